@@ -52,8 +52,8 @@ protected:
   //! load the library (<file>.so) that was created earlier, store
   bool loadRhsLibrary(std::string libraryFilename);
 
-  //! create the source filename using the CellmlSourceCodeGenerator, then compile to library
-  void createLibraryOnOneRank(std::string libraryFilename, const std::vector<int> &nInstancesRanks);
+  //! write the source code that was generated by the CellmlSourceCodeGenerator and compile it to the library, the library is published atomically in the cache directory
+  void createLibraryOnOneRank(std::string libraryFilename, std::string compileCommandOptions);
 
   std::string sourceToCompileFilename_;   //< filename of the processed source file that will be used to compile the library
   std::string optimizationType_;          //< type of generated file, e.g. "simd", "gpu", "openmp"
@@ -61,7 +61,10 @@ protected:
   int maximumNumberOfThreads_;            //< when using "openmp" as optimizationType_, the maximum number of threads to use, 0 means no restriction
   bool useAoVSMemoryLayout_;              //< which memory layout to use for the vc optimization type, true=Array-of-Vectorized-Struct, false=Struct-of-Vectorized-Array
 
-  void (*rhsRoutine_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);                //< function pointer to the rhs routine that can compute several instances of the problem in parallel. Data is assumed to contain values for a state contiguously, e.g. (state[1], state[1], state[1], state[2], state[2], state[2], ...). The first parameter is a this pointer.
+  void (*rhsRoutine_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters, int nInstances);  //< function pointer to the rhs routine that can compute several instances of the problem in parallel, the number of instances is given as last argument. Data is assumed to contain values for a state contiguously, e.g. (state[1], state[1], state[1], state[2], state[2], state[2], ...). The first parameter is a this pointer.
+  void (*rhsRoutineFixedNInstances_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);   //< function pointer to the rhs routine of libraries that were compiled for a fixed number of instances, used if rhsRoutine_ is not available
+  void (*rhsRoutineTimeSteps_)(void *context, double startTime, double timeStepWidth, int nTimeSteps, int useHeun,
+                               double *states, double *algebraics, double *parameters, int nInstances) = nullptr;   //< function pointer to the routine that computes multiple explicit Euler or Heun time steps at once, without storing intermediate values
 
   //! helper rhs routines
   void (*rhsRoutineGPU_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);             //< function pointer to a gpu processed rhs function that is passed as dynamic library. Data is assumed to contain values for a state contiguously, e.g. (state[1], state[1], state[1], state[2], state[2], state[2], ...).
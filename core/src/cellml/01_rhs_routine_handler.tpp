@@ -9,11 +9,16 @@
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
 #include "utility/string_utility.h"
+#include "utility/file_lock.h"
 #include "mesh/mesh_manager/mesh_manager.h"
+#include "output_writer/generic.h"
 
 #include <unistd.h>  //dlopen
 #include <dlfcn.h>
 #include <ctime>
+#include <cstdio>    // rename
+#include <thread>
+#include <chrono>
 
 // forward declaration
 template <int nStates,int nAlgebraics_,typename FunctionSpaceType>
@@ -84,79 +89,74 @@ initializeRhsRoutine()
   }
   else
   {
-    // determine file name of the source code file and library file
-    std::stringstream baseFilename;
-    baseFilename << StringUtility::extractBasename(this->cellmlSourceCodeGenerator_.sourceFilename())
-      << "_" << this->cellmlSourceCodeGenerator_.nParameters() << "_";
+    // generate the source code, the code does not depend on the number of instances which is passed at runtime, therefore it is the same on all ranks
+    this->cellmlSourceCodeGenerator_.generateSourceCode(optimizationType_, approximateExponentialFunction_, maximumNumberOfThreads_, useAoVSMemoryLayout_);
 
-    const std::vector<int> &statesForTransfer = this->data_.statesForTransfer();
-    for (int i = 0; i < statesForTransfer.size(); i++)
-      baseFilename << statesForTransfer[i];
-    baseFilename << "_";
-
-    const std::vector<int> &algebraicsForTransfer = this->data_.algebraicsForTransfer();
-    for (int i = 0; i < algebraicsForTransfer.size(); i++)
-      baseFilename << algebraicsForTransfer[i];
-    baseFilename << "_";
-
-    const std::vector<int> &parametersForTransfer = this->data_.parametersForTransfer();
-    for (int i = 0; i < parametersForTransfer.size(); i++)
-      baseFilename << parametersForTransfer[i];
+    // load compiler flags
+    std::string compilerFlags = this->specificSettings_.getOptionString("compilerFlags", "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
 
-    baseFilename << "_" << optimizationType_
-      << "_" << this->nInstances_;
+#ifdef NDEBUG
+    if (compilerFlags.find("-O3") == std::string::npos)
+    {
+      LOG(WARNING) << "\"compilerFlags\" does not contain \"-O3\", this may be slow.";
+    }
+#endif
+    // for GPU: -ta=host,tesla,time
 
+    // compose the compile command without the source and library filenames
     std::stringstream s;
-    s << "lib/" << baseFilename.str() << ".so";
-    libraryFilename = s.str();
+    s << this->cellmlSourceCodeGenerator_.compilerCommand() << " "
+      << compilerFlags << " " << this->cellmlSourceCodeGenerator_.additionalCompileFlags() << " ";
+    std::string compileCommandOptions = s.str();
 
-    int rankNoWorldCommunicator = DihuContext::ownRankNoCommWorld();
-    s.str("");
-    s << "src/" << baseFilename.str() << "." << rankNoWorldCommunicator << this->cellmlSourceCodeGenerator_.sourceFileSuffix();
-    sourceToCompileFilename_ = s.str();
+    // the library is identified by a hash of the generated source code and the compile command,
+    // such that changes of the model or the compiler flags lead to a new library and equal libraries are only compiled once
+    std::string hash = StringUtility::hashHexadecimal(this->cellmlSourceCodeGenerator_.generatedSourceCode() + "\n" + compileCommandOptions);
 
-    // create path of library filename if it does not exist
-    if (libraryFilename.find("/") != std::string::npos)
-    {
-      std::string path = libraryFilename.substr(0, libraryFilename.rfind("/"));
-      // if directory does not yet exist, create it
-      struct stat info;
-      if (stat(path.c_str(), &info) != 0)
-      {
-        int ret = system((std::string("mkdir -p ")+path).c_str());
+    std::string libraryCacheDirectory = this->specificSettings_.getOptionString("libraryCacheDirectory", "lib");
+    if (!libraryCacheDirectory.empty() && libraryCacheDirectory[libraryCacheDirectory.length()-1] != '/')
+      libraryCacheDirectory += "/";
 
-        if (ret != 0)
-        {
-          LOG(ERROR) << "Could not create path \"" << path << "\".";
-        }
-      }
-    }
+    std::string baseFilename = libraryCacheDirectory + StringUtility::extractBasename(this->cellmlSourceCodeGenerator_.sourceFilename()) + "_" + hash;
+    libraryFilename = baseFilename + ".so";
+    sourceToCompileFilename_ = baseFilename + this->cellmlSourceCodeGenerator_.sourceFileSuffix();
 
-    // gather what number of instances all ranks have
+    // gather the hashes of all ranks, the library of every hash is only compiled by the lowest rank that needs it
+    MPI_Comm mpiCommunicator = this->functionSpace_->meshPartition()->mpiCommunicator();
     int nRanksCommunicator = this->functionSpace_->meshPartition()->nRanks();
     int ownRankNoCommunicator = this->functionSpace_->meshPartition()->ownRankNo();
-    std::vector<int> nInstancesRanks(nRanksCommunicator);
-    nInstancesRanks[ownRankNoCommunicator] = this->nInstances_;
+    const int hashLength = hash.length();
 
-    //std::cout << "ownRankNoCommunicator: " << ownRankNoCommunicator << ", Communicator has " << nRanksCommunicator << " ranks, nInstancesRanks: " << nInstancesRanks << std::endl;
+    std::vector<char> hashesRanks(nRanksCommunicator*hashLength);
+    MPIUtility::handleReturnValue(MPI_Allgather(hash.data(), hashLength, MPI_CHAR, hashesRanks.data(),
+                                                hashLength, MPI_CHAR, mpiCommunicator), "MPI_Allgather");
 
-    MPIUtility::handleReturnValue(MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, nInstancesRanks.data(),
-                                                1, MPI_INT, this->functionSpace_->meshPartition()->mpiCommunicator()), "MPI_Allgather");
-
-    // check if the library already exists by a previous compilation
-    struct stat buffer;
-    if (stat(libraryFilename.c_str(), &buffer) == 0)
+    int rankWhichCompilesLibrary = 0;
+    for (int rankNo = 0; rankNo < nRanksCommunicator; rankNo++)
     {
-      LOG(DEBUG) << "Library \"" << libraryFilename << "\" already exists.";
+      if (std::string(hashesRanks.begin() + rankNo*hashLength, hashesRanks.begin() + (rankNo+1)*hashLength) == hash)
+      {
+        rankWhichCompilesLibrary = rankNo;
+        break;
+      }
     }
-    else
+
+    if (rankWhichCompilesLibrary == ownRankNoCommunicator)
     {
-      // compile the library on only one rank
-      createLibraryOnOneRank(libraryFilename, nInstancesRanks);
+      // check if the library already exists in the cache from a previous run or from other ranks
+      struct stat buffer;
+      if (stat(libraryFilename.c_str(), &buffer) == 0)
+      {
+        LOG(DEBUG) << "Library \"" << libraryFilename << "\" already exists in the cache.";
+      }
+      else
+      {
+        createLibraryOnOneRank(libraryFilename, compileCommandOptions);
+      }
     }
 
-    // barrier to wait until the one rank that compiles the library has finished
-    MPIUtility::handleReturnValue(MPI_Barrier(this->functionSpace_->meshPartition()->mpiCommunicator()), "MPI_Barrier");
+    // barrier to wait until the ranks that compile the libraries have finished
+    MPIUtility::handleReturnValue(MPI_Barrier(mpiCommunicator), "MPI_Barrier");
   }
 
   loadRhsLibrary(libraryFilename);
@@ -173,6 +173,10 @@ loadRhsLibraryGetHandle(std::string libraryFilename)
   if (currentWorkingDirectory[currentWorkingDirectory.length()-1] != '/')
     currentWorkingDirectory += "/";
 
+  // the library cache directory can also be given as absolute path
+  if (!libraryFilename.empty() && libraryFilename[0] == '/')
+    currentWorkingDirectory = "";
+
   void *handle = NULL;
   for (int i = 0; handle == NULL && i < 50; i++)  // wait maximum 2.5 ms for rank 0 to finish
   {
@@ -216,7 +220,9 @@ loadRhsLibrary(std::string libraryFilename)
     // load rhs method
 
     // try to load several routine names
-    rhsRoutine_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeCellMLRightHandSide");
+    rhsRoutine_ = (void (*)(void *,double,double*,double*,double*,double*,int)) dlsym(handle, "computeCellMLRightHandSideNInstances");
+    rhsRoutineFixedNInstances_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeCellMLRightHandSide");
+    rhsRoutineTimeSteps_ = (void (*)(void *,double,double,int,int,double*,double*,double*,int)) dlsym(handle, "computeCellMLTimeStepsNInstances");
     rhsRoutineGPU_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeGPUCellMLRightHandSide");
     rhsRoutineSingleInstance_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeCellMLRightHandSideSingleInstance");
     initConstsOpenCOR_ = (void(*)(double*, double*, double*)) dlsym(handle, "initConsts");
@@ -225,6 +231,8 @@ loadRhsLibrary(std::string libraryFilename)
 
     LOG(DEBUG) << "Library \"" << libraryFilename << "\" loaded. "
       << "rhsRoutine_: " << (rhsRoutine_==NULL? "NULL" : "yes")
+      << ", rhsRoutineFixedNInstances_: " << (rhsRoutineFixedNInstances_==NULL? "NULL" : "yes")
+      << ", rhsRoutineTimeSteps_: " << (rhsRoutineTimeSteps_==NULL? "NULL" : "yes")
       << ", rhsRoutineGPU_: " << (rhsRoutineGPU_==NULL? "NULL" : "yes")
       << ", rhsRoutineSingleInstance: " << (rhsRoutineSingleInstance_==NULL? "NULL" : "yes")
       << ", initConstsOpenCOR_: " << (initConstsOpenCOR_==NULL? "NULL" : "yes")
@@ -236,10 +244,17 @@ loadRhsLibrary(std::string libraryFilename)
       // if the opendihu-generated rhs function (with openmp pragmas) is present in the library, we can directly use it and we are done in this method.
       return true;
     }
+    else if (rhsRoutineFixedNInstances_)
+    {
+      // libraries of older versions of opendihu have the number of instances compiled into the code
+      LOG(WARNING) << "Library \"" << libraryFilename << "\" was created for a fixed number of instances, "
+        << "make sure that it was created for " << this->nInstances_ << " instances.";
+      return true;
+    }
     else if (rhsRoutineGPU_)
     {
       // if the gpu-processed rhs function (with openmp 4.5 pragmas) is present in the library, we can directly use it and we are done in this method.
-      rhsRoutine_ = rhsRoutineGPU_;
+      rhsRoutineFixedNInstances_ = rhsRoutineGPU_;
       return true;
     }
     else if (initConstsOpenCOR_)
@@ -263,38 +278,15 @@ loadRhsLibrary(std::string libraryFilename)
 
 template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
 void RhsRoutineHandler<nStates,nAlgebraics_,FunctionSpaceType>::
-createLibraryOnOneRank(std::string libraryFilename, const std::vector<int> &nInstancesRanks)
+createLibraryOnOneRank(std::string libraryFilename, std::string compileCommandOptions)
 {
-  // get the global rank no, needed for the output filenames
-  int rankNoWorldCommunicator = DihuContext::ownRankNoCommWorld();
-
-  // determine if this rank should do compilation, such that each nInstances is compiled only once, by the rank with lowest number
-  int i = 0;
-  int rankWhichCompilesLibrary = 0;
-  for (std::vector<int>::const_iterator iter = nInstancesRanks.begin(); iter != nInstancesRanks.end(); iter++, i++)
+  // create the cache directory if it does not yet exist
+  if (libraryFilename.find("/") != std::string::npos)
   {
-    if (*iter == this->nInstances_)
+    std::string path = libraryFilename.substr(0, libraryFilename.rfind("/"));
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0)
     {
-      rankWhichCompilesLibrary = i;
-      break;
-    }
-  }
-
-  LOG(DEBUG) << "Library will be compiled on rank " << rankWhichCompilesLibrary;
-
-  int ownRankNoCommunicator = this->functionSpace_->meshPartition()->ownRankNo();
-  if (rankWhichCompilesLibrary == ownRankNoCommunicator)
-  {
-    LOG(DEBUG) << "compile on this rank";
-
-    // create source file
-    this->cellmlSourceCodeGenerator_.generateSourceFile(sourceToCompileFilename_, optimizationType_,
-                                                        approximateExponentialFunction_, maximumNumberOfThreads_, useAoVSMemoryLayout_);
-
-    // create library file
-    if (libraryFilename.find("/") != std::string::npos)
-    {
-      std::string path = libraryFilename.substr(0, libraryFilename.rfind("/"));
       int ret = system((std::string("mkdir -p ")+path).c_str());
 
       if (ret != 0)
@@ -302,85 +294,123 @@ createLibraryOnOneRank(std::string libraryFilename, const std::vector<int> &nIns
         LOG(ERROR) << "Could not create path \"" << path << "\" for library file.";
       }
     }
+  }
 
-    std::stringstream compileCommand;
+  // the cache directory can be shared by multiple simulations and by ranks of different communicators,
+  // only one process compiles the library, the others wait until it has been published.
+  // A lock of a process on the same host that was aborted during the compilation is detected and removed
+  FileLock lock(libraryFilename + ".lock");
+  const int maximumWaitTime = this->specificSettings_.getOptionInt("libraryCacheLockTimeout", 600, PythonUtility::NonNegative);
+  for (int i = 0; !lock.tryLock(); i++)
+  {
+    struct stat buffer;
+    if (stat(libraryFilename.c_str(), &buffer) == 0)
+      return;
 
-    // load compiler flags
-    std::string compilerFlags = this->specificSettings_.getOptionString("compilerFlags", "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+    if (i == 0)
+    {
+      LOG(DEBUG) << "Library \"" << libraryFilename << "\" is being compiled by process \"" << lock.owner() << "\", wait until it exists.";
+    }
 
-#ifdef NDEBUG
-    if (compilerFlags.find("-O3") == std::string::npos)
+    // the owner of the lock runs on another host and did not finish, e.g. because it was aborted
+    if (i >= maximumWaitTime*10)
     {
-      LOG(WARNING) << "\"compilerFlags\" does not contain \"-O3\", this may be slow.";
+      LOG(WARNING) << "Library \"" << libraryFilename << "\" was locked by process \"" << lock.owner() << "\" for more than " << maximumWaitTime
+        << " s, but not created. Compiling the library now.";
+      break;
     }
-#endif
-    // for GPU: -ta=host,tesla,time
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
 
-    // compose compile command
-    std::stringstream s;
-    s << this->cellmlSourceCodeGenerator_.compilerCommand() << " " << sourceToCompileFilename_ << " "
-      << compilerFlags << " " << this->cellmlSourceCodeGenerator_.additionalCompileFlags() << " ";
+  // the library may have been published between the last check and acquiring the lock
+  struct stat libraryStat;
+  if (lock.isLocked() && stat(libraryFilename.c_str(), &libraryStat) == 0)
+    return;
 
-    std::string compileCommandOptions = s.str();
+  // write the source file and compile it to temporary files, then rename the library, which is atomic, such that no process loads a partially written library
+  std::stringstream temporarySuffix;
+  temporarySuffix << "." << DihuContext::ownRankNoCommWorld() << "." << getpid() << ".tmp";
+
+  std::string temporarySourceFilename = sourceToCompileFilename_ + temporarySuffix.str() + this->cellmlSourceCodeGenerator_.sourceFileSuffix();
+  std::string temporaryLibraryFilename = libraryFilename + temporarySuffix.str();
+
+  std::ofstream sourceCodeFile;
+  OutputWriter::Generic::openFile(sourceCodeFile, temporarySourceFilename);
+  if (!sourceCodeFile.is_open())
+  {
+    LOG(FATAL) << "Could not write to file \"" << temporarySourceFilename << "\".";
+  }
+  sourceCodeFile << this->cellmlSourceCodeGenerator_.generatedSourceCode();
+  sourceCodeFile.close();
 
-    // compile library to filename with "*.rankNoWorldCommunicator", then wait (different wait times for ranks), then rename file to without "*.rankNoWorldCommunicator"
-    compileCommand << compileCommandOptions
-      << " -o " << libraryFilename << "." << rankNoWorldCommunicator << " "
-      //<< " && sleep " << int((rankNoWorldCommunicator%100)/10+1)
-      << " && mv " << libraryFilename << "." << rankNoWorldCommunicator << " " << libraryFilename;
+  std::stringstream compileCommand;
+  compileCommand << compileCommandOptions << " " << temporarySourceFilename << " -o " << temporaryLibraryFilename;
 
-    int ret = system(compileCommand.str().c_str());
-    if (ret != 0)
+  int ret = system(compileCommand.str().c_str());
+  if (ret != 0)
+  {
+    LOG(ERROR) << "Compilation failed. Command: \"" << compileCommand.str() << "\".";
+
+    try
     {
-      LOG(ERROR) << "Compilation failed. Command: \"" << compileCommand.str() << "\".";
+      // remove "-fopenmp" in the compile command
+      std::string newCompileCommand = compileCommand.str();
+      std::string strToReplace = "-fopenmp";
+      std::size_t pos = newCompileCommand.find(strToReplace);
+      if (pos != std::string::npos)
+      {
+        newCompileCommand.replace(pos, strToReplace.length(), "");
+      }
 
-      try
+      // remove -foffload="..."
+      pos = newCompileCommand.find("-foffload=\"");
+      std::size_t pos2 = newCompileCommand.find("\"", pos+11);
+      if (pos != std::string::npos && pos2 != std::string::npos)
       {
-        // remove "-fopenmp" in the compile command
-        std::string newCompileCommand = compileCommand.str();
-        std::string strToReplace = "-fopenmp";
-        std::size_t pos = newCompileCommand.find(strToReplace);
-        if (pos != std::string::npos)
-        {
-          newCompileCommand.replace(pos, strToReplace.length(), "");
-        }
-
-        // remove -foffload="..."
-        pos = newCompileCommand.find("-foffload=\"");
-        std::size_t pos2 = newCompileCommand.find("\"", pos+11);
-        if (pos != std::string::npos && pos2 != std::string::npos)
-        {
-          newCompileCommand.replace(pos, pos2-pos+1, "");
-        }
-
-        LOG(INFO) << "Retry without offloading, command: \n" << newCompileCommand;
-
-        // execute new compilation command
-        int ret = system(newCompileCommand.c_str());
-        if (ret != 0)
-        {
-          LOG(ERROR) << "Compilation failed again.";
-        }
-        else
-        {
-          LOG(DEBUG) << "Compilation successful.";
-        }
+        newCompileCommand.replace(pos, pos2-pos+1, "");
       }
-      catch(...)
+
+      LOG(INFO) << "Retry without offloading, command: \n" << newCompileCommand;
+
+      // execute new compilation command
+      ret = system(newCompileCommand.c_str());
+      if (ret != 0)
+      {
+        LOG(ERROR) << "Compilation failed again.";
+      }
+      else
       {
-         LOG(ERROR) << "Could not modify compile command. Command: \"" << compileCommand.str() << "\".";
+        LOG(DEBUG) << "Compilation successful.";
       }
     }
-    else
+    catch(...)
     {
-      LOG(DEBUG) << "Compilation successful. Command: \"" << compileCommand.str() << "\".";
+       LOG(ERROR) << "Could not modify compile command. Command: \"" << compileCommand.str() << "\".";
     }
   }
   else
   {
-    LOG(DEBUG) << "we are the wrong rank, do not compile library "
-      << "wait until library has been compiled";
+    LOG(DEBUG) << "Compilation successful. Command: \"" << compileCommand.str() << "\".";
   }
+
+  // publish the source file and the library in the cache
+  if (ret == 0)
+  {
+    if (std::rename(temporarySourceFilename.c_str(), sourceToCompileFilename_.c_str()) != 0)
+    {
+      LOG(WARNING) << "Could not rename \"" << temporarySourceFilename << "\" to \"" << sourceToCompileFilename_ << "\".";
+    }
+    if (std::rename(temporaryLibraryFilename.c_str(), libraryFilename.c_str()) != 0)
+    {
+      LOG(ERROR) << "Could not rename \"" << temporaryLibraryFilename << "\" to \"" << libraryFilename << "\".";
+    }
+  }
+  else
+  {
+    std::remove(temporarySourceFilename.c_str());
+  }
+
+  lock.unlock();
 }
 
 template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
@@ -91,6 +91,7 @@ protected:
   double lastCallSpecificStatesTime_;             //< last time the setSpecificStates_ method was called
   double setSpecificStatesRepeatAfterFirstCall_;  //< duration of continuation of calling the setSpecificStates callback after it was triggered
   double setSpecificStatesCallEnableBegin_;       //< first time when setSpecificStates should be called
+  int checkpointingHandle_ = -1;                  //< handle of the stimulation information registered in Control::Checkpointing, -1 if not registered
  
   PyObject *pythonSetSpecificParametersFunction_; //< Python function handle that is called to set parameters to the CellML problem from the python config
   PyObject *pythonSetSpecificStatesFunction_;     //< Python function handle that is called to set states to the CellML problem from the python config
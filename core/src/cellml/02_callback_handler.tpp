@@ -9,6 +9,7 @@
 #include "utility/petsc_utility.h"
 #include "utility/string_utility.h"
 #include "mesh/mesh_manager/mesh_manager.h"
+#include "control/checkpointing/checkpointing.h"
 
 template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
 CallbackHandler<nStates,nAlgebraics_,FunctionSpaceType>::
@@ -35,6 +36,7 @@ CallbackHandler<nStates,nAlgebraics_,FunctionSpaceType>::
 ~CallbackHandler()
 {
   clearPyObjects();
+  Control::Checkpointing::unregisterState(checkpointingHandle_);
 }
 
 template<int nStates, int nAlgebraics_, typename FunctionSpaceType>
@@ -53,6 +53,14 @@ public:
 
   //! evaluate rhs
   void evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepNo, double currentTime);
+
+  //! get the number of the following explicit Euler or Heun time steps, at most nTimeStepsMaximum, that can be computed at once by computeTimeSteps,
+  //! i.e. no callback function and no output of the CellmlAdapter is due during these time steps. Returns 0 if the library does not contain the routine.
+  //! @param nRhsEvaluationsPerTimeStep 1 for explicit Euler, 2 for Heun
+  int nTimeStepsWithoutInterruption(double currentTime, double timeStepWidth, int nTimeStepsMaximum, int nRhsEvaluationsPerTimeStep);
+
+  //! compute nTimeSteps explicit Euler or Heun time steps at once with the routine of the compiled library, the values in states are updated in-place
+  void computeTimeSteps(Vec &states, double currentTime, double timeStepWidth, int nTimeSteps, bool useHeun);
   
   //! return the mesh
   std::shared_ptr<FunctionSpaceType> functionSpace();
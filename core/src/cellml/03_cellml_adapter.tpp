@@ -4,6 +4,8 @@
 
 #include <list>
 #include <sstream>
+#include <cmath>
+#include <algorithm>
 
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
@@ -11,6 +13,7 @@
 #include "mesh/structured_regular_fixed.h"
 #include "mesh/mesh_manager/mesh_manager.h"
 #include "function_space/function_space.h"
+#include "control/checkpointing/checkpointing.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
 
 template<int nStates_, int nAlgebraics_, typename FunctionSpaceType>
@@ -187,6 +190,31 @@ initialize()
   this->jitterIndex_ = 0;
   this->lastCallSpecificStatesTime_ = this->setSpecificStatesCallEnableBegin_ - 1e-13 - 1./(this->setSpecificStatesCallFrequency_+this->currentJitter_);
 
+  // store the stimulation information in checkpoints, the states and parameters are field variables which are stored anyways
+  if (Control::Checkpointing::enabled())
+  {
+    Control::Checkpointing::SaveFunction save = [this](std::vector<double> &values)
+    {
+      values.push_back(this->lastCallSpecificStatesTime_);
+      values.push_back(this->currentJitter_);
+      values.push_back(this->jitterIndex_);
+      values.push_back(this->internalTimeStepNo_);
+    };
+    Control::Checkpointing::RestoreFunction restore = [this](const std::vector<double> &values)
+    {
+      if (values.size() != 4)
+      {
+        LOG(FATAL) << "CellmlAdapter: Checkpoint contains " << values.size() << " values for the stimulation information, but 4 are needed.";
+      }
+      this->lastCallSpecificStatesTime_ = values[0];
+      this->currentJitter_ = values[1];
+      this->jitterIndex_ = int(values[2]);
+      this->internalTimeStepNo_ = int(values[3]);
+    };
+    std::string key = std::string("cellml/") + this->functionSpace_->meshName() + "/stimulation";
+    this->checkpointingHandle_ = Control::Checkpointing::registerState(key, save, restore);
+  }
+
   LOG(DEBUG) << "Cellml end of initialize, " << this->sourceToCompileFilename_ << ", statesForTransfer: " << this->data_.statesForTransfer();
   this->initialized_ = true;
 }
@@ -275,10 +303,15 @@ evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepN
     //Control::PerformanceMeasurement::start("rhsEvaluationTime");  // commented out because it takes too long in this very inner loop
 
     // call actual rhs routine from cellml code
-    this->rhsRoutine_((void *)this, currentTime, statesLocal, ratesLocal, algebraicsLocal, this->data_.parameterValues());
+    this->rhsRoutine_((void *)this, currentTime, statesLocal, ratesLocal, algebraicsLocal, this->data_.parameterValues(), this->nInstances_);
 
     //Control::PerformanceMeasurement::stop("rhsEvaluationTime");
   }
+  else if (this->rhsRoutineFixedNInstances_)
+  {
+    // call rhs routine of a library that was compiled for a fixed number of instances
+    this->rhsRoutineFixedNInstances_((void *)this, currentTime, statesLocal, ratesLocal, algebraicsLocal, this->data_.parameterValues());
+  }
 
   // handle callback function "handleResult"
   checkCallbackAlgebraics(currentTime, statesLocal, algebraicsLocal);
@@ -297,6 +330,95 @@ evaluateTimesteppingRightHandSideExplicit(Vec& input, Vec& output, int timeStepN
   this->internalTimeStepNo_++;
 }
 
+template<int nStates_, int nAlgebraics_, typename FunctionSpaceType>
+int CellmlAdapter<nStates_,nAlgebraics_,FunctionSpaceType>::
+nTimeStepsWithoutInterruption(double currentTime, double timeStepWidth, int nTimeStepsMaximum, int nRhsEvaluationsPerTimeStep)
+{
+  if (!this->rhsRoutineTimeSteps_ || nTimeStepsMaximum <= 0)
+    return 0;
+
+  int nTimeSteps = nTimeStepsMaximum;
+
+  // callbacks with a call interval are called at the rhs evaluation where internalTimeStepNo_ is a multiple of the interval
+  auto restrictToCallInterval = [this,&nTimeSteps,nRhsEvaluationsPerTimeStep](int callInterval)
+  {
+    int nRhsEvaluationsUntilCall = (callInterval - this->internalTimeStepNo_ % callInterval) % callInterval;
+    nTimeSteps = std::min(nTimeSteps, nRhsEvaluationsUntilCall / nRhsEvaluationsPerTimeStep);
+  };
+
+  if (this->pythonSetSpecificParametersFunction_)
+    restrictToCallInterval(this->setSpecificParametersCallInterval_);
+
+  if (this->pythonHandleResultFunction_)
+    restrictToCallInterval(this->handleResultCallInterval_);
+
+  if (this->pythonSetSpecificStatesFunction_)
+  {
+    if (this->setSpecificStatesCallInterval_ != 0)
+      restrictToCallInterval(this->setSpecificStatesCallInterval_);
+
+    if (this->setSpecificStatesCallFrequency_ != 0.0)
+    {
+      // the callback is called at the first rhs evaluation at or after this time, cf. checkCallbackStates
+      double nextCallTime = std::max(this->lastCallSpecificStatesTime_ + 1./(this->setSpecificStatesCallFrequency_+this->currentJitter_),
+                                     this->setSpecificStatesCallEnableBegin_-1e-13);
+
+      // the last rhs evaluation of n time steps is at currentTime + (n-1)*dt for explicit Euler and at currentTime + n*dt for Heun
+      double nTimeStepWidthsUntilCall = (nextCallTime - currentTime) / timeStepWidth;
+      if (nTimeStepWidthsUntilCall < nTimeSteps + 2)
+      {
+        int nTimeStepWidths = (int)std::ceil(nTimeStepWidthsUntilCall) - 1;
+        if (currentTime + nTimeStepWidths*timeStepWidth >= nextCallTime)
+          nTimeStepWidths--;
+
+        nTimeSteps = std::min(nTimeSteps, nTimeStepWidths + 2 - nRhsEvaluationsPerTimeStep);
+      }
+    }
+  }
+
+  // the output writers of the CellmlAdapter are called at every rhs evaluation
+  if (this->outputWriterManager_.hasOutputWriters())
+  {
+    nTimeSteps = std::min(nTimeSteps, (this->outputWriterManager_.nCallsUntilNextOutput() - 1) / nRhsEvaluationsPerTimeStep);
+  }
+
+  return std::max(0, nTimeSteps);
+}
+
+template<int nStates_, int nAlgebraics_, typename FunctionSpaceType>
+void CellmlAdapter<nStates_,nAlgebraics_,FunctionSpaceType>::
+computeTimeSteps(Vec &states, double currentTime, double timeStepWidth, int nTimeSteps, bool useHeun)
+{
+  assert(this->rhsRoutineTimeSteps_);
+
+  // get raw pointers from Petsc data structures
+  double *statesLocal;
+  double *algebraicsLocal;
+  PetscErrorCode ierr;
+  ierr = VecGetArray(states, &statesLocal); CHKERRV(ierr);
+  ierr = VecGetArray(this->data_.algebraics()->getValuesContiguous(), &algebraicsLocal); CHKERRV(ierr);
+
+  // make the parameterValues_ vector available
+  this->data_.prepareParameterValues();
+
+  // compute all time steps in the compiled library, the values of the instances stay in registers or cache for all time steps
+  this->rhsRoutineTimeSteps_((void *)this, currentTime, timeStepWidth, nTimeSteps, (useHeun? 1 : 0),
+                             statesLocal, algebraicsLocal, this->data_.parameterValues(), this->nInstances_);
+
+  // give control of data back to Petsc
+  ierr = VecRestoreArray(states, &statesLocal); CHKERRV(ierr);
+  ierr = VecRestoreArray(this->data_.algebraics()->getValuesContiguous(), &algebraicsLocal); CHKERRV(ierr);
+
+  this->data_.restoreParameterValues();
+
+  // advance the counter of rhs evaluations as if every time step had been computed individually, such that the call intervals of callbacks stay the same
+  const int nRhsEvaluations = nTimeSteps * (useHeun? 2 : 1);
+  this->internalTimeStepNo_ += nRhsEvaluations;
+
+  // update the call counts of the output writers, nTimeStepsWithoutInterruption ensures that no output is due
+  this->outputWriterManager_.writeOutput(this->data_, this->internalTimeStepNo_, currentTime + nTimeSteps*timeStepWidth, nRhsEvaluations);
+}
+
 template<int nStates_, int nAlgebraics_, typename FunctionSpaceType>
 void CellmlAdapter<nStates_,nAlgebraics_,FunctionSpaceType>::
 checkCallbackParameters(double currentTime)
@@ -380,3 +380,8 @@ std::string CellmlSourceCodeGeneratorBase::compilerCommand() const
 {
   return compilerCommand_;
 }
+
+const std::string &CellmlSourceCodeGeneratorBase::generatedSourceCode() const
+{
+  return generatedSourceCode_;
+}
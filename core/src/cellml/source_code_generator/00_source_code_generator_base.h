@@ -60,6 +60,9 @@ public:
   //! get the suffix to use for the source file, e.g. ".c" or ".cpp"
   std::string sourceFileSuffix() const;
 
+  //! get the source code that was created by the last call to generateSourceCode, it does not depend on the number of instances
+  const std::string &generatedSourceCode() const;
+
 protected:
 
   struct code_expression_t
@@ -121,6 +124,7 @@ protected:
   std::string compilerCommand_;                //< compiler command that should be used to compile the created source file
   std::string additionalCompileFlags_;         //< additional compile flags that depend on the optimizationType, e.g. -fopenmp for "openmp"
   std::string sourceFileSuffix_;               //< suffix to use for the source file, e.g. ".c" or ".cpp"
+  std::string generatedSourceCode_;            //< the generated source code of the rhs routine that will be compiled to a library
 
   std::vector<int> parametersUsedAsAlgebraic_;  //< explicitely defined parameters that will be copied to algebraics, this vector contains the indices of the algebraic array
   std::vector<int> parametersUsedAsConstant_;  //< explicitely defined parameters that will be copied to constants, this vector contains the indices of the constants
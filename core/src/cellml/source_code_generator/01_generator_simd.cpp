@@ -8,25 +8,24 @@
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
 #include "easylogging++.h"
 
 
 void CellmlSourceCodeGeneratorSimd::
-generateSourceFileSimd(std::string outputFilename)
+generateSourceCodeSimd()
 {
-  LOG(DEBUG) << "generateSourceFileSimd";
+  LOG(DEBUG) << "generateSourceCodeSimd";
 
   std::stringstream simdSource;
   simdSource << "#include <math.h>" << std::endl
     << cellMLCode_.header << std::endl;
 
-  auto t = std::time(nullptr);
-  auto tm = *std::localtime(&t);
-  simdSource << std::endl << "/* This function was created by opendihu at " << StringUtility::timeToString(&tm)  //std::put_time(&tm, "%d/%m/%Y %H:%M:%S")
-    << ".\n * It is designed for " << this->nInstances_ << " instances of the CellML problem.\n "
+  simdSource << std::endl << "/* This function was created by opendihu.\n"
+    << " * The number of instances of the CellML problem is given by the argument nInstances.\n "
     << " * The \"optimizationType\" is \"simd\". (Other options are \"vc\" and \"openmp\".) */" << std::endl
-    << "void computeCellMLRightHandSide("
-    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters)" << std::endl << "{" << std::endl;
+    << "void computeCellMLRightHandSideNInstances("
+    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters, int nInstances)" << std::endl << "{" << std::endl;
 
   simdSource << "  double VOI = t;   /* current simulation time */" << std::endl;
   simdSource << std::endl << "  /* define constants */" << std::endl
@@ -49,7 +48,7 @@ generateSourceFileSimd(std::string outputFilename)
         << "  #pragma omp for simd" << std::endl
         << "#endif" << std::endl
         //<< "#pragma GCC ivdep  // this disables alias checking for the compiler (GCC only)" << std::endl   // does not work on hazelhen
-        << "  for (int i = 0; i < " << this->nInstances_ << "; i++)" << std::endl
+        << "  for (int i = 0; i < nInstances; i++)" << std::endl
         << "  {" << std::endl
         << "    ";
 
@@ -67,7 +66,7 @@ generateSourceFileSimd(std::string outputFilename)
           else
           {
             // all other variables (states, rates, algebraics, parameters) exist for every instance
-            simdSource << expression.code << "[" << expression.arrayIndex * this->nInstances_ << "+i]";
+            simdSource << expression.code << "[" << expression.arrayIndex << "*nInstances+i]";
           }
           break;
 
@@ -91,23 +90,165 @@ generateSourceFileSimd(std::string outputFilename)
   // add footer
   simdSource << cellMLCode_.footer << std::endl;
 
+  // add code that computes multiple time steps at once
+  simdSource << generateTimeStepsCode(false);
+
   // add code for a single instance
   simdSource << singleInstanceCode_;
 
-  // write out source file
-  std::ofstream simdSourceFile;
-  OutputWriter::Generic::openFile(simdSourceFile, outputFilename);
-  if (!simdSourceFile.is_open())
+  generatedSourceCode_ = simdSource.str();
+  compilerCommand_ = C_COMPILER_COMMAND;
+  additionalCompileFlags_ = "";
+  sourceFileSuffix_ = ".c";
+}
+
+std::string CellmlSourceCodeGeneratorSimd::
+generateTimeStepsCode(bool useOpenMp)
+{
+  const int blockSize = 8;   // number of instances that are computed together, such that the values stay in cache and the loops can be vectorized
+
+  std::stringstream sourceCode;
+  sourceCode << std::endl << "/* This function was created by opendihu.\n"
+    << " * It computes nTimeSteps explicit Euler steps (useHeun=0) or Heun steps (useHeun=1) for nInstances instances.\n"
+    << " * The instances are processed in blocks of " << blockSize << ", the values of a block are kept in local arrays for all time steps. */" << std::endl
+    << "void computeCellMLTimeStepsNInstances(void *context, double startTime, double timeStepWidth, int nTimeSteps, int useHeun, "
+    << "double *states, double *algebraics, double *parameters, int nInstances)" << std::endl << "{" << std::endl;
+
+  sourceCode << "  /* define constants */" << std::endl
+    << "  double CONSTANTS[" << this->nConstants_ << "];" << std::endl;
+
+  // add assignments of constant values
+  for (std::string constantAssignmentsLine : constantAssignments_)
   {
-    LOG(FATAL) << "Could not write to file \"" << outputFilename << "\".";
+    sourceCode << "  " << constantAssignmentsLine << std::endl;
   }
-  else
+
+  const int nStatesBlock = this->nStates_*blockSize;
+  const int nAlgebraicsBlock = std::max(1u, this->nAlgebraics_)*blockSize;
+  const int nParametersBlock = std::max(1, this->nParameters_)*blockSize;
+
+  sourceCode << std::endl;
+  if (useOpenMp)
   {
-    std::string fileContents = simdSource.str();
-    simdSourceFile << fileContents;
-    simdSourceFile.close();
+    sourceCode << "  #pragma omp parallel for" << std::endl;
   }
-  compilerCommand_ = C_COMPILER_COMMAND;
-  additionalCompileFlags_ = "";
-  sourceFileSuffix_ = ".c";
+  sourceCode << "  for (int blockBegin = 0; blockBegin < nInstances; blockBegin += " << blockSize << ")" << std::endl
+    << "  {" << std::endl
+    << "    const int nInstancesBlock = (nInstances - blockBegin < " << blockSize << "? nInstances - blockBegin : " << blockSize << ");" << std::endl
+    << "    double statesBlock[" << nStatesBlock << "];" << std::endl
+    << "    double ratesBlock[" << nStatesBlock << "];" << std::endl
+    << "    double statesPreliminaryBlock[" << nStatesBlock << "];" << std::endl
+    << "    double ratesPreliminaryBlock[" << nStatesBlock << "];" << std::endl
+    << "    double algebraicsBlock[" << nAlgebraicsBlock << "];" << std::endl
+    << "    double parametersBlock[" << nParametersBlock << "];" << std::endl
+    << std::endl
+    << "    /* load the values of the block, the remaining entries of the last block are filled with the values of the last instance */" << std::endl
+    << "    for (int k = 0; k < " << blockSize << "; k++)" << std::endl
+    << "    {" << std::endl
+    << "      const int i = blockBegin + (k < nInstancesBlock? k : nInstancesBlock-1);" << std::endl
+    << "      for (int stateNo = 0; stateNo < " << this->nStates_ << "; stateNo++)" << std::endl
+    << "        statesBlock[stateNo*" << blockSize << "+k] = states[stateNo*nInstances+i];" << std::endl
+    << "      for (int algebraicNo = 0; algebraicNo < " << this->nAlgebraics_ << "; algebraicNo++)" << std::endl
+    << "        algebraicsBlock[algebraicNo*" << blockSize << "+k] = algebraics[algebraicNo*nInstances+i];" << std::endl
+    << "      for (int parameterNo = 0; parameterNo < " << this->nParameters_ << "; parameterNo++)" << std::endl
+    << "        parametersBlock[parameterNo*" << blockSize << "+k] = parameters[parameterNo*nInstances+i];" << std::endl
+    << "    }" << std::endl
+    << std::endl;
+
+  // write the rhs code for all instances of the block, using the given arrays for the states and rates
+  auto writeRightHandSide = [&sourceCode,this,blockSize](std::string statesName, std::string ratesName)
+  {
+    sourceCode << "#ifndef TEST_WITHOUT_PRAGMAS" << std::endl
+      << "      #pragma omp simd" << std::endl
+      << "#endif" << std::endl
+      << "      for (int k = 0; k < " << blockSize << "; k++)" << std::endl
+      << "      {" << std::endl;
+
+    for (code_expression_t &codeExpression : cellMLCode_.lines)
+    {
+      if (codeExpression.type == code_expression_t::commented_out)
+        continue;
+
+      sourceCode << "        ";
+      codeExpression.visitLeafs([&sourceCode,&statesName,&ratesName,blockSize](CellmlSourceCodeGeneratorSimd::code_expression_t &expression, bool isFirstVariable)
+      {
+        switch(expression.type)
+        {
+        case code_expression_t::variableName:
+
+          if (expression.code == "CONSTANTS")
+          {
+            // constants only exist once for all instances
+            sourceCode << expression.code << "[" << expression.arrayIndex << "]";
+          }
+          else
+          {
+            // all other variables (states, rates, algebraics, parameters) exist for every instance of the block
+            std::string arrayName = expression.code + "Block";
+            if (expression.code == "states")
+              arrayName = statesName;
+            else if (expression.code == "rates")
+              arrayName = ratesName;
+
+            sourceCode << arrayName << "[" << expression.arrayIndex << "*" << blockSize << "+k]";
+          }
+          break;
+
+        case code_expression_t::otherCode:
+          sourceCode << expression.code;
+          break;
+
+        default:
+          break;
+        };
+      });
+      sourceCode << std::endl;
+    }
+    sourceCode << "      }" << std::endl;
+  };
+
+  sourceCode << "    for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)" << std::endl
+    << "    {" << std::endl
+    << "      double VOI = startTime + timeStepNo*timeStepWidth;   /* current simulation time */" << std::endl
+    << std::endl
+    << "      /* compute rates = f(u_t) */" << std::endl;
+
+  writeRightHandSide("statesBlock", "ratesBlock");
+
+  sourceCode << std::endl
+    << "      if (!useHeun)" << std::endl
+    << "      {" << std::endl
+    << "        /* explicit Euler: u_{t+1} = u_t + dt*f(u_t) */" << std::endl
+    << "        for (int j = 0; j < " << nStatesBlock << "; j++)" << std::endl
+    << "          statesBlock[j] += timeStepWidth*ratesBlock[j];" << std::endl
+    << "        continue;" << std::endl
+    << "      }" << std::endl
+    << std::endl
+    << "      /* Heun: u* = u_t + dt*f(u_t) */" << std::endl
+    << "      for (int j = 0; j < " << nStatesBlock << "; j++)" << std::endl
+    << "        statesPreliminaryBlock[j] = statesBlock[j] + timeStepWidth*ratesBlock[j];" << std::endl
+    << std::endl
+    << "      /* compute f(u*) */" << std::endl
+    << "      VOI += timeStepWidth;" << std::endl;
+
+  writeRightHandSide("statesPreliminaryBlock", "ratesPreliminaryBlock");
+
+  sourceCode << std::endl
+    << "      /* u_{t+1} = u_t + 0.5*dt*(f(u_t) + f(u*)) */" << std::endl
+    << "      for (int j = 0; j < " << nStatesBlock << "; j++)" << std::endl
+    << "        statesBlock[j] += 0.5*timeStepWidth*(ratesBlock[j] + ratesPreliminaryBlock[j]);" << std::endl
+    << "    }" << std::endl
+    << std::endl
+    << "    /* store the new states and the algebraics of the last rhs evaluation */" << std::endl
+    << "    for (int k = 0; k < nInstancesBlock; k++)" << std::endl
+    << "    {" << std::endl
+    << "      for (int stateNo = 0; stateNo < " << this->nStates_ << "; stateNo++)" << std::endl
+    << "        states[stateNo*nInstances+blockBegin+k] = statesBlock[stateNo*" << blockSize << "+k];" << std::endl
+    << "      for (int algebraicNo = 0; algebraicNo < " << this->nAlgebraics_ << "; algebraicNo++)" << std::endl
+    << "        algebraics[algebraicNo*nInstances+blockBegin+k] = algebraicsBlock[algebraicNo*" << blockSize << "+k];" << std::endl
+    << "    }" << std::endl
+    << "  }" << std::endl
+    << "}" << std::endl << std::endl;
+
+  return sourceCode.str();
 }
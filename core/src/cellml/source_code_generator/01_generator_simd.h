@@ -12,8 +12,13 @@ public:
 
 protected:
 
-  //! write the source file with openmp pragmas in struct-of-array memory ordering
-  //! that will be autovectorized by the compiler
-  void generateSourceFileSimd(std::string outputFilename);
+  //! generate the source code with openmp pragmas in struct-of-array memory ordering
+  //! that will be autovectorized by the compiler, store it in generatedSourceCode_
+  void generateSourceCodeSimd();
+
+  //! generate the function computeCellMLTimeStepsNInstances that computes multiple explicit Euler or Heun steps at once.
+  //! The instances are processed in blocks, the values of a block are kept in local arrays for all time steps.
+  //! @param useOpenMp if the blocks should be distributed to the threads by an openmp pragma
+  std::string generateTimeStepsCode(bool useOpenMp);
 
 };
@@ -11,20 +11,18 @@
 #include "easylogging++.h"
 
 void CellmlSourceCodeGeneratorOpenMp::
-generateSourceFileOpenMP(std::string outputFilename, int maximumNumberOfThreads)
+generateSourceCodeOpenMP(int maximumNumberOfThreads)
 {
   std::stringstream sourceCode;
   sourceCode << "#include <math.h>" << std::endl
     << "#include <omp.h>" << std::endl
     << cellMLCode_.header << std::endl;
 
-  auto t = std::time(nullptr);
-  auto tm = *std::localtime(&t);
-  sourceCode << std::endl << "/* This function was created by opendihu at " << StringUtility::timeToString(&tm)  //std::put_time(&tm, "%d/%m/%Y %H:%M:%S")
-    << ".\n * It is designed for " << this->nInstances_ << " instances of the CellML problem.\n "
+  sourceCode << std::endl << "/* This function was created by opendihu.\n"
+    << " * The number of instances of the CellML problem is given by the argument nInstances.\n "
     << " * The \"optimizationType\" is \"openmp\". (Other options are \"vc\", \"simd\" and \"gpu\".) */" << std::endl
-    << "void computeCellMLRightHandSide("
-    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters)" << std::endl << "{" << std::endl;
+    << "void computeCellMLRightHandSideNInstances("
+    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters, int nInstances)" << std::endl << "{" << std::endl;
 
   if (maximumNumberOfThreads > 0)
   {
@@ -43,7 +41,7 @@ generateSourceFileOpenMP(std::string outputFilename, int maximumNumberOfThreads)
 
   sourceCode << std::endl
     << "  #pragma omp parallel for" << std::endl
-    << "  for (int i = 0; i < " << this->nInstances_ << "; i++)" << std::endl
+    << "  for (int i = 0; i < nInstances; i++)" << std::endl
     << "  {" << std::endl;
 
   // loop over lines of cellml code
@@ -68,7 +66,7 @@ generateSourceFileOpenMP(std::string outputFilename, int maximumNumberOfThreads)
           else
           {
             // all other variables (states, rates, algebraics, parameters) exist for every instance
-            sourceCode << expression.code << "[" << expression.arrayIndex * this->nInstances_ << "+i]";
+            sourceCode << expression.code << "[" << expression.arrayIndex << "*nInstances+i]";
           }
           break;
 
@@ -95,22 +93,13 @@ generateSourceFileOpenMP(std::string outputFilename, int maximumNumberOfThreads)
   // add footer
   sourceCode << cellMLCode_.footer << std::endl;
 
+  // add code that computes multiple time steps at once
+  sourceCode << generateTimeStepsCode(true);
+
   // add code for a single instance
   sourceCode << singleInstanceCode_;
 
-  // write out source file
-  std::ofstream sourceCodeFile;
-  OutputWriter::Generic::openFile(sourceCodeFile, outputFilename);
-  if (!sourceCodeFile.is_open())
-  {
-    LOG(FATAL) << "Could not write to file \"" << outputFilename << "\".";
-  }
-  else
-  {
-    std::string fileContents = sourceCode.str();
-    sourceCodeFile << fileContents;
-    sourceCodeFile.close();
-  }
+  generatedSourceCode_ = sourceCode.str();
 
   additionalCompileFlags_ = "-fopenmp";
   compilerCommand_ = C_COMPILER_COMMAND;
@@ -12,9 +12,9 @@ public:
 
 protected:
 
-  //! write the source file with openmp support
+  //! generate the source code with openmp support, store it in generatedSourceCode_
   //! @param maximumNumberOfThreads how many threads there should be at maximum
-  void generateSourceFileOpenMP(std::string outputFilename, int maximumNumberOfThreads);
+  void generateSourceCodeOpenMP(int maximumNumberOfThreads);
 
 
 };
@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
 #include "easylogging++.h"
 
 void CellmlSourceCodeGeneratorVc::preprocessCode(std::set<std::string> &helperFunctions, bool useVc)
@@ -617,7 +618,7 @@ Vc::double_v pow(Vc::double_v basis, double exponent)
 }
 
 void CellmlSourceCodeGeneratorVc::
-generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunction, bool useAoVSMemoryLayout)
+generateSourceCodeVc(bool approximateExponentialFunction, bool useAoVSMemoryLayout)
 {
   std::set<std::string> helperFunctions;   //< functions found in the CellML code that need to be provided, usually the pow2, pow3, etc. helper functions for pow(..., 2), pow(...,3) etc.
 
@@ -629,6 +630,8 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
   std::stringstream sourceCode;
   sourceCode << "#include <math.h>" << std::endl
     << "#include <iostream>" << std::endl
+    << "#include <algorithm>" << std::endl
+    << "#include <memory>" << std::endl
     << "#include <vc_or_std_simd.h>  // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available" << std::endl
     << cellMLCode_.header << std::endl
     << "using Vc::double_v; " << std::endl;
@@ -636,10 +639,8 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
   // define helper functions
   sourceCode << defineHelperFunctions(helperFunctions, approximateExponentialFunction, true);
 
-  auto t = std::time(nullptr);
-  auto tm = *std::localtime(&t);
-  sourceCode << std::endl << "// This function was created by opendihu at " << StringUtility::timeToString(&tm)  //std::put_time(&tm, "%d/%m/%Y %H:%M:%S")
-    << ".\n// It is designed for " << this->nInstances_ << " instances of the CellML problem.\n"
+  sourceCode << std::endl << "// This function was created by opendihu.\n"
+    << "// The number of instances of the CellML problem is given by the argument nInstances.\n"
     << "// The \"optimizationType\" is \"vc\". (Other options are \"simd\", \"openmp\" and \"gpu\".)" << std::endl;
     
   if (!parametersUsedAsAlgebraic_.empty())
@@ -673,13 +674,13 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
 
     
   sourceCode << "#ifdef __cplusplus\n" << "extern \"C\"\n" << "#endif\n" << std::endl
-    << "void computeCellMLRightHandSide("
-    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters)" << std::endl 
+    << "void computeCellMLRightHandSideNInstances("
+    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters, int nInstances)" << std::endl
     << "{" << std::endl
     << "  // assert that Vc::double_v::size() is the same as in opendihu, otherwise there will be problems\n"
     << "  if (Vc::double_v::size() != " << Vc::double_v::size() << ")\n"
     << "  {\n"
-    << "    std::cout << \"Fatal error in compiled library of source file \\\"" << outputFilename << "\\\", size of SIMD register in "
+    << "    std::cout << \"Fatal error in compiled CellML library, size of SIMD register in "
     << "compiled code (\" << Vc::double_v::size() << \") does not match opendihu code (" << Vc::double_v::size() << ").\" << std::endl;\n"
     << "    std::cout << \"Delete library such that it will be regenerated with the correct compile options!\" << std::endl;\n"
     << "    exit(1);\n"
@@ -697,19 +698,28 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
 
   // add declaration of algebraic variables
   sourceCode << std::endl;
-  const int nVcVectors = (int)(ceil((double)this->nInstances_ / Vc::double_v::size()));
   const int nParametersPerInstance = this->nAlgebraics_;
 
   sourceCode << std::endl
-    << "  const int nInstances = " << this->nInstances_ << ";\n"
     << "  const int nStates = " << this->nStates_ << ";\n"
     << "  const int nAlgebraics = " << this->nAlgebraics_ << ";\n"
     << "  const int nParametersPerInstance = " << nParametersPerInstance << ";\n"
-    << "  const int nVcVectors = " << nVcVectors << ";  // ceil(" << this->nInstances_ << " instances / VcSize " << Vc::double_v::size() << ")" << std::endl
-    << "  Vc::double_v statesVc[nStates*nVcVectors];  // " << this->nStates_ << " states * " << nVcVectors << " vectors" << std::endl
-    << "  Vc::double_v ratesVc[nStates*nVcVectors];   // " << this->nStates_ << " rates  * " << nVcVectors << " vectors" << std::endl
-    << "  Vc::double_v algebraicsVc[nAlgebraics*nVcVectors];  // " << this->nAlgebraics_ << " algebraics  * " << nVcVectors << " vectors" << std::endl
-    << "  Vc::double_v parametersVc[nParametersPerInstance*nVcVectors];  // " << nParametersPerInstance << " parameters  * " << nVcVectors << " vectors" << std::endl
+    << "  const int nVcVectors = (nInstances + (int)Vc::double_v::size() - 1) / (int)Vc::double_v::size();  // ceil(nInstances / VcSize)" << std::endl
+    << "\n"
+    << "  // buffers of the vectorized values, they are only reallocated when the number of instances grows and freed when the thread exits\n"
+    << "  static thread_local int nAllocatedVcVectors = 0;\n"
+    << "  static thread_local std::unique_ptr<Vc::double_v[]> statesVc;      // nStates * nVcVectors\n"
+    << "  static thread_local std::unique_ptr<Vc::double_v[]> ratesVc;       // nStates * nVcVectors\n"
+    << "  static thread_local std::unique_ptr<Vc::double_v[]> algebraicsVc;  // nAlgebraics * nVcVectors\n"
+    << "  static thread_local std::unique_ptr<Vc::double_v[]> parametersVc;  // nParametersPerInstance * nVcVectors\n"
+    << "  if (nVcVectors > nAllocatedVcVectors)\n"
+    << "  {\n"
+    << "    statesVc.reset(new Vc::double_v[nStates*nVcVectors]);\n"
+    << "    ratesVc.reset(new Vc::double_v[nStates*nVcVectors]);\n"
+    << "    algebraicsVc.reset(new Vc::double_v[std::max(1,nAlgebraics*nVcVectors)]);\n"
+    << "    parametersVc.reset(new Vc::double_v[std::max(1,nParametersPerInstance*nVcVectors)]);\n"
+    << "    nAllocatedVcVectors = nVcVectors;\n"
+    << "  }\n"
     << "\n"
     << "  // fill input vectors of states and parameters\n"
     << "  for (int stateNo = 0; stateNo < nStates; stateNo++)\n"
@@ -738,7 +748,7 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
     {
       sourceCode << "    ";
 
-      codeExpression.visitLeafs([&sourceCode,&nVcVectors,&useAoVSMemoryLayout,this](CellmlSourceCodeGeneratorVc::code_expression_t &expression, bool isFirstVariable)
+      codeExpression.visitLeafs([&sourceCode,&useAoVSMemoryLayout,this](CellmlSourceCodeGeneratorVc::code_expression_t &expression, bool isFirstVariable)
       {
         switch(expression.type)
         {
@@ -757,28 +767,28 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
                 if (useAoVSMemoryLayout)
                   sourceCode << "statesVc[i*nStates + " << expression.arrayIndex << "]";
                 else
-                  sourceCode << "statesVc[" << expression.arrayIndex * nVcVectors << "+i]";
+                  sourceCode << "statesVc[" << expression.arrayIndex << "*nVcVectors+i]";
               }
               else if (expression.code == "rates")
               {
                 if (useAoVSMemoryLayout)
                   sourceCode << "ratesVc[i*nStates + " << expression.arrayIndex << "]";
                 else
-                  sourceCode << "ratesVc[" << expression.arrayIndex * nVcVectors << "+i]";
+                  sourceCode << "ratesVc[" << expression.arrayIndex << "*nVcVectors+i]";
               }
               else if (expression.code == "algebraics")
               {
                 if (useAoVSMemoryLayout)
                   sourceCode << "algebraicsVc[i*nAlgebraics + " << expression.arrayIndex << "]";
                 else
-                  sourceCode << "algebraicsVc[" << expression.arrayIndex * nVcVectors << "+i]";
+                  sourceCode << "algebraicsVc[" << expression.arrayIndex << "*nVcVectors+i]";
               }
               else if (expression.code == "parameters")
               {
                 if (useAoVSMemoryLayout)
                   sourceCode << "parametersVc[i*nParametersPerInstance + " << expression.arrayIndex << "]";
                 else
-                  sourceCode << "parametersVc[" << expression.arrayIndex * nVcVectors << "+i]";
+                  sourceCode << "parametersVc[" << expression.arrayIndex << "*nVcVectors+i]";
               }
               else
               {
@@ -836,22 +846,13 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
   // add footer
   sourceCode << cellMLCode_.footer << std::endl;
 
+  // add code that computes multiple time steps at once
+  sourceCode << generateTimeStepsCodeVc();
+
   // add code for a single instance
   sourceCode << singleInstanceCode_;
   
-  // write out source file
-  std::ofstream sourceCodeFile;
-  OutputWriter::Generic::openFile(sourceCodeFile, outputFilename);
-  if (!sourceCodeFile.is_open())
-  {
-    LOG(FATAL) << "Could not write to file \"" << outputFilename << "\".";
-  }
-  else
-  {
-    std::string fileContents = sourceCode.str();
-    sourceCodeFile << fileContents;
-    sourceCodeFile.close();
-  }
+  generatedSourceCode_ = sourceCode.str();
 
   std::stringstream s;
   s << "-lVc -I\"" << OPENDIHU_HOME << "/dependencies/vc/install/include\" "
@@ -870,6 +871,151 @@ generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunc
   sourceFileSuffix_ = ".cpp";
 }
 
+std::string CellmlSourceCodeGeneratorVc::
+generateTimeStepsCodeVc()
+{
+  std::stringstream sourceCode;
+  sourceCode << std::endl << "// This function was created by opendihu.\n"
+    << "// It computes nTimeSteps explicit Euler steps (useHeun=0) or Heun steps (useHeun=1) for nInstances instances.\n"
+    << "// The values of every Vc vector of instances are kept in local variables for all time steps." << std::endl
+    << "#ifdef __cplusplus\n" << "extern \"C\"\n" << "#endif\n"
+    << "void computeCellMLTimeStepsNInstances(void *context, double startTime, double timeStepWidth, int nTimeSteps, int useHeun, "
+    << "double *states, double *algebraics, double *parameters, int nInstances)" << std::endl
+    << "{" << std::endl;
+
+  sourceCode << "  /* define constants */" << std::endl
+    << "  double CONSTANTS[" << this->nConstants_ << "];" << std::endl;
+
+  // add assignments of constant values
+  for (std::string constantAssignmentsLine : constantAssignments_)
+  {
+    sourceCode << "  " << constantAssignmentsLine << std::endl;
+  }
+
+  sourceCode << std::endl
+    << "  const int nStates = " << this->nStates_ << ";\n"
+    << "  const int nAlgebraics = " << this->nAlgebraics_ << ";\n"
+    << "  const int nParameters = " << this->nParameters_ << ";\n"
+    << "  const int nVcVectors = (nInstances + (int)Vc::double_v::size() - 1) / (int)Vc::double_v::size();  // ceil(nInstances / VcSize)" << std::endl
+    << std::endl
+    << "  for (int i = 0; i < nVcVectors; i++)" << std::endl
+    << "  {" << std::endl
+    << "    Vc::double_v statesVc[" << std::max(1u, this->nStates_) << "];" << std::endl
+    << "    Vc::double_v ratesVc[" << std::max(1u, this->nStates_) << "];" << std::endl
+    << "    Vc::double_v statesPreliminaryVc[" << std::max(1u, this->nStates_) << "];" << std::endl
+    << "    Vc::double_v ratesPreliminaryVc[" << std::max(1u, this->nStates_) << "];" << std::endl
+    << "    Vc::double_v algebraicsVc[" << std::max(1u, this->nAlgebraics_) << "];" << std::endl
+    << "    Vc::double_v parametersVc[" << std::max(1, this->nParameters_) << "];" << std::endl
+    << std::endl
+    << "    // load the values of the instances, the remaining entries of the last Vc vector are filled with the values of the last instance\n"
+    << "    for (int k = 0; k < Vc::double_v::size(); k++)  // entry no in Vc vector\n"
+    << "    {\n"
+    << "      const int instanceNo = std::min(i*(int)Vc::double_v::size()+k, nInstances-1);\n"
+    << "      for (int stateNo = 0; stateNo < nStates; stateNo++)\n"
+    << "        statesVc[stateNo][k] = states[stateNo*nInstances + instanceNo];\n"
+    << "      for (int algebraicNo = 0; algebraicNo < nAlgebraics; algebraicNo++)\n"
+    << "        algebraicsVc[algebraicNo][k] = algebraics[algebraicNo*nInstances + instanceNo];\n"
+    << "      for (int parameterNo = 0; parameterNo < nParameters; parameterNo++)\n"
+    << "        parametersVc[parameterNo][k] = parameters[parameterNo*nInstances + instanceNo];\n"
+    << "    }\n"
+    << std::endl;
+
+  // write the rhs code for one Vc vector of instances, using the given arrays for the states and rates
+  auto writeRightHandSide = [&sourceCode,this](std::string statesName, std::string ratesName)
+  {
+    for (code_expression_t &codeExpression : cellMLCode_.lines)
+    {
+      if (codeExpression.type == code_expression_t::commented_out)
+        continue;
+
+      sourceCode << "      ";
+      codeExpression.visitLeafs([&sourceCode,&statesName,&ratesName](CellmlSourceCodeGeneratorVc::code_expression_t &expression, bool isFirstVariable)
+      {
+        switch(expression.type)
+        {
+          case code_expression_t::variableName:
+
+            if (expression.code == "CONSTANTS")
+            {
+              // constants only exist once for all instances
+              sourceCode << expression.code << "[" << expression.arrayIndex << "]";
+            }
+            else if (expression.code == "states")
+            {
+              sourceCode << statesName << "[" << expression.arrayIndex << "]";
+            }
+            else if (expression.code == "rates")
+            {
+              sourceCode << ratesName << "[" << expression.arrayIndex << "]";
+            }
+            else
+            {
+              // algebraics and parameters
+              sourceCode << expression.code << "Vc[" << expression.arrayIndex << "]";
+            }
+            break;
+
+          case code_expression_t::otherCode:
+            sourceCode << expression.code;
+            break;
+
+          default:
+            break;
+        }
+      });
+      sourceCode << std::endl;
+    }
+  };
+
+  sourceCode << "    for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)" << std::endl
+    << "    {" << std::endl
+    << "      double VOI = startTime + timeStepNo*timeStepWidth;   // current simulation time" << std::endl
+    << std::endl
+    << "      // compute rates = f(u_t)" << std::endl;
+
+  writeRightHandSide("statesVc", "ratesVc");
+
+  sourceCode << std::endl
+    << "      if (!useHeun)\n"
+    << "      {\n"
+    << "        // explicit Euler: u_{t+1} = u_t + dt*f(u_t)\n"
+    << "        for (int stateNo = 0; stateNo < nStates; stateNo++)\n"
+    << "          statesVc[stateNo] += timeStepWidth*ratesVc[stateNo];\n"
+    << "        continue;\n"
+    << "      }\n"
+    << "\n"
+    << "      // Heun: u* = u_t + dt*f(u_t)\n"
+    << "      for (int stateNo = 0; stateNo < nStates; stateNo++)\n"
+    << "        statesPreliminaryVc[stateNo] = statesVc[stateNo] + timeStepWidth*ratesVc[stateNo];\n"
+    << "\n"
+    << "      // compute f(u*)\n"
+    << "      VOI += timeStepWidth;\n";
+
+  writeRightHandSide("statesPreliminaryVc", "ratesPreliminaryVc");
+
+  sourceCode << std::endl
+    << "      // u_{t+1} = u_t + 0.5*dt*(f(u_t) + f(u*))\n"
+    << "      for (int stateNo = 0; stateNo < nStates; stateNo++)\n"
+    << "        statesVc[stateNo] += 0.5*timeStepWidth*(ratesVc[stateNo] + ratesPreliminaryVc[stateNo]);\n"
+    << "    }\n"
+    << "\n"
+    << "    // store the new states and the algebraics of the last rhs evaluation\n"
+    << "    for (int k = 0; k < Vc::double_v::size(); k++)  // entry no in Vc vector\n"
+    << "    {\n"
+    << "      const int instanceNo = i*(int)Vc::double_v::size()+k;\n"
+    << "      if (instanceNo >= nInstances)\n"
+    << "        break;\n"
+    << "      for (int stateNo = 0; stateNo < nStates; stateNo++)\n"
+    << "        states[stateNo*nInstances + instanceNo] = statesVc[stateNo][k];\n"
+    << "      for (int algebraicNo = 0; algebraicNo < nAlgebraics; algebraicNo++)\n"
+    << "        algebraics[algebraicNo*nInstances + instanceNo] = algebraicsVc[algebraicNo][k];\n"
+    << "    }\n"
+    << "  }\n"
+    << "}\n\n";
+
+  return sourceCode.str();
+}
+
 void CellmlSourceCodeGeneratorVc::
 generateSourceFileFastMonodomain(std::string outputFilename, bool approximateExponentialFunction)
 {
@@ -32,9 +32,13 @@ protected:
   //! define "pow" and "exponential" helper functions
   std::string defineHelperFunctions(std::set<std::string> &helperFunctions, bool approximateExponentialFunction, bool useVc, bool useReal = true);
 
-  //! Write the source file with explicit vectorization using Vc
-  //! The file contains the source for only the rhs computation
-  void generateSourceFileVc(std::string outputFilename, bool approximateExponentialFunction, bool useAoVSMemoryLayout=false);
+  //! Generate the source code with explicit vectorization using Vc, store it in generatedSourceCode_
+  //! The code contains only the rhs computation
+  void generateSourceCodeVc(bool approximateExponentialFunction, bool useAoVSMemoryLayout=false);
+
+  //! generate the function computeCellMLTimeStepsNInstances that computes multiple explicit Euler or Heun steps at once.
+  //! For every Vc vector of instances, the values are kept in local Vc::double_v variables for all time steps.
+  std::string generateTimeStepsCodeVc();
 
   bool preprocessingDone_ = false;      //< if preprocessing of the code tree has been done already
   std::string helperFunctionsCode_;     //< code with all helper functions like pow, exponential
@@ -11,20 +11,18 @@
 #include "easylogging++.h"
 
 void CellmlSourceCodeGeneratorGpu::
-generateSourceFileGpu(std::string outputFilename)
+generateSourceCodeGpu()
 {
   std::stringstream sourceCode;
   sourceCode << "#include <math.h>" << std::endl
     << "#include <omp.h>" << std::endl
     << cellMLCode_.header << std::endl;
 
-  auto t = std::time(nullptr);
-  auto tm = *std::localtime(&t);
-  sourceCode << std::endl << "/* This function was created by opendihu at " << StringUtility::timeToString(&tm)  //std::put_time(&tm, "%d/%m/%Y %H:%M:%S")
-    << ".\n * It is designed for " << this->nInstances_ << " instances of the CellML problem.\n "
+  sourceCode << std::endl << "/* This function was created by opendihu.\n"
+    << " * The number of instances of the CellML problem is given by the argument nInstances.\n "
     << " * The \"optimizationType\" is \"gpu\". (Other options are \"vc\", \"openmp\" and \"simd\".) */" << std::endl
-    << "void computeCellMLRightHandSide("
-    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters)" << std::endl << "{" << std::endl;
+    << "void computeCellMLRightHandSideNInstances("
+    << "void *context, double t, double *states, double *rates, double *algebraics, double *parameters, int nInstances)" << std::endl << "{" << std::endl;
 
   sourceCode << "  double VOI = t;   /* current simulation time */" << std::endl;
   sourceCode << std::endl << "  /* define constants */" << std::endl
@@ -38,7 +36,7 @@ generateSourceFileGpu(std::string outputFilename)
 
   sourceCode << std::endl
     << "  #pragma omp target parallel for map(to:states,t,parameters) map(from:rates,algebraics)" << std::endl
-    << "  for (int i = 0; i < " << this->nInstances_ << "; i++)" << std::endl
+    << "  for (int i = 0; i < nInstances; i++)" << std::endl
     << "  {" << std::endl;
 
   // loop over lines of cellml code
@@ -63,7 +61,7 @@ generateSourceFileGpu(std::string outputFilename)
           else
           {
             // all other variables (states, rates, algebraics, parameters) exist for every instance
-            sourceCode << expression.code << "[" << expression.arrayIndex * this->nInstances_ << "+i]";
+            sourceCode << expression.code << "[" << expression.arrayIndex << "*nInstances+i]";
           }
           break;
 
@@ -93,19 +91,7 @@ generateSourceFileGpu(std::string outputFilename)
   // add code for a single instance
   sourceCode << singleInstanceCode_;
 
-  // write out source file
-  std::ofstream sourceCodeFile;
-  OutputWriter::Generic::openFile(sourceCodeFile, outputFilename);
-  if (!sourceCodeFile.is_open())
-  {
-    LOG(FATAL) << "Could not write to file \"" << outputFilename << "\".";
-  }
-  else
-  {
-    std::string fileContents = sourceCode.str();
-    sourceCodeFile << fileContents;
-    sourceCodeFile.close();
-  }
+  generatedSourceCode_ = sourceCode.str();
 
   additionalCompileFlags_ = "-fopenmp -foffload=\"-O3 -lm\"";
   compilerCommand_ = C_COMPILER_COMMAND;
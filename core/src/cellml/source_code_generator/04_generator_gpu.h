@@ -18,6 +18,6 @@ public:
 
 protected:
 
-  //! write the source file with openmp support
-  void generateSourceFileGpu(std::string outputFilename);
+  //! generate the source code with openmp offloading support, store it in generatedSourceCode_
+  void generateSourceCodeGpu();
 };
@@ -2,23 +2,23 @@
 
 #include <Python.h>  // has to be the first included header
 
-void CellmlSourceCodeGenerator::generateSourceFile(std::string outputFilename, std::string optimizationType, 
-                                                   bool approximateExponentialFunction, int maximumNumberOfThreads, bool useAoVSMemoryLayout)
+void CellmlSourceCodeGenerator::generateSourceCode(std::string optimizationType, bool approximateExponentialFunction,
+                                                   int maximumNumberOfThreads, bool useAoVSMemoryLayout)
 {
   if (optimizationType == "vc")
   {
-    generateSourceFileVc(outputFilename, approximateExponentialFunction, useAoVSMemoryLayout);
+    generateSourceCodeVc(approximateExponentialFunction, useAoVSMemoryLayout);
   }
   else if (optimizationType == "simd")
   {
-    generateSourceFileSimd(outputFilename);
+    generateSourceCodeSimd();
   }
   else if (optimizationType == "openmp")
   {
-    generateSourceFileOpenMP(outputFilename, maximumNumberOfThreads);
+    generateSourceCodeOpenMP(maximumNumberOfThreads);
   }
   else if (optimizationType == "gpu")
   {
-    generateSourceFileGpu(outputFilename);
+    generateSourceCodeGpu();
   }
 }
@@ -11,11 +11,11 @@ public:
   //! constructor
   using CellmlSourceCodeGeneratorGpu::CellmlSourceCodeGeneratorGpu;
 
-  //! generate the source file according to optimizationType
+  //! generate the source code according to optimizationType, afterwards it can be retrieved by generatedSourceCode()
   //! Possible values are: simd vc openmp gpu
+  //! The generated function computeCellMLRightHandSideNInstances gets the number of instances as argument, such that the code is the same on all ranks.
   //! @param approximateExponentialFunction If the exp()-Function should be approximated by the n=1024th series term
   //! @param maximumNumberOfThreads value for the openmp optimization type
   //! @param useAoVSMemoryLayout which memory layout to use for the vc optimization type, true=Array-of-Vectorized-Struct, false=Struct-of-Vectorized-Array
-  void generateSourceFile(std::string outputFilename, std::string optimizationType,
-                          bool approximateExponentialFunction, int maximumNumberOfThreads, bool useAoVSMemoryLayout);
+  void generateSourceCode(std::string optimizationType, bool approximateExponentialFunction, int maximumNumberOfThreads, bool useAoVSMemoryLayout);
 };
@@ -0,0 +1,655 @@
+#include "control/checkpointing/checkpointing.h"
+
+#include <Python.h>  // has to be the first included header
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "easylogging++.h"
+#include "control/dihu_context.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+#include "utility/mpi_utility.h"
+
+namespace Control
+{
+
+namespace
+{
+  const char checkpointMagic[8] = {'D','I','H','U','C','K','P','T'};   //< identifier at the beginning of every checkpoint file
+  const std::int32_t checkpointVersion = 1;                           //< version of the file format
+  const std::int64_t fixedHeaderSize = 24;                            //< size of magic, version, nRanks and time
+  const std::int64_t maximumChunkSize = 1LL << 30;                    //< maximum size of a single MPI-IO call, because the count is an int
+
+  //! append the bytes of a value to a buffer
+  template<typename T>
+  void appendToBuffer(std::vector<char> &buffer, const T *data, std::size_t nEntries)
+  {
+    const char *bytes = reinterpret_cast<const char *>(data);
+    buffer.insert(buffer.end(), bytes, bytes + nEntries*sizeof(T));
+  }
+
+  //! read a value from a buffer at the given position and advance the position, @return false if the buffer is too short
+  template<typename T>
+  bool readFromBuffer(const std::vector<char> &buffer, std::size_t &position, T *data, std::size_t nEntries)
+  {
+    const std::size_t nBytes = nEntries*sizeof(T);
+    if (position + nBytes > buffer.size())
+      return false;
+    std::memcpy(data, buffer.data() + position, nBytes);
+    position += nBytes;
+    return true;
+  }
+}
+
+bool Checkpointing::enabled_ = false;
+bool Checkpointing::restart_ = false;
+bool Checkpointing::stateRegistrationRequested_ = false;
+bool Checkpointing::outermostSolverClaimed_ = false;
+bool Checkpointing::isRestart_ = false;
+std::string Checkpointing::filename_;
+double Checkpointing::interval_ = 0;
+double Checkpointing::wallTimeInterval_ = 0;
+double Checkpointing::wallTimeLimit_ = 0;
+double Checkpointing::startWallTime_ = 0;
+double Checkpointing::lastCheckpointTime_ = 0;
+double Checkpointing::lastCheckpointWallTime_ = 0;
+
+bool Checkpointing::writePending_ = false;
+double Checkpointing::pendingTime_ = 0;
+MPI_File Checkpointing::pendingFile_;
+std::vector<MPI_Request> Checkpointing::pendingRequests_;
+std::vector<char> Checkpointing::headerBuffer_;
+std::vector<char> Checkpointing::writeBuffer_;
+
+void Checkpointing::initialize(PythonConfig settings)
+{
+  // a checkpoint of a previous context has to be completed first
+  finishPendingWrite();
+
+  filename_ = settings.getOptionString("filename", "checkpoints/checkpoint");
+  interval_ = settings.getOptionDouble("interval", 0.0, PythonUtility::NonNegative);
+  wallTimeInterval_ = settings.getOptionDouble("wallTimeInterval", 0.0, PythonUtility::NonNegative);
+  wallTimeLimit_ = settings.getOptionDouble("wallTimeLimit", 0.0, PythonUtility::NonNegative);
+  restart_ = settings.getOptionBool("restart", false);
+
+  enabled_ = !filename_.empty() && (interval_ > 0 || wallTimeInterval_ > 0 || restart_);
+  stateRegistrationRequested_ = false;
+  outermostSolverClaimed_ = false;
+
+  // the existence of the checkpoint file is checked by every rank, such that no communication is needed, later checkpoints of this run do not count
+  isRestart_ = false;
+  if (enabled_ && restart_)
+  {
+    std::ifstream file(filename_.c_str(), std::ios::in | std::ios::binary);
+    isRestart_ = file.is_open();
+  }
+
+  lastCheckpointTime_ = 0;
+  lastCheckpointWallTime_ = MPI_Wtime();
+  startWallTime_ = lastCheckpointWallTime_;
+
+  registry().states.clear();
+  registry().nRegistrations.clear();
+
+  LOG(DEBUG) << "Checkpointing: filename \"" << filename_ << "\", interval " << interval_ << ", wallTimeInterval " << wallTimeInterval_
+    << " s, wallTimeLimit " << wallTimeLimit_ << " s, restart: " << std::boolalpha << restart_ << ", enabled: " << enabled_;
+}
+
+void Checkpointing::reset()
+{
+  finishPendingWrite();
+
+  enabled_ = false;
+  restart_ = false;
+  stateRegistrationRequested_ = false;
+  outermostSolverClaimed_ = false;
+  isRestart_ = false;
+  interval_ = 0;
+  wallTimeInterval_ = 0;
+  wallTimeLimit_ = 0;
+
+  registry().states.clear();
+  registry().nRegistrations.clear();
+}
+
+bool Checkpointing::enabled()
+{
+  return enabled_ || stateRegistrationRequested_;
+}
+
+bool Checkpointing::writesCheckpoints()
+{
+  return enabled_ && (interval_ > 0 || wallTimeInterval_ > 0);
+}
+
+bool Checkpointing::isRestart()
+{
+  return isRestart_;
+}
+
+bool Checkpointing::claimOutermostSolver(MPI_Comm mpiCommunicator)
+{
+  if (!enabled_ || outermostSolverClaimed_)
+    return false;
+
+  // checkpoints are written and restored collectively on all ranks
+  int nRanks = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator, &nRanks), "MPI_Comm_size");
+  if (nRanks != DihuContext::nRanksCommWorld())
+  {
+    LOG(WARNING) << "Checkpointing: The outermost solver runs on " << nRanks << " of " << DihuContext::nRanksCommWorld() << " ranks, "
+      << "e.g. in MultipleInstances, no checkpoints are written or restored.";
+    outermostSolverClaimed_ = true;
+    return false;
+  }
+
+  outermostSolverClaimed_ = true;
+  return true;
+}
+
+void Checkpointing::requestStateRegistration()
+{
+  stateRegistrationRequested_ = true;
+}
+
+int Checkpointing::nextHandle()
+{
+  return registry().nextHandle;
+}
+
+Checkpointing::Registry &Checkpointing::registry()
+{
+  static Registry *registry = new Registry();
+  return *registry;
+}
+
+int Checkpointing::registerState(std::string key, SaveFunction save, RestoreFunction restore, bool isPartOfSolution)
+{
+  if (!enabled())
+    return -1;
+
+  Registry &registry = Checkpointing::registry();
+
+  // prefix the key by the scope of the solver that registers the state, the scope is the full path in the python config
+  if (!registry.keyScopes.empty())
+  {
+    key = registry.keyScopes.back() + "/" + key;
+  }
+
+  // make the key unique if the same solver registers equally named states, e.g. two field variables with the same name on the same mesh
+  int nRegistrations = registry.nRegistrations[key]++;
+  if (nRegistrations > 0)
+  {
+    key += std::string("#") + std::to_string(nRegistrations);
+  }
+
+  int handle = registry.nextHandle++;
+  registry.states[handle] = State{key, save, restore, isPartOfSolution};
+
+  VLOG(1) << "Checkpointing: register state \"" << key << "\", handle " << handle;
+  return handle;
+}
+
+Checkpointing::KeyScope::KeyScope(std::string scope)
+{
+  Checkpointing::registry().keyScopes.push_back(scope);
+}
+
+Checkpointing::KeyScope::~KeyScope()
+{
+  Checkpointing::registry().keyScopes.pop_back();
+}
+
+void Checkpointing::unregisterState(int handle)
+{
+  if (handle == -1)
+    return;
+
+  registry().states.erase(handle);
+}
+
+void Checkpointing::saveStates(int handleBegin, int handleEnd, std::vector<double> &values)
+{
+  values.clear();
+
+  std::vector<double> stateValues;
+  Registry &registry = Checkpointing::registry();
+  for (std::map<int,State>::iterator iter = registry.states.lower_bound(handleBegin); iter != registry.states.end() && iter->first < handleEnd; iter++)
+  {
+    const State &state = iter->second;
+    if (!state.isPartOfSolution)
+      continue;
+
+    stateValues.clear();
+    state.save(stateValues);
+
+    values.push_back(stateValues.size());
+    values.insert(values.end(), stateValues.begin(), stateValues.end());
+  }
+}
+
+void Checkpointing::restoreStates(int handleBegin, int handleEnd, const std::vector<double> &values)
+{
+  std::size_t position = 0;
+  std::vector<double> stateValues;
+  Registry &registry = Checkpointing::registry();
+  for (std::map<int,State>::iterator iter = registry.states.lower_bound(handleBegin); iter != registry.states.end() && iter->first < handleEnd; iter++)
+  {
+    const State &state = iter->second;
+    if (!state.isPartOfSolution)
+      continue;
+
+    std::size_t nValues = position < values.size()? (std::size_t)values[position] : 0;
+    if (position >= values.size() || position + 1 + nValues > values.size())
+    {
+      LOG(FATAL) << "Stored states contain no or too few values for \"" << state.key << "\", the states were stored by a different solver.";
+    }
+
+    stateValues.assign(values.begin() + position + 1, values.begin() + position + 1 + nValues);
+    state.restore(stateValues);
+    position += 1 + nValues;
+  }
+
+  if (position != values.size())
+  {
+    LOG(FATAL) << "Stored states contain " << values.size() << " values, but only " << position << " were restored, the states were stored by a different solver.";
+  }
+}
+
+void Checkpointing::serializeStates()
+{
+  writeBuffer_.clear();
+
+  // every state is stored as [int32 key length][key][int64 number of values][values]
+  std::vector<double> values;
+  for (const std::pair<const int,State> &entry : registry().states)
+  {
+    const State &state = entry.second;
+
+    values.clear();
+    state.save(values);
+
+    std::int32_t keyLength = state.key.length();
+    std::int64_t nValues = values.size();
+
+    appendToBuffer(writeBuffer_, &keyLength, 1);
+    appendToBuffer(writeBuffer_, state.key.data(), keyLength);
+    appendToBuffer(writeBuffer_, &nValues, 1);
+    appendToBuffer(writeBuffer_, values.data(), nValues);
+  }
+}
+
+void Checkpointing::writeCheckpointIfDue(double currentTime)
+{
+  if (!enabled_ || (interval_ <= 0 && wallTimeInterval_ <= 0))
+    return;
+
+  // rename the previous checkpoint as soon as it is complete
+  testPendingWrite();
+
+  // the simulation time interval, with a tolerance for the rounding errors of the time steps
+  bool isDue = interval_ > 0 && currentTime - lastCheckpointTime_ >= interval_*(1 - 1e-10);
+
+  if (wallTimeInterval_ > 0)
+  {
+    // the decision has to be the same on all ranks, therefore the wall time of rank 0 is used
+    int wallTimeIntervalHasPassed = MPI_Wtime() - lastCheckpointWallTime_ >= wallTimeInterval_;
+    MPIUtility::handleReturnValue(MPI_Bcast(&wallTimeIntervalHasPassed, 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Bcast");
+
+    if (wallTimeIntervalHasPassed)
+      isDue = true;
+  }
+
+  if (isDue)
+    writeCheckpoint(currentTime);
+}
+
+void Checkpointing::writeCheckpoint(double currentTime)
+{
+  if (!enabled_)
+    return;
+
+  // complete the previous checkpoint, such that at most one write is in progress
+  finishPendingWrite();
+
+  Control::PerformanceMeasurement::start("durationWriteCheckpoint");
+
+  const int nRanks = DihuContext::nRanksCommWorld();
+  const int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  serializeStates();
+
+  // get the sizes of the blocks of all ranks
+  long long ownBlockSize = writeBuffer_.size();
+  std::vector<long long> blockSizes(nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(&ownBlockSize, 1, MPI_LONG_LONG, blockSizes.data(), 1, MPI_LONG_LONG, MPI_COMM_WORLD), "MPI_Allgather");
+
+  // the blocks are stored after the header in the order of the ranks
+  std::vector<long long> blockOffsets(nRanks);
+  long long offset = fixedHeaderSize + 2*8*nRanks;
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    blockOffsets[rankNo] = offset;
+    offset += blockSizes[rankNo];
+  }
+
+  std::string temporaryFilename = filename_ + ".tmp";
+
+  // create the directory of the checkpoint file, once
+  static std::string createdDirectory;
+  if (ownRankNo == 0 && filename_.rfind("/") != std::string::npos && filename_.substr(0, filename_.rfind("/")) != createdDirectory)
+  {
+    std::string path = filename_.substr(0, filename_.rfind("/"));
+    if (path != "")
+    {
+      int ret = system((std::string("mkdir -p ")+path).c_str());
+      if (ret != 0)
+        LOG(WARNING) << "Creation of directory \"" << path << "\" failed.";
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    createdDirectory = path;
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  MPIUtility::handleReturnValue(MPI_File_open(MPI_COMM_WORLD, temporaryFilename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                              MPI_INFO_NULL, &pendingFile_), "MPI_File_open");
+
+  // truncate the file, it may exist from an aborted run
+  MPIUtility::handleReturnValue(MPI_File_set_size(pendingFile_, 0), "MPI_File_set_size");
+
+  pendingRequests_.clear();
+
+  // rank 0 writes the header: magic, version, number of ranks, time, offsets and sizes of the blocks
+  if (ownRankNo == 0)
+  {
+    std::int32_t nRanksFile = nRanks;
+    std::vector<std::int64_t> blockOffsetsFile(blockOffsets.begin(), blockOffsets.end());
+    std::vector<std::int64_t> blockSizesFile(blockSizes.begin(), blockSizes.end());
+
+    headerBuffer_.clear();
+    appendToBuffer(headerBuffer_, checkpointMagic, 8);
+    appendToBuffer(headerBuffer_, &checkpointVersion, 1);
+    appendToBuffer(headerBuffer_, &nRanksFile, 1);
+    appendToBuffer(headerBuffer_, &currentTime, 1);
+    appendToBuffer(headerBuffer_, blockOffsetsFile.data(), nRanks);
+    appendToBuffer(headerBuffer_, blockSizesFile.data(), nRanks);
+
+    MPI_Request request;
+    MPIUtility::handleReturnValue(MPI_File_iwrite_at(pendingFile_, 0, headerBuffer_.data(), headerBuffer_.size(), MPI_BYTE, &request), "MPI_File_iwrite_at");
+    pendingRequests_.push_back(request);
+  }
+
+  // write the own block, in chunks because the count argument is an int
+  for (long long chunkBegin = 0; chunkBegin < ownBlockSize; chunkBegin += maximumChunkSize)
+  {
+    int chunkSize = std::min<long long>(maximumChunkSize, ownBlockSize - chunkBegin);
+
+    MPI_Request request;
+    MPIUtility::handleReturnValue(MPI_File_iwrite_at(pendingFile_, blockOffsets[ownRankNo] + chunkBegin, writeBuffer_.data() + chunkBegin,
+                                                     chunkSize, MPI_BYTE, &request), "MPI_File_iwrite_at");
+    pendingRequests_.push_back(request);
+  }
+
+  writePending_ = true;
+  pendingTime_ = currentTime;
+  lastCheckpointTime_ = currentTime;
+
+  const double wallTimeSinceLastCheckpoint = MPI_Wtime() - lastCheckpointWallTime_;
+  lastCheckpointWallTime_ = MPI_Wtime();
+
+  Control::PerformanceMeasurement::stop("durationWriteCheckpoint");
+
+  LOG(DEBUG) << "Checkpointing: started writing checkpoint at t=" << currentTime << ", " << ownBlockSize << " bytes on own rank";
+
+  // if the job will be stopped before the next checkpoint, this checkpoint has to be complete before, therefore do not write it in the background
+  if (isLastCheckpointBeforeWallTimeLimit(wallTimeSinceLastCheckpoint))
+  {
+    LOG(INFO) << "Checkpointing: the wall time limit of " << wallTimeLimit_ << " s is reached before the next checkpoint, complete the checkpoint now.";
+    finishPendingWrite();
+  }
+}
+
+bool Checkpointing::isLastCheckpointBeforeWallTimeLimit(double wallTimeSinceLastCheckpoint)
+{
+  if (wallTimeLimit_ <= 0)
+    return false;
+
+  // estimate the wall time until the next checkpoint by the wall time interval or, for a simulation time interval, by the duration of the last interval,
+  // the decision has to be the same on all ranks, therefore the wall time of rank 0 is used
+  double wallTimeUntilNextCheckpoint = wallTimeSinceLastCheckpoint;
+  if (wallTimeInterval_ > 0)
+    wallTimeUntilNextCheckpoint = std::min(wallTimeInterval_, wallTimeUntilNextCheckpoint);
+
+  int isLastCheckpoint = MPI_Wtime() - startWallTime_ + wallTimeUntilNextCheckpoint >= wallTimeLimit_;
+  MPIUtility::handleReturnValue(MPI_Bcast(&isLastCheckpoint, 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Bcast");
+
+  return isLastCheckpoint;
+}
+
+void Checkpointing::testPendingWrite()
+{
+  if (!writePending_)
+    return;
+
+  // test the own requests, this also drives the progress of the write
+  int ownWriteCompleted = 0;
+  MPIUtility::handleReturnValue(MPI_Testall(pendingRequests_.size(), pendingRequests_.data(), &ownWriteCompleted, MPI_STATUSES_IGNORE), "MPI_Testall");
+
+  // the file can only be closed and renamed when all ranks have completed their writes
+  int writeCompleted = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&ownWriteCompleted, &writeCompleted, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD), "MPI_Allreduce");
+
+  if (writeCompleted)
+    finishPendingWrite();
+}
+
+void Checkpointing::finishPendingWrite()
+{
+  if (!writePending_)
+    return;
+
+  Control::PerformanceMeasurement::start("durationWriteCheckpoint");
+
+  MPIUtility::handleReturnValue(MPI_Waitall(pendingRequests_.size(), pendingRequests_.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+  MPIUtility::handleReturnValue(MPI_File_close(&pendingFile_), "MPI_File_close");
+  pendingRequests_.clear();
+  writePending_ = false;
+
+  // all ranks have to be finished before the previous checkpoint is replaced
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  if (DihuContext::ownRankNoCommWorld() == 0)
+  {
+    std::string temporaryFilename = filename_ + ".tmp";
+    if (std::rename(temporaryFilename.c_str(), filename_.c_str()) != 0)
+    {
+      LOG(ERROR) << "Could not rename checkpoint file \"" << temporaryFilename << "\" to \"" << filename_ << "\".";
+    }
+    else
+    {
+      LOG(INFO) << "Wrote checkpoint \"" << filename_ << "\" at t=" << pendingTime_ << ".";
+    }
+  }
+
+  Control::PerformanceMeasurement::stop("durationWriteCheckpoint");
+}
+
+bool Checkpointing::restoreCheckpoint(double &currentTime)
+{
+  if (!enabled_ || !restart_)
+    return false;
+
+  const int nRanks = DihuContext::nRanksCommWorld();
+  const int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  // check on rank 0 if the checkpoint file exists
+  int fileExists = 0;
+  if (ownRankNo == 0)
+  {
+    std::ifstream file(filename_.c_str(), std::ios::in | std::ios::binary);
+    fileExists = file.is_open();
+  }
+  MPIUtility::handleReturnValue(MPI_Bcast(&fileExists, 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Bcast");
+
+  if (!fileExists)
+  {
+    LOG(INFO) << "Checkpoint file \"" << filename_ << "\" does not exist, start the simulation from the beginning.";
+    return false;
+  }
+
+  Control::PerformanceMeasurement::start("durationRestoreCheckpoint");
+
+  MPI_File file;
+  MPIUtility::handleReturnValue(MPI_File_open(MPI_COMM_WORLD, filename_.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &file), "MPI_File_open");
+
+  // read the fixed part of the header
+  std::vector<char> header(fixedHeaderSize);
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(file, 0, header.data(), fixedHeaderSize, MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  char magic[8];
+  std::int32_t version = 0;
+  std::int32_t nRanksFile = 0;
+  double checkpointTime = 0;
+  std::size_t position = 0;
+  readFromBuffer(header, position, magic, 8);
+  readFromBuffer(header, position, &version, 1);
+  readFromBuffer(header, position, &nRanksFile, 1);
+  readFromBuffer(header, position, &checkpointTime, 1);
+
+  if (std::memcmp(magic, checkpointMagic, 8) != 0 || version != checkpointVersion)
+  {
+    LOG(FATAL) << "File \"" << filename_ << "\" is not a valid checkpoint file.";
+  }
+  if (nRanksFile != nRanks)
+  {
+    LOG(FATAL) << "Checkpoint \"" << filename_ << "\" was written with " << nRanksFile << " ranks, but the simulation runs on " << nRanks << " ranks. "
+      << "A restart needs the same number of ranks.";
+  }
+
+  // read the offset and size of the own block
+  std::int64_t blockOffset = 0;
+  std::int64_t blockSize = 0;
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(file, fixedHeaderSize + 8*ownRankNo, &blockOffset, 8, MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(file, fixedHeaderSize + 8*nRanks + 8*ownRankNo, &blockSize, 8, MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  // read the own block, in chunks because the count argument is an int
+  std::vector<char> buffer(blockSize);
+  for (std::int64_t chunkBegin = 0; chunkBegin < blockSize; chunkBegin += maximumChunkSize)
+  {
+    int chunkSize = std::min<std::int64_t>(maximumChunkSize, blockSize - chunkBegin);
+    MPIUtility::handleReturnValue(MPI_File_read_at(file, blockOffset + chunkBegin, buffer.data() + chunkBegin, chunkSize, MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_at");
+  }
+
+  MPIUtility::handleReturnValue(MPI_File_close(&file), "MPI_File_close");
+
+  // parse the states in the block
+  std::map<std::string,std::vector<double>> storedStates;
+  position = 0;
+  while (position < buffer.size())
+  {
+    std::int32_t keyLength = 0;
+    std::int64_t nValues = 0;
+    std::string key;
+    std::vector<double> values;
+
+    bool valid = readFromBuffer(buffer, position, &keyLength, 1) && keyLength >= 0;
+    if (valid)
+    {
+      key.resize(keyLength);
+      valid = readFromBuffer(buffer, position, &key[0], keyLength)
+        && readFromBuffer(buffer, position, &nValues, 1) && nValues >= 0;
+    }
+    if (valid)
+    {
+      values.resize(nValues);
+      valid = readFromBuffer(buffer, position, values.data(), nValues);
+    }
+    if (!valid)
+    {
+      LOG(FATAL) << "Checkpoint file \"" << filename_ << "\" is corrupt, block of rank " << ownRankNo << " could not be read.";
+    }
+
+    storedStates[key] = values;
+  }
+
+  // restore all registered states
+  int nRestoredStates = 0;
+  for (std::pair<const int,State> &entry : registry().states)
+  {
+    const State &state = entry.second;
+
+    std::map<std::string,std::vector<double>>::iterator iter = storedStates.find(state.key);
+    if (iter == storedStates.end())
+    {
+      // the key is prefixed by the path of the solver in the settings
+      std::string solverPath = "<top level>";
+      if (state.key.rfind("/") != std::string::npos)
+        solverPath = state.key.substr(0, state.key.rfind("/"));
+
+      // bookkeeping, e.g. of an output writer that was added to the settings, can start from the beginning, but a solution value would not be initialized
+      if (!state.isPartOfSolution)
+      {
+        LOG(WARNING) << "Checkpoint \"" << filename_ << "\" contains no data for \"" << state.key << "\" of solver " << solverPath << ", it keeps its initial value.";
+        continue;
+      }
+
+      LOG(FATAL) << "Checkpoint \"" << filename_ << "\" contains no data for \"" << state.key << "\", the solver " << solverPath << " cannot be restored. "
+        << "The settings differ from the run that wrote the checkpoint.";
+    }
+
+    state.restore(iter->second);
+    storedStates.erase(iter);
+    nRestoredStates++;
+  }
+
+  if (!storedStates.empty())
+  {
+    LOG(WARNING) << "Checkpoint \"" << filename_ << "\" contains " << storedStates.size() << " states that are not part of the simulation, "
+      << "e.g. \"" << storedStates.begin()->first << "\". The settings differ from the run that wrote the checkpoint.";
+  }
+
+  currentTime = checkpointTime;
+  lastCheckpointTime_ = checkpointTime;
+  lastCheckpointWallTime_ = MPI_Wtime();
+
+  Control::PerformanceMeasurement::stop("durationRestoreCheckpoint");
+
+  LOG(INFO) << "Restored checkpoint \"" << filename_ << "\" at t=" << checkpointTime << " (" << nRestoredStates << " states on own rank).";
+  return true;
+}
+
+void Checkpointing::getLocalValues(Vec vector, std::vector<double> &values)
+{
+  PetscErrorCode ierr;
+  PetscInt nEntries;
+  ierr = VecGetLocalSize(vector, &nEntries); CHKERRV(ierr);
+
+  const double *data;
+  ierr = VecGetArrayRead(vector, &data); CHKERRV(ierr);
+  values.insert(values.end(), data, data + nEntries);
+  ierr = VecRestoreArrayRead(vector, &data); CHKERRV(ierr);
+}
+
+void Checkpointing::setLocalValues(Vec vector, const std::vector<double> &values, std::string key)
+{
+  PetscErrorCode ierr;
+  PetscInt nEntries;
+  ierr = VecGetLocalSize(vector, &nEntries); CHKERRV(ierr);
+
+  if ((PetscInt)values.size() != nEntries)
+  {
+    LOG(FATAL) << "Checkpoint contains " << values.size() << " values for \"" << key << "\", but " << nEntries << " are needed. "
+      << "The settings differ from the run that wrote the checkpoint.";
+  }
+
+  double *data;
+  ierr = VecGetArray(vector, &data); CHKERRV(ierr);
+  std::copy(values.begin(), values.end(), data);
+  ierr = VecRestoreArray(vector, &data); CHKERRV(ierr);
+}
+
+}  // namespace
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <mpi.h>
+#include <petscvec.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "control/python_config/python_config.h"
+
+namespace Control
+{
+
+/** Checkpointing of the whole simulation state, such that a long simulation can be continued after it was stopped, e.g., by the wall time limit of a batch job.
+ *
+ *  Everything that is part of the simulation state registers itself: all field variables do so in their constructor, solvers with additional internal state
+ *  (FastMonodomainSolver, CellmlAdapter, the hyperelasticity solvers, output writers) register functions that save and restore this state.
+ *  The outermost solver, i.e. the solver whose run() is called and that runs on all ranks, claims the checkpoints with claimOutermostSolver().
+ *  This can be a splitting or coupling scheme, a time stepping scheme, the FastMonodomainSolver or a preCICE adapter.
+ *  It restores the state in run() after initialization and continues at the time of the checkpoint.
+ *  After every time step it calls writeCheckpointIfDue(), which writes a checkpoint when the configured simulation time or wall time interval has passed.
+ *
+ *  A checkpoint is a single binary file that is written collectively with MPI-IO, every rank writes its own block of data.
+ *  The write is asynchronous: the data is copied into a buffer and the progress of the write is tested after every time step of the outermost solver.
+ *  The data is first written to "<filename>.tmp" which is renamed to the final filename as soon as the write is complete on all ranks, such that the last complete checkpoint is never lost.
+ *  If a wall time limit is given and the next checkpoint would not be written before this limit, the write is completed immediately,
+ *  such that the checkpoint is available when the job is stopped.
+ *  A restart has to use the same settings and the same number of ranks as the run that wrote the checkpoint.
+ *
+ *  The registered states are also used by Parareal, which stores and restores the full state of its nested solver with saveStates and restoreStates.
+ *
+ *  Settings, at the top level of the config:
+ *  "checkpointing": {
+ *    "filename":         "checkpoints/checkpoint",   # file name of the checkpoint
+ *    "interval":         10.0,                       # simulation time interval between checkpoints, 0 disables it
+ *    "wallTimeInterval": 3600,                       # wall time interval in seconds between checkpoints, 0 disables it
+ *    "wallTimeLimit":    86400,                      # wall time in seconds after the start of the simulation, at which the job will be stopped, 0 if unknown
+ *    "restart":          True,                       # if the state should be restored from the checkpoint file at the start, if it exists
+ *  }
+ */
+class Checkpointing
+{
+public:
+
+  //! function that stores the state of a participant in the given vector
+  typedef std::function<void(std::vector<double> &values)> SaveFunction;
+
+  //! function that restores the state of a participant from the given values, which were previously stored by the SaveFunction
+  typedef std::function<void(const std::vector<double> &values)> RestoreFunction;
+
+  //! parse the settings, called by DihuContext when the config contains "checkpointing", this also clears all registered states
+  static void initialize(PythonConfig settings);
+
+  //! disable checkpointing, called by DihuContext when the config contains no "checkpointing"
+  static void reset();
+
+  //! if the states need to be registered, i.e. if checkpoints are written or restored or if requestStateRegistration() was called
+  static bool enabled();
+
+  //! if checkpoints are written after time steps, i.e. if an interval is set
+  static bool writesCheckpoints();
+
+  //! if "restart" is set and the checkpoint file existed at the start of the simulation, i.e. the simulation continues a previous run.
+  //! Output writers that append to a single file use this to continue the existing file instead of overwriting it.
+  static bool isRestart();
+
+  //! called in run() of a solver, i.e. a solver that is not nested in another solver. The first such solver that runs on all ranks is the outermost solver,
+  //! which restores and writes the checkpoints. Solvers on a subset of the ranks, e.g. in MultipleInstances, cannot write checkpoints, because this is collective on all ranks.
+  //! @return if the calling solver is the outermost solver and is responsible for the checkpoints
+  static bool claimOutermostSolver(MPI_Comm mpiCommunicator);
+
+  //! register all states even if no checkpoints are written, this is used by Parareal to propagate the full state of its nested solver
+  static void requestStateRegistration();
+
+  /** While an object of this class exists, the keys of all registered states are prefixed by the given scope. Solvers create it in initialize() with the path
+   *  of their settings in the python config, e.g. ["StrangSplitting"]["Term1"]["MultipleInstances"]["instances"][0]["Heun"], such that the keys
+   *  of equally named field variables of different solvers are unique and do not depend on the order in which the solvers are initialized.
+   */
+  class KeyScope
+  {
+  public:
+    //! constructor, begin the scope
+    KeyScope(std::string scope);
+
+    //! destructor, end the scope
+    ~KeyScope();
+  };
+
+  //! register a part of the simulation state, the key identifies the state in the checkpoint file and is prefixed by the current KeyScope.
+  //! If the key was already registered before in the same scope, a number is appended.
+  //! @param isPartOfSolution if the state belongs to the solution, false for bookkeeping such as the file counters of output writers, which are not used by saveStates
+  //! @return a handle to be used for unregisterState, or -1 if checkpointing is disabled
+  static int registerState(std::string key, SaveFunction save, RestoreFunction restore, bool isPartOfSolution = true);
+
+  //! get the handle that the next registered state will get, the states registered between two calls have the handles in between
+  static int nextHandle();
+
+  //! store all states with handles in [handleBegin,handleEnd) that are part of the solution in values, in the order of registration.
+  //! Every state is preceded by its number of values, such that linear combinations of stored states of the same solver can be restored.
+  static void saveStates(int handleBegin, int handleEnd, std::vector<double> &values);
+
+  //! restore all states with handles in [handleBegin,handleEnd) that are part of the solution from values that were stored by saveStates
+  static void restoreStates(int handleBegin, int handleEnd, const std::vector<double> &values);
+
+  //! remove a registered state, this has to be called when the object that registered the state is destroyed, a handle of -1 is ignored
+  static void unregisterState(int handle);
+
+  //! if "restart" is set and the checkpoint file exists, restore all registered states from the checkpoint file, this is collective on MPI_COMM_WORLD
+  //! @param currentTime the simulation time of the checkpoint, only set if the checkpoint was restored
+  //! @return if the checkpoint was restored
+  static bool restoreCheckpoint(double &currentTime);
+
+  //! write a checkpoint if the simulation time interval or the wall time interval has passed, called by the outermost solver after each time step.
+  //! This also completes a pending write, if it has finished on all ranks.
+  static void writeCheckpointIfDue(double currentTime);
+
+  //! write a checkpoint of all registered states, asynchronously, this is collective on MPI_COMM_WORLD
+  static void writeCheckpoint(double currentTime);
+
+  //! complete the pending asynchronous write, if there is any, called at the end of the simulation by DihuContext
+  static void finishPendingWrite();
+
+  //! test if the pending asynchronous write has finished on all ranks and complete it in that case, this is collective on MPI_COMM_WORLD
+  static void testPendingWrite();
+
+  //! helper function for SaveFunction, append the local values of a PETSc Vec without ghosts to values
+  static void getLocalValues(Vec vector, std::vector<double> &values);
+
+  //! helper function for RestoreFunction, set the local values of a PETSc Vec without ghosts
+  static void setLocalValues(Vec vector, const std::vector<double> &values, std::string key);
+
+private:
+
+  /** a registered part of the simulation state */
+  struct State
+  {
+    std::string key;             //< unique key of the state in the checkpoint file
+    SaveFunction save;           //< function that stores the state
+    RestoreFunction restore;     //< function that restores the state
+    bool isPartOfSolution;       //< if the state is used by saveStates and restoreStates
+  };
+
+  /** all registered states, this object is never deallocated, because field variables in global objects unregister after the end of main */
+  struct Registry
+  {
+    std::map<int,State> states;                //< the registered states by their handle, i.e. in the order of registration
+    std::map<std::string,int> nRegistrations;  //< how often a key was registered, to make the keys unique
+    std::vector<std::string> keyScopes;        //< the scopes of the currently existing KeyScope objects, the last one is the innermost
+    int nextHandle = 0;                        //< handle of the next registered state
+  };
+
+  //! get the registry of all states
+  static Registry &registry();
+
+  //! serialize all registered states to the write buffer
+  static void serializeStates();
+
+  //! if the checkpoint that was just started is the last one before the wall time limit, decided by rank 0
+  static bool isLastCheckpointBeforeWallTimeLimit(double wallTimeSinceLastCheckpoint);
+
+  static bool enabled_;                      //< if checkpoints are written or restored
+  static bool restart_;                      //< if the state should be restored from the checkpoint file at the start
+  static bool stateRegistrationRequested_;   //< if the states are registered although no checkpoints are written
+  static bool outermostSolverClaimed_;       //< if a solver already called claimOutermostSolver
+  static bool isRestart_;                    //< if "restart" is set and the checkpoint file existed at initialization
+  static std::string filename_;              //< filename of the checkpoint file
+  static double interval_;                   //< simulation time interval between checkpoints, 0 means disabled
+  static double wallTimeInterval_;           //< wall time interval between checkpoints in seconds, 0 means disabled
+  static double wallTimeLimit_;              //< wall time in seconds after initialize() at which the job is stopped, 0 means unknown
+  static double startWallTime_;              //< wall time of initialize()
+  static double lastCheckpointTime_;         //< simulation time of the last written or restored checkpoint
+  static double lastCheckpointWallTime_;     //< wall time of the last written checkpoint or of the initialization
+
+  static bool writePending_;                 //< if there is an asynchronous write in progress
+  static double pendingTime_;                //< simulation time of the checkpoint that is currently written
+  static MPI_File pendingFile_;              //< file handle of the checkpoint that is currently written
+  static std::vector<MPI_Request> pendingRequests_;  //< requests of the asynchronous writes
+  static std::vector<char> headerBuffer_;    //< header of the checkpoint file that is currently written, only on rank 0
+  static std::vector<char> writeBuffer_;     //< data of the own rank of the checkpoint that is currently written
+};
+
+}  // namespace
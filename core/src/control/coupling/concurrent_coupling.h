@@ -0,0 +1,70 @@
+#pragma once
+
+#include "operator_splitting/operator_splitting.h"
+#include "control/coupling/concurrent_transfer.h"
+
+namespace Control
+{
+
+/** A coupling of two time stepping schemes where both terms are computed at the same time on disjoint sets of ranks.
+ *  The terms are usually MultipleInstances objects with the "ranks" option, such that every term is only computed on its own rank subset.
+ *  The coupling is of Jacobi type and lagged by one coupling time step: in time step n, every term uses the values that the other term computed in time step n-1.
+ *  After a term has advanced, its values of the connected slots are sent with non-blocking point-to-point communication, they are received
+ *  right before the next time step. Therefore, both terms compute concurrently and only wait for each other if one term is slower.
+ *
+ *  The data is transferred between the slots that are connected by "connectedSlotsTerm1To2" and "connectedSlotsTerm2To1".
+ *  The field variables of two connected slots have to be defined on the same mesh (same global number of dofs, Lagrange basis functions),
+ *  but can be partitioned differently. The dofs are identified by their global natural numbers.
+ *  The settings are the same as for Coupling, under the key "ConcurrentCoupling".
+  */
+template<typename TimeStepping1, typename TimeStepping2>
+class ConcurrentCoupling :
+  public ::OperatorSplitting::OperatorSplitting<TimeStepping1,TimeStepping2>
+{
+public:
+  //! constructor
+  ConcurrentCoupling(DihuContext context);
+
+  //! initialize the two terms and the communication between them
+  void initialize();
+
+  //! advance both terms by the time span, concurrently
+  void advanceTimeSpan(bool withOutputWritersEnabled = true);
+
+protected:
+
+  /** one connection between a slot of one term and a slot of the other term
+   */
+  struct Connection
+  {
+    bool term1To2;                          //< the transfer direction, true: from term 1 to term 2, false: from term 2 to term 1
+    int fromSlotNo;                         //< the slot no in the sending term
+    int toSlotNo;                           //< the slot no in the receiving term
+    std::vector<dof_no_t> sendDofNosLocal;  //< the local dofs of the sending slot on the own rank, empty if the own rank does not compute the sending term
+    std::vector<dof_no_t> receiveDofNosLocal; //< the local dofs including ghosts of the receiving slot on the own rank
+    std::vector<double> values;             //< buffer for the values
+    std::shared_ptr<ConcurrentTransfer> transfer; //< the communication
+  };
+
+  //! determine the connections and initialize the transfer objects, collective over all ranks of the context
+  void initializeConnections();
+
+  //! get the local dof nos and their global natural numbers of the given slot, without ghosts for sending, with ghosts for receiving.
+  //! The numbers of the ghost dofs are requested from the ranks that own them, this is collective over the ranks of the slot's mesh.
+  template<typename SlotConnectorDataType>
+  void getSlotDofs(std::shared_ptr<SlotConnectorDataType> slotConnectorData, int slotNo, bool withoutGhosts,
+                   std::vector<dof_no_t> &dofNosLocal, std::vector<global_no_t> &dofNosGlobalNatural);
+
+  //! get the values of the connected slots of both terms and start the non-blocking transfers
+  void startTransfers();
+
+  //! wait for the transfers to complete and store the received values in the connected slots
+  void finishTransfers();
+
+  std::vector<Connection> connections_;     //< all connections between the two terms
+  bool connectionsInitialized_;             //< if initializeConnections() was called
+};
+
+}  // namespace
+
+#include "control/coupling/concurrent_coupling.tpp"
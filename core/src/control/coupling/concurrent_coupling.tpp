@@ -0,0 +1,353 @@
+#include "control/coupling/concurrent_coupling.h"
+
+#include "slot_connection/data_helper/slot_connector_data_helper.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+#include "utility/mpi_utility.h"
+
+#include <numeric>
+#include <algorithm>
+
+namespace Control
+{
+
+template<typename TimeStepping1, typename TimeStepping2>
+ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+ConcurrentCoupling(DihuContext context) :
+  ::OperatorSplitting::OperatorSplitting<TimeStepping1,TimeStepping2>(context, "ConcurrentCoupling"),
+  connectionsInitialized_(false)
+{
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+initialize()
+{
+  ::OperatorSplitting::OperatorSplitting<TimeStepping1,TimeStepping2>::initialize();
+
+  initializeConnections();
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+template<typename SlotConnectorDataType>
+void ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+getSlotDofs(std::shared_ptr<SlotConnectorDataType> slotConnectorData, int slotNo, bool withoutGhosts,
+            std::vector<dof_no_t> &dofNosLocal, std::vector<global_no_t> &dofNosGlobalNatural)
+{
+  dofNosLocal.clear();
+  dofNosGlobalNatural.clear();
+
+  // ranks that do not compute the term have no data
+  int nArrayItems = SlotConnectorDataHelper<SlotConnectorDataType>::nArrayItems(slotConnectorData, slotNo);
+  if (nArrayItems == 0)
+    return;
+
+  // the local instances of a MultipleInstances object are different on the ranks of the two terms, therefore they cannot be matched
+  if (nArrayItems > 1)
+  {
+    LOG(FATAL) << "ConcurrentCoupling(\"" << this->description_ << "\"): Slot " << slotNo << " has " << nArrayItems << " instances on rank "
+      << DihuContext::ownRankNoCommWorld() << ", but only one instance per rank can be transferred. "
+      << "Use a MultipleInstances object with only one instance for every term.";
+  }
+
+  std::shared_ptr<Partition::MeshPartitionBase> meshPartition
+    = SlotConnectorDataHelper<SlotConnectorDataType>::getMeshPartitionBase(slotConnectorData, slotNo, 0);
+
+  if (!meshPartition)
+    return;
+
+  // the global natural numbers of the local dofs without ghosts, this assumes one dof per node (Lagrange basis functions)
+  meshPartition->getDofNosGlobalNatural(dofNosGlobalNatural);
+
+  dof_no_t nDofsLocalWithoutGhosts = meshPartition->nDofsLocalWithoutGhosts();
+  dofNosLocal.resize(nDofsLocalWithoutGhosts);
+  std::iota(dofNosLocal.begin(), dofNosLocal.end(), 0);
+
+  if (withoutGhosts)
+    return;
+
+  // get the global natural numbers of the ghost dofs from the ranks that own them, the non-ghost dofs of every rank are contiguous in the global PETSc numbering
+  MPI_Comm mpiCommunicator = meshPartition->mpiCommunicator();
+  int nRanks = meshPartition->nRanks();
+
+  std::vector<global_no_t> nDofsOnRanks(nRanks);
+  global_no_t nDofsLocal = nDofsLocalWithoutGhosts;
+  MPIUtility::handleReturnValue(MPI_Allgather(&nDofsLocal, 1, MPI_UNSIGNED_LONG_LONG, nDofsOnRanks.data(), 1, MPI_UNSIGNED_LONG_LONG, mpiCommunicator), "MPI_Allgather");
+
+  std::vector<global_no_t> dofNoGlobalPetscBeginOnRanks(nRanks+1, 0);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    dofNoGlobalPetscBeginOnRanks[rankNo+1] = dofNoGlobalPetscBeginOnRanks[rankNo] + nDofsOnRanks[rankNo];
+
+  // ask the owning ranks of the ghost dofs
+  std::vector<std::vector<global_no_t>> ghostDofNosGlobalPetsc(nRanks);
+  std::vector<std::vector<dof_no_t>> ghostDofNosLocal(nRanks);
+  for (dof_no_t dofNoLocal = nDofsLocalWithoutGhosts; dofNoLocal < meshPartition->nDofsLocalWithGhosts(); dofNoLocal++)
+  {
+    global_no_t dofNoGlobalPetsc = meshPartition->getNodeNoGlobalPetsc(dofNoLocal);
+    int rankNo = std::upper_bound(dofNoGlobalPetscBeginOnRanks.begin(), dofNoGlobalPetscBeginOnRanks.end(), dofNoGlobalPetsc) - dofNoGlobalPetscBeginOnRanks.begin() - 1;
+
+    ghostDofNosGlobalPetsc[rankNo].push_back(dofNoGlobalPetsc);
+    ghostDofNosLocal[rankNo].push_back(dofNoLocal);
+  }
+
+  std::vector<int> nRequestsToRanks(nRanks), nRequestsFromRanks(nRanks);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    nRequestsToRanks[rankNo] = ghostDofNosGlobalPetsc[rankNo].size();
+
+  MPIUtility::handleReturnValue(MPI_Alltoall(nRequestsToRanks.data(), 1, MPI_INT, nRequestsFromRanks.data(), 1, MPI_INT, mpiCommunicator), "MPI_Alltoall");
+
+  std::vector<int> offsetsToRanks(nRanks, 0), offsetsFromRanks(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+  {
+    offsetsToRanks[rankNo] = offsetsToRanks[rankNo-1] + nRequestsToRanks[rankNo-1];
+    offsetsFromRanks[rankNo] = offsetsFromRanks[rankNo-1] + nRequestsFromRanks[rankNo-1];
+  }
+
+  std::vector<global_no_t> requestsToRanks;
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    requestsToRanks.insert(requestsToRanks.end(), ghostDofNosGlobalPetsc[rankNo].begin(), ghostDofNosGlobalPetsc[rankNo].end());
+
+  std::vector<global_no_t> requestsFromRanks(offsetsFromRanks[nRanks-1] + nRequestsFromRanks[nRanks-1]);
+  MPIUtility::handleReturnValue(MPI_Alltoallv(requestsToRanks.data(), nRequestsToRanks.data(), offsetsToRanks.data(), MPI_UNSIGNED_LONG_LONG,
+                                              requestsFromRanks.data(), nRequestsFromRanks.data(), offsetsFromRanks.data(), MPI_UNSIGNED_LONG_LONG,
+                                              mpiCommunicator), "MPI_Alltoallv");
+
+  // answer with the global natural numbers of the requested own dofs
+  std::vector<global_no_t> answersToRanks(requestsFromRanks.size());
+  for (int i = 0; i < requestsFromRanks.size(); i++)
+  {
+    bool isLocal = false;
+    dof_no_t dofNoLocal = meshPartition->getDofNoLocal(requestsFromRanks[i], isLocal);
+    assert(isLocal && dofNoLocal < nDofsLocalWithoutGhosts);
+    answersToRanks[i] = dofNosGlobalNatural[dofNoLocal];
+  }
+
+  std::vector<global_no_t> answersFromRanks(requestsToRanks.size());
+  MPIUtility::handleReturnValue(MPI_Alltoallv(answersToRanks.data(), nRequestsFromRanks.data(), offsetsFromRanks.data(), MPI_UNSIGNED_LONG_LONG,
+                                              answersFromRanks.data(), nRequestsToRanks.data(), offsetsToRanks.data(), MPI_UNSIGNED_LONG_LONG,
+                                              mpiCommunicator), "MPI_Alltoallv");
+
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    dofNosLocal.insert(dofNosLocal.end(), ghostDofNosLocal[rankNo].begin(), ghostDofNosLocal[rankNo].end());
+    dofNosGlobalNatural.insert(dofNosGlobalNatural.end(), answersFromRanks.begin() + offsetsToRanks[rankNo],
+                               answersFromRanks.begin() + offsetsToRanks[rankNo] + nRequestsToRanks[rankNo]);
+  }
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+initializeConnections()
+{
+  if (connectionsInitialized_)
+    return;
+
+  LOG(DEBUG) << "ConcurrentCoupling(\"" << this->description_ << "\")::initializeConnections";
+
+  typedef typename TimeStepping1::SlotConnectorDataType SlotConnectorDataType1;
+  typedef typename TimeStepping2::SlotConnectorDataType SlotConnectorDataType2;
+
+  std::shared_ptr<SlotConnectorDataType1> slotConnectorData1 = this->timeStepping1_.getSlotConnectorData();
+  std::shared_ptr<SlotConnectorDataType2> slotConnectorData2 = this->timeStepping2_.getSlotConnectorData();
+
+  // collect the connections, the connectors are parsed from the settings and are therefore the same on all ranks
+  connections_.clear();
+  for (int direction = 0; direction < 2; direction++)
+  {
+    bool term1To2 = (direction == 0);
+    const std::vector<SlotsConnection::Connector> &connectors
+      = (term1To2? this->slotsConnection_->connectorForVisualizerTerm1To2() : this->slotsConnection_->connectorForVisualizerTerm2To1());
+
+    for (int fromSlotNo = 0; fromSlotNo < connectors.size(); fromSlotNo++)
+    {
+      if (connectors[fromSlotNo].index < 0)
+        continue;
+
+      Connection connection;
+      connection.term1To2 = term1To2;
+      connection.fromSlotNo = fromSlotNo;
+      connection.toSlotNo = connectors[fromSlotNo].index;
+      connections_.push_back(connection);
+    }
+  }
+
+  MPI_Comm mpiCommunicator = this->context_.rankSubset()->mpiCommunicator();
+
+  // initialize the communication of every connection, this is collective over all ranks
+  for (int connectionNo = 0; connectionNo < connections_.size(); connectionNo++)
+  {
+    Connection &connection = connections_[connectionNo];
+
+    std::vector<global_no_t> sendDofNosGlobalNatural;
+    std::vector<global_no_t> receiveDofNosGlobalNatural;
+
+    if (connection.term1To2)
+    {
+      getSlotDofs(slotConnectorData1, connection.fromSlotNo, true, connection.sendDofNosLocal, sendDofNosGlobalNatural);
+      getSlotDofs(slotConnectorData2, connection.toSlotNo, false, connection.receiveDofNosLocal, receiveDofNosGlobalNatural);
+    }
+    else
+    {
+      getSlotDofs(slotConnectorData2, connection.fromSlotNo, true, connection.sendDofNosLocal, sendDofNosGlobalNatural);
+      getSlotDofs(slotConnectorData1, connection.toSlotNo, false, connection.receiveDofNosLocal, receiveDofNosGlobalNatural);
+    }
+
+    connection.transfer = std::make_shared<ConcurrentTransfer>();
+    connection.transfer->initialize(mpiCommunicator, sendDofNosGlobalNatural, receiveDofNosGlobalNatural, connectionNo);
+
+    LOG(DEBUG) << "connection " << connectionNo << " (" << (connection.term1To2? "1->2" : "2->1") << ") slot "
+      << connection.fromSlotNo << " -> " << connection.toSlotNo << ": send " << connection.transfer->nValuesToSend()
+      << " values, receive " << connection.transfer->nValuesToReceive() << " values";
+  }
+
+  connectionsInitialized_ = true;
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+startTransfers()
+{
+  typedef typename TimeStepping1::SlotConnectorDataType SlotConnectorDataType1;
+  typedef typename TimeStepping2::SlotConnectorDataType SlotConnectorDataType2;
+
+  for (Connection &connection : connections_)
+  {
+    connection.values.clear();
+    if (!connection.sendDofNosLocal.empty())
+    {
+      if (connection.term1To2)
+      {
+        SlotConnectorDataHelper<SlotConnectorDataType1>::slotGetValues(this->timeStepping1_.getSlotConnectorData(),
+          connection.fromSlotNo, 0, connection.sendDofNosLocal, connection.values);
+      }
+      else
+      {
+        SlotConnectorDataHelper<SlotConnectorDataType2>::slotGetValues(this->timeStepping2_.getSlotConnectorData(),
+          connection.fromSlotNo, 0, connection.sendDofNosLocal, connection.values);
+      }
+    }
+
+    connection.transfer->startTransfer(connection.values);
+  }
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+finishTransfers()
+{
+  typedef typename TimeStepping1::SlotConnectorDataType SlotConnectorDataType1;
+  typedef typename TimeStepping2::SlotConnectorDataType SlotConnectorDataType2;
+
+  for (Connection &connection : connections_)
+  {
+    if (!connection.transfer->transferIsActive())
+      continue;
+
+    // wait for the values of the other term, the waiting time is measured by the transfer timers
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(connection.term1To2? this->timerTransfer12_ : this->timerTransfer21_);
+
+    // initialize the received values with the current values, such that dofs that nobody sends keep their values
+    if (connection.term1To2)
+    {
+      SlotConnectorDataHelper<SlotConnectorDataType2>::slotGetValues(this->timeStepping2_.getSlotConnectorData(),
+        connection.toSlotNo, 0, connection.receiveDofNosLocal, connection.values);
+    }
+    else
+    {
+      SlotConnectorDataHelper<SlotConnectorDataType1>::slotGetValues(this->timeStepping1_.getSlotConnectorData(),
+        connection.toSlotNo, 0, connection.receiveDofNosLocal, connection.values);
+    }
+    connection.values.resize(connection.receiveDofNosLocal.size());
+
+    connection.transfer->finishTransfer(connection.values);
+
+    if (!connection.receiveDofNosLocal.empty())
+    {
+      if (connection.term1To2)
+      {
+        SlotConnectorDataHelper<SlotConnectorDataType2>::slotSetValues(this->timeStepping2_.getSlotConnectorData(),
+          connection.toSlotNo, 0, connection.receiveDofNosLocal, connection.values, INSERT_VALUES);
+      }
+      else
+      {
+        SlotConnectorDataHelper<SlotConnectorDataType1>::slotSetValues(this->timeStepping1_.getSlotConnectorData(),
+          connection.toSlotNo, 0, connection.receiveDofNosLocal, connection.values, INSERT_VALUES);
+      }
+    }
+
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(connection.term1To2? this->timerTransfer12_ : this->timerTransfer21_);
+  }
+}
+
+template<typename TimeStepping1, typename TimeStepping2>
+void ConcurrentCoupling<TimeStepping1,TimeStepping2>::
+advanceTimeSpan(bool withOutputWritersEnabled)
+{
+  LOG_SCOPE_FUNCTION;
+
+  // initialize the connections if this was not yet done, e.g. if initialize() of the base class was called
+  initializeConnections();
+
+  // start duration measurement, the name of the output variable can be set by "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKey_);
+
+  double timeSpan = this->endTime_ - this->startTime_;
+
+  LOG(DEBUG) << "  ConcurrentCoupling(\"" << this->description_ << "\")::advanceTimeSpan: timeSpan=[" << this->startTime_<< "," << this->endTime_<< "]"
+    << ", n steps: " << this->numberTimeSteps_<< ", timeStepWidth=" << this->timeStepWidth_;
+
+  // loop over time steps
+  double currentTime = this->startTime_;
+  for (int timeStepNo = 0; timeStepNo < this->numberTimeSteps_;)
+  {
+    if (timeStepNo % this->timeStepOutputInterval_ == 0 && (this->timeStepOutputInterval_ <= 10 || timeStepNo > 0))  // show first timestep only if timeStepOutputInterval is <= 10
+    {
+      LOG(INFO) << this->schemeName_ << ", timestep " << timeStepNo << "/" << this->numberTimeSteps_<< ", t=" << currentTime;
+    }
+
+    // receive the values that the other term computed in the previous time step
+    finishTransfers();
+
+    // --------------- time stepping 1 and 2, time span = [t,t+dt] -------------------------
+    // only one of the terms has local data on a rank if the terms are placed on disjoint rank subsets, the other one returns immediately
+    this->timeStepping1_.setTimeSpan(currentTime, currentTime+this->timeStepWidth_);
+
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::start(this->timerTimeStepping1AdvanceTimeSpan_);
+
+    this->timeStepping1_.advanceTimeSpan(withOutputWritersEnabled);
+
+    if (this->durationLogKey_ != "")
+    {
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTimeStepping2AdvanceTimeSpan_);
+    }
+
+    this->timeStepping2_.setTimeSpan(currentTime, currentTime+this->timeStepWidth_);
+    this->timeStepping2_.advanceTimeSpan(withOutputWritersEnabled);
+
+    if (this->durationLogKey_ != "")
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping2AdvanceTimeSpan_);
+
+    // send the new values to the other term, the transfer is completed at the beginning of the next time step
+    startTransfers();
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = this->startTime_ + double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
+
+    // store the current simulation in case the program gets interrupted, then the last time gets logged
+    Control::PerformanceMeasurement::setParameter("currentSimulationTime", std::to_string(currentTime));
+  }
+
+  // complete the last transfers, such that both terms have consistent values at the end of the time span
+  finishTransfers();
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+}
+
+}  // namespace
@@ -0,0 +1,279 @@
+#include "control/coupling/concurrent_transfer.h"
+
+#include <unordered_map>
+#include <numeric>
+#include <algorithm>
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
+namespace Control
+{
+
+template<typename T>
+void ConcurrentTransfer::
+exchange(const std::vector<std::vector<T>> &valuesToRanks, MPI_Datatype mpiDatatype, std::vector<int> &nValuesFromRanks, std::vector<T> &valuesFromRanks)
+{
+  int nRanks = valuesToRanks.size();
+  std::vector<int> nValuesToRanks(nRanks);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    nValuesToRanks[rankNo] = valuesToRanks[rankNo].size();
+
+  nValuesFromRanks.resize(nRanks);
+  MPIUtility::handleReturnValue(MPI_Alltoall(nValuesToRanks.data(), 1, MPI_INT, nValuesFromRanks.data(), 1, MPI_INT, mpiCommunicator_), "MPI_Alltoall");
+
+  std::vector<int> sendOffsets(nRanks, 0);
+  std::vector<int> receiveOffsets(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+  {
+    sendOffsets[rankNo] = sendOffsets[rankNo-1] + nValuesToRanks[rankNo-1];
+    receiveOffsets[rankNo] = receiveOffsets[rankNo-1] + nValuesFromRanks[rankNo-1];
+  }
+
+  std::vector<T> valuesContiguous;
+  valuesContiguous.reserve(sendOffsets[nRanks-1] + nValuesToRanks[nRanks-1]);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    valuesContiguous.insert(valuesContiguous.end(), valuesToRanks[rankNo].begin(), valuesToRanks[rankNo].end());
+
+  valuesFromRanks.resize(receiveOffsets[nRanks-1] + nValuesFromRanks[nRanks-1]);
+  MPIUtility::handleReturnValue(MPI_Alltoallv(valuesContiguous.data(), nValuesToRanks.data(), sendOffsets.data(), mpiDatatype,
+                                              valuesFromRanks.data(), nValuesFromRanks.data(), receiveOffsets.data(), mpiDatatype,
+                                              mpiCommunicator_), "MPI_Alltoallv");
+}
+
+void ConcurrentTransfer::
+initialize(MPI_Comm mpiCommunicator, const std::vector<global_no_t> &sendDofNosGlobalNatural,
+           const std::vector<global_no_t> &receiveDofNosGlobalNatural, int tag)
+{
+  mpiCommunicator_ = mpiCommunicator;
+  tag_ = tag;
+  sendTransfers_.clear();
+  receiveTransfers_.clear();
+
+  int nRanks = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator_, &nRanks), "MPI_Comm_size");
+
+  // The sending ranks of the dofs are found with a distributed directory, such that no rank needs memory of the size of the global mesh:
+  // every dof has a directory rank that is determined by a block partitioning of the global natural dof nos,
+  // the sending ranks register their dofs at the directory ranks, the receiving ranks ask them for the sending ranks of their dofs.
+  unsigned long long nDofsGlobalLocal = 0;
+  for (global_no_t dofNoGlobalNatural : sendDofNosGlobalNatural)
+    nDofsGlobalLocal = std::max(nDofsGlobalLocal, (unsigned long long)dofNoGlobalNatural + 1);
+  for (global_no_t dofNoGlobalNatural : receiveDofNosGlobalNatural)
+    nDofsGlobalLocal = std::max(nDofsGlobalLocal, (unsigned long long)dofNoGlobalNatural + 1);
+
+  unsigned long long nDofsGlobal = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&nDofsGlobalLocal, &nDofsGlobal, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, mpiCommunicator_), "MPI_Allreduce");
+
+  auto getDirectoryRank = [nRanks,nDofsGlobal](unsigned long long dofNoGlobalNatural)
+  {
+    return (int)(dofNoGlobalNatural * nRanks / nDofsGlobal);
+  };
+
+  // register the own send dofs and their indices in the send list at the directory ranks
+  std::vector<std::vector<unsigned long long>> registerDofNos(nRanks);
+  std::vector<std::vector<int>> registerIndices(nRanks);
+  for (int sendIndex = 0; sendIndex < sendDofNosGlobalNatural.size(); sendIndex++)
+  {
+    int directoryRankNo = getDirectoryRank(sendDofNosGlobalNatural[sendIndex]);
+    registerDofNos[directoryRankNo].push_back(sendDofNosGlobalNatural[sendIndex]);
+    registerIndices[directoryRankNo].push_back(sendIndex);
+  }
+
+  std::vector<int> nRegisteredByRanks;
+  std::vector<unsigned long long> registeredDofNos;
+  std::vector<int> registeredIndices;
+  exchange(registerDofNos, MPI_UNSIGNED_LONG_LONG, nRegisteredByRanks, registeredDofNos);
+  exchange(registerIndices, MPI_INT, nRegisteredByRanks, registeredIndices);
+  registerDofNos.clear();
+  registerIndices.clear();
+
+  // the directory of the own block of dofs, from the global natural dof no to the sending rank and the index in its send list
+  std::unordered_map<unsigned long long, std::pair<int,int>> sendingRankOfDof;
+  sendingRankOfDof.reserve(registeredDofNos.size());
+  for (int rankNo = 0, i = 0; rankNo < nRanks; rankNo++)
+  {
+    for (int j = 0; j < nRegisteredByRanks[rankNo]; j++, i++)
+    {
+      sendingRankOfDof.insert(std::make_pair(registeredDofNos[i], std::make_pair(rankNo, registeredIndices[i])));
+    }
+  }
+
+  // ask the directory ranks for the sending ranks of the own receive dofs
+  std::vector<std::vector<unsigned long long>> queryDofNos(nRanks);
+  std::vector<std::vector<int>> queryReceiveIndices(nRanks);
+  for (int receiveIndex = 0; receiveIndex < receiveDofNosGlobalNatural.size(); receiveIndex++)
+  {
+    int directoryRankNo = getDirectoryRank(receiveDofNosGlobalNatural[receiveIndex]);
+    queryDofNos[directoryRankNo].push_back(receiveDofNosGlobalNatural[receiveIndex]);
+    queryReceiveIndices[directoryRankNo].push_back(receiveIndex);
+  }
+
+  std::vector<int> nQueriedByRanks;
+  std::vector<unsigned long long> queriedDofNos;
+  exchange(queryDofNos, MPI_UNSIGNED_LONG_LONG, nQueriedByRanks, queriedDofNos);
+
+  // answer the queries with the sending rank and the index in its send list, -1 if no rank sends the dof
+  std::vector<std::vector<int>> answers(nRanks);
+  for (int rankNo = 0, i = 0; rankNo < nRanks; rankNo++)
+  {
+    for (int j = 0; j < nQueriedByRanks[rankNo]; j++, i++)
+    {
+      std::unordered_map<unsigned long long, std::pair<int,int>>::iterator iter = sendingRankOfDof.find(queriedDofNos[i]);
+      if (iter == sendingRankOfDof.end())
+      {
+        answers[rankNo].push_back(-1);
+        answers[rankNo].push_back(-1);
+      }
+      else
+      {
+        answers[rankNo].push_back(iter->second.first);
+        answers[rankNo].push_back(iter->second.second);
+      }
+    }
+  }
+  sendingRankOfDof.clear();
+
+  std::vector<int> nAnswersFromRanks;
+  std::vector<int> receivedAnswers;
+  exchange(answers, MPI_INT, nAnswersFromRanks, receivedAnswers);
+
+  // collect the requested indices for every sending rank, the answers are in the order of the queries
+  std::vector<std::vector<int>> requestedIndices(nRanks);
+  std::vector<std::vector<int>> receiveIndices(nRanks);
+  int nDofsWithoutSender = 0;
+  for (int directoryRankNo = 0, i = 0; directoryRankNo < nRanks; directoryRankNo++)
+  {
+    for (int receiveIndex : queryReceiveIndices[directoryRankNo])
+    {
+      int sendingRankNo = receivedAnswers[i++];
+      int sendIndex = receivedAnswers[i++];
+      if (sendingRankNo == -1)
+      {
+        nDofsWithoutSender++;
+        continue;
+      }
+      requestedIndices[sendingRankNo].push_back(sendIndex);
+      receiveIndices[sendingRankNo].push_back(receiveIndex);
+    }
+  }
+
+  if (nDofsWithoutSender > 0)
+  {
+    LOG(WARNING) << "ConcurrentTransfer: " << nDofsWithoutSender << " of " << receiveDofNosGlobalNatural.size()
+      << " local dofs are not sent by any rank, their values will not be set.";
+  }
+
+  // tell the sending ranks which of their values are needed
+  std::vector<int> nRequestedByRanks;
+  std::vector<int> indicesRequestedByRanks;
+  exchange(requestedIndices, MPI_INT, nRequestedByRanks, indicesRequestedByRanks);
+
+  std::vector<int> receiveOffsets(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+    receiveOffsets[rankNo] = receiveOffsets[rankNo-1] + nRequestedByRanks[rankNo-1];
+
+  // store the communication pattern
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    if (nRequestedByRanks[rankNo] > 0)
+    {
+      RankTransfer sendTransfer;
+      sendTransfer.rankNo = rankNo;
+      sendTransfer.indices.assign(indicesRequestedByRanks.begin() + receiveOffsets[rankNo],
+                                  indicesRequestedByRanks.begin() + receiveOffsets[rankNo] + nRequestedByRanks[rankNo]);
+      sendTransfer.buffer.resize(nRequestedByRanks[rankNo]);
+      sendTransfers_.push_back(sendTransfer);
+    }
+
+    if (!requestedIndices[rankNo].empty())
+    {
+      RankTransfer receiveTransfer;
+      receiveTransfer.rankNo = rankNo;
+      receiveTransfer.indices = receiveIndices[rankNo];
+      receiveTransfer.buffer.resize(requestedIndices[rankNo].size());
+      receiveTransfers_.push_back(receiveTransfer);
+    }
+  }
+
+  VLOG(1) << "ConcurrentTransfer (tag " << tag_ << "): send to " << sendTransfers_.size() << " ranks, receive from " << receiveTransfers_.size() << " ranks";
+}
+
+void ConcurrentTransfer::
+startTransfer(const std::vector<double> &sendValues)
+{
+  if (!requests_.empty())
+  {
+    LOG(ERROR) << "ConcurrentTransfer: startTransfer was called while the previous transfer was not finished.";
+    std::vector<double> receivedValues;
+    finishTransfer(receivedValues);
+  }
+
+  // post the receives first
+  for (RankTransfer &receiveTransfer : receiveTransfers_)
+  {
+    MPI_Request request;
+    MPIUtility::handleReturnValue(MPI_Irecv(receiveTransfer.buffer.data(), receiveTransfer.buffer.size(), MPI_DOUBLE, receiveTransfer.rankNo, tag_,
+                                            mpiCommunicator_, &request), "MPI_Irecv");
+    requests_.push_back(request);
+  }
+
+  // copy the values to the send buffers and send them
+  for (RankTransfer &sendTransfer : sendTransfers_)
+  {
+    for (int i = 0; i < sendTransfer.indices.size(); i++)
+    {
+      sendTransfer.buffer[i] = sendValues[sendTransfer.indices[i]];
+    }
+
+    MPI_Request request;
+    MPIUtility::handleReturnValue(MPI_Isend(sendTransfer.buffer.data(), sendTransfer.buffer.size(), MPI_DOUBLE, sendTransfer.rankNo, tag_,
+                                            mpiCommunicator_, &request), "MPI_Isend");
+    requests_.push_back(request);
+  }
+}
+
+void ConcurrentTransfer::
+finishTransfer(std::vector<double> &receivedValues)
+{
+  if (requests_.empty())
+    return;
+
+  MPIUtility::handleReturnValue(MPI_Waitall(requests_.size(), requests_.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+  requests_.clear();
+
+  for (const RankTransfer &receiveTransfer : receiveTransfers_)
+  {
+    for (int i = 0; i < receiveTransfer.indices.size(); i++)
+    {
+      if (receiveTransfer.indices[i] < receivedValues.size())
+        receivedValues[receiveTransfer.indices[i]] = receiveTransfer.buffer[i];
+    }
+  }
+}
+
+bool ConcurrentTransfer::
+transferIsActive() const
+{
+  return !requests_.empty();
+}
+
+int ConcurrentTransfer::
+nValuesToSend() const
+{
+  int result = 0;
+  for (const RankTransfer &sendTransfer : sendTransfers_)
+    result += sendTransfer.indices.size();
+  return result;
+}
+
+int ConcurrentTransfer::
+nValuesToReceive() const
+{
+  int result = 0;
+  for (const RankTransfer &receiveTransfer : receiveTransfers_)
+    result += receiveTransfer.indices.size();
+  return result;
+}
+
+}  // namespace Control
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <mpi.h>
+#include <vector>
+
+#include "control/types.h"
+
+namespace Control
+{
+
+/** Helper class to transfer the values of a field variable between two groups of ranks that have the same mesh with a different partitioning, e.g. disjoint rank subsets.
+ *  The dofs are identified by their global natural number. Every rank can send the values of its own dofs and receive the values of its local dofs.
+ *  The communication pattern is determined once in initialize with a distributed directory of the dofs, such that the memory per rank only depends on the number of local dofs.
+ *  Then the transfers use non-blocking point-to-point communication, such that the computation can continue between startTransfer and finishTransfer.
+ */
+class ConcurrentTransfer
+{
+public:
+
+  //! Initialize the communication pattern, this is collective over mpiCommunicator.
+  //! @param sendDofNosGlobalNatural[in] the global natural dof nos of the values that the own rank will send, may be empty
+  //! @param receiveDofNosGlobalNatural[in] the global natural dof nos of the values that the own rank needs, may be empty
+  //! @param tag the MPI tag for the transfers, has to be different for transfers that can be active at the same time
+  void initialize(MPI_Comm mpiCommunicator, const std::vector<global_no_t> &sendDofNosGlobalNatural,
+                  const std::vector<global_no_t> &receiveDofNosGlobalNatural, int tag);
+
+  //! start the non-blocking transfer, sendValues contains the values in the order of sendDofNosGlobalNatural
+  void startTransfer(const std::vector<double> &sendValues);
+
+  //! wait until the transfer is complete, receivedValues will contain the values in the order of receiveDofNosGlobalNatural, entries of dofs that no rank sends are not changed
+  void finishTransfer(std::vector<double> &receivedValues);
+
+  //! if a transfer was started but not yet finished
+  bool transferIsActive() const;
+
+  //! the number of values that are sent by the own rank in every transfer
+  int nValuesToSend() const;
+
+  //! the number of values that are received by the own rank in every transfer
+  int nValuesToReceive() const;
+
+protected:
+
+  //! send valuesToRanks[rankNo] to every rank rankNo, valuesFromRanks contains the values of all ranks, nValuesFromRanks[rankNo] of them from rank rankNo, collective over mpiCommunicator_
+  template<typename T>
+  void exchange(const std::vector<std::vector<T>> &valuesToRanks, MPI_Datatype mpiDatatype, std::vector<int> &nValuesFromRanks, std::vector<T> &valuesFromRanks);
+
+  //! the dofs that are exchanged with one foreign rank
+  struct RankTransfer
+  {
+    int rankNo;                     //< the foreign rank
+    std::vector<int> indices;       //< for sending: indices in sendDofNosGlobalNatural, for receiving: indices in receiveDofNosGlobalNatural
+    std::vector<double> buffer;     //< buffer for the values
+  };
+
+  MPI_Comm mpiCommunicator_;                  //< the communicator containing all sending and receiving ranks
+  int tag_;                                   //< the MPI tag of the messages
+  std::vector<RankTransfer> sendTransfers_;   //< the values to send, for every foreign rank
+  std::vector<RankTransfer> receiveTransfers_; //< the values to receive, for every foreign rank
+  std::vector<MPI_Request> requests_;         //< the requests of the active transfer
+};
+
+}  // namespace Control
@@ -0,0 +1,252 @@
+#include "control/diagnostic_tool/hardware_counters.h"
+
+#include "easylogging++.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "control/diagnostic_tool/performance_measurement.h"
+
+namespace Control
+{
+
+bool HardwareCounters::isEnabled_ = false;
+bool HardwareCounters::isInitialized_ = false;
+bool HardwareCounters::flopsAvailable_ = false;
+int HardwareCounters::groupFileDescriptor_ = -1;
+std::array<int,HardwareCounters::nCounters> HardwareCounters::groupIndex_;
+int HardwareCounters::nOpenedCounters_ = 0;
+std::vector<std::array<double,HardwareCounters::nCounters>> HardwareCounters::startValues_;
+std::vector<std::array<double,HardwareCounters::nCounters>> HardwareCounters::totalValues_;
+
+namespace
+{
+
+//! get the vendor of the CPU from /proc/cpuinfo, e.g. "GenuineIntel" or "AuthenticAMD", empty if it cannot be determined
+std::string getCpuVendor()
+{
+  std::ifstream file("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.find("vendor_id") == 0 && line.find(":") != std::string::npos)
+    {
+      std::string vendor = line.substr(line.find(":")+1);
+      vendor.erase(0, vendor.find_first_not_of(" \t"));
+      vendor.erase(vendor.find_last_not_of(" \t\r")+1);
+      return vendor;
+    }
+  }
+  return "";
+}
+
+}  // anonymous namespace
+
+void HardwareCounters::initialize()
+{
+  // the counters are opened only once, also if this failed
+  if (isInitialized_)
+    return;
+  isInitialized_ = true;
+
+  groupIndex_.fill(-1);
+  nOpenedCounters_ = 0;
+
+#ifdef __linux__
+  struct CounterEvent
+  {
+    counter_t counter;      //< the counter that is measured by the event
+    uint32_t type;          //< type of the event for perf_event_open
+    uint64_t config;        //< configuration of the event for perf_event_open
+    std::string name;       //< name of the event for messages
+  };
+
+  // the generic hardware events are mapped by the kernel to the events of the respective CPU
+  std::vector<CounterEvent> events = {
+    CounterEvent{counterCycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    CounterEvent{counterInstructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    CounterEvent{counterLastLevelCacheMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "cache-misses"}
+  };
+
+  // there is no generic event for floating point operations, the raw events of FP_ARITH_INST_RETIRED (event 0xc7) only exist on Intel CPUs
+  std::string cpuVendor = getCpuVendor();
+  if (cpuVendor == "GenuineIntel")
+  {
+    events.insert(events.end(), {
+      CounterEvent{counterFlopsScalar, PERF_TYPE_RAW, 0x5301c7, "FP_ARITH_INST_RETIRED.SCALAR_DOUBLE"},
+      CounterEvent{counterFlops128, PERF_TYPE_RAW, 0x5304c7, "FP_ARITH_INST_RETIRED.128B_PACKED_DOUBLE"},
+      CounterEvent{counterFlops256, PERF_TYPE_RAW, 0x5310c7, "FP_ARITH_INST_RETIRED.256B_PACKED_DOUBLE"},
+      CounterEvent{counterFlops512, PERF_TYPE_RAW, 0x5340c7, "FP_ARITH_INST_RETIRED.512B_PACKED_DOUBLE"}
+    });
+  }
+  else
+  {
+    LOG(INFO) << "Hardware counters: floating point operations can only be counted on Intel CPUs, the CPU vendor is \"" << cpuVendor << "\". "
+      << "Flops are not measured.";
+  }
+
+  std::stringstream failedEvents;
+  for (const CounterEvent &event : events)
+  {
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(struct perf_event_attr));
+    attributes.size = sizeof(struct perf_event_attr);
+    attributes.type = event.type;
+    attributes.config = event.config;
+    attributes.disabled = (event.counter == counterCycles? 1 : 0);   // only the group leader starts disabled
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // measure the calling thread on any cpu. Counters of a group cannot be inherited by threads that are created later,
+    // because a group with inherited counters cannot be read with PERF_FORMAT_GROUP
+    int fileDescriptor = syscall(__NR_perf_event_open, &attributes, 0, -1, groupFileDescriptor_, 0);
+
+    if (fileDescriptor == -1)
+    {
+      if (event.counter == counterCycles)
+      {
+        LOG(WARNING) << "Could not open hardware counters with perf_event_open: " << strerror(errno) << ". "
+          << "Check /proc/sys/kernel/perf_event_paranoid. Hardware counters are disabled.";
+        return;
+      }
+
+      // the counter stays marked as not available by groupIndex_ -1
+      failedEvents << (failedEvents.str().empty()? "" : ", ") << event.name << " (" << strerror(errno) << ")";
+      continue;
+    }
+
+    if (event.counter == counterCycles)
+      groupFileDescriptor_ = fileDescriptor;
+
+    groupIndex_[event.counter] = nOpenedCounters_++;
+  }
+
+  // the flops are only reported if all floating point counters are available, otherwise they would be underestimated
+  flopsAvailable_ = groupIndex_[counterFlopsScalar] != -1 && groupIndex_[counterFlops128] != -1
+    && groupIndex_[counterFlops256] != -1 && groupIndex_[counterFlops512] != -1;
+
+  if (!failedEvents.str().empty())
+  {
+    LOG(WARNING) << "Hardware counters: the following events are not available on this CPU and are not reported: " << failedEvents.str() << "."
+      << (cpuVendor == "GenuineIntel" && !flopsAvailable_? " Flops are not measured." : "");
+  }
+
+  // start counting
+  ioctl(groupFileDescriptor_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(groupFileDescriptor_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+  isEnabled_ = true;
+  LOG(DEBUG) << "Opened " << nOpenedCounters_ << " hardware counters.";
+
+#ifdef _OPENMP
+  if (omp_get_max_threads() > 1)
+  {
+    LOG(WARNING) << "Hardware counters only measure the main thread, the events of the other " << omp_get_max_threads()-1 << " OpenMP threads are not counted.";
+  }
+#endif
+#else
+  LOG(WARNING) << "Hardware counters are only available on Linux.";
+#endif
+}
+
+bool HardwareCounters::isEnabled()
+{
+  return isEnabled_;
+}
+
+void HardwareCounters::readCounters(std::array<double,nCounters> &values)
+{
+  // the layout of the buffer is {nr, time_enabled, time_running, value[nr]}
+  std::array<uint64_t,3+nCounters> buffer;
+  values.fill(0.0);
+
+  if (read(groupFileDescriptor_, buffer.data(), sizeof(buffer)) <= 0)
+    return;
+
+  // scale values, if the counters were multiplexed with other counters
+  double scalingFactor = 1.0;
+  if (buffer[2] > 0 && buffer[2] < buffer[1])
+    scalingFactor = double(buffer[1]) / buffer[2];
+
+  for (int counterNo = 0; counterNo < nCounters; counterNo++)
+  {
+    if (groupIndex_[counterNo] != -1)
+      values[counterNo] = buffer[3 + groupIndex_[counterNo]] * scalingFactor;
+  }
+}
+
+void HardwareCounters::start(int timerHandle)
+{
+  if (timerHandle >= (int)startValues_.size())
+  {
+    std::array<double,nCounters> zero;
+    zero.fill(0.0);
+    startValues_.resize(timerHandle+1, zero);
+    totalValues_.resize(timerHandle+1, zero);
+  }
+
+  readCounters(startValues_[timerHandle]);
+}
+
+void HardwareCounters::stop(int timerHandle)
+{
+  if (timerHandle >= (int)startValues_.size())
+    return;
+
+  std::array<double,nCounters> values;
+  readCounters(values);
+
+  for (int counterNo = 0; counterNo < nCounters; counterNo++)
+  {
+    totalValues_[timerHandle][counterNo] += values[counterNo] - startValues_[timerHandle][counterNo];
+  }
+}
+
+void HardwareCounters::storeDerivedMetrics(const std::vector<std::string> &timerNames, const std::vector<double> &durations)
+{
+  if (!isEnabled_)
+    return;
+
+  for (int timerHandle = 0; timerHandle < (int)totalValues_.size() && timerHandle < (int)timerNames.size(); timerHandle++)
+  {
+    const std::array<double,nCounters> &values = totalValues_[timerHandle];
+    const std::string &name = timerNames[timerHandle];
+
+    if (values[counterCycles] == 0)
+      continue;
+
+    double nFlops = values[counterFlopsScalar] + 2*values[counterFlops128] + 4*values[counterFlops256] + 8*values[counterFlops512];
+    double nBytes = 64*values[counterLastLevelCacheMisses];
+
+    PerformanceMeasurement::setParameter(name + "_cycles", values[counterCycles]);
+
+    if (groupIndex_[counterInstructions] != -1)
+      PerformanceMeasurement::setParameter(name + "_IPC", values[counterInstructions] / values[counterCycles]);
+
+    if (groupIndex_[counterLastLevelCacheMisses] != -1)
+      PerformanceMeasurement::setParameter(name + "_LLCMisses", values[counterLastLevelCacheMisses]);
+
+    if (flopsAvailable_)
+    {
+      PerformanceMeasurement::setParameter(name + "_flops", nFlops);
+      if (durations[timerHandle] > 0)
+        PerformanceMeasurement::setParameter(name + "_GFLOPs", nFlops / durations[timerHandle] * 1e-9);
+      if (nFlops > 0 && groupIndex_[counterLastLevelCacheMisses] != -1)
+        PerformanceMeasurement::setParameter(name + "_bytesPerFlop", nBytes / nFlops);
+    }
+  }
+}
+
+}  // namespace
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+#include <string>
+#include <array>
+
+namespace Control
+{
+
+/** In-process measurement of hardware performance counters using the Linux perf_event_open interface.
+ *  A group of counters (cycles, instructions, last level cache misses and floating point operations) is opened for the calling thread.
+ *  The counters are attributed to the regions of PerformanceMeasurement, i.e. they are read at every start and stop of a measurement.
+ *  At the end, derived metrics (GFLOP/s, IPC, bytes per flop) are added to the log file.
+ *
+ *  Only the thread that calls initialize() is measured, the counters are not inherited by OpenMP threads or other threads,
+ *  because the counters of a group are read together and the kernel does not support this for inherited counters.
+ *
+ *  Cycles, instructions and cache misses are the generic hardware events of the kernel. The floating point events are the Intel FP_ARITH_INST_RETIRED events
+ *  for double precision (scalar, 128, 256 and 512 bit), they are only opened on Intel CPUs. Counters that cannot be opened are logged and not reported.
+ */
+class HardwareCounters
+{
+public:
+
+  //! open the counters for the calling thread, after this call isEnabled() returns if the counters could be opened, later calls have no effect
+  static void initialize();
+
+  //! if the counters are active
+  static bool isEnabled();
+
+  //! read the current counter values and store them as start values for the timer handle
+  static void start(int timerHandle);
+
+  //! read the current counter values and add the difference to the start values to the total values of the timer handle
+  static void stop(int timerHandle);
+
+  //! add derived metrics for all measurements to the parameters of PerformanceMeasurement, durations[timerHandle] is the total duration
+  static void storeDerivedMetrics(const std::vector<std::string> &timerNames, const std::vector<double> &durations);
+
+private:
+
+  //! counters that are opened in the group
+  enum counter_t {
+    counterCycles,              //< CPU cycles
+    counterInstructions,        //< retired instructions
+    counterLastLevelCacheMisses,  //< last level cache misses, each miss transfers one cache line of 64 bytes
+    counterFlopsScalar,         //< scalar double precision floating point instructions, 1 flop each
+    counterFlops128,            //< 128 bit packed double precision instructions, 2 flops each
+    counterFlops256,            //< 256 bit packed double precision instructions, 4 flops each
+    counterFlops512,            //< 512 bit packed double precision instructions, 8 flops each
+    nCounters
+  };
+
+  //! read all counters of the group, values that were not opened are set to 0
+  static void readCounters(std::array<double,nCounters> &values);
+
+  static bool isEnabled_;                                       //< if the counters have been opened successfully
+  static bool isInitialized_;                                   //< if initialize() was already called
+  static bool flopsAvailable_;                                  //< if all floating point counters could be opened
+  static int groupFileDescriptor_;                              //< file descriptor of the group leader, the cycles counter
+  static std::array<int,nCounters> groupIndex_;                 //< position of the counters in the read buffer of the group, -1 if the counter is not available
+  static int nOpenedCounters_;                                  //< number of counters in the group
+  static std::vector<std::array<double,nCounters>> startValues_;   //< counter values at the last start, for every timer handle
+  static std::vector<std::array<double,nCounters>> totalValues_;   //< accumulated counter values, for every timer handle
+};
+
+}  // namespace
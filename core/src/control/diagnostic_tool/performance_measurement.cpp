@@ -11,9 +11,12 @@
 #include <string>
 #include <sys/param.h>
 #include <iomanip>
+#include <cassert>
+#include <algorithm>
 //#include <stdlib.h>  //was only for function getenv()
 
 #include "output_writer/generic.h"
+#include "control/diagnostic_tool/hardware_counters.h"
 
 namespace Control
 {
@@ -21,15 +24,26 @@ namespace Control
 std::map<std::string, PerformanceMeasurement::Measurement> PerformanceMeasurement::measurements_;
 std::map<std::string,std::string> PerformanceMeasurement::parameters_;
 std::map<std::string, int> PerformanceMeasurement::sums_;
-std::shared_ptr<std::thread> PerformanceMeasurement::perfThread_;
-int PerformanceMeasurement::perfThreadHandle_;
+std::vector<PerformanceMeasurement::Measurement *> PerformanceMeasurement::timers_;
+std::vector<std::string> PerformanceMeasurement::timerNames_;
+std::vector<PerformanceMeasurement::Region> PerformanceMeasurement::regions_;
+std::vector<int> PerformanceMeasurement::regionStack_;
+std::vector<PerformanceMeasurement::TraceEvent> PerformanceMeasurement::traceEvents_;
+std::string PerformanceMeasurement::regionsFilename_ = "";
+std::string PerformanceMeasurement::traceFilename_ = "";
+int PerformanceMeasurement::maxNTraceEvents_ = 1000000;
 
 PerformanceMeasurement::Measurement::Measurement() :
-  start(0.0), totalDuration(0.0), nTimeSpans(0), totalError(0.0), nErrors(0)
+  start(0.0), totalDuration(0.0), nTimeSpans(0), totalError(0.0), nErrors(0), timerHandle(-1)
 {
 }
 
-void PerformanceMeasurement::start(std::string name)
+PerformanceMeasurement::Region::Region(TimerHandle timerHandle, int parentRegionNo) :
+  timerHandle(timerHandle), parentRegionNo(parentRegionNo), start(0.0), inclusiveDuration(0.0), childrenDuration(0.0), nCalls(0)
+{
+}
+
+PerformanceMeasurement::TimerHandle PerformanceMeasurement::getTimerHandle(const std::string &name)
 {
   std::map<std::string, Measurement>::iterator iter = measurements_.find(name);
 
@@ -40,69 +54,150 @@ void PerformanceMeasurement::start(std::string name)
     iter = insertedIter.first;
   }
 
-  // measure current time
-  iter->second.start = MPI_Wtime();
+  // create new handle, pointers to elements of std::map stay valid when other elements are inserted
+  if (iter->second.timerHandle == -1)
+  {
+    iter->second.timerHandle = timers_.size();
+    timers_.push_back(&iter->second);
+    timerNames_.push_back(name);
+  }
+  return iter->second.timerHandle;
 }
 
-void PerformanceMeasurement::stop(std::string name, int numberAccumulated)
+void PerformanceMeasurement::start(const std::string &name)
 {
-  double stopTime = MPI_Wtime();
+  start(getTimerHandle(name));
+}
+
+void PerformanceMeasurement::start(TimerHandle timerHandle)
+{
+  assert(0 <= timerHandle && timerHandle < (int)timers_.size());
+
+  // measure current time
+  double startTime = MPI_Wtime();
+  timers_[timerHandle]->start = startTime;
 
-  if (measurements_.find(name) == measurements_.end())
+  // enter the region as child of the currently running region
+  if (regions_.empty())
+  {
+    regions_.push_back(Region(-1, -1));
+  }
+  int parentRegionNo = (regionStack_.empty()? 0 : regionStack_.back());
+  int regionNo = getChildRegion(parentRegionNo, timerHandle);
+
+  regions_[regionNo].start = startTime;
+  regionStack_.push_back(regionNo);
+
+  if (HardwareCounters::isEnabled())
+    HardwareCounters::start(timerHandle);
+}
+
+void PerformanceMeasurement::stop(const std::string &name, int numberAccumulated)
+{
+  std::map<std::string, Measurement>::iterator iter = measurements_.find(name);
+  if (iter == measurements_.end() || iter->second.timerHandle == -1)
   {
     LOG(ERROR) << "PerformanceMeasurement stop with name \"" << name << "\", a corresponding start is not present.";
   }
   else
   {
-    Measurement &measurement = measurements_[name];
-    double duration = stopTime - measurement.start;
-    measurement.totalDuration += duration;
-    measurement.nTimeSpans += numberAccumulated;
-
-    VLOG(2) << "PerformanceMeasurement::stop(" << name << "), time span [" << measurement.start << "," << stopTime << "], duration=" << duration
-      << ", now total: " << measurement.totalDuration << ", nTimeSpans: " << measurement.nTimeSpans;
+    stop(iter->second.timerHandle, numberAccumulated);
   }
 }
 
-void PerformanceMeasurement::startFlops()
+void PerformanceMeasurement::stop(TimerHandle timerHandle, int numberAccumulated)
 {
-  // get process id
-  int pid = getpid();
+  double stopTime = MPI_Wtime();
 
-  perfThread_ = std::make_shared<std::thread>([pid](){
+  assert(0 <= timerHandle && timerHandle < (int)timers_.size());
 
-    std::stringstream filename;
-    filename << "perf." << DihuContext::ownRankNoCommWorld() << ".txt";
+  if (HardwareCounters::isEnabled())
+    HardwareCounters::stop(timerHandle);
 
-    std::stringstream command;
-    command << "perf stat -e r5301c7 -p " << pid << " -o " << filename.str();
+  Measurement &measurement = *timers_[timerHandle];
+  double duration = stopTime - measurement.start;
+  measurement.totalDuration += duration;
+  measurement.nTimeSpans += numberAccumulated;
 
-    LOG(INFO) << "starting perf with command " << command.str();
+  VLOG(2) << "PerformanceMeasurement::stop(" << timerNames_[timerHandle] << "), time span [" << measurement.start << "," << stopTime << "], duration=" << duration
+    << ", now total: " << measurement.totalDuration << ", nTimeSpans: " << measurement.nTimeSpans;
 
-    int returnValue = system(command.str().c_str());
-    LOG(DEBUG) << returnValue;
-  });
-  perfThreadHandle_ = perfThread_->native_handle();
+  // leave the region, usually it is the innermost running region,
+  // if regions are not properly nested, the region is removed from the middle of the stack
+  for (int stackIndex = (int)regionStack_.size()-1; stackIndex >= 0; stackIndex--)
+  {
+    Region &region = regions_[regionStack_[stackIndex]];
+    if (region.timerHandle == timerHandle)
+    {
+      double regionDuration = stopTime - region.start;
+      region.inclusiveDuration += regionDuration;
+      region.nCalls++;
+      regions_[region.parentRegionNo].childrenDuration += regionDuration;
+
+      // record the call for the trace file
+      if (!traceFilename_.empty() && (int)traceEvents_.size() < maxNTraceEvents_)
+      {
+        traceEvents_.push_back(TraceEvent{timerHandle, region.start, regionDuration});
+      }
+
+      regionStack_.erase(regionStack_.begin() + stackIndex);
+      break;
+    }
+  }
+}
 
-  perfThread_->detach();
+int PerformanceMeasurement::getChildRegion(int parentRegionNo, TimerHandle timerHandle)
+{
+  // the number of children is small, a linear search is faster than a map
+  for (const std::pair<TimerHandle,int> &child : regions_[parentRegionNo].children)
+  {
+    if (child.first == timerHandle)
+      return child.second;
+  }
+
+  // create new region
+  int regionNo = regions_.size();
+  regions_.push_back(Region(timerHandle, parentRegionNo));
+  regions_[parentRegionNo].children.push_back(std::pair<TimerHandle,int>(timerHandle, regionNo));
+  return regionNo;
 }
 
-void PerformanceMeasurement::endFlops()
+std::string PerformanceMeasurement::getRegionPath(int regionNo)
 {
-  pthread_cancel(perfThreadHandle_);
+  std::string path = timerNames_[regions_[regionNo].timerHandle];
+  for (int parentRegionNo = regions_[regionNo].parentRegionNo; parentRegionNo > 0; parentRegionNo = regions_[parentRegionNo].parentRegionNo)
+  {
+    path = timerNames_[regions_[parentRegionNo].timerHandle] + "/" + path;
+  }
+  return path;
+}
 
-  std::stringstream filename;
-  filename << "perf." << DihuContext::ownRankNoCommWorld() << ".txt";
+void PerformanceMeasurement::setRegionOutput(std::string regionsFilename, std::string traceFilename, int maxNTraceEvents)
+{
+  regionsFilename_ = regionsFilename;
+  traceFilename_ = traceFilename;
+  maxNTraceEvents_ = maxNTraceEvents;
 
-  // parse file
-  std::ifstream file(filename.str());
-  if (file.is_open())
+  if (!traceFilename_.empty())
   {
-     std::string content((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
-     LOG(DEBUG) << content;
+    traceEvents_.reserve(std::min(maxNTraceEvents_, 100000));
   }
 }
 
+void PerformanceMeasurement::startFlops()
+{
+  // the counters are read in-process, the group is opened on the first call
+  if (!HardwareCounters::isEnabled())
+    HardwareCounters::initialize();
+
+  start("totalFlops");
+}
+
+void PerformanceMeasurement::endFlops()
+{
+  stop("totalFlops");
+}
+
 std::string PerformanceMeasurement::getParameter(std::string key)
 {
   if (parameters_.find(key) == parameters_.end())
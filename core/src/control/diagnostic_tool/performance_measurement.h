@@ -2,6 +2,7 @@
 
 #include <Python.h>  // has to be the first included header
 #include <map>
+#include <vector>
 
 #include "control/dihu_context.h"
 #include "interfaces/runnable.h"
@@ -10,21 +11,44 @@ namespace Control
 {
 
 /** A class used for timing and error performance measurements. Timing is done using MPI_Wtime.
+ *  Measurements can be identified by their name or, in hot paths, by a timer handle that is resolved once with getTimerHandle.
+ *  Nested start/stop calls form a tree of regions with inclusive and exclusive durations. If a filename is set by setRegionOutput,
+ *  the region tree is aggregated over all ranks (min/avg/max) at the end of the program and written to a text file and a speedscope JSON file.
+ *  Optionally, every region call is recorded and written as Chrome trace file.
+ *  If hardware counters are enabled (see HardwareCounters), they are read at every start and stop and derived metrics are added to the log file.
  */
 class PerformanceMeasurement
 {
 public:
 
+  //! handle of a measurement, obtained by getTimerHandle
+  typedef int TimerHandle;
+
+  //! get the handle for the measurement with the given keyword, create the measurement if it does not yet exist
+  static TimerHandle getTimerHandle(const std::string &name);
+
   //! start timing measurement for a given keyword
-  static void start(std::string name);
+  static void start(const std::string &name);
+
+  //! start timing measurement for a timer handle, this does not involve any lookup by name
+  static void start(TimerHandle timerHandle);
 
   //! stop timing measurement for a given keyword, the counter of number of time spans is increased by numberAccumulated
-  static void stop(std::string name, int numberAccumulated=1);
+  static void stop(const std::string &name, int numberAccumulated=1);
+
+  //! stop timing measurement for a timer handle, the counter of number of time spans is increased by numberAccumulated
+  static void stop(TimerHandle timerHandle, int numberAccumulated=1);
+
+  //! set the filenames for the region files, empty strings disable the respective output
+  static void setRegionOutput(std::string regionsFilename, std::string traceFilename, int maxNTraceEvents);
+
+  //! aggregate the region tree over all ranks and write the region summary, speedscope and trace files, this is collective on MPI_COMM_WORLD
+  static void writeRegionFiles();
   
-  //! execute perf counter to measure flops of the current PID
+  //! start measuring hardware counters (flops, cycles, instructions, cache misses) in the region "totalFlops", enables the hardware counters if needed
   static void startFlops();
 
-  //! stop perf
+  //! stop the region "totalFlops"
   static void endFlops();
 
   //! compute the mean magnitude of the given error vector or matrix and store it under name
@@ -66,14 +90,56 @@ private:
 
     double totalError;  //< sum of all errors
     int nErrors;        //< number of summands of totalError
+
+    TimerHandle timerHandle;  //< the handle of this measurement, -1 if no handle was created yet
   };
 
+  //! a node in the tree of nested regions
+  struct Region
+  {
+    //! constructor
+    Region(TimerHandle timerHandle, int parentRegionNo);
+
+    TimerHandle timerHandle;    //< the measurement of this region, -1 for the root
+    int parentRegionNo;         //< index of the parent region in regions_
+    std::vector<std::pair<TimerHandle,int>> children;   //< timer handles and region nos of the child regions
+    double start;               //< last start point in time
+    double inclusiveDuration;   //< total duration including the child regions
+    double childrenDuration;    //< total duration of the child regions
+    int nCalls;                 //< number of calls of this region
+  };
+
+  //! a recorded call of a region for the trace file
+  struct TraceEvent
+  {
+    TimerHandle timerHandle;    //< the measurement
+    double start;               //< start point in time
+    double duration;            //< duration of the call
+  };
+
+  //! get the region no of the child region of parentRegionNo with the given timer handle, create the region if it does not exist
+  static int getChildRegion(int parentRegionNo, TimerHandle timerHandle);
+
+  //! get the path of the region, i.e. the names of all parent regions and the region itself, separated by "/"
+  static std::string getRegionPath(int regionNo);
+
+  //! write the Chrome trace file of the own rank
+  static void writeTraceFile();
+
+  //! escape quotes, backslashes and control characters such that the string can be written as JSON string
+  static std::string escapeJson(const std::string &string);
+
   static std::map<std::string, Measurement> measurements_;   //< the currently stored measurements
+  static std::vector<Measurement *> timers_;                 //< pointers to the measurements in measurements_, indexed by timer handle
+  static std::vector<std::string> timerNames_;               //< the names of the measurements, indexed by timer handle
+  static std::vector<Region> regions_;                       //< the tree of regions, regions_[0] is the root
+  static std::vector<int> regionStack_;                      //< the region nos of the currently running regions
+  static std::vector<TraceEvent> traceEvents_;               //< recorded region calls for the trace file
+  static std::string regionsFilename_;                       //< filename without suffix of the region summary and speedscope file, empty (default) to disable
+  static std::string traceFilename_;                         //< filename without suffix of the Chrome trace file, empty to disable
+  static int maxNTraceEvents_;                               //< maximum number of recorded region calls per rank
   static std::map<std::string, int> sums_;   //< the currently stored sums
   static std::map<std::string,std::string> parameters_;   //< arbitrary parameters that will be stored in the log
-
-  static std::shared_ptr<std::thread> perfThread_;  //< thread used to execute perf which measures FLOPS
-  static int perfThreadHandle_;   //< handle of the perf thread
 };
 
 template<>
@@ -13,6 +13,7 @@
 #include <iomanip>
 
 #include "output_writer/generic.h"
+#include "control/diagnostic_tool/hardware_counters.h"
 
 namespace Control
 {
@@ -23,6 +24,15 @@ void PerformanceMeasurement::writeLogFile(std::string logFileName)
 
   parseStatusInformation();
 
+  // add derived metrics of the hardware counters (GFLOP/s, IPC, bytes per flop) of every measurement as parameters
+  if (HardwareCounters::isEnabled())
+  {
+    std::vector<double> durations;
+    for (Measurement *measurement : timers_)
+      durations.push_back(measurement->totalDuration);
+    HardwareCounters::storeDerivedMetrics(timerNames_, durations);
+  }
+
   const bool useMPIOutput = true;   /// if the output is using MPI Output
 
   int ownRankNo = DihuContext::ownRankNoCommWorld();
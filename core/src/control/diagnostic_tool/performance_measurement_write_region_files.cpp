@@ -0,0 +1,288 @@
+#include "control/diagnostic_tool/performance_measurement.h"
+
+#include "easylogging++.h"
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <set>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#include "output_writer/generic.h"
+#include "utility/mpi_utility.h"
+
+namespace Control
+{
+
+void PerformanceMeasurement::writeRegionFiles()
+{
+  if (!traceFilename_.empty())
+  {
+    writeTraceFile();
+  }
+
+  if (regionsFilename_.empty())
+    return;
+
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+  int nRanks = DihuContext::nRanksCommWorld();
+
+  // collect the paths of all regions of the own rank, separated by newlines
+  std::map<std::string,int> ownRegionNos;     // region no for every path
+  std::stringstream ownPaths;
+  for (int regionNo = 1; regionNo < (int)regions_.size(); regionNo++)
+  {
+    std::string path = getRegionPath(regionNo);
+    ownRegionNos[path] = regionNo;
+    ownPaths << path << "\n";
+  }
+  std::string ownPathsString = ownPaths.str();
+
+  // gather the paths of all ranks on rank 0, different ranks can have different regions
+  int ownPathsLength = ownPathsString.length();
+  std::vector<int> pathsLengths(nRanks);
+  MPIUtility::handleReturnValue(MPI_Gather(&ownPathsLength, 1, MPI_INT, pathsLengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Gather");
+
+  std::vector<int> offsets(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+  {
+    offsets[rankNo] = offsets[rankNo-1] + pathsLengths[rankNo-1];
+  }
+
+  std::vector<char> allPaths(ownRankNo == 0? offsets[nRanks-1] + pathsLengths[nRanks-1] : 0);
+  MPIUtility::handleReturnValue(MPI_Gatherv(ownPathsString.data(), ownPathsLength, MPI_CHAR,
+                                            allPaths.data(), pathsLengths.data(), offsets.data(), MPI_CHAR, 0, MPI_COMM_WORLD), "MPI_Gatherv");
+
+  // create the sorted union of all paths on rank 0 and send it to all ranks
+  std::string unionPathsString;
+  if (ownRankNo == 0)
+  {
+    // sort paths such that children directly follow their parent, i.e. "/" is ordered before all other characters
+    auto comparePaths = [](const std::string &path1, const std::string &path2)
+    {
+      return std::lexicographical_compare(path1.begin(), path1.end(), path2.begin(), path2.end(), [](char a, char b)
+      {
+        return (a == '/'? '\0' : a) < (b == '/'? '\0' : b);
+      });
+    };
+    std::set<std::string,decltype(comparePaths)> unionPaths(comparePaths);
+    std::stringstream stream(std::string(allPaths.begin(), allPaths.end()));
+    std::string path;
+    while (std::getline(stream, path))
+    {
+      if (!path.empty())
+        unionPaths.insert(path);
+    }
+
+    std::stringstream unionPathsStream;
+    for (const std::string &path : unionPaths)
+    {
+      unionPathsStream << path << "\n";
+    }
+    unionPathsString = unionPathsStream.str();
+  }
+
+  int unionPathsLength = unionPathsString.length();
+  MPIUtility::handleReturnValue(MPI_Bcast(&unionPathsLength, 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Bcast");
+  unionPathsString.resize(unionPathsLength);
+  MPIUtility::handleReturnValue(MPI_Bcast(&unionPathsString[0], unionPathsLength, MPI_CHAR, 0, MPI_COMM_WORLD), "MPI_Bcast");
+
+  std::vector<std::string> paths;
+  std::stringstream stream(unionPathsString);
+  std::string path;
+  while (std::getline(stream, path))
+  {
+    paths.push_back(path);
+  }
+
+  // fill values of the own regions, regions that do not exist on the own rank have zero duration
+  const int nPaths = paths.size();
+  std::vector<double> inclusiveDurations(nPaths, 0.0);
+  std::vector<double> exclusiveDurations(nPaths, 0.0);
+  std::vector<double> nCalls(nPaths, 0.0);
+
+  for (int pathIndex = 0; pathIndex < nPaths; pathIndex++)
+  {
+    std::map<std::string,int>::iterator iter = ownRegionNos.find(paths[pathIndex]);
+    if (iter != ownRegionNos.end())
+    {
+      const Region &region = regions_[iter->second];
+      inclusiveDurations[pathIndex] = region.inclusiveDuration;
+      exclusiveDurations[pathIndex] = region.inclusiveDuration - region.childrenDuration;
+      nCalls[pathIndex] = region.nCalls;
+    }
+  }
+
+  // reduce minimum, maximum and sum of all values on rank 0
+  std::vector<double> inclusiveMin(nPaths), inclusiveMax(nPaths), inclusiveSum(nPaths);
+  std::vector<double> exclusiveMin(nPaths), exclusiveMax(nPaths), exclusiveSum(nPaths);
+  std::vector<double> nCallsSum(nPaths);
+
+  MPIUtility::handleReturnValue(MPI_Reduce(inclusiveDurations.data(), inclusiveMin.data(), nPaths, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(inclusiveDurations.data(), inclusiveMax.data(), nPaths, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(inclusiveDurations.data(), inclusiveSum.data(), nPaths, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(exclusiveDurations.data(), exclusiveMin.data(), nPaths, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(exclusiveDurations.data(), exclusiveMax.data(), nPaths, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(exclusiveDurations.data(), exclusiveSum.data(), nPaths, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(nCalls.data(), nCallsSum.data(), nPaths, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD), "MPI_Reduce");
+
+  if (ownRankNo != 0)
+    return;
+
+  // write text file with the region tree, the paths are sorted such that children follow their parents
+  std::ofstream file;
+  OutputWriter::Generic::openFile(file, regionsFilename_ + ".txt");
+  if (!file.is_open())
+    return;
+
+  file << "# region tree of " << DihuContext::versionText() << ", " << nRanks << " ranks, durations in s, min/avg/max over ranks" << std::endl
+    << "# " << std::setw(58) << std::left << "region" << std::right
+    << std::setw(12) << "n calls"
+    << std::setw(12) << "incl. min" << std::setw(12) << "incl. avg" << std::setw(12) << "incl. max"
+    << std::setw(12) << "excl. min" << std::setw(12) << "excl. avg" << std::setw(12) << "excl. max" << std::endl;
+
+  for (int pathIndex = 0; pathIndex < nPaths; pathIndex++)
+  {
+    // indent the name of the region according to its depth
+    int depth = std::count(paths[pathIndex].begin(), paths[pathIndex].end(), '/');
+    std::string name = paths[pathIndex].substr(paths[pathIndex].rfind('/') == std::string::npos? 0 : paths[pathIndex].rfind('/')+1);
+
+    file << "  " << std::setw(58) << std::left << (std::string(2*depth, ' ') + name) << std::right
+      << std::setw(12) << nCallsSum[pathIndex] / nRanks
+      << std::setw(12) << inclusiveMin[pathIndex] << std::setw(12) << inclusiveSum[pathIndex] / nRanks << std::setw(12) << inclusiveMax[pathIndex]
+      << std::setw(12) << exclusiveMin[pathIndex] << std::setw(12) << exclusiveSum[pathIndex] / nRanks << std::setw(12) << exclusiveMax[pathIndex]
+      << std::endl;
+  }
+  file.close();
+
+  // write speedscope file (https://www.speedscope.app), as sampled profile where every region is one sample weighted by its average exclusive duration
+  std::vector<std::string> frameNames;
+  std::map<std::string,int> frameNos;
+  std::stringstream samples;
+  std::stringstream weights;
+  double totalDuration = 0;
+
+  for (int pathIndex = 0; pathIndex < nPaths; pathIndex++)
+  {
+    std::stringstream pathStream(paths[pathIndex]);
+    std::string frameName;
+
+    if (pathIndex > 0)
+    {
+      samples << ",";
+      weights << ",";
+    }
+
+    samples << "[";
+    bool isFirstFrame = true;
+    while (std::getline(pathStream, frameName, '/'))
+    {
+      if (frameNos.find(frameName) == frameNos.end())
+      {
+        frameNos[frameName] = frameNames.size();
+        frameNames.push_back(frameName);
+      }
+      if (!isFirstFrame)
+        samples << ",";
+      samples << frameNos[frameName];
+      isFirstFrame = false;
+    }
+    samples << "]";
+
+    double weight = exclusiveSum[pathIndex] / nRanks;
+    weights << weight;
+    totalDuration += weight;
+  }
+
+  OutputWriter::Generic::openFile(file, regionsFilename_ + ".speedscope.json");
+  if (!file.is_open())
+    return;
+
+  file << "{\"$schema\":\"https://www.speedscope.app/file-format-schema.json\",\"shared\":{\"frames\":[";
+  for (int frameNo = 0; frameNo < (int)frameNames.size(); frameNo++)
+  {
+    if (frameNo > 0)
+      file << ",";
+    file << "{\"name\":\"" << escapeJson(frameNames[frameNo]) << "\"}";
+  }
+  file << "]},\"profiles\":[{\"type\":\"sampled\",\"name\":\"average over " << nRanks << " ranks\",\"unit\":\"seconds\",\"startValue\":0,"
+    << "\"endValue\":" << totalDuration << ",\"samples\":[" << samples.str() << "],\"weights\":[" << weights.str() << "]}],"
+    << "\"name\":\"" << escapeJson(getParameter("scenarioName")) << "\",\"exporter\":\"opendihu\"}" << std::endl;
+  file.close();
+}
+
+void PerformanceMeasurement::writeTraceFile()
+{
+  // write Chrome trace file (chrome://tracing or https://ui.perfetto.dev), one file per rank
+  std::stringstream filename;
+  filename << traceFilename_ << "." << std::setw(7) << std::setfill('0') << DihuContext::ownRankNoCommWorld() << ".json";
+
+  std::ofstream file;
+  OutputWriter::Generic::openFile(file, filename.str());
+  if (!file.is_open())
+    return;
+
+  double beginTime = 0;
+  if (!traceEvents_.empty())
+  {
+    beginTime = traceEvents_.front().start;
+    for (const TraceEvent &traceEvent : traceEvents_)
+      beginTime = std::min(beginTime, traceEvent.start);
+  }
+
+  // timestamps and durations are in microseconds
+  file << "{\"traceEvents\":[";
+  for (int eventNo = 0; eventNo < (int)traceEvents_.size(); eventNo++)
+  {
+    const TraceEvent &traceEvent = traceEvents_[eventNo];
+    if (eventNo > 0)
+      file << ",\n";
+    file << "{\"name\":\"" << escapeJson(timerNames_[traceEvent.timerHandle]) << "\",\"ph\":\"X\",\"pid\":" << DihuContext::ownRankNoCommWorld() << ",\"tid\":0,"
+      << "\"ts\":" << std::fixed << std::setprecision(3) << (traceEvent.start - beginTime)*1e6 << ",\"dur\":" << traceEvent.duration*1e6 << "}";
+  }
+  file << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+  file.close();
+
+  if ((int)traceEvents_.size() >= maxNTraceEvents_)
+  {
+    LOG(WARNING) << "The trace file \"" << filename.str() << "\" only contains the first " << maxNTraceEvents_ << " region calls.";
+  }
+}
+
+std::string PerformanceMeasurement::escapeJson(const std::string &string)
+{
+  std::stringstream result;
+  for (char character : string)
+  {
+    switch (character)
+    {
+    case '"':
+      result << "\\\"";
+      break;
+    case '\\':
+      result << "\\\\";
+      break;
+    case '\n':
+      result << "\\n";
+      break;
+    case '\t':
+      result << "\\t";
+      break;
+    default:
+      // other control characters are written as unicode escape sequence
+      if ((unsigned char)character < 0x20)
+      {
+        result << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)character << std::dec;
+      }
+      else
+      {
+        result << character;
+      }
+    }
+  }
+  return result.str();
+}
+
+} // namespace
@@ -29,6 +29,7 @@
 #include "solver/solver_manager.h"
 #include "partition/partition_manager.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
+#include "control/checkpointing/checkpointing.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
 #include "slot_connection/global_connections_by_slot_name.h"
 
@@ -586,10 +587,14 @@ DihuContext::~DihuContext()
   VLOG(1) << "~DihuContext, nObjects = " << nObjects_;
   if (nObjects_ == 0)
   {
+    // complete the last checkpoint, if it is still being written
+    Control::Checkpointing::finishPendingWrite();
+
     // write log files
     writeSolverStructureDiagram();
     Control::StimulationLogging::writeLogFile();
     Control::PerformanceMeasurement::writeLogFile();
+    Control::PerformanceMeasurement::writeRegionFiles();
     MappingBetweenMeshes::Manager::writeLogFile();
 
     // After a call to MPI_Finalize we cannot call MPI_Initialize() anymore.
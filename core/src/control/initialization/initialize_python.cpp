@@ -3,6 +3,9 @@
 #include <Python.h>  // this has to be the first included header
 #include <python_home.h>  // defines PYTHON_HOME_DIRECTORY
 #include "control/diagnostic_tool/performance_measurement.h"
+#include "control/diagnostic_tool/hardware_counters.h"
+#include "control/checkpointing/checkpointing.h"
+#include "partition/partitioned_petsc_vec/values_representation.h"
 #include "utility/python_capture_stderr.h"
 #include "control/initialization/python_opendihu_module.h"
 
@@ -338,6 +341,35 @@ void DihuContext::parseGlobalParameters()
     setLogFormat(logFormatCsv);
   }
 
+  // parse filenames for the region profile and the trace of all region calls, both are disabled by default, "None" or "" disables the output
+  std::string regionsFilename = pythonConfig_.getOptionString("performanceRegionsFile", "");
+  std::string traceFilename = pythonConfig_.getOptionString("performanceTraceFile", "");
+  int maxNTraceEvents = pythonConfig_.getOptionInt("performanceTraceMaxEvents", 1000000, PythonUtility::Positive);
+  if (regionsFilename == "None")
+    regionsFilename = "";
+  if (traceFilename == "None")
+    traceFilename = "";
+  Control::PerformanceMeasurement::setRegionOutput(regionsFilename, traceFilename, maxNTraceEvents);
+
+  // open hardware counters for the regions of the performance measurement, this uses perf_event_open on Linux
+  if (pythonConfig_.getOptionBool("hardwareCounters", false))
+  {
+    Control::HardwareCounters::initialize();
+  }
+
+  // if multi-component field variables store their values in the contiguous vector that is used by CellML and the timestepping schemes
+  Partition::contiguousStorageEnabled = pythonConfig_.getOptionBool("contiguousStorage", false);
+
+  // parse the settings of checkpoint/restart, without "checkpointing" no checkpoints are written
+  if (pythonConfig_.hasKey("checkpointing"))
+  {
+    Control::Checkpointing::initialize(PythonConfig(pythonConfig_, "checkpointing"));
+  }
+  else
+  {
+    Control::Checkpointing::reset();
+  }
+
   // parse all keys under meta and add forward them directly to the log file
   // These parameters are not used by opendihu but can hold information that the
   // user wants to have in the log file.
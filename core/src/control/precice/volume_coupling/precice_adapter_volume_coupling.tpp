@@ -1,5 +1,9 @@
 #include "control/precice/volume_coupling/precice_adapter_volume_coupling.h"
 
+#include <cmath>
+
+#include "control/checkpointing/checkpointing.h"
+
 namespace Control
 {
 
@@ -14,11 +18,19 @@ run()
 
   double currentTime = 0;
 
+  // the adapter is the outermost solver, it writes the checkpoints of the whole simulation and continues from the last checkpoint if "restart" is set.
+  // The preCICE configuration and the coupled participant have to be set up such that they also start at the time of the checkpoint
+  const bool isOutermostSolver = Control::Checkpointing::claimOutermostSolver(this->context_.rankSubset()->mpiCommunicator());
+  if (isOutermostSolver)
+  {
+    Control::Checkpointing::restoreCheckpoint(currentTime);
+  }
+
   // if precice coupling is disabled in settings, run the timestep of the nested solver until endTimeIfCouplingDisabled_ is reached
   if (!this->couplingEnabled_)
   {
     const int nTimeSteps = this->endTimeIfCouplingDisabled_ / this->timeStepWidth_;
-    for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)
+    for (int timeStepNo = std::lround(currentTime / this->timeStepWidth_); timeStepNo < nTimeSteps; timeStepNo++)
     {
       if (timeStepNo % this->timeStepOutputInterval_ == 0 && (this->timeStepOutputInterval_ <= 10 || timeStepNo > 0))  // show first timestep only if timeStepOutputInterval is <= 10
       {
@@ -33,6 +45,9 @@ run()
 
       // increase current simulation time
       currentTime += this->timeStepWidth_;
+
+      if (isOutermostSolver)
+        Control::Checkpointing::writeCheckpointIfDue(currentTime);
     }
     return;
   }
@@ -115,6 +130,10 @@ run()
         // output all data in the nested solvers
         this->nestedSolver_.callOutputWriter(timeStepNo, currentTime);
       }
+
+      // only converged states of complete time windows are stored in checkpoints
+      if (isOutermostSolver)
+        Control::Checkpointing::writeCheckpointIfDue(currentTime);
     }
 
   }   // loop over time steps
@@ -22,6 +22,9 @@ public:
   
   //! initialize the function space for rows of the snapshot matrix
   virtual void setFunctionSpaceRows(std::shared_ptr<FunctionSpaceRowsType> functionSpace);
+
+  //! the function space for rows of the snapshot matrix
+  std::shared_ptr<FunctionSpaceRowsType> functionSpaceRows();
    
   //! Basis for the reduced solution, V
   std::shared_ptr<PartitionedPetscMat<FunctionSpaceRowsType,::FunctionSpace::Generic>> &basis();
@@ -25,6 +25,13 @@ setFunctionSpaceRows(std::shared_ptr<FunctionSpaceRows> functionSpace)
   this->functionSpaceRows_=functionSpace;
 }
 
+template<typename FunctionSpaceRows>
+std::shared_ptr<FunctionSpaceRows> ModelOrderReduction<FunctionSpaceRows>::
+functionSpaceRows()
+{
+  return this->functionSpaceRows_;
+}
+
 template<typename FunctionSpaceRows>  
 std::shared_ptr<PartitionedPetscMat<FunctionSpaceRows,::FunctionSpace::Generic>> 
 &ModelOrderReduction<FunctionSpaceRows>::
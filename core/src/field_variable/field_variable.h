@@ -20,6 +20,13 @@ public:
   
   //! this has to be called before the vector is manipulated (i.e. VecSetValues or vecZeroEntries is called), to ensure that the current state of the vector is fetched from the global vector
   void startGhostManipulation();
+
+  //! split-phase version of startGhostManipulation, starts the communication of the ghost values. Until startGhostManipulationEnd() is called, only non-ghost values may be read and no values may be set.
+  //! Computations that only need the own values (e.g. on the interior elements, see FunctionSpace::elementNosLocalInterior()) can be done in between to overlap them with the communication.
+  void startGhostManipulationBegin();
+
+  //! complete the communication of the ghost values that was started by startGhostManipulationBegin()
+  void startGhostManipulationEnd();
   
   //! zero all values in the local ghost buffer. Needed if between startGhostManipulation() and finishGhostManipulation() only some ghost will be reassigned. To prevent that the "old" ghost values that were present in the local ghost values buffer get again added to the real values which actually did not change.
   void zeroGhostBuffer();
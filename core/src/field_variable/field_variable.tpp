@@ -15,6 +15,24 @@ startGhostManipulation()
     this->values_->startGhostManipulation();
 }
 
+//! split-phase version of startGhostManipulation, starts the communication of the ghost values
+template<typename FunctionSpaceType,int nComponents>
+void FieldVariable<FunctionSpaceType,nComponents>::
+startGhostManipulationBegin()
+{
+  if (this->values_) // if there is an internal values_ vector (this is not the case for geometry fields of stencil-type settings)
+    this->values_->startGhostManipulationBegin();
+}
+
+//! complete the communication of the ghost values that was started by startGhostManipulationBegin()
+template<typename FunctionSpaceType,int nComponents>
+void FieldVariable<FunctionSpaceType,nComponents>::
+startGhostManipulationEnd()
+{
+  if (this->values_) // if there is an internal values_ vector (this is not the case for geometry fields of stencil-type settings)
+    this->values_->startGhostManipulationEnd();
+}
+
 //! this has to be called after the vector is manipulated (i.e. VecSetValues or vecZeroEntries is called), to ensure that operations on different partitions are merged by Petsc
 template<typename FunctionSpaceType,int nComponents>
 void FieldVariable<FunctionSpaceType,nComponents>::
@@ -9,6 +9,7 @@
 
 #include "field_variable/01_field_variable_components.h"
 #include "partition/partitioned_petsc_vec/partitioned_petsc_vec.h"
+#include "control/checkpointing/checkpointing.h"
 
 namespace FieldVariable
 {
@@ -112,7 +113,11 @@ public:
   
 protected:
 
+  //! register the values with Control::Checkpointing, called by the constructors that create a new values_ vector
+  void registerCheckpointingState();
+
   std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,nComponents_>> values_ = nullptr;          //< Petsc vector containing the values, the values for the components are stored as struct of array, e.g. (comp1val1, comp1val2, comp1val3, ..., comp2val1, comp2val2, comp2val3, ...). Dof ordering proceeds fastest over dofs of a node, then over nodes, node numbering is along whole domain, fastes in x, then in y,z direction.
+  int checkpointingHandle_ = -1;      //< handle of the registered state in Control::Checkpointing, -1 if not registered
 };
 
 } // namespace
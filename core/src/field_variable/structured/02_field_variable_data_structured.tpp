@@ -44,6 +44,10 @@ FieldVariableDataStructured(FieldVariable<FunctionSpaceType,nComponents> &rhs, s
     // else create new values vector
     this->values_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,nComponents>>(this->functionSpace_->meshPartition(), name);
   }
+
+  // if the data is reused, it is already stored in the checkpoint by rhs
+  if (!reuseData || !rhs.partitionedPetscVec())
+    registerCheckpointingState();
 }
 
 //! contructor as data copy with a different name and different components
@@ -77,6 +81,10 @@ FieldVariableDataStructured(FieldVariable<FunctionSpaceType,nComponents2> &rhs,
     // else create new values vector
     this->values_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,nComponents>>(this->functionSpace_->meshPartition(), name);
   }
+
+  // if the data is reused, it is already stored in the checkpoint by rhs
+  if (!reuseData || !rhs.partitionedPetscVec())
+    registerCheckpointingState();
 }
 
 //! constructor with functionSpace, name and components
@@ -109,6 +117,7 @@ FieldVariableDataStructured(std::shared_ptr<FunctionSpaceType> functionSpace, st
   {
     //LOG(DEBUG) << "create a field variable with values_ vector";
     this->values_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,nComponents>>(this->functionSpace_->meshPartition(), name);
+    registerCheckpointingState();
   }
   else
   {
@@ -120,6 +129,63 @@ template<typename FunctionSpaceType, int nComponents>
 FieldVariableDataStructured<FunctionSpaceType,nComponents>::
 ~FieldVariableDataStructured()
 {
+  Control::Checkpointing::unregisterState(checkpointingHandle_);
+}
+
+template<typename FunctionSpaceType, int nComponents>
+void FieldVariableDataStructured<FunctionSpaceType,nComponents>::
+registerCheckpointingState()
+{
+  if (!Control::Checkpointing::enabled())
+    return;
+
+  std::string key = std::string("fieldVariable/") + this->functionSpace_->meshName() + "/" + this->name_;
+
+  // the functions only hold a weak pointer, because values_ may be replaced, e.g. by the surface field variables
+  std::weak_ptr<PartitionedPetscVec<FunctionSpaceType,nComponents>> valuesWeak = this->values_;
+
+  // store the local values without ghosts of all components
+  Control::Checkpointing::SaveFunction save = [valuesWeak](std::vector<double> &values)
+  {
+    std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,nComponents>> partitionedPetscVec = valuesWeak.lock();
+    if (!partitionedPetscVec)
+      return;
+
+    const dof_no_t nDofsLocal = partitionedPetscVec->meshPartition()->nDofsLocalWithoutGhosts();
+    const PetscInt *dofNosLocal = partitionedPetscVec->meshPartition()->dofNosLocal().data();
+
+    values.resize(nComponents*nDofsLocal);
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      partitionedPetscVec->getValues(componentNo, nDofsLocal, dofNosLocal, values.data() + componentNo*nDofsLocal);
+    }
+  };
+
+  // set the local values and update the ghost values
+  Control::Checkpointing::RestoreFunction restore = [valuesWeak,key](const std::vector<double> &values)
+  {
+    std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,nComponents>> partitionedPetscVec = valuesWeak.lock();
+    if (!partitionedPetscVec)
+      return;
+
+    const dof_no_t nDofsLocal = partitionedPetscVec->meshPartition()->nDofsLocalWithoutGhosts();
+    const PetscInt *dofNosLocal = partitionedPetscVec->meshPartition()->dofNosLocal().data();
+
+    if ((dof_no_t)values.size() != nComponents*nDofsLocal)
+    {
+      LOG(FATAL) << "Checkpoint contains " << values.size() << " values for \"" << key << "\", but " << nComponents*nDofsLocal << " are needed. "
+        << "The settings differ from the run that wrote the checkpoint.";
+    }
+
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      partitionedPetscVec->setValues(componentNo, nDofsLocal, dofNosLocal, values.data() + componentNo*nDofsLocal, INSERT_VALUES);
+    }
+    partitionedPetscVec->setRepresentationGlobal();
+    partitionedPetscVec->startGhostManipulation();
+  };
+
+  checkpointingHandle_ = Control::Checkpointing::registerState(key, save, restore);
 }
 /*
 template<typename FunctionSpaceType, int nComponents>
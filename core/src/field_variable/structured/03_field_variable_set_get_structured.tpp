@@ -354,21 +354,23 @@ getElementValues(Vc::int_v elementNoLocal,
 
   VLOG(2) << "getElementValues (vectorized) element " << elementNoLocal << ", nComponents=" << nComponents << ", nDofsPerElement=" << nDofsPerElement << ", nVcComponents: " << nVcComponents;
 
-  // prepare lookup indices for PETSc vector values_
-  for (int componentIndex = 0; componentIndex < nComponents; componentIndex++)
+  // prepare lookup indices for PETSc vector values_, the dof nos are taken from the precomputed table of the function space,
+  // they are the same for all components
+  std::array<Vc::int_v,nDofsPerElement> dofNosLocal = this->functionSpace_->getElementDofNosLocal(elementNoLocal);
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
   {
-    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
     {
-      for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
-      {
-        if (elementNoLocal[vcComponent] == -1)
-          indices[dofIndex*nVcComponents + vcComponent] = 0;    // set index to 0, then here the dof 0 is retrieved and also further used in computation but it is discarded later in setValue
-        else
-          indices[dofIndex*nVcComponents + vcComponent] = this->functionSpace_->getDofNo(elementNoLocal[vcComponent], dofIndex);
-        //LOG(DEBUG) << "    element " << elementNoLocal[vcComponent] << " dof " << dofIndex << ": indices[" << dofIndex*nVcComponents + vcComponent << "]: " << indices[dofIndex*nVcComponents + vcComponent];
-      }
+      if (elementNoLocal[vcComponent] == -1)
+        indices[dofIndex*nVcComponents + vcComponent] = 0;    // set index to 0, then here the dof 0 is retrieved and also further used in computation but it is discarded later in setValue
+      else
+        indices[dofIndex*nVcComponents + vcComponent] = dofNosLocal[dofIndex][vcComponent];
+      //LOG(DEBUG) << "    element " << elementNoLocal[vcComponent] << " dof " << dofIndex << ": indices[" << dofIndex*nVcComponents + vcComponent << "]: " << indices[dofIndex*nVcComponents + vcComponent];
     }
+  }
 
+  for (int componentIndex = 0; componentIndex < nComponents; componentIndex++)
+  {
     // get the values for the current component
     this->values_->getValues(componentIndex, nDofsPerElement*nVcComponents, indices.data(), (double *)&result[componentIndex*nDofsPerElement]);
 
@@ -38,6 +38,8 @@ getElementValues(Vc::int_v elementNoLocal, std::array<Vc::double_v,FunctionSpace
   std::array<PetscInt, nDofsPerElement*nVcComponents> indices;
   std::array<Vc::double_v, nDofsPerElement> result;
 
+  // the dof nos are taken from the precomputed table of the function space
+  std::array<Vc::int_v,nDofsPerElement> dofNosLocal = this->functionSpace_->getElementDofNosLocal(elementNoLocal);
   for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
   {
     for (int vcComponentNo = 0; vcComponentNo < nVcComponents; vcComponentNo++)
@@ -45,7 +47,7 @@ getElementValues(Vc::int_v elementNoLocal, std::array<Vc::double_v,FunctionSpace
       if (elementNoLocal[vcComponentNo] == -1)
         indices[dofIndex*nVcComponents + vcComponentNo] = 0;     // set index to 0, then here the dof 0 is retrieved and also further used in computation but it is discarded later in setValue
       else
-        indices[dofIndex*nVcComponents + vcComponentNo] = this->functionSpace_->getDofNo(elementNoLocal[vcComponentNo], dofIndex);
+        indices[dofIndex*nVcComponents + vcComponentNo] = dofNosLocal[dofIndex][vcComponentNo];
     }
   }
 
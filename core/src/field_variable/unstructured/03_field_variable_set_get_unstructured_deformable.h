@@ -153,6 +153,11 @@ public:
 
   //! set value to zero for all dofs
   void zeroEntries();
+
+protected:
+
+  //! number of values that getValuesWithoutGhosts returns per component, i.e. the number of own dofs or own nodal dofs
+  dof_no_t nValuesWithoutGhosts(bool onlyNodalValues) const;
 };
 
 } // namespace
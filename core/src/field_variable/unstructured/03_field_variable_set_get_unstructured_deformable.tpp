@@ -27,7 +27,9 @@ template<typename FunctionSpaceType, int nComponents>
 void FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
 getValuesWithoutGhosts(int componentNo, std::vector<double> &values, bool onlyNodalValues) const
 {
+  // the local dofs are ordered such that the own dofs come first, followed by the ghost dofs
   this->getValuesWithGhosts(componentNo, values, onlyNodalValues);
+  values.resize(nValuesWithoutGhosts(onlyNodalValues));
 }
 
 //! for a specific component, get all values
@@ -78,6 +80,7 @@ void FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
 getValuesWithoutGhosts(std::vector<std::array<double,nComponents>> &values, bool onlyNodalValues) const
 {
   this->getValuesWithGhosts(values, onlyNodalValues);
+  values.resize(nValuesWithoutGhosts(onlyNodalValues));
 }
 
 //! for a specific component, get all values
@@ -86,6 +89,23 @@ void FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
 getValuesWithoutGhosts(std::array<std::vector<double>,nComponents> &values, bool onlyNodalValues) const
 {
   this->getValuesWithGhosts(values, onlyNodalValues);
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+  {
+    values[componentNo].resize(nValuesWithoutGhosts(onlyNodalValues));
+  }
+}
+
+template<typename FunctionSpaceType, int nComponents>
+dof_no_t FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
+nValuesWithoutGhosts(bool onlyNodalValues) const
+{
+  const dof_no_t nDofsLocalWithoutGhosts = this->functionSpace_->nDofsLocalWithoutGhosts();
+
+  // for Hermite, only every nDofsPerNode'th value is a nodal value
+  if (onlyNodalValues && std::is_same<typename FunctionSpaceType::BasisFunction, BasisFunction::Hermite>::value)
+    return nDofsLocalWithoutGhosts / FunctionSpaceType::nDofsPerNode();
+
+  return nDofsLocalWithoutGhosts;
 }
 
 //! get values from their local dof no.s for all components, this eventually does not get all values if there are multiple versions
@@ -273,20 +293,22 @@ getElementValues(Vc::int_v elementNoLocal,
 
   VLOG(2) << "getElementValues (vectorized) element " << elementNoLocal << ", nComponents=" << nComponents << ", nDofsPerElement=" << nDofsPerElement;
 
-  // prepare lookup indices for PETSc vector values_
-  for (int componentIndex = 0; componentIndex < nComponents; componentIndex++)
+  // prepare lookup indices for PETSc vector values_, the dof nos are taken from the precomputed table of the function space,
+  // they are the same for all components
+  std::array<Vc::int_v,nDofsPerElement> dofNosLocal = this->functionSpace_->getElementDofNosLocal(elementNoLocal);
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
   {
-    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
     {
-      for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
-      {
-        if (elementNoLocal[vcComponent] == -1)
-          indices[dofIndex*nVcComponents + vcComponent] = 0;   // set index to 0, then here the dof 0 is retrieved and also further used in computation but it is discarded later in setValue
-        else
-          indices[dofIndex*nVcComponents + vcComponent] = this->functionSpace_->getDofNo(elementNoLocal[vcComponent], dofIndex);
-      }
+      if (elementNoLocal[vcComponent] == -1)
+        indices[dofIndex*nVcComponents + vcComponent] = 0;   // set index to 0, then here the dof 0 is retrieved and also further used in computation but it is discarded later in setValue
+      else
+        indices[dofIndex*nVcComponents + vcComponent] = dofNosLocal[dofIndex][vcComponent];
     }
+  }
 
+  for (int componentIndex = 0; componentIndex < nComponents; componentIndex++)
+  {
     // get the values for the current component
     this->values_->getValues(componentIndex, nDofsPerElement*nVcComponents, indices.data(), (double *)&result[componentIndex*nDofsPerElement]);
   }
@@ -578,8 +600,11 @@ void FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
 setValuesWithoutGhosts(const std::vector<std::array<double,nComponents>> &values, InsertMode petscInsertMode)
 {
   assert(values.size() == this->functionSpace_->meshPartition()->nDofsLocalWithoutGhosts());
-  
-  this->setValues(this->functionSpace_->meshPartition()->dofNosLocal(), values, petscInsertMode);
+
+  // only the first dof nos are used, these are the own dofs
+  std::vector<dof_no_t> dofNosLocalWithoutGhosts(this->functionSpace_->meshPartition()->dofNosLocal().begin(),
+                                                 this->functionSpace_->meshPartition()->dofNosLocal().begin() + values.size());
+  this->setValues(dofNosLocalWithoutGhosts, values, petscInsertMode);
 }
 
 //! set value to zero for all dofs
@@ -59,6 +59,8 @@ getElementValues(Vc::int_v elementNoLocal, std::array<Vc::double_v,FunctionSpace
   std::array<PetscInt, nDofsPerElement*nVcComponents> indices;
   std::array<Vc::double_v, nDofsPerElement> result;
 
+  // the dof nos are taken from the precomputed table of the function space
+  std::array<Vc::int_v,nDofsPerElement> dofNosLocal = this->functionSpace_->getElementDofNosLocal(elementNoLocal);
   for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
   {
     for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
@@ -66,12 +68,12 @@ getElementValues(Vc::int_v elementNoLocal, std::array<Vc::double_v,FunctionSpace
       if (elementNoLocal[vcComponent] == -1)
         indices[dofIndex*nVcComponents + vcComponent] = 0;    // set index to 0, then here the dof 0 is retrieved and also further used in computation but it is discarded later in setValue
       else
-        indices[dofIndex*nVcComponents + vcComponent] = this->functionSpace_->getDofNo(elementNoLocal[vcComponent], dofIndex);
+        indices[dofIndex*nVcComponents + vcComponent] = dofNosLocal[dofIndex][vcComponent];
     }
   }
 
   // get the values for the current component
-  this->values_->getValues(0, nDofsPerElement*nVcComponents, indices.data(), (double *)&result[nDofsPerElement]);
+  this->values_->getValues(0, nDofsPerElement*nVcComponents, indices.data(), (double *)result.data());
 
   // copy result to output values
   for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
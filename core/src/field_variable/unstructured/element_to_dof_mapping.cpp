@@ -203,6 +203,55 @@ std::shared_ptr<NodeToDofMapping> ElementToDofMapping::setup(std::shared_ptr<Exf
   return nodeToDofMapping;
 }
 
+std::shared_ptr<NodeToDofMapping> ElementToDofMapping::setupLocal(std::shared_ptr<ExfileRepresentation> exfileRepresentation,
+                                                                  std::shared_ptr<ElementToNodeMapping> elementToNodeMapping,
+                                                                  const std::vector<std::vector<dof_no_t>> &nodeDofNos, const int nDofsPerNode, dof_no_t nDofsLocal)
+{
+  // for setupLocal to work we need the number of elements already set (by a previous call to setNumberElements)
+  element_no_t nElements = elementDofs_.size();
+
+  // create node to dof mapping of the local nodes, the dofs are already numbered
+  std::shared_ptr<NodeToDofMapping> nodeToDofMapping = std::make_shared<NodeToDofMapping>();
+
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < (node_no_t)nodeDofNos.size(); nodeNoLocal++)
+  {
+    NodeToDofMapping::NodeDofInformation &nodeDofInformation = nodeToDofMapping->getNodeDofInformation(nodeNoLocal);
+    nodeDofInformation.dofs = nodeDofNos[nodeNoLocal];
+    nodeDofInformation.elementsOfVersion.resize(nodeDofNos[nodeNoLocal].size() / nDofsPerNode);
+  }
+
+  // loop over local elements
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElements; elementNoLocal++)
+  {
+    ElementToNodeMapping::Element &element = elementToNodeMapping->getElement(elementNoLocal);
+    std::shared_ptr<ExfileElementRepresentation> exfileElement = exfileRepresentation->getExfileElementRepresentation(elementNoLocal);
+
+    unsigned int nNodesInElement = element.nodeGlobalNo.size();
+    elementDofs_[elementNoLocal].resize(nNodesInElement*nDofsPerNode);
+
+    int elementDofIndex = 0;
+    for (unsigned int nodeIndex = 0; nodeIndex < nNodesInElement; nodeIndex++)
+    {
+      const ExfileElementRepresentation::Node &exfileNode = exfileElement->getNode(nodeIndex);
+      NodeToDofMapping::NodeDofInformation &nodeDofInformation = nodeToDofMapping->getNodeDofInformation(element.nodeGlobalNo[nodeIndex]);
+
+      // add the element to the elements of the version that it uses
+      unsigned int versionNo = int(exfileNode.valueIndices[0] / nDofsPerNode);
+      assert(versionNo < nodeDofInformation.elementsOfVersion.size());
+      nodeDofInformation.elementsOfVersion[versionNo].push_back({elementNoLocal, nodeIndex});
+
+      for (int dofIndex = 0; dofIndex < nDofsPerNode; dofIndex++)
+      {
+        elementDofs_[elementNoLocal][elementDofIndex++] = nodeDofInformation.dofs[exfileNode.valueIndices[dofIndex]];
+      }
+    }
+  }
+
+  nDofs_ = nDofsLocal;
+
+  return nodeToDofMapping;
+}
+
 dof_no_t ElementToDofMapping::nDofsLocal() const
 {
   return nDofs_;
@@ -30,6 +30,13 @@ public:
                                           std::shared_ptr<ElementToNodeMapping> elementToNodeMapping,
                                           const int nDofsPerNode);
 
+  //! setup the element to dof mapping of a subdomain and create the node to dof mapping of the subdomain, elementToNodeMapping contains local node nos,
+  //! nodeDofNos contains for every local node the local dof nos indexed by the exfile value index, nDofsPerNode for every version,
+  //! all versions of a local node are kept, also if they are only used by non-local elements
+  std::shared_ptr<NodeToDofMapping> setupLocal(std::shared_ptr<ExfileRepresentation> exfileRepresentation,
+                                               std::shared_ptr<ElementToNodeMapping> elementToNodeMapping,
+                                               const std::vector<std::vector<dof_no_t>> &nodeDofNos, const int nDofsPerNode, dof_no_t nDofsLocal);
+
   //! get all dofs of an element
   const std::vector<dof_no_t> &getElementDofs(element_no_t elementGlobalNo) const;
 
@@ -5,6 +5,7 @@
 #include "function_space/02_function_space_jacobian.h"
 #include "partition/mesh_partition/01_mesh_partition.h"
 #include "partition/mesh_partition/00_mesh_partition_base.h"
+#include "partition/mesh_partition/unstructured_partitioning.h"
 #include "mesh/composite.h"
 
 // forward declaration
@@ -84,7 +85,9 @@ public:
   virtual global_no_t nDofsGlobal() const = 0;
 
   // nDofsGlobal() is defined in 06_function_space_dofs_nodes.h
-  
+
+protected:
+  std::shared_ptr<Partition::UnstructuredPartitioning> partitioning_;   //< the distribution of the mesh to the ranks, if it is set, the meshPartition is created from it
 };
 
 /** specialization for composite structured meshes
@@ -32,8 +32,23 @@ initialize()
   assert(this->nNodesGlobal() != 0);
   assert(this->nDofsGlobal() != 0);
   
-  this->meshPartition_ = this->partitionManager_->template createPartitioningUnstructured<FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>>(
-    this->nElementsGlobal(), this->nNodesGlobal(), this->nDofsGlobal());
+  // if the mesh was distributed by initializeDistributedMesh, use the partitioning, otherwise create a serial partition
+  if (this->partitioning_)
+  {
+    this->meshPartition_ = this->partitionManager_->template createPartitioningUnstructured<FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>>(
+      this->partitioning_);
+  }
+  else
+  {
+    this->meshPartition_ = this->partitionManager_->template createPartitioningUnstructured<FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>>(
+      this->nElementsGlobal(), this->nNodesGlobal(), this->nDofsGlobal());
+
+    if (this->meshPartition_->nRanks() > 1)
+    {
+      LOG(FATAL) << "A serial partition of an unstructured mesh was created for " << this->meshPartition_->nRanks() << " ranks, "
+        << "a mesh on more than one rank has to be distributed by initializeDistributedMesh.";
+    }
+  }
 
   // set initalized_ to true which indicates that initialize has been called
   this->initialized_ = true;
@@ -53,7 +53,7 @@ public:
   //! return the global node number of element-local node nodeIndex of element elementNo, nElements is the total number of elements
   node_no_t getNodeNo(element_no_t elementNo, int nodeIndex) const;
 
-  //! return the global/natural node number of element-local node nodeIndex of element elementNo, nElements is the total number of elements, this is the same as getNodeNo because there are no global numbers for unstructured meshes
+  //! return the global/natural node number of element-local node nodeIndex of element elementNo, for a serial mesh this is the same as getNodeNo, for a distributed mesh the element has to be local
   global_no_t getNodeNoGlobalNatural(global_no_t elementNoGlobalNatural, int nodeIndex) const;
 
   //! get all dofs of a specific node, as vector, the array version that is present for structured meshes does not make sense here, because with versions the number of dofs per node is not static.
@@ -92,9 +92,44 @@ protected:
   //! multiply dof values with scale factors such that scale factor information is completely contained in dof values
   void eliminateScaleFactors();
 
-  //! parse the element and node positions from python settings
+  //! an element given by the global node nos and the versions of its nodes, as specified in the settings or in a binary mesh file
+  struct UnstructuredElement
+  {
+    struct ElementNode
+    {
+      node_no_t nodeGlobalNo;   //< the global natural node no
+      unsigned int versionNo;   //< the version of the node that is used by the element
+    };
+    std::vector<ElementNode> nodes;
+  };
+
+  //! parse the element and node positions from python settings, every rank only converts its block of elements and the node positions it needs,
+  //! distribute the mesh to the ranks and set up the local mappings
   void parseFromSettings(PythonConfig settings);
 
+  //! read the mesh from a binary mesh file, every rank reads a block of elements and the node values of its local nodes, distribute the mesh to the ranks and set up the local mappings
+  void parseBinaryFile(std::string binaryFilename);
+
+  //! write the geometry of the mesh that was read from exfiles to a binary mesh file, the local elements and own nodes are gathered on the first rank
+  //! of the partition, which writes the file, Hermite meshes, multiple versions of nodes and scale factors are not supported
+  void writeBinaryFile(std::string binaryFilename);
+
+  //! check if the binary mesh file exists and is newer than the exfiles
+  bool binaryFileIsUpToDate(std::string binaryFilename, std::string exelemFilename, std::string exnodeFilename) const;
+
+  //! read the exfile mesh, which has been parsed by every rank, into a serial partition and distribute it to the ranks of rankSubset,
+  //! only the geometry field is kept, the other field variables of the exfiles are discarded
+  void distributeExfileMesh(std::string exnodeFilename, std::shared_ptr<Partition::RankSubset> rankSubset);
+
+  //! compute the partitioning over rankSubset, create the local mappings, the geometry field and the meshPartition, this is collective
+  //! @param elements the elements of the own block of global element nos, see Partition::UnstructuredPartitioning::getElementBlock
+  //! @param elementCentroids the centroids of the elements of the own block
+  void initializeDistributedMesh(global_no_t nElementsGlobal, global_no_t nNodesGlobal, const std::vector<UnstructuredElement> &elements,
+                                 const std::vector<Vec3> &elementCentroids, std::shared_ptr<Partition::RankSubset> rankSubset);
+
+  //! set the values of the geometry field, nodeValues contains for every local node (including ghosts) nDofsPerNode*3 values, for every dof the x,y,z values
+  void setGeometryFieldNodeValues(const std::vector<double> &nodeValues);
+
   //! initialize the meshPartition of this mesh (by calling FunctionSpacePartition::initialize()), then create the partitioned Petsc vectors in each field variable
   void initializeValuesVector();
   
@@ -113,3 +148,4 @@ protected:
 #include "function_space/04_function_space_data_unstructured.tpp"
 #include "function_space/04_function_space_data_unstructured_parse_exfiles.tpp"
 #include "function_space/04_function_space_data_unstructured_parse_settings.tpp"
+#include "function_space/04_function_space_data_unstructured_binary_file.tpp"
@@ -40,17 +40,25 @@ template<int D,typename BasisFunctionType>
 void FunctionSpaceDataUnstructured<D,BasisFunctionType>::
 initialize()
 { 
-  if (DihuContext::nRanksCommWorld() > 1)
-  {
-    LOG(FATAL) << "Unstructured grids are not implemented for parallel execution! " << std::endl
-      << "Use structured or regular grids instead or run with a single process.";
-  }
+  // the binary mesh file is created from the exfiles once and is then used instead of the exfiles, it can be read in parallel
+  std::string filenameBinary;
+  if (this->specificSettings_.hasKey("binaryFile"))
+    filenameBinary = this->specificSettings_.getOptionString("binaryFile", "mesh.bin");
 
   if (this->specificSettings_.hasKey("exelem"))
   {
     std::string filenameExelem = this->specificSettings_.getOptionString("exelem", "input.exelem");
     std::string filenameExnode = this->specificSettings_.getOptionString("exnode", "input.exnode");
 
+    if (!filenameBinary.empty() && this->binaryFileIsUpToDate(filenameBinary, filenameExelem, filenameExnode))
+    {
+      LOG(DEBUG) << "Binary mesh file \"" << filenameBinary << "\" is newer than \"" << filenameExelem << "\" and \"" << filenameExnode << "\", use it.";
+
+      // this distributes the mesh to the ranks, creates the geometryField and sets the mesh, also creates the meshPartition
+      this->parseBinaryFile(filenameBinary);
+      return;
+    }
+
     // read in exelem file
     this->parseExelemFile(filenameExelem);
 
@@ -58,6 +66,17 @@ initialize()
     // this assigns the geometry field
     this->remapFieldVariables(this->specificSettings_);
 
+    // with more than one rank, every rank reads the whole exfile mesh and keeps only its partition
+    std::shared_ptr<Partition::RankSubset> rankSubset = this->partitionManager_->rankSubsetForNextCreatedPartitioning();
+    if (rankSubset->size() > 1)
+    {
+      this->distributeExfileMesh(filenameExnode, rankSubset);
+
+      if (!filenameBinary.empty())
+        this->writeBinaryFile(filenameBinary);
+      return;
+    }
+
     // create the meshPartition by calling FunctionSpacePartition::initialize() and then create the partitioned vectors for all field variables, also for geometry field
     this->initializeValuesVector();
     
@@ -66,16 +85,25 @@ initialize()
 
     // eliminate scale factors (not yet tested)
     //this->eliminateScaleFactors();
+
+    // convert the exfiles such that the next run can use the binary mesh file
+    if (!filenameBinary.empty())
+      this->writeBinaryFile(filenameBinary);
+  }
+  else if (!filenameBinary.empty())
+  {
+    // this distributes the mesh to the ranks, creates the geometryField and sets the mesh, also creates the meshPartition
+    this->parseBinaryFile(filenameBinary);
   }
   else if (this->specificSettings_.hasKey("nodePositions"))
   {
-    // this creates the geometryField and sets the mesh, also creates the meshPartition by calling FunctionSpacePartition::initialize();
+    // this distributes the mesh to the ranks, creates the geometryField and sets the mesh, also creates the meshPartition by calling FunctionSpacePartition::initialize();
     this->parseFromSettings(this->specificSettings_);
   }
   else
   {
     LOG(FATAL) << "Could not create UnstructuredDeformable node positions. "
-      << "Either specify \"exelem\" and \"exnode\" or \"nodePositions\". ";
+      << "Either specify \"exelem\" and \"exnode\", \"binaryFile\" or \"nodePositions\". ";
   }
 }
 
@@ -101,6 +129,14 @@ template<int D,typename BasisFunctionType>
 global_no_t FunctionSpaceDataUnstructured<D,BasisFunctionType>::
 getNodeNoGlobalNatural(global_no_t elementNoGlobalNatural, int nodeIndex) const
 {
+  // a distributed mesh only knows its local elements
+  if (this->partitioning_)
+  {
+    element_no_t elementNoLocal = this->partitioning_->getElementNoLocal(elementNoGlobalNatural);
+    assert(elementNoLocal != -1);
+    return this->partitioning_->elementNodeNos()[elementNoLocal][nodeIndex];
+  }
+
   return this->getNodeNo(elementNoGlobalNatural, nodeIndex);
 }
 
@@ -147,6 +183,9 @@ template<int D,typename BasisFunctionType>
 global_no_t FunctionSpaceDataUnstructured<D,BasisFunctionType>::
 nElementsGlobal() const
 {
+  if (this->partitioning_)
+    return this->partitioning_->nElementsGlobal();
+
   assert(geometryField_);
   return this->geometryField_->nElements();
 }
@@ -0,0 +1,260 @@
+#include "function_space/04_function_space_data_unstructured.h"
+
+#include <sys/stat.h>  // stat() to compare file modification times
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+
+#include "easylogging++.h"
+#include "mesh/unstructured_binary_file.h"
+#include "utility/mpi_utility.h"
+
+namespace FunctionSpace
+{
+
+template<int D,typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D,BasisFunctionType>::
+parseBinaryFile(std::string binaryFilename)
+{
+  LOG(DEBUG) << "parseBinaryFile \"" << binaryFilename << "\"";
+
+  std::shared_ptr<Partition::RankSubset> rankSubset = this->partitionManager_->rankSubsetForNextCreatedPartitioning();
+
+  // collectively open the file and read the header
+  Mesh::UnstructuredBinaryFile file(binaryFilename, rankSubset->mpiCommunicator());
+  const Mesh::UnstructuredBinaryFile::Header &header = file.header();
+
+  if (header.dimension != D || header.nNodesPerElement != this->nNodesPerElement() || header.nDofsPerNode != this->nDofsPerNode())
+  {
+    LOG(FATAL) << "Binary mesh file \"" << binaryFilename << "\" contains a mesh with D=" << header.dimension << ", "
+      << header.nNodesPerElement << " nodes per element and " << header.nDofsPerNode << " dofs per node, "
+      << "but the function space has D=" << D << ", " << this->nNodesPerElement() << " nodes per element and " << this->nDofsPerNode() << " dofs per node.";
+  }
+
+  // every rank reads the topology of its block of elements, from which the partitioning is computed
+  global_no_t elementNoBegin = 0;
+  global_no_t elementNoEnd = 0;
+  Partition::UnstructuredPartitioning::getElementBlock(header.nElements, rankSubset, elementNoBegin, elementNoEnd);
+
+  std::vector<int64_t> elementNodeNos;
+  std::vector<int32_t> elementNodeVersions;
+  std::vector<Vec3> elementCentroids;
+  file.readTopology(elementNoBegin, elementNoEnd, elementNodeNos, elementNodeVersions, elementCentroids);
+
+  std::vector<UnstructuredElement> elements(elementNoEnd - elementNoBegin);
+  for (int elementIndex = 0; elementIndex < elements.size(); elementIndex++)
+  {
+    elements[elementIndex].nodes.resize(this->nNodesPerElement());
+    for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement(); nodeIndex++)
+    {
+      int64_t index = (int64_t)elementIndex*this->nNodesPerElement() + nodeIndex;
+      elements[elementIndex].nodes[nodeIndex].nodeGlobalNo = elementNodeNos[index];
+      elements[elementIndex].nodes[nodeIndex].versionNo = elementNodeVersions[index];
+    }
+  }
+
+  // distribute the mesh and create the geometry field
+  this->initializeDistributedMesh(header.nElements, header.nNodes, elements, elementCentroids, rankSubset);
+
+  // read the node values of the local nodes only
+  std::vector<double> nodeValues;
+  file.readNodeValues(this->partitioning_->nodeNosGlobalNatural(), nodeValues);
+
+  this->setGeometryFieldNodeValues(nodeValues);
+}
+
+template<int D,typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D,BasisFunctionType>::
+writeBinaryFile(std::string binaryFilename)
+{
+  if (!this->geometryField_)
+  {
+    LOG(ERROR) << "Could not write binary mesh file \"" << binaryFilename << "\", the mesh has no geometry field.";
+    return;
+  }
+
+  // the binary format only stores the dof values of the first version of every node and no scale factors,
+  // a Hermite mesh would be read with wrong derivatives, therefore the exfiles have to be used
+  if (std::is_same<BasisFunctionType,BasisFunction::Hermite>::value)
+  {
+    LOG(ERROR) << "The binary mesh file \"" << binaryFilename << "\" is not written, it cannot store Hermite meshes. "
+      << "Remove the option \"binaryFile\" and use the exfiles.";
+    return;
+  }
+
+  // with a distributed mesh, the local numbers are mapped to the global natural numbers, a serial mesh is already in global natural numbering
+  std::shared_ptr<Partition::RankSubset> rankSubset = this->meshPartition_->rankSubset();
+  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+  std::shared_ptr<FieldVariable::ExfileRepresentation> exfileRepresentation = this->geometryField_->exfileRepresentation();
+
+  auto getNodeNoGlobal = [this](node_no_t nodeNoLocal) -> global_no_t
+  {
+    return (this->partitioning_? this->partitioning_->nodeNosGlobalNatural()[nodeNoLocal] : nodeNoLocal);
+  };
+
+  // collect the local elements, for every element the global element no followed by the global node nos,
+  // the version is given by the value indices of the geometry field and has to be 0
+  std::stringstream reason;    // the reason why the file cannot be written, if any
+  std::vector<long long> localElements;
+  node_no_t nNodesSerial = 0;
+  for (element_no_t elementNoLocal = 0; elementNoLocal < this->nElements_; elementNoLocal++)
+  {
+    global_no_t elementNoGlobal = (this->partitioning_? this->partitioning_->elementNosGlobal()[elementNoLocal] : elementNoLocal);
+    localElements.push_back(elementNoGlobal);
+
+    const std::vector<double> &scaleFactors = this->elementToNodeMapping_->getElement(elementNoLocal).scaleFactors;
+    if (reason.str().empty() && std::any_of(scaleFactors.begin(), scaleFactors.end(), [](double scaleFactor){return scaleFactor != 1.0;}))
+    {
+      reason << "element " << elementNoGlobal << " has scale factors which cannot be stored";
+    }
+
+    for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement(); nodeIndex++)
+    {
+      node_no_t nodeNoLocal = this->getNodeNo(elementNoLocal, nodeIndex);
+      nNodesSerial = std::max(nNodesSerial, nodeNoLocal+1);
+      localElements.push_back(getNodeNoGlobal(nodeNoLocal));
+
+      int versionNo = exfileRepresentation->getExfileElementRepresentation(elementNoLocal)->getNode(nodeIndex).valueIndices[0] / this->nDofsPerNode();
+      if (reason.str().empty() && versionNo != 0)
+      {
+        reason << "node " << getNodeNoGlobal(nodeNoLocal) << " of element " << elementNoGlobal << " uses version " << versionNo
+          << ", but only the first version of every node can be stored";
+      }
+    }
+  }
+
+  // the file is only written if all ranks can store their part
+  int canBeWrittenLocal = reason.str().empty();
+  int canBeWritten = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&canBeWrittenLocal, &canBeWritten, 1, MPI_INT, MPI_MIN, mpiCommunicator), "MPI_Allreduce");
+  if (!canBeWritten)
+  {
+    if (!canBeWrittenLocal)
+    {
+      LOG(ERROR) << "The binary mesh file \"" << binaryFilename << "\" is not written, " << reason.str() << ". "
+        << "Remove the option \"binaryFile\" and use the exfiles.";
+    }
+    return;
+  }
+
+  // collect the dof values of the first version of every own node
+  std::shared_ptr<FieldVariable::NodeToDofMapping> nodeToDofMapping = this->geometryField_->nodeToDofMapping();
+  const node_no_t nNodesOwn = (this->partitioning_? this->partitioning_->nNodesLocalWithoutGhosts() : nNodesSerial);
+
+  std::vector<long long> localNodeNos;
+  std::vector<double> localNodeValues;
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesOwn; nodeNoLocal++)
+  {
+    if (!nodeToDofMapping->containsNode(nodeNoLocal))
+      continue;
+
+    localNodeNos.push_back(getNodeNoGlobal(nodeNoLocal));
+    std::vector<dof_no_t> &nodeDofs = nodeToDofMapping->getNodeDofs(nodeNoLocal);
+    for (int dofIndex = 0; dofIndex < this->nDofsPerNode(); dofIndex++)
+    {
+      Vec3 value({0.0, 0.0, 0.0});
+      if (dofIndex < nodeDofs.size())
+        value = this->geometryField_->getValue(nodeDofs[dofIndex]);
+
+      localNodeValues.insert(localNodeValues.end(), value.begin(), value.end());
+    }
+  }
+
+  // gather the values of all ranks on the first rank of the partition
+  const int nRanks = rankSubset->size();
+  const int ownRankNo = rankSubset->ownRankNo();
+  // the counts and offsets of MPI_Gatherv are int, the total number of gathered values is checked such that they do not overflow
+  auto gatherOnFirstRank = [&](const auto &localValues, auto &globalValues, MPI_Datatype mpiDatatype)
+  {
+    long long nLocalValuesLong = localValues.size();
+    long long nGlobalValues = 0;
+    MPIUtility::handleReturnValue(MPI_Allreduce(&nLocalValuesLong, &nGlobalValues, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+    if (nGlobalValues > std::numeric_limits<int>::max())
+    {
+      LOG(FATAL) << "The binary mesh file \"" << binaryFilename << "\" cannot be written, the mesh has " << nGlobalValues << " values to be gathered "
+        << "on one rank, but at most " << std::numeric_limits<int>::max() << " are possible. Convert the exfiles of a smaller mesh or read the exfiles.";
+    }
+
+    int nLocalValues = localValues.size();
+    std::vector<int> sizesOnRanks(nRanks, 0);
+    MPIUtility::handleReturnValue(MPI_Gather(&nLocalValues, 1, MPI_INT, sizesOnRanks.data(), 1, MPI_INT, 0, mpiCommunicator), "MPI_Gather");
+
+    std::vector<int> offsets(nRanks, 0);
+    for (int rankNo = 1; rankNo < nRanks; rankNo++)
+      offsets[rankNo] = offsets[rankNo-1] + sizesOnRanks[rankNo-1];
+
+    globalValues.resize(ownRankNo == 0? nGlobalValues : 0);
+    MPIUtility::handleReturnValue(MPI_Gatherv(localValues.data(), nLocalValues, mpiDatatype, globalValues.data(), sizesOnRanks.data(), offsets.data(),
+                                              mpiDatatype, 0, mpiCommunicator), "MPI_Gatherv");
+  };
+
+  std::vector<long long> globalElements, globalNodeNos;
+  std::vector<double> globalNodeValues;
+  gatherOnFirstRank(localElements, globalElements, MPI_LONG_LONG);
+  gatherOnFirstRank(localNodeNos, globalNodeNos, MPI_LONG_LONG);
+  gatherOnFirstRank(localNodeValues, globalNodeValues, MPI_DOUBLE);
+
+  // only the first rank writes the file and the others wait until it is complete.
+  // Other instances that read the same exfiles may write the file at the same time, therefore every writer uses its own temporary file which is then renamed
+  if (ownRankNo == 0)
+  {
+    const int nNodesPerElement = this->nNodesPerElement();
+    const int nValuesPerNode = this->nDofsPerNode()*3;
+    const global_no_t nElements = globalElements.size() / (nNodesPerElement+1);
+
+    // bring the elements into global order, the versions are all 0
+    std::vector<int64_t> elementNodeNos(nElements*nNodesPerElement);
+    std::vector<int32_t> elementNodeVersions(nElements*nNodesPerElement, 0);
+    long long nNodes = 0;
+    for (global_no_t elementIndex = 0; elementIndex < nElements; elementIndex++)
+    {
+      const long long *element = globalElements.data() + elementIndex*(nNodesPerElement+1);
+      for (int nodeIndex = 0; nodeIndex < nNodesPerElement; nodeIndex++)
+      {
+        elementNodeNos[element[0]*nNodesPerElement + nodeIndex] = element[1+nodeIndex];
+        nNodes = std::max(nNodes, element[1+nodeIndex]+1);
+      }
+    }
+    for (long long nodeNo : globalNodeNos)
+      nNodes = std::max(nNodes, nodeNo+1);
+
+    std::vector<double> nodeValues(nNodes*nValuesPerNode, 0.0);
+    for (long long nodeIndex = 0; nodeIndex < globalNodeNos.size(); nodeIndex++)
+    {
+      std::copy(globalNodeValues.begin() + nodeIndex*nValuesPerNode, globalNodeValues.begin() + (nodeIndex+1)*nValuesPerNode,
+                nodeValues.begin() + globalNodeNos[nodeIndex]*nValuesPerNode);
+    }
+
+    std::stringstream temporaryFilename;
+    temporaryFilename << binaryFilename << ".tmp" << DihuContext::ownRankNoCommWorld();
+
+    Mesh::UnstructuredBinaryFile::write(temporaryFilename.str(), D, nNodesPerElement, this->nDofsPerNode(), elementNodeNos, elementNodeVersions, nodeValues);
+
+    if (std::rename(temporaryFilename.str().c_str(), binaryFilename.c_str()) != 0)
+    {
+      LOG(ERROR) << "Could not rename binary mesh file \"" << temporaryFilename.str() << "\" to \"" << binaryFilename << "\".";
+    }
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(mpiCommunicator), "MPI_Barrier");
+}
+
+template<int D,typename BasisFunctionType>
+bool FunctionSpaceDataUnstructured<D,BasisFunctionType>::
+binaryFileIsUpToDate(std::string binaryFilename, std::string exelemFilename, std::string exnodeFilename) const
+{
+  struct stat binaryFileStat, exelemFileStat, exnodeFileStat;
+  if (stat(binaryFilename.c_str(), &binaryFileStat) != 0)
+    return false;
+
+  // if the exfiles do not exist, the binary file is used as it is
+  if (stat(exelemFilename.c_str(), &exelemFileStat) == 0 && exelemFileStat.st_mtime > binaryFileStat.st_mtime)
+    return false;
+
+  if (stat(exnodeFilename.c_str(), &exnodeFileStat) == 0 && exnodeFileStat.st_mtime > binaryFileStat.st_mtime)
+    return false;
+
+  return true;
+}
+
+} // namespace
@@ -8,6 +8,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 namespace FunctionSpace
 {
@@ -424,4 +425,99 @@ initializeValuesVector()
   if (geometryField_) 
     this->geometryField_->initializeValuesVector();
 }
+
+template<int D,typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D,BasisFunctionType>::
+distributeExfileMesh(std::string exnodeFilename, std::shared_ptr<Partition::RankSubset> rankSubset)
+{
+  if (!this->geometryField_)
+    LOG(FATAL) << "Mesh contains no field variable \"geometry\". Use remap to create one!";
+
+  // only the geometry field is distributed
+  if (!this->fieldVariable_.empty())
+  {
+    std::stringstream fieldVariableNames;
+    for (auto &fieldVariable : this->fieldVariable_)
+      fieldVariableNames << " \"" << fieldVariable.first << "\"";
+
+    LOG(WARNING) << "The field variables" << fieldVariableNames.str() << " of the exfiles are not used, "
+      << "only the geometry is distributed to " << rankSubset->size() << " ranks.";
+    this->fieldVariable_.clear();
+  }
+
+  // every rank has parsed the exelem file, read the values of the whole mesh into a serial partition that only contains the own rank
+  this->meshPartition_ = std::make_shared<Partition::MeshPartition<FunctionSpaceType>>(
+    this->nElementsGlobal(), this->nNodesGlobal(), this->nDofsGlobal(), std::make_shared<Partition::RankSubset>(MPI_COMM_SELF));
+  this->geometryField_->initializeValuesVector();
+  this->parseExnodeFile(exnodeFilename);
+
+  std::shared_ptr<FieldVariable::ElementToNodeMapping> elementToNodeMappingSerial = this->elementToNodeMapping_;
+  std::shared_ptr<FieldVariable::NodeToDofMapping> nodeToDofMappingSerial = this->geometryField_->nodeToDofMapping();
+  std::shared_ptr<FieldVariable::ExfileRepresentation> exfileRepresentationSerial = this->geometryField_->exfileRepresentation();
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,3>> geometryFieldSerial = this->geometryField_;
+
+  std::vector<Vec3> valuesSerial;
+  geometryFieldSerial->getValuesWithGhosts(valuesSerial);
+
+  // the nodes that are not used by any element are not in the exelem file
+  const global_no_t nElementsGlobal = this->nElements_;
+  global_no_t nNodesGlobal = 0;
+  for (element_no_t elementNo = 0; elementNo < this->nElements_; elementNo++)
+  {
+    for (int nodeGlobalNo : elementToNodeMappingSerial->getElement(elementNo).nodeGlobalNo)
+      nNodesGlobal = std::max(nNodesGlobal, (global_no_t)nodeGlobalNo+1);
+  }
+
+  // collect the elements of the own block, the version is given by the value indices of the geometry field
+  global_no_t elementNoBegin = 0;
+  global_no_t elementNoEnd = 0;
+  Partition::UnstructuredPartitioning::getElementBlock(nElementsGlobal, rankSubset, elementNoBegin, elementNoEnd);
+
+  std::vector<UnstructuredElement> elements(elementNoEnd - elementNoBegin);
+  std::vector<Vec3> elementCentroids(elements.size(), Vec3({0.0, 0.0, 0.0}));
+  for (global_no_t elementGlobalNo = elementNoBegin; elementGlobalNo < elementNoEnd; elementGlobalNo++)
+  {
+    UnstructuredElement &element = elements[elementGlobalNo - elementNoBegin];
+    element.nodes.resize(this->nNodesPerElement());
+    for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement(); nodeIndex++)
+    {
+      element.nodes[nodeIndex].nodeGlobalNo = elementToNodeMappingSerial->getElement(elementGlobalNo).nodeGlobalNo[nodeIndex];
+      element.nodes[nodeIndex].versionNo = exfileRepresentationSerial->getExfileElementRepresentation(elementGlobalNo)->getNode(nodeIndex).valueIndices[0] / this->nDofsPerNode();
+
+      // the first dof of the node is its position
+      elementCentroids[elementGlobalNo - elementNoBegin] += valuesSerial[geometryFieldSerial->getDofNo(elementGlobalNo, nodeIndex*this->nDofsPerNode())];
+    }
+    elementCentroids[elementGlobalNo - elementNoBegin] *= 1.0 / this->nNodesPerElement();
+  }
+
+  // distribute the mesh, this replaces the geometry field, the mappings and the meshPartition by the distributed ones
+  this->meshPartition_ = nullptr;
+  this->initializeDistributedMesh(nElementsGlobal, nNodesGlobal, elements, elementCentroids, rankSubset);
+
+  // copy the values of the local nodes, the dofs of a version that is used by an element have the same value index in both numberings
+  const std::vector<global_no_t> &nodeNosGlobalNatural = this->partitioning_->nodeNosGlobalNatural();
+  const std::vector<std::vector<dof_no_t>> &nodeDofNosLocal = this->partitioning_->nodeDofNosLocal();
+  std::vector<Vec3> values(this->partitioning_->nDofsLocalWithGhosts(), Vec3({0.0, 0.0, 0.0}));
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nodeNosGlobalNatural.size(); nodeNoLocal++)
+  {
+    if (!nodeToDofMappingSerial->containsNode(nodeNosGlobalNatural[nodeNoLocal]))
+      continue;
+
+    FieldVariable::NodeToDofMapping::NodeDofInformation &nodeDofInformation = nodeToDofMappingSerial->getNodeDofInformation(nodeNosGlobalNatural[nodeNoLocal]);
+    for (int valueIndex = 0; valueIndex < nodeDofNosLocal[nodeNoLocal].size(); valueIndex++)
+    {
+      int versionNo = valueIndex / this->nDofsPerNode();
+      if (versionNo < nodeDofInformation.elementsOfVersion.size() && !nodeDofInformation.elementsOfVersion[versionNo].empty())
+        values[nodeDofNosLocal[nodeNoLocal][valueIndex]] = valuesSerial[nodeDofInformation.dofs[valueIndex]];
+    }
+  }
+  this->geometryField_->setValuesWithGhosts(values);
+
+  // copy the scale factors of the local elements
+  const std::vector<global_no_t> &elementNosGlobal = this->partitioning_->elementNosGlobal();
+  for (element_no_t elementNoLocal = 0; elementNoLocal < this->nElements_; elementNoLocal++)
+  {
+    this->elementToNodeMapping_->getElement(elementNoLocal).scaleFactors = elementToNodeMappingSerial->getElement(elementNosGlobal[elementNoLocal]).scaleFactors;
+  }
+}
 } // namespace
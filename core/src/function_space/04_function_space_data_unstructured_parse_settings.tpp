@@ -3,6 +3,7 @@
 #include "easylogging++.h"
 #include "utility/string_utility.h"
 #include "utility/python_utility.h"
+#include "utility/vector_operators.h"
 
 #include "basis_function/basis_function.h"
 #include "field_variable/factory.h"
@@ -21,144 +22,160 @@ parseFromSettings(PythonConfig settings)
 
   // example input in settings:
   //  "nodePositions": [[0,0,0], [1,0], [2,0,0], [0,1], [1,1], [2,1], [0,2], [1,2], [2,2], ...],
+  //  "elements": [[[0,0], [1,0], [2,1], [3,0]], [next element]]   # each node is [node no, version-at-that-node no] or just node-no then it assumes version no 0
 
-  // parse node positions
-  std::vector<Vec3> nodePositions;
-  bool listWarningIssued = false;    // if the warning about lists was already shown
+  // the python lists are present on every rank, every rank only converts the elements of its block and the node positions that it needs
+  PyObject *pyNodePositions = settings.getOptionPyObject("nodePositions");
+  PyObject *pyElements = settings.getOptionPyObject("elements");
 
-  // get the first node position from the list
-  PyObject *pyNodePositions = settings.getOptionListBegin<PyObject *>("nodePositions");
+  if (!PyList_Check(pyNodePositions) || !PyList_Check(pyElements))
+  {
+    LOG(FATAL) << settings.getStringPath() << ": \"nodePositions\" and \"elements\" have to be lists.";
+  }
 
-  // loop over other entries of list
-  for (;
-      !settings.getOptionListEnd("nodePositions");
-      settings.getOptionListNext<PyObject *>("nodePositions", pyNodePositions))
+  const global_no_t nNodesGlobal = PyList_Size(pyNodePositions);
+  const global_no_t nElementsGlobal = PyList_Size(pyElements);
+
+  // get the position of a node from the python list
+  bool listWarningIssued = false;    // if the warning about lists was already shown
+  auto getNodePosition = [&](global_no_t nodeGlobalNo)
   {
-    if (!PythonUtility::isTypeList(pyNodePositions) && !listWarningIssued)
+    PyObject *pyNodePosition = PyList_GetItem(pyNodePositions, (Py_ssize_t)nodeGlobalNo);   // borrowed reference
+    if (!PythonUtility::isTypeList(pyNodePosition) && !listWarningIssued)
     {
       listWarningIssued = true;
       LOG(WARNING) << "\"nodePositions\" is not a list of lists.";
     }
-   
-    Vec3 nodePosition = PythonUtility::convertFromPython<Vec3>::get(pyNodePositions);
-    VLOG(1) << "node position " << nodePosition;
-    nodePositions.push_back(nodePosition);
-  }
-
-  // parse elements
-  struct Element
-  {
-    struct ElementNode
-    {
-      node_no_t nodeGlobalNo;
-      unsigned int versionNo;
-    };
-    std::vector<ElementNode> nodes;
+    return PythonUtility::convertFromPython<Vec3>::get(pyNodePosition);
   };
-  std::vector<Element> elements;
 
-  // example input in settings:
-  //  "elements": [[[0,0], [1,0], [2,1], [3,0]], [next element]]   # each node is [node no, version-at-that-node no] or just node-no then it assumes version no 0
-
-  // get the first node position from the list
-  PyObject *pyElement = settings.getOptionListBegin<PyObject *>("elements");
+  std::shared_ptr<Partition::RankSubset> rankSubset = this->partitionManager_->rankSubsetForNextCreatedPartitioning();
+  global_no_t elementNoBegin = 0;
+  global_no_t elementNoEnd = 0;
+  Partition::UnstructuredPartitioning::getElementBlock(nElementsGlobal, rankSubset, elementNoBegin, elementNoEnd);
 
-  // loop over other entries of list
-  for (;
-      !settings.getOptionListEnd("elements");
-      settings.getOptionListNext<PyObject *>("elements", pyElement))
+  // parse the elements of the own block, check the node nos and compute the element centroids which are needed for the partitioning
+  std::vector<UnstructuredElement> elements(elementNoEnd - elementNoBegin);
+  std::vector<Vec3> elementCentroids(elements.size(), Vec3({0.0, 0.0, 0.0}));
+  for (global_no_t elementGlobalNo = elementNoBegin; elementGlobalNo < elementNoEnd; elementGlobalNo++)
   {
     // get the python list that makes up the element, e.g. [[0,0], [1,0], [2,1], [3,0]]
+    PyObject *pyElement = PyList_GetItem(pyElements, (Py_ssize_t)elementGlobalNo);   // borrowed reference
     typedef std::array<PyObject *,this->nNodesPerElement()> PyElementNodes;
     PyElementNodes pyElementNodes = PythonUtility::convertFromPython<PyElementNodes>::get(pyElement);
 
-    Element currentElement;
+    UnstructuredElement &currentElement = elements[elementGlobalNo - elementNoBegin];
+    Vec3 &elementCentroid = elementCentroids[elementGlobalNo - elementNoBegin];
     currentElement.nodes.resize(this->nNodesPerElement());
+
     // loop over nodes of that element
     for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement(); nodeIndex++)
     {
-       // extract the node positions, e.g. [1,0] (global node no., version no.) or just 1 (only global node no., version no. defaults to 0)
-       std::array<int,2> elementNode = PythonUtility::convertFromPython<std::array<int,2>>::get(pyElementNodes[nodeIndex], {0,0}, false);
+      // extract the node positions, e.g. [1,0] (global node no., version no.) or just 1 (only global node no., version no. defaults to 0)
+      std::array<int,2> elementNode = PythonUtility::convertFromPython<std::array<int,2>>::get(pyElementNodes[nodeIndex], {0,0}, false);
 
-       VLOG(1) << "   elementNode " << elementNode;
+      VLOG(1) << "   elementNode " << elementNode;
 
-       currentElement.nodes[nodeIndex].nodeGlobalNo = elementNode[0];
-       currentElement.nodes[nodeIndex].versionNo = elementNode[1];
+      // check if given global node number is valid
+      if (elementNode[0] < 0 || elementNode[0] >= nNodesGlobal)
+      {
+        LOG(FATAL) << "Element " << elementGlobalNo << " contains node global no. "
+          << elementNode[0] << " which is >= the number of nodes ("
+          << nNodesGlobal << ")";
+      }
+
+      currentElement.nodes[nodeIndex].nodeGlobalNo = elementNode[0];
+      currentElement.nodes[nodeIndex].versionNo = elementNode[1];
+
+      elementCentroid += getNodePosition(elementNode[0]);
     }
-    elements.push_back(currentElement);
+    elementCentroid *= 1.0 / this->nNodesPerElement();
   }
 
-  this->nElements_ = elements.size();
+  LOG(DEBUG) << nNodesGlobal << " node positions, " << nElementsGlobal << " elements, parsed elements [" << elementNoBegin << "," << elementNoEnd << ")";
 
-  LOG(DEBUG) << nodePositions.size() << " node positions, " << elements.size() << " elements";
+  // distribute the mesh and create the geometry field
+  this->initializeDistributedMesh(nElementsGlobal, nNodesGlobal, elements, elementCentroids, rankSubset);
 
-  // initialize elementToNodeMapping_
-  this->elementToNodeMapping_ = std::make_shared<FieldVariable::ElementToNodeMapping>();
-  this->elementToNodeMapping_->setNumberElements(elements.size());
-
-  // loop over elements
-  for (element_no_t elementGlobalNo = 0; elementGlobalNo < elements.size(); elementGlobalNo++)
+  // set values from nodePositions of the local nodes, the derivative dofs of Hermite are left at 0
+  const std::vector<global_no_t> &nodeNosGlobalNatural = this->partitioning_->nodeNosGlobalNatural();
+  std::vector<double> nodeValues(nodeNosGlobalNatural.size()*this->nDofsPerNode()*3, 0.0);
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nodeNosGlobalNatural.size(); nodeNoLocal++)
   {
-    // allocate vector in elementToNodeMapping for nodes of that element
-    this->elementToNodeMapping_->getElement(elementGlobalNo).nodeGlobalNo.resize(this->nNodesPerElement());
-
-    // loop over nodes of that element
-    for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement(); nodeIndex++)
+    Vec3 nodePosition = getNodePosition(nodeNosGlobalNatural[nodeNoLocal]);
+    for (int componentNo = 0; componentNo < 3; componentNo++)
     {
-      // assign previously extracted global node number to element in ElementToNodeMapping
-      this->elementToNodeMapping_->getElement(elementGlobalNo).nodeGlobalNo[nodeIndex] = elements[elementGlobalNo].nodes[nodeIndex].nodeGlobalNo;
+      nodeValues[nodeNoLocal*this->nDofsPerNode()*3 + componentNo] = nodePosition[componentNo];
+    }
+  }
+  this->setGeometryFieldNodeValues(nodeValues);
+}
 
-      // check if given global node number is valid
-      if (this->elementToNodeMapping_->getElement(elementGlobalNo).nodeGlobalNo[nodeIndex] >= nodePositions.size())
-      {
-        LOG(FATAL) << "Element " << elementGlobalNo << " contains node global no. "
-          << this->elementToNodeMapping_->getElement(elementGlobalNo).nodeGlobalNo[nodeIndex] << " which is >= the number of nodes ("
-          << nodePositions.size() << ")";
-      }
+template<int D,typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D,BasisFunctionType>::
+initializeDistributedMesh(global_no_t nElementsGlobal, global_no_t nNodesGlobal, const std::vector<UnstructuredElement> &elements,
+                          const std::vector<Vec3> &elementCentroids, std::shared_ptr<Partition::RankSubset> rankSubset)
+{
+  // collect the node nos and versions of the elements of the own block
+  std::vector<std::vector<global_no_t>> elementNodeNos(elements.size());
+  std::vector<std::vector<int>> elementNodeVersions(elements.size());
+  for (int elementIndex = 0; elementIndex < elements.size(); elementIndex++)
+  {
+    for (const typename UnstructuredElement::ElementNode &elementNode : elements[elementIndex].nodes)
+    {
+      elementNodeNos[elementIndex].push_back(elementNode.nodeGlobalNo);
+      elementNodeVersions[elementIndex].push_back(elementNode.versionNo);
     }
   }
 
-  // set exfileRepresentation
+  // distribute the elements to the ranks and number the nodes and dofs, afterwards only the local elements are known
+  std::string partitioningMethod = this->specificSettings_.getOptionString("partitioningMethod", "rcb");
+  this->partitioning_ = std::make_shared<Partition::UnstructuredPartitioning>(nElementsGlobal, nNodesGlobal, elementNodeNos, elementNodeVersions,
+    elementCentroids, this->nDofsPerNode(), rankSubset, Partition::UnstructuredPartitioning::parseMethod(partitioningMethod));
+
+  // create the element to node mapping and exfile representation of the local elements, the node nos are local nos
+  const element_no_t nElementsLocal = this->partitioning_->nElementsLocal();
+  const std::vector<std::vector<global_no_t>> &localElementNodeNos = this->partitioning_->elementNodeNos();
+  const std::vector<std::vector<int>> &localElementNodeVersions = this->partitioning_->elementNodeVersions();
+
+  this->elementToNodeMapping_ = std::make_shared<FieldVariable::ElementToNodeMapping>();
+  this->elementToNodeMapping_->setNumberElements(nElementsLocal);
+
   std::shared_ptr<FieldVariable::ExfileRepresentation> exfileRepresentation = std::make_shared<FieldVariable::ExfileRepresentation>();
-  exfileRepresentation->setNumberElements(elements.size());
+  exfileRepresentation->setNumberElements(nElementsLocal);
 
-  // loop over elements
-  for (element_no_t elementGlobalNo = 0; elementGlobalNo < elements.size(); elementGlobalNo++)
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
   {
-    std::shared_ptr<FieldVariable::ExfileElementRepresentation> &exfileElementRepresentation
-     = exfileRepresentation->getExfileElementRepresentation(elementGlobalNo);
+    std::vector<int> &nodeLocalNos = this->elementToNodeMapping_->getElement(elementNoLocal).nodeGlobalNo;
+    nodeLocalNos.resize(this->nNodesPerElement());
 
     // construct exfile element representation for the current element
+    std::shared_ptr<FieldVariable::ExfileElementRepresentation> &exfileElementRepresentation
+     = exfileRepresentation->getExfileElementRepresentation(elementNoLocal);
     exfileElementRepresentation = std::make_shared<FieldVariable::ExfileElementRepresentation>();
     exfileElementRepresentation->setNumberNodes(this->nNodesPerElement());
 
-    // loop over nodes of current element
     for (int nodeIndex = 0; nodeIndex < this->nNodesPerElement(); nodeIndex++)
     {
-      FieldVariable::ExfileElementRepresentation::Node &node = exfileElementRepresentation->getNode(nodeIndex);
-      /*
-      struct Node
-      {
-        std::vector<int> valueIndices;        //< the indices of the dof values of this node in the exnode file node values (sub-)block (for the particular field variable/component) of the node. If there are not multiple versions, this is simply 0,1,...,ndofs-1. If there are e.g. 2 versions and 8 dofs per node, this can be 0,1,...,7 if the elements uses the 1st version, or 8,...,15 if the element uses the second version. Note, that the real index of the dofs inside the values block may be different when this is not the first component of the block.
-        std::vector<int> scaleFactorIndices;   //< the indices of all scale factor entries for this node in the exelem element scale factors block. Thus this is kind of a node to element block mapping.
-      };*/
+      nodeLocalNos[nodeIndex] = this->partitioning_->getNodeNoLocal(localElementNodeNos[elementNoLocal][nodeIndex]);
 
-      // set valueIndices
-      int versionNo = elements[elementGlobalNo].nodes[nodeIndex].versionNo;
+      // the value indices select the dofs of the version that is used by the element
+      FieldVariable::ExfileElementRepresentation::Node &node = exfileElementRepresentation->getNode(nodeIndex);
       node.valueIndices.resize(this->nDofsPerNode());
-      std::iota(node.valueIndices.begin(), node.valueIndices.end(), versionNo*this->nDofsPerNode());
+      std::iota(node.valueIndices.begin(), node.valueIndices.end(), localElementNodeVersions[elementNoLocal][nodeIndex]*this->nDofsPerNode());
     }
   }
 
-  // setup elementToDof mapping, this also creates nodeToDofMapping
+  // setup the elementToDof and nodeToDof mappings of the local elements and nodes (including ghosts) in local numbering
   std::shared_ptr<FieldVariable::ElementToDofMapping> elementToDofMapping = std::make_shared<FieldVariable::ElementToDofMapping>();
-
-  elementToDofMapping->setNumberElements(elements.size());
+  elementToDofMapping->setNumberElements(nElementsLocal);
   std::shared_ptr<FieldVariable::NodeToDofMapping> nodeToDofMapping
-    = elementToDofMapping->setup(exfileRepresentation, this->elementToNodeMapping_, this->nDofsPerNode());
+    = elementToDofMapping->setupLocal(exfileRepresentation, this->elementToNodeMapping_, this->partitioning_->nodeDofNosLocal(),
+                                      this->nDofsPerNode(), this->partitioning_->nDofsLocalWithGhosts());
 
   VLOG(1) << "nodeToDofMapping: " << *nodeToDofMapping;
 
+  this->nElements_ = nElementsLocal;
   this->nDofs_ = elementToDofMapping->nDofsLocal();
 
   // create and setup geometry field variable
@@ -179,8 +196,8 @@ parseFromSettings(PythonConfig settings)
                                                            this->elementToNodeMapping_, nodeToDofMapping, {"x","y","z"});
   //this does not yet call initializeValuesVector(), which needs to be done after the meshPartition of the mesh is set
   
-  // unify exfile representation variables in field variables such that there is only one shared for all components of a field variable
-  this->geometryField_->unifyMappings(this->elementToNodeMapping_, this->nDofsPerNode());
+  // all components already share the same exfile representation and mappings, therefore unifyMappings is not called here,
+  // it would set up the element to dof mapping again from the local elements, in a numbering that differs from the one of the partitioning
 
   // create meshPartition and redistribute elements if necessary, this needs information about mesh size
   FunctionSpacePartition<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::initialize();
@@ -188,37 +205,42 @@ parseFromSettings(PythonConfig settings)
   // create the values vector
   this->geometryField_->initializeValuesVector();
   
-  // set values from nodePositions
+}
+
+template<int D,typename BasisFunctionType>
+void FunctionSpaceDataUnstructured<D,BasisFunctionType>::
+setGeometryFieldNodeValues(const std::vector<double> &nodeValues)
+{
+  std::shared_ptr<FieldVariable::NodeToDofMapping> nodeToDofMapping = this->geometryField_->nodeToDofMapping();
 
-  // loop over nodes
-  for (node_no_t nodeGlobalNo = 0; nodeGlobalNo < nodePositions.size(); nodeGlobalNo++)
+  // loop over local nodes, including ghost nodes
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < this->partitioning_->nNodesLocalWithGhosts(); nodeNoLocal++)
   {
-    int nVersions = nodeToDofMapping->nVersions(nodeGlobalNo);  // this fails
+    int nVersions = nodeToDofMapping->nVersions(nodeNoLocal);
 
-    VLOG(1) << "node " << nodeGlobalNo << ", nVersions: " << nVersions;
+    VLOG(1) << "node " << nodeNoLocal << " (global " << this->partitioning_->nodeNosGlobalNatural()[nodeNoLocal] << "), nVersions: " << nVersions;
 
     // loop over components
     int componentNo = 0;
     std::array<::FieldVariable::Component<FunctionSpaceType,3>,3> &component = this->geometryField_->component();
     for (auto iter = component.begin(); iter != component.end(); iter++, componentNo++)
     {
-      // get value of nodePositions vector that matches current component
-      double positionValue = nodePositions[nodeGlobalNo][componentNo];
-
       // create vector containing all dofs of the current node
-      std::vector<double> nodeValues(this->nDofsPerNode()*nVersions, 0.0);
+      std::vector<double> nodeDofValues(this->nDofsPerNode()*nVersions, 0.0);
 
-      // set first dof of every version for the particular component (this leaves derivative dofs of Hermite at 0)
+      // all versions get the same values for the particular component
       for (int versionNo = 0; versionNo < nVersions; versionNo++)
       {
-        VLOG(1) << "    set version " << versionNo << " at " << this->nDofsPerNode()*versionNo << " to " << positionValue;
-        nodeValues[this->nDofsPerNode()*versionNo] = positionValue;
+        for (int dofIndex = 0; dofIndex < this->nDofsPerNode(); dofIndex++)
+        {
+          nodeDofValues[this->nDofsPerNode()*versionNo + dofIndex] = nodeValues[(nodeNoLocal*this->nDofsPerNode() + dofIndex)*3 + componentNo];
+        }
       }
 
-      VLOG(1) << "   component no. " << componentNo << ", positionValue: " << positionValue << " nodeValues: " <<nodeValues;
+      VLOG(1) << "   component no. " << componentNo << ", nodeDofValues: " << nodeDofValues;
 
       // set nodal dof values at node
-      iter->setNodeValues(nodeGlobalNo, nodeValues.begin());
+      iter->setNodeValues(nodeNoLocal, nodeDofValues.begin());
     }
   }
 }
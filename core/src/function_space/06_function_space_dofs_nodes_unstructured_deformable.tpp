@@ -24,6 +24,10 @@ template<int D,typename BasisFunctionType>
 node_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::
 nNodesLocalWithoutGhosts() const
 {
+  // the local nodes are ordered such that the own nodes come first, followed by the ghost nodes
+  if (this->partitioning_)
+    return this->partitioning_->nNodesLocalWithoutGhosts();
+
   // assert that geometry field variable is set
   assert (this->geometryField_);
 
@@ -34,7 +38,7 @@ template<int D,typename BasisFunctionType>
 dof_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::
 nDofsLocalWithGhosts() const
 {
-  // parallelism not implemented for unstructured grids, therefore there is no distinction between global and local numbers
+  // nDofs_ is the number of local dofs including ghosts, without partitioning this is the number of all dofs
   return this->nDofs_;
 }
 
@@ -42,7 +46,10 @@ template<int D,typename BasisFunctionType>
 dof_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::
 nDofsLocalWithoutGhosts() const
 {
-  // parallelism not implemented for unstructured grids, therefore there is no distinction between global and local numbers
+  if (this->partitioning_)
+    return this->partitioning_->nDofsLocalWithoutGhosts();
+
+  // without partitioning there is no distinction between global and local numbers
   return this->nDofs_;
 }
 
@@ -50,7 +57,10 @@ template<int D,typename BasisFunctionType>
 global_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::
 nNodesGlobal() const
 {
-  // parallelism not implemented for unstructured grids, therefore there is no distinction between global and local numbers
+  if (this->partitioning_)
+    return this->partitioning_->nNodesGlobal();
+
+  // without partitioning there is no distinction between global and local numbers
   assert(this->geometryField_);
   return this->geometryField_->nNodes();
 }
@@ -59,7 +69,10 @@ template<int D,typename BasisFunctionType>
 global_no_t FunctionSpaceDofsNodes<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType>::
 nDofsGlobal() const
 {
-  // parallelism not implemented for unstructured grids
+  if (this->partitioning_)
+    return this->partitioning_->nDofsGlobal();
+
+  // without partitioning there is no distinction between global and local numbers
   return this->nDofs_;
 }
 
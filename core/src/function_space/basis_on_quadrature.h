@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <array>
+#include "control/types.h"
+
+#include "quadrature/tensor_product.h"
+
+namespace FunctionSpace
+{
+
+/** Tables of the basis functions and their gradients evaluated at the sampling points of a quadrature rule, e.g. Quadrature::TensorProduct<D,Quadrature::Gauss<3>>.
+ *  The tables only depend on the types, they are computed once at the first access and can then be used in all integration loops
+ *  instead of evaluating phi and dphi_dxi at every sampling point of every element.
+ */
+template<typename FunctionSpaceType,typename QuadratureDD>
+class BasisOnQuadrature
+{
+public:
+  static constexpr int D = FunctionSpaceType::dim();                                  //< dimension of the elements
+  static constexpr int nDofsPerElement = FunctionSpaceType::nDofsPerElement();        //< number of basis functions per element
+  static constexpr int nSamplingPoints = QuadratureDD::numberEvaluations();           //< number of sampling points of the quadrature rule
+
+  typedef std::array<std::array<double,nDofsPerElement>,nSamplingPoints> PhiTableType;                          //< phi[samplingPointIndex][dofIndex]
+  typedef std::array<std::array<std::array<double,D>,nDofsPerElement>,nSamplingPoints> GradPhiTableType;     //< gradPhi[samplingPointIndex][dofIndex][direction]
+
+  //! get the values of all basis functions at all sampling points
+  static const PhiTableType &phi();
+
+  //! get the gradients of all basis functions at all sampling points, the storage per sampling point is the same as in getGradPhi, gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i
+  static const GradPhiTableType &gradPhi();
+
+  //! compute the (geometry) jacobian matrix at the sampling point, this gives the same result as FunctionSpaceType::computeJacobian(geometryField, samplingPoints[samplingPointIndex])
+  template<typename Vec3>
+  static std::array<Vec3,D> computeJacobian(const std::array<Vec3,nDofsPerElement> &geometryField, int samplingPointIndex);
+};
+
+}  // namespace
+
+#include "function_space/basis_on_quadrature.tpp"
@@ -0,0 +1,73 @@
+#include "function_space/basis_on_quadrature.h"
+
+#include "utility/vector_operators.h"
+
+namespace FunctionSpace
+{
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+const typename BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::PhiTableType &BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::
+phi()
+{
+  // the table is computed at the first call, initialization of static local variables is thread-safe
+  static const PhiTableType phiTable = []()
+  {
+    PhiTableType result;
+    std::array<std::array<double,D>,nSamplingPoints> samplingPoints = QuadratureDD::samplingPoints();
+
+    for (int samplingPointIndex = 0; samplingPointIndex < nSamplingPoints; samplingPointIndex++)
+    {
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        result[samplingPointIndex][dofIndex] = FunctionSpaceType::phi(dofIndex, samplingPoints[samplingPointIndex]);
+      }
+    }
+    return result;
+  }();
+
+  return phiTable;
+}
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+const typename BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::GradPhiTableType &BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::
+gradPhi()
+{
+  static const GradPhiTableType gradPhiTable = []()
+  {
+    GradPhiTableType result;
+    std::array<std::array<double,D>,nSamplingPoints> samplingPoints = QuadratureDD::samplingPoints();
+
+    for (int samplingPointIndex = 0; samplingPointIndex < nSamplingPoints; samplingPointIndex++)
+    {
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        result[samplingPointIndex][dofIndex] = FunctionSpaceType::gradPhi(dofIndex, samplingPoints[samplingPointIndex]);
+      }
+    }
+    return result;
+  }();
+
+  return gradPhiTable;
+}
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+template<typename Vec3>
+std::array<Vec3,BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::D> BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::
+computeJacobian(const std::array<Vec3,nDofsPerElement> &geometryField, int samplingPointIndex)
+{
+  const std::array<std::array<double,D>,nDofsPerElement> &gradPhiAtSamplingPoint = gradPhi()[samplingPointIndex];
+
+  // jacobian[dimNo] = sum_dofIndex dphi_dofIndex/dxi_dimNo * geometryField[dofIndex]
+  std::array<Vec3,D> jacobian;
+  for (int dimNo = 0; dimNo < D; dimNo++)
+  {
+    jacobian[dimNo] = Vec3({0.0});
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      jacobian[dimNo] += gradPhiAtSamplingPoint[dofIndex][dimNo] * geometryField[dofIndex];
+    }
+  }
+  return jacobian;
+}
+
+}  // namespace
@@ -3,6 +3,7 @@
 #include <Python.h>  // has to be the first included header
 
 #include <array>
+#include <vector>
 #include "control/types.h"
 #include "mesh/type_traits.h"
 #include "function_space/11_function_space_xi.h"
@@ -30,14 +31,22 @@ public:
   typedef FunctionSpace<MeshType,BasisFunctionType> HighOrderFunctionSpace;
   typedef typename ::Mesh::SurfaceMesh<MeshType>::type SurfaceMesh;
 
+  //! initialize the function space and create the table of the dof nos of all local elements
+  virtual void initialize();
+
   //! return an array of all dof nos. of the element, including ghost dofs (local dof nos)
   std::array<dof_no_t,FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement()>
   getElementDofNosLocal(element_no_t elementNo) const;
 
-  //! vectorized version of getElementDofNosLocal
+  //! vectorized version of getElementDofNosLocal, the dof nos are gathered from the table elementDofNosLocal(), lanes with element no -1 get dof no -1
   std::array<Vc::int_v,FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement()>
   getElementDofNosLocal(Vc::int_v elementNo) const;
 
+  //! get the table of the local dof nos of all local elements, including ghost dofs, the dofs of element e are at [e*nDofsPerElement, (e+1)*nDofsPerElement).
+  //! This avoids the computation of the dof nos by getDofNo in the element loops, which is expensive for unstructured and composite meshes.
+  //! The table is created in initialize(), therefore this can be called concurrently, e.g. from OpenMP threads. It is a fatal error to call this before initialize().
+  const std::vector<dof_no_t> &elementDofNosLocal() const;
+
   //! fill a vector of all local dof nos. of the element, without ghost dofs
   void getElementDofNosLocalWithoutGhosts(element_no_t elementNo, std::vector<dof_no_t> &dofNosLocal) const;
 
@@ -46,6 +55,28 @@ public:
 
   //! get a description of the function space, with mesh name and type
   std::string getDescription() const;
+
+  //! get the local element nos of the interior elements, i.e. the elements whose dofs are all non-ghost dofs of the own rank.
+  //! Computations on these elements do not need ghost values and can be overlapped with the communication of the ghost values, see FieldVariable::startGhostManipulationBegin()
+  const std::vector<element_no_t> &elementNosLocalInterior() const;
+
+  //! get the local element nos of the boundary elements, i.e. the elements that have at least one ghost dof, these are all elements that are not interior
+  const std::vector<element_no_t> &elementNosLocalBoundary() const;
+
+protected:
+
+  //! split the local elements into interior and boundary elements, this is done once on the first call to elementNosLocalInterior() or elementNosLocalBoundary()
+  void initializeInteriorAndBoundaryElements() const;
+
+  mutable std::vector<element_no_t> elementNosLocalInterior_;   //< the local element nos of the elements that have no ghost dofs
+  mutable std::vector<element_no_t> elementNosLocalBoundary_;   //< the local element nos of the elements that have at least one ghost dof
+  mutable bool interiorAndBoundaryElementsInitialized_ = false; //< if elementNosLocalInterior_ and elementNosLocalBoundary_ have been computed
+
+  //! compute the table elementDofNosLocal_, this is done in initialize()
+  void initializeElementDofNosLocal();
+
+  std::vector<dof_no_t> elementDofNosLocal_;                    //< the local dof nos of all local elements, nDofsPerElement entries per element
+  bool elementDofNosLocalInitialized_ = false;                  //< if elementDofNosLocal_ has been computed
 };
 
 }  // namespace
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <array>
 #include <sstream>
+#include <cassert>
 
 #include "easylogging++.h"
 #include "basis_function/lagrange.h"
@@ -30,15 +31,23 @@ template<typename MeshType, typename BasisFunctionType>
 std::array<Vc::int_v,FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement()> FunctionSpace<MeshType,BasisFunctionType>::
 getElementDofNosLocal(Vc::int_v elementNo) const
 {
-  std::array<Vc::int_v,FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement()> dofNosLocal;
-  for (int dofIndex = 0; dofIndex < FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement(); dofIndex++)
+  const int nDofsPerElement = FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement();
+  const std::vector<dof_no_t> &elementDofNosLocal = this->elementDofNosLocal();
+
+  std::array<Vc::int_v,nDofsPerElement> dofNosLocal;
+  for (int vcComponent = 0; vcComponent < Vc::double_v::size(); vcComponent++)
   {
-    for (int vcComponent = 0; vcComponent < Vc::double_v::size(); vcComponent++)
+    if (elementNo[vcComponent] == -1)
     {
-      if (elementNo[vcComponent] == -1)
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
         dofNosLocal[dofIndex][vcComponent] = -1;
-      else
-        dofNosLocal[dofIndex][vcComponent] = this->getDofNo(elementNo[vcComponent], dofIndex);
+    }
+    else
+    {
+      // the dofs of one element are contiguous in the table
+      const dof_no_t *elementDofNos = elementDofNosLocal.data() + elementNo[vcComponent]*nDofsPerElement;
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+        dofNosLocal[dofIndex][vcComponent] = elementDofNos[dofIndex];
     }
   }
   return dofNosLocal;
@@ -106,4 +115,104 @@ getDescription() const
   return description.str();
 }
 
+template<typename MeshType, typename BasisFunctionType>
+const std::vector<element_no_t> &FunctionSpace<MeshType,BasisFunctionType>::
+elementNosLocalInterior() const
+{
+  if (!interiorAndBoundaryElementsInitialized_)
+    initializeInteriorAndBoundaryElements();
+
+  return elementNosLocalInterior_;
+}
+
+template<typename MeshType, typename BasisFunctionType>
+const std::vector<element_no_t> &FunctionSpace<MeshType,BasisFunctionType>::
+elementNosLocalBoundary() const
+{
+  if (!interiorAndBoundaryElementsInitialized_)
+    initializeInteriorAndBoundaryElements();
+
+  return elementNosLocalBoundary_;
+}
+
+template<typename MeshType, typename BasisFunctionType>
+void FunctionSpace<MeshType,BasisFunctionType>::
+initializeInteriorAndBoundaryElements() const
+{
+  const int nDofsPerElement = FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement();
+  const element_no_t nElementsLocal = this->nElementsLocal();
+
+  // the local dof numbering contains the non-ghost dofs first, then the ghost dofs
+  const dof_no_t nDofsLocalWithoutGhosts = this->nDofsLocalWithoutGhosts();
+
+  elementNosLocalInterior_.clear();
+  elementNosLocalBoundary_.clear();
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    bool isInteriorElement = true;
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      if (this->getDofNo(elementNoLocal, dofIndex) >= nDofsLocalWithoutGhosts)
+      {
+        isInteriorElement = false;
+        break;
+      }
+    }
+
+    if (isInteriorElement)
+      elementNosLocalInterior_.push_back(elementNoLocal);
+    else
+      elementNosLocalBoundary_.push_back(elementNoLocal);
+  }
+
+  LOG(DEBUG) << "\"" << this->meshName() << "\": " << elementNosLocalInterior_.size() << " interior and "
+    << elementNosLocalBoundary_.size() << " boundary elements";
+
+  interiorAndBoundaryElementsInitialized_ = true;
+}
+
+template<typename MeshType, typename BasisFunctionType>
+void FunctionSpace<MeshType,BasisFunctionType>::
+initialize()
+{
+  FunctionSpacePointInElement<MeshType,BasisFunctionType>::initialize();
+
+  // the table is created here and not on first use, because the element loops that use it can run in multiple threads
+  initializeElementDofNosLocal();
+}
+
+template<typename MeshType, typename BasisFunctionType>
+const std::vector<dof_no_t> &FunctionSpace<MeshType,BasisFunctionType>::
+elementDofNosLocal() const
+{
+  // the table is not created lazily here, because this is called from the element loops that can run in multiple threads
+  if (!elementDofNosLocalInitialized_)
+  {
+    LOG(FATAL) << "The table of the element dof nos of function space \"" << this->meshName() << "\" is used before initialize() was called.";
+  }
+  return elementDofNosLocal_;
+}
+
+template<typename MeshType, typename BasisFunctionType>
+void FunctionSpace<MeshType,BasisFunctionType>::
+initializeElementDofNosLocal()
+{
+  const int nDofsPerElement = FunctionSpaceFunction<MeshType,BasisFunctionType>::nDofsPerElement();
+  const element_no_t nElementsLocal = this->nElementsLocal();
+
+  // the dof numbering does not change after the function space was created, not even if the mesh deforms, therefore the table can be kept
+  elementDofNosLocal_.resize(nElementsLocal*nDofsPerElement);
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      elementDofNosLocal_[elementNoLocal*nDofsPerElement + dofIndex] = this->getDofNo(elementNoLocal, dofIndex);
+    }
+  }
+
+  elementDofNosLocalInitialized_ = true;
+}
+
 } // namespace
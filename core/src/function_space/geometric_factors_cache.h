@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <array>
+#include <vector>
+#include "control/types.h"
+
+#include "function_space/basis_on_quadrature.h"
+
+namespace FunctionSpace
+{
+
+/** Cache of the geometric factors of a 3D function space at the sampling points of a quadrature rule, i.e. the inverse jacobian
+ *  of the parameter space to world space mapping and its determinant, for all local elements.
+ *  The factors of an element are only recomputed if the geometry values of the element changed since they were last computed,
+ *  i.e. for a fixed reference geometry (e.g. in the solid mechanics assembly) they are computed only once.
+ *  Elements are handled in the same batches of nVcComponents elements as in the vectorized assembly loops, a batch is identified by the index of its first element in the loop.
+ *
+ *  The stored factors are only reused if the geometry values are exactly equal to the stored ones. The cache is therefore only useful for
+ *  a geometry that does not change between the calls, such as the reference configuration. For the current configuration of a deforming mesh
+ *  the comparison never succeeds and every call recomputes the factors after an additional comparison and copy of the geometry values.
+ *  A warning is logged once if the factors of more batches had to be recomputed because of changed geometry values than there are batches.
+ */
+template<typename FunctionSpaceType,typename QuadratureDD>
+class GeometricFactorsCache
+{
+public:
+  static constexpr int nDofsPerElement = FunctionSpaceType::nDofsPerElement();        //< number of dofs per element
+  static constexpr int nSamplingPoints = QuadratureDD::numberEvaluations();           //< number of sampling points of the quadrature rule
+
+  typedef std::array<Vec3_v_t,nDofsPerElement> ElementGeometryType;                   //< the geometry values of an element
+
+  /** the geometric factors at the sampling points of one batch of elements
+   */
+  struct ElementFactors
+  {
+    ElementGeometryType geometry;                                        //< the geometry values from which the factors were computed
+    double_v_t approximateMeshWidth;                                     //< the approximate mesh width of the element, used as tolerance for the inverse
+    std::array<Tensor2_v_t<3>,nSamplingPoints> inverseJacobian;          //< inverseJacobian[samplingPointIndex][columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx
+    std::array<double_v_t,nSamplingPoints> jacobianDeterminant;          //< the determinant of the jacobian
+    bool isValid = false;                                                //< if the factors have been computed
+  };
+
+  //! get the geometric factors of the batch of elements starting at index elementIndex of the assembly loop with the given geometry values, recompute them if the geometry changed
+  const ElementFactors &get(element_no_t elementIndex, const ElementGeometryType &geometry);
+
+  //! discard all stored factors, e.g. if the function space changed
+  void clear();
+
+  //! get the number of times that the factors of a batch were computed since the last clear(), for diagnostics and tests
+  int nComputations() const;
+
+private:
+
+  //! check if the stored geometry values of the element are the same as the given values
+  static bool geometryEquals(const ElementGeometryType &geometry1, const ElementGeometryType &geometry2);
+
+#if defined(USE_VECTORIZED_FE_MATRIX_ASSEMBLY) && !defined(HAVE_STDSIMD)
+  std::vector<ElementFactors,Vc::Allocator<ElementFactors>> elementFactors_;   //< the factors for every batch of nVcComponents elements, aligned for the Vc types
+#else
+  std::vector<ElementFactors> elementFactors_;                                 //< the factors for every batch of nVcComponents elements
+#endif
+  int nComputations_ = 0;                    //< number of computations of the factors of a batch
+  int nRecomputations_ = 0;                  //< number of computations of the factors of a batch that had valid factors for different geometry values
+  bool changingGeometryWarningShown_ = false;   //< if the warning that the geometry changes between the calls was already logged
+};
+
+}  // namespace
+
+#include "function_space/geometric_factors_cache.tpp"
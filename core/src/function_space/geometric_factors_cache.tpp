@@ -0,0 +1,89 @@
+#include "function_space/geometric_factors_cache.h"
+
+#include "utility/math_utility.h"
+#include "easylogging++.h"
+
+namespace FunctionSpace
+{
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+const typename GeometricFactorsCache<FunctionSpaceType,QuadratureDD>::ElementFactors &GeometricFactorsCache<FunctionSpaceType,QuadratureDD>::
+get(element_no_t elementIndex, const ElementGeometryType &geometry)
+{
+  static_assert(FunctionSpaceType::dim() == 3, "GeometricFactorsCache is only implemented for 3D function spaces.");
+
+  // the assembly loops advance by nVcComponents elements, one entry is stored per batch
+  assert(elementIndex % nVcComponents == 0);
+  const int batchNo = elementIndex / nVcComponents;
+
+  if (batchNo >= (int)elementFactors_.size())
+    elementFactors_.resize(batchNo+1);
+
+  ElementFactors &elementFactors = elementFactors_[batchNo];
+
+  if (elementFactors.isValid && geometryEquals(elementFactors.geometry, geometry))
+    return elementFactors;
+
+  VLOG(2) << "compute geometric factors of the elements at index " << elementIndex;
+
+  // the geometry values of the batch changed, for a deforming geometry this happens in every call and the cache only adds overhead
+  if (elementFactors.isValid)
+  {
+    nRecomputations_++;
+    if (nRecomputations_ > (int)elementFactors_.size() && !changingGeometryWarningShown_)
+    {
+      LOG(WARNING) << "The geometric factors of " << nRecomputations_ << " element batches were recomputed because the geometry changed, "
+        << "but there are only " << elementFactors_.size() << " batches. The GeometricFactorsCache should only be used for a fixed geometry.";
+      changingGeometryWarningShown_ = true;
+    }
+  }
+  nComputations_++;
+
+  // compute the factors of the changed element
+  elementFactors.geometry = geometry;
+  elementFactors.approximateMeshWidth = MathUtility::computeApproximateMeshWidth<double_v_t,nDofsPerElement>(geometry);
+
+  for (int samplingPointIndex = 0; samplingPointIndex < nSamplingPoints; samplingPointIndex++)
+  {
+    // jacobian[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
+    Tensor2_v_t<3> jacobian = BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::computeJacobian(geometry, samplingPointIndex);
+    elementFactors.inverseJacobian[samplingPointIndex] = MathUtility::computeInverse(jacobian, elementFactors.approximateMeshWidth,
+                                                                                     elementFactors.jacobianDeterminant[samplingPointIndex]);
+  }
+  elementFactors.isValid = true;
+
+  return elementFactors;
+}
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+void GeometricFactorsCache<FunctionSpaceType,QuadratureDD>::
+clear()
+{
+  elementFactors_.clear();
+  nComputations_ = 0;
+  nRecomputations_ = 0;
+}
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+int GeometricFactorsCache<FunctionSpaceType,QuadratureDD>::
+nComputations() const
+{
+  return nComputations_;
+}
+
+template<typename FunctionSpaceType,typename QuadratureDD>
+bool GeometricFactorsCache<FunctionSpaceType,QuadratureDD>::
+geometryEquals(const ElementGeometryType &geometry1, const ElementGeometryType &geometry2)
+{
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      if (!MathUtility::isEqual<double_v_t>(geometry1[dofIndex][i], geometry2[dofIndex][i]))
+        return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+
+#include <memory>
+#include <vector>
+#include "control/types.h"
+
+namespace MappingBetweenMeshes
+{
+
+/** Base class of EmbeddedGeometry, such that objects for different function space types can be stored in a common container.
+ */
+class EmbeddedGeometryBase
+{
+public:
+  //! virtual destructor
+  virtual ~EmbeddedGeometryBase() {}
+
+  //! set the geometry of the embedded mesh from the current geometry of the host mesh
+  virtual void updateGeometry() = 0;
+};
+
+/** Geometry transfer from a (3D) host mesh, e.g. the deforming muscle mesh, to a mesh that is embedded in it, e.g. a fiber mesh or a finer 3D mesh.
+ *  The embedded mesh is located in the reference configuration of the host mesh, i.e. the element and the xi coordinates of every embedded node
+ *  in the host mesh do not change during the deformation. Therefore the interpolation weights are taken once from the mapping between the meshes
+ *  in the undeformed state and stored in flat arrays. An update of the geometry is then a plain weighted sum of host node positions for every embedded node,
+ *  without the overhead of the generic MappingBetweenMeshes::Manager prepareMapping/map/finalizeMapping sequence.
+ *
+ *  FunctionSpaceHostType: the function space of the host mesh (e.g. 3D muscle mesh) whose geometry is interpolated
+ *  FunctionSpaceEmbeddedType: the function space of the embedded mesh whose geometry gets set
+ */
+template<typename FunctionSpaceHostType, typename FunctionSpaceEmbeddedType>
+class EmbeddedGeometry : public EmbeddedGeometryBase
+{
+public:
+
+  //! constructor, the function spaces need to be initialized and in their reference configuration
+  EmbeddedGeometry(std::shared_ptr<FunctionSpaceHostType> functionSpaceHost, std::shared_ptr<FunctionSpaceEmbeddedType> functionSpaceEmbedded);
+
+  //! set the geometry of the embedded mesh from the current geometry of the host mesh
+  void updateGeometry() override;
+
+private:
+
+  static constexpr int nDofsPerHostElement = FunctionSpaceHostType::nDofsPerElement();   //< number of dofs of a host element, the interpolation stencil of an embedded node
+
+  std::shared_ptr<FunctionSpaceHostType> functionSpaceHost_;           //< the function space of the host mesh
+  std::shared_ptr<FunctionSpaceEmbeddedType> functionSpaceEmbedded_;   //< the function space of the embedded mesh
+
+  std::vector<dof_no_t> embeddedDofNosLocal_;       //< [i] local dof no of the embedded mesh that gets a value, only dofs inside the host mesh are contained
+  std::vector<dof_no_t> hostDofNosLocal_;           //< [i*nDofsPerHostElement + dofIndex] local dof nos (with ghosts) of the host element that contains embedded dof i
+  std::vector<double> weights_;                     //< [i*nDofsPerHostElement + dofIndex] interpolation weights (values of phi) corresponding to hostDofNosLocal_
+
+  std::array<std::vector<double>,3> hostGeometryValues_;   //< buffer for the geometry values of the host mesh, one vector per component
+  std::vector<Vec3> embeddedGeometryValues_;               //< buffer for the interpolated geometry values of the embedded mesh
+};
+
+}  // namespace
+
+#include "mesh/mapping_between_meshes/embedded_geometry.tpp"
@@ -0,0 +1,113 @@
+#include "mesh/mapping_between_meshes/embedded_geometry.h"
+
+#include "control/dihu_context.h"
+#include "mesh/mapping_between_meshes/manager/04_manager.h"
+#include "utility/vector_operators.h"
+#include "easylogging++.h"
+
+namespace MappingBetweenMeshes
+{
+
+template<typename FunctionSpaceHostType, typename FunctionSpaceEmbeddedType>
+EmbeddedGeometry<FunctionSpaceHostType,FunctionSpaceEmbeddedType>::
+EmbeddedGeometry(std::shared_ptr<FunctionSpaceHostType> functionSpaceHost, std::shared_ptr<FunctionSpaceEmbeddedType> functionSpaceEmbedded) :
+  functionSpaceHost_(functionSpaceHost), functionSpaceEmbedded_(functionSpaceEmbedded)
+{
+  assert(functionSpaceHost_);
+  assert(functionSpaceEmbedded_);
+
+  // get the mapping embedded -> host, this contains for every local dof of the embedded mesh the host element and the phi values at its xi coordinates,
+  // the mapping is created if it does not exist yet, this has to happen in the reference configuration
+  std::shared_ptr<MappingBetweenMeshes<FunctionSpaceEmbeddedType,FunctionSpaceHostType>> mapping
+    = DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<FunctionSpaceEmbeddedType,FunctionSpaceHostType>(functionSpaceEmbedded_, functionSpaceHost_);
+
+  const auto &targetMappingInfo = mapping->targetMappingInfo();
+  const dof_no_t nDofsLocalEmbedded = functionSpaceEmbedded_->nDofsLocalWithoutGhosts();
+
+  embeddedDofNosLocal_.reserve(nDofsLocalEmbedded);
+  hostDofNosLocal_.reserve(nDofsLocalEmbedded*nDofsPerHostElement);
+  weights_.reserve(nDofsLocalEmbedded*nDofsPerHostElement);
+
+  for (dof_no_t embeddedDofNoLocal = 0; embeddedDofNoLocal < nDofsLocalEmbedded; embeddedDofNoLocal++)
+  {
+    // if the dof is outside of the host mesh
+    if (!targetMappingInfo[embeddedDofNoLocal].mapThisDof)
+      continue;
+
+    // the first host element is enough for interpolation, like in mapHighToLowDimension
+    const auto &hostElement = targetMappingInfo[embeddedDofNoLocal].targetElements[0];
+
+    std::array<dof_no_t,nDofsPerHostElement> elementDofNosLocal = functionSpaceHost_->getElementDofNosLocal(hostElement.elementNoLocal);
+
+    // normalize the weights such that a rigid translation of the host mesh is reproduced exactly
+    double scalingFactorsSum = 0;
+    for (int dofIndex = 0; dofIndex < nDofsPerHostElement; dofIndex++)
+    {
+      scalingFactorsSum += hostElement.scalingFactors[dofIndex];
+    }
+
+    if (fabs(scalingFactorsSum-1.0) > 1e-10)
+      LOG(WARNING) << "Interpolation weights of dof " << embeddedDofNoLocal << " of mesh \"" << functionSpaceEmbedded_->meshName()
+        << "\" in element " << hostElement.elementNoLocal << " of mesh \"" << functionSpaceHost_->meshName()
+        << "\" do not sum to 1: " << hostElement.scalingFactors << ", sum: " << scalingFactorsSum;
+
+    embeddedDofNosLocal_.push_back(embeddedDofNoLocal);
+    for (int dofIndex = 0; dofIndex < nDofsPerHostElement; dofIndex++)
+    {
+      hostDofNosLocal_.push_back(elementDofNosLocal[dofIndex]);
+      weights_.push_back(hostElement.scalingFactors[dofIndex] / scalingFactorsSum);
+    }
+  }
+
+  embeddedGeometryValues_.resize(embeddedDofNosLocal_.size());
+
+  LOG(DEBUG) << "EmbeddedGeometry \"" << functionSpaceHost_->meshName() << "\" -> \"" << functionSpaceEmbedded_->meshName() << "\": "
+    << embeddedDofNosLocal_.size() << " of " << nDofsLocalEmbedded << " local dofs are inside the host mesh";
+}
+
+template<typename FunctionSpaceHostType, typename FunctionSpaceEmbeddedType>
+void EmbeddedGeometry<FunctionSpaceHostType,FunctionSpaceEmbeddedType>::
+updateGeometry()
+{
+  // get the current geometry of the host mesh, including ghost dofs because host elements can contain ghost dofs
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    functionSpaceHost_->geometryField().getValuesWithGhosts(componentNo, hostGeometryValues_[componentNo]);
+  }
+
+  const double *x = hostGeometryValues_[0].data();
+  const double *y = hostGeometryValues_[1].data();
+  const double *z = hostGeometryValues_[2].data();
+  const dof_no_t *hostDofNosLocal = hostDofNosLocal_.data();
+  const double *weights = weights_.data();
+  const int nEmbeddedDofs = embeddedDofNosLocal_.size();
+
+  // interpolate the positions of all embedded dofs, all three components in one pass over the stencil
+  for (int i = 0; i < nEmbeddedDofs; i++)
+  {
+    double valueX = 0;
+    double valueY = 0;
+    double valueZ = 0;
+
+    const int offset = i*nDofsPerHostElement;
+#pragma omp simd reduction(+:valueX,valueY,valueZ)
+    for (int dofIndex = 0; dofIndex < nDofsPerHostElement; dofIndex++)
+    {
+      const dof_no_t hostDofNoLocal = hostDofNosLocal[offset + dofIndex];
+      const double weight = weights[offset + dofIndex];
+
+      valueX += weight * x[hostDofNoLocal];
+      valueY += weight * y[hostDofNoLocal];
+      valueZ += weight * z[hostDofNoLocal];
+    }
+
+    embeddedGeometryValues_[i] = Vec3({valueX, valueY, valueZ});
+  }
+
+  // set the new geometry values, ghost values are not set, like in the mapping between meshes
+  functionSpaceEmbedded_->geometryField().setValues(embeddedDofNosLocal_, embeddedGeometryValues_);
+
+  VLOG(1) << "updated geometry of mesh \"" << functionSpaceEmbedded_->meshName() << "\" from mesh \"" << functionSpaceHost_->meshName() << "\"";
+}
+
+}  // namespace
@@ -46,6 +46,25 @@ using isStructuredOrComposite = std::enable_if_t<
   MeshType
 >;
 
+// structured, composite and unstructured meshes, i.e. all meshes that have a mesh partition with contiguous petsc numbering and ghost dofs
+template<typename MeshType>
+using isStructuredOrCompositeOrUnstructured = std::enable_if_t<
+  std::is_same<MeshType, StructuredRegularFixedOfDimension<1>>::value
+  || std::is_same<MeshType, StructuredRegularFixedOfDimension<2>>::value
+  || std::is_same<MeshType, StructuredRegularFixedOfDimension<3>>::value
+  || std::is_same<MeshType, StructuredDeformableOfDimension<1>>::value
+  || std::is_same<MeshType, StructuredDeformableOfDimension<2>>::value
+  || std::is_same<MeshType, StructuredDeformableOfDimension<3>>::value
+  || std::is_same<MeshType, CompositeOfDimension<1>>::value
+  || std::is_same<MeshType, CompositeOfDimension<2>>::value
+  || std::is_same<MeshType, CompositeOfDimension<3>>::value
+  || std::is_same<MeshType, UnstructuredDeformableOfDimension<1>>::value
+  || std::is_same<MeshType, UnstructuredDeformableOfDimension<2>>::value
+  || std::is_same<MeshType, UnstructuredDeformableOfDimension<3>>::value
+  ,
+  MeshType
+>;
+
 // deformable meshes
 template<typename MeshType>
 using isDeformable = std::enable_if_t<
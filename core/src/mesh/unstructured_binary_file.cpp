@@ -0,0 +1,200 @@
+#include "mesh/unstructured_binary_file.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+#include "utility/mpi_utility.h"
+#include "easylogging++.h"
+
+namespace Mesh
+{
+
+namespace
+{
+const char binaryFileMagic[8] = {'O','P','D','I','H','U','M','B'};
+const int32_t binaryFileFormatVersion = 1;
+}
+
+void UnstructuredBinaryFile::write(std::string filename, int dimension, int nNodesPerElement, int nDofsPerNode, const std::vector<int64_t> &elementNodeNos,
+                                   const std::vector<int32_t> &elementNodeVersions, const std::vector<double> &nodeValues)
+{
+  assert(elementNodeNos.size() == elementNodeVersions.size());
+  assert(elementNodeNos.size() % nNodesPerElement == 0);
+  assert(nodeValues.size() % (nDofsPerNode*3) == 0);
+
+  Header header;
+  std::memcpy(header.magic, binaryFileMagic, sizeof(header.magic));
+  header.formatVersion = binaryFileFormatVersion;
+  header.dimension = dimension;
+  header.nNodesPerElement = nNodesPerElement;
+  header.nDofsPerNode = nDofsPerNode;
+  header.nElements = elementNodeNos.size() / nNodesPerElement;
+  header.nNodes = nodeValues.size() / (nDofsPerNode*3);
+
+  // compute the element centroids from the positions of the nodes, i.e. the first dof of every node
+  std::vector<double> elementCentroids(header.nElements*3, 0.0);
+  for (int64_t elementNo = 0; elementNo < header.nElements; elementNo++)
+  {
+    for (int nodeIndex = 0; nodeIndex < nNodesPerElement; nodeIndex++)
+    {
+      int64_t nodeNo = elementNodeNos[elementNo*nNodesPerElement + nodeIndex];
+      for (int i = 0; i < 3; i++)
+      {
+        elementCentroids[elementNo*3 + i] += nodeValues[nodeNo*nDofsPerNode*3 + i] / nNodesPerElement;
+      }
+    }
+  }
+
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    LOG(ERROR) << "Could not write binary mesh file \"" << filename << "\".";
+    return;
+  }
+
+  file.write((const char *)&header, sizeof(Header));
+  file.write((const char *)elementNodeNos.data(), elementNodeNos.size()*sizeof(int64_t));
+  file.write((const char *)elementNodeVersions.data(), elementNodeVersions.size()*sizeof(int32_t));
+  file.write((const char *)elementCentroids.data(), elementCentroids.size()*sizeof(double));
+  file.write((const char *)nodeValues.data(), nodeValues.size()*sizeof(double));
+  file.close();
+
+  LOG(INFO) << "Wrote binary mesh file \"" << filename << "\" with " << header.nElements << " elements and " << header.nNodes << " nodes.";
+}
+
+UnstructuredBinaryFile::UnstructuredBinaryFile(std::string filename, MPI_Comm mpiCommunicator) :
+  filename_(filename)
+{
+  // collectively open the file for reading
+  MPIUtility::handleReturnValue(MPI_File_open(mpiCommunicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fileHandle_), "MPI_File_open");
+
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle_, 0, &header_, sizeof(Header), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  if (std::memcmp(header_.magic, binaryFileMagic, sizeof(header_.magic)) != 0 || header_.formatVersion != binaryFileFormatVersion)
+  {
+    LOG(FATAL) << "File \"" << filename << "\" is not a binary mesh file of format version " << binaryFileFormatVersion << ". "
+      << "Delete it such that it is created again from the exelem and exnode files.";
+  }
+
+  LOG(DEBUG) << "Opened binary mesh file \"" << filename << "\", D=" << header_.dimension << ", " << header_.nElements << " elements, "
+    << header_.nNodes << " nodes, " << header_.nNodesPerElement << " nodes per element, " << header_.nDofsPerNode << " dofs per node.";
+}
+
+UnstructuredBinaryFile::~UnstructuredBinaryFile()
+{
+  MPIUtility::handleReturnValue(MPI_File_close(&fileHandle_), "MPI_File_close");
+}
+
+const UnstructuredBinaryFile::Header &UnstructuredBinaryFile::header() const
+{
+  return header_;
+}
+
+void UnstructuredBinaryFile::readTopology(global_no_t elementNoBegin, global_no_t elementNoEnd, std::vector<int64_t> &elementNodeNos,
+                                          std::vector<int32_t> &elementNodeVersions, std::vector<Vec3> &elementCentroids)
+{
+  assert(elementNoBegin <= elementNoEnd && elementNoEnd <= header_.nElements);
+
+  const int64_t nEntriesGlobal = header_.nElements*header_.nNodesPerElement;
+  const int64_t nElements = elementNoEnd - elementNoBegin;
+  const int64_t nEntries = nElements*header_.nNodesPerElement;
+
+  // the counts of MPI are int, therefore whole elements are read with derived datatypes and only the number of local elements has to fit into an int
+  if (nElements > std::numeric_limits<int>::max())
+  {
+    LOG(FATAL) << "Could not read binary mesh file "" << filename_ << "", the block of " << nElements << " elements of the own rank "
+      << "is too large for MPI-IO. Use more ranks.";
+  }
+
+  elementNodeNos.resize(nEntries);
+  elementNodeVersions.resize(nEntries);
+  elementCentroids.resize(nElements);
+
+  MPI_Datatype elementNodeNosType, elementNodeVersionsType, elementCentroidType;
+  MPIUtility::handleReturnValue(MPI_Type_contiguous(header_.nNodesPerElement, MPI_INT64_T, &elementNodeNosType), "MPI_Type_contiguous");
+  MPIUtility::handleReturnValue(MPI_Type_contiguous(header_.nNodesPerElement, MPI_INT32_T, &elementNodeVersionsType), "MPI_Type_contiguous");
+  MPIUtility::handleReturnValue(MPI_Type_contiguous(3, MPI_DOUBLE, &elementCentroidType), "MPI_Type_contiguous");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&elementNodeNosType), "MPI_Type_commit");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&elementNodeVersionsType), "MPI_Type_commit");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&elementCentroidType), "MPI_Type_commit");
+
+  // every rank reads its range of every block, the offsets are computed in 64 bit
+  MPI_Offset offset = (MPI_Offset)sizeof(Header) + (MPI_Offset)elementNoBegin*header_.nNodesPerElement*sizeof(int64_t);
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle_, offset, elementNodeNos.data(), nElements, elementNodeNosType, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  offset = (MPI_Offset)sizeof(Header) + (MPI_Offset)nEntriesGlobal*sizeof(int64_t) + (MPI_Offset)elementNoBegin*header_.nNodesPerElement*sizeof(int32_t);
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle_, offset, elementNodeVersions.data(), nElements, elementNodeVersionsType, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  offset = (MPI_Offset)sizeof(Header) + (MPI_Offset)nEntriesGlobal*(sizeof(int64_t) + sizeof(int32_t)) + (MPI_Offset)elementNoBegin*3*sizeof(double);
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle_, offset, elementCentroids.data(), nElements, elementCentroidType, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  MPIUtility::handleReturnValue(MPI_Type_free(&elementNodeNosType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_Type_free(&elementNodeVersionsType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_Type_free(&elementCentroidType), "MPI_Type_free");
+}
+
+void UnstructuredBinaryFile::readNodeValues(const std::vector<global_no_t> &nodeNosGlobal, std::vector<double> &nodeValues)
+{
+  const int nValuesPerNode = header_.nDofsPerNode*3;
+
+  if (nodeNosGlobal.size() > (std::size_t)std::numeric_limits<int>::max())
+  {
+    LOG(FATAL) << "Could not read binary mesh file "" << filename_ << "", the " << nodeNosGlobal.size() << " nodes of the own rank "
+      << "are too many for MPI-IO. Use more ranks.";
+  }
+  const int nNodes = nodeNosGlobal.size();
+
+  // the file view needs ascending displacements, therefore read the nodes in sorted order
+  std::vector<int> permutation(nNodes);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::sort(permutation.begin(), permutation.end(), [&nodeNosGlobal](int a, int b)
+  {
+    return nodeNosGlobal[a] < nodeNosGlobal[b];
+  });
+
+  // the displacements are given in bytes as MPI_Aint, such that global node nos of large meshes do not overflow
+  std::vector<MPI_Aint> displacements(nNodes);
+  for (int i = 0; i < nNodes; i++)
+  {
+    displacements[i] = (MPI_Aint)nodeNosGlobal[permutation[i]]*nValuesPerNode*sizeof(double);
+  }
+
+  // create a file type that selects the records of the local nodes
+  MPI_Datatype nodeRecordType, fileType;
+  MPIUtility::handleReturnValue(MPI_Type_contiguous(nValuesPerNode, MPI_DOUBLE, &nodeRecordType), "MPI_Type_contiguous");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&nodeRecordType), "MPI_Type_commit");
+  MPIUtility::handleReturnValue(MPI_Type_create_hindexed_block(nNodes, 1, displacements.data(), nodeRecordType, &fileType), "MPI_Type_create_hindexed_block");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&fileType), "MPI_Type_commit");
+
+  MPIUtility::handleReturnValue(MPI_File_set_view(fileHandle_, nodeValuesOffset(), MPI_DOUBLE, fileType, "native", MPI_INFO_NULL), "MPI_File_set_view");
+
+  // the count is the number of node records, not the number of values
+  std::vector<double> readBuffer((std::size_t)nNodes*nValuesPerNode);
+  MPIUtility::handleReturnValue(MPI_File_read_all(fileHandle_, readBuffer.data(), nNodes, nodeRecordType, MPI_STATUS_IGNORE), "MPI_File_read_all");
+
+  // reset the view such that the explicit offsets of the other methods are in bytes again
+  MPIUtility::handleReturnValue(MPI_File_set_view(fileHandle_, 0, MPI_BYTE, MPI_BYTE, "native", MPI_INFO_NULL), "MPI_File_set_view");
+
+  MPIUtility::handleReturnValue(MPI_Type_free(&fileType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_Type_free(&nodeRecordType), "MPI_Type_free");
+
+  // undo the sorting
+  nodeValues.resize((std::size_t)nNodes*nValuesPerNode);
+  for (int i = 0; i < nNodes; i++)
+  {
+    std::copy(readBuffer.begin() + (std::size_t)i*nValuesPerNode, readBuffer.begin() + (std::size_t)(i+1)*nValuesPerNode,
+              nodeValues.begin() + (std::size_t)permutation[i]*nValuesPerNode);
+  }
+}
+
+MPI_Offset UnstructuredBinaryFile::nodeValuesOffset() const
+{
+  const int64_t nEntries = header_.nElements*header_.nNodesPerElement;
+  return (MPI_Offset)sizeof(Header) + (MPI_Offset)nEntries*(sizeof(int64_t) + sizeof(int32_t)) + (MPI_Offset)header_.nElements*3*sizeof(double);
+}
+
+}  // namespace
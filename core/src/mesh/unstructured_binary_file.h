@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <mpi.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "control/types.h"
+
+namespace Mesh
+{
+
+/** A compact binary file format for unstructured meshes, it is created once from exelem/exnode files and can then be read in parallel with MPI-IO.
+ *  All values are stored in native byte order. The file consists of the header and the following blocks:
+ *   - element node nos:       nElements*nNodesPerElement int64 values, the global node nos of the nodes of every element
+ *   - element node versions:  nElements*nNodesPerElement int32 values, the version no of every node in the element
+ *   - element centroids:      nElements*3 double values, needed to partition the mesh without reading the node values
+ *   - node values:            nNodes*nDofsPerNode*3 double values, for every node the dof values for x,y,z
+ *
+ *  Every rank reads the topology (first three blocks) only for its block of elements, from which the partitioning is computed collectively,
+ *  the node values are only read for the local nodes. The reads use derived datatypes and 64 bit offsets, only the numbers of local elements and nodes have to fit into an int.
+ *
+ *  The format stores one version per node and no scale factors. Therefore FunctionSpaceDataUnstructured::writeBinaryFile rejects Hermite meshes,
+ *  nodes with more than one version and elements with scale factors with an error, these meshes have to be read from the exfiles.
+ */
+class UnstructuredBinaryFile
+{
+public:
+
+  //! the header at the beginning of the file
+  struct Header
+  {
+    char magic[8];              //< the characters "OPDIHUMB", to identify the file format
+    int32_t formatVersion;      //< the version of the format, currently 1
+    int32_t dimension;          //< dimensionality D of the mesh
+    int32_t nNodesPerElement;   //< number of nodes per element
+    int32_t nDofsPerNode;       //< number of dofs per node and version
+    int64_t nElements;          //< total number of elements
+    int64_t nNodes;             //< total number of nodes
+  };
+
+  //! write a binary mesh file, this is not collective and should be called by a single rank
+  //! @param elementNodeNos for every element the global node nos, nElements*nNodesPerElement entries
+  //! @param elementNodeVersions for every element the version nos of the nodes, nElements*nNodesPerElement entries
+  //! @param nodeValues for every node nDofsPerNode*3 values, for every dof the x,y,z values
+  static void write(std::string filename, int dimension, int nNodesPerElement, int nDofsPerNode, const std::vector<int64_t> &elementNodeNos,
+                    const std::vector<int32_t> &elementNodeVersions, const std::vector<double> &nodeValues);
+
+  //! collectively open the file on all ranks of the communicator and read the header
+  UnstructuredBinaryFile(std::string filename, MPI_Comm mpiCommunicator);
+
+  //! close the file
+  ~UnstructuredBinaryFile();
+
+  //! the header of the file
+  const Header &header() const;
+
+  //! collectively read the topology of the elements [elementNoBegin, elementNoEnd), every rank reads its own range
+  void readTopology(global_no_t elementNoBegin, global_no_t elementNoEnd, std::vector<int64_t> &elementNodeNos,
+                    std::vector<int32_t> &elementNodeVersions, std::vector<Vec3> &elementCentroids);
+
+  //! collectively read the node values of the given global node nos, nodeValues will contain nDofsPerNode*3 values for every node
+  void readNodeValues(const std::vector<global_no_t> &nodeNosGlobal, std::vector<double> &nodeValues);
+
+private:
+
+  //! the offset in bytes of the block of the node values
+  MPI_Offset nodeValuesOffset() const;
+
+  std::string filename_;          //< the filename
+  MPI_File fileHandle_;           //< the MPI file handle, opened read-only
+  Header header_;                 //< the header of the file
+};
+
+}  // namespace
@@ -36,6 +36,12 @@ advanceTimeSpan(bool withOutputWritersEnabled)
   Mat &basis = this->dataMOR_->basis()->valuesGlobal();
   //Mat &basisTransp = this->dataMOR_->basisTransp()->valuesGlobal();
   
+  // with the dense solver, the reduced solution is kept in a contiguous array during the time steps,
+  // it is only copied to the reduced solution vector when output is written and at the end of the time span,
+  // it is only transferred to the full-order space when output of the full-order solution is written or when fullTimestepping() is called
+  if (this->useDenseSolver_)
+    this->gatherReducedState();
+
   // loop over time steps
   double currentTime = this->startTime_;
   
@@ -49,25 +55,48 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     // advance simulation time
     timeStepNo++;
     currentTime = this->startTime_ + double(timeStepNo) / this->numberTimeSteps_ * timeSpan;   
-    
-    // transfer to full-order space
-    this->MatMultFull(basis,redSolution,solution);
-    
-    VLOG(1) << "starting from solution: " << *this->fullTimestepping_.data().solution();    
-    
-    // adjust the full-order rhs vector such that boundary conditions are satisfied
-    //this->fullTimestepping_.dirichletBoundaryConditions()->applyInRightHandSide(this->fullTimestepping_.data().solution(), this->fullTimestepping_.dataImplicit().boundaryConditionsRightHandSideSummand());    
-    // In case, the solution is changed after applying the boundary condition
-    //this->MatMultReduced(basisTransp, this->fullTimestepping_.data().solution()->valuesGlobal(), redSolution);      
-    
-    // advance computed value
-    // solve A_R*z^{t+1} = z^{t} for z^{t+1} where A_R is the reduced system matrix, solveLinearSystem(b,x)
-    this->solveLinearSystem(redSolution, redSolution);       
-    
-    // transfer to full-order space
-    this->MatMultFull(basis,redSolution,solution);          
-    
-    VLOG(1) << "solution after integration: " << *this->fullTimestepping_.data().solution();
+
+    if (this->useDenseSolver_)
+    {
+      // solve A_R*z^{t+1} = z^{t} with the precomputed LU factorization of A_R
+      this->solveLinearSystemDense();
+      this->fullSolutionOutdated_ = true;
+
+      if (withOutputWritersEnabled)
+      {
+        // only update the solution vectors if an output writer will write them in this time step
+        bool fullOutputDue = this->fullTimestepping_.outputWriterManager().nCallsUntilNextOutput() == 1;
+        bool reducedOutputDue = this->outputWriterManager().nCallsUntilNextOutput() == 1;
+
+        if (fullOutputDue || reducedOutputDue)
+          this->scatterReducedState();
+
+        // transfer to full-order space
+        if (fullOutputDue)
+          this->updateFullSolution();
+      }
+    }
+    else
+    {
+      // transfer to full-order space
+      this->MatMultFull(basis,redSolution,solution);
+      
+      VLOG(1) << "starting from solution: " << *this->fullTimestepping_.data().solution();    
+      
+      // adjust the full-order rhs vector such that boundary conditions are satisfied
+      //this->fullTimestepping_.dirichletBoundaryConditions()->applyInRightHandSide(this->fullTimestepping_.data().solution(), this->fullTimestepping_.dataImplicit().boundaryConditionsRightHandSideSummand());    
+      // In case, the solution is changed after applying the boundary condition
+      //this->MatMultReduced(basisTransp, this->fullTimestepping_.data().solution()->valuesGlobal(), redSolution);      
+      
+      // advance computed value
+      // solve A_R*z^{t+1} = z^{t} for z^{t+1} where A_R is the reduced system matrix, solveLinearSystem(b,x)
+      this->solveLinearSystem(redSolution, redSolution);       
+      
+      // transfer to full-order space
+      this->MatMultFull(basis,redSolution,solution);          
+      
+      VLOG(1) << "solution after integration: " << *this->fullTimestepping_.data().solution();
+    }
     
     // stop duration measurement
     if (this->durationLogKey_ != "")
@@ -87,6 +116,11 @@ advanceTimeSpan(bool withOutputWritersEnabled)
       Control::PerformanceMeasurement::start(this->durationLogKey_);
     
   }
+
+  // store the final reduced solution in the solution vector, which is also used for the slot transfer,
+  // the full-order solution is reconstructed later if it is needed
+  if (this->useDenseSolver_)
+    this->scatterReducedState();
   
   // stop duration measurement
   if (this->durationLogKey_ != "")
@@ -2,6 +2,7 @@
 #include "data_management/data.h"
 //#include <petscmat.h>
 #include <array>
+#include <numeric>
 #include "utility/svd_utility.h"
 
 namespace ModelOrderReduction
@@ -43,7 +44,53 @@ namespace ModelOrderReduction
     PetscInt mat_sz_1, mat_sz_2;
     MatGetSize(basis,&mat_sz_1,&mat_sz_2);
     LOG(DEBUG) << "basis, mat_sz_1: " << mat_sz_1 << "basis, mat_sz_2: " << mat_sz_2 << "==============";
-    
+
+    // the basis can be given as binary file, e.g. computed by the PodBasis output writer, then every rank reads only its own rows
+    // the rows in the file are ordered by global natural dof numbers, they are mapped to the PETSc numbering of the local dofs
+    std::string basisFile = specificSettingsMOR_.getOptionString("basisFile", "");
+    if (basisFile != "")
+    {
+      MPI_Comm mpiCommunicator;
+      ierr = PetscObjectGetComm((PetscObject)basis, &mpiCommunicator); CHKERRV(ierr);
+
+      std::shared_ptr<FunctionSpaceRowsType> functionSpaceRows = this->dataMOR_->functionSpaceRows();
+      assert(functionSpaceRows);
+      std::vector<global_no_t> dofNosGlobalNatural;
+      functionSpaceRows->meshPartition()->getDofNosGlobalNatural(dofNosGlobalNatural);
+      std::vector<long long> rowNosGlobalNatural(dofNosGlobalNatural.begin(), dofNosGlobalNatural.end());
+
+      std::vector<double> basisValues;
+      std::vector<double> singularValues;
+      if (!SvdUtility::readBasisBinary(basisFile, rowNosGlobalNatural, mat_sz_2, basisValues, singularValues, mpiCommunicator))
+      {
+        LOG(FATAL) << "Could not read the basis for the model order reduction from \"" << basisFile << "\".";
+      }
+      LOG(DEBUG) << "read " << mat_sz_2 << " of " << singularValues.size() << " modes from \"" << basisFile << "\", singular values: " << singularValues;
+
+      const PetscInt nRowsLocal = rowNosGlobalNatural.size();
+      std::vector<PetscInt> rowIndices(nRowsLocal);
+      std::vector<PetscInt> columnIndices(mat_sz_2);
+      for (dof_no_t dofNoLocal = 0; dofNoLocal < nRowsLocal; dofNoLocal++)
+      {
+        rowIndices[dofNoLocal] = functionSpaceRows->meshPartition()->getDofNoGlobalPetsc(dofNoLocal);
+      }
+      std::iota(columnIndices.begin(), columnIndices.end(), 0);
+
+      // the values are row-major, as expected by MatSetValues
+      ierr = MatSetValues(basis, nRowsLocal, rowIndices.data(), mat_sz_2, columnIndices.data(), basisValues.data(), INSERT_VALUES); CHKERRV(ierr);
+
+      // interpreted as column-major, the same values are the block of the transposed basis
+      ierr = MatSetOption(basisTransp, MAT_ROW_ORIENTED, PETSC_FALSE); CHKERRV(ierr);
+      ierr = MatSetValues(basisTransp, mat_sz_2, columnIndices.data(), nRowsLocal, rowIndices.data(), basisValues.data(), INSERT_VALUES); CHKERRV(ierr);
+      ierr = MatSetOption(basisTransp, MAT_ROW_ORIENTED, PETSC_TRUE); CHKERRV(ierr);
+
+      ierr = MatAssemblyBegin(basis, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+      ierr = MatAssemblyBegin(basisTransp, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+      ierr = MatAssemblyEnd(basis, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+      ierr = MatAssemblyEnd(basisTransp, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+      return;
+    }
+
     // input data is the transpose of the snapshot matrix    
     std::string inputData = specificSettingsMOR_.getOptionString("snapshots","");
     std::cout << inputData;
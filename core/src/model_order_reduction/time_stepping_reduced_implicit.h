@@ -1,5 +1,8 @@
 #pragma once
 
+#include <vector>
+#include <petscblaslapack.h>
+
 #include "control/dihu_context.h"
 #include "data_management/time_stepping/time_stepping_implicit.h"
 #include "model_order_reduction/time_stepping_scheme_ode_reduced.h"
@@ -32,10 +35,30 @@ namespace ModelOrderReduction
     
     //! solves the linear system of equations resulting from the Implicit Euler method time discretization
     void solveLinearSystem(Vec &input, Vec &output); 
+
+    //! gather the reduced system matrix on every rank and compute its LU factorization with LAPACK
+    void factorizeRedSystemMatrixDense();
+
+    //! solve A_R*z^{t+1} = z^{t} in-place for reducedState_, using the LU factorization of the reduced system matrix
+    void solveLinearSystemDense();
+
+    //! copy the values of the reduced solution vector of all ranks to reducedState_
+    void gatherReducedState();
+
+    //! copy the own values of reducedState_ to the reduced solution vector
+    void scatterReducedState();
+
+    //! compute the full-order solution from the reduced solution vector
+    void updateFullSolution() override;
     
     //std::shared_ptr<Data::TimeSteppingImplicit<typename DiscretizableInTimeType::FunctionSpace, DiscretizableInTimeType::nComponents()>> dataImplicit_;  //< a pointer to the data_ object but of type Data::TimeSteppingImplicit
     std::shared_ptr<Solver::Linear> linearSolver_;   //< the linear solver used for solving the system
     std::shared_ptr<KSP> ksp_;     //< the ksp object of the linear solver
+
+    bool useDenseSolver_;                       //< if the reduced system is solved with the dense LU factorization instead of the ksp, option "denseReducedSystem"
+    std::vector<double> redSystemMatrixLU_;     //< LU factorization of the reduced system matrix in column-major order, this is the same on all ranks
+    std::vector<PetscBLASInt> pivotIndices_;    //< the pivot indices of the LU factorization
+    std::vector<double> reducedState_;          //< the reduced solution z of all ranks in a contiguous array, used with the dense solver
     
   };
   
@@ -2,6 +2,8 @@
 
 #include <Python.h>
 #include "utility/python_utility.h"
+#include "utility/mpi_utility.h"
+#include <algorithm>
 #include <petscksp.h>
 #include <petscmat.h> 
 #include "solver/solver_manager.h"
@@ -45,6 +47,14 @@ initialize()
   assert(this->ksp_);
   PetscErrorCode ierr;
   ierr = KSPSetOperators(*ksp_, redSystemMatrix, redSystemMatrix); CHKERRV(ierr);
+
+  // the reduced system is small, therefore it is factorized once with dense LAPACK and every time step only needs the forward and backward substitution,
+  // the ksp solver can still be used by setting "denseReducedSystem" to False
+  useDenseSolver_ = this->specificSettings_.getOptionBool("denseReducedSystem", true);
+  if (useDenseSolver_)
+  {
+    factorizeRedSystemMatrixDense();
+  }
   
   this->initialized_=true;
   
@@ -176,6 +186,136 @@ solveLinearSystem(Vec &input, Vec &output)
   << ": " << PetscUtility::getStringLinearConvergedReason(convergedReason);
 }
 
+template<typename TimeSteppingImplicitType>
+void TimeSteppingSchemeOdeReducedImplicit<TimeSteppingImplicitType>::
+factorizeRedSystemMatrixDense()
+{
+  Mat &redSystemMatrix = this->dataMOR_->redSystemMatrix()->valuesGlobal();
+  MPI_Comm mpiCommunicator = this->data_->functionSpace()->meshPartition()->mpiCommunicator();
+
+  PetscErrorCode ierr;
+  PetscInt nRows, nColumns;
+  ierr = MatGetSize(redSystemMatrix, &nRows, &nColumns); CHKERRV(ierr);
+
+  if (nRows != nColumns)
+  {
+    LOG(FATAL) << "The reduced system matrix is not square (" << nRows << "x" << nColumns << ").";
+  }
+  const int n = nRows;
+
+  // collect the own rows of the reduced system matrix in a dense column-major matrix, then sum up the matrices of all ranks
+  redSystemMatrixLU_.assign(n*n, 0.0);
+
+  PetscInt rowNoBegin, rowNoEnd;
+  ierr = MatGetOwnershipRange(redSystemMatrix, &rowNoBegin, &rowNoEnd); CHKERRV(ierr);
+  for (PetscInt rowNo = rowNoBegin; rowNo < rowNoEnd; rowNo++)
+  {
+    PetscInt nEntries;
+    const PetscInt *columnNos;
+    const PetscScalar *values;
+    ierr = MatGetRow(redSystemMatrix, rowNo, &nEntries, &columnNos, &values); CHKERRV(ierr);
+    for (PetscInt entryNo = 0; entryNo < nEntries; entryNo++)
+    {
+      redSystemMatrixLU_[columnNos[entryNo]*n + rowNo] = values[entryNo];
+    }
+    ierr = MatRestoreRow(redSystemMatrix, rowNo, &nEntries, &columnNos, &values); CHKERRV(ierr);
+  }
+
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, redSystemMatrixLU_.data(), n*n, MPI_DOUBLE, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+
+  // compute the LU factorization, every rank computes the same factorization
+  PetscBLASInt nBlas = n;
+  PetscBLASInt info = 0;
+  pivotIndices_.resize(std::max(1,n));
+  LAPACKgetrf_(&nBlas, &nBlas, redSystemMatrixLU_.data(), &nBlas, pivotIndices_.data(), &info);
+
+  if (info != 0)
+  {
+    LOG(FATAL) << "LU factorization of the reduced system matrix (" << n << "x" << n << ") failed, LAPACK getrf returned info=" << info << ".";
+  }
+
+  LOG(DEBUG) << "Computed dense LU factorization of the reduced system matrix (" << n << "x" << n << ").";
+}
+
+template<typename TimeSteppingImplicitType>
+void TimeSteppingSchemeOdeReducedImplicit<TimeSteppingImplicitType>::
+solveLinearSystemDense()
+{
+  // solve LU*z^{t+1} = z^{t}, the solution overwrites the right hand side
+  const char transpose = 'N';
+  PetscBLASInt nBlas = reducedState_.size();
+  PetscBLASInt nRightHandSides = 1;
+  PetscBLASInt info = 0;
+  LAPACKgetrs_(&transpose, &nBlas, &nRightHandSides, redSystemMatrixLU_.data(), &nBlas, pivotIndices_.data(), reducedState_.data(), &nBlas, &info);
+
+  if (info != 0)
+  {
+    LOG(ERROR) << "Solution of the reduced system failed, LAPACK getrs returned info=" << info << ".";
+  }
+}
+
+template<typename TimeSteppingImplicitType>
+void TimeSteppingSchemeOdeReducedImplicit<TimeSteppingImplicitType>::
+gatherReducedState()
+{
+  Vec &redSolution = this->data().solution()->valuesGlobal();
+  MPI_Comm mpiCommunicator = this->data_->functionSpace()->meshPartition()->mpiCommunicator();
+  int nRanks = this->data_->functionSpace()->meshPartition()->nRanks();
+
+  PetscErrorCode ierr;
+  PetscInt nValuesLocal, nValuesGlobal;
+  ierr = VecGetLocalSize(redSolution, &nValuesLocal); CHKERRV(ierr);
+  ierr = VecGetSize(redSolution, &nValuesGlobal); CHKERRV(ierr);
+
+  // gather the local sizes and compute the offsets of all ranks
+  int nValuesLocalInt = nValuesLocal;
+  std::vector<int> nValuesOnRanks(nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(&nValuesLocalInt, 1, MPI_INT, nValuesOnRanks.data(), 1, MPI_INT, mpiCommunicator), "MPI_Allgather");
+
+  std::vector<int> offsets(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+  {
+    offsets[rankNo] = offsets[rankNo-1] + nValuesOnRanks[rankNo-1];
+  }
+
+  reducedState_.resize(nValuesGlobal);
+
+  const double *values;
+  ierr = VecGetArrayRead(redSolution, &values); CHKERRV(ierr);
+  MPIUtility::handleReturnValue(MPI_Allgatherv(values, nValuesLocalInt, MPI_DOUBLE, reducedState_.data(), nValuesOnRanks.data(), offsets.data(),
+                                               MPI_DOUBLE, mpiCommunicator), "MPI_Allgatherv");
+  ierr = VecRestoreArrayRead(redSolution, &values); CHKERRV(ierr);
+}
+
+template<typename TimeSteppingImplicitType>
+void TimeSteppingSchemeOdeReducedImplicit<TimeSteppingImplicitType>::
+scatterReducedState()
+{
+  Vec &redSolution = this->data().solution()->valuesGlobal();
+
+  PetscErrorCode ierr;
+  PetscInt indexBegin, indexEnd;
+  ierr = VecGetOwnershipRange(redSolution, &indexBegin, &indexEnd); CHKERRV(ierr);
+
+  double *values;
+  ierr = VecGetArray(redSolution, &values); CHKERRV(ierr);
+  std::copy(reducedState_.begin() + indexBegin, reducedState_.begin() + indexEnd, values);
+  ierr = VecRestoreArray(redSolution, &values); CHKERRV(ierr);
+}
+
+template<typename TimeSteppingImplicitType>
+void TimeSteppingSchemeOdeReducedImplicit<TimeSteppingImplicitType>::
+updateFullSolution()
+{
+  Vec &solution = this->fullTimestepping_.data().solution()->valuesGlobal();
+  Vec &redSolution = this->data().solution()->valuesGlobal();
+  Mat &basis = this->dataMOR_->basis()->valuesGlobal();
+
+  // transfer to full-order space
+  this->MatMultFull(basis,redSolution,solution);
+  this->fullSolutionOutdated_ = false;
+}
+
 template<typename TimeSteppingImplicitType>
 void TimeSteppingSchemeOdeReducedImplicit<TimeSteppingImplicitType>::
 initializeLinearSolver()
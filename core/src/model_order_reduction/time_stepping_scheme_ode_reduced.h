@@ -40,8 +40,8 @@ namespace ModelOrderReduction
     //! reset state such that new initialization becomes necessary
     //virtual void reset();
 
-    //! full-order timestepping object
-    TimeSteppingType fullTimestepping();
+    //! full-order timestepping object, its solution is reconstructed from the reduced solution first if it is outdated
+    TimeSteppingType &fullTimestepping();
 
     //! get the data that will be transferred in the operator splitting to the other term of the splitting
     //! the transfer is done by the slot_connector_data_transfer class
@@ -54,6 +54,9 @@ namespace ModelOrderReduction
     //! prepare the discretizableInTime object for the following call to getSlotConnectorData()
     virtual void prepareForGetSlotConnectorData() {}
 
+    //! compute the full-order solution from the reduced solution, this is called by fullTimestepping() if fullSolutionOutdated_ is set
+    virtual void updateFullSolution() {}
+
     std::shared_ptr<GenericFunctionSpace> functionSpaceRed;
     std::shared_ptr<GenericFunctionSpace> functionSpaceRowsSnapshots;
     
@@ -61,6 +64,7 @@ namespace ModelOrderReduction
     std::shared_ptr<SlotConnectorDataType> slotConnectorData_;
 
     bool initialized_;     //< if initialize() was already called
+    bool fullSolutionOutdated_;   //< if the solution of fullTimestepping_ does not yet correspond to the current reduced solution
 
   };
   
@@ -19,7 +19,7 @@ TimeSteppingSchemeOdeReduced<TimeSteppingType>::
 TimeSteppingSchemeOdeReduced(DihuContext context, std::string name):
 MORBase<typename TimeSteppingType::FunctionSpace>(context["ModelOrderReduction"]),
 ::TimeSteppingScheme::TimeSteppingSchemeOdeBase<::FunctionSpace::Generic,1>(context["ModelOrderReduction"],name),
-  fullTimestepping_(context["ModelOrderReduction"]), initialized_(false)
+  fullTimestepping_(context["ModelOrderReduction"]), initialized_(false), fullSolutionOutdated_(false)
 {
   LOG(DEBUG) << "Constructor TimeSteppingSchemeOdeReduced, given context: " << context.getPythonConfig();
 
@@ -160,9 +160,13 @@ run()
 }
 
 template<typename TimeSteppingType>
-TimeSteppingType TimeSteppingSchemeOdeReduced<TimeSteppingType>::
+TimeSteppingType &TimeSteppingSchemeOdeReduced<TimeSteppingType>::
 fullTimestepping()
 {
+  // the full-order solution is only reconstructed when it is actually read
+  if (fullSolutionOutdated_)
+    updateFullSolution();
+
   return fullTimestepping_;
 }
 
@@ -2,6 +2,7 @@
 #include "utility/python_utility.h"
 
 #include "control/coupling/coupling.h"
+#include "control/coupling/concurrent_coupling.h"
 #include "control/coupling/multiple_coupling.h"
 #include "control/dihu_context.h"
 #include "control/multiple_instances.h"
@@ -37,6 +38,7 @@
 #include "time_stepping_scheme/heun.h"
 #include "time_stepping_scheme/repeated_call.h"
 #include "time_stepping_scheme/repeated_call_static.h"
+#include "time_stepping_scheme/parareal.h"
 #include "specialized_solver/multidomain_solver/multidomain_solver.h"
 #include "specialized_solver/multidomain_solver/multidomain_with_fat_solver.h"
 #include "specialized_solver/static_bidomain_solver.h"
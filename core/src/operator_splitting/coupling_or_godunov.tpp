@@ -42,7 +42,7 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::start(this->logKeyTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTimeStepping1AdvanceTimeSpan_);
     }
 
     // advance simulation by time span
@@ -50,8 +50,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTimeStepping1AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer12_);
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTransfer12_);
     }
 
     // --------------- data transfer 1->2 -------------------------
@@ -76,8 +76,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer12_);
-      Control::PerformanceMeasurement::start(this->logKeyTimeStepping2AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::stop(this->timerTransfer12_);
+      Control::PerformanceMeasurement::start(this->timerTimeStepping2AdvanceTimeSpan_);
     }
 
     // --------------- time stepping 2, time span = [0,dt] -------------------------
@@ -91,8 +91,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTimeStepping2AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer21_);
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping2AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTransfer21_);
     }
 
     // --------------- data transfer 2->1 -------------------------
@@ -114,7 +114,7 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer21_);
+      Control::PerformanceMeasurement::stop(this->timerTransfer21_);
     }
 
     // advance simulation time
@@ -123,6 +123,9 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     // store the current simulation in case the program gets interrupted, then the last time gets logged
     Control::PerformanceMeasurement::setParameter("currentSimulationTime", std::to_string(currentTime));
+
+    // write a checkpoint if the interval has passed, only the outermost scheme has the complete state after its time step
+    this->writeCheckpointIfDue(currentTime);
   }
 
   // stop duration measurement
@@ -7,6 +7,7 @@
 #include "partition/rank_subset.h"
 #include "slot_connection/slot_connector_data_transfer.h"
 #include "data_management/operator_splitting.h"
+#include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OperatorSplitting
 {
@@ -76,6 +77,10 @@ protected:
   std::string logKeyTimeStepping2AdvanceTimeSpan_;  //< key for logging of the duration of the advanceTimeSpan() call of timeStepping2
   std::string logKeyTransfer12_;    //< key for logging of the duration of data transfer from timestepping 1 to 2
   std::string logKeyTransfer21_;    //< key for logging of the duration of data transfer from timestepping 2 to 1
+  Control::PerformanceMeasurement::TimerHandle timerTimeStepping1AdvanceTimeSpan_;  //< timer handle for logKeyTimeStepping1AdvanceTimeSpan_, resolved once in initialize
+  Control::PerformanceMeasurement::TimerHandle timerTimeStepping2AdvanceTimeSpan_;  //< timer handle for logKeyTimeStepping2AdvanceTimeSpan_
+  Control::PerformanceMeasurement::TimerHandle timerTransfer12_;    //< timer handle for logKeyTransfer12_
+  Control::PerformanceMeasurement::TimerHandle timerTransfer21_;    //< timer handle for logKeyTransfer21_
 
   std::shared_ptr<SlotsConnection> slotsConnection_; //< information regarding the mapping between the data slots of the two terms
 
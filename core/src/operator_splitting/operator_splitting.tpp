@@ -128,6 +128,12 @@ initialize()
   logKeyTransfer12_ = this->durationLogKey_ + std::string("_transfer12");  //< key for logging of the duration of data transfer from timestepping 1 to 2
   logKeyTransfer21_ = this->durationLogKey_ + std::string("_transfer21");  //< key for logging of the duration of data transfer from timestepping 2 to 1
 
+  // resolve the timer handles, these are used in every time step
+  timerTimeStepping1AdvanceTimeSpan_ = Control::PerformanceMeasurement::getTimerHandle(logKeyTimeStepping1AdvanceTimeSpan_);
+  timerTimeStepping2AdvanceTimeSpan_ = Control::PerformanceMeasurement::getTimerHandle(logKeyTimeStepping2AdvanceTimeSpan_);
+  timerTransfer12_ = Control::PerformanceMeasurement::getTimerHandle(logKeyTransfer12_);
+  timerTransfer21_ = Control::PerformanceMeasurement::getTimerHandle(logKeyTransfer21_);
+
   // add the slot connections that were given in the global field "connectedSlots" to the slotConnection_ object of this splitting scheme
   DihuContext::globalConnectionsBySlotName()->addConnections(this->data_.getSlotConnectorData(), slotsConnection_);
 
@@ -160,6 +166,9 @@ run()
   // initialize data structurures
   initialize();
 
+  // continue from the last checkpoint, if "restart" is set and this is the outermost solver
+  this->startCheckpointing();
+
 #ifdef HAVE_PAT
   PAT_record(PAT_STATE_ON);
   std::string label = "computation";
@@ -59,7 +59,7 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     // --------------- time stepping 1, time span = [0,midTime] -------------------------
     if (this->durationLogKey_ != "")
-      Control::PerformanceMeasurement::start(this->logKeyTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTimeStepping1AdvanceTimeSpan_);
 
     // set timespan for timestepping1
     this->timeStepping1_.setTimeSpan(currentTime, midTime);
@@ -71,8 +71,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTimeStepping1AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer12_);
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTransfer12_);
     }
 
     // --------------- data transfer 1->2 -------------------------
@@ -87,8 +87,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer12_);
-      Control::PerformanceMeasurement::start(this->logKeyTimeStepping2AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::stop(this->timerTransfer12_);
+      Control::PerformanceMeasurement::start(this->timerTimeStepping2AdvanceTimeSpan_);
     }
 
     // --------------- time stepping 2, time span = [0,dt] -------------------------
@@ -102,8 +102,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTimeStepping2AdvanceTimeSpan_);
-      Control::PerformanceMeasurement::start(this->logKeyTransfer21_);
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping2AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::start(this->timerTransfer21_);
     }
 
     // --------------- data transfer 2->1 -------------------------
@@ -118,8 +118,8 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTransfer21_);
-      Control::PerformanceMeasurement::start(this->logKeyTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::stop(this->timerTransfer21_);
+      Control::PerformanceMeasurement::start(this->timerTimeStepping1AdvanceTimeSpan_);
     }
 
     // --------------- time stepping 1, time span = [midTime,dt] -------------------------
@@ -132,7 +132,7 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     if (this->durationLogKey_ != "")
     {
-      Control::PerformanceMeasurement::stop(this->logKeyTimeStepping1AdvanceTimeSpan_);
+      Control::PerformanceMeasurement::stop(this->timerTimeStepping1AdvanceTimeSpan_);
     }
 
     /* option 1. (implemented)
@@ -164,6 +164,9 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     // store the current simulation in case the program gets interrupted, then the last time gets logged
     Control::PerformanceMeasurement::setParameter("currentSimulationTime", std::to_string(currentTime));
+
+    // write a checkpoint if the interval has passed, only the outermost scheme has the complete state after its time step
+    this->writeCheckpointIfDue(currentTime);
   }
 
   // stop duration measurement
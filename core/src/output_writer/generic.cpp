@@ -3,6 +3,8 @@
 #include <chrono>
 #include <thread>
 
+#include "control/checkpointing/checkpointing.h"
+
 namespace OutputWriter
 {
 
@@ -40,10 +42,32 @@ Generic::Generic(DihuContext context, PythonConfig specificSettings, std::shared
     fileNumbering_ = fileNumberingIncremental;
     LOG(ERROR) << "Unknown option for \"fileNumbering\": \"" <<fileNumbering<< "\". Use one of \"incremental\" or \"timeStepIndex\". Falling back to \"incremental\".";
   }
+
+  // store the counters in checkpoints, such that the file numbers continue after a restart
+  if (Control::Checkpointing::enabled())
+  {
+    Control::Checkpointing::SaveFunction save = [this](std::vector<double> &values)
+    {
+      values.push_back(writeCallCount_);
+      values.push_back(outputFileNo_);
+    };
+    Control::Checkpointing::RestoreFunction restore = [this](const std::vector<double> &values)
+    {
+      if (values.size() != 2)
+      {
+        LOG(FATAL) << "Checkpoint contains " << values.size() << " values for the counters of an output writer, but 2 are needed.";
+      }
+      writeCallCount_ = int(values[0]);
+      outputFileNo_ = int(values[1]);
+    };
+    std::string key = std::string("outputWriter/") + formatString_ + "/" + filenameBase_;
+    checkpointingHandle_ = Control::Checkpointing::registerState(key, save, restore, false);
+  }
 }
 
 Generic::~Generic()
 {
+  Control::Checkpointing::unregisterState(checkpointingHandle_);
 }
 
 void Generic::openFile(std::ofstream& file, std::string filename, bool append)
@@ -113,4 +137,9 @@ void Generic::setOutputFileNo(int outputFileNo)
   outputFileNo_ = outputFileNo;
 }
 
+int Generic::nCallsUntilNextWrite() const
+{
+  return outputInterval_ - writeCallCount_ % outputInterval_;
+}
+
 }  // namespace
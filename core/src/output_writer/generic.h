@@ -38,6 +38,9 @@ public:
   //! set the current output file no counter
   void setOutputFileNo(int outputFileNo);
 
+  //! get the number of calls to write, including the next one, that are needed until a file is written, according to outputInterval
+  int nCallsUntilNextWrite() const;
+
 protected:
 
   //! check if output should be written in this timestep and prepare filename, i.e. set filename_ from config
@@ -55,6 +58,7 @@ protected:
   int writeCallCount_ = 0;      //< counter of calls to write
   int outputFileNo_ = 0;        //< counter of calls to write when actually a file was written
   int outputInterval_ = 0;      //< the interval in which calls to write actually write data
+  int checkpointingHandle_ = -1;  //< handle of the counters registered in Control::Checkpointing, -1 if not registered
 
   std::shared_ptr<Partition::RankSubset> rankSubset_; //< the ranks that collectively call Paraview::write
 
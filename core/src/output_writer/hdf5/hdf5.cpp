@@ -0,0 +1,846 @@
+#include "output_writer/hdf5/hdf5.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+#include "easylogging++.h"
+#include "utility/python_utility.h"
+#include "utility/mpi_utility.h"
+#include "control/checkpointing/checkpointing.h"
+
+namespace OutputWriter
+{
+
+#ifdef HAVE_HDF5
+namespace
+{
+
+//! check the return value of a HDF5 function, negative values indicate an error
+template<typename T>
+T handleReturnValue(T returnValue, std::string functionName)
+{
+  if (returnValue < 0)
+  {
+    LOG(FATAL) << "HDF5 function " << functionName << " failed with return value " << returnValue << ".";
+  }
+  return returnValue;
+}
+
+//! the end of the XDMF file, the time steps are inserted in front of it
+const char *xdmfClosingTags = "    </Grid>\n  </Domain>\n</Xdmf>\n";
+
+//! replace characters that are not allowed in HDF5 object names
+std::string hdf5ObjectName(std::string name)
+{
+  std::replace(name.begin(), name.end(), '/', '_');
+  if (name.empty() || name == ".")
+    name = "_";
+  return name;
+}
+
+//! create an extendible, chunked dataset with dimensions nTimeSteps x nPointsGlobal x nComponents, one chunk contains chunkSize points of one time step
+hid_t createTimeSeriesDataset(hid_t group, std::string name, long long nPointsGlobal, int nComponents, long long chunkSize)
+{
+  hsize_t dimensions[3] = {0, (hsize_t)nPointsGlobal, (hsize_t)nComponents};
+  hsize_t maximumDimensions[3] = {H5S_UNLIMITED, (hsize_t)nPointsGlobal, (hsize_t)nComponents};
+  hsize_t chunkDimensions[3] = {1, (hsize_t)std::max(1LL, std::min(chunkSize, nPointsGlobal)), (hsize_t)nComponents};
+
+  hid_t dataSpace = handleReturnValue(H5Screate_simple(3, dimensions, maximumDimensions), "H5Screate_simple");
+  hid_t creationPropertyList = handleReturnValue(H5Pcreate(H5P_DATASET_CREATE), "H5Pcreate");
+  handleReturnValue(H5Pset_chunk(creationPropertyList, 3, chunkDimensions), "H5Pset_chunk");
+
+  hid_t dataset = handleReturnValue(H5Dcreate2(group, hdf5ObjectName(name).c_str(), H5T_NATIVE_DOUBLE, dataSpace,
+                                               H5P_DEFAULT, creationPropertyList, H5P_DEFAULT), "H5Dcreate2");
+  H5Pclose(creationPropertyList);
+  H5Sclose(dataSpace);
+  return dataset;
+}
+
+//! open the dataset if it exists in a file that is continued after a restart, otherwise create it, nEntries is set to the size of the time dimension
+hid_t openOrCreateTimeSeriesDataset(hid_t group, std::string name, long long nPointsGlobal, int nComponents, long long chunkSize, long long &nEntries)
+{
+  nEntries = 0;
+  if (handleReturnValue(H5Lexists(group, hdf5ObjectName(name).c_str(), H5P_DEFAULT), "H5Lexists") == 0)
+    return createTimeSeriesDataset(group, name, nPointsGlobal, nComponents, chunkSize);
+
+  hid_t dataset = handleReturnValue(H5Dopen2(group, hdf5ObjectName(name).c_str(), H5P_DEFAULT), "H5Dopen2");
+  hid_t dataSpace = handleReturnValue(H5Dget_space(dataset), "H5Dget_space");
+
+  hsize_t dimensions[3] = {0, 0, 0};
+  if (H5Sget_simple_extent_ndims(dataSpace) != 3
+    || handleReturnValue(H5Sget_simple_extent_dims(dataSpace, dimensions, NULL), "H5Sget_simple_extent_dims") != 3
+    || dimensions[1] != (hsize_t)nPointsGlobal || dimensions[2] != (hsize_t)nComponents)
+  {
+    LOG(FATAL) << "HDF5 writer: the existing dataset \"" << name << "\" has dimensions " << dimensions[0] << " x " << dimensions[1] << " x " << dimensions[2]
+      << ", but " << nPointsGlobal << " points with " << nComponents << " components are needed. "
+      << "The file cannot be continued after the restart, the mesh or the partitioning has changed.";
+  }
+  H5Sclose(dataSpace);
+
+  nEntries = dimensions[0];
+  return dataset;
+}
+
+//! open the group if it exists in a file that is continued after a restart, otherwise create it
+hid_t openOrCreateGroup(hid_t parent, std::string name)
+{
+  if (handleReturnValue(H5Lexists(parent, name.c_str(), H5P_DEFAULT), "H5Lexists") == 0)
+    return handleReturnValue(H5Gcreate2(parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), "H5Gcreate2");
+
+  return handleReturnValue(H5Gopen2(parent, name.c_str(), H5P_DEFAULT), "H5Gopen2");
+}
+
+//! escape the characters that are not allowed in XML attribute values and text
+std::string xmlEscape(const std::string &text)
+{
+  std::string result;
+  result.reserve(text.size());
+  for (char character : text)
+  {
+    switch (character)
+    {
+    case '&':
+      result += "&amp;";
+      break;
+    case '<':
+      result += "&lt;";
+      break;
+    case '>':
+      result += "&gt;";
+      break;
+    case '"':
+      result += "&quot;";
+      break;
+    case '\'':
+      result += "&apos;";
+      break;
+    default:
+      result += character;
+    }
+  }
+  return result;
+}
+
+//! get the path of the group of a mesh as it is referenced in the XDMF file, the HDF5 file is referenced relative to the XDMF file
+std::string xdmfGroupPath(std::string hdf5Filename, std::string meshName)
+{
+  if (hdf5Filename.rfind("/") != std::string::npos)
+    hdf5Filename = hdf5Filename.substr(hdf5Filename.rfind("/")+1);
+
+  return hdf5Filename + ":/" + hdf5ObjectName(meshName);
+}
+
+//! get the HyperSlab DataItem of the XDMF file that selects the given entry of a dataset with dimensions extent x nPoints x nComponents
+std::string xdmfHyperSlab(std::string hdf5Path, long long entryNo, long long extent, long long nPoints, int nComponents, int indentation)
+{
+  std::stringstream result;
+  std::string indent(indentation, ' ');
+  result << indent << "<DataItem ItemType=\"HyperSlab\" Dimensions=\"" << nPoints << " " << nComponents << "\" Type=\"HyperSlab\">\n"
+    << indent << "  <DataItem Dimensions=\"3 3\" Format=\"XML\">" << entryNo << " 0 0 1 1 1 1 " << nPoints << " " << nComponents << "</DataItem>\n"
+    << indent << "  <DataItem Dimensions=\"" << extent << " " << nPoints << " " << nComponents << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+    << xmlEscape(hdf5Path) << "</DataItem>\n"
+    << indent << "</DataItem>\n";
+  return result.str();
+}
+
+//! in the XDMF file contents, replace the size of the time dimension of the HDF DataItems by the given extents, the key is the escaped path of the dataset
+std::string replaceXdmfDatasetExtents(const std::string &xdmf, const std::map<std::string,long long> &extents)
+{
+  const std::string dimensionsBegin = "<DataItem Dimensions=\"";
+  const std::string hdfFormat = "Format=\"HDF\">";
+  const std::string dataItemEnd = "</DataItem>";
+
+  std::string result;
+  result.reserve(xdmf.size());
+  std::size_t position = 0;
+  for (std::size_t formatPosition = xdmf.find(hdfFormat); formatPosition != std::string::npos; formatPosition = xdmf.find(hdfFormat, formatPosition+1))
+  {
+    std::size_t pathBegin = formatPosition + hdfFormat.size();
+    std::size_t pathEnd = xdmf.find(dataItemEnd, pathBegin);
+    std::size_t extentBegin = xdmf.rfind(dimensionsBegin, formatPosition);
+    if (pathEnd == std::string::npos || extentBegin == std::string::npos || extentBegin < position)
+      continue;
+    extentBegin += dimensionsBegin.size();
+    std::size_t extentEnd = xdmf.find(' ', extentBegin);
+
+    std::map<std::string,long long>::const_iterator extent = extents.find(xdmf.substr(pathBegin, pathEnd-pathBegin));
+    if (extent == extents.end() || extentEnd == std::string::npos || extentEnd > formatPosition)
+      continue;
+
+    result.append(xdmf, position, extentBegin-position);
+    result += std::to_string(extent->second);
+    position = extentEnd;
+  }
+  result.append(xdmf, position, std::string::npos);
+  return result;
+}
+
+}  // anonymous namespace
+#endif
+
+HDF5::HDF5(DihuContext context, PythonConfig settings, std::shared_ptr<Partition::RankSubset> rankSubset) :
+  Generic(context, settings, rankSubset)
+{
+#ifdef HAVE_HDF5
+  fileId_ = -1;
+  transferPropertyList_ = -1;
+  timeDataset_ = -1;
+  timeDatasetExtent_ = 0;
+  nTimeStepsWritten_ = 0;
+  nTimeStepsWrittenRestored_ = false;
+  timeStepsCheckpointingHandle_ = -1;
+  chunkSize_ = settings.getOptionInt("chunkSize", 65536, PythonUtility::Positive);
+  deltaOutput_ = settings.getOptionBool("deltaOutput", false);
+  deltaTolerance_ = settings.getOptionDouble("deltaTolerance", 0.0, PythonUtility::NonNegative);
+
+  // store the number of written time steps in checkpoints, such that a restarted simulation continues the file after the time step of the checkpoint
+  if (Control::Checkpointing::enabled())
+  {
+    Control::Checkpointing::SaveFunction save = [this](std::vector<double> &values)
+    {
+      values.push_back(nTimeStepsWritten_);
+    };
+    Control::Checkpointing::RestoreFunction restore = [this](const std::vector<double> &values)
+    {
+      if (values.size() != 1)
+      {
+        LOG(FATAL) << "Checkpoint contains " << values.size() << " values for the number of time steps of the HDF5 output writer, but 1 is needed.";
+      }
+      nTimeStepsWritten_ = (long long)values[0];
+      nTimeStepsWrittenRestored_ = true;
+
+      // the file was already opened by the output of the initial values, remove the time steps of the aborted run after the checkpoint
+      if (xdmfFile_.is_open())
+        truncateXdmfTimeSteps(nTimeStepsWritten_);
+    };
+    std::string key = std::string("outputWriter/HDF5/") + this->filenameBase_ + "/timeSteps";
+    timeStepsCheckpointingHandle_ = Control::Checkpointing::registerState(key, save, restore, false);
+  }
+#else
+  LOG(ERROR) << settings.getStringPath() << ": Not compiled with HDF5, but a \"HDF5\" output writer was specified. No output will be written.";
+#endif
+}
+
+HDF5::~HDF5()
+{
+#ifdef HAVE_HDF5
+  Control::Checkpointing::unregisterState(timeStepsCheckpointingHandle_);
+
+  if (fileId_ < 0)
+    return;
+
+  // in a file that was continued after a restart, remove the entries of the aborted run that were not overwritten,
+  // without deltaOutput_ the entries correspond to the time steps
+  for (std::pair<const std::string,MeshDatasets> &mesh : meshes_)
+  {
+    std::vector<FieldVariableDataset *> datasets({&mesh.second.geometryDataset});
+    for (std::pair<const std::string,FieldVariableDataset> &fieldVariableDataset : mesh.second.fieldVariableDatasets)
+      datasets.push_back(&fieldVariableDataset.second);
+
+    for (FieldVariableDataset *dataset : datasets)
+    {
+      long long nEntries = (deltaOutput_? dataset->nEntries : nTimeStepsWritten_);
+      if (dataset->extent > nEntries)
+      {
+        hsize_t dimensions[3] = {(hsize_t)nEntries, (hsize_t)mesh.second.nPointsGlobal, (hsize_t)dataset->nComponents};
+        handleReturnValue(H5Dset_extent(dataset->dataset, dimensions), "H5Dset_extent");
+        dataset->extent = nEntries;
+      }
+    }
+  }
+  if (timeDatasetExtent_ > nTimeStepsWritten_)
+  {
+    hsize_t dimensions[1] = {(hsize_t)nTimeStepsWritten_};
+    handleReturnValue(H5Dset_extent(timeDataset_, dimensions), "H5Dset_extent");
+  }
+  if (xdmfFile_.is_open() && nTimeStepsWritten_ < (long long)xdmfTimeStepPositions_.size())
+    truncateXdmfTimeSteps(nTimeStepsWritten_);
+
+  // close all objects, the file is closed collectively by all ranks
+  for (std::pair<const std::string,MeshDatasets> &mesh : meshes_)
+  {
+    for (std::pair<const std::string,FieldVariableDataset> &fieldVariableDataset : mesh.second.fieldVariableDatasets)
+    {
+      H5Dclose(fieldVariableDataset.second.dataset);
+    }
+    H5Dclose(mesh.second.geometryDataset.dataset);
+    H5Gclose(mesh.second.fieldsGroup);
+    H5Gclose(mesh.second.group);
+  }
+  H5Dclose(timeDataset_);
+  H5Pclose(transferPropertyList_);
+  H5Fclose(fileId_);
+
+  // the time steps in the XDMF file were written with the extents of the datasets at that time
+  if (xdmfFile_.is_open())
+  {
+    xdmfFile_.close();
+    updateXdmfDatasetExtents();
+  }
+#endif
+}
+
+#ifdef HAVE_HDF5
+
+void HDF5::openFiles()
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+  const int ownRankNo = this->rankSubset_->ownRankNo();
+
+  hdf5Filename_ = this->filenameBase_ + ".h5";
+  xdmfFilename_ = this->filenameBase_ + ".xdmf";
+
+  // after a restart from a checkpoint, the files of the aborted run are continued if both exist,
+  // rank 0 decides and creates the directory and the XDMF file otherwise, the other ranks wait until the directory exists
+  int continueFiles = 0;
+  if (ownRankNo == 0)
+  {
+    if (Control::Checkpointing::isRestart() && std::ifstream(hdf5Filename_.c_str()).good())
+    {
+      continueFiles = (openExistingXdmfFile()? 1 : 0);
+    }
+    if (!continueFiles)
+    {
+      if (Control::Checkpointing::isRestart())
+      {
+        LOG(WARNING) << "HDF5 writer: The files \"" << hdf5Filename_ << "\" and \"" << xdmfFilename_ << "\" of the previous run "
+          << "cannot be continued after the restart, they are created again.";
+      }
+      Generic::openFile(xdmfFile_, xdmfFilename_);
+    }
+  }
+  MPIUtility::handleReturnValue(MPI_Bcast(&continueFiles, 1, MPI_INT, 0, mpiCommunicator), "MPI_Bcast");
+
+  // create the file with the MPI-IO driver
+  hid_t fileAccessPropertyList = handleReturnValue(H5Pcreate(H5P_FILE_ACCESS), "H5Pcreate");
+#ifdef H5_HAVE_PARALLEL
+  handleReturnValue(H5Pset_fapl_mpio(fileAccessPropertyList, mpiCommunicator, MPI_INFO_NULL), "H5Pset_fapl_mpio");
+#else
+  if (this->rankSubset_->size() > 1)
+  {
+    LOG(FATAL) << "The HDF5 library was compiled without parallel support, the \"HDF5\" output writer can only be used with one rank.";
+  }
+#endif
+
+  if (continueFiles)
+  {
+    fileId_ = handleReturnValue(H5Fopen(hdf5Filename_.c_str(), H5F_ACC_RDWR, fileAccessPropertyList), "H5Fopen");
+  }
+  else
+  {
+    fileId_ = handleReturnValue(H5Fcreate(hdf5Filename_.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileAccessPropertyList), "H5Fcreate");
+  }
+  H5Pclose(fileAccessPropertyList);
+
+  // all writes of values are collective operations
+  transferPropertyList_ = handleReturnValue(H5Pcreate(H5P_DATASET_XFER), "H5Pcreate");
+#ifdef H5_HAVE_PARALLEL
+  handleReturnValue(H5Pset_dxpl_mpio(transferPropertyList_, H5FD_MPIO_COLLECTIVE), "H5Pset_dxpl_mpio");
+#endif
+
+  if (continueFiles)
+  {
+    // open the dataset of the simulation times, the time steps in the XDMF file correspond to its entries
+    timeDataset_ = handleReturnValue(H5Dopen2(fileId_, "time", H5P_DEFAULT), "H5Dopen2");
+
+    hid_t dataSpace = handleReturnValue(H5Dget_space(timeDataset_), "H5Dget_space");
+    hsize_t dimensions[1] = {0};
+    handleReturnValue(H5Sget_simple_extent_dims(dataSpace, dimensions, NULL), "H5Sget_simple_extent_dims");
+    H5Sclose(dataSpace);
+    timeDatasetExtent_ = dimensions[0];
+
+    // if the number of time steps was already restored, remove the later time steps from the XDMF file
+    if (ownRankNo == 0 && nTimeStepsWrittenRestored_)
+      truncateXdmfTimeSteps(nTimeStepsWritten_);
+
+    LOG(DEBUG) << "HDF5 writer continues file \"" << hdf5Filename_ << "\" with " << timeDatasetExtent_ << " time steps.";
+    return;
+  }
+
+  // create the extendible dataset of the simulation times
+  hsize_t dimensions[1] = {0};
+  hsize_t maximumDimensions[1] = {H5S_UNLIMITED};
+  hsize_t chunkDimensions[1] = {1024};
+
+  hid_t dataSpace = handleReturnValue(H5Screate_simple(1, dimensions, maximumDimensions), "H5Screate_simple");
+  hid_t creationPropertyList = handleReturnValue(H5Pcreate(H5P_DATASET_CREATE), "H5Pcreate");
+  handleReturnValue(H5Pset_chunk(creationPropertyList, 1, chunkDimensions), "H5Pset_chunk");
+
+  timeDataset_ = handleReturnValue(H5Dcreate2(fileId_, "time", H5T_NATIVE_DOUBLE, dataSpace, H5P_DEFAULT, creationPropertyList, H5P_DEFAULT), "H5Dcreate2");
+  H5Pclose(creationPropertyList);
+  H5Sclose(dataSpace);
+
+  // write the beginning of the XDMF file, the time steps are appended in front of the closing tags
+  if (ownRankNo == 0)
+  {
+    xdmfFile_ << "<?xml version=\"1.0\" ?>\n"
+      << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n"
+      << "<Xdmf Version=\"3.0\">\n"
+      << "  <Domain>\n"
+      << "    <Grid Name=\"TimeSeries\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+    xdmfClosingTagsPosition_ = xdmfFile_.tellp();
+    xdmfFile_ << xdmfClosingTags;
+    xdmfFile_.flush();
+  }
+
+  LOG(DEBUG) << "HDF5 writer opened file \"" << hdf5Filename_ << "\".";
+}
+
+bool HDF5::openExistingXdmfFile()
+{
+  std::ifstream file(xdmfFilename_.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+  const std::string xdmf = contents.str();
+
+  // the time steps are the grids with an indentation of 6 in front of the closing tags
+  std::size_t closingTagsPosition = xdmf.rfind(xdmfClosingTags);
+  if (closingTagsPosition == std::string::npos)
+    return false;
+
+  const std::string timeStepBegin = "\n      <Grid Name=\"";
+  xdmfTimeStepPositions_.clear();
+  for (std::size_t position = xdmf.find(timeStepBegin); position != std::string::npos && position < closingTagsPosition;
+       position = xdmf.find(timeStepBegin, position+1))
+  {
+    xdmfTimeStepPositions_.push_back(position+1);
+  }
+  xdmfClosingTagsPosition_ = closingTagsPosition;
+
+  xdmfFile_.open(xdmfFilename_.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+  return xdmfFile_.is_open();
+}
+
+void HDF5::truncateXdmfTimeSteps(long long nTimeSteps)
+{
+  if (nTimeSteps > (long long)xdmfTimeStepPositions_.size())
+  {
+    LOG(WARNING) << "HDF5 writer: The file \"" << xdmfFilename_ << "\" contains " << xdmfTimeStepPositions_.size() << " time steps, "
+      << "but " << nTimeSteps << " time steps were written before the checkpoint. The missing time steps are not listed.";
+  }
+  if (nTimeSteps >= (long long)xdmfTimeStepPositions_.size())
+    return;
+
+  // write the closing tags after the last kept time step and cut off the rest of the file
+  xdmfClosingTagsPosition_ = xdmfTimeStepPositions_[nTimeSteps];
+  xdmfTimeStepPositions_.resize(nTimeSteps);
+
+  xdmfFile_.seekp(xdmfClosingTagsPosition_);
+  xdmfFile_ << xdmfClosingTags;
+  xdmfFile_.flush();
+
+  if (truncate(xdmfFilename_.c_str(), xdmfFile_.tellp()) != 0)
+  {
+    LOG(ERROR) << "Could not truncate XDMF file \"" << xdmfFilename_ << "\".";
+  }
+}
+
+void HDF5::initializeMesh(const std::string &meshName, const PolyDataPropertiesForMesh &properties,
+                          const std::vector<global_no_t> &nodeNosGlobalPetsc, node_no_t nNodesLocalWithoutGhosts)
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+
+  MeshDatasets &mesh = meshes_[meshName];
+  mesh.dimensionality = properties.dimensionality;
+  mesh.nNodesPerCell = 1 << properties.dimensionality;
+
+  // every rank writes its own nodes, they are numbered contiguously in the global PETSc numbering
+  mesh.nPointsLocalWithGhosts = properties.nPointsLocal;
+  mesh.nPointsLocal = nNodesLocalWithoutGhosts;
+  mesh.pointOffset = 0;
+  mesh.nPointsGlobal = 0;
+  MPIUtility::handleReturnValue(MPI_Exscan(&mesh.nPointsLocal, &mesh.pointOffset, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Allreduce(&mesh.nPointsLocal, &mesh.nPointsGlobal, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+
+  // MPI_Exscan leaves the result on rank 0 undefined
+  if (this->rankSubset_->ownRankNo() == 0)
+    mesh.pointOffset = 0;
+
+  if ((long long)nodeNosGlobalPetsc.size() != mesh.nPointsLocalWithGhosts)
+  {
+    LOG(FATAL) << "HDF5 writer: mesh \"" << meshName << "\" has " << mesh.nPointsLocalWithGhosts << " local points, "
+      << "but the global numbers of " << nodeNosGlobalPetsc.size() << " points are given.";
+  }
+
+  // determine the local point of every own global node, the other points are ghosts
+  mesh.ownedPointNos.assign(mesh.nPointsLocal, -1);
+  long long nOwnedPointsFound = 0;
+  for (long long pointNo = 0; pointNo < mesh.nPointsLocalWithGhosts; pointNo++)
+  {
+    long long ownedPointNo = (long long)nodeNosGlobalPetsc[pointNo] - mesh.pointOffset;
+    if (ownedPointNo >= 0 && ownedPointNo < mesh.nPointsLocal && mesh.ownedPointNos[ownedPointNo] == -1)
+    {
+      mesh.ownedPointNos[ownedPointNo] = pointNo;
+      nOwnedPointsFound++;
+    }
+  }
+  if (nOwnedPointsFound != mesh.nPointsLocal)
+  {
+    LOG(FATAL) << "HDF5 writer: the global numbers of the " << mesh.nPointsLocal << " own nodes of mesh \"" << meshName << "\" "
+      << "are not the range [" << mesh.pointOffset << "," << mesh.pointOffset + mesh.nPointsLocal << "), only " << nOwnedPointsFound << " nodes were found. "
+      << "The mesh has to be partitioned with a contiguous global numbering of the nodes of every rank.";
+  }
+
+  // the connectivity of structured meshes is created from the number of local nodes in every coordinate direction,
+  // for unstructured meshes the connectivity values are given by the mesh. The local point numbers are then transformed to the global numbers
+  std::vector<long long> connectivityValues;
+  const std::vector<node_no_t> &nNodesLocalWithGhosts = properties.nNodesLocalWithGhosts;
+
+  if (!properties.unstructuredMeshConnectivityValues.empty())
+  {
+    connectivityValues.assign(properties.unstructuredMeshConnectivityValues.begin(), properties.unstructuredMeshConnectivityValues.end());
+  }
+  else if (mesh.dimensionality == 1)
+  {
+    for (long long indexX = 0; indexX < (long long)nNodesLocalWithGhosts[0]-1; indexX++)
+    {
+      connectivityValues.push_back(indexX);
+      connectivityValues.push_back(indexX + 1);
+    }
+  }
+  else if (mesh.dimensionality == 2)
+  {
+    const long long nNodesX = nNodesLocalWithGhosts[0];
+    for (long long indexY = 0; indexY < (long long)nNodesLocalWithGhosts[1]-1; indexY++)
+    {
+      for (long long indexX = 0; indexX < nNodesX-1; indexX++)
+      {
+        long long pointNo = indexY*nNodesX + indexX;
+        connectivityValues.insert(connectivityValues.end(), {
+          pointNo, pointNo + 1, pointNo + nNodesX + 1, pointNo + nNodesX
+        });
+      }
+    }
+  }
+  else if (mesh.dimensionality == 3)
+  {
+    const long long nNodesX = nNodesLocalWithGhosts[0];
+    const long long nNodesPlane = nNodesX*nNodesLocalWithGhosts[1];
+    for (long long indexZ = 0; indexZ < (long long)nNodesLocalWithGhosts[2]-1; indexZ++)
+    {
+      for (long long indexY = 0; indexY < (long long)nNodesLocalWithGhosts[1]-1; indexY++)
+      {
+        for (long long indexX = 0; indexX < nNodesX-1; indexX++)
+        {
+          long long pointNo = indexZ*nNodesPlane + indexY*nNodesX + indexX;
+          connectivityValues.insert(connectivityValues.end(), {
+            pointNo, pointNo + 1, pointNo + nNodesX + 1, pointNo + nNodesX,
+            pointNo + nNodesPlane, pointNo + nNodesPlane + 1, pointNo + nNodesPlane + nNodesX + 1, pointNo + nNodesPlane + nNodesX
+          });
+        }
+      }
+    }
+  }
+
+  for (long long &value : connectivityValues)
+  {
+    value = nodeNosGlobalPetsc[value];
+  }
+
+  long long nCellsLocal = connectivityValues.size() / mesh.nNodesPerCell;
+  long long cellOffset = 0;
+  mesh.nCellsGlobal = 0;
+  MPIUtility::handleReturnValue(MPI_Exscan(&nCellsLocal, &cellOffset, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Allreduce(&nCellsLocal, &mesh.nCellsGlobal, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+  if (this->rankSubset_->ownRankNo() == 0)
+    cellOffset = 0;
+
+  // create the groups of the mesh, in a file that is continued after a restart they already exist
+  std::string groupName = hdf5ObjectName(meshName);
+  mesh.group = openOrCreateGroup(fileId_, groupName);
+  mesh.fieldsGroup = openOrCreateGroup(mesh.group, "fields");
+
+  // write the connectivity, it does not change over time
+  hsize_t dimensions[2] = {(hsize_t)mesh.nCellsGlobal, (hsize_t)mesh.nNodesPerCell};
+  hsize_t start[2] = {(hsize_t)cellOffset, 0};
+  hsize_t count[2] = {(hsize_t)nCellsLocal, (hsize_t)mesh.nNodesPerCell};
+
+  hid_t fileSpace = handleReturnValue(H5Screate_simple(2, dimensions, NULL), "H5Screate_simple");
+  hid_t connectivityDataset = -1;
+  if (handleReturnValue(H5Lexists(mesh.group, "connectivity", H5P_DEFAULT), "H5Lexists") > 0)
+  {
+    connectivityDataset = handleReturnValue(H5Dopen2(mesh.group, "connectivity", H5P_DEFAULT), "H5Dopen2");
+
+    hid_t existingFileSpace = handleReturnValue(H5Dget_space(connectivityDataset), "H5Dget_space");
+    hsize_t existingDimensions[2] = {0, 0};
+    if (H5Sget_simple_extent_ndims(existingFileSpace) != 2
+      || handleReturnValue(H5Sget_simple_extent_dims(existingFileSpace, existingDimensions, NULL), "H5Sget_simple_extent_dims") != 2
+      || existingDimensions[0] != dimensions[0] || existingDimensions[1] != dimensions[1])
+    {
+      LOG(FATAL) << "HDF5 writer: the existing connectivity of mesh \"" << meshName << "\" has " << existingDimensions[0] << " cells, "
+        << "but " << mesh.nCellsGlobal << " are needed. The file cannot be continued after the restart, the mesh or the partitioning has changed.";
+    }
+    H5Sclose(existingFileSpace);
+  }
+  else
+  {
+    connectivityDataset = handleReturnValue(H5Dcreate2(mesh.group, "connectivity", H5T_NATIVE_LLONG, fileSpace,
+                                                       H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT), "H5Dcreate2");
+  }
+  hid_t memorySpace = handleReturnValue(H5Screate_simple(2, count, NULL), "H5Screate_simple");
+
+  if (nCellsLocal > 0)
+  {
+    handleReturnValue(H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, NULL, count, NULL), "H5Sselect_hyperslab");
+  }
+  else
+  {
+    H5Sselect_none(fileSpace);
+    H5Sselect_none(memorySpace);
+  }
+
+  handleReturnValue(H5Dwrite(connectivityDataset, H5T_NATIVE_LLONG, memorySpace, fileSpace, transferPropertyList_, connectivityValues.data()), "H5Dwrite");
+
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+  H5Dclose(connectivityDataset);
+
+  // create the geometry dataset, it is written at every time step to support deforming meshes, for deltaOutput_ only when it changed
+  mesh.geometryDataset.nComponents = 3;
+  mesh.geometryDataset.currentEntry = 0;
+  mesh.geometryDataset.dataset = openOrCreateTimeSeriesDataset(mesh.group, "geometry", mesh.nPointsGlobal, 3, chunkSize_, mesh.geometryDataset.extent);
+  mesh.geometryDataset.nEntries = mesh.geometryDataset.extent;
+
+  LOG(DEBUG) << "HDF5 writer: initialized mesh \"" << meshName << "\", nPointsGlobal: " << mesh.nPointsGlobal << ", nCellsGlobal: " << mesh.nCellsGlobal;
+}
+
+HDF5::FieldVariableDataset &HDF5::getFieldVariableDataset(MeshDatasets &mesh, const std::string &fieldVariableName, int nComponents)
+{
+  std::map<std::string,FieldVariableDataset>::iterator iter = mesh.fieldVariableDatasets.find(fieldVariableName);
+  if (iter != mesh.fieldVariableDatasets.end())
+    return iter->second;
+
+  FieldVariableDataset &fieldVariableDataset = mesh.fieldVariableDatasets[fieldVariableName];
+  fieldVariableDataset.nComponents = nComponents;
+  fieldVariableDataset.currentEntry = 0;
+  fieldVariableDataset.dataset = openOrCreateTimeSeriesDataset(mesh.fieldsGroup, fieldVariableName, mesh.nPointsGlobal, nComponents, chunkSize_,
+                                                               fieldVariableDataset.extent);
+
+  // for deltaOutput_, new entries are appended after the entries of a file that is continued after a restart
+  fieldVariableDataset.nEntries = fieldVariableDataset.extent;
+
+  return fieldVariableDataset;
+}
+
+void HDF5::appendValues(const MeshDatasets &mesh, FieldVariableDataset &fieldVariableDataset, std::vector<double> &values)
+{
+  const int nComponents = fieldVariableDataset.nComponents;
+  hid_t dataset = fieldVariableDataset.dataset;
+
+  if (values.size() != mesh.nPointsLocalWithGhosts*nComponents)
+  {
+    LOG(ERROR) << "HDF5 writer: field variable has " << values.size() << " local values, expected " << mesh.nPointsLocalWithGhosts << "x" << nComponents << ".";
+    values.resize(mesh.nPointsLocalWithGhosts*nComponents, 0.0);
+  }
+
+  // extract the values of the own points in the global order, the ghost values are written by their owning ranks
+  std::vector<double> ownedValues(mesh.nPointsLocal*nComponents);
+  for (long long ownedPointNo = 0; ownedPointNo < mesh.nPointsLocal; ownedPointNo++)
+  {
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      ownedValues[ownedPointNo*nComponents + componentNo] = values[mesh.ownedPointNos[ownedPointNo]*nComponents + componentNo];
+    }
+  }
+
+  // without deltaOutput_, the entries of the dataset correspond to the time steps
+  long long entryNo = nTimeStepsWritten_;
+  if (deltaOutput_)
+  {
+    // keep referring to the last written entry if no rank has changed values
+    if (fieldVariableDataset.nEntries > 0 && !valuesChanged(fieldVariableDataset, ownedValues))
+    {
+      return;
+    }
+    entryNo = fieldVariableDataset.nEntries;
+    fieldVariableDataset.lastWrittenValues = ownedValues;
+  }
+  fieldVariableDataset.nEntries = entryNo+1;
+  fieldVariableDataset.currentEntry = entryNo;
+
+  // extend the dataset by the new entry, this is a collective operation.
+  // The dataset is never shrunk here, such that the entries of a continued file are kept until they are overwritten
+  if (entryNo+1 > fieldVariableDataset.extent)
+  {
+    fieldVariableDataset.extent = entryNo+1;
+    hsize_t dimensions[3] = {(hsize_t)fieldVariableDataset.extent, (hsize_t)mesh.nPointsGlobal, (hsize_t)nComponents};
+    handleReturnValue(H5Dset_extent(dataset, dimensions), "H5Dset_extent");
+  }
+
+  // select the local points in the new entry
+  hsize_t start[3] = {(hsize_t)entryNo, (hsize_t)mesh.pointOffset, 0};
+  hsize_t count[3] = {1, (hsize_t)mesh.nPointsLocal, (hsize_t)nComponents};
+
+  hid_t fileSpace = handleReturnValue(H5Dget_space(dataset), "H5Dget_space");
+  hid_t memorySpace = handleReturnValue(H5Screate_simple(3, count, NULL), "H5Screate_simple");
+
+  if (mesh.nPointsLocal > 0)
+  {
+    handleReturnValue(H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, NULL, count, NULL), "H5Sselect_hyperslab");
+  }
+  else
+  {
+    H5Sselect_none(fileSpace);
+    H5Sselect_none(memorySpace);
+  }
+
+  handleReturnValue(H5Dwrite(dataset, H5T_NATIVE_DOUBLE, memorySpace, fileSpace, transferPropertyList_, ownedValues.data()), "H5Dwrite");
+
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+}
+
+bool HDF5::valuesChanged(const FieldVariableDataset &dataset, const std::vector<double> &values)
+{
+  int valuesChangedOnOwnRank = (values.size() != dataset.lastWrittenValues.size()? 1 : 0);
+  for (std::size_t i = 0; !valuesChangedOnOwnRank && i < values.size(); i++)
+  {
+    if (fabs(values[i] - dataset.lastWrittenValues[i]) > deltaTolerance_)
+      valuesChangedOnOwnRank = 1;
+  }
+
+  // the dataset is extended collectively, therefore all ranks have to take the same decision
+  int valuesChangedOnAnyRank = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&valuesChangedOnOwnRank, &valuesChangedOnAnyRank, 1, MPI_INT, MPI_MAX,
+                                              this->rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+  return valuesChangedOnAnyRank != 0;
+}
+
+void HDF5::appendTime(double currentTime)
+{
+  if (nTimeStepsWritten_+1 > timeDatasetExtent_)
+  {
+    timeDatasetExtent_ = nTimeStepsWritten_+1;
+    hsize_t dimensions[1] = {(hsize_t)timeDatasetExtent_};
+    handleReturnValue(H5Dset_extent(timeDataset_, dimensions), "H5Dset_extent");
+  }
+
+  // only rank 0 writes the value, but all ranks participate in the collective write
+  hsize_t start[1] = {(hsize_t)nTimeStepsWritten_};
+  hsize_t count[1] = {1};
+
+  hid_t fileSpace = handleReturnValue(H5Dget_space(timeDataset_), "H5Dget_space");
+  hid_t memorySpace = handleReturnValue(H5Screate_simple(1, count, NULL), "H5Screate_simple");
+
+  if (this->rankSubset_->ownRankNo() == 0)
+  {
+    handleReturnValue(H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, NULL, count, NULL), "H5Sselect_hyperslab");
+  }
+  else
+  {
+    H5Sselect_none(fileSpace);
+    H5Sselect_none(memorySpace);
+  }
+
+  handleReturnValue(H5Dwrite(timeDataset_, H5T_NATIVE_DOUBLE, memorySpace, fileSpace, transferPropertyList_, &currentTime), "H5Dwrite");
+
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+}
+
+void HDF5::appendXdmfTimeStep(double currentTime)
+{
+  // in a file that is continued after a restart, the time steps before the checkpoint are already listed.
+  // This is the case for the output of the initial values, before the number of written time steps is restored
+  if (nTimeStepsWritten_ < (long long)xdmfTimeStepPositions_.size())
+    return;
+
+  std::stringstream xdmf;
+  xdmf << "      <Grid Name=\"" << nTimeStepsWritten_ << "\" GridType=\"Collection\" CollectionType=\"Spatial\">\n"
+    << "        <Time Value=\"" << std::setprecision(16) << currentTime << "\"/>\n";
+
+  const std::map<int,std::string> topologyTypes = {{1, "Polyline"}, {2, "Quadrilateral"}, {3, "Hexahedron"}};
+
+  for (const std::string &meshName : meshNamesCurrentTimeStep_)
+  {
+    const MeshDatasets &mesh = meshes_.at(meshName);
+    std::string groupPath = xdmfGroupPath(hdf5Filename_, meshName);
+
+    xdmf << "        <Grid Name=\"" << xmlEscape(meshName) << "\" GridType=\"Uniform\">\n"
+      << "          <Topology TopologyType=\"" << topologyTypes.at(mesh.dimensionality) << "\"";
+
+    // the number of nodes per element has to be given for polylines
+    if (mesh.dimensionality == 1)
+      xdmf << " NodesPerElement=\"" << mesh.nNodesPerCell << "\"";
+
+    xdmf << " NumberOfElements=\"" << mesh.nCellsGlobal << "\">\n"
+      << "            <DataItem Dimensions=\"" << mesh.nCellsGlobal << " " << mesh.nNodesPerCell << "\" NumberType=\"Int\" Precision=\"8\" Format=\"HDF\">"
+      << xmlEscape(groupPath) << "/connectivity</DataItem>\n"
+      << "          </Topology>\n"
+      << "          <Geometry GeometryType=\"XYZ\">\n"
+      << xdmfHyperSlab(groupPath + "/geometry", mesh.geometryDataset.currentEntry, mesh.geometryDataset.extent, mesh.nPointsGlobal, 3, 12)
+      << "          </Geometry>\n";
+
+    for (const std::pair<const std::string,FieldVariableDataset> &fieldVariableDataset : mesh.fieldVariableDatasets)
+    {
+      const int nComponents = fieldVariableDataset.second.nComponents;
+      std::string attributeType = "Matrix";
+      if (nComponents == 1)
+        attributeType = "Scalar";
+      else if (nComponents == 3)
+        attributeType = "Vector";
+      else if (nComponents == 6)
+        attributeType = "Tensor6";
+      else if (nComponents == 9)
+        attributeType = "Tensor";
+
+      xdmf << "          <Attribute Name=\"" << xmlEscape(fieldVariableDataset.first) << "\" AttributeType=\"" << attributeType << "\" Center=\"Node\">\n"
+        << xdmfHyperSlab(groupPath + "/fields/" + hdf5ObjectName(fieldVariableDataset.first), fieldVariableDataset.second.currentEntry,
+                         fieldVariableDataset.second.extent, mesh.nPointsGlobal, nComponents, 12)
+        << "          </Attribute>\n";
+    }
+    xdmf << "        </Grid>\n";
+  }
+  xdmf << "      </Grid>\n";
+
+  // overwrite the closing tags with the new time step and append the closing tags again
+  xdmfTimeStepPositions_.push_back(xdmfClosingTagsPosition_);
+  xdmfFile_.seekp(xdmfClosingTagsPosition_);
+  xdmfFile_ << xdmf.str();
+  xdmfClosingTagsPosition_ = xdmfFile_.tellp();
+  xdmfFile_ << xdmfClosingTags;
+  xdmfFile_.flush();
+}
+
+void HDF5::updateXdmfDatasetExtents()
+{
+  std::map<std::string,long long> extents;
+  for (const std::pair<const std::string,MeshDatasets> &mesh : meshes_)
+  {
+    std::string groupPath = xdmfGroupPath(hdf5Filename_, mesh.first);
+    extents[xmlEscape(groupPath + "/geometry")] = mesh.second.geometryDataset.extent;
+
+    for (const std::pair<const std::string,FieldVariableDataset> &fieldVariableDataset : mesh.second.fieldVariableDatasets)
+    {
+      extents[xmlEscape(groupPath + "/fields/" + hdf5ObjectName(fieldVariableDataset.first))] = fieldVariableDataset.second.extent;
+    }
+  }
+
+  std::ifstream file(xdmfFilename_.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+  {
+    LOG(ERROR) << "Could not open XDMF file \"" << xdmfFilename_ << "\" to update the dimensions of the datasets.";
+    return;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  file.close();
+
+  std::ofstream outputFile(xdmfFilename_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  outputFile << replaceXdmfDatasetExtents(contents.str(), extents);
+  if (!outputFile.good())
+  {
+    LOG(ERROR) << "Could not write XDMF file \"" << xdmfFilename_ << "\".";
+  }
+}
+
+#endif
+
+}  // namespace
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <map>
+
+#ifdef HAVE_HDF5
+#include <hdf5.h>
+#endif
+
+#include "control/types.h"
+#include "output_writer/generic.h"
+#include "output_writer/paraview/poly_data_properties_for_mesh.h"
+
+namespace OutputWriter
+{
+
+/** Output writer that writes all field variables of all meshes for all time steps into a single HDF5 file "<filename>.h5".
+ *  Every mesh is stored in a group "/<meshName>" with the datasets "geometry" (nTimeSteps x nPoints x 3), "connectivity" (nCells x nNodesPerCell)
+ *  and one dataset per field variable in the group "/<meshName>/fields" (nTimeSteps x nPoints x nComponents).
+ *  The time dimension is extendible, every call to write appends one time step. The simulation times are stored in the dataset "/time".
+ *  All ranks write their portion of the datasets collectively with MPI-IO. Every node is written once by the rank that owns it,
+ *  the points are numbered by the global PETSc node numbering, which is contiguous for the nodes of a rank. The connectivity refers to these numbers.
+ *
+ *  Additionally, rank 0 writes an XDMF file "<filename>.xdmf" that describes the datasets as temporal collection, it can be opened in ParaView.
+ *
+ *  With the option "deltaOutput", a dataset is only extended if its values changed since the last written entry on any rank.
+ *  This stores the geometry of non-deforming meshes and field variables that are in equilibrium only once, the XDMF file refers to the last written entry.
+ *
+ *  When the simulation is restarted from a checkpoint, the existing files are continued: the number of written time steps is stored in the checkpoint,
+ *  the time steps up to the checkpoint are kept and the time steps that were written after the checkpoint by the aborted run are overwritten.
+ */
+class HDF5 : public Generic
+{
+public:
+
+  //! constructor
+  HDF5(DihuContext context, PythonConfig specificSettings, std::shared_ptr<Partition::RankSubset> rankSubset = nullptr);
+
+  //! destructor, closes the file
+  virtual ~HDF5();
+
+  //! append the current values of all field variables as a new time step to the file
+  template<typename DataType>
+  void write(DataType &data, int timeStepNo = -1, double currentTime = -1, int callCountIncrement = 1);
+
+#ifdef HAVE_HDF5
+private:
+
+  //! dataset of a field variable or of the geometry
+  struct FieldVariableDataset
+  {
+    hid_t dataset;          //< the HDF5 dataset with dimensions nEntries x nPointsGlobal x nComponents
+    int nComponents;        //< number of components of the field variable
+    long long nEntries;     //< number of entries in the time dimension of the dataset, this is less than the number of time steps for deltaOutput_
+    long long extent;       //< current size of the time dimension, in a file that is continued after a restart this can be larger than nEntries
+    long long currentEntry; //< index of the entry in the time dimension that contains the values of the current time step
+    std::vector<double> lastWrittenValues;   //< for deltaOutput_, the local values of the entry currentEntry
+  };
+
+  //! handles and sizes of the datasets of a mesh
+  struct MeshDatasets
+  {
+    hid_t group;                //< the group "/<meshName>"
+    hid_t fieldsGroup;          //< the group "/<meshName>/fields"
+    FieldVariableDataset geometryDataset;   //< the extendible dataset of the geometry values
+
+    std::map<std::string,FieldVariableDataset> fieldVariableDatasets;   //< datasets of the field variables, key is the field variable name
+
+    long long nPointsLocal;     //< number of points of the own rank, without ghosts
+    long long nPointsLocalWithGhosts;   //< number of local values per component that are given by the field variables, including ghosts
+    long long nPointsGlobal;    //< total number of points, sum of nPointsLocal over all ranks
+    long long pointOffset;      //< number of points on previous ranks, the global number of the first own point
+    std::vector<long long> ownedPointNos;   //< for every own point in global numbering, the index of its value in the local values including ghosts
+    long long nCellsGlobal;     //< total number of cells
+    int dimensionality;         //< dimension of the mesh
+    int nNodesPerCell;          //< 2, 4 or 8, depending on the dimensionality
+  };
+
+  //! create the HDF5 file and the XDMF file, or open the existing files after a restart, this is called at the first write
+  void openFiles();
+
+  //! on rank 0, parse the existing XDMF file for the positions of the time steps and open it for writing, returns false if the file cannot be continued
+  bool openExistingXdmfFile();
+
+  //! remove all time steps starting at nTimeSteps from the XDMF file, this is used after the number of written time steps was restored from a checkpoint
+  void truncateXdmfTimeSteps(long long nTimeSteps);
+
+  //! create the group, the geometry and the connectivity dataset of a mesh,
+  //! nodeNosGlobalPetsc are the global numbers of the local points including ghosts in the order of the values, the first nNodesLocalWithoutGhosts local nodes are owned
+  void initializeMesh(const std::string &meshName, const PolyDataPropertiesForMesh &properties,
+                      const std::vector<global_no_t> &nodeNosGlobalPetsc, node_no_t nNodesLocalWithoutGhosts);
+
+  //! create the dataset of a field variable, if it does not yet exist
+  FieldVariableDataset &getFieldVariableDataset(MeshDatasets &mesh, const std::string &fieldVariableName, int nComponents);
+
+  //! extend the dataset by the current time step and collectively write the values of the own points, values are the local values including ghosts.
+  //! For deltaOutput_, nothing is written if the values did not change on any rank, then the current time step refers to the last written entry.
+  void appendValues(const MeshDatasets &mesh, FieldVariableDataset &dataset, std::vector<double> &values);
+
+  //! for deltaOutput_, determine if the values of any rank differ from the last written values by more than deltaTolerance_, this is collective
+  bool valuesChanged(const FieldVariableDataset &dataset, const std::vector<double> &values);
+
+  //! extend the time dataset and write the current time
+  void appendTime(double currentTime);
+
+  //! append the description of the current time step to the XDMF file, only called on rank 0
+  void appendXdmfTimeStep(double currentTime);
+
+  //! set the sizes of the time dimension of all datasets in the XDMF file to the final extents of the datasets, only called on rank 0 when the files are closed
+  void updateXdmfDatasetExtents();
+
+  hid_t fileId_;                                    //< handle of the HDF5 file, -1 if not yet opened
+  hid_t transferPropertyList_;                      //< property list for collective writes
+  hid_t timeDataset_;                               //< the dataset "/time"
+  long long timeDatasetExtent_;                     //< current size of the time dataset
+  std::map<std::string,MeshDatasets> meshes_;       //< the datasets of all meshes, key is the mesh name
+  std::vector<std::string> meshNamesCurrentTimeStep_;   //< the meshes that were written in the current time step, for the XDMF file
+
+  long long nTimeStepsWritten_;                     //< number of time steps that are stored in the file
+  long long chunkSize_;                             //< number of points per chunk of the datasets
+  bool deltaOutput_;                                //< if the geometry and field variables are only stored again when their values changed
+  double deltaTolerance_;                           //< for deltaOutput_, the maximum absolute difference of values that are considered unchanged
+  bool nTimeStepsWrittenRestored_;                  //< if nTimeStepsWritten_ was restored from a checkpoint
+  int timeStepsCheckpointingHandle_;                //< handle of nTimeStepsWritten_ in Control::Checkpointing, -1 if not registered
+  std::string hdf5Filename_;                        //< filename of the HDF5 file
+  std::string xdmfFilename_;                        //< filename of the XDMF file
+  std::ofstream xdmfFile_;                          //< the XDMF file, only open on rank 0
+  std::streampos xdmfClosingTagsPosition_;          //< position in the XDMF file where the next time step will be appended
+  std::vector<std::streampos> xdmfTimeStepPositions_;   //< positions in the XDMF file where the grids of the time steps begin
+#endif
+};
+
+} // namespace
+
+#include "output_writer/hdf5/hdf5.tpp"
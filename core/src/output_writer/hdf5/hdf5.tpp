@@ -0,0 +1,104 @@
+#include "output_writer/hdf5/hdf5.h"
+
+#include <set>
+
+#include "easylogging++.h"
+
+#include "output_writer/paraview/loop_collect_mesh_properties.h"
+#include "output_writer/paraview/loop_get_nodal_values.h"
+#include "output_writer/paraview/loop_get_geometry_field_nodal_values.h"
+#include "output_writer/hdf5/loop_get_node_nos_global.h"
+
+namespace OutputWriter
+{
+
+template<typename DataType>
+void HDF5::write(DataType& data, int timeStepNo, double currentTime, int callCountIncrement)
+{
+  // check if output should be written in this timestep and prepare filename
+  if (!Generic::prepareWrite(data, timeStepNo, currentTime, callCountIncrement))
+  {
+    return;
+  }
+
+#ifdef HAVE_HDF5
+  typedef typename DataType::FieldVariablesForOutputWriter FieldVariablesForOutputWriterType;
+  FieldVariablesForOutputWriterType fieldVariables = data.getFieldVariablesForOutputWriter();
+
+  // collect the number of points, cells and the field variables of all meshes
+  std::map<std::string,PolyDataPropertiesForMesh> meshProperties;
+  std::vector<std::string> meshNames;
+  ParaviewLoopOverTuple::loopCollectMeshProperties<FieldVariablesForOutputWriterType>(fieldVariables, meshProperties, meshNames);
+
+  // open the file at the first call
+  if (fileId_ < 0)
+  {
+    openFiles();
+  }
+
+  appendTime(currentTime);
+
+  // sort the mesh names, such that all ranks create the datasets in the same order
+  std::set<std::string> meshNamesSorted(meshNames.begin(), meshNames.end());
+  meshNamesCurrentTimeStep_.assign(meshNamesSorted.begin(), meshNamesSorted.end());
+
+  // get the global numbering of the points of the meshes that are written for the first time
+  std::set<std::string> newMeshNames;
+  for (const std::string &meshName : meshNamesCurrentTimeStep_)
+  {
+    if (meshes_.find(meshName) == meshes_.end())
+      newMeshNames.insert(meshName);
+  }
+
+  std::map<std::string,std::vector<global_no_t>> nodeNosGlobalPetsc;
+  std::map<std::string,node_no_t> nNodesLocalWithoutGhosts;
+  if (!newMeshNames.empty())
+  {
+    HDF5LoopOverTuple::loopGetNodeNosGlobal<FieldVariablesForOutputWriterType>(fieldVariables, newMeshNames, nodeNosGlobalPetsc, nNodesLocalWithoutGhosts);
+  }
+
+  for (const std::string &meshName : meshNamesCurrentTimeStep_)
+  {
+    const PolyDataPropertiesForMesh &properties = meshProperties[meshName];
+
+    // create the datasets of the mesh at the first time step it is written
+    if (meshes_.find(meshName) == meshes_.end())
+    {
+      initializeMesh(meshName, properties, nodeNosGlobalPetsc[meshName], nNodesLocalWithoutGhosts[meshName]);
+    }
+    MeshDatasets &mesh = meshes_[meshName];
+
+    // get the local values including ghosts of the geometry field and all other field variables, only the values of the own points are written
+    std::set<std::string> currentMeshName({meshName});
+
+    std::vector<double> geometryValues;
+    ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, currentMeshName, geometryValues);
+
+    std::map<std::string,std::vector<double>> fieldVariableValues;
+    ParaviewLoopOverTuple::loopGetNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, currentMeshName, fieldVariableValues);
+
+    appendValues(mesh, mesh.geometryDataset, geometryValues);
+
+    for (const PolyDataPropertiesForMesh::DataArrayName &pointDataArray : properties.pointDataArrays)
+    {
+      FieldVariableDataset &fieldVariableDataset = getFieldVariableDataset(mesh, pointDataArray.name, pointDataArray.nComponents);
+      appendValues(mesh, fieldVariableDataset, fieldVariableValues[pointDataArray.name]);
+    }
+  }
+
+  // make the new time step visible to readers, in case the simulation is aborted
+  if (H5Fflush(fileId_, H5F_SCOPE_GLOBAL) < 0)
+  {
+    LOG(ERROR) << "Could not flush HDF5 file \"" << hdf5Filename_ << "\".";
+  }
+
+  if (this->rankSubset_->ownRankNo() == 0)
+  {
+    appendXdmfTimeStep(currentTime);
+  }
+
+  nTimeStepsWritten_++;
+#endif
+}
+
+} // namespace
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "utility/type_utility.h"
+#include "mesh/type_traits.h"
+
+#include <cstdlib>
+
+/** The functions in this file model a loop over the elements of a tuple, as it occurs as FieldVariablesForOutputWriterType in all data_management classes.
+ *  (Because the types inside the tuple are static and fixed at compile-time, a simple for loop c not work here.)
+ *  The two functions starting with loop recursively emulate the loop. One method is the break condition and does nothing, the other method does the work and calls the method without loop in the name.
+ *  FieldVariablesForOutputWriterType is assumed to be of type std::tuple<...>> where the types can be (mixed) std::shared_ptr<FieldVariable> or std::vector<std::shared_ptr<FieldVariable>>.
+ *
+ *  Get the global PETSc node numbers of the points of the meshes given in meshNames, in the order of the values of loopGetNodalValues (local natural ordering including ghosts),
+ *  and the number of local nodes without ghosts. This is used by the HDF5 writer to store every node only once, by the rank that owns it.
+ */
+
+namespace OutputWriter
+{
+
+namespace HDF5LoopOverTuple
+{
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ *  Stopping criterion
+ */
+template<typename FieldVariablesForOutputWriterType, int i=0>
+inline typename std::enable_if<i == std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
+loopGetNodeNosGlobal(const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                     std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts
+)
+{}
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ * Loop body
+ */
+template<typename FieldVariablesForOutputWriterType, int i=0>
+inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
+loopGetNodeNosGlobal(const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                     std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts);
+
+/** Loop body for a vector element
+ */
+template<typename VectorType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
+getNodeNosGlobal(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts);
+
+/** Loop body for a tuple element
+ */
+template<typename VectorType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
+getNodeNosGlobal(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts);
+
+ /**  Loop body for a pointer element
+ */
+template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value
+  && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
+getNodeNosGlobal(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts);
+
+/** Loop body for a field variables with Mesh::CompositeOfDimension<D>
+ */
+template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
+getNodeNosGlobal(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts);
+
+}  // namespace HDF5LoopOverTuple
+
+}  // namespace OutputWriter
+
+#include "output_writer/hdf5/loop_get_node_nos_global.tpp"
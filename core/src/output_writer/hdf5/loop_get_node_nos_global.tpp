@@ -0,0 +1,119 @@
+#include "output_writer/hdf5/loop_get_node_nos_global.h"
+
+#include <cstdlib>
+#include "field_variable/field_variable.h"
+
+namespace OutputWriter
+{
+
+namespace HDF5LoopOverTuple
+{
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ * Loop body
+ */
+template<typename FieldVariablesForOutputWriterType, int i>
+inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
+loopGetNodeNosGlobal(const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                     std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts
+)
+{
+  // call what to do in the loop body
+  if (getNodeNosGlobal<typename std::tuple_element<i,FieldVariablesForOutputWriterType>::type, FieldVariablesForOutputWriterType>(
+        std::get<i>(fieldVariables), fieldVariables, meshNames, nodeNosGlobalPetsc, nNodesLocalWithoutGhosts))
+    return;
+
+  // advance iteration to next tuple element
+  loopGetNodeNosGlobal<FieldVariablesForOutputWriterType, i+1>(fieldVariables, meshNames, nodeNosGlobalPetsc, nNodesLocalWithoutGhosts);
+}
+
+// current element is of pointer type (not vector)
+template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
+getNodeNosGlobal(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts)
+{
+  if (!currentFieldVariable || !currentFieldVariable->functionSpace())
+    return false;
+
+  // all field variables of a mesh share the numbering, collect it only once per mesh
+  std::string meshName = currentFieldVariable->functionSpace()->meshName();
+  if (meshNames.find(meshName) == meshNames.end() || nodeNosGlobalPetsc.find(meshName) != nodeNosGlobalPetsc.end())
+    return false;
+
+  typedef typename CurrentFieldVariableType::element_type::FunctionSpace FunctionSpaceType;
+  const int nDofsPerNode = FunctionSpaceType::nDofsPerNode();
+
+  auto meshPartition = currentFieldVariable->functionSpace()->meshPartition();
+  const std::vector<dof_no_t> &dofNosLocalNaturalOrdering = meshPartition->dofNosLocalNaturalOrdering();
+  const node_no_t nNodesLocal = meshPartition->nNodesLocalWithGhosts();
+
+  // the points are in the same order as the values of loopGetNodalValues, i.e. every nDofsPerNode'th dof in local natural ordering
+  std::vector<global_no_t> &nodeNos = nodeNosGlobalPetsc[meshName];
+  nodeNos.resize(nNodesLocal);
+  for (node_no_t pointNo = 0; pointNo < nNodesLocal; pointNo++)
+  {
+    node_no_t nodeNoLocal = dofNosLocalNaturalOrdering[pointNo*nDofsPerNode] / nDofsPerNode;
+    nodeNos[pointNo] = meshPartition->getNodeNoGlobalPetsc(nodeNoLocal);
+  }
+  nNodesLocalWithoutGhosts[meshName] = meshPartition->nNodesLocalWithoutGhosts();
+
+  return false;  // do not break iteration
+}
+
+// element i is of vector type
+template<typename VectorType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
+getNodeNosGlobal(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts)
+{
+  for (auto& currentFieldVariable : currentFieldVariableGradient)
+  {
+    // call function on all vector entries
+    if (getNodeNosGlobal<typename VectorType::value_type,FieldVariablesForOutputWriterType>(currentFieldVariable, fieldVariables, meshNames,
+                                                                                            nodeNosGlobalPetsc, nNodesLocalWithoutGhosts))
+      return true; // break iteration
+  }
+  return false;  // do not break iteration
+}
+
+// element i is of tuple type
+template<typename TupleType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
+getNodeNosGlobal(TupleType currentFieldVariableTuple, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts)
+{
+  // call for tuple element
+  loopGetNodeNosGlobal<TupleType>(currentFieldVariableTuple, meshNames, nodeNosGlobalPetsc, nNodesLocalWithoutGhosts);
+
+  return false;  // do not break iteration
+}
+
+// element i is a field variables with Mesh::CompositeOfDimension<D>
+template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
+getNodeNosGlobal(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                 std::map<std::string,std::vector<global_no_t>> &nodeNosGlobalPetsc, std::map<std::string,node_no_t> &nNodesLocalWithoutGhosts)
+{
+  const int D = CurrentFieldVariableType::element_type::FunctionSpace::dim();
+  typedef typename CurrentFieldVariableType::element_type::FunctionSpace::BasisFunction BasisFunctionType;
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>, BasisFunctionType> SubFunctionSpaceType;
+  const int nComponents = CurrentFieldVariableType::element_type::nComponents();
+
+  typedef FieldVariable::FieldVariable<SubFunctionSpaceType, nComponents> SubFieldVariableType;
+
+  std::vector<std::shared_ptr<SubFieldVariableType>> subFieldVariables;
+  currentFieldVariable->getSubFieldVariables(subFieldVariables);
+
+  for (auto& currentSubFieldVariable : subFieldVariables)
+  {
+    // call function on all vector entries
+    if (getNodeNosGlobal<std::shared_ptr<SubFieldVariableType>,FieldVariablesForOutputWriterType>(currentSubFieldVariable, fieldVariables, meshNames,
+                                                                                                   nodeNosGlobalPetsc, nNodesLocalWithoutGhosts))
+      return true;
+  }
+
+  return false;  // do not break iteration
+}
+}  // namespace HDF5LoopOverTuple
+}  // namespace OutputWriter
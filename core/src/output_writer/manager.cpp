@@ -1,5 +1,8 @@
 #include "output_writer/manager.h"
 
+#include <limits>
+#include <algorithm>
+
 #include "easylogging++.h"
 
 #include "utility/python_utility.h"
@@ -8,6 +11,8 @@
 #include "output_writer/paraview/paraview.h"
 #include "output_writer/exfile/exfile.h"
 #include "output_writer/megamol/megamol.h"
+#include "output_writer/hdf5/hdf5.h"
+#include "output_writer/pod_basis/pod_basis.h"
 
 namespace OutputWriter
 {
@@ -112,10 +117,22 @@ void Manager::createOutputWriterFromSettings(DihuContext context, PythonConfig s
       LOG(ERROR) << "Not compiled with ADIOS, but a \"MegaMol\" output writer was specified. Ignoring this output writer.";
 #endif
     }
+    else if (typeString == "HDF5")
+    {
+#ifdef HAVE_HDF5
+      outputWriter_.push_back(std::make_shared<HDF5>(context, settings, rankSubset));
+#else
+      LOG(ERROR) << "Not compiled with HDF5, but a \"HDF5\" output writer was specified. Ignoring this output writer.";
+#endif
+    }
+    else if (typeString == "PodBasis")
+    {
+      outputWriter_.push_back(std::make_shared<PodBasis>(context, settings, rankSubset));
+    }
     else
     {
       LOG(WARNING) << "Unknown output writer type \"" << typeString<< "\". "
-        << "Valid options are: \"Paraview\", \"PythonCallback\", \"PythonFile\", \"Exfile\", \"MegaMol\"";
+        << "Valid options are: \"Paraview\", \"PythonCallback\", \"PythonFile\", \"Exfile\", \"MegaMol\", \"HDF5\", \"PodBasis\"";
     }
   }
 }
@@ -125,6 +142,16 @@ bool Manager::hasOutputWriters()
   return !outputWriter_.empty();
 }
 
+int Manager::nCallsUntilNextOutput() const
+{
+  int nCalls = std::numeric_limits<int>::max();
+  for (const std::shared_ptr<Generic> &outputWriter : outputWriter_)
+  {
+    nCalls = std::min(nCalls, outputWriter->nCallsUntilNextWrite());
+  }
+  return nCalls;
+}
+
 //! get the filename of the first output writer
 std::string Manager::filename()
 {
@@ -30,6 +30,10 @@ public:
   //! if this manager contains any output writers
   bool hasOutputWriters();
 
+  //! get the number of calls to writeOutput, including the next one, until any of the output writers writes a file, std::numeric_limits<int>::max() if there are no output writers
+  //! Time stepping schemes can compute this number of time steps at once and then call writeOutput with this value as callCountIncrement.
+  int nCallsUntilNextOutput() const;
+
   //! get the filename of the first output writer
   std::string filename();
 
@@ -5,6 +5,8 @@
 #include "output_writer/paraview/paraview.h"
 #include "output_writer/exfile/exfile.h"
 #include "output_writer/megamol/megamol.h"
+#include "output_writer/hdf5/hdf5.h"
+#include "output_writer/pod_basis/pod_basis.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OutputWriter
@@ -68,6 +70,26 @@ void Manager::writeOutput(DataType &problemData, int timeStepNo, double currentT
 
       Control::PerformanceMeasurement::stop("durationWriteOutputMegamol");
     }
+    else if (std::dynamic_pointer_cast<HDF5>(outputWriter) != nullptr)
+    {
+      LogScope s ("WriteOutputHDF5");
+      Control::PerformanceMeasurement::start("durationWriteOutputHDF5");
+
+      std::shared_ptr<HDF5> writer = std::static_pointer_cast<HDF5>(outputWriter);
+      writer->write<DataType>(problemData, timeStepNo, currentTime, callCountIncrement);
+
+      Control::PerformanceMeasurement::stop("durationWriteOutputHDF5");
+    }
+    else if (std::dynamic_pointer_cast<PodBasis>(outputWriter) != nullptr)
+    {
+      LogScope s ("WriteOutputPodBasis");
+      Control::PerformanceMeasurement::start("durationWriteOutputPodBasis");
+
+      std::shared_ptr<PodBasis> writer = std::static_pointer_cast<PodBasis>(outputWriter);
+      writer->write<DataType>(problemData, timeStepNo, currentTime, callCountIncrement);
+
+      Control::PerformanceMeasurement::stop("durationWriteOutputPodBasis");
+    }
   }
 
   // stop duration measurement
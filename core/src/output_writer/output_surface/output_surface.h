@@ -23,6 +23,9 @@ public:
   //! constructor
   OutputSurface(DihuContext context);
 
+  //! destructor, writes the remaining buffered samples
+  virtual ~OutputSurface();
+
   //! advance simulation by the given time span [startTime_, endTime_]
   void advanceTimeSpan(bool withOutputWritersEnabled = true);
 
@@ -59,6 +62,15 @@ protected:
   //! write positions of found sampling points
   void writeFoundAndNotFoundPointGeometry();
 
+  //! for buffered sampling, assign every sampling point to the rank with the best score, store the interpolation weights and write the header of the binary file
+  void initializeBufferedSampling();
+
+  //! for buffered sampling, interpolate the values at the own sampling points and append them to the local buffer, flush the buffer if it is full
+  void sampleBufferedPointValues();
+
+  //! for buffered sampling, collect the buffered samples of all ranks on rank 0 and append them to the binary file, this is collective on rankSubset_
+  void flushSampleBuffer();
+
   DihuContext context_;               //< object that contains the python config for the current context and the global singletons meshManager and solverManager
   Solver solver_;                     //< the contained solver object
 
@@ -98,6 +110,21 @@ protected:
   bool enableGeometryInCsvFile_;      //< if the csv file should contain geometry data
   bool enableGeometryFiles_;          //< if the found and not found electrodes should be written
 
+  bool enableBufferedSampling_;       //< if the values at the sampling points are buffered and written in windows of bufferSize_ samples to a binary file, instead of gathering and writing them in every call
+  int bufferSize_;                    //< number of samples (calls to advanceTimeSpan) per window for buffered sampling
+  std::string binaryFilename_;        //< filename of the binary file for buffered sampling
+  int nSamplesInBuffer_ = 0;          //< number of samples that are currently in sampleBuffer_
+  std::vector<double> sampleBuffer_;  //< [sampleNo*nBufferedPointsLocal + pointIndex] the buffered values of the own sampling points
+  std::vector<double> sampleTimes_;   //< [sampleNo] the simulation times of the buffered samples
+  std::vector<int> bufferedPointNosLocal_;                        //< [pointIndex] the samplingPointNo of the own sampling points, i.e. the points for which this rank has the best score
+  std::vector<std::vector<int>> bufferedPointIndices_;            //< [functionSpaceNo][i] pointIndex of the i-th own sampling point in the face
+  std::vector<std::vector<dof_no_t>> bufferedDofNosLocal_;        //< [functionSpaceNo][i*nDofsPerElement + dofIndex] the dofs of the element that contains the i-th own sampling point in the face
+  std::vector<std::vector<double>> bufferedWeights_;              //< [functionSpaceNo][i*nDofsPerElement + dofIndex] the interpolation weights (values of phi) of the i-th own sampling point in the face
+  std::vector<double> bufferedElementValues_;                     //< buffer for the values at bufferedDofNosLocal_
+  std::vector<int> nBufferedPointsOnRanks_;                       //< on rank 0, the number of own sampling points of every rank
+  std::vector<int> bufferedPointColumns_;                         //< on rank 0, [i] the column in the binary file of the i-th gathered point, in the order of the ranks
+  int nBufferedPointsGlobal_ = 0;                                 //< on rank 0, the number of found sampling points in total
+
   SeriesWriter seriesWriter_;         //< the series writer object that collects all VTK filenames and creates a collection file that can be loaded by ParaView, for the files that have the EMG values
   SeriesWriter seriesWriterFoundPoints_;      //< the series writer object that collects all VTK filenames and creates a collection file that can be loaded by ParaView, for the files that have the found electrode points
   SeriesWriter seriesWriterNotFoundPoints_;   //< the series writer object that collects all VTK filenames and creates a collection file that can be loaded by ParaView, for the files that have the not found electrode points
@@ -110,3 +137,4 @@ protected:
 
 #include "output_writer/output_surface/output_surface.tpp"
 #include "output_writer/output_surface/output_surface_write.tpp"
+#include "output_writer/output_surface/output_surface_buffered.tpp"
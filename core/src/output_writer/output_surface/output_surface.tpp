@@ -10,11 +10,20 @@ OutputSurface<Solver>::
 OutputSurface(DihuContext context) :
   context_(context["OutputSurface"]), solver_(context_),
   data_(context_), ownRankInvolvedInOutput_(true), timeStepNo_(0), currentTime_(0.0), updatePointPositions_(false),
-  enableCsvFile_(false), enableVtpFile_(false), enableGeometryInCsvFile_(false)
+  enableCsvFile_(false), enableVtpFile_(false), enableGeometryInCsvFile_(false), enableBufferedSampling_(false), bufferSize_(1)
 {
 
 }
 
+template<typename Solver>
+OutputSurface<Solver>::
+~OutputSurface()
+{
+  // write the samples of the last, incomplete window
+  if (initialized_ && ownRankInvolvedInOutput_ && enableBufferedSampling_)
+    flushSampleBuffer();
+}
+
 template<typename Solver>
 void OutputSurface<Solver>::
 initialize()
@@ -44,6 +53,24 @@ initialize()
     enableVtpFile_ = specificSettings.getOptionBool("enableVtpFile", true);
     enableGeometryInCsvFile_ = specificSettings.getOptionBool("enableGeometryInCsvFile", true);
     enableGeometryFiles_ = specificSettings.getOptionBool("enableGeometryFiles", true);
+    enableBufferedSampling_ = specificSettings.getOptionBool("enableBufferedSampling", false);
+
+    if (enableBufferedSampling_)
+    {
+      bufferSize_ = specificSettings.getOptionInt("bufferSize", 100, PythonUtility::Positive);
+
+      std::string filenameBase = filename_;
+      if (filenameBase.rfind(".") != std::string::npos)
+        filenameBase = filenameBase.substr(0, filenameBase.rfind("."));
+      binaryFilename_ = specificSettings.getOptionString("binaryFilename", filenameBase + ".bin");
+
+      if (updatePointPositions_)
+      {
+        LOG(WARNING) << specificSettings << "[\"updatePointPositions\"] is not supported together with \"enableBufferedSampling\": True, "
+          << "the sampling points are only located once at the beginning.";
+        updatePointPositions_ = false;
+      }
+    }
   }
 
   LOG(DEBUG) << "OutputSurface: initialize output writers";
@@ -64,6 +91,9 @@ initialize()
 
     initializeSampledPoints();
 
+    if (!sampledPointsRequestedPositions_.empty() && enableBufferedSampling_)
+      initializeBufferedSampling();
+
     // write positions of found sampling points
     if (!sampledPointsRequestedPositions_.empty() && enableGeometryFiles_)
       writeFoundAndNotFoundPointGeometry();
@@ -166,7 +196,10 @@ advanceTimeSpan(bool withOutputWritersEnabled)
       outputWriterManager_.writeOutput(data_, timeStepNo_++, currentTime_);
 
     // write out values at points
-    writeSampledPointValues();
+    if (enableBufferedSampling_)
+      sampleBufferedPointValues();
+    else
+      writeSampledPointValues();
 
     // write positions of found sampling points
     if (updatePointPositions_)
@@ -189,6 +222,9 @@ run()
   if (ownRankInvolvedInOutput_)
   {
     outputWriterManager_.writeOutput(data_);
+
+    if (enableBufferedSampling_)
+      flushSampleBuffer();
   }
 }
 
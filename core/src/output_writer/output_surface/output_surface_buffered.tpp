@@ -0,0 +1,272 @@
+#include "output_writer/output_surface/output_surface.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace OutputWriter
+{
+
+template<typename Solver>
+void OutputSurface<Solver>::
+initializeBufferedSampling()
+{
+  const int nDofsPerElement = DataSurface::FunctionSpaceFirstFieldVariable::nDofsPerElement();
+  const int nSamplingPoints = sampledPointsRequestedPositions_.size();
+
+  int nRanks = rankSubset_->size();
+  int ownRankNo = rankSubset_->ownRankNo();
+
+  // a sampling point can be found on multiple ranks (at shared element boundaries), assign it to the rank with the best (lowest) score,
+  // for equal scores the lower rank no is chosen, this way the global values do not have to be sorted and deduplicated in every sample
+  struct ScoreRank
+  {
+    double score;
+    int rankNo;
+  };
+  std::vector<ScoreRank> scoresLocal(nSamplingPoints, ScoreRank{std::numeric_limits<double>::max(), ownRankNo});
+  std::vector<ScoreRank> scoresBest(nSamplingPoints);
+
+  for (const std::pair<int,FoundSampledPoint> &pair : foundSampledPoints_)
+  {
+    scoresLocal[pair.first].score = pair.second.score;
+  }
+
+  MPIUtility::handleReturnValue(MPI_Allreduce(scoresLocal.data(), scoresBest.data(), nSamplingPoints, MPI_DOUBLE_INT, MPI_MINLOC,
+                                              rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+
+  // store the dofs and interpolation weights of the own sampling points, sorted by face
+  bufferedPointNosLocal_.clear();
+  bufferedPointIndices_.assign(functionSpaces_.size(), std::vector<int>());
+  bufferedDofNosLocal_.assign(functionSpaces_.size(), std::vector<dof_no_t>());
+  bufferedWeights_.assign(functionSpaces_.size(), std::vector<double>());
+
+  std::vector<double> positionsLocal;
+
+  for (const std::pair<int,FoundSampledPoint> &pair : foundSampledPoints_)
+  {
+    int samplingPointNo = pair.first;
+    const FoundSampledPoint &foundSampledPoint = pair.second;
+
+    if (scoresBest[samplingPointNo].rankNo != ownRankNo)
+      continue;
+
+    int functionSpaceNo = foundSampledPoint.functionSpaceNo;
+    std::shared_ptr<typename ::Data::OutputSurface<Data>::FunctionSpaceFirstFieldVariable> functionSpace = functionSpaces_[functionSpaceNo];
+
+    std::array<dof_no_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(foundSampledPoint.elementNoLocal);
+
+    bufferedPointIndices_[functionSpaceNo].push_back(bufferedPointNosLocal_.size());
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      bufferedDofNosLocal_[functionSpaceNo].push_back(dofNosLocal[dofIndex]);
+      bufferedWeights_[functionSpaceNo].push_back(DataSurface::FunctionSpaceFirstFieldVariable::phi(dofIndex, foundSampledPoint.xi));
+    }
+
+    bufferedPointNosLocal_.push_back(samplingPointNo);
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      positionsLocal.push_back(foundSampledPoint.position[componentNo]);
+    }
+  }
+
+  int nPointsLocal = bufferedPointNosLocal_.size();
+  sampleBuffer_.reserve(bufferSize_*nPointsLocal);
+  sampleTimes_.reserve(bufferSize_);
+
+  // collect the point nos and positions of all ranks on rank 0, this is only done once
+  nBufferedPointsOnRanks_.resize(nRanks);
+  MPIUtility::handleReturnValue(MPI_Gather(&nPointsLocal, 1, MPI_INT, nBufferedPointsOnRanks_.data(), 1, MPI_INT, 0, rankSubset_->mpiCommunicator()), "MPI_Gather");
+
+  std::vector<int> sizesOnRanks(nRanks, 0);
+  std::vector<int> offsets(nRanks, 0);
+  std::vector<int> sizesOnRanksGeometry(nRanks, 0);
+  std::vector<int> offsetsGeometry(nRanks, 0);
+  nBufferedPointsGlobal_ = 0;
+
+  if (ownRankNo == 0)
+  {
+    for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    {
+      sizesOnRanks[rankNo] = nBufferedPointsOnRanks_[rankNo];
+      sizesOnRanksGeometry[rankNo] = nBufferedPointsOnRanks_[rankNo]*3;
+      offsets[rankNo] = nBufferedPointsGlobal_;
+      offsetsGeometry[rankNo] = nBufferedPointsGlobal_*3;
+      nBufferedPointsGlobal_ += nBufferedPointsOnRanks_[rankNo];
+    }
+  }
+
+  std::vector<int> pointNosGlobal(nBufferedPointsGlobal_);
+  std::vector<double> positionsGlobal(nBufferedPointsGlobal_*3);
+
+  MPIUtility::handleReturnValue(MPI_Gatherv(bufferedPointNosLocal_.data(), nPointsLocal, MPI_INT,
+                                            pointNosGlobal.data(), sizesOnRanks.data(), offsets.data(), MPI_INT, 0, rankSubset_->mpiCommunicator()), "MPI_Gatherv");
+  MPIUtility::handleReturnValue(MPI_Gatherv(positionsLocal.data(), nPointsLocal*3, MPI_DOUBLE,
+                                            positionsGlobal.data(), sizesOnRanksGeometry.data(), offsetsGeometry.data(), MPI_DOUBLE, 0, rankSubset_->mpiCommunicator()), "MPI_Gatherv");
+
+  LOG(DEBUG) << "buffered sampling, " << nPointsLocal << " own sampling points: " << bufferedPointNosLocal_;
+
+  if (ownRankNo != 0)
+    return;
+
+  // the points are stored in the file in the order of their samplingPointNo, determine the column of every gathered point
+  std::vector<int> sortedPointNos(pointNosGlobal);
+  std::sort(sortedPointNos.begin(), sortedPointNos.end());
+
+  bufferedPointColumns_.resize(nBufferedPointsGlobal_);
+  std::vector<double> positionsSorted(nBufferedPointsGlobal_*3);
+  for (int i = 0; i < nBufferedPointsGlobal_; i++)
+  {
+    int columnNo = std::lower_bound(sortedPointNos.begin(), sortedPointNos.end(), pointNosGlobal[i]) - sortedPointNos.begin();
+    bufferedPointColumns_[i] = columnNo;
+
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      positionsSorted[3*columnNo + componentNo] = positionsGlobal[3*i + componentNo];
+    }
+  }
+
+  LOG(INFO) << "OutputSurface: " << nBufferedPointsGlobal_ << " of " << nSamplingPoints << " sampling points found, "
+    << "write samples in windows of " << bufferSize_ << " to \"" << binaryFilename_ << "\".";
+
+  // write the header of the binary file:
+  //   char[8] "EMGBUF01", int32 nPoints, int32 samplingPointNo[nPoints], double position[nPoints][3]
+  // followed by one record per sample: double time, double value[nPoints]
+  std::ofstream file;
+  Generic::openFile(file, binaryFilename_);  // recreate and truncate file
+
+  const char magic[8] = {'E','M','G','B','U','F','0','1'};
+  int32_t nPoints = nBufferedPointsGlobal_;
+  std::vector<int32_t> sortedPointNos32(sortedPointNos.begin(), sortedPointNos.end());
+
+  file.write(magic, 8);
+  file.write((const char *)&nPoints, sizeof(int32_t));
+  file.write((const char *)sortedPointNos32.data(), sizeof(int32_t)*nPoints);
+  file.write((const char *)positionsSorted.data(), sizeof(double)*nPoints*3);
+  file.close();
+}
+
+template<typename Solver>
+void OutputSurface<Solver>::
+sampleBufferedPointValues()
+{
+  if (!ownRankInvolvedInOutput_ || sampledPointsRequestedPositions_.empty())
+    return;
+
+  const int nDofsPerElement = DataSurface::FunctionSpaceFirstFieldVariable::nDofsPerElement();
+  const int nComponents = DataSurface::SecondFieldVariable::nComponents();
+  if (nComponents != 1)
+    LOG(FATAL) << "Output of sampled points is only possible for scalar field variables.";
+
+  // get all 2D field variables
+  typename DataSurface::FieldVariablesForOutputWriter outputFieldVariables2D
+    = this->data_.getFieldVariablesForOutputWriter();
+
+  const int nPointsLocal = bufferedPointNosLocal_.size();
+  sampleBuffer_.resize((nSamplesInBuffer_+1)*nPointsLocal);
+  double *samples = sampleBuffer_.data() + nSamplesInBuffer_*nPointsLocal;
+
+  // interpolate the values of the own points in every face with the stored weights
+  for (int functionSpaceNo = 0; functionSpaceNo < bufferedPointIndices_.size(); functionSpaceNo++)
+  {
+    const std::vector<int> &pointIndices = bufferedPointIndices_[functionSpaceNo];
+    if (pointIndices.empty())
+      continue;
+
+    std::shared_ptr<typename DataSurface::SecondFieldVariable> fieldVariable = std::get<2>(outputFieldVariables2D)[functionSpaceNo];
+
+    // get the values at all needed dofs of the face at once
+    bufferedElementValues_.clear();
+    fieldVariable->getValues(0, bufferedDofNosLocal_[functionSpaceNo], bufferedElementValues_);
+
+    const double *weights = bufferedWeights_[functionSpaceNo].data();
+    for (int i = 0; i < pointIndices.size(); i++)
+    {
+      double value = 0;
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        value += weights[i*nDofsPerElement + dofIndex] * bufferedElementValues_[i*nDofsPerElement + dofIndex];
+      }
+      samples[pointIndices[i]] = value;
+    }
+  }
+
+  sampleTimes_.push_back(currentTime_);
+  nSamplesInBuffer_++;
+
+  // if the window is full, write it
+  if (nSamplesInBuffer_ >= bufferSize_)
+    flushSampleBuffer();
+}
+
+template<typename Solver>
+void OutputSurface<Solver>::
+flushSampleBuffer()
+{
+  // all ranks sample in the same calls, therefore all ranks have the same number of samples
+  if (nSamplesInBuffer_ == 0)
+    return;
+
+  LOG(DEBUG) << "flushSampleBuffer, " << nSamplesInBuffer_ << " samples";
+
+  int nRanks = rankSubset_->size();
+  int ownRankNo = rankSubset_->ownRankNo();
+  const int nPointsLocal = bufferedPointNosLocal_.size();
+
+  std::vector<int> sizesOnRanks(nRanks, 0);
+  std::vector<int> offsets(nRanks, 0);
+  std::vector<double> samplesGlobal;
+
+  if (ownRankNo == 0)
+  {
+    int offset = 0;
+    for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    {
+      sizesOnRanks[rankNo] = nSamplesInBuffer_*nBufferedPointsOnRanks_[rankNo];
+      offsets[rankNo] = offset;
+      offset += sizesOnRanks[rankNo];
+    }
+    samplesGlobal.resize(offset);
+  }
+
+  // collect the whole window with a single collective operation
+  MPIUtility::handleReturnValue(MPI_Gatherv(sampleBuffer_.data(), nSamplesInBuffer_*nPointsLocal, MPI_DOUBLE,
+                                            samplesGlobal.data(), sizesOnRanks.data(), offsets.data(), MPI_DOUBLE, 0, rankSubset_->mpiCommunicator()), "MPI_Gatherv");
+
+  // on rank 0, reorder to records of (time, values of all points) and append them to the file
+  if (ownRankNo == 0)
+  {
+    const int recordSize = 1 + nBufferedPointsGlobal_;
+    std::vector<double> records(nSamplesInBuffer_*recordSize);
+
+    for (int sampleNo = 0; sampleNo < nSamplesInBuffer_; sampleNo++)
+    {
+      records[sampleNo*recordSize] = sampleTimes_[sampleNo];
+    }
+
+    int pointOffset = 0;
+    for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    {
+      const int nPointsOnRank = nBufferedPointsOnRanks_[rankNo];
+      for (int sampleNo = 0; sampleNo < nSamplesInBuffer_; sampleNo++)
+      {
+        for (int i = 0; i < nPointsOnRank; i++)
+        {
+          int columnNo = bufferedPointColumns_[pointOffset + i];
+          records[sampleNo*recordSize + 1 + columnNo] = samplesGlobal[offsets[rankNo] + sampleNo*nPointsOnRank + i];
+        }
+      }
+      pointOffset += nPointsOnRank;
+    }
+
+    std::ofstream file;
+    Generic::openFile(file, binaryFilename_, true);  // append to file
+    file.write((const char *)records.data(), sizeof(double)*records.size());
+    file.close();
+  }
+
+  sampleBuffer_.clear();
+  sampleTimes_.clear();
+  nSamplesInBuffer_ = 0;
+}
+
+}  // namespace OutputWriter
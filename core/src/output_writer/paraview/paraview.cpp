@@ -27,6 +27,48 @@ Paraview::Paraview(DihuContext context, PythonConfig settings, std::shared_ptr<P
   binaryOutput_ = settings.getOptionBool("binary", true);
   fixedFormat_ = settings.getOptionBool("fixedFormat", true);
   combineFiles_ = settings.getOptionBool("combineFiles", false);
+  appendedOutput_ = settings.getOptionBool("appended", false);
+  compressionBlockSize_ = settings.getOptionInt("compressionBlockSize", 32768, PythonUtility::Positive);
+
+  std::string compression = settings.getOptionString("compression", "none");
+  if (compression == "zlib")
+  {
+#ifdef HAVE_ZLIB
+    compression_ = compressionZlib;
+#else
+    LOG(WARNING) << settings.getStringPath() << "[\"compression\"] is \"zlib\", but opendihu was compiled without zlib. The output will not be compressed.";
+    compression_ = compressionNone;
+#endif
+  }
+  else if (compression == "lz4")
+  {
+#ifdef HAVE_LZ4
+    compression_ = compressionLZ4;
+#else
+    LOG(WARNING) << settings.getStringPath() << "[\"compression\"] is \"lz4\", but opendihu was compiled without LZ4. The output will not be compressed.";
+    compression_ = compressionNone;
+#endif
+  }
+  else
+  {
+    if (compression != "none" && compression != "None")
+    {
+      LOG(WARNING) << settings.getStringPath() << "[\"compression\"] is \"" << compression << "\", but has to be one of \"none\", \"zlib\" or \"lz4\". The output will not be compressed.";
+    }
+    compression_ = compressionNone;
+  }
+
+  // appended output is only implemented for the combined files that are written with MPI IO
+  if (appendedOutput_ && (!binaryOutput_ || !combineFiles_))
+  {
+    LOG(WARNING) << settings.getStringPath() << "[\"appended\"] is only possible with \"binary\": True and \"combineFiles\": True. Using inline data.";
+    appendedOutput_ = false;
+  }
+  if (compression_ != compressionNone && !appendedOutput_)
+  {
+    LOG(WARNING) << settings.getStringPath() << "[\"compression\"] is only used with \"appended\": True. The output will not be compressed.";
+    compression_ = compressionNone;
+  }
 }
 
 std::string Paraview::encodeBase64Vec(const Vec &vector, bool withEncodedSizePrefix)
@@ -111,6 +111,22 @@ protected:
   //! write a vector containing nValues "12" (if output3DMeshes) or "9" (if !output3DMeshes) values for the types for an unstructured grid
   void writeCombinedTypesVector(MPI_File fileHandle, int ownRankNo, int nValues, bool output3DMeshes, int identifier);
 
+  //! convert the local values to raw Float32 or Int32 data and store them as the next data array of the <AppendedData> section of a combined file, collective
+  template<typename T>
+  void prepareAppendedDataArray(const std::vector<T> &values, bool writeFloatsAsInt=false);
+
+  //! compress the local raw data (if compression is enabled) and store it as the next data array of the <AppendedData> section of a combined file, collective
+  void prepareAppendedDataArray(const std::string &rawData);
+
+  //! get the format attribute of a <DataArray> element of a combined file, for appended output this includes the offset of the prepared data array appendedArrayNo
+  std::string combinedFileFormatAttribute(int appendedArrayNo) const;
+
+  //! get additional attributes of the <VTKFile> element of a combined file, i.e. header_type and compressor for appended output
+  std::string combinedFileVTKFileAttributes() const;
+
+  //! write the <AppendedData> section with all prepared data arrays and the closing </VTKFile> tag, then clear the prepared data arrays, collective
+  void writeAppendedData(MPI_File fileHandle, int ownRankNo);
+
   //! helper method that writes the unstructured grid file
   template<typename FieldVariablesForOutputWriterType>
   void writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWriterType &fieldVariables, PolyDataPropertiesForMesh &polyDataPropertiesForMesh,
@@ -123,6 +139,27 @@ protected:
 
   bool combineFiles_;   //< if the output data should be combined for 1D meshes into a single PolyData output file (*.vtp) and for 2D and 3D meshes to normal *.vtu,*.vts or *.vtr files. This is needed when the number of output files should be reduced.
 
+  //! compression algorithm for the appended binary data, the data is compressed in blocks as in VTK's vtkZLibDataCompressor and vtkLZ4DataCompressor
+  enum compression_t {
+    compressionNone,
+    compressionZlib,
+    compressionLZ4
+  };
+
+  //! one data array of the <AppendedData> section of a combined file
+  struct AppendedDataArray
+  {
+    std::string header;         //< header that precedes the data, i.e. the number of bytes or the compression header, only set on rank 0
+    std::string data;           //< the encoded local data of the own rank
+    long long offset;           //< offset of the data array in the <AppendedData> section, only set on rank 0
+    long long nBytesGlobal;     //< total number of bytes of header and data of all ranks, only set on rank 0
+  };
+
+  bool appendedOutput_;         //< if the binary data of combined files is written as raw data in an <AppendedData> section instead of base64 encoded inline data
+  compression_t compression_;   //< the compression of the appended data
+  long long compressionBlockSize_;   //< uncompressed size in bytes of the blocks that are compressed individually
+  std::vector<AppendedDataArray> appendedDataArrays_;   //< the prepared data arrays of the combined file that is currently written
+
   std::vector<int> globalValuesSize_;   //< cached values used in writeCombinedValuesVector
   std::vector<int> nPreviousValues_;    //< cached values used in writeCombinedValuesVector
 
@@ -0,0 +1,273 @@
+#include "output_writer/paraview/paraview.h"
+
+#include <cstring>
+#include <cassert>
+#include <sstream>
+#include <algorithm>
+
+#include "easylogging++.h"
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+#include "utility/mpi_utility.h"
+
+namespace OutputWriter
+{
+
+namespace
+{
+
+//! append a value as UInt64 to the buffer, this is the header_type of the combined files with appended data
+void appendUInt64(std::string &buffer, long long value)
+{
+  uint64_t headerValue = (uint64_t)value;
+  buffer.append(reinterpret_cast<const char *>(&headerValue), sizeof(uint64_t));
+}
+
+}  // anonymous namespace
+
+void Paraview::prepareAppendedDataArray(const std::string &rawData)
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+  const int ownRankNo = this->rankSubset_->ownRankNo();
+  const int nRanks = this->rankSubset_->size();
+
+  AppendedDataArray dataArray;
+  dataArray.offset = 0;
+  dataArray.nBytesGlobal = 0;
+
+  // the data arrays are stored consecutively in the <AppendedData> section
+  if (!appendedDataArrays_.empty())
+  {
+    dataArray.offset = appendedDataArrays_.back().offset + appendedDataArrays_.back().nBytesGlobal;
+  }
+
+  long long nBytesLocal = rawData.size();
+
+  if (compression_ == compressionNone)
+  {
+    // without compression, the header is the total number of bytes, followed by the concatenated data of all ranks
+    long long nBytesGlobal = 0;
+    MPIUtility::handleReturnValue(MPI_Reduce(&nBytesLocal, &nBytesGlobal, 1, MPI_LONG_LONG, MPI_SUM, 0, mpiCommunicator), "MPI_Reduce");
+
+    dataArray.data = rawData;
+    if (ownRankNo == 0)
+    {
+      appendUInt64(dataArray.header, nBytesGlobal);
+      dataArray.nBytesGlobal = dataArray.header.size() + nBytesGlobal;
+    }
+    appendedDataArrays_.push_back(dataArray);
+    return;
+  }
+
+  // with compression, the global data is split into blocks of compressionBlockSize_ bytes that are compressed individually.
+  // Every rank compresses the blocks that start in its own range of the global data, the missing end of the last block is received from the next ranks.
+  std::vector<long long> nBytesOnRanks(nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(&nBytesLocal, 1, MPI_LONG_LONG, nBytesOnRanks.data(), 1, MPI_LONG_LONG, mpiCommunicator), "MPI_Allgather");
+
+  std::vector<long long> beginOnRanks(nRanks+1, 0);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    beginOnRanks[rankNo+1] = beginOnRanks[rankNo] + nBytesOnRanks[rankNo];
+  }
+  const long long nBytesGlobal = beginOnRanks[nRanks];
+  const long long blockSize = compressionBlockSize_;
+
+  // get the range of blocks that start on the given rank
+  auto getBlocksOfRank = [&](int rankNo, long long &beginBlockNo, long long &endBlockNo)
+  {
+    beginBlockNo = (beginOnRanks[rankNo] + blockSize - 1) / blockSize;
+    endBlockNo = std::max(beginBlockNo, (beginOnRanks[rankNo+1] + blockSize - 1) / blockSize);
+  };
+
+  // get the end of the global byte range that is needed by the given rank to compress its blocks
+  auto getNeededEnd = [&](int rankNo)
+  {
+    long long beginBlockNo, endBlockNo;
+    getBlocksOfRank(rankNo, beginBlockNo, endBlockNo);
+    if (beginBlockNo == endBlockNo)
+      return beginOnRanks[rankNo+1];
+    return std::min(endBlockNo*blockSize, nBytesGlobal);
+  };
+
+  long long ownBeginBlockNo, ownEndBlockNo;
+  getBlocksOfRank(ownRankNo, ownBeginBlockNo, ownEndBlockNo);
+
+  const long long ownBegin = beginOnRanks[ownRankNo];
+  const long long ownEnd = beginOnRanks[ownRankNo+1];
+  const long long bufferBegin = std::min(ownBeginBlockNo*blockSize, ownEnd);
+  const long long neededEnd = getNeededEnd(ownRankNo);
+
+  // buffer that contains the global bytes [bufferBegin, neededEnd)
+  std::vector<char> buffer(neededEnd - bufferBegin);
+  if (ownEnd > bufferBegin)
+    std::copy(rawData.begin() + (bufferBegin - ownBegin), rawData.end(), buffer.begin());
+
+  // receive the missing end of the last block from the next ranks
+  std::vector<MPI_Request> requests;
+  for (int rankNo = ownRankNo+1; rankNo < nRanks && beginOnRanks[rankNo] < neededEnd; rankNo++)
+  {
+    long long receiveBegin = std::max(beginOnRanks[rankNo], ownEnd);
+    long long receiveEnd = std::min(beginOnRanks[rankNo+1], neededEnd);
+    if (receiveEnd > receiveBegin)
+    {
+      requests.emplace_back();
+      MPIUtility::handleReturnValue(MPI_Irecv(buffer.data() + (receiveBegin - bufferBegin), receiveEnd - receiveBegin, MPI_BYTE,
+                                              rankNo, 0, mpiCommunicator, &requests.back()), "MPI_Irecv");
+    }
+  }
+
+  // send the beginning of the own data to the previous ranks that need it for their last block
+  for (int rankNo = 0; rankNo < ownRankNo; rankNo++)
+  {
+    long long sendBegin = std::max(beginOnRanks[rankNo+1], ownBegin);
+    long long sendEnd = std::min(getNeededEnd(rankNo), ownEnd);
+    if (sendEnd > sendBegin)
+    {
+      requests.emplace_back();
+      MPIUtility::handleReturnValue(MPI_Isend(rawData.data() + (sendBegin - ownBegin), sendEnd - sendBegin, MPI_BYTE,
+                                              rankNo, 0, mpiCommunicator, &requests.back()), "MPI_Isend");
+    }
+  }
+
+  if (!requests.empty())
+  {
+    MPIUtility::handleReturnValue(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+  }
+
+  // compress the own blocks
+  const int nOwnBlocks = ownEndBlockNo - ownBeginBlockNo;
+  std::vector<long long> compressedBlockSizes(nOwnBlocks);
+
+  for (int blockNo = 0; blockNo < nOwnBlocks; blockNo++)
+  {
+    const char *block = buffer.data() + blockNo*blockSize;
+    long long uncompressedSize = std::min(blockSize, (long long)buffer.size() - blockNo*blockSize);
+    long long compressedSize = 0;
+    std::size_t dataSize = dataArray.data.size();
+
+    if (compression_ == compressionZlib)
+    {
+#ifdef HAVE_ZLIB
+      uLongf zlibSize = compressBound(uncompressedSize);
+      dataArray.data.resize(dataSize + zlibSize);
+
+      // use the fastest compression level, the output speed is more important than the last percent of file size
+      int result = compress2(reinterpret_cast<Bytef *>(&dataArray.data[dataSize]), &zlibSize,
+                             reinterpret_cast<const Bytef *>(block), uncompressedSize, Z_BEST_SPEED);
+      if (result != Z_OK)
+      {
+        LOG(FATAL) << "zlib compression of paraview output failed with error code " << result << ".";
+      }
+      compressedSize = zlibSize;
+#endif
+    }
+    else if (compression_ == compressionLZ4)
+    {
+#ifdef HAVE_LZ4
+      dataArray.data.resize(dataSize + LZ4_compressBound(uncompressedSize));
+
+      compressedSize = LZ4_compress_default(block, &dataArray.data[dataSize], uncompressedSize, LZ4_compressBound(uncompressedSize));
+      if (compressedSize <= 0)
+      {
+        LOG(FATAL) << "LZ4 compression of paraview output failed.";
+      }
+#endif
+    }
+
+    dataArray.data.resize(dataSize + compressedSize);
+    compressedBlockSizes[blockNo] = compressedSize;
+  }
+
+  // gather the compressed sizes of all blocks on rank 0, they are needed in the header
+  std::vector<int> nBlocksOnRanks(nRanks);
+  std::vector<int> blockOffsets(nRanks);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    long long beginBlockNo, endBlockNo;
+    getBlocksOfRank(rankNo, beginBlockNo, endBlockNo);
+    nBlocksOnRanks[rankNo] = endBlockNo - beginBlockNo;
+    blockOffsets[rankNo] = beginBlockNo;
+  }
+  const long long nBlocksGlobal = (nBytesGlobal + blockSize - 1) / blockSize;
+
+  std::vector<long long> compressedBlockSizesGlobal(ownRankNo == 0? nBlocksGlobal : 0);
+  MPIUtility::handleReturnValue(MPI_Gatherv(compressedBlockSizes.data(), nOwnBlocks, MPI_LONG_LONG,
+                                            compressedBlockSizesGlobal.data(), nBlocksOnRanks.data(), blockOffsets.data(), MPI_LONG_LONG,
+                                            0, mpiCommunicator), "MPI_Gatherv");
+
+  // the header is: number of blocks, uncompressed block size, uncompressed size of the last partial block (0 if the last block is full), compressed sizes of all blocks
+  if (ownRankNo == 0)
+  {
+    appendUInt64(dataArray.header, nBlocksGlobal);
+    appendUInt64(dataArray.header, blockSize);
+    appendUInt64(dataArray.header, nBytesGlobal % blockSize);
+
+    long long nCompressedBytesGlobal = 0;
+    for (long long compressedBlockSize : compressedBlockSizesGlobal)
+    {
+      appendUInt64(dataArray.header, compressedBlockSize);
+      nCompressedBytesGlobal += compressedBlockSize;
+    }
+    dataArray.nBytesGlobal = dataArray.header.size() + nCompressedBytesGlobal;
+  }
+
+  appendedDataArrays_.push_back(dataArray);
+}
+
+std::string Paraview::combinedFileFormatAttribute(int appendedArrayNo) const
+{
+  if (appendedOutput_)
+  {
+    assert(appendedArrayNo < appendedDataArrays_.size());
+
+    std::stringstream result;
+    result << "format=\"appended\" offset=\"" << appendedDataArrays_[appendedArrayNo].offset << "\"";
+    return result.str();
+  }
+  else if (binaryOutput_)
+  {
+    return std::string("format=\"binary\"");
+  }
+  return std::string("format=\"ascii\"");
+}
+
+std::string Paraview::combinedFileVTKFileAttributes() const
+{
+  if (!appendedOutput_)
+    return std::string("");
+
+  std::string result(" header_type=\"UInt64\"");
+  if (compression_ == compressionZlib)
+  {
+    result += " compressor=\"vtkZLibDataCompressor\"";
+  }
+  else if (compression_ == compressionLZ4)
+  {
+    result += " compressor=\"vtkLZ4DataCompressor\"";
+  }
+  return result;
+}
+
+void Paraview::writeAppendedData(MPI_File fileHandle, int ownRankNo)
+{
+  writeAsciiDataShared(fileHandle, ownRankNo, std::string(1, '\t') + "<AppendedData encoding=\"raw\">\n" + std::string(2, '\t') + "_");
+
+  for (const AppendedDataArray &dataArray : appendedDataArrays_)
+  {
+    // rank 0 writes the header, then all ranks write their data in the order of the ranks
+    writeAsciiDataShared(fileHandle, ownRankNo, dataArray.header);
+    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, dataArray.data.data(), dataArray.data.size(), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_write_ordered");
+  }
+
+  writeAsciiDataShared(fileHandle, ownRankNo, std::string("\n") + std::string(1, '\t') + "</AppendedData>\n</VTKFile>\n");
+
+  appendedDataArrays_.clear();
+}
+
+}  // namespace
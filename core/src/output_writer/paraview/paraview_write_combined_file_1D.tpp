@@ -314,7 +314,13 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
   // transform current time to string
   std::vector<double> time(1, this->currentTime_);
   std::string stringTime;
-  if (binaryOutput_)
+  if (appendedOutput_)
+  {
+    // the time is written in the appended data section by rank 0
+    if (ownRankNo != 0)
+      time.clear();
+  }
+  else if (binaryOutput_)
   {
     stringTime = Paraview::encodeBase64Float(time.begin(), time.end());
   }
@@ -323,17 +329,33 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     stringTime = Paraview::convertToAscii(time, fixedFormat_);
   }
 
+  // for appended output, encode (and compress) all data arrays already now, because the xml structure contains their offsets
+  if (appendedOutput_)
+  {
+    prepareAppendedDataArray(time);
+    for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = vtkPiece1D_.properties.pointDataArrays.begin();
+         pointDataArrayIter != vtkPiece1D_.properties.pointDataArrays.end(); pointDataArrayIter++)
+    {
+      bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";
+      prepareAppendedDataArray(fieldVariableValues[pointDataArrayIter->name], writeFloatsAsInt);
+    }
+    prepareAppendedDataArray(geometryFieldValues);
+    prepareAppendedDataArray(connectivityValues);
+    prepareAppendedDataArray(offsetValues);
+  }
+  int appendedArrayNo = 0;
+
   // create the basic structure of the output file
   std::vector<std::stringstream> outputFileParts(nOutputFileParts);
   int outputFilePartNo = 0;
   outputFileParts[outputFilePartNo] << "<?xml version=\"1.0\"?>" << std::endl
     << "<!-- " << DihuContext::versionText() << " " << DihuContext::metaText()
     << ", currentTime: " << this->currentTime_ << ", timeStepNo: " << this->timeStepNo_ << " -->" << std::endl
-    << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\">" << std::endl    // intel cpus are LittleEndian
+    << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\"" << combinedFileVTKFileAttributes() << ">" << std::endl    // intel cpus are LittleEndian
     << std::string(1, '\t') << "<PolyData>" << std::endl
     << std::string(2, '\t') << "<FieldData>" << std::endl
-    << std::string(3, '\t') << "<DataArray type=\"Float32\" Name=\"Time\" NumberOfTuples=\"1\" format=\"" << (binaryOutput_? "binary" : "ascii")
-    << "\" >" << std::endl
+    << std::string(3, '\t') << "<DataArray type=\"Float32\" Name=\"Time\" NumberOfTuples=\"1\" " << combinedFileFormatAttribute(appendedArrayNo++)
+    << " >" << std::endl
     << std::string(4, '\t') << stringTime << std::endl
     << std::string(3, '\t') << "</DataArray>" << std::endl
     << std::string(2, '\t') << "</FieldData>" << std::endl;
@@ -383,8 +405,8 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
         << "type=\"" << (pointDataArrayIter->name == "partitioning"? "Int32" : "Float32") << "\" "
         << "NumberOfComponents=\"" << pointDataArrayIter->nComponents << "\" "
         << componentNames.str()
-        << "format=\"" << (binaryOutput_? "binary" : "ascii")
-        << "\" >" << std::endl << std::string(5, '\t');
+        << combinedFileFormatAttribute(appendedArrayNo++)
+        << " >" << std::endl << std::string(5, '\t');
 
     // at this point the data of the field variable is missing
     outputFilePartNo++;
@@ -396,8 +418,8 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     << std::string(3, '\t') << "<CellData>" << std::endl
     << std::string(3, '\t') << "</CellData>" << std::endl
     << std::string(3, '\t') << "<Points>" << std::endl
-    << std::string(4, '\t') << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"" << (binaryOutput_? "binary" : "ascii")
-    << "\" >" << std::endl << std::string(5, '\t');
+    << std::string(4, '\t') << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" " << combinedFileFormatAttribute(appendedArrayNo++)
+    << " >" << std::endl << std::string(5, '\t');
 
   // at this point the data of points (geometry field) is missing
   outputFilePartNo++;
@@ -407,7 +429,7 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     << std::string(3, '\t') << "<Verts></Verts>" << std::endl
     << std::string(3, '\t') << "<Lines>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"connectivity\" type=\"Int32\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << combinedFileFormatAttribute(appendedArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the the structural information of the lines (connectivity) is missing
   outputFilePartNo++;
@@ -415,7 +437,7 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
   outputFileParts[outputFilePartNo]
     << std::endl << std::string(4, '\t') << "</DataArray>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"offsets\" type=\"Int32\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << combinedFileFormatAttribute(appendedArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the offset array will be written to the file
   outputFilePartNo++;
@@ -426,8 +448,11 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     << std::string(3, '\t') << "<Strips></Strips>" << std::endl
     << std::string(3, '\t') << "<Polys></Polys>" << std::endl
     << std::string(2, '\t') << "</Piece>" << std::endl
-    << std::string(1, '\t') << "</PolyData>" << std::endl
-    << "</VTKFile>" << std::endl;
+    << std::string(1, '\t') << "</PolyData>" << std::endl;
+
+  // for appended output, the closing tag follows after the <AppendedData> section
+  if (!appendedOutput_)
+    outputFileParts[outputFilePartNo] << "</VTKFile>" << std::endl;
 
   assert(outputFilePartNo+1 == nOutputFileParts);
 
@@ -451,55 +476,69 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
 
   Control::PerformanceMeasurement::start("durationParaview1DWrite");
 
-  // write beginning of file on rank 0
-  outputFilePartNo = 0;
+  if (appendedOutput_)
+  {
+    // the xml structure does not contain any inline data, write it at once, followed by the appended data of all ranks
+    std::stringstream xmlStructure;
+    for (std::vector<std::stringstream>::iterator iter = outputFileParts.begin(); iter != outputFileParts.end(); iter++)
+    {
+      xmlStructure << iter->str();
+    }
+    writeAsciiDataShared(fileHandle, ownRankNo, xmlStructure.str());
+    writeAppendedData(fileHandle, ownRankNo);
+  }
+  else
+  {
+    // write beginning of file on rank 0
+    outputFilePartNo = 0;
 
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  VLOG(1) << "get current shared file position";
+    VLOG(1) << "get current shared file position";
 
-  // get current file position
-  MPI_Offset currentFilePosition = 0;
-  MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
-  LOG(DEBUG) << "current shared file position: " << currentFilePosition;
+    // get current file position
+    MPI_Offset currentFilePosition = 0;
+    MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
+    LOG(DEBUG) << "current shared file position: " << currentFilePosition;
 
-  // write field variables
-  // loop over field variables
-  int fieldVariableNo = 0;
-  for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = vtkPiece1D_.properties.pointDataArrays.begin();
-       pointDataArrayIter != vtkPiece1D_.properties.pointDataArrays.end(); pointDataArrayIter++, fieldVariableNo++)
-  {
-    assert(fieldVariableValues.find(pointDataArrayIter->name) != fieldVariableValues.end());
+    // write field variables
+    // loop over field variables
+    int fieldVariableNo = 0;
+    for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = vtkPiece1D_.properties.pointDataArrays.begin();
+         pointDataArrayIter != vtkPiece1D_.properties.pointDataArrays.end(); pointDataArrayIter++, fieldVariableNo++)
+    {
+      assert(fieldVariableValues.find(pointDataArrayIter->name) != fieldVariableValues.end());
 
-    // write values
-    bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";    // for partitioning, convert float values to integer values for output
-    writeCombinedValuesVector(fileHandle, ownRankNo, fieldVariableValues[pointDataArrayIter->name], fieldVariableNo, writeFloatsAsInt);
+      // write values
+      bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";    // for partitioning, convert float values to integer values for output
+      writeCombinedValuesVector(fileHandle, ownRankNo, fieldVariableValues[pointDataArrayIter->name], fieldVariableNo, writeFloatsAsInt);
+
+      // write next xml constructs
+      writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+      outputFilePartNo++;
+    }
+
+    // write geometry field data
+    writeCombinedValuesVector(fileHandle, ownRankNo, geometryFieldValues, fieldVariableNo++);
 
     // write next xml constructs
     writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
     outputFilePartNo++;
-  }
 
-  // write geometry field data
-  writeCombinedValuesVector(fileHandle, ownRankNo, geometryFieldValues, fieldVariableNo++);
-
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // write connectivity values
+    writeCombinedValuesVector(fileHandle, ownRankNo, connectivityValues, fieldVariableNo++);
 
-  // write connectivity values
-  writeCombinedValuesVector(fileHandle, ownRankNo, connectivityValues, fieldVariableNo++);
-
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  // write offset values
-  writeCombinedValuesVector(fileHandle, ownRankNo, offsetValues, fieldVariableNo++);
+    // write offset values
+    writeCombinedValuesVector(fileHandle, ownRankNo, offsetValues, fieldVariableNo++);
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+  }
 
   /*
     int array_of_sizes[1];
@@ -5,6 +5,7 @@
 #include <thread>
 #include <chrono>
 #include <cstdio>  // remove
+#include <cstring>
 
 #include "easylogging++.h"
 #include "base64.h"
@@ -273,4 +274,31 @@ void Paraview::writeCombinedValuesVector(MPI_File fileHandle, int ownRankNo, con
   MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_write_ordered");
 }
 
+template<typename T>
+void Paraview::prepareAppendedDataArray(const std::vector<T> &values, bool writeFloatsAsInt)
+{
+  // convert the values to raw little endian Float32 or Int32 data, as in the inline binary output
+  std::string rawData(values.size()*4, '\0');
+  char *rawDataPointer = &rawData[0];
+
+  if ((std::is_same<T,double>::value || std::is_same<T,float>::value) && !writeFloatsAsInt)
+  {
+    for (int i = 0; i < values.size(); i++)
+    {
+      float value = (float)values[i];
+      std::memcpy(rawDataPointer + 4*i, &value, 4);
+    }
+  }
+  else
+  {
+    for (int i = 0; i < values.size(); i++)
+    {
+      int32_t value = (int32_t)(round(values[i]));
+      std::memcpy(rawDataPointer + 4*i, &value, 4);
+    }
+  }
+
+  prepareAppendedDataArray(rawData);
+}
+
 } // namespace
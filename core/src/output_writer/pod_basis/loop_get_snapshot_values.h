@@ -0,0 +1,70 @@
+#pragma once
+
+#include "utility/type_utility.h"
+#include "mesh/type_traits.h"
+
+#include <cstdlib>
+
+/** The functions in this file model a loop over the elements of a tuple, as it occurs as FieldVariablesForOutputWriterType in all data_management classes.
+ *  (Because the types inside the tuple are static and fixed at compile-time, a simple for loop c not work here.)
+ *  The two functions starting with loop recursively emulate the loop. One method is the break condition and does nothing, the other method does the work and calls the method without loop in the name.
+ *  FieldVariablesForOutputWriterType is assumed to be of type std::tuple<...>> where the types can be (mixed) std::shared_ptr<FieldVariable> or std::vector<std::shared_ptr<FieldVariable>>.
+ *
+ *  Get the local values without ghosts of the field variable with the given name, or of the first field variable that is not a geometry field if fieldVariableName is empty.
+ *  The values of the components are stored one after another (x x x y y y z z z), which is the layout of a snapshot for the POD basis.
+ *  Also get the global natural dof numbers of the local dofs and the global number of dofs, such that the basis can be stored independent of the partitioning.
+ *  The iteration stops at the first matching field variable.
+ */
+
+namespace OutputWriter
+{
+
+namespace PodBasisLoopOverTuple
+{
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ *  Stopping criterion
+ */
+template<typename FieldVariablesForOutputWriterType, int i=0>
+inline typename std::enable_if<i == std::tuple_size<FieldVariablesForOutputWriterType>::value, bool>::type
+loopGetSnapshotValues(const FieldVariablesForOutputWriterType &fieldVariables, std::string fieldVariableName,
+                      std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal
+)
+{return false;}
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ * Loop body
+ */
+template<typename FieldVariablesForOutputWriterType, int i=0>
+inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, bool>::type
+loopGetSnapshotValues(const FieldVariablesForOutputWriterType &fieldVariables, std::string fieldVariableName,
+                      std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal);
+
+/** Loop body for a vector element
+ */
+template<typename VectorType>
+typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
+getSnapshotValues(VectorType currentFieldVariableVector, std::string fieldVariableName, std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal);
+
+/** Loop body for a tuple element
+ */
+template<typename VectorType>
+typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
+getSnapshotValues(VectorType currentFieldVariableTuple, std::string fieldVariableName, std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal);
+
+ /**  Loop body for a pointer element
+ */
+template<typename CurrentFieldVariableType>
+typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value, bool>::type
+getSnapshotValues(CurrentFieldVariableType currentFieldVariable, std::string fieldVariableName, std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal);
+
+}  // namespace PodBasisLoopOverTuple
+
+}  // namespace OutputWriter
+
+#include "output_writer/pod_basis/loop_get_snapshot_values.tpp"
@@ -0,0 +1,99 @@
+#include "output_writer/pod_basis/loop_get_snapshot_values.h"
+
+#include <cstdlib>
+#include "field_variable/field_variable.h"
+
+namespace OutputWriter
+{
+
+namespace PodBasisLoopOverTuple
+{
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ * Loop body
+ */
+template<typename FieldVariablesForOutputWriterType, int i>
+inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, bool>::type
+loopGetSnapshotValues(const FieldVariablesForOutputWriterType &fieldVariables, std::string fieldVariableName,
+                      std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal
+)
+{
+  // call what to do in the loop body
+  if (getSnapshotValues<typename std::tuple_element<i,FieldVariablesForOutputWriterType>::type>(
+        std::get<i>(fieldVariables), fieldVariableName, values, nComponents, dofNosGlobalNatural, nDofsGlobal))
+    return true;
+
+  // advance iteration to next tuple element
+  return loopGetSnapshotValues<FieldVariablesForOutputWriterType, i+1>(fieldVariables, fieldVariableName, values, nComponents, dofNosGlobalNatural, nDofsGlobal);
+}
+
+// current element is of pointer type (not vector)
+template<typename CurrentFieldVariableType>
+typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value, bool>::type
+getSnapshotValues(CurrentFieldVariableType currentFieldVariable, std::string fieldVariableName, std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal)
+{
+  if (!currentFieldVariable || !currentFieldVariable->functionSpace())
+    return false;
+
+  // select the field variable with the given name or the first one that is not a geometry field
+  if (fieldVariableName.empty())
+  {
+    if (currentFieldVariable->isGeometryField())
+      return false;
+  }
+  else if (currentFieldVariable->name() != fieldVariableName)
+  {
+    return false;
+  }
+
+  nComponents = CurrentFieldVariableType::element_type::nComponents();
+  values.clear();
+
+  // get the local values without ghosts, one component after the other
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+  {
+    std::vector<double> componentValues;
+    currentFieldVariable->getValuesWithoutGhosts(componentNo, componentValues);
+    values.insert(values.end(), componentValues.begin(), componentValues.end());
+  }
+
+  // get the global natural numbers of the local dofs, they are in the same order as the values of one component
+  std::vector<global_no_t> dofNosGlobalNaturalFunctionSpace;
+  currentFieldVariable->functionSpace()->meshPartition()->getDofNosGlobalNatural(dofNosGlobalNaturalFunctionSpace);
+  dofNosGlobalNatural.assign(dofNosGlobalNaturalFunctionSpace.begin(), dofNosGlobalNaturalFunctionSpace.end());
+  nDofsGlobal = currentFieldVariable->functionSpace()->meshPartition()->nDofsGlobal();
+
+  VLOG(1) << "got snapshot of field variable \"" << currentFieldVariable->name() << "\", " << nComponents << " components, " << values.size() << " local values";
+
+  return true;  // break iteration
+}
+
+// element i is of vector type
+template<typename VectorType>
+typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
+getSnapshotValues(VectorType currentFieldVariableVector, std::string fieldVariableName, std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal)
+{
+  for (auto& currentFieldVariable : currentFieldVariableVector)
+  {
+    // call function on all vector entries
+    if (getSnapshotValues<typename VectorType::value_type>(currentFieldVariable, fieldVariableName, values, nComponents, dofNosGlobalNatural, nDofsGlobal))
+      return true; // break iteration
+  }
+  return false;  // do not break iteration
+}
+
+// element i is of tuple type
+template<typename TupleType>
+typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
+getSnapshotValues(TupleType currentFieldVariableTuple, std::string fieldVariableName, std::vector<double> &values, int &nComponents,
+                      std::vector<long long> &dofNosGlobalNatural, long long &nDofsGlobal)
+{
+  // call for tuple element
+  return loopGetSnapshotValues<TupleType>(currentFieldVariableTuple, fieldVariableName, values, nComponents, dofNosGlobalNatural, nDofsGlobal);
+}
+
+}  // namespace PodBasisLoopOverTuple
+}  // namespace OutputWriter
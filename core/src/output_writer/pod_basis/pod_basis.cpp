@@ -0,0 +1,55 @@
+#include "output_writer/pod_basis/pod_basis.h"
+
+#include "easylogging++.h"
+#include "utility/python_utility.h"
+#include "utility/svd_utility.h"
+#include "utility/mpi_utility.h"
+
+namespace OutputWriter
+{
+
+PodBasis::PodBasis(DihuContext context, PythonConfig settings, std::shared_ptr<Partition::RankSubset> rankSubset) :
+  Generic(context, settings, rankSubset),
+  incrementalSvd_(this->rankSubset_->mpiCommunicator(),
+                  settings.getOptionInt("nModes", 20, PythonUtility::Positive),
+                  settings.getOptionInt("blockSize", 10, PythonUtility::Positive),
+                  settings.getOptionDouble("truncationTolerance", 1e-10, PythonUtility::NonNegative)),
+  nComponents_(-1), nSnapshotsWritten_(0), nDofsGlobal_(0)
+{
+  fieldVariableName_ = settings.getOptionString("fieldVariableName", "");
+}
+
+PodBasis::~PodBasis()
+{
+  writeBasis();
+}
+
+void PodBasis::writeBasis()
+{
+  // nothing to do if no new snapshot was added since the last time the basis was written, all ranks have the same number of snapshots
+  if (incrementalSvd_.nSnapshots() == nSnapshotsWritten_)
+    return;
+
+  incrementalSvd_.flush();
+  nSnapshotsWritten_ = incrementalSvd_.nSnapshots();
+
+  std::string filename = filenameBase_ + ".pod";
+
+  // create the output directory
+  if (this->rankSubset_->ownRankNo() == 0)
+  {
+    std::ofstream file;
+    openFile(file, filename);
+    file.close();
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(this->rankSubset_->mpiCommunicator()), "MPI_Barrier");
+
+  SvdUtility::writeBasisBinary(filename, incrementalSvd_.leftSingularVectors(), incrementalSvd_.singularValues(),
+                               dofNosGlobalNatural_, nDofsGlobal_, nComponents_, this->rankSubset_->mpiCommunicator());
+
+  const std::vector<double> &singularValues = incrementalSvd_.singularValues();
+  LOG(INFO) << "PodBasis: wrote " << singularValues.size() << " modes of " << nSnapshotsWritten_ << " snapshots to \"" << filename << "\""
+    << (singularValues.empty()? "" : ", singular values " + std::to_string(singularValues.front()) + " ... " + std::to_string(singularValues.back()));
+}
+
+} // namespace
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+
+#include "control/types.h"
+#include "output_writer/generic.h"
+#include "utility/incremental_svd.h"
+
+namespace OutputWriter
+{
+
+/** Output writer that computes a POD basis (proper orthogonal decomposition) from the values of one field variable on the fly,
+ *  instead of writing snapshot files that are post-processed offline. Every call to write that is due according to outputInterval adds one snapshot
+ *  to a distributed incremental SVD, only the current truncated basis and a block of blockSize snapshots are kept in memory.
+ *  When the output writer is destroyed, the basis is written collectively to the binary file "<filename>.pod", which can be used by ModelOrderReduction with the option "basisFile".
+ *  The rows of the basis are stored in global natural dof order, therefore the file does not depend on the partitioning.
+ */
+class PodBasis : public Generic
+{
+public:
+
+  //! constructor
+  PodBasis(DihuContext context, PythonConfig specificSettings, std::shared_ptr<Partition::RankSubset> rankSubset = nullptr);
+
+  //! destructor, writes the basis file
+  virtual ~PodBasis();
+
+  //! add the current values of the field variable as snapshot
+  template<typename DataType>
+  void write(DataType &data, int timeStepNo = -1, double currentTime = -1, int callCountIncrement = 1);
+
+  //! update the basis with all added snapshots and write it to the file, collective
+  void writeBasis();
+
+private:
+
+  IncrementalSvd incrementalSvd_;     //< the incremental SVD of the snapshot matrix
+  std::string fieldVariableName_;     //< name of the field variable whose values are the snapshots, empty for the first field variable that is not a geometry field
+  int nComponents_;                   //< number of components of the field variable, -1 before the first snapshot
+  int nSnapshotsWritten_;             //< number of snapshots that were contained in the last written basis
+  std::vector<long long> dofNosGlobalNatural_;  //< global natural dof numbers of the local rows of one component, they determine the rows in the basis file
+  long long nDofsGlobal_;             //< global number of dofs of one component
+};
+
+} // namespace
+
+#include "output_writer/pod_basis/pod_basis.tpp"
@@ -0,0 +1,42 @@
+#include "output_writer/pod_basis/pod_basis.h"
+
+#include "easylogging++.h"
+
+#include "output_writer/pod_basis/loop_get_snapshot_values.h"
+
+namespace OutputWriter
+{
+
+template<typename DataType>
+void PodBasis::write(DataType& data, int timeStepNo, double currentTime, int callCountIncrement)
+{
+  // check if a snapshot should be taken in this timestep
+  if (!Generic::prepareWrite(data, timeStepNo, currentTime, callCountIncrement))
+  {
+    return;
+  }
+
+  typedef typename DataType::FieldVariablesForOutputWriter FieldVariablesForOutputWriterType;
+  FieldVariablesForOutputWriterType fieldVariables = data.getFieldVariablesForOutputWriter();
+
+  std::vector<double> snapshot;
+  int nComponents = 0;
+  std::vector<long long> dofNosGlobalNatural;
+  long long nDofsGlobal = 0;
+  if (!PodBasisLoopOverTuple::loopGetSnapshotValues<FieldVariablesForOutputWriterType>(fieldVariables, fieldVariableName_, snapshot, nComponents,
+                                                                                        dofNosGlobalNatural, nDofsGlobal))
+  {
+    LOG(ERROR) << specificSettings_.getStringPath() << ": PodBasis output writer: field variable \"" << fieldVariableName_ << "\" was not found, no snapshot is taken.";
+    return;
+  }
+
+  if (nComponents_ == -1)
+  {
+    nComponents_ = nComponents;
+    dofNosGlobalNatural_ = dofNosGlobalNatural;
+    nDofsGlobal_ = nDofsGlobal;
+  }
+  incrementalSvd_.addSnapshot(snapshot);
+}
+
+} // namespace
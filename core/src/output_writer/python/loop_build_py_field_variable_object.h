@@ -4,6 +4,7 @@
 #include "mesh/type_traits.h"
 
 #include <cstdlib>
+#include <vector>
 
 /** The functions in this file model a loop over the elements of a tuple, as it occurs as FieldVariablesForOutputWriterType in all data_management classes.
  *  (Because the types inside the tuple are static and fixed at compile-time, a simple for loop c not work here.)
@@ -14,6 +15,13 @@
 namespace OutputWriter
 {
 
+//! the values of a field variable, collected for binary output instead of python lists of the values
+struct FieldVariableValues
+{
+  int nComponents;                //< number of components of the field variable
+  std::vector<double> values;     //< the values of all components after each other
+};
+
 namespace PythonLoopOverTuple
 {
  
@@ -23,7 +31,8 @@ namespace PythonLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i == std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopBuildPyFieldVariableObject(const FieldVariablesForOutputWriterType &fieldVariables, int &fieldVariableIndex, std::string meshName, 
-                               PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+                               PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                               std::vector<FieldVariableValues> *fieldVariableValues)
 {}
 
  /** Static recursive loop from 0 to number of entries in the tuple
@@ -32,35 +41,40 @@ loopBuildPyFieldVariableObject(const FieldVariablesForOutputWriterType &fieldVar
 template<typename FieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopBuildPyFieldVariableObject(const FieldVariablesForOutputWriterType &fieldVariables, int &fieldVariableIndex, std::string meshName, 
-                               PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh);
+                               PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                               std::vector<FieldVariableValues> *fieldVariableValues);
 
 /** Loop body for a vector element
  */
 template<typename VectorType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 buildPyFieldVariableObject(VectorType currentFieldVariableGradient, int &fieldVariableIndex, std::string meshName, 
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh);
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues);
 
 /** Loop body for a tuple element
  */
 template<typename VectorType>
 typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
 buildPyFieldVariableObject(VectorType currentFieldVariableGradient, int &fieldVariableIndex, std::string meshName, 
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh);
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues);
 
 /**  Loop body for a pointer element
  */
 template<typename CurrentFieldVariableType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &fieldVariableIndex, std::string meshName, 
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh);
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues);
 
 /** Loop body for a field variables with Mesh::CompositeOfDimension<D>
  */
 template<typename CurrentFieldVariableType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &fieldVariableIndex, std::string meshName,
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh);
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues);
 
 }  // namespace ExfileLoopOverTuple
 
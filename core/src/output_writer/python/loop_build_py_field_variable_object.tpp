@@ -15,22 +15,24 @@ namespace PythonLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, int i>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopBuildPyFieldVariableObject(const FieldVariablesForOutputWriterType &fieldVariables, int &fieldVariableIndex, std::string meshName, 
-                               PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+                               PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                               std::vector<FieldVariableValues> *fieldVariableValues)
 {
   // call what to do in the loop body
   if (buildPyFieldVariableObject<typename std::tuple_element<i,FieldVariablesForOutputWriterType>::type>(
-       std::get<i>(fieldVariables), fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh))
+       std::get<i>(fieldVariables), fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh, fieldVariableValues))
     return;
   
   // advance iteration to next tuple element
-  loopBuildPyFieldVariableObject<FieldVariablesForOutputWriterType, i+1>(fieldVariables, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh);
+  loopBuildPyFieldVariableObject<FieldVariablesForOutputWriterType, i+1>(fieldVariables, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh, fieldVariableValues);
 }
  
 // current element is of pointer type (not vector)
 template<typename CurrentFieldVariableType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &fieldVariableIndex, std::string meshName, 
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues)
 {
   // if the field variable is a null pointer, return but do not break iteration
   if (!currentFieldVariable)
@@ -54,6 +56,15 @@ buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &f
   const int nComponents = currentFieldVariable->nComponents();
   PyObject *pyComponents = PyList_New((Py_ssize_t)nComponents);
 
+  // if the values are collected for binary output, the python object only contains the component names
+  FieldVariableValues *currentFieldVariableValues = nullptr;
+  if (fieldVariableValues)
+  {
+    fieldVariableValues->emplace_back();
+    currentFieldVariableValues = &fieldVariableValues->back();
+    currentFieldVariableValues->nComponents = nComponents;
+  }
+
   // loop over components of field variable
   for (int componentNo = 0; componentNo < nComponents; componentNo++)
   {
@@ -65,7 +76,17 @@ buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &f
 
     VLOG(2) << "  values: " << values << ", values.size(): " << values.size();
 
-    PyObject *pyValues = PythonUtility::convertToPythonList(values);
+    PyObject *pyValues = Py_None;
+    if (currentFieldVariableValues)
+    {
+      currentFieldVariableValues->values.reserve(nComponents*values.size());
+      currentFieldVariableValues->values.insert(currentFieldVariableValues->values.end(), values.begin(), values.end());
+    }
+    else
+    {
+      pyValues = PythonUtility::convertToPythonList(values);
+    }
+
     VLOG(2) << " create pyComponent";
     PyObject *pyComponent = Py_BuildValue("{s s, s O}", "name", componentName.c_str(), "values", pyValues);
 
@@ -98,12 +119,13 @@ buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &f
 template<typename VectorType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 buildPyFieldVariableObject(VectorType currentFieldVariableGradient, int &fieldVariableIndex, std::string meshName,
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues)
 {
   for (auto& currentFieldVariable : currentFieldVariableGradient)
   {
     // call function on all vector entries
-    if (buildPyFieldVariableObject<typename VectorType::value_type>(currentFieldVariable, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh))
+    if (buildPyFieldVariableObject<typename VectorType::value_type>(currentFieldVariable, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh, fieldVariableValues))
       return true;
   }
 
@@ -114,11 +136,12 @@ buildPyFieldVariableObject(VectorType currentFieldVariableGradient, int &fieldVa
 template<typename TupleType>
 typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
 buildPyFieldVariableObject(TupleType currentFieldVariableTuple, int &fieldVariableIndex, std::string meshName, 
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues)
 {
   // call for tuple element
   loopBuildPyFieldVariableObject<TupleType>(currentFieldVariableTuple, fieldVariableIndex, meshName,
-                                            pyData, onlyNodalValues, mesh);
+                                            pyData, onlyNodalValues, mesh, fieldVariableValues);
   
   return false;  // do not break iteration
 }
@@ -127,7 +150,8 @@ buildPyFieldVariableObject(TupleType currentFieldVariableTuple, int &fieldVariab
 template<typename CurrentFieldVariableType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &fieldVariableIndex, std::string meshName,
-                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+                           PyObject *pyData, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                           std::vector<FieldVariableValues> *fieldVariableValues)
 {
   const int D = CurrentFieldVariableType::element_type::FunctionSpace::dim();
   typedef typename CurrentFieldVariableType::element_type::FunctionSpace::BasisFunction BasisFunctionType;
@@ -142,7 +166,7 @@ buildPyFieldVariableObject(CurrentFieldVariableType currentFieldVariable, int &f
   for (auto& currentSubFieldVariable : subFieldVariables)
   {
     // call function on all vector entries
-    if (buildPyFieldVariableObject<std::shared_ptr<SubFieldVariableType>>(currentSubFieldVariable, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh))
+    if (buildPyFieldVariableObject<std::shared_ptr<SubFieldVariableType>>(currentSubFieldVariable, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh, fieldVariableValues))
       return true;
   }
 
@@ -29,9 +29,10 @@ class Python<FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimensio
 public:
   typedef FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<D>,BasisFunctionType> FunctionSpaceType;
 
-  //! call python callback
+  //! create the python dict with all data and meta data, if fieldVariableValues is given, the values are collected there instead of in the dict
   static PyObject *buildPyDataObject(FieldVariablesForOutputWriterType fieldVariables,
-                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues);
+                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues,
+                                     std::vector<FieldVariableValues> *fieldVariableValues = nullptr);
 };
 
 // specialization for StructuredDeformable
@@ -42,9 +43,10 @@ class Python<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<
 public:
   typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>,BasisFunctionType> FunctionSpaceType;
 
-  //! call python callback
+  //! create the python dict with all data and meta data, if fieldVariableValues is given, the values are collected there instead of in the dict
   static PyObject *buildPyDataObject(FieldVariablesForOutputWriterType fieldVariables,
-                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues);
+                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues,
+                                     std::vector<FieldVariableValues> *fieldVariableValues = nullptr);
 };
 
 // specialization for Composite
@@ -56,9 +58,10 @@ public:
   // the function space is StructuredDeformable whereas the FunctionSpace of the class is CompositeOfDimension
   typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>,BasisFunctionType> FunctionSpaceType;
 
-  //! call python callback
+  //! create the python dict with all data and meta data, if fieldVariableValues is given, the values are collected there instead of in the dict
   static PyObject *buildPyDataObject(FieldVariablesForOutputWriterType fieldVariables,
-                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues);
+                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues,
+                                     std::vector<FieldVariableValues> *fieldVariableValues = nullptr);
 };
 
 // specialization for UnstructuredDeformable
@@ -69,9 +72,10 @@ class Python<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimensio
 public:
   typedef FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>,BasisFunctionType> FunctionSpaceType;
 
-  //! call python callback
+  //! create the python dict with all data and meta data, if fieldVariableValues is given, the values are collected there instead of in the dict
   static PyObject *buildPyDataObject(FieldVariablesForOutputWriterType fieldVariables,
-                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues);
+                                     std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues,
+                                     std::vector<FieldVariableValues> *fieldVariableValues = nullptr);
 private:
   
   //! create a list of list where for each element the dofs are listed (if !onlyNodalValues) or the node numbers (if onlyNodalValues)
@@ -4,6 +4,8 @@
 #include <iostream>
 #include <vector>
 
+#include "output_writer/python/loop_build_py_field_variable_object.h"
+
 namespace OutputWriter
 {
 
@@ -16,7 +18,9 @@ class PythonBase
 public:
   //! create a python dict that contains data and meta data of field variables
   //! @param onlyNodalValues: if only values at nodes should be contained, this discards the derivative values for Hermite
-  static PyObject *buildPyFieldVariablesObject(FieldVariablesForOutputWriterType fieldVariables, std::string meshName, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh);
+  //! @param fieldVariableValues: if given, the values are collected in this vector instead of python lists and the "values" entries are None
+  static PyObject *buildPyFieldVariablesObject(FieldVariablesForOutputWriterType fieldVariables, std::string meshName, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                                               std::vector<FieldVariableValues> *fieldVariableValues = nullptr);
 };
 
 } // namespace
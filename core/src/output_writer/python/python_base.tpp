@@ -14,7 +14,8 @@ namespace OutputWriter
 
 template<typename FieldVariablesForOutputWriterType>
 PyObject *PythonBase<FieldVariablesForOutputWriterType>::
-buildPyFieldVariablesObject(FieldVariablesForOutputWriterType fieldVariables, std::string meshName, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh)
+buildPyFieldVariablesObject(FieldVariablesForOutputWriterType fieldVariables, std::string meshName, bool onlyNodalValues, std::shared_ptr<Mesh::Mesh> &mesh,
+                            std::vector<FieldVariableValues> *fieldVariableValues)
 {
   // build python dict containing field variables
   // [
@@ -34,7 +35,7 @@ buildPyFieldVariablesObject(FieldVariablesForOutputWriterType fieldVariables, st
   PyObject *pyData = PyList_New((Py_ssize_t)nFieldVariablesInMesh);
 
   int fieldVariableIndex = 0;
-  PythonLoopOverTuple::loopBuildPyFieldVariableObject<FieldVariablesForOutputWriterType>(fieldVariables, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh);
+  PythonLoopOverTuple::loopBuildPyFieldVariableObject<FieldVariablesForOutputWriterType>(fieldVariables, fieldVariableIndex, meshName, pyData, onlyNodalValues, mesh, fieldVariableValues);
 
   return pyData;
 }
@@ -12,7 +12,8 @@ namespace OutputWriter
 template<int D, typename BasisFunctionType, typename FieldVariablesForOutputWriterType>
 PyObject *Python<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<D>,BasisFunctionType>,FieldVariablesForOutputWriterType>::
 buildPyDataObject(FieldVariablesForOutputWriterType fieldVariables,
-                  std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues)
+                  std::string meshName, int timeStepNo, double currentTime, bool onlyNodalValues,
+                  std::vector<FieldVariableValues> *fieldVariableValues)
 {
   // build python dict containing all information
   // data = {
@@ -35,7 +36,7 @@ buildPyDataObject(FieldVariablesForOutputWriterType fieldVariables,
 
   // build python object for data
   std::shared_ptr<Mesh::Mesh> meshBase;
-  PyObject *pyData = PythonBase<FieldVariablesForOutputWriterType>::buildPyFieldVariablesObject(fieldVariables, meshName, onlyNodalValues, meshBase);
+  PyObject *pyData = PythonBase<FieldVariablesForOutputWriterType>::buildPyFieldVariablesObject(fieldVariables, meshName, onlyNodalValues, meshBase, fieldVariableValues);
 
   // cast mesh to its real type
   typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>,BasisFunctionType> FunctionSpaceType;
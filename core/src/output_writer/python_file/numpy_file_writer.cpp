@@ -0,0 +1,117 @@
+#include "output_writer/python_file/numpy_file_writer.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#include "utility/mpi_utility.h"
+#include "easylogging++.h"
+
+namespace OutputWriter
+{
+
+NumpyFileWriter::NumpyFileWriter(std::string metaDataJson)
+{
+  appendArrayHeader("|u1", std::vector<long long>{(long long)metaDataJson.size()});
+  buffer_.append(metaDataJson);
+}
+
+void NumpyFileWriter::addFieldVariable(const std::vector<double> &values, int nComponents)
+{
+  long long nValues = (nComponents == 0? 0 : values.size() / nComponents);
+  appendArrayHeader(nativeDescriptor('f', sizeof(double)), std::vector<long long>{(long long)nComponents, nValues});
+  buffer_.append((const char *)values.data(), values.size()*sizeof(double));
+}
+
+void NumpyFileWriter::addFieldVariableChunks(const std::vector<int> &chunkSources, const std::vector<double> &chunkValues)
+{
+  static_assert(sizeof(int) == 4, "int32 is expected for the chunk sources");
+
+  appendArrayHeader(nativeDescriptor('i', sizeof(int)), std::vector<long long>{(long long)chunkSources.size()});
+  buffer_.append((const char *)chunkSources.data(), chunkSources.size()*sizeof(int));
+
+  appendArrayHeader(nativeDescriptor('f', sizeof(double)), std::vector<long long>{(long long)chunkValues.size()});
+  buffer_.append((const char *)chunkValues.data(), chunkValues.size()*sizeof(double));
+}
+
+std::string NumpyFileWriter::nativeDescriptor(char kind, int nBytes)
+{
+  const uint16_t endiannessTest = 1;
+  std::stringstream descriptor;
+  descriptor << (*(const char *)&endiannessTest == 1? "<" : ">") << kind << nBytes;
+  return descriptor.str();
+}
+
+void NumpyFileWriter::appendArrayHeader(std::string descriptor, const std::vector<long long> &shape)
+{
+  // format version 1.0, see numpy.lib.format
+  std::stringstream dict;
+  dict << "{'descr': '" << descriptor << "', 'fortran_order': False, 'shape': (";
+  for (long long extent : shape)
+  {
+    dict << extent << ", ";
+  }
+  dict << "), }";
+
+  // the header has to be padded with spaces and terminated by a newline such that the data starts at a multiple of 64 bytes
+  const int preambleLength = 10;
+  std::string header = dict.str();
+  int nPaddingCharacters = 64 - (preambleLength + header.size() + 1) % 64;
+  if (nPaddingCharacters == 64)
+    nPaddingCharacters = 0;
+  header.append(nPaddingCharacters, ' ');
+  header.append("\n");
+
+  // the header length is stored as little endian uint16
+  const char magic[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0};
+  buffer_.append(magic, 8);
+  buffer_.push_back((char)(header.size() & 0xff));
+  buffer_.push_back((char)((header.size() >> 8) & 0xff));
+  buffer_.append(header);
+}
+
+void NumpyFileWriter::write(std::string filename)
+{
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    LOG(ERROR) << "Could not open file \"" << filename << "\" for writing.";
+    return;
+  }
+
+  file.write(buffer_.data(), buffer_.size());
+  file.close();
+
+  LOG(INFO) << "Binary file \"" << filename << "\" written.";
+}
+
+void NumpyFileWriter::writeCombined(std::string filename, MPI_Comm mpiCommunicator)
+{
+  int ownRankNo = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator, &ownRankNo), "MPI_Comm_rank");
+
+  // determine the offset of the own block in the file, the blocks are in the order of the ranks
+  long long blockSize = buffer_.size();
+  long long blockOffset = 0;
+  long long fileSize = 0;
+  MPIUtility::handleReturnValue(MPI_Exscan(&blockSize, &blockOffset, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Allreduce(&blockSize, &fileSize, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+
+  // MPI_Exscan leaves the result on rank 0 undefined
+  if (ownRankNo == 0)
+    blockOffset = 0;
+
+  MPI_File fileHandle;
+  MPIUtility::handleReturnValue(MPI_File_open(mpiCommunicator, filename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                              MPI_INFO_NULL, &fileHandle), "MPI_File_open");
+
+  // truncate an existing longer file
+  MPIUtility::handleReturnValue(MPI_File_set_size(fileHandle, fileSize), "MPI_File_set_size");
+
+  MPIUtility::handleReturnValue(MPI_File_write_at_all(fileHandle, blockOffset, buffer_.data(), buffer_.size(), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_write_at_all");
+  MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+
+  LOG(INFO) << "Binary file \"" << filename << "\" written.";
+}
+
+} // namespace
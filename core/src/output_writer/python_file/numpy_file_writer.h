@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+namespace OutputWriter
+{
+
+/** Writes the data of the PythonFile output writer as a sequence of arrays in the NumPy .npy format ("*.npys" files).
+ *  A block consists of one uint8 array with the JSON encoded meta data (the same dict as for the ASCII output but with "values": None),
+ *  followed by one float64 array of shape (nComponents, nValues) for every field variable in the order of the "data" list.
+ *  The arrays can be read consecutively from an opened file with numpy.load, as done by scripts/py_reader.py.
+ *
+ *  Every rank writes one block, either into its own file or, combined with MPI-IO, all blocks in the order of the ranks into a single file.
+ *
+ *  For delta output, the values of a field variable are split into chunks and only the chunks that changed are stored.
+ *  Then a field variable consists of an int32 array with the source of every chunk, -1 if it is stored in this block or the index into
+ *  the list "referencedFiles" of the meta data, followed by a float64 array with the stored chunks after each other.
+ */
+class NumpyFileWriter
+{
+public:
+
+  //! constructor, start a new block with the meta data
+  NumpyFileWriter(std::string metaDataJson);
+
+  //! add the values of a field variable, values contains the nComponents components after each other
+  void addFieldVariable(const std::vector<double> &values, int nComponents);
+
+  //! add the delta encoded values of a field variable, chunkSources contains the source of every chunk, chunkValues the values of the chunks with source -1
+  void addFieldVariableChunks(const std::vector<int> &chunkSources, const std::vector<double> &chunkValues);
+
+  //! write the block to its own file, this is not collective
+  void write(std::string filename);
+
+  //! collectively write the blocks of all ranks in the communicator to a single file
+  void writeCombined(std::string filename, MPI_Comm mpiCommunicator);
+
+private:
+
+  //! append the header of a .npy array with the given numpy type descriptor and shape to buffer_
+  void appendArrayHeader(std::string descriptor, const std::vector<long long> &shape);
+
+  //! get the numpy type descriptor of the given type in native byte order, e.g. "<f8"
+  static std::string nativeDescriptor(char kind, int nBytes);
+
+  std::string buffer_;    //< the serialized block of the own rank
+};
+
+} // namespace
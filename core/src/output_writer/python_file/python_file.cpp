@@ -2,9 +2,14 @@
 
 #include <Python.h>  // has to be the first included header
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
 
 #include "easylogging++.h"
 #include "utility/python_utility.h"
+#include "utility/mpi_utility.h"
+#include "output_writer/python_file/numpy_file_writer.h"
 
 namespace OutputWriter
 {
@@ -13,6 +18,23 @@ PythonFile::PythonFile(DihuContext context, PythonConfig settings, std::shared_p
   Generic(context, settings, rankSubset)
 {
   onlyNodalValues_ = settings.getOptionBool("onlyNodalValues", true);
+  numpyOutput_ = settings.getOptionBool("numpy", false);
+  combineFiles_ = settings.getOptionBool("combineFiles", false);
+  deltaOutput_ = settings.getOptionBool("deltaOutput", false);
+  deltaChunkSize_ = settings.getOptionInt("deltaChunkSize", 1024, PythonUtility::Positive);
+  deltaTolerance_ = settings.getOptionDouble("deltaTolerance", 0.0, PythonUtility::NonNegative);
+
+  if (combineFiles_ && !numpyOutput_)
+  {
+    LOG(WARNING) << settings.getStringPath() << "[\"combineFiles\"] is only possible with \"numpy\": True. Writing separate files for every rank.";
+    combineFiles_ = false;
+  }
+
+  if (deltaOutput_ && !numpyOutput_)
+  {
+    LOG(WARNING) << settings.getStringPath() << "[\"deltaOutput\"] is only possible with \"numpy\": True. Writing all values.";
+    deltaOutput_ = false;
+  }
 }
 
 PyObject *PythonFile::openPythonFileStream(std::string filename, std::string writeFlag)
@@ -84,4 +106,180 @@ void PythonFile::outputPyObject(PyObject *file, PyObject *pyData)
 #endif
 }
 
+void PythonFile::writeNumpyFile(std::string filename, std::string meshName, PyObject *pyData, const std::vector<FieldVariableValues> &fieldVariableValues)
+{
+  // load json module
+  static PyObject *jsonModule = NULL;
+  if (jsonModule == NULL)
+  {
+    jsonModule = PyImport_ImportModule("json");
+  }
+  if (jsonModule == NULL)
+  {
+    LOG(ERROR) << "Could not import json module";
+    return;
+  }
+
+  // the meta data is stored as json string, it does not contain the values
+  PyObject *pyMetaDataJson = PyObject_CallMethod(jsonModule, "dumps", "(O)", pyData);
+  std::string metaDataJson = PythonUtility::pyUnicodeToString(pyMetaDataJson);
+  Py_XDECREF(pyMetaDataJson);
+
+  if (!deltaOutput_)
+  {
+    NumpyFileWriter numpyFileWriter(metaDataJson);
+    for (const FieldVariableValues &currentFieldVariableValues : fieldVariableValues)
+    {
+      numpyFileWriter.addFieldVariable(currentFieldVariableValues.values, currentFieldVariableValues.nComponents);
+    }
+    writeNumpyFileBlock(filename, numpyFileWriter);
+    return;
+  }
+
+  // delta output, the files are referenced without directory, such that the output directory can be moved
+  std::string filenameWithoutDirectory = filename;
+  if (filenameWithoutDirectory.rfind("/") != std::string::npos)
+    filenameWithoutDirectory = filenameWithoutDirectory.substr(filenameWithoutDirectory.rfind("/")+1);
+
+  // if a file is written again, e.g. with "fileNumbering": "timeStepIndex" in a nested solver, its previous values are overwritten.
+  // If chunks of the current states are stored in this file, all field variables of all meshes are written completely again,
+  // such that the new files do not refer to the overwritten values
+  for (int previousFileNo = 0; previousFileNo < deltaOutputFilenames_.size(); previousFileNo++)
+  {
+    if (deltaOutputFilenames_[previousFileNo] != filenameWithoutDirectory)
+      continue;
+
+    int isReferenced = 0;
+    for (const std::pair<const std::string,std::vector<DeltaOutputState>> &meshDeltaOutputStates : deltaOutputStates_)
+    {
+      for (const DeltaOutputState &deltaOutputState : meshDeltaOutputStates.second)
+      {
+        if (std::find(deltaOutputState.chunkFileNos.begin(), deltaOutputState.chunkFileNos.end(), previousFileNo) != deltaOutputState.chunkFileNos.end())
+          isReferenced = 1;
+      }
+    }
+
+    // the ranks of a combined file keep the same list of files
+    if (combineFiles_)
+    {
+      int isReferencedOnOwnRank = isReferenced;
+      MPIUtility::handleReturnValue(MPI_Allreduce(&isReferencedOnOwnRank, &isReferenced, 1, MPI_INT, MPI_MAX,
+                                                  this->rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+    }
+
+    if (isReferenced)
+    {
+      LOG_N_TIMES(1,WARNING) << "Delta output: the file \"" << filename << "\" is written again, but later files refer to its values. "
+        << "All values are written completely again, earlier files that refer to it are no longer valid. Use \"fileNumbering\": \"incremental\" to avoid this.";
+      deltaOutputStates_.clear();
+      deltaOutputFilenames_.clear();
+    }
+    break;
+  }
+
+  const int fileNo = deltaOutputFilenames_.size();
+  deltaOutputFilenames_.push_back(filenameWithoutDirectory);
+
+  std::vector<DeltaOutputState> &deltaOutputStates = deltaOutputStates_[meshName];
+  deltaOutputStates.resize(fieldVariableValues.size());
+
+  // encode all field variables
+  std::vector<int> referencedFileNos;
+  std::vector<std::vector<int>> chunkSources(fieldVariableValues.size());
+  std::vector<std::vector<double>> chunkValues(fieldVariableValues.size());
+  std::stringstream shapes;
+  for (int fieldVariableNo = 0; fieldVariableNo < fieldVariableValues.size(); fieldVariableNo++)
+  {
+    const FieldVariableValues &currentFieldVariableValues = fieldVariableValues[fieldVariableNo];
+    encodeDelta(currentFieldVariableValues.values, deltaOutputStates[fieldVariableNo], fileNo, referencedFileNos,
+                chunkSources[fieldVariableNo], chunkValues[fieldVariableNo]);
+
+    const int nComponents = currentFieldVariableValues.nComponents;
+    shapes << (fieldVariableNo == 0? "" : ", ") << "[" << nComponents << ", "
+      << (nComponents == 0? 0 : currentFieldVariableValues.values.size() / nComponents) << "]";
+  }
+
+  // add the information to decode the chunks to the meta data, the shapes are the shapes of the full arrays of the field variables
+  std::stringstream deltaMetaData;
+  deltaMetaData << ", \"delta\": {\"chunkSize\": " << deltaChunkSize_ << ", \"shapes\": [" << shapes.str() << "], \"referencedFiles\": [";
+  for (int i = 0; i < referencedFileNos.size(); i++)
+  {
+    deltaMetaData << (i == 0? "" : ", ") << "\"" << deltaOutputFilenames_[referencedFileNos[i]] << "\"";
+  }
+  deltaMetaData << "]}";
+  metaDataJson.insert(metaDataJson.rfind("}"), deltaMetaData.str());
+
+  NumpyFileWriter numpyFileWriter(metaDataJson);
+  for (int fieldVariableNo = 0; fieldVariableNo < fieldVariableValues.size(); fieldVariableNo++)
+  {
+    numpyFileWriter.addFieldVariableChunks(chunkSources[fieldVariableNo], chunkValues[fieldVariableNo]);
+  }
+  writeNumpyFileBlock(filename, numpyFileWriter);
+}
+
+void PythonFile::writeNumpyFileBlock(std::string filename, NumpyFileWriter &numpyFileWriter)
+{
+  if (combineFiles_)
+  {
+    numpyFileWriter.writeCombined(filename, this->rankSubset_->mpiCommunicator());
+  }
+  else
+  {
+    numpyFileWriter.write(filename);
+  }
+}
+
+void PythonFile::encodeDelta(const std::vector<double> &values, DeltaOutputState &state, int fileNo, std::vector<int> &referencedFileNos,
+                             std::vector<int> &chunkSources, std::vector<double> &chunkValues)
+{
+  const int nValues = values.size();
+  const int nChunks = (nValues + deltaChunkSize_ - 1) / deltaChunkSize_;
+
+  // if the number of values changed, e.g. at the first output, all chunks are stored
+  if (state.values.size() != values.size())
+  {
+    state.values = values;
+    state.chunkFileNos.assign(nChunks, fileNo);
+    chunkSources.assign(nChunks, -1);
+    chunkValues = values;
+    return;
+  }
+
+  chunkSources.resize(nChunks);
+  chunkValues.clear();
+  for (int chunkNo = 0; chunkNo < nChunks; chunkNo++)
+  {
+    const int chunkBegin = chunkNo*deltaChunkSize_;
+    const int chunkEnd = std::min(chunkBegin + deltaChunkSize_, nValues);
+
+    // compare with the values as they were written, not with the previous output, such that small changes cannot accumulate
+    bool chunkChanged = false;
+    for (int i = chunkBegin; i < chunkEnd; i++)
+    {
+      if (fabs(values[i] - state.values[i]) > deltaTolerance_)
+      {
+        chunkChanged = true;
+        break;
+      }
+    }
+
+    if (chunkChanged)
+    {
+      std::copy(values.begin() + chunkBegin, values.begin() + chunkEnd, state.values.begin() + chunkBegin);
+      chunkValues.insert(chunkValues.end(), values.begin() + chunkBegin, values.begin() + chunkEnd);
+      state.chunkFileNos[chunkNo] = fileNo;
+      chunkSources[chunkNo] = -1;
+    }
+    else
+    {
+      // refer to the file that stores the values of the chunk, this is always a file where the chunk has source -1
+      const int referencedFileNo = state.chunkFileNos[chunkNo];
+      std::vector<int>::iterator iter = std::find(referencedFileNos.begin(), referencedFileNos.end(), referencedFileNo);
+      chunkSources[chunkNo] = iter - referencedFileNos.begin();
+      if (iter == referencedFileNos.end())
+        referencedFileNos.push_back(referencedFileNo);
+    }
+  }
+}
+
 }  // namespace
@@ -3,10 +3,14 @@
 #include <Python.h>  // has to be the first included header
 #include <iostream>
 #include <vector>
+#include <map>
+#include <string>
 
 #include "control/types.h"
 #include "output_writer/generic.h"
 #include "data_management/finite_element_method/finite_elements.h"
+#include "output_writer/python/loop_build_py_field_variable_object.h"
+#include "output_writer/python_file/numpy_file_writer.h"
 
 namespace OutputWriter
 {
@@ -29,7 +33,33 @@ private:
   //! write a python object to an already opened python file stream
   void outputPyObject(PyObject *file, PyObject *pyData);
 
+  /** for deltaOutput_, the values of a field variable as they are stored in the output files */
+  struct DeltaOutputState
+  {
+    std::vector<double> values;       //< the values of all chunks as they were last written
+    std::vector<int> chunkFileNos;    //< for every chunk the index in deltaOutputFilenames_ of the file that stores the values of the chunk
+  };
+
+  //! write the meta data in pyData and the values in fieldVariableValues as *.npys file, if combineFiles_ this is collective over rankSubset_
+  void writeNumpyFile(std::string filename, std::string meshName, PyObject *pyData, const std::vector<FieldVariableValues> &fieldVariableValues);
+
+  //! write the block of the own rank, if combineFiles_ this is collective over rankSubset_
+  void writeNumpyFileBlock(std::string filename, NumpyFileWriter &numpyFileWriter);
+
+  //! for deltaOutput_, split the values of a field variable into chunks, determine the chunks that changed since they were last written and
+  //! the files that contain the unchanged chunks. The indices of these files in referencedFileNos are used as chunk sources.
+  void encodeDelta(const std::vector<double> &values, DeltaOutputState &state, int fileNo, std::vector<int> &referencedFileNos,
+                   std::vector<int> &chunkSources, std::vector<double> &chunkValues);
+
   bool onlyNodalValues_;  //< if only nodal values should be output, this omits the derivative values for Hermite ansatz functions, for Lagrange functions it has no effect
+  bool numpyOutput_;      //< if the values should be written as raw numpy arrays to *.npys files instead of python lists
+  bool combineFiles_;     //< for numpyOutput_, if the data of all ranks should be written to a single file using MPI-IO
+  bool deltaOutput_;      //< for numpyOutput_, if only the chunks of values that changed since the last output are written, the other chunks refer to earlier files
+  int deltaChunkSize_;    //< for deltaOutput_, the number of values per chunk
+  double deltaTolerance_; //< for deltaOutput_, the maximum absolute difference of values that are considered unchanged
+
+  std::map<std::string,std::vector<DeltaOutputState>> deltaOutputStates_;   //< for deltaOutput_, the state of every field variable, key is the mesh name
+  std::vector<std::string> deltaOutputFilenames_;                           //< for deltaOutput_, the filenames without directory of all written files
 };
 
 } // namespace
@@ -5,6 +5,7 @@
 #include <cstdio>
 
 #include "easylogging++.h"
+#include "utility/mpi_utility.h"
 #include "output_writer/python/python.h"
 #include "output_writer/python_file/python_stiffness_matrix_writer.h"
 
@@ -37,6 +38,44 @@ void PythonFile::write(DataType& data, int timeStepNo, double currentTime, int c
      
       filenameStart << this->filename_ << "_" << meshName;
    
+    // write raw numpy arrays, the python object only contains the meta data
+    if (numpyOutput_)
+    {
+      // a combined file does not contain the rank no in its name
+      std::stringstream numpyFilename;
+      if (combineFiles_)
+      {
+        numpyFilename << this->filenameBaseWithNo_;
+        if (meshNames.size() != 1)
+          numpyFilename << "_" << meshName;
+      }
+      else
+      {
+        numpyFilename << filenameStart.str();
+      }
+      numpyFilename << ".npys";
+
+      std::vector<FieldVariableValues> fieldVariableValues;
+      PyObject *pyData = Python<typename DataType::FunctionSpace, typename DataType::FieldVariablesForOutputWriter>::
+        buildPyDataObject(data.getFieldVariablesForOutputWriter(), meshName, timeStepNo, currentTime, this->onlyNodalValues_, &fieldVariableValues);
+
+      // open file, to see if directory needs to be created
+      if (!combineFiles_ || this->rankSubset_->ownRankNo() == 0)
+      {
+        std::ofstream ofile;
+        openFile(ofile, numpyFilename.str());
+        if (ofile.is_open())
+          ofile.close();
+      }
+      if (combineFiles_)
+        MPIUtility::handleReturnValue(MPI_Barrier(this->rankSubset_->mpiCommunicator()), "MPI_Barrier");
+
+      writeNumpyFile(numpyFilename.str(), meshName, pyData, fieldVariableValues);
+
+      Py_XDECREF(pyData);
+      continue;
+    }
+
     // exelem file
     // determine file name
     std::stringstream s;
@@ -68,6 +68,9 @@ public:
   //! get the local dof no for a global petsc dof no, does not work for ghost nodes
   virtual dof_no_t getDofNoLocal(global_no_t dofNoGlobalPetsc, bool &isLocal) const = 0;
 
+  //! get a vector of global natural dof nos of the locally stored non-ghost dofs, in the order of the local dof nos
+  virtual void getDofNosGlobalNatural(std::vector<global_no_t> &dofNosGlobalNatural) const = 0;
+
   //! get the rank on which the global natural node is located
   virtual int getRankOfDofNoGlobalNatural(global_no_t dofNoGlobalNatural) const = 0;
 
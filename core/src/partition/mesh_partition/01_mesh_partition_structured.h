@@ -228,6 +228,9 @@ public:
   //! refine the partitioning by multiplying the number of elements by refinementFactor
   void refine(std::array<int,MeshType::dim()> refinementFactor);
 
+  //! get the node no in global petsc ordering from global coordinates
+  global_no_t getNodeNoGlobalPetsc(std::array<global_no_t,MeshType::dim()> coordinatesGlobal) const;
+
 protected:
   
   //! initialize the values of hasFullNumberOfNodes_ variable
@@ -264,9 +267,6 @@ protected:
   //! get the number of nodes in the global Petsc ordering that are in partitions prior to the one given by partitionIndex
   global_no_t nNodesGlobalPetscInPreviousPartitions(std::array<int,MeshType::dim()> partitionIndex) const;
 
-  //! get the node no in global petsc ordering from global coordinates
-  global_no_t getNodeNoGlobalPetsc(std::array<global_no_t,MeshType::dim()> coordinatesGlobal) const;
-
   std::shared_ptr<DM> dmElements_;                              //< PETSc DMDA object (data management for distributed arrays) that stores topology information and everything needed for communication of ghost values. This particular object is created to get partitioning information on the element level.
   
   std::array<global_no_t,MeshType::dim()> beginElementGlobal_;  //< global element no.s of the lower left front corner of the domain
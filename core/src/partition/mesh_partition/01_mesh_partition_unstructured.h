@@ -9,6 +9,7 @@
 #include "partition/rank_subset.h"
 #include "mesh/type_traits.h"
 #include "mesh/face_t.h"
+#include "partition/mesh_partition/unstructured_partitioning.h"
 
 // forward declaration
 namespace FunctionSpace 
@@ -20,10 +21,10 @@ class FunctionSpace;
 namespace Partition
 {
 
-/** Partial specialization for unstructured meshes 
- *  use petsc IS
- *  not implemented yet
- *  Unstructured meshes should work for non-parallel execution, as usual.
+/** Partial specialization for unstructured meshes.
+ *  If the mesh was created with an UnstructuredPartitioning, the partition holds the local elements, own nodes and ghost nodes of the rank,
+ *  the numberings are given by the partitioning. Otherwise, the partition is serial and all numberings are the identity, this is used for
+ *  the mesh of the whole exfiles before it is distributed.
  */
 template<int D, typename BasisFunctionType>
 class MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>> : 
@@ -31,8 +32,11 @@ class MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfD
 {
 public:
   
-  //! constructor
+  //! constructor for a serial partition with the given global sizes
   MeshPartition(global_no_t nElementsGlobal, global_no_t nNodesGlobal, global_no_t nDofsGlobal, std::shared_ptr<RankSubset> rankSubset);
+
+  //! constructor for a distributed partition
+  MeshPartition(std::shared_ptr<UnstructuredPartitioning> partitioning);
   
   //! number of elements in the local partition
   element_no_t nElementsLocal() const;
@@ -67,11 +71,14 @@ public:
   //! number of dofs in total, same as nDofs
   global_no_t nDofsGlobal() const;
   
-  //! get the global element no for a local element no, this only has an effect for structured meshes, not for unstructured meshes
+  //! get the global element no for a local element no
   global_no_t getElementNoGlobalNatural(element_no_t elementNoLocal) const;
 
   //! get the local to global mapping for the current partition
   ISLocalToGlobalMapping localToGlobalMappingDofs();
+
+  //! get the global petsc dof nos of the ghost dofs which are stored on the local partition
+  const std::vector<PetscInt> &ghostDofNosGlobalPetsc() const;
   
   //! from a vector of values of global node numbers remove all that are non-local, nComponents consecutive components are assumed for each dof
   template <typename T>
@@ -114,10 +121,10 @@ public:
   //! check if the given dof is owned by the own rank, then return true, if not, neighbourRankNo is set to the rank by which the dof is owned
   bool isNonGhost(node_no_t nodeNoLocal, int &neighbourRankNo) const;
 
-  //! get the rank on which the global natural node is located
+  //! get the rank on which the global natural node is located, for a distributed partition this is only known for local nodes (own and ghosts)
   int getRankOfNodeNoGlobalNatural(global_no_t nodeNoGlobalNatural) const;
 
-  //! get the rank on which the global natural node is located
+  //! get the rank on which the global natural dof is located, for a distributed partition this is only known for local dofs (own and ghosts)
   int getRankOfDofNoGlobalNatural(global_no_t dofNoGlobalNatural) const;
 
   //! get the node no in global petsc ordering from a local node no
@@ -130,10 +137,17 @@ public:
   void getDofNoGlobalPetsc(const std::vector<dof_no_t> &dofNosLocal, std::vector<PetscInt> &dofNosGlobalPetsc) const;
 
 protected:
- 
+
+  //! create the local to global mapping and the ghost dof nos
+  void initializeDofMappings();
+
   global_no_t nElements_;   //< the global size, i.e. number of elements of the whole problem
   global_no_t nNodes_;   //< the global size, i.e. the number of nodes of the whole problem
   global_no_t nDofs_;    //< the number of dofs
+
+  std::shared_ptr<UnstructuredPartitioning> partitioning_;   //< the distribution of elements, nodes and dofs to the ranks, nullptr for a serial partition
+  ISLocalToGlobalMapping localToGlobalPetscMappingDofs_;    //< local to global mapping for dofs, including ghosts
+  std::vector<PetscInt> ghostDofNosGlobalPetsc_;             //< global petsc dof nos of the ghost dofs
 };
 
 }  // namespace
@@ -3,15 +3,49 @@
 namespace Partition
 {
 
-// this is not yet implemented in parallel, it should however work serially
- 
+// the partition is serial if it was created from the global sizes, otherwise the numberings are given by partitioning_
+
 template<int D, typename BasisFunctionType>
 MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 MeshPartition(global_no_t nElementsGlobal, global_no_t nNodesGlobal, global_no_t nDofsGlobal, std::shared_ptr<RankSubset> rankSubset):
-  MeshPartitionBase(rankSubset), nElements_(nElementsGlobal), nNodes_(nNodesGlobal), nDofs_(nDofsGlobal)
+  MeshPartitionBase(rankSubset), nElements_(nElementsGlobal), nNodes_(nNodesGlobal), nDofs_(nDofsGlobal), partitioning_(nullptr)
+{
+  // initialize dofNosLocalIS_ and dofNosLocalNonGhostIS_
+  this->createLocalDofOrderings();
+
+  initializeDofMappings();
+}
+
+template<int D, typename BasisFunctionType>
+MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
+MeshPartition(std::shared_ptr<UnstructuredPartitioning> partitioning):
+  MeshPartitionBase(partitioning->rankSubset()), nElements_(partitioning->nElementsGlobal()), nNodes_(partitioning->nNodesGlobal()),
+  nDofs_(partitioning->nDofsGlobal()), partitioning_(partitioning)
 {
   // initialize dofNosLocalIS_ and dofNosLocalNonGhostIS_
   this->createLocalDofOrderings();
+
+  initializeDofMappings();
+}
+
+//! create the local to global mapping and the ghost dof nos
+template<int D, typename BasisFunctionType>
+void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
+initializeDofMappings()
+{
+  std::vector<PetscInt> dofNosGlobalPetsc(nDofsLocalWithGhosts());
+  std::iota(dofNosGlobalPetsc.begin(), dofNosGlobalPetsc.end(), 0);
+  ghostDofNosGlobalPetsc_.clear();
+
+  if (partitioning_)
+  {
+    dofNosGlobalPetsc = partitioning_->dofNosGlobalPetsc();
+    ghostDofNosGlobalPetsc_.assign(dofNosGlobalPetsc.begin() + nDofsLocalWithoutGhosts(), dofNosGlobalPetsc.end());
+  }
+
+  PetscErrorCode ierr;
+  ierr = ISLocalToGlobalMappingCreate(mpiCommunicator(), 1, dofNosGlobalPetsc.size(),
+                                      dofNosGlobalPetsc.data(), PETSC_COPY_VALUES, &localToGlobalPetscMappingDofs_); CHKERRABORT(mpiCommunicator(),ierr);
 }
 
 //! get the local to global mapping for the current partition
@@ -19,14 +53,15 @@ template<int D, typename BasisFunctionType>
 ISLocalToGlobalMapping MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 localToGlobalMappingDofs()
 {
-  PetscErrorCode ierr;
-  std::vector<PetscInt> globalDofNos(nDofs_);
-  std::iota(globalDofNos.begin(), globalDofNos.end(), 0);
-  ISLocalToGlobalMapping localToGlobalMapping;
-  ierr = ISLocalToGlobalMappingCreate(mpiCommunicator(), 1, nDofs_, 
-                                      globalDofNos.data(), PETSC_COPY_VALUES, &localToGlobalMapping); CHKERRABORT(mpiCommunicator(),ierr);
+  return localToGlobalPetscMappingDofs_;
+}
 
-  return localToGlobalMapping;
+//! get the global petsc dof nos of the ghost dofs
+template<int D, typename BasisFunctionType>
+const std::vector<PetscInt> & MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
+ghostDofNosGlobalPetsc() const
+{
+  return ghostDofNosGlobalPetsc_;
 }
 
 //! number of entries in the current partition
@@ -34,6 +69,8 @@ template<int D, typename BasisFunctionType>
 element_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nElementsLocal() const
 {
+  if (partitioning_)
+    return partitioning_->nElementsLocal();
   return nElements_;
 }
 
@@ -50,41 +87,48 @@ template<int D, typename BasisFunctionType>
 node_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nNodesLocalWithGhosts() const
 {
+  if (partitioning_)
+    return partitioning_->nNodesLocalWithGhosts();
   return nNodes_;
 }
 
-//! number of nodes in the local partition
+//! number of dofs in the local partition, including ghosts
 template<int D, typename BasisFunctionType>
 dof_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nDofsLocalWithGhosts() const
 {
+  if (partitioning_)
+    return partitioning_->nDofsLocalWithGhosts();
   return nDofs_;
 }
 
-//! number of nodes in the local partition
+//! number of dofs in the local partition, without ghosts
 template<int D, typename BasisFunctionType>
 dof_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nDofsLocalWithoutGhosts() const
 {
+  if (partitioning_)
+    return partitioning_->nDofsLocalWithoutGhosts();
   return nDofs_;
 }
 
-
 //! number of nodes in the local partition
 template<int D, typename BasisFunctionType>
-dof_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
+node_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nNodesLocalWithGhosts(int coordinateDirection) const
 {
   if (coordinateDirection == 0)
-    return nNodes_;
+    return nNodesLocalWithGhosts();
   return 1;
 }
 
-//! number of nodes in the local partition
+//! number of nodes in the local partition, without ghosts
 template<int D, typename BasisFunctionType>
 node_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nNodesLocalWithoutGhosts() const
 {
+  if (partitioning_)
+    return partitioning_->nNodesLocalWithoutGhosts();
   return nNodes_;
 }
 
@@ -106,7 +150,7 @@ nNodesGlobal(int coordinateDirection) const
   return 1;
 }
 
-//! number of nodes in total
+//! number of dofs in total
 template<int D, typename BasisFunctionType>
 global_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nDofs() const
@@ -114,7 +158,7 @@ nDofs() const
   return nDofs_;
 }
 
-//! number of nodes in total
+//! number of dofs in total
 template<int D, typename BasisFunctionType>
 global_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 nDofsGlobal() const
@@ -122,19 +166,29 @@ nDofsGlobal() const
   return nDofs_;
 }
 
-//! number of nodes in total
+//! get the global natural element no for a local element no
 template<int D, typename BasisFunctionType>
 global_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getElementNoGlobalNatural(element_no_t elementNoLocal) const
 {
+  if (partitioning_)
+    return partitioning_->elementNosGlobal()[elementNoLocal];
   return (global_no_t)(elementNoLocal);
 }
-  
-//! get the local element no. from the global no., set isOnLocalDomain to true if the node with global coordinates is in the local domain
+
+//! get the local element no. from the global no., set isOnLocalDomain to true if the element is in the local domain
 template<int D, typename BasisFunctionType>
 element_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getElementNoLocal(global_no_t elementNoGlobalPetsc, bool &isOnLocalDomain) const
 {
+  // for elements, the global petsc numbering is the global natural numbering
+  if (partitioning_)
+  {
+    element_no_t elementNoLocal = partitioning_->getElementNoLocal(elementNoGlobalPetsc);
+    isOnLocalDomain = (elementNoLocal != -1);
+    return elementNoLocal;
+  }
+
   isOnLocalDomain = true;
   return elementNoGlobalPetsc;
 }
@@ -144,30 +198,51 @@ template <typename T>
 void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 extractLocalNodesWithoutGhosts(std::vector<T> &vector, int nComponents) const
 {
-  
+  // for a serial partition, all nodes are local
+  if (!partitioning_)
+    return;
+
+  std::vector<T> result(nNodesLocalWithoutGhosts()*nComponents);
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocalWithoutGhosts(); nodeNoLocal++)
+  {
+    global_no_t nodeNoGlobalNatural = partitioning_->nodeNosGlobalNatural()[nodeNoLocal];
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      result[nodeNoLocal*nComponents + componentNo] = vector[nodeNoGlobalNatural*nComponents + componentNo];
+    }
+  }
+  vector.assign(result.begin(), result.end());
 }
 
 template<int D, typename BasisFunctionType>
 void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 extractLocalDofsWithoutGhosts(std::vector<double> &vector) const
 {
-
+  extractLocalDofsWithoutGhosts<double>(vector);
 }
 
-
 template<int D, typename BasisFunctionType>
 template <typename T>
 void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 extractLocalDofsWithoutGhosts(std::vector<T> &vector) const
 {
+  // for a serial partition, all dofs are local
+  if (!partitioning_)
+    return;
 
+  std::vector<T> result(nDofsLocalWithoutGhosts());
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts(); dofNoLocal++)
+  {
+    result[dofNoLocal] = vector[partitioning_->dofNosGlobalNatural()[dofNoLocal]];
+  }
+  vector.assign(result.begin(), result.end());
 }
 
 template<int D, typename BasisFunctionType>
 std::array<int,D> MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getCoordinatesLocal(std::array<global_no_t,D> coordinatesGlobal, bool &isOnLocalDomain) const
 {
-  // because we have no parallel execution, global coordinates are the same as local coordinates and isOnLocalDomain is always true
+  // coordinates are not defined for unstructured meshes, global coordinates are the same as local coordinates and isOnLocalDomain is always true
   isOnLocalDomain = true;
   std::array<int,D> coordinatesLocal(coordinatesGlobal.begin(), coordinatesGlobal.end());
   return coordinatesLocal;
@@ -177,6 +252,12 @@ template<int D, typename BasisFunctionType>
 void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getDofNosGlobalNatural(std::vector<global_no_t> &dofNosGlobalNatural) const
 {
+  if (partitioning_)
+  {
+    dofNosGlobalNatural.assign(partitioning_->dofNosGlobalNatural().begin(), partitioning_->dofNosGlobalNatural().begin() + nDofsLocalWithoutGhosts());
+    return;
+  }
+
   dofNosGlobalNatural.resize(nDofsLocalWithoutGhosts());
   std::iota(dofNosGlobalNatural.begin(), dofNosGlobalNatural.end(), 0);
 }
@@ -185,6 +266,13 @@ template<int D, typename BasisFunctionType>
 node_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getNodeNoLocal(global_no_t nodeNoGlobalPetsc, bool &isLocal) const
 {
+  if (partitioning_)
+  {
+    node_no_t nodeNoLocal = partitioning_->getNodeNoLocalFromPetsc(nodeNoGlobalPetsc);
+    isLocal = (nodeNoLocal != -1);
+    return nodeNoLocal;
+  }
+
   isLocal = true;
   return (node_no_t)nodeNoGlobalPetsc;
 }
@@ -193,6 +281,13 @@ template<int D, typename BasisFunctionType>
 dof_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getDofNoLocal(global_no_t dofNoGlobalPetsc, bool &isLocal) const
 {
+  if (partitioning_)
+  {
+    dof_no_t dofNoLocal = partitioning_->getDofNoLocalFromPetsc(dofNoGlobalPetsc);
+    isLocal = (dofNoLocal != -1);
+    return dofNoLocal;
+  }
+
   isLocal = true;
   return (dof_no_t)dofNoGlobalPetsc;
 }
@@ -219,13 +314,20 @@ getDofNoLocal(std::array<global_no_t,D> coordinatesGlobal, int nodalDofIndex, bo
   return -1;
 }
 
-//! transform the global natural numbering to the local numbering
+//! transform the global natural numbering to the local numbering, this also finds ghost nodes
 template<int D, typename BasisFunctionType>
-dof_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
+node_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getNodeNoLocalFromGlobalNatural(global_no_t nodeNoGlobalNatural, bool &isOnLocalDomain) const
 {
-  // global natural makes no sense for unstructured meshes
-  return -1;
+  if (partitioning_)
+  {
+    node_no_t nodeNoLocal = partitioning_->getNodeNoLocal(nodeNoGlobalNatural);
+    isOnLocalDomain = (nodeNoLocal != -1);
+    return nodeNoLocal;
+  }
+
+  isOnLocalDomain = true;
+  return (node_no_t)nodeNoGlobalNatural;
 }
 
 template<int D, typename BasisFunctionType>
@@ -233,14 +335,20 @@ void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDi
 output(std::ostream &stream)
 {
   stream << "MeshPartition<Unstructured>, nElements_: " << nElements_ << ", nNodes_: " << nNodes_ << ", nDofs_: " << nDofs_;
+  if (partitioning_)
+    stream << ", " << *partitioning_;
 }
 
-//! check if the given dof is owned by the own rank, then return true, if not, neighbourRankNo is set to the rank by which the dof is owned
+//! check if the given node is owned by the own rank, then return true, if not, neighbourRankNo is set to the rank by which the node is owned
 template<int D, typename BasisFunctionType>
 bool MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 isNonGhost(node_no_t nodeNoLocal, int &neighbourRankNo) const
 {
-  return true;
+  if (nodeNoLocal < nNodesLocalWithoutGhosts())
+    return true;
+
+  neighbourRankNo = partitioning_->getRankOfNodeNoGlobalNatural(partitioning_->nodeNosGlobalNatural()[nodeNoLocal]);
+  return false;
 }
 
 //! get the rank on which the global natural node is located
@@ -248,14 +356,18 @@ template<int D, typename BasisFunctionType>
 int MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getRankOfNodeNoGlobalNatural(global_no_t nodeNoGlobalNatural) const
 {
+  if (partitioning_)
+    return partitioning_->getRankOfNodeNoGlobalNatural(nodeNoGlobalNatural);
   return 0;
 }
 
-//! get the rank on which the global natural node is located
+//! get the rank on which the global natural dof is located
 template<int D, typename BasisFunctionType>
 int MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getRankOfDofNoGlobalNatural(global_no_t dofNoGlobalNatural) const
 {
+  if (partitioning_)
+    return partitioning_->getRankOfDofNoGlobalNatural(dofNoGlobalNatural);
   return 0;
 }
 
@@ -264,6 +376,8 @@ template<int D, typename BasisFunctionType>
 global_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getNodeNoGlobalPetsc(node_no_t nodeNoLocal) const
 {
+  if (partitioning_)
+    return partitioning_->nodeNosGlobalPetsc()[nodeNoLocal];
   return (global_no_t)nodeNoLocal;
 }
 
@@ -271,13 +385,25 @@ template<int D, typename BasisFunctionType>
 void MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getDofNoGlobalPetsc(const std::vector<dof_no_t> &dofNosLocal, std::vector<PetscInt> &dofNosGlobalPetsc) const
 {
-  dofNosGlobalPetsc.assign(dofNosLocal.begin(), dofNosLocal.end());
+  if (!partitioning_)
+  {
+    dofNosGlobalPetsc.assign(dofNosLocal.begin(), dofNosLocal.end());
+    return;
+  }
+
+  dofNosGlobalPetsc.resize(dofNosLocal.size());
+  for (unsigned int i = 0; i < dofNosLocal.size(); i++)
+  {
+    dofNosGlobalPetsc[i] = partitioning_->dofNosGlobalPetsc()[dofNosLocal[i]];
+  }
 }
 
 template<int D, typename BasisFunctionType>
 global_no_t MeshPartition<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, Mesh::UnstructuredDeformableOfDimension<D>>::
 getDofNoGlobalPetsc(dof_no_t dofNoLocal) const
 {
+  if (partitioning_)
+    return partitioning_->dofNosGlobalPetsc()[dofNoLocal];
   return (global_no_t)dofNoLocal;
 }
 
@@ -0,0 +1,1001 @@
+#include "partition/mesh_partition/unstructured_partitioning.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <limits>
+#include <petscmat.h>
+
+#include "utility/mpi_utility.h"
+#include "easylogging++.h"
+
+namespace Partition
+{
+
+namespace
+{
+
+//! a key of an element for the parallel selection, the value is compared first, then the global element no
+typedef std::pair<unsigned long long, unsigned long long> ElementKey;
+
+//! the first item of the block of rankNo, if nItems are distributed in contiguous blocks to nRanks ranks
+global_no_t blockBegin(global_no_t nItems, int nRanks, int rankNo)
+{
+  return nItems * rankNo / nRanks;
+}
+
+//! the rank that has itemNo in its block, i.e. the largest rankNo with blockBegin(nItems, nRanks, rankNo) <= itemNo
+int blockRankNo(global_no_t nItems, int nRanks, global_no_t itemNo)
+{
+  return ((itemNo+1) * nRanks - 1) / nItems;
+}
+
+//! map a double to an unsigned integer with the same order, such that the values can be bisected
+unsigned long long orderedBits(double value)
+{
+  // -0.0 is equal to 0.0 and has to get the same key
+  if (value == 0.0)
+    value = 0.0;
+
+  unsigned long long bits;
+  std::memcpy(&bits, &value, sizeof(double));
+
+  // the order of negative numbers is reversed, they have the sign bit set
+  if (bits >> 63)
+    return ~bits;
+  return bits | (1ull << 63);
+}
+
+//! get the position of no in nos, where the ranges [0,nFirstRange) and [nFirstRange,nos.size()) are sorted, -1 if it is not contained
+PetscInt findInSortedRanges(const std::vector<global_no_t> &nos, PetscInt nFirstRange, global_no_t no)
+{
+  std::vector<global_no_t>::const_iterator firstRangeEnd = nos.begin() + nFirstRange;
+
+  std::vector<global_no_t>::const_iterator iter = std::lower_bound(nos.begin(), firstRangeEnd, no);
+  if (iter != firstRangeEnd && *iter == no)
+    return iter - nos.begin();
+
+  iter = std::lower_bound(firstRangeEnd, nos.end(), no);
+  if (iter != nos.end() && *iter == no)
+    return iter - nos.begin();
+
+  return -1;
+}
+
+//! Collectively find the keys at the sorted positions keyIndex[queryNo] among the keys of the group queryGroupNo[queryNo] on all ranks.
+//! The keys of every group have to be sorted locally and keyIndex has to be smaller than the global number of keys in the group.
+//! The value and then the element no are bisected, with one reduction of the counts of all queries per step.
+std::vector<ElementKey> selectKeys(const std::vector<std::vector<ElementKey>> &keysOfGroups, const std::vector<int> &queryGroupNo,
+                                   const std::vector<global_no_t> &keyIndex, global_no_t nElementsGlobal, MPI_Comm mpiCommunicator)
+{
+  const int nQueries = queryGroupNo.size();
+
+  // the result is the smallest key such that more than keyIndex keys are not greater than it, it is in [lower,upper]
+  std::vector<ElementKey> lower(nQueries, ElementKey(0, 0));
+  std::vector<ElementKey> upper(nQueries, ElementKey(std::numeric_limits<unsigned long long>::max(), nElementsGlobal-1));
+
+  for (int componentNo = 0; componentNo < 2; componentNo++)
+  {
+    for (;;)
+    {
+      // lower and upper are the same on all ranks, therefore all ranks stop at the same time
+      bool isConverged = true;
+      std::vector<ElementKey> middle(nQueries);
+      std::vector<unsigned long long> nKeysNotGreater(nQueries, 0);
+      for (int queryNo = 0; queryNo < nQueries; queryNo++)
+      {
+        unsigned long long lowerComponent = (componentNo == 0? lower[queryNo].first : lower[queryNo].second);
+        unsigned long long upperComponent = (componentNo == 0? upper[queryNo].first : upper[queryNo].second);
+        if (lowerComponent == upperComponent)
+          continue;
+
+        isConverged = false;
+        unsigned long long middleComponent = lowerComponent + (upperComponent - lowerComponent) / 2;
+
+        // while the value is bisected, all element nos of the value are counted
+        if (componentNo == 0)
+          middle[queryNo] = ElementKey(middleComponent, nElementsGlobal-1);
+        else
+          middle[queryNo] = ElementKey(lower[queryNo].first, middleComponent);
+
+        const std::vector<ElementKey> &keys = keysOfGroups[queryGroupNo[queryNo]];
+        nKeysNotGreater[queryNo] = std::upper_bound(keys.begin(), keys.end(), middle[queryNo]) - keys.begin();
+      }
+
+      if (isConverged)
+        break;
+
+      MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, nKeysNotGreater.data(), nQueries, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+
+      for (int queryNo = 0; queryNo < nQueries; queryNo++)
+      {
+        unsigned long long &lowerComponent = (componentNo == 0? lower[queryNo].first : lower[queryNo].second);
+        unsigned long long &upperComponent = (componentNo == 0? upper[queryNo].first : upper[queryNo].second);
+        if (lowerComponent == upperComponent)
+          continue;
+
+        unsigned long long middleComponent = (componentNo == 0? middle[queryNo].first : middle[queryNo].second);
+        if (nKeysNotGreater[queryNo] > keyIndex[queryNo])
+          upperComponent = middleComponent;
+        else
+          lowerComponent = middleComponent + 1;
+      }
+    }
+  }
+
+  return lower;
+}
+
+}  // namespace
+
+UnstructuredPartitioning::method_t UnstructuredPartitioning::parseMethod(std::string methodString)
+{
+  if (methodString == "rcb")
+    return methodRecursiveCoordinateBisection;
+  else if (methodString == "sfc")
+    return methodSpaceFillingCurve;
+  else if (methodString == "graph")
+    return methodGraph;
+
+  LOG(WARNING) << "Unknown partitioning method \"" << methodString << "\" for unstructured meshes, allowed values are \"rcb\", \"sfc\" and \"graph\". "
+    << "Using \"rcb\".";
+  return methodRecursiveCoordinateBisection;
+}
+
+void UnstructuredPartitioning::getElementBlock(global_no_t nElementsGlobal, std::shared_ptr<RankSubset> rankSubset,
+                                               global_no_t &elementNoBegin, global_no_t &elementNoEnd)
+{
+  elementNoBegin = blockBegin(nElementsGlobal, rankSubset->size(), rankSubset->ownRankNo());
+  elementNoEnd = blockBegin(nElementsGlobal, rankSubset->size(), rankSubset->ownRankNo()+1);
+}
+
+UnstructuredPartitioning::UnstructuredPartitioning(global_no_t nElementsGlobal, global_no_t nNodesGlobal, const std::vector<std::vector<global_no_t>> &elementNodeNos,
+                                                   const std::vector<std::vector<int>> &elementNodeVersions, const std::vector<Vec3> &elementCentroids,
+                                                   int nDofsPerNode, std::shared_ptr<RankSubset> rankSubset, method_t method) :
+  rankSubset_(rankSubset), nDofsPerNode_(nDofsPerNode), nElementsGlobal_(nElementsGlobal), nNodesGlobal_(nNodesGlobal), nDofsGlobal_(0)
+{
+  nRanks_ = rankSubset_->size();
+  ownRankNo_ = rankSubset_->ownRankNo();
+
+  global_no_t elementNoBlockEnd = 0;
+  getElementBlock(nElementsGlobal_, rankSubset_, elementNoBlockBegin_, elementNoBlockEnd);
+
+  assert(elementNodeNos.size() == elementNoBlockEnd - elementNoBlockBegin_);
+  assert(elementNodeVersions.size() == elementNodeNos.size());
+  assert(elementCentroids.size() == elementNodeNos.size());
+
+  // the rank of every element of the own block
+  std::vector<int> blockElementRankNo(elementNodeNos.size(), 0);
+
+  if (nRanks_ > 1)
+  {
+    if (nElementsGlobal_ < (global_no_t)nRanks_)
+    {
+      LOG(WARNING) << "The unstructured mesh has only " << nElementsGlobal_ << " elements, but is distributed to " << nRanks_ << " ranks. "
+        << "Some ranks will have no elements.";
+    }
+
+    // the graph partitioner is tried first, if it is not available, fall back to recursive coordinate bisection
+    if (method == methodGraph && !partitionGraph(elementNodeNos, blockElementRankNo))
+    {
+      LOG(WARNING) << "Graph partitioning of the unstructured mesh is not possible (PETSc has no ParMETIS or there are fewer elements than ranks), "
+        << "use recursive coordinate bisection instead.";
+      method = methodRecursiveCoordinateBisection;
+    }
+
+    if (method == methodRecursiveCoordinateBisection)
+    {
+      partitionRecursiveCoordinateBisection(elementCentroids, blockElementRankNo);
+    }
+    else if (method == methodSpaceFillingCurve)
+    {
+      partitionSpaceFillingCurve(elementCentroids, blockElementRankNo);
+    }
+  }
+
+  createNumberings(elementNodeNos, elementNodeVersions, blockElementRankNo);
+
+  LOG(DEBUG) << "UnstructuredPartitioning: " << *this;
+}
+
+void UnstructuredPartitioning::exchange(const std::vector<std::vector<long long>> &valuesToRanks, std::vector<std::vector<long long>> &valuesFromRanks) const
+{
+  MPI_Comm mpiCommunicator = rankSubset_->mpiCommunicator();
+
+  std::vector<int> nValuesToRanks(nRanks_), nValuesFromRanks(nRanks_);
+  for (int rankNo = 0; rankNo < nRanks_; rankNo++)
+  {
+    nValuesToRanks[rankNo] = valuesToRanks[rankNo].size();
+  }
+
+  MPIUtility::handleReturnValue(MPI_Alltoall(nValuesToRanks.data(), 1, MPI_INT, nValuesFromRanks.data(), 1, MPI_INT, mpiCommunicator), "MPI_Alltoall");
+
+  std::vector<int> sendOffsets(nRanks_, 0), receiveOffsets(nRanks_, 0);
+  std::partial_sum(nValuesToRanks.begin(), nValuesToRanks.end()-1, sendOffsets.begin()+1);
+  std::partial_sum(nValuesFromRanks.begin(), nValuesFromRanks.end()-1, receiveOffsets.begin()+1);
+
+  std::vector<long long> sendBuffer;
+  sendBuffer.reserve(sendOffsets.back() + nValuesToRanks.back());
+  for (int rankNo = 0; rankNo < nRanks_; rankNo++)
+  {
+    sendBuffer.insert(sendBuffer.end(), valuesToRanks[rankNo].begin(), valuesToRanks[rankNo].end());
+  }
+
+  std::vector<long long> receiveBuffer(receiveOffsets.back() + nValuesFromRanks.back());
+  MPIUtility::handleReturnValue(MPI_Alltoallv(sendBuffer.data(), nValuesToRanks.data(), sendOffsets.data(), MPI_LONG_LONG,
+                                              receiveBuffer.data(), nValuesFromRanks.data(), receiveOffsets.data(), MPI_LONG_LONG, mpiCommunicator), "MPI_Alltoallv");
+
+  valuesFromRanks.resize(nRanks_);
+  for (int rankNo = 0; rankNo < nRanks_; rankNo++)
+  {
+    valuesFromRanks[rankNo].assign(receiveBuffer.begin() + receiveOffsets[rankNo], receiveBuffer.begin() + receiveOffsets[rankNo] + nValuesFromRanks[rankNo]);
+  }
+}
+
+void UnstructuredPartitioning::partitionRecursiveCoordinateBisection(const std::vector<Vec3> &centroids, std::vector<int> &blockElementRankNo) const
+{
+  MPI_Comm mpiCommunicator = rankSubset_->mpiCommunicator();
+  const int nElementsBlock = centroids.size();
+
+  // every part of the current level is a range of ranks, in the beginning all elements are in one part with all ranks
+  std::vector<int> partRankNoBegin(1, 0), partNRanks(1, nRanks_);
+  std::vector<int> elementPartNo(nElementsBlock, 0);
+
+  // split all parts of a level at once, until every part has a single rank
+  while (*std::max_element(partNRanks.begin(), partNRanks.end()) > 1)
+  {
+    const int nParts = partRankNoBegin.size();
+
+    // determine the number of elements and the bounding box of the centroids of every part
+    std::vector<unsigned long long> nElementsOfPart(nParts, 0);
+    std::vector<double> minimum(nParts*3, std::numeric_limits<double>::max());
+    std::vector<double> maximum(nParts*3, std::numeric_limits<double>::lowest());
+    for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+    {
+      const int partNo = elementPartNo[elementNo];
+      nElementsOfPart[partNo]++;
+      for (int coordinateDirection = 0; coordinateDirection < 3; coordinateDirection++)
+      {
+        minimum[partNo*3 + coordinateDirection] = std::min(minimum[partNo*3 + coordinateDirection], centroids[elementNo][coordinateDirection]);
+        maximum[partNo*3 + coordinateDirection] = std::max(maximum[partNo*3 + coordinateDirection], centroids[elementNo][coordinateDirection]);
+      }
+    }
+
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, nElementsOfPart.data(), nParts, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, minimum.data(), nParts*3, MPI_DOUBLE, MPI_MIN, mpiCommunicator), "MPI_Allreduce");
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, maximum.data(), nParts*3, MPI_DOUBLE, MPI_MAX, mpiCommunicator), "MPI_Allreduce");
+
+    // split every part in the coordinate direction with the largest extent, such that the number of elements is proportional to the number of ranks on both sides
+    std::vector<int> splitDirection(nParts, 0), queryNoOfPart(nParts, -1);
+    std::vector<int> queryPartNo;
+    std::vector<global_no_t> nElementsLeft;
+    for (int partNo = 0; partNo < nParts; partNo++)
+    {
+      if (partNRanks[partNo] == 1 || nElementsOfPart[partNo] == 0)
+        continue;
+
+      for (int coordinateDirection = 1; coordinateDirection < 3; coordinateDirection++)
+      {
+        if (maximum[partNo*3 + coordinateDirection] - minimum[partNo*3 + coordinateDirection]
+            > maximum[partNo*3 + splitDirection[partNo]] - minimum[partNo*3 + splitDirection[partNo]])
+          splitDirection[partNo] = coordinateDirection;
+      }
+
+      queryNoOfPart[partNo] = queryPartNo.size();
+      queryPartNo.push_back(partNo);
+      nElementsLeft.push_back(nElementsOfPart[partNo] * (partNRanks[partNo]/2) / partNRanks[partNo]);
+    }
+
+    // the first element of the right side is the element at position nElementsLeft in the order of the coordinate,
+    // ties in the coordinate are broken by the element no, such that the result does not depend on the distribution of the blocks
+    std::vector<std::vector<ElementKey>> keysOfParts(nParts);
+    for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+    {
+      const int partNo = elementPartNo[elementNo];
+      keysOfParts[partNo].push_back(ElementKey(orderedBits(centroids[elementNo][splitDirection[partNo]]), elementNoBlockBegin_ + elementNo));
+    }
+    for (std::vector<ElementKey> &keys : keysOfParts)
+    {
+      std::sort(keys.begin(), keys.end());
+    }
+
+    std::vector<ElementKey> splitKeys = selectKeys(keysOfParts, queryPartNo, nElementsLeft, nElementsGlobal_, mpiCommunicator);
+
+    // create the parts of the next level, parts with a single rank are kept
+    std::vector<int> newPartRankNoBegin, newPartNRanks;
+    std::vector<int> leftPartNo(nParts), rightPartNo(nParts);
+    for (int partNo = 0; partNo < nParts; partNo++)
+    {
+      if (partNRanks[partNo] == 1)
+      {
+        leftPartNo[partNo] = rightPartNo[partNo] = newPartRankNoBegin.size();
+        newPartRankNoBegin.push_back(partRankNoBegin[partNo]);
+        newPartNRanks.push_back(1);
+        continue;
+      }
+
+      const int nRanksLeft = partNRanks[partNo] / 2;
+
+      leftPartNo[partNo] = newPartRankNoBegin.size();
+      newPartRankNoBegin.push_back(partRankNoBegin[partNo]);
+      newPartNRanks.push_back(nRanksLeft);
+
+      rightPartNo[partNo] = newPartRankNoBegin.size();
+      newPartRankNoBegin.push_back(partRankNoBegin[partNo] + nRanksLeft);
+      newPartNRanks.push_back(partNRanks[partNo] - nRanksLeft);
+    }
+
+    for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+    {
+      const int partNo = elementPartNo[elementNo];
+      if (partNRanks[partNo] == 1)
+      {
+        elementPartNo[elementNo] = leftPartNo[partNo];
+        continue;
+      }
+
+      ElementKey key(orderedBits(centroids[elementNo][splitDirection[partNo]]), elementNoBlockBegin_ + elementNo);
+      if (key < splitKeys[queryNoOfPart[partNo]])
+        elementPartNo[elementNo] = leftPartNo[partNo];
+      else
+        elementPartNo[elementNo] = rightPartNo[partNo];
+    }
+
+    partRankNoBegin = newPartRankNoBegin;
+    partNRanks = newPartNRanks;
+  }
+
+  for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+  {
+    blockElementRankNo[elementNo] = partRankNoBegin[elementPartNo[elementNo]];
+  }
+}
+
+void UnstructuredPartitioning::partitionSpaceFillingCurve(const std::vector<Vec3> &centroids, std::vector<int> &blockElementRankNo) const
+{
+  MPI_Comm mpiCommunicator = rankSubset_->mpiCommunicator();
+  const int nElementsBlock = centroids.size();
+
+  // bounding box of the centroids
+  std::array<double,3> minimum({std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()});
+  std::array<double,3> maximum({std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()});
+  for (const Vec3 &centroid : centroids)
+  {
+    for (int coordinateDirection = 0; coordinateDirection < 3; coordinateDirection++)
+    {
+      minimum[coordinateDirection] = std::min(minimum[coordinateDirection], centroid[coordinateDirection]);
+      maximum[coordinateDirection] = std::max(maximum[coordinateDirection], centroid[coordinateDirection]);
+    }
+  }
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, minimum.data(), 3, MPI_DOUBLE, MPI_MIN, mpiCommunicator), "MPI_Allreduce");
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, maximum.data(), 3, MPI_DOUBLE, MPI_MAX, mpiCommunicator), "MPI_Allreduce");
+
+  // compute the Morton code of every centroid, with 21 bits per coordinate direction
+  const int nBits = 21;
+  const double nCells = (double)((1ull << nBits) - 1);
+  std::vector<std::vector<ElementKey>> mortonCodes(1, std::vector<ElementKey>(nElementsBlock));
+  for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+  {
+    std::array<unsigned long long,3> cellIndex;
+    for (int coordinateDirection = 0; coordinateDirection < 3; coordinateDirection++)
+    {
+      double extent = maximum[coordinateDirection] - minimum[coordinateDirection];
+      cellIndex[coordinateDirection] = 0;
+      if (extent > 0)
+        cellIndex[coordinateDirection] = (unsigned long long)((centroids[elementNo][coordinateDirection] - minimum[coordinateDirection]) / extent * nCells);
+    }
+
+    unsigned long long code = 0;
+    for (int bitNo = 0; bitNo < nBits; bitNo++)
+    {
+      for (int coordinateDirection = 0; coordinateDirection < 3; coordinateDirection++)
+      {
+        code |= ((cellIndex[coordinateDirection] >> bitNo) & 1ull) << (3*bitNo + coordinateDirection);
+      }
+    }
+    mortonCodes[0][elementNo] = ElementKey(code, elementNoBlockBegin_ + elementNo);
+  }
+  std::sort(mortonCodes[0].begin(), mortonCodes[0].end());
+
+  // cut the curve into nRanks_ pieces of the same size, the element at position index along the curve gets the rank index*nRanks_/nElementsGlobal_,
+  // i.e. rank rankNo begins at position ceil(rankNo*nElementsGlobal_/nRanks_)
+  std::vector<int> queryGroupNo;
+  std::vector<global_no_t> firstIndexOfRank;
+  for (int rankNo = 1; rankNo < nRanks_; rankNo++)
+  {
+    global_no_t index = (rankNo*nElementsGlobal_ + nRanks_ - 1) / nRanks_;
+    if (index >= nElementsGlobal_)
+      break;
+
+    queryGroupNo.push_back(0);
+    firstIndexOfRank.push_back(index);
+  }
+
+  std::vector<ElementKey> firstKeyOfRank = selectKeys(mortonCodes, queryGroupNo, firstIndexOfRank, nElementsGlobal_, mpiCommunicator);
+
+  // the rank of an element is the number of ranks that begin at or before it
+  for (const ElementKey &key : mortonCodes[0])
+  {
+    blockElementRankNo[key.second - elementNoBlockBegin_] = std::upper_bound(firstKeyOfRank.begin(), firstKeyOfRank.end(), key) - firstKeyOfRank.begin();
+  }
+}
+
+bool UnstructuredPartitioning::partitionGraph(const std::vector<std::vector<global_no_t>> &elementNodeNos, std::vector<int> &blockElementRankNo) const
+{
+#if defined(PETSC_HAVE_PARMETIS)
+  // ParMETIS needs at least one vertex of the graph on every rank
+  if (nElementsGlobal_ < (global_no_t)nRanks_)
+    return false;
+
+  MPI_Comm mpiCommunicator = rankSubset_->mpiCommunicator();
+  PetscErrorCode ierr;
+  const PetscInt nRowsLocal = elementNodeNos.size();
+
+  // collect the adjacent elements of every node on the rank that has the node in its block
+  std::vector<std::vector<long long>> valuesToRanks(nRanks_), valuesFromRanks;
+  for (PetscInt rowNo = 0; rowNo < nRowsLocal; rowNo++)
+  {
+    for (global_no_t nodeNoGlobal : elementNodeNos[rowNo])
+    {
+      std::vector<long long> &values = valuesToRanks[blockRankNo(nNodesGlobal_, nRanks_, nodeNoGlobal)];
+      values.push_back(nodeNoGlobal);
+      values.push_back(elementNoBlockBegin_ + rowNo);
+    }
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  std::vector<std::pair<long long,long long>> nodeElementNos;   // (node no, element no)
+  for (const std::vector<long long> &values : valuesFromRanks)
+  {
+    for (int i = 0; i < values.size(); i += 2)
+      nodeElementNos.push_back(std::make_pair(values[i], values[i+1]));
+  }
+  std::sort(nodeElementNos.begin(), nodeElementNos.end());
+  nodeElementNos.erase(std::unique(nodeElementNos.begin(), nodeElementNos.end()), nodeElementNos.end());
+
+  // send the other adjacent elements of every node to the ranks that have the elements in their block, as (element no, number of neighbours, neighbours)
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (int groupBegin = 0; groupBegin < nodeElementNos.size();)
+  {
+    int groupEnd = groupBegin;
+    while (groupEnd < nodeElementNos.size() && nodeElementNos[groupEnd].first == nodeElementNos[groupBegin].first)
+      groupEnd++;
+
+    for (int i = groupBegin; i < groupEnd; i++)
+    {
+      std::vector<long long> &values = valuesToRanks[blockRankNo(nElementsGlobal_, nRanks_, nodeElementNos[i].second)];
+      values.push_back(nodeElementNos[i].second);
+      values.push_back(groupEnd - groupBegin - 1);
+      for (int j = groupBegin; j < groupEnd; j++)
+      {
+        if (j != i)
+          values.push_back(nodeElementNos[j].second);
+      }
+    }
+    groupBegin = groupEnd;
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  // every rank sets up the rows of the adjacency matrix of the dual graph for the elements of its block
+  std::vector<std::vector<PetscInt>> neighbourElementNos(nRowsLocal);
+  for (const std::vector<long long> &values : valuesFromRanks)
+  {
+    for (int i = 0; i < values.size(); i += 2 + values[i+1])
+    {
+      std::vector<PetscInt> &neighbours = neighbourElementNos[values[i] - elementNoBlockBegin_];
+      neighbours.insert(neighbours.end(), values.begin() + i+2, values.begin() + i+2 + values[i+1]);
+    }
+  }
+
+  PetscInt nEntries = 0;
+  for (std::vector<PetscInt> &neighbours : neighbourElementNos)
+  {
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+    nEntries += neighbours.size();
+  }
+
+  // the arrays are owned by the adjacency matrix afterwards and freed by MatDestroy
+  PetscInt *rowOffsets, *columnIndices;
+  ierr = PetscMalloc1(nRowsLocal+1, &rowOffsets); CHKERRABORT(mpiCommunicator,ierr);
+  ierr = PetscMalloc1(std::max(nEntries, (PetscInt)1), &columnIndices); CHKERRABORT(mpiCommunicator,ierr);
+
+  rowOffsets[0] = 0;
+  for (PetscInt rowNo = 0; rowNo < nRowsLocal; rowNo++)
+  {
+    std::copy(neighbourElementNos[rowNo].begin(), neighbourElementNos[rowNo].end(), columnIndices + rowOffsets[rowNo]);
+    rowOffsets[rowNo+1] = rowOffsets[rowNo] + neighbourElementNos[rowNo].size();
+  }
+
+  Mat adjacency;
+  ierr = MatCreateMPIAdj(mpiCommunicator, nRowsLocal, nElementsGlobal_, rowOffsets, columnIndices, NULL, &adjacency); CHKERRABORT(mpiCommunicator,ierr);
+
+  MatPartitioning matPartitioning;
+  ierr = MatPartitioningCreate(mpiCommunicator, &matPartitioning); CHKERRABORT(mpiCommunicator,ierr);
+  ierr = MatPartitioningSetAdjacency(matPartitioning, adjacency); CHKERRABORT(mpiCommunicator,ierr);
+  ierr = MatPartitioningSetType(matPartitioning, MATPARTITIONINGPARMETIS); CHKERRABORT(mpiCommunicator,ierr);
+  ierr = MatPartitioningSetFromOptions(matPartitioning); CHKERRABORT(mpiCommunicator,ierr);
+
+  IS rankNosIS;
+  ierr = MatPartitioningApply(matPartitioning, &rankNosIS); CHKERRABORT(mpiCommunicator,ierr);
+
+  // the index set contains the new ranks of the rows of the own block
+  const PetscInt *rankNos;
+  ierr = ISGetIndices(rankNosIS, &rankNos); CHKERRABORT(mpiCommunicator,ierr);
+  blockElementRankNo.assign(rankNos, rankNos + nRowsLocal);
+  ierr = ISRestoreIndices(rankNosIS, &rankNos); CHKERRABORT(mpiCommunicator,ierr);
+
+  ierr = ISDestroy(&rankNosIS); CHKERRABORT(mpiCommunicator,ierr);
+  ierr = MatPartitioningDestroy(&matPartitioning); CHKERRABORT(mpiCommunicator,ierr);
+  ierr = MatDestroy(&adjacency); CHKERRABORT(mpiCommunicator,ierr);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void UnstructuredPartitioning::createNumberings(const std::vector<std::vector<global_no_t>> &elementNodeNos, const std::vector<std::vector<int>> &elementNodeVersions,
+                                                const std::vector<int> &blockElementRankNo)
+{
+  MPI_Comm mpiCommunicator = rankSubset_->mpiCommunicator();
+  const int nElementsBlock = elementNodeNos.size();
+  std::vector<std::vector<long long>> valuesToRanks(nRanks_), valuesFromRanks;
+
+  // send every use of a node by an element to the rank that has the node in its block (the directory of the node),
+  // as (node no, version no, element no, node index, rank of the element)
+  for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+  {
+    for (int nodeIndex = 0; nodeIndex < elementNodeNos[elementNo].size(); nodeIndex++)
+    {
+      global_no_t nodeNoGlobal = elementNodeNos[elementNo][nodeIndex];
+      std::vector<long long> &values = valuesToRanks[blockRankNo(nNodesGlobal_, nRanks_, nodeNoGlobal)];
+      values.insert(values.end(), {(long long)nodeNoGlobal, elementNodeVersions[elementNo][nodeIndex], (long long)(elementNoBlockBegin_ + elementNo),
+                                   nodeIndex, blockElementRankNo[elementNo]});
+    }
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  std::vector<std::array<long long,5>> nodeUses;
+  for (const std::vector<long long> &values : valuesFromRanks)
+  {
+    for (int i = 0; i < values.size(); i += 5)
+      nodeUses.push_back({values[i], values[i+1], values[i+2], values[i+3], values[i+4]});
+  }
+  std::sort(nodeUses.begin(), nodeUses.end());
+
+  // the directory of the own block of nodes stores the owner of every node and the first global natural dof no of every version, -1 for unused versions
+  const global_no_t nodeNoDirectoryBegin = blockBegin(nNodesGlobal_, nRanks_, ownRankNo_);
+  const global_no_t nNodesDirectory = blockBegin(nNodesGlobal_, nRanks_, ownRankNo_+1) - nodeNoDirectoryBegin;
+  std::vector<int> directoryNodeRankNo(nNodesDirectory, nRanks_);
+  std::vector<std::vector<long long>> directoryVersionDofNo(nNodesDirectory);
+
+  // a node is owned by the lowest rank of its elements, the first use of every version (lowest element no, then node index)
+  // is sent to the rank that has the element in its block, there the dofs are numbered
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (int useNo = 0; useNo < nodeUses.size(); useNo++)
+  {
+    const std::array<long long,5> &use = nodeUses[useNo];
+    const global_no_t directoryNodeNo = use[0] - nodeNoDirectoryBegin;
+    directoryNodeRankNo[directoryNodeNo] = std::min(directoryNodeRankNo[directoryNodeNo], (int)use[4]);
+
+    std::vector<long long> &versionDofNo = directoryVersionDofNo[directoryNodeNo];
+    if (versionDofNo.size() < use[1]+1)
+      versionDofNo.resize(use[1]+1, -1);
+
+    // the uses are sorted by node, version, element and node index
+    if (useNo == 0 || nodeUses[useNo-1][0] != use[0] || nodeUses[useNo-1][1] != use[1])
+    {
+      std::vector<long long> &values = valuesToRanks[blockRankNo(nElementsGlobal_, nRanks_, use[2])];
+      values.insert(values.end(), {use[0], use[1], use[2], use[3]});
+    }
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  // number the dofs like ElementToDofMapping::setup, every first use of a version gets the next nDofsPerNode dofs in the order of the elements and node indices
+  std::vector<std::array<long long,4>> firstUses;
+  for (const std::vector<long long> &values : valuesFromRanks)
+  {
+    for (int i = 0; i < values.size(); i += 4)
+      firstUses.push_back({values[i], values[i+1], values[i+2], values[i+3]});
+  }
+  std::sort(firstUses.begin(), firstUses.end(), [](const std::array<long long,4> &a, const std::array<long long,4> &b)
+  {
+    return std::make_pair(a[2], a[3]) < std::make_pair(b[2], b[3]);
+  });
+
+  long long nFirstUses = firstUses.size();
+  long long firstUseNoBegin = 0;
+  long long nFirstUsesGlobal = 0;
+  MPIUtility::handleReturnValue(MPI_Exscan(&nFirstUses, &firstUseNoBegin, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Allreduce(&nFirstUses, &nFirstUsesGlobal, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+  if (ownRankNo_ == 0)
+    firstUseNoBegin = 0;
+  nDofsGlobal_ = nFirstUsesGlobal * nDofsPerNode_;
+
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (long long firstUseNo = 0; firstUseNo < nFirstUses; firstUseNo++)
+  {
+    const std::array<long long,4> &firstUse = firstUses[firstUseNo];
+    std::vector<long long> &values = valuesToRanks[blockRankNo(nNodesGlobal_, nRanks_, firstUse[0])];
+    values.insert(values.end(), {firstUse[0], firstUse[1], (firstUseNoBegin + firstUseNo) * nDofsPerNode_});
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  for (const std::vector<long long> &values : valuesFromRanks)
+  {
+    for (int i = 0; i < values.size(); i += 3)
+      directoryVersionDofNo[values[i] - nodeNoDirectoryBegin][values[i+1]] = values[i+2];
+  }
+
+  // nodes without elements are owned by rank 0
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (global_no_t directoryNodeNo = 0; directoryNodeNo < nNodesDirectory; directoryNodeNo++)
+  {
+    if (directoryNodeRankNo[directoryNodeNo] == nRanks_)
+    {
+      directoryNodeRankNo[directoryNodeNo] = 0;
+      valuesToRanks[0].push_back(nodeNoDirectoryBegin + directoryNodeNo);
+    }
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  std::vector<global_no_t> localNodeNos;
+  for (const std::vector<long long> &values : valuesFromRanks)
+  {
+    localNodeNos.insert(localNodeNos.end(), values.begin(), values.end());
+  }
+
+  // move the elements to their ranks, as (element no, number of nodes, node nos, version nos)
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (int elementNo = 0; elementNo < nElementsBlock; elementNo++)
+  {
+    std::vector<long long> &values = valuesToRanks[blockElementRankNo[elementNo]];
+    values.push_back(elementNoBlockBegin_ + elementNo);
+    values.push_back(elementNodeNos[elementNo].size());
+    values.insert(values.end(), elementNodeNos[elementNo].begin(), elementNodeNos[elementNo].end());
+    values.insert(values.end(), elementNodeVersions[elementNo].begin(), elementNodeVersions[elementNo].end());
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  std::vector<std::pair<global_no_t, std::pair<int,int>>> receivedElements;   // (element no, (rank, position in the received values))
+  for (int rankNo = 0; rankNo < nRanks_; rankNo++)
+  {
+    const std::vector<long long> &values = valuesFromRanks[rankNo];
+    for (int i = 0; i < values.size(); i += 2 + 2*values[i+1])
+      receivedElements.push_back(std::make_pair(values[i], std::make_pair(rankNo, i)));
+  }
+  std::sort(receivedElements.begin(), receivedElements.end());
+
+  const element_no_t nElementsLocal = receivedElements.size();
+  elementNosGlobal_.resize(nElementsLocal);
+  elementNodeNos_.resize(nElementsLocal);
+  elementNodeVersions_.resize(nElementsLocal);
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    const std::vector<long long> &values = valuesFromRanks[receivedElements[elementNoLocal].second.first];
+    const int position = receivedElements[elementNoLocal].second.second;
+    const int nNodes = values[position+1];
+
+    elementNosGlobal_[elementNoLocal] = values[position];
+    elementNodeNos_[elementNoLocal].assign(values.begin() + position+2, values.begin() + position+2 + nNodes);
+    elementNodeVersions_[elementNoLocal].assign(values.begin() + position+2 + nNodes, values.begin() + position+2 + 2*nNodes);
+
+    localNodeNos.insert(localNodeNos.end(), elementNodeNos_[elementNoLocal].begin(), elementNodeNos_[elementNoLocal].end());
+  }
+
+  // the local nodes are the nodes of the local elements and on rank 0 the nodes without elements
+  std::sort(localNodeNos.begin(), localNodeNos.end());
+  localNodeNos.erase(std::unique(localNodeNos.begin(), localNodeNos.end()), localNodeNos.end());
+
+  // get the owner and the first dof nos of the versions of the local nodes from their directories,
+  // the reply is (owner, number of versions, first dof no of every version) in the order of the requests
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (global_no_t nodeNoGlobal : localNodeNos)
+  {
+    valuesToRanks[blockRankNo(nNodesGlobal_, nRanks_, nodeNoGlobal)].push_back(nodeNoGlobal);
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  valuesToRanks.assign(nRanks_, std::vector<long long>());
+  for (int rankNo = 0; rankNo < nRanks_; rankNo++)
+  {
+    for (long long nodeNoGlobal : valuesFromRanks[rankNo])
+    {
+      const std::vector<long long> &versionDofNo = directoryVersionDofNo[nodeNoGlobal - nodeNoDirectoryBegin];
+      valuesToRanks[rankNo].push_back(directoryNodeRankNo[nodeNoGlobal - nodeNoDirectoryBegin]);
+      valuesToRanks[rankNo].push_back(versionDofNo.size());
+      valuesToRanks[rankNo].insert(valuesToRanks[rankNo].end(), versionDofNo.begin(), versionDofNo.end());
+    }
+  }
+  exchange(valuesToRanks, valuesFromRanks);
+
+  const node_no_t nNodesLocal = localNodeNos.size();
+  std::vector<int> localNodeRankNo(nNodesLocal);
+  std::vector<std::vector<long long>> localNodeVersionDofNo(nNodesLocal);
+  std::vector<int> replyPosition(nRanks_, 0);
+  for (node_no_t i = 0; i < nNodesLocal; i++)
+  {
+    const int rankNo = blockRankNo(nNodesGlobal_, nRanks_, localNodeNos[i]);
+    const std::vector<long long> &values = valuesFromRanks[rankNo];
+    const int position = replyPosition[rankNo];
+
+    localNodeRankNo[i] = values[position];
+    localNodeVersionDofNo[i].assign(values.begin() + position+2, values.begin() + position+2 + values[position+1]);
+    replyPosition[rankNo] = position + 2 + values[position+1];
+  }
+
+  // local nodes, first the own nodes, then the ghost nodes, both in ascending global natural order
+  std::vector<node_no_t> nodeOrder;
+  for (int ghosts = 0; ghosts < 2; ghosts++)
+  {
+    for (node_no_t i = 0; i < nNodesLocal; i++)
+    {
+      if ((localNodeRankNo[i] == ownRankNo_) == (ghosts == 0))
+        nodeOrder.push_back(i);
+    }
+    if (ghosts == 0)
+      nNodesLocalWithoutGhosts_ = nodeOrder.size();
+  }
+
+  nodeNosGlobalNatural_.resize(nNodesLocal);
+  nodeRankNo_.resize(nNodesLocal);
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocal; nodeNoLocal++)
+  {
+    nodeNosGlobalNatural_[nodeNoLocal] = localNodeNos[nodeOrder[nodeNoLocal]];
+    nodeRankNo_[nodeNoLocal] = localNodeRankNo[nodeOrder[nodeNoLocal]];
+  }
+
+  // local dofs, first the own dofs, then the ghost dofs, both in ascending global natural order
+  std::vector<global_no_t> ghostDofNosGlobalNatural;
+  dofNosGlobalNatural_.clear();
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocal; nodeNoLocal++)
+  {
+    std::vector<global_no_t> &dofNos = (nodeNoLocal < nNodesLocalWithoutGhosts_? dofNosGlobalNatural_ : ghostDofNosGlobalNatural);
+    for (long long dofNoBegin : localNodeVersionDofNo[nodeOrder[nodeNoLocal]])
+    {
+      if (dofNoBegin == -1)
+        continue;
+
+      for (int dofIndex = 0; dofIndex < nDofsPerNode_; dofIndex++)
+        dofNos.push_back(dofNoBegin + dofIndex);
+    }
+  }
+  std::sort(dofNosGlobalNatural_.begin(), dofNosGlobalNatural_.end());
+  std::sort(ghostDofNosGlobalNatural.begin(), ghostDofNosGlobalNatural.end());
+  nDofsLocalWithoutGhosts_ = dofNosGlobalNatural_.size();
+  dofNosGlobalNatural_.insert(dofNosGlobalNatural_.end(), ghostDofNosGlobalNatural.begin(), ghostDofNosGlobalNatural.end());
+
+  // the local dofs of every local node by exfile value index, versions that are not used get the dofs of the first used version
+  nodeDofNosLocal_.assign(nNodesLocal, std::vector<dof_no_t>());
+  dofNodeNoLocal_.assign(dofNosGlobalNatural_.size(), -1);
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocal; nodeNoLocal++)
+  {
+    const std::vector<long long> &versionDofNo = localNodeVersionDofNo[nodeOrder[nodeNoLocal]];
+    std::vector<long long>::const_iterator firstUsedVersion = std::find_if(versionDofNo.begin(), versionDofNo.end(), [](long long dofNo){return dofNo != -1;});
+    if (firstUsedVersion == versionDofNo.end())
+      continue;
+
+    for (long long dofNoBegin : versionDofNo)
+    {
+      if (dofNoBegin == -1)
+        dofNoBegin = *firstUsedVersion;
+
+      for (int dofIndex = 0; dofIndex < nDofsPerNode_; dofIndex++)
+      {
+        dof_no_t dofNoLocal = getDofNoLocal(dofNoBegin + dofIndex);
+        assert(dofNoLocal != -1);
+        nodeDofNosLocal_[nodeNoLocal].push_back(dofNoLocal);
+        dofNodeNoLocal_[dofNoLocal] = nodeNoLocal;
+      }
+    }
+  }
+
+  // the global petsc numbering, every rank has a contiguous range in the order of the ranks, the own nodes and dofs are in ascending global natural order
+  long long nNodesOwn = nNodesLocalWithoutGhosts_, nDofsOwn = nDofsLocalWithoutGhosts_;
+  long long nodeNoBegin = 0, dofNoBegin = 0;
+  MPIUtility::handleReturnValue(MPI_Exscan(&nNodesOwn, &nodeNoBegin, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Exscan(&nDofsOwn, &dofNoBegin, 1, MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  if (ownRankNo_ == 0)
+  {
+    nodeNoBegin = 0;
+    dofNoBegin = 0;
+  }
+  nodeNoGlobalPetscBegin_ = nodeNoBegin;
+  dofNoGlobalPetscBegin_ = dofNoBegin;
+
+  // the global petsc nos of the ghosts are requested from their owners, the replies are in the order of the requests
+  for (int isDof = 0; isDof < 2; isDof++)
+  {
+    const std::vector<global_no_t> &nosGlobalNatural = (isDof? dofNosGlobalNatural_ : nodeNosGlobalNatural_);
+    const PetscInt nOwn = (isDof? nDofsLocalWithoutGhosts_ : nNodesLocalWithoutGhosts_);
+    const global_no_t noGlobalPetscBegin = (isDof? dofNoGlobalPetscBegin_ : nodeNoGlobalPetscBegin_);
+    std::vector<PetscInt> &nosGlobalPetsc = (isDof? dofNosGlobalPetsc_ : nodeNosGlobalPetsc_);
+
+    nosGlobalPetsc.resize(nosGlobalNatural.size());
+    for (PetscInt noLocal = 0; noLocal < nOwn; noLocal++)
+      nosGlobalPetsc[noLocal] = noGlobalPetscBegin + noLocal;
+
+    valuesToRanks.assign(nRanks_, std::vector<long long>());
+    for (PetscInt noLocal = nOwn; noLocal < nosGlobalNatural.size(); noLocal++)
+    {
+      const int rankNo = (isDof? nodeRankNo_[dofNodeNoLocal_[noLocal]] : nodeRankNo_[noLocal]);
+      valuesToRanks[rankNo].push_back(nosGlobalNatural[noLocal]);
+    }
+    exchange(valuesToRanks, valuesFromRanks);
+
+    for (std::vector<long long> &values : valuesFromRanks)
+    {
+      for (long long &value : values)
+      {
+        PetscInt noLocal = findInSortedRanges(nosGlobalNatural, nOwn, value);
+        assert(noLocal != -1 && noLocal < nOwn);
+        value = noGlobalPetscBegin + noLocal;
+      }
+    }
+    exchange(valuesFromRanks, valuesToRanks);
+
+    std::fill(replyPosition.begin(), replyPosition.end(), 0);
+    for (PetscInt noLocal = nOwn; noLocal < nosGlobalNatural.size(); noLocal++)
+    {
+      const int rankNo = (isDof? nodeRankNo_[dofNodeNoLocal_[noLocal]] : nodeRankNo_[noLocal]);
+      nosGlobalPetsc[noLocal] = valuesToRanks[rankNo][replyPosition[rankNo]++];
+    }
+  }
+}
+
+std::shared_ptr<RankSubset> UnstructuredPartitioning::rankSubset() const
+{
+  return rankSubset_;
+}
+
+element_no_t UnstructuredPartitioning::nElementsLocal() const
+{
+  return elementNosGlobal_.size();
+}
+
+global_no_t UnstructuredPartitioning::nElementsGlobal() const
+{
+  return nElementsGlobal_;
+}
+
+node_no_t UnstructuredPartitioning::nNodesLocalWithGhosts() const
+{
+  return nodeNosGlobalNatural_.size();
+}
+
+node_no_t UnstructuredPartitioning::nNodesLocalWithoutGhosts() const
+{
+  return nNodesLocalWithoutGhosts_;
+}
+
+global_no_t UnstructuredPartitioning::nNodesGlobal() const
+{
+  return nNodesGlobal_;
+}
+
+dof_no_t UnstructuredPartitioning::nDofsLocalWithGhosts() const
+{
+  return dofNosGlobalNatural_.size();
+}
+
+dof_no_t UnstructuredPartitioning::nDofsLocalWithoutGhosts() const
+{
+  return nDofsLocalWithoutGhosts_;
+}
+
+global_no_t UnstructuredPartitioning::nDofsGlobal() const
+{
+  return nDofsGlobal_;
+}
+
+const std::vector<global_no_t> &UnstructuredPartitioning::elementNosGlobal() const
+{
+  return elementNosGlobal_;
+}
+
+const std::vector<std::vector<global_no_t>> &UnstructuredPartitioning::elementNodeNos() const
+{
+  return elementNodeNos_;
+}
+
+const std::vector<std::vector<int>> &UnstructuredPartitioning::elementNodeVersions() const
+{
+  return elementNodeVersions_;
+}
+
+const std::vector<global_no_t> &UnstructuredPartitioning::nodeNosGlobalNatural() const
+{
+  return nodeNosGlobalNatural_;
+}
+
+const std::vector<global_no_t> &UnstructuredPartitioning::dofNosGlobalNatural() const
+{
+  return dofNosGlobalNatural_;
+}
+
+const std::vector<PetscInt> &UnstructuredPartitioning::nodeNosGlobalPetsc() const
+{
+  return nodeNosGlobalPetsc_;
+}
+
+const std::vector<PetscInt> &UnstructuredPartitioning::dofNosGlobalPetsc() const
+{
+  return dofNosGlobalPetsc_;
+}
+
+const std::vector<std::vector<dof_no_t>> &UnstructuredPartitioning::nodeDofNosLocal() const
+{
+  return nodeDofNosLocal_;
+}
+
+element_no_t UnstructuredPartitioning::getElementNoLocal(global_no_t elementNoGlobalNatural) const
+{
+  std::vector<global_no_t>::const_iterator iter = std::lower_bound(elementNosGlobal_.begin(), elementNosGlobal_.end(), elementNoGlobalNatural);
+  if (iter == elementNosGlobal_.end() || *iter != elementNoGlobalNatural)
+    return -1;
+  return iter - elementNosGlobal_.begin();
+}
+
+node_no_t UnstructuredPartitioning::getNodeNoLocal(global_no_t nodeNoGlobalNatural) const
+{
+  return findInSortedRanges(nodeNosGlobalNatural_, nNodesLocalWithoutGhosts_, nodeNoGlobalNatural);
+}
+
+dof_no_t UnstructuredPartitioning::getDofNoLocal(global_no_t dofNoGlobalNatural) const
+{
+  return findInSortedRanges(dofNosGlobalNatural_, nDofsLocalWithoutGhosts_, dofNoGlobalNatural);
+}
+
+node_no_t UnstructuredPartitioning::getNodeNoLocalFromPetsc(global_no_t nodeNoGlobalPetsc) const
+{
+  if (nodeNoGlobalPetsc < nodeNoGlobalPetscBegin_ || nodeNoGlobalPetsc >= nodeNoGlobalPetscBegin_ + nNodesLocalWithoutGhosts_)
+    return -1;
+  return nodeNoGlobalPetsc - nodeNoGlobalPetscBegin_;
+}
+
+dof_no_t UnstructuredPartitioning::getDofNoLocalFromPetsc(global_no_t dofNoGlobalPetsc) const
+{
+  if (dofNoGlobalPetsc < dofNoGlobalPetscBegin_ || dofNoGlobalPetsc >= dofNoGlobalPetscBegin_ + nDofsLocalWithoutGhosts_)
+    return -1;
+  return dofNoGlobalPetsc - dofNoGlobalPetscBegin_;
+}
+
+int UnstructuredPartitioning::getRankOfNodeNoGlobalNatural(global_no_t nodeNoGlobalNatural) const
+{
+  node_no_t nodeNoLocal = getNodeNoLocal(nodeNoGlobalNatural);
+  if (nodeNoLocal == -1)
+  {
+    LOG(FATAL) << "The owner of node " << nodeNoGlobalNatural << " of the unstructured mesh is not known on rank " << ownRankNo_ << ", "
+      << "only the owners of the own and ghost nodes are stored.";
+  }
+  return nodeRankNo_[nodeNoLocal];
+}
+
+int UnstructuredPartitioning::getRankOfDofNoGlobalNatural(global_no_t dofNoGlobalNatural) const
+{
+  dof_no_t dofNoLocal = getDofNoLocal(dofNoGlobalNatural);
+  if (dofNoLocal == -1)
+  {
+    LOG(FATAL) << "The owner of dof " << dofNoGlobalNatural << " of the unstructured mesh is not known on rank " << ownRankNo_ << ", "
+      << "only the owners of the own and ghost dofs are stored.";
+  }
+  return nodeRankNo_[dofNodeNoLocal_[dofNoLocal]];
+}
+
+void UnstructuredPartitioning::output(std::ostream &stream) const
+{
+  stream << "rank " << ownRankNo_ << "/" << nRanks_ << ": " << nElementsLocal() << "/" << nElementsGlobal_ << " elements, "
+    << nNodesLocalWithoutGhosts_ << " (" << nNodesLocalWithGhosts() << " with ghosts)/" << nNodesGlobal_ << " nodes, "
+    << nDofsLocalWithoutGhosts_ << " (" << nDofsLocalWithGhosts() << " with ghosts)/" << nDofsGlobal_ << " dofs, "
+    << "first petsc node no: " << nodeNoGlobalPetscBegin_ << ", first petsc dof no: " << dofNoGlobalPetscBegin_;
+}
+
+std::ostream &operator<<(std::ostream &stream, const UnstructuredPartitioning &partitioning)
+{
+  partitioning.output(stream);
+  return stream;
+}
+
+}  // namespace
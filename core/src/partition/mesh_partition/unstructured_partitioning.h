@@ -0,0 +1,182 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <memory>
+#include <vector>
+#include <petscsys.h>
+
+#include "control/types.h"
+#include "partition/rank_subset.h"
+
+namespace Partition
+{
+
+/** The domain decomposition of an unstructured mesh. No rank stores the topology of the whole mesh: the mesh is read in blocks of
+ *  contiguous global element nos, the block of rank r is [r*nElementsGlobal/nRanks, (r+1)*nElementsGlobal/nRanks) (see getElementBlock).
+ *  The partitioning is computed collectively from these blocks, afterwards every rank only stores its local elements, nodes and dofs.
+ *
+ *  Elements are distributed to the ranks by recursive coordinate bisection ("rcb") or by a space-filling curve ("sfc") of the element centroids,
+ *  or by a graph partitioner ("graph") on the dual graph of the mesh, which uses ParMETIS through PETSc's MatPartitioning.
+ *  The geometric methods select their split points by a parallel bisection of the keys, the result does not depend on the number of ranks
+ *  that hold the blocks and is the same as a sort of all elements by (coordinate or Morton code, global element no).
+ *
+ *  Information on the nodes is collected in a distributed directory, the node n is handled by the rank that has n in its block of node nos.
+ *  A node is owned by the lowest rank of its adjacent elements, nodes without elements are owned by rank 0, all dofs of a node are owned by the owner of the node.
+ *  The nodes of the local elements that are owned by other ranks are the ghost nodes.
+ *
+ *  Local numbering: first the own nodes/dofs in ascending global natural order, then the ghost nodes/dofs in ascending global natural order.
+ *  Global Petsc numbering: each rank has a contiguous range, the ranges are in the order of the ranks, like for structured meshes.
+ *  Global natural numbering: the numbering of the nodes of the whole mesh as given in the settings, the global natural dofs are numbered
+ *  like in FieldVariable::ElementToDofMapping::setup, i.e. every version of a node gets its dofs where it is used first in the order of the elements.
+ *  With a single rank, all three numberings coincide.
+ */
+class UnstructuredPartitioning
+{
+public:
+
+  //! the algorithm that distributes the elements to the ranks
+  enum method_t
+  {
+    methodRecursiveCoordinateBisection,    //< recursive coordinate bisection of the element centroids
+    methodSpaceFillingCurve,               //< contiguous chunks of the elements sorted by the Morton code of their centroids
+    methodGraph                            //< graph partitioning of the dual graph (elements that share nodes are neighbours)
+  };
+
+  //! parse the method from a string "rcb", "sfc" or "graph"
+  static method_t parseMethod(std::string methodString);
+
+  //! get the range [elementNoBegin, elementNoEnd) of global element nos that the own rank has to read and pass to the constructor
+  static void getElementBlock(global_no_t nElementsGlobal, std::shared_ptr<RankSubset> rankSubset, global_no_t &elementNoBegin, global_no_t &elementNoEnd);
+
+  //! constructor, compute the partitioning, this is collective over the ranks of rankSubset
+  //! @param elementNodeNos for every element of the own block the global natural node nos
+  //! @param elementNodeVersions for every element of the own block the version nos of its nodes
+  //! @param elementCentroids for every element of the own block its centroid, used by the geometric methods
+  UnstructuredPartitioning(global_no_t nElementsGlobal, global_no_t nNodesGlobal, const std::vector<std::vector<global_no_t>> &elementNodeNos,
+                           const std::vector<std::vector<int>> &elementNodeVersions, const std::vector<Vec3> &elementCentroids, int nDofsPerNode,
+                           std::shared_ptr<RankSubset> rankSubset, method_t method);
+
+  //! the rank subset of the partitioning
+  std::shared_ptr<RankSubset> rankSubset() const;
+
+  //! number of elements on the own rank
+  element_no_t nElementsLocal() const;
+
+  //! number of elements in total
+  global_no_t nElementsGlobal() const;
+
+  //! number of nodes on the own rank, including ghost nodes
+  node_no_t nNodesLocalWithGhosts() const;
+
+  //! number of nodes owned by the own rank
+  node_no_t nNodesLocalWithoutGhosts() const;
+
+  //! number of nodes in total
+  global_no_t nNodesGlobal() const;
+
+  //! number of dofs on the own rank, including ghost dofs
+  dof_no_t nDofsLocalWithGhosts() const;
+
+  //! number of dofs owned by the own rank
+  dof_no_t nDofsLocalWithoutGhosts() const;
+
+  //! number of dofs in total
+  global_no_t nDofsGlobal() const;
+
+  //! the global natural element nos of the local elements, in ascending order
+  const std::vector<global_no_t> &elementNosGlobal() const;
+
+  //! for every local element the global natural node nos
+  const std::vector<std::vector<global_no_t>> &elementNodeNos() const;
+
+  //! for every local element the version nos of its nodes
+  const std::vector<std::vector<int>> &elementNodeVersions() const;
+
+  //! the global natural node nos of the local nodes, including ghosts
+  const std::vector<global_no_t> &nodeNosGlobalNatural() const;
+
+  //! the global natural dof nos of the local dofs, including ghosts
+  const std::vector<global_no_t> &dofNosGlobalNatural() const;
+
+  //! the global petsc node nos of the local nodes, including ghosts
+  const std::vector<PetscInt> &nodeNosGlobalPetsc() const;
+
+  //! the global petsc dof nos of the local dofs, including ghosts
+  const std::vector<PetscInt> &dofNosGlobalPetsc() const;
+
+  //! for every local node the local dof nos indexed by the exfile value index, i.e. nDofsPerNode dofs for every version,
+  //! versions that are not used by any element get the dofs of the first used version
+  const std::vector<std::vector<dof_no_t>> &nodeDofNosLocal() const;
+
+  //! get the local element no of a global element no, -1 if the element is not local
+  element_no_t getElementNoLocal(global_no_t elementNoGlobalNatural) const;
+
+  //! get the local node no of a global natural node no, -1 if the node is not local (neither own nor ghost)
+  node_no_t getNodeNoLocal(global_no_t nodeNoGlobalNatural) const;
+
+  //! get the local dof no of a global natural dof no, -1 if the dof is not local (neither own nor ghost)
+  dof_no_t getDofNoLocal(global_no_t dofNoGlobalNatural) const;
+
+  //! get the local node no of a global petsc node no, only for own nodes, else -1
+  node_no_t getNodeNoLocalFromPetsc(global_no_t nodeNoGlobalPetsc) const;
+
+  //! get the local dof no of a global petsc dof no, only for own dofs, else -1
+  dof_no_t getDofNoLocalFromPetsc(global_no_t dofNoGlobalPetsc) const;
+
+  //! get the rank that owns the global natural node, the node has to be local (own or ghost)
+  int getRankOfNodeNoGlobalNatural(global_no_t nodeNoGlobalNatural) const;
+
+  //! get the rank that owns the global natural dof, the dof has to be local (own or ghost)
+  int getRankOfDofNoGlobalNatural(global_no_t dofNoGlobalNatural) const;
+
+  //! output to stream for debugging
+  void output(std::ostream &stream) const;
+
+private:
+
+  //! send valuesToRanks[rankNo] to every rank, receive the values that the other ranks send to the own rank
+  void exchange(const std::vector<std::vector<long long>> &valuesToRanks, std::vector<std::vector<long long>> &valuesFromRanks) const;
+
+  //! assign the elements of the own block to ranks by recursive coordinate bisection
+  void partitionRecursiveCoordinateBisection(const std::vector<Vec3> &centroids, std::vector<int> &blockElementRankNo) const;
+
+  //! assign the elements of the own block to ranks by a space-filling curve (Morton order) of the element centroids
+  void partitionSpaceFillingCurve(const std::vector<Vec3> &centroids, std::vector<int> &blockElementRankNo) const;
+
+  //! assign the elements of the own block to ranks by partitioning the dual graph with PETSc MatPartitioning, returns false if no graph partitioner is available
+  bool partitionGraph(const std::vector<std::vector<global_no_t>> &elementNodeNos, std::vector<int> &blockElementRankNo) const;
+
+  //! number the dofs, move the elements to their ranks and set up the local numberings
+  void createNumberings(const std::vector<std::vector<global_no_t>> &elementNodeNos, const std::vector<std::vector<int>> &elementNodeVersions,
+                        const std::vector<int> &blockElementRankNo);
+
+  std::shared_ptr<RankSubset> rankSubset_;          //< the ranks over which the mesh is distributed
+  int nRanks_;                                      //< number of ranks in rankSubset_
+  int ownRankNo_;                                   //< own rank no in rankSubset_
+  int nDofsPerNode_;                                //< number of dofs per node and version
+
+  global_no_t nElementsGlobal_;                     //< number of elements in total
+  global_no_t nNodesGlobal_;                        //< number of nodes in total
+  global_no_t nDofsGlobal_;                         //< number of dofs in total
+  global_no_t elementNoBlockBegin_;                 //< first global element no of the block of the own rank
+
+  std::vector<global_no_t> elementNosGlobal_;       //< the global natural nos of the local elements, ascending
+  std::vector<std::vector<global_no_t>> elementNodeNos_;   //< for every local element the global natural node nos
+  std::vector<std::vector<int>> elementNodeVersions_;      //< for every local element the version nos of the nodes
+  std::vector<global_no_t> nodeNosGlobalNatural_;   //< the global natural nos of the local nodes, first own nodes, then ghost nodes
+  std::vector<global_no_t> dofNosGlobalNatural_;    //< the global natural nos of the local dofs, first own dofs, then ghost dofs
+  std::vector<PetscInt> nodeNosGlobalPetsc_;        //< the global petsc nos of the local nodes
+  std::vector<PetscInt> dofNosGlobalPetsc_;         //< the global petsc nos of the local dofs
+  std::vector<int> nodeRankNo_;                     //< for every local node the owning rank
+  std::vector<node_no_t> dofNodeNoLocal_;           //< for every local dof the local node it belongs to
+  std::vector<std::vector<dof_no_t>> nodeDofNosLocal_;  //< for every local node the local dofs, indexed by the exfile value index
+
+  node_no_t nNodesLocalWithoutGhosts_;              //< number of own nodes
+  dof_no_t nDofsLocalWithoutGhosts_;                //< number of own dofs
+  global_no_t nodeNoGlobalPetscBegin_;              //< first global petsc node no of the own rank
+  global_no_t dofNoGlobalPetscBegin_;               //< first global petsc dof no of the own rank
+};
+
+std::ostream &operator<<(std::ostream &stream, const UnstructuredPartitioning &partitioning);
+
+}  // namespace
@@ -13,6 +13,15 @@ Manager::Manager(PythonConfig specificSettings) : specificSettings_(specificSett
 {
 }
 
+std::shared_ptr<RankSubset> Manager::rankSubsetForNextCreatedPartitioning()
+{
+  // if no nextRankSubset was specified, create rank subset of all available MPI ranks
+  if (nextRankSubset_ == nullptr)
+    return std::make_shared<RankSubset>();
+
+  return nextRankSubset_;
+}
+
 void Manager::setRankSubsetForNextCreatedPartitioning(std::shared_ptr<RankSubset> nextRankSubset)
 {
   nextRankSubset_ = nextRankSubset;
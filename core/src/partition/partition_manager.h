@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "partition/mesh_partition/01_mesh_partition.h"
+#include "partition/mesh_partition/unstructured_partitioning.h"
 #include "control/python_config/python_config.h"
 
 // forward declaration
@@ -30,6 +31,10 @@ public:
   template<typename FunctionSpace>
   std::shared_ptr<MeshPartition<FunctionSpace>> createPartitioningUnstructured(global_no_t nElementsGlobal, global_no_t nNodesGlobal, global_no_t nDofsGlobal);
 
+  //! create new partitioning of an unstructured mesh that is distributed according to the given partitioning, the rank subset is the one of the partitioning
+  template<typename FunctionSpace>
+  std::shared_ptr<MeshPartition<FunctionSpace>> createPartitioningUnstructured(std::shared_ptr<UnstructuredPartitioning> partitioning);
+
   //! create new partitioning over all available processes, respective the rank subset that was set by the last call to setRankSubsetForNextCreatedPartitioning, for a structured mesh, from global sizes
   //! use globalSize, fill localSize and nRanks
   template<typename FunctionSpace>
@@ -55,6 +60,9 @@ public:
     const std::vector<std::shared_ptr<::FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>,BasisFunctionType>>> &subFunctionSpaces,
     std::vector<int> rankNos);
 
+  //! get the rank subset that will be used for the next partitioning that will be created, this is a new rank subset of all ranks if none was set
+  std::shared_ptr<RankSubset> rankSubsetForNextCreatedPartitioning();
+
   //! store a rank subset that will be used for the next partitioning that will be created
   void setRankSubsetForNextCreatedPartitioning(std::shared_ptr<RankSubset> nextRankSubset);
   
@@ -15,26 +15,23 @@ createPartitioningUnstructured(global_no_t nElementsGlobal, global_no_t nNodesGl
   LOG(DEBUG) << "Partition::Manager::createPartitioningUnstructured, nElementsGlobal: " 
     << nElementsGlobal << ", nNodesGlobal: " << nNodesGlobal << ", nDofsGlobal: " << nDofsGlobal;
   
-  // the subset of ranks for the partition to be created
-  std::shared_ptr<RankSubset> rankSubset;
-  
-  // if no nextRankSubset was specified, use all available ranks
-  if (nextRankSubset_ == nullptr)
-  {
-    // create rank subset of all available MPI ranks
-    rankSubset = std::make_shared<RankSubset>();
-  }
-  else 
-  {
-    // if nextRankSubset was specified, use it
-    rankSubset = nextRankSubset_;
-  }
+  // the subset of ranks for the partition to be created, if no nextRankSubset was specified, use all available ranks
+  std::shared_ptr<RankSubset> rankSubset = rankSubsetForNextCreatedPartitioning();
   
   LOG(DEBUG) << "using rankSubset " << *rankSubset;
   
   return std::make_shared<MeshPartition<FunctionSpace>>(nElementsGlobal, nNodesGlobal, nDofsGlobal, rankSubset);
 }
 
+template<typename FunctionSpace>
+std::shared_ptr<MeshPartition<FunctionSpace>> Manager::
+createPartitioningUnstructured(std::shared_ptr<UnstructuredPartitioning> partitioning)
+{
+  LOG(DEBUG) << "Partition::Manager::createPartitioningUnstructured from partitioning " << *partitioning;
+
+  return std::make_shared<MeshPartition<FunctionSpace>>(partitioning);
+}
+
 // use nElementsLocal and nRanks, fill nElementsGlobal
 template<typename FunctionSpace>
 std::shared_ptr<MeshPartition<FunctionSpace>> Manager::
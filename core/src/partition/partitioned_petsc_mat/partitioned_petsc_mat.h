@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <array>
 
 #include "control/types.h"
 #include "partition/rank_subset.h"
@@ -62,6 +63,17 @@ public:
   template<int nComponents>
   void setValues(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], const std::vector<std::array<double,nComponents>> &v, InsertMode addv);
 
+  //! set the nDofsPerElement x nDofsPerElement block of the given component for one element with a single call to MatSetValues,
+  //! values are stored row major, values[i*nDofsPerElement + j] is the entry for the dofs (dofNosLocal[i], dofNosLocal[j])
+  template<int nDofsPerElement>
+  void setValuesElement(int componentNo, const std::array<dof_no_t,nDofsPerElement> &dofNosLocal,
+                        const std::array<double,nDofsPerElement*nDofsPerElement> &values, InsertMode addv);
+
+  //! vectorized version of setValuesElement, sets the blocks of all elements of the batch with one call to MatSetValues per element, lanes with dof no -1 are skipped
+  template<int nDofsPerElement>
+  void setValuesElement(int componentNo, const std::array<Vc::int_v,nDofsPerElement> &dofNosLocal,
+                        const std::array<Vc::double_v,nDofsPerElement*nDofsPerElement> &values, InsertMode addv);
+
   //! set entries in the given submatrix, uses the global/Petsc indexing. This is not the global natural numbering!
   void setValuesGlobalPetscIndexing(int componentNo, PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], const PetscScalar v[], InsertMode addv);
 
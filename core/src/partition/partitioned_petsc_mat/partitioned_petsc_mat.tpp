@@ -212,6 +212,57 @@ setValues(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[],
   }
 }
 
+//! set the block of one element with a single call to MatSetValues
+template<typename RowsFunctionSpaceType, typename ColumnsFunctionSpaceType>
+template<int nDofsPerElement>
+void PartitionedPetscMat<RowsFunctionSpaceType,ColumnsFunctionSpaceType>::
+setValuesElement(int componentNo, const std::array<dof_no_t,nDofsPerElement> &dofNosLocal,
+                 const std::array<double,nDofsPerElement*nDofsPerElement> &values, InsertMode addv)
+{
+  std::array<PetscInt,nDofsPerElement> indices;
+  for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+  {
+    indices[dofIndex] = dofNosLocal[dofIndex];
+  }
+
+  setValues(componentNo, nDofsPerElement, indices.data(), nDofsPerElement, indices.data(), values.data(), addv);
+}
+
+//! set the blocks of all elements of a vectorized batch, one call to MatSetValues per element
+template<typename RowsFunctionSpaceType, typename ColumnsFunctionSpaceType>
+template<int nDofsPerElement>
+void PartitionedPetscMat<RowsFunctionSpaceType,ColumnsFunctionSpaceType>::
+setValuesElement(int componentNo, const std::array<Vc::int_v,nDofsPerElement> &dofNosLocal,
+                 const std::array<Vc::double_v,nDofsPerElement*nDofsPerElement> &values, InsertMode addv)
+{
+  const int nVcComponents = Vc::double_v::size();
+
+  // transpose the values such that the block of each element is contiguous, blockValues[vcComponent][i*nDofsPerElement + j]
+  std::array<std::array<double,nDofsPerElement*nDofsPerElement>,nVcComponents> blockValues;
+  for (int entryNo = 0; entryNo < nDofsPerElement*nDofsPerElement; entryNo++)
+  {
+    for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
+    {
+      blockValues[vcComponent][entryNo] = values[entryNo][vcComponent];
+    }
+  }
+
+  std::array<PetscInt,nDofsPerElement> indices;
+  for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
+  {
+    // lanes that do not contain an element have all dof nos set to -1
+    if (dofNosLocal[0][vcComponent] == -1)
+      continue;
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      indices[dofIndex] = dofNosLocal[dofIndex][vcComponent];
+    }
+
+    setValues(componentNo, nDofsPerElement, indices.data(), nDofsPerElement, indices.data(), blockValues[vcComponent].data(), addv);
+  }
+}
+
 //! wrapper of MatZeroRowsColumns, zeros all entries (except possibly the main diagonal) of a set of local rows and columns
 template<typename RowsFunctionSpaceType, typename ColumnsFunctionSpaceType>
 void PartitionedPetscMat<RowsFunctionSpaceType,ColumnsFunctionSpaceType>::
@@ -105,8 +105,8 @@ protected:
   Mat localMatrix_;    //< a local submatrix that holds all rows and columns for the local dofs with ghosts
 };
 
-/** Partial specialization for unstructured meshes. This is completely serial, there are no parallel matrices.
- *  (To enable for parallelism, use petsc IS, not implemented yet)
+/** Partial specialization for unstructured meshes. The rows and columns of the own dofs are stored on the own rank,
+ *  the local dof nos including ghosts are mapped to the global petsc nos by the local to global mapping of the mesh partition (MatSetValuesLocal).
  */
 template<int D, typename BasisFunctionType>
 class PartitionedPetscMatOneComponent<
@@ -170,10 +170,10 @@ public:
   //! get entries from the matrix that are locally stored, uses the global/Petsc indexing. This is not the global natural numbering!
   void getValuesGlobalPetscIndexing(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], PetscScalar v[]) const;
   
-  //! get a reference to the PETSc matrix, because there is no parallelism with UnstructuredDeformableOfDimension meshes, this is the same as valuesGlobal
+  //! get a reference to the PETSc matrix, there is no local submatrix for UnstructuredDeformableOfDimension meshes, this is the same as valuesGlobal
   Mat &valuesLocal();
   
-  //! get a reference to the PETSc matrix, because there is no parallelism with UnstructuredDeformableOfDimension meshes, this is the same as valuesLocal
+  //! get a reference to the PETSc matrix, there is no local submatrix for UnstructuredDeformableOfDimension meshes, this is the same as valuesLocal
   Mat &valuesGlobal();
     
   //! output matrix to stream, the operator<< is also overloaded to use this method
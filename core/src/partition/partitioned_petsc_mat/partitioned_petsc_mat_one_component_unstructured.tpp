@@ -70,13 +70,14 @@ createMatrix(MatType matrixType, int nNonZerosDiagonal, int nNonZerosOffdiagonal
   assert(this->meshPartitionRows_);
   assert(this->meshPartitionColumns_);
   
-  dof_no_t nRowDofs = this->meshPartitionRows_->nDofs();
-  dof_no_t nColumnDofs = this->meshPartitionColumns_->nDofs();
-  //ierr = MatCreateAIJ(rankSubset_->mpiCommunicator(), partition.(), partition.(), n, n,
-  //                    nNonZerosDiagonal, NULL, nNonZerosOffdiagonal, NULL, &matrix); CHKERRV(ierr);
-  
+  // the rows and columns of the own dofs are stored locally, ghost dofs are rows of other ranks
+  dof_no_t nRowDofsLocal = this->meshPartitionRows_->nDofsLocalWithoutGhosts();
+  dof_no_t nColumnDofsLocal = this->meshPartitionColumns_->nDofsLocalWithoutGhosts();
+  global_no_t nRowDofsGlobal = this->meshPartitionRows_->nDofsGlobal();
+  global_no_t nColumnDofsGlobal = this->meshPartitionColumns_->nDofsGlobal();
+
   ierr = MatCreate(this->meshPartitionRows_->mpiCommunicator(), &this->matrix_); CHKERRV(ierr);
-  ierr = MatSetSizes(this->matrix_, nRowDofs, nColumnDofs, nRowDofs, nColumnDofs); CHKERRV(ierr);
+  ierr = MatSetSizes(this->matrix_, nRowDofsLocal, nColumnDofsLocal, nRowDofsGlobal, nColumnDofsGlobal); CHKERRV(ierr);
 
   ierr = MatSetType(this->matrix_, matrixType); CHKERRV(ierr);
 
@@ -102,6 +103,10 @@ createMatrix(MatType matrixType, int nNonZerosDiagonal, int nNonZerosOffdiagonal
     ierr = MatMPIAIJSetPreallocation(this->matrix_, nNonZerosDiagonal, NULL, nNonZerosOffdiagonal, NULL); CHKERRV(ierr);
     ierr = MatSeqAIJSetPreallocation(this->matrix_, nNonZerosDiagonal, NULL); CHKERRV(ierr);
   }
+
+  // set the local to global mapping, such that values can be set with local dof nos including ghosts by MatSetValuesLocal
+  ierr = MatSetLocalToGlobalMapping(this->matrix_, this->meshPartitionRows_->localToGlobalMappingDofs(),
+                                    this->meshPartitionColumns_->localToGlobalMappingDofs()); CHKERRV(ierr);
 }
 
 template<int D, typename BasisFunctionType>
@@ -117,7 +122,7 @@ setValue(PetscInt row, PetscInt col, PetscScalar value, InsertMode mode)
   
   // this wraps the standard PETSc MatSetValue on the local matrix
   PetscErrorCode ierr;
-  ierr = MatSetValues(this->matrix_, 1, &row, 1, &col, &value, mode); CHKERRV(ierr);
+  ierr = MatSetValuesLocal(this->matrix_, 1, &row, 1, &col, &value, mode); CHKERRV(ierr);
 }
 
 template<int D, typename BasisFunctionType>
@@ -134,7 +139,7 @@ setValue(Vc::int_v rows, Vc::int_v columns, PetscScalar value, InsertMode mode)
       PetscInt columnNo = columns[vcComponentNo];
       if (columnNo != -1)
       {
-        ierr = MatSetValues(this->matrix_, 1, &rowNo, 1, &columnNo, &value, mode); CHKERRV(ierr);
+        ierr = MatSetValuesLocal(this->matrix_, 1, &rowNo, 1, &columnNo, &value, mode); CHKERRV(ierr);
       }
     }
   }
@@ -162,7 +167,7 @@ setValue(Vc::int_v rows, Vc::int_v columns, Vc::double_v values, InsertMode mode
       PetscInt columnNo = columns[vcComponentNo];
       if (columnNo != -1)
       {
-        ierr = MatSetValues(this->matrix_, 1, &rowNo, 1, &columnNo, &(data[vcComponentNo]), mode); CHKERRV(ierr);
+        ierr = MatSetValuesLocal(this->matrix_, 1, &rowNo, 1, &columnNo, &(data[vcComponentNo]), mode); CHKERRV(ierr);
       }
     }
   }
@@ -190,7 +195,7 @@ setValues(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[],
   
   // this wraps the standard PETSc MatSetValues on the local matrix
   PetscErrorCode ierr;
-  ierr = MatSetValues(this->matrix_, m, idxm, n, idxn, v, addv); CHKERRV(ierr);
+  ierr = MatSetValuesLocal(this->matrix_, m, idxm, n, idxn, v, addv); CHKERRV(ierr);
 }
 
 template<int D, typename BasisFunctionType>
@@ -208,7 +213,7 @@ zeroRowsColumns(PetscInt numRows, const PetscInt rows[], PetscScalar diag)
   }
   
   PetscErrorCode ierr;
-  ierr = MatZeroRowsColumns(this->matrix_, numRows, rows, diag, NULL, NULL); CHKERRV(ierr);
+  ierr = MatZeroRowsColumnsLocal(this->matrix_, numRows, rows, diag, NULL, NULL); CHKERRV(ierr);
   
   // assemble the global matrix
   ierr = MatAssemblyBegin(this->matrix_, MAT_FLUSH_ASSEMBLY); CHKERRV(ierr);
@@ -300,11 +305,17 @@ template<int D, typename BasisFunctionType>
 void PartitionedPetscMatOneComponent<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>>::
 getValues(PetscInt m, const PetscInt idxm[], PetscInt n, const PetscInt idxn[], PetscScalar v[]) const
 {
-  // this wraps the standard PETSc MatGetValues, for the global indexing, only retrieves locally stored indices
+  // this wraps the standard PETSc MatGetValues, for the local indexing, only retrieves locally stored indices
   PetscErrorCode ierr;
 
+  // transform the local indices to global petsc indices, there is no MatGetValuesLocal
+  std::vector<PetscInt> rowNosGlobalPetsc(m);
+  std::vector<PetscInt> columnNosGlobalPetsc(n);
+  ierr = ISLocalToGlobalMappingApply(this->meshPartitionRows_->localToGlobalMappingDofs(), m, idxm, rowNosGlobalPetsc.data()); CHKERRV(ierr);
+  ierr = ISLocalToGlobalMappingApply(this->meshPartitionColumns_->localToGlobalMappingDofs(), n, idxn, columnNosGlobalPetsc.data()); CHKERRV(ierr);
+
   // access the global matrix
-  ierr = MatGetValues(this->matrix_, m, idxm, n, idxn, v); CHKERRV(ierr);
+  ierr = MatGetValues(this->matrix_, m, rowNosGlobalPetsc.data(), n, columnNosGlobalPetsc.data(), v); CHKERRV(ierr);
 }
 
 template<int D, typename BasisFunctionType>
@@ -44,6 +44,12 @@ public:
   //! Communicates the ghost values from the global vectors to the local vector and sets the representation to local.
   //! The representation has to be global, afterwards it is set to local.
   void startGhostManipulation();
+
+  //! split-phase version of startGhostManipulation, the combined vector is communicated at once, therefore this is the same as startGhostManipulation
+  void startGhostManipulationBegin();
+
+  //! complete the split-phase startGhostManipulation, does nothing because startGhostManipulationBegin already communicated the ghost values
+  void startGhostManipulationEnd();
   
   //! Communicates the ghost values from the local vectors back to the global vector and sets the representation to global.
   //! The representation has to be local, afterwards it is set to global.
@@ -121,6 +121,21 @@ startGhostManipulation()
   this->currentRepresentation_ = Partition::values_representation_t::representationCombinedLocal;
 }
 
+//! split-phase version of startGhostManipulation, the combined vector is communicated at once
+template<typename FunctionSpaceType, int nComponents, int nComponentsDirichletBc>
+void PartitionedPetscVecWithDirichletBc<FunctionSpaceType, nComponents, nComponentsDirichletBc>::
+startGhostManipulationBegin()
+{
+  startGhostManipulation();
+}
+
+//! complete the split-phase startGhostManipulation, the ghost values were already communicated by startGhostManipulationBegin
+template<typename FunctionSpaceType, int nComponents, int nComponentsDirichletBc>
+void PartitionedPetscVecWithDirichletBc<FunctionSpaceType, nComponents, nComponentsDirichletBc>::
+startGhostManipulationEnd()
+{
+}
+
 //! Communicates the ghost values from the local vectors back to the global vector and sets the representation to global.
 //! The representation has to be local, afterwards it is set to global.
 template<typename FunctionSpaceType, int nComponents, int nComponentsDirichletBc>
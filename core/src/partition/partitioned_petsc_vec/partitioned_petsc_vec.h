@@ -27,10 +27,9 @@ enum values_modified_t
  *  Global Natural numbering: normal indexing proceeding fastest in x, then in y, then in z direction, over the whole domain.
  *  Local numbering: starting with 0, first all non-ghost values, then the ghost indices.
  * *
- *  This particular standard specialization is for non-structured meshes or no meshes and currently completely serial, 
- *  it is the placeholder as long as the partial specialization for unstructured meshes is not implemented. (It will never be)
- *  This means some of the methods here have no effect. Most likely you want to have a look at the partial specialization for
- *  structured meshes, below this class.
+ *  This particular standard specialization is for function spaces without a mesh partition of one of the known mesh types and is completely serial.
+ *  This means some of the methods here have no effect. Structured, composite and unstructured meshes use the partial specialization
+ *  below this class, because it only needs the local and ghost dof numbering of the mesh partition, not the mesh structure.
  */
 template<typename FunctionSpaceType, int nComponents, typename = typename FunctionSpaceType::Mesh>
 class PartitionedPetscVec : 
@@ -47,6 +46,12 @@ public:
 
   //! this has to be called before the vector is manipulated (i.e. VecSetValues or vecZeroEntries is called)
   void startGhostManipulation();
+
+  //! split-phase version of startGhostManipulation, there is no communication for serial vectors, therefore this is the same as startGhostManipulation
+  void startGhostManipulationBegin();
+
+  //! complete the split-phase startGhostManipulation, does nothing for serial vectors
+  void startGhostManipulationEnd();
   
   //! this has to be called after the vector is manipulated (i.e. VecSetValues or vecZeroEntries is called)
   void finishGhostManipulation();
@@ -137,6 +142,10 @@ protected:
  *
  *  valuesGlobal(componentNo) returns the global Petsc Vec of the given component. valuesGlobal() returns a nested Petsc Vec of all components.
  *
+ *  If the global option "contiguousStorage" is set and the own partition has no ghost dofs, the contiguous vector is allocated first and the component vectors are created on its memory.
+ *  Then the switch between the contiguous and the local or global representation needs no copy. With ghost dofs this is not possible, because the local vector of a component
+ *  needs the ghost values directly after its own values, where the next component is stored in the contiguous vector. Then the values are copied as usual.
+ *
  *  Internally, an own DMDA object is generated, separately from the one in MeshPartition. This object now refers to nodes (as opposite the one of MeshPartition which refers to elements).
  *  This object is created such that it matches the partition given by the meshPartition.
  */
@@ -158,6 +167,14 @@ public:
   //! Communicates the ghost values from the global vectors to the local vector and sets the representation to local.
   //! The representation has to be global, afterwards it is set to local.
   void startGhostManipulation();
+
+  //! Split-phase version of startGhostManipulation, starts the communication of the ghost values and sets the representation to local.
+  //! Until startGhostManipulationEnd() is called, only the non-ghost values may be read and no values may be set.
+  //! This allows to overlap the communication with computations that only need the own values, e.g. on interior elements.
+  void startGhostManipulationBegin();
+
+  //! Completes the communication of the ghost values that was started by startGhostManipulationBegin(), afterwards the ghost values are valid.
+  void startGhostManipulationEnd();
   
   //! Communicates the ghost values from the local vectors back to the global vector and sets the representation to global.
   //! The representation has to be local, afterwards it is set to global.
@@ -262,10 +279,12 @@ protected:
   
   std::shared_ptr<DM> dm_;                    //< PETSc DMDA object that stores topology information and everything needed for communication of ghost values
   bool ghostManipulationStarted_;             //< if startGhostManipulation() was called but not yet finishGhostManipulation(). This indicates that finishGhostManipulation() can be called next without giving an error.
+  bool ghostUpdateInProgress_ = false;        //< if startGhostManipulationBegin() was called but not yet startGhostManipulationEnd(), i.e. the ghost values are currently being communicated
   
   std::array<Vec,nComponents> vectorLocal_;   //< local vector that holds the local Vecs, is filled by startGhostManipulation and can the be manipulated, afterwards the results need to get copied back by finishGhostManipulation
   std::array<Vec,nComponents> vectorGlobal_;  //< the global distributed vector that holds the actual data
   Vec valuesContiguous_ = PETSC_NULL;         //< global vector that has all values of the components concatenated, i.e. in a "struct of arrays" memory layout. This is never used if nComponents = 1
+  bool hasContiguousStorage_ = false;         //< if valuesContiguous_ is the storage of all components and the component vectors share its memory, then the representation can be switched to and from contiguous without copying values
 
   std::vector<PetscInt> temporaryIndicesVector_;   //< a temporary vector that will be used whenever indices are to be computed, this avoids creating and deleting local vectors which is time-consuming (found out by perftools on hazelhen)
 
@@ -278,13 +297,13 @@ protected:
   Vec vectorNestedGlobal_;                    //< a VecNest object containing the global values, only in used if nComponents > 1
 };
 
-/** This is a partial specialization for structured meshes with multiple components.
+/** This is a partial specialization for structured, composite and unstructured meshes with multiple components.
  */
 template<typename MeshType, typename BasisFunctionType, int nComponents>
 class PartitionedPetscVec<
   FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,
   nComponents,
-  Mesh::isStructuredOrComposite<MeshType>> :
+  Mesh::isStructuredOrCompositeOrUnstructured<MeshType>> :
   public PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>
 {
 public:
@@ -305,7 +324,7 @@ template<typename MeshType, typename BasisFunctionType>
 class PartitionedPetscVec<
   FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,
   1,
-  Mesh::isStructuredOrComposite<MeshType>> :
+  Mesh::isStructuredOrCompositeOrUnstructured<MeshType>> :
   public PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,1>
 {
 public:
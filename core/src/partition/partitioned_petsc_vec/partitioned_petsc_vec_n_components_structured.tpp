@@ -47,7 +47,16 @@ PartitionedPetscVecNComponentsStructured(PartitionedPetscVec<FunctionSpace::Func
       vectorLocal_[componentNo] = rhs.vectorLocal_[rhsComponentNoBegin + componentNo];
     }
 
-    valuesContiguous_ = rhs.valuesContiguous_;
+    // if the contiguous vector of rhs is the storage of its components, it can only be shared if all components are used
+    if (rhs.hasContiguousStorage_ && (nComponents != nComponents2 || rhsComponentNoBegin != 0))
+    {
+      valuesContiguous_ = PETSC_NULL;
+    }
+    else
+    {
+      valuesContiguous_ = rhs.valuesContiguous_;
+      hasContiguousStorage_ = rhs.hasContiguousStorage_;
+    }
     extractedData_ = rhs.extractedData_;
     savedVectorLocal_ = rhs.savedVectorLocal_;
     savedVectorGlobal_ = rhs.savedVectorGlobal_;
@@ -92,15 +101,46 @@ createVector()
   // and then fetch the local portion of the global vector together with ghost values into a local vector (VecGhostGetLocalForm),
   // then manipulate the values (using standard VecSetValues/VecGetValues routines) and commit the results (VecGhostRestoreLocalForm, VecGhostUpdateBegin, VecGhostUpdateEnd).
   
+  const dof_no_t nDofsLocalWithoutGhosts = this->meshPartition_->nDofsLocalWithoutGhosts();
+  const dof_no_t nGhostDofs = this->meshPartition_->nDofsLocalWithGhosts() - nDofsLocalWithoutGhosts;
+
+  // If contiguous storage is enabled, create the contiguous vector first and then the component vectors on its memory.
+  // This is only possible without ghost dofs, because the ghost values of a component would be stored where the next component starts.
+  double *valuesDataContiguous = nullptr;
+  hasContiguousStorage_ = (Partition::contiguousStorageEnabled && nComponents > 1 && nGhostDofs == 0);
+  if (hasContiguousStorage_)
+  {
+    ierr = VecCreateSeq(MPI_COMM_SELF, nDofsLocalWithoutGhosts*nComponents, &valuesContiguous_); CHKERRV(ierr);
+    ierr = PetscObjectSetName((PetscObject) valuesContiguous_, this->name_.c_str()); CHKERRV(ierr);
+
+    // the pointer stays valid after VecRestoreArray, because a sequential vector always keeps its own array
+    double *array;
+    ierr = VecGetArray(valuesContiguous_, &array); CHKERRV(ierr);
+    valuesDataContiguous = array;
+    ierr = VecRestoreArray(valuesContiguous_, &array); CHKERRV(ierr);
+
+    VLOG(1) << "\"" << this->name_ << "\" use contiguous storage for " << nComponents << " components";
+  }
+
   // loop over the components of this field variable
   for (int componentNo = 0; componentNo < nComponents; componentNo++)
   {
-    const dof_no_t nGhostDofs = this->meshPartition_->nDofsLocalWithGhosts() - this->meshPartition_->nDofsLocalWithoutGhosts();
     VLOG(2) << "\"" << this->name_ << "\" component " << componentNo << ", VecCreateGhost " << *this->meshPartition_->rankSubset()
-      << " size local: " << this->meshPartition_->nDofsLocalWithoutGhosts() << ", global: " << this->meshPartition_->nDofsGlobal()
+      << " size local: " << nDofsLocalWithoutGhosts << ", global: " << this->meshPartition_->nDofsGlobal()
       << ", n dofs: " << nGhostDofs;
-    ierr = VecCreateGhost(this->meshPartition_->mpiCommunicator(), this->meshPartition_->nDofsLocalWithoutGhosts(),
-                          this->meshPartition_->nDofsGlobal(), nGhostDofs, this->meshPartition_->ghostDofNosGlobalPetsc().data(), &vectorGlobal_[componentNo]); CHKERRV(ierr);
+
+    if (hasContiguousStorage_)
+    {
+      // the component uses its part of the memory of the contiguous vector
+      ierr = VecCreateGhostWithArray(this->meshPartition_->mpiCommunicator(), nDofsLocalWithoutGhosts,
+                                     this->meshPartition_->nDofsGlobal(), nGhostDofs, this->meshPartition_->ghostDofNosGlobalPetsc().data(),
+                                     valuesDataContiguous + componentNo*nDofsLocalWithoutGhosts, &vectorGlobal_[componentNo]); CHKERRV(ierr);
+    }
+    else
+    {
+      ierr = VecCreateGhost(this->meshPartition_->mpiCommunicator(), nDofsLocalWithoutGhosts,
+                            this->meshPartition_->nDofsGlobal(), nGhostDofs, this->meshPartition_->ghostDofNosGlobalPetsc().data(), &vectorGlobal_[componentNo]); CHKERRV(ierr);
+    }
     
 #if 0
     // debugging tests, learn how ghost value communcation works
@@ -222,8 +262,11 @@ createVector()
     //ierr = VecCreate(this->meshPartition_->mpiCommunicator(), &vectorLocal_[componentNo]); CHKERRV(ierr);
     ierr = PetscObjectSetName((PetscObject) vectorGlobal_[componentNo], this->name_.c_str()); CHKERRV(ierr);
 
-    // set sparsity type and other options
-    ierr = VecSetFromOptions(vectorGlobal_[componentNo]); CHKERRV(ierr);
+    // set sparsity type and other options, not for contiguous storage, because a change of the vector type would allocate new memory
+    if (!hasContiguousStorage_)
+    {
+      ierr = VecSetFromOptions(vectorGlobal_[componentNo]); CHKERRV(ierr);
+    }
     ierr = VecGhostGetLocalForm(vectorGlobal_[componentNo], &vectorLocal_[componentNo]); CHKERRV(ierr);
 
     // ignore negative indices. This is needed when Vc::int_v contains the indices
@@ -333,7 +376,15 @@ template<typename MeshType,typename BasisFunctionType,int nComponents>
 void PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>::
 startGhostManipulation()
 {
-  VLOG(2) << "\"" << this->name_ << "\" startGhostManipulation";
+  startGhostManipulationBegin();
+  startGhostManipulationEnd();
+}
+
+template<typename MeshType,typename BasisFunctionType,int nComponents>
+void PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>::
+startGhostManipulationBegin()
+{
+  VLOG(2) << "\"" << this->name_ << "\" startGhostManipulationBegin";
   
   if (this->currentRepresentation_ != Partition::values_representation_t::representationGlobal)
   {
@@ -354,16 +405,39 @@ startGhostManipulation()
     //ierr = VecZeroEntries(vectorLocal_[componentNo]); CHKERRV(ierr);
     //ierr = DMGlobalToLocalBegin(*dm_, vectorGlobal_[componentNo], INSERT_VALUES, vectorLocal_[componentNo]); CHKERRV(ierr);
   }
+
+  // get the local vectors already, they share the memory with the global vectors, the non-ghost values are valid, the ghost values only after startGhostManipulationEnd()
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+  {
+    ierr = VecGhostGetLocalForm(vectorGlobal_[componentNo], &vectorLocal_[componentNo]); CHKERRV(ierr);
+  }
+
+  ghostUpdateInProgress_ = true;
+  this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
+}
+
+template<typename MeshType,typename BasisFunctionType,int nComponents>
+void PartitionedPetscVecNComponentsStructured<MeshType,BasisFunctionType,nComponents>::
+startGhostManipulationEnd()
+{
+  VLOG(2) << "\"" << this->name_ << "\" startGhostManipulationEnd";
+
+  if (!ghostUpdateInProgress_)
+  {
+    LOG(ERROR) << "\"" << this->name_ << "\", startGhostManipulationEnd called without previous startGhostManipulationBegin.";
+    return;
+  }
+
+  PetscErrorCode ierr;
   
   // loop over the components of this field variable
   for (int componentNo = 0; componentNo < nComponents; componentNo++)
   {
     ierr = VecGhostUpdateEnd(vectorGlobal_[componentNo], INSERT_VALUES, SCATTER_FORWARD); CHKERRV(ierr);
     //ierr = DMGlobalToLocalEnd(*dm_, vectorGlobal_[componentNo], INSERT_VALUES, vectorLocal_[componentNo]); CHKERRV(ierr);
-    ierr = VecGhostGetLocalForm(vectorGlobal_[componentNo], &vectorLocal_[componentNo]); CHKERRV(ierr);
   }
 
-  this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
+  ghostUpdateInProgress_ = false;
 }
 
 template<typename MeshType,typename BasisFunctionType,int nComponents>
@@ -378,6 +452,13 @@ finishGhostManipulation()
       << this->getCurrentRepresentationString()
       << "), (probably no previous startGhostManipulation)";
   }
+
+  // complete a split-phase startGhostManipulation, if this has not yet been done
+  if (ghostUpdateInProgress_)
+  {
+    LOG(WARNING) << "\"" << this->name_ << "\", finishGhostManipulation called before startGhostManipulationEnd.";
+    startGhostManipulationEnd();
+  }
   
   // Copy the local values vectors into the global vector. ADD_VALUES means that ghost values are reduced (summed up)
   PetscErrorCode ierr;
@@ -778,6 +859,16 @@ setRepresentationContiguous()
 
   PetscErrorCode ierr;
 
+  // if the component vectors use the memory of the contiguous vector, the values are already there
+  if (hasContiguousStorage_)
+  {
+    // the values may have been changed through the component vectors, invalidate cached values like norms of the contiguous vector
+    ierr = PetscObjectStateIncrease((PetscObject)valuesContiguous_); CHKERRABORT(this->meshPartition_->mpiCommunicator(),ierr);
+
+    this->currentRepresentation_ = Partition::values_representation_t::representationContiguous;
+    return;
+  }
+
   // create contiguos vector if it does not exist yet
   if (valuesContiguous_ == PETSC_NULL)
   {
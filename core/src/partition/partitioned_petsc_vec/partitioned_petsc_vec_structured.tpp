@@ -3,7 +3,7 @@
 //! fill a contiguous vector with all components after each other, "struct of array"-type data layout.
 //! after manipulation of the vector has finished one has to call restoreValuesContiguous
 template<typename MeshType,typename BasisFunctionType,int nComponents>
-Vec &PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents,Mesh::isStructuredOrComposite<MeshType>>::
+Vec &PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents,Mesh::isStructuredOrCompositeOrUnstructured<MeshType>>::
 getValuesContiguous()
 {
   VLOG(2) << "\"" << this->name_ << "\" getValuesContiguous()";
@@ -16,7 +16,7 @@ getValuesContiguous()
 //! fill a contiguous vector with all components after each other, "struct of array"-type data layout.
 //! after manipulation of the vector has finished one has to call restoreValuesContiguous
 template<typename MeshType,typename BasisFunctionType>
-Vec &PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,1,Mesh::isStructuredOrComposite<MeshType>>::
+Vec &PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,1,Mesh::isStructuredOrCompositeOrUnstructured<MeshType>>::
 getValuesContiguous()
 {
   VLOG(2) << "\"" << this->name_ << "\" getValuesContiguous(), nComponents=1";
@@ -27,7 +27,7 @@ getValuesContiguous()
 //! copy the values back from a contiguous representation where all components are in one vector to the standard internal format of PartitionedPetscVec where there is one local vector with ghosts for each component.
 //! this has to be called
 template<typename MeshType,typename BasisFunctionType,int nComponents>
-void PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents,Mesh::isStructuredOrComposite<MeshType>>::
+void PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,nComponents,Mesh::isStructuredOrCompositeOrUnstructured<MeshType>>::
 restoreValuesContiguous()
 {
   VLOG(2) << "\"" << this->name_ << "\" restoreValuesContiguous() nComponents=" << nComponents;
@@ -40,8 +40,23 @@ restoreValuesContiguous()
       << this->getCurrentRepresentationString() << ", probably without previous getValuesContiguous()";
   }
 
-  // copy values from component vectors to contiguous vector
   PetscErrorCode ierr;
+
+  // if the component vectors use the memory of the contiguous vector, the values are already there
+  if (this->hasContiguousStorage_)
+  {
+    // the values may have been changed through the contiguous vector, invalidate cached values like norms of the component vectors
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      ierr = PetscObjectStateIncrease((PetscObject)this->vectorLocal_[componentNo]); CHKERRV(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)this->vectorGlobal_[componentNo]); CHKERRV(ierr);
+    }
+
+    this->currentRepresentation_ = Partition::values_representation_t::representationLocal;
+    return;
+  }
+
+  // copy values from component vectors to contiguous vector
   const double *valuesDataContiguous;
   ierr = VecGetArrayRead(this->valuesContiguous_, &valuesDataContiguous); CHKERRV(ierr);
 
@@ -75,7 +90,7 @@ restoreValuesContiguous()
 //! copy the values back from a contiguous representation where all components are in one vector to the standard internal format of PartitionedPetscVec where there is one local vector with ghosts for each component.
 //! this has to be called
 template<typename MeshType,typename BasisFunctionType>
-void PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,1,Mesh::isStructuredOrComposite<MeshType>>::
+void PartitionedPetscVec<FunctionSpace::FunctionSpace<MeshType,BasisFunctionType>,1,Mesh::isStructuredOrCompositeOrUnstructured<MeshType>>::
 restoreValuesContiguous()
 {
   VLOG(2) << "\"" << this->name_ << "\" restoreValuesContiguous() nComponents=1";
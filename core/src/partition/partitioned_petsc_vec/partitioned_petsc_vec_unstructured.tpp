@@ -93,6 +93,21 @@ startGhostManipulation()
 {
 }
 
+//! split-phase version of startGhostManipulation, there is no communication for serial vectors
+template<typename FunctionSpaceType, int nComponents, typename DummyForTraits>
+void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
+startGhostManipulationBegin()
+{
+  startGhostManipulation();
+}
+
+//! complete the split-phase startGhostManipulation, there is no communication for serial vectors
+template<typename FunctionSpaceType, int nComponents, typename DummyForTraits>
+void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
+startGhostManipulationEnd()
+{
+}
+
 //! this has to be called after the vector is manipulated (i.e. VecSetValues or vecZeroEntries is called)
 template<typename FunctionSpaceType, int nComponents, typename DummyForTraits>
 void PartitionedPetscVec<FunctionSpaceType, nComponents, DummyForTraits>::
@@ -14,4 +14,6 @@ const char *valuesRepresentationString[16] =
   "no-vector"
 };
 
+bool contiguousStorageEnabled = false;
+
 } // namespace
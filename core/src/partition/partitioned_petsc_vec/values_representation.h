@@ -16,4 +16,8 @@ enum values_representation_t
 
 extern const char *valuesRepresentationString[16];
 
+//! if multi-component vectors should use the contiguous vector as the storage of all components, such that the component vectors share its memory and
+//! the switch to and from the contiguous representation needs no copy, this is set by the global option "contiguousStorage"
+extern bool contiguousStorageEnabled;
+
 } // namespace
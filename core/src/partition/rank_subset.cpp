@@ -132,7 +132,7 @@ RankSubset::RankSubset(int singleRank, std::shared_ptr<RankSubset> parentRankSub
 }
 
 //! constructor that reuses an existing mpi communicator, e.g. generated by xbraid
-RankSubset::RankSubset(MPI_Comm mpiCommunicator)
+RankSubset::RankSubset(MPI_Comm mpiCommunicator) : nCommunicatorsSplit_(0)
 {
   mpiCommunicator_ = mpiCommunicator;
   isWorldCommunicator_ = mpiCommunicator == MPI_COMM_WORLD;
@@ -140,6 +140,23 @@ RankSubset::RankSubset(MPI_Comm mpiCommunicator)
   // get own rank no
   MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator_, &ownRankNo_), "MPI_Comm_rank");
 
+  // store the ranks of the communicator in terms of MPI_COMM_WORLD, such that size() is correct
+  int nRanks = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator_, &nRanks), "MPI_Comm_size");
+
+  MPI_Group group, worldGroup;
+  MPIUtility::handleReturnValue(MPI_Comm_group(mpiCommunicator_, &group), "MPI_Comm_group");
+  MPIUtility::handleReturnValue(MPI_Comm_group(MPI_COMM_WORLD, &worldGroup), "MPI_Comm_group");
+
+  std::vector<int> ranks(nRanks);
+  std::vector<int> worldRanks(nRanks);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  MPIUtility::handleReturnValue(MPI_Group_translate_ranks(group, nRanks, ranks.data(), worldGroup, worldRanks.data()), "MPI_Group_translate_ranks");
+  rankNo_.insert(worldRanks.begin(), worldRanks.end());
+
+  MPIUtility::handleReturnValue(MPI_Group_free(&group), "MPI_Group_free");
+  MPIUtility::handleReturnValue(MPI_Group_free(&worldGroup), "MPI_Group_free");
+
   // get name of communicator
   std::vector<char> communicatorNameStr(MPI_MAX_OBJECT_NAME);
   int communicatorNameLength = 0;
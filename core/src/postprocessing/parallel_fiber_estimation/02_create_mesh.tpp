@@ -47,69 +47,96 @@ createMesh(std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, std::ve
   file.close();
 
 #else
-  // call stl_create_mesh.create_3d_mesh_from_boundary_points_faces
-  PyObject *boundaryPointsFacesPy = PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(boundaryPoints);
-  PythonUtility::checkForError();
-
-  //LOG(DEBUG) << PythonUtility::getString(boundaryPointsFacesPy);
-  LOG(DEBUG) << "call function create_3d_mesh_from_boundary_points_faces";
+  // create the mesh natively, if this fails use the python script
+  bool nativeMeshCreated = false;
+  if (useNativeMeshGeneration_)
+  {
+    nativeMeshCreated = createMeshNative(boundaryPoints, nodePositions, nElementsPerCoordinateDirectionLocal);
 
-  PyObject *meshData = PyObject_CallFunction(functionCreate3dMeshFromBoundaryPointsFaces_, "(O,O,d,i)", 
-                                             boundaryPointsFacesPy, (improveMesh_? Py_True : Py_False), maxAreaFactor_, level_);
-  PythonUtility::checkForError();
+    // count the ranks where the python script has to be used, all ranks of the current rank subset create their mesh at the same time
+    int nFailed = (nativeMeshCreated? 0 : 1);
+    int nFailedGlobal = 0;
+    MPIUtility::handleReturnValue(MPI_Reduce(&nFailed, &nFailedGlobal, 1, MPI_INT, MPI_SUM, 0, currentRankSubset_->mpiCommunicator()), "MPI_Reduce");
 
-  if (meshData == Py_None)
-  {
-    LOG(FATAL) << "Python function create_3d_mesh_from_boundary_points_faces returned None!";
+    if (currentRankSubset_->ownRankNo() == 0 && nFailedGlobal > 0)
+    {
+      LOG(WARNING) << "Native mesh generation failed on level " << level_ << " on " << nFailedGlobal << " of " << currentRankSubset_->size()
+        << " rank(s), using the python script there.";
+    }
   }
 
-  //LOG(DEBUG) << PythonUtility::getString(meshData);
-  // return value:
-  //data = {
-  //  "node_positions": node_positions,
-  //  "linear_elements": linear_elements,
-  //  "quadratic_elements": quadratic_elements,
-  //  "seed_points": seed_points,
-  //  "bottom_nodes": bottom_node_indices,
-  //  "top_nodes": top_node_indices,
-  //  "n_linear_elements_per_coordinate_direction": n_linear_elements_per_coordinate_direction,
-  //  "n_quadratic_elements_per_coordinate_direction": n_quadratic_elements_per_coordinate_direction,
-  //}
-
-  PyObject *object = PythonUtility::getOptionPyObject(meshData, "node_positions", "");
-  nodePositions = PythonUtility::convertFromPython<std::vector<Vec3>>::get(object);
-
-  // for linear elements
-  if (BasisFunctionType::getBasisOrder() == 1)
+  if (nativeMeshCreated)
   {
-    nElementsPerCoordinateDirectionLocal = PythonUtility::getOptionArray<int,3>(meshData, "n_linear_elements_per_coordinate_direction", "", std::array<int,3>({0,0,0}));
-
-    subdomainNNodesX = nElementsPerCoordinateDirectionLocal[0]+1;
-    subdomainNNodesY = nElementsPerCoordinateDirectionLocal[1]+1;
-    subdomainNNodesZ = nElementsPerCoordinateDirectionLocal[2]+1;
+    subdomainNNodesX = nBoundaryPointsXNew_;
+    subdomainNNodesY = nBoundaryPointsXNew_;
+    subdomainNNodesZ = nBoundaryPointsZ_;
   }
-  else if (BasisFunctionType::getBasisOrder() == 2)
+  else
   {
-    // for quadratic elements
-    nElementsPerCoordinateDirectionLocal = PythonUtility::getOptionArray<int,3>(meshData, "n_quadratic_elements_per_coordinate_direction", "", std::array<int,3>({0,0,0}));
+    // call stl_create_mesh.create_3d_mesh_from_boundary_points_faces
+    PyObject *boundaryPointsFacesPy = PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(boundaryPoints);
+    PythonUtility::checkForError();
 
-    subdomainNNodesX = 2*nElementsPerCoordinateDirectionLocal[0]+1;
-    subdomainNNodesY = 2*nElementsPerCoordinateDirectionLocal[1]+1;
-    subdomainNNodesZ = 2*nElementsPerCoordinateDirectionLocal[2]+1;
-  }
+    //LOG(DEBUG) << PythonUtility::getString(boundaryPointsFacesPy);
+    LOG(DEBUG) << "call function create_3d_mesh_from_boundary_points_faces";
+
+    PyObject *meshData = PyObject_CallFunction(functionCreate3dMeshFromBoundaryPointsFaces_, "(O,O,d,i)", 
+                                               boundaryPointsFacesPy, (improveMesh_? Py_True : Py_False), maxAreaFactor_, level_);
+    PythonUtility::checkForError();
+
+    if (meshData == Py_None)
+    {
+      LOG(FATAL) << "Python function create_3d_mesh_from_boundary_points_faces returned None!";
+    }
 
+    //LOG(DEBUG) << PythonUtility::getString(meshData);
+    // return value:
+    //data = {
+    //  "node_positions": node_positions,
+    //  "linear_elements": linear_elements,
+    //  "quadratic_elements": quadratic_elements,
+    //  "seed_points": seed_points,
+    //  "bottom_nodes": bottom_node_indices,
+    //  "top_nodes": top_node_indices,
+    //  "n_linear_elements_per_coordinate_direction": n_linear_elements_per_coordinate_direction,
+    //  "n_quadratic_elements_per_coordinate_direction": n_quadratic_elements_per_coordinate_direction,
+    //}
+
+    PyObject *object = PythonUtility::getOptionPyObject(meshData, "node_positions", "");
+    nodePositions = PythonUtility::convertFromPython<std::vector<Vec3>>::get(object);
+
+    // for linear elements
+    if (BasisFunctionType::getBasisOrder() == 1)
+    {
+      nElementsPerCoordinateDirectionLocal = PythonUtility::getOptionArray<int,3>(meshData, "n_linear_elements_per_coordinate_direction", "", std::array<int,3>({0,0,0}));
 
-  LOG(DEBUG) << "subdomainNNodes: " << subdomainNNodesX << " x " << subdomainNNodesY << " x " << subdomainNNodesZ;
+      subdomainNNodesX = nElementsPerCoordinateDirectionLocal[0]+1;
+      subdomainNNodesY = nElementsPerCoordinateDirectionLocal[1]+1;
+      subdomainNNodesZ = nElementsPerCoordinateDirectionLocal[2]+1;
+    }
+    else if (BasisFunctionType::getBasisOrder() == 2)
+    {
+      // for quadratic elements
+      nElementsPerCoordinateDirectionLocal = PythonUtility::getOptionArray<int,3>(meshData, "n_quadratic_elements_per_coordinate_direction", "", std::array<int,3>({0,0,0}));
 
-  if (subdomainNNodesX != nBoundaryPointsXNew_ || subdomainNNodesY != nBoundaryPointsXNew_ || subdomainNNodesZ != nBoundaryPointsZ_)
-  {
-    PyObject_CallFunction(functionOutputBoundaryPoints_, "s i i O f", "xx_failed_boundary_points", currentRankSubset_->ownRankNo(), level_,
-                          PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(boundaryPoints), 0.03);
-    PythonUtility::checkForError();
+      subdomainNNodesX = 2*nElementsPerCoordinateDirectionLocal[0]+1;
+      subdomainNNodesY = 2*nElementsPerCoordinateDirectionLocal[1]+1;
+      subdomainNNodesZ = 2*nElementsPerCoordinateDirectionLocal[2]+1;
+    }
+
+
+    LOG(DEBUG) << "subdomainNNodes: " << subdomainNNodesX << " x " << subdomainNNodesY << " x " << subdomainNNodesZ;
+
+    if (subdomainNNodesX != nBoundaryPointsXNew_ || subdomainNNodesY != nBoundaryPointsXNew_ || subdomainNNodesZ != nBoundaryPointsZ_)
+    {
+      PyObject_CallFunction(functionOutputBoundaryPoints_, "s i i O f", "xx_failed_boundary_points", currentRankSubset_->ownRankNo(), level_,
+                            PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(boundaryPoints), 0.03);
+      PythonUtility::checkForError();
+    }
+    assert(subdomainNNodesX == nBoundaryPointsXNew_);
+    assert(subdomainNNodesY == nBoundaryPointsXNew_);
+    assert(subdomainNNodesZ == nBoundaryPointsZ_);
   }
-  assert(subdomainNNodesX == nBoundaryPointsXNew_);
-  assert(subdomainNNodesY == nBoundaryPointsXNew_);
-  assert(subdomainNNodesZ == nBoundaryPointsZ_);
 /*
   // revert order of node positions
   std::vector<Vec3> nodePositions(nodePositionsOrderReversed.size());
@@ -0,0 +1,439 @@
+#include "postprocessing/parallel_fiber_estimation/parallel_fiber_estimation.h"
+
+#include <cmath>
+#include "utility/vector_operators.h"
+#include "utility/math_utility.h"
+
+namespace Postprocessing
+{
+
+template<typename BasisFunctionType>
+bool ParallelFiberEstimation<BasisFunctionType>::
+createMeshNative(const std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal)
+{
+  // The mesh is created in the same way as in stl_create_mesh.create_3d_mesh_from_boundary_points_faces:
+  // For every z-level, a 2D structured grid with nBoundaryPointsXNew_ x nBoundaryPointsXNew_ nodes is created from the boundary points of the four faces (createPlanarMeshNative).
+  // The 2D grids of all z-levels are then stacked to the 3D mesh, the node numbering is x fastest, then y, then z.
+  const int nNodesX = nBoundaryPointsXNew_;
+  const int nNodesZ = nBoundaryPointsZ_;
+
+  LOG(DEBUG) << "createMeshNative, " << nNodesX << " x " << nNodesX << " x " << nNodesZ << " nodes";
+
+  // check that the boundary points have the expected sizes
+  for (int face = Mesh::face_t::face0Minus; face <= Mesh::face_t::face1Plus; face++)
+  {
+    if ((int)boundaryPoints[face].size() != nNodesZ)
+    {
+      LOG(DEBUG) << "createMeshNative: face " << Mesh::getString((Mesh::face_t)face) << " has " << boundaryPoints[face].size()
+        << " z-levels of boundary points, expected " << nNodesZ;
+      return false;
+    }
+
+    for (int zIndex = 0; zIndex < nNodesZ; zIndex++)
+    {
+      if ((int)boundaryPoints[face][zIndex].size() != nNodesX)
+      {
+        LOG(DEBUG) << "createMeshNative: face " << Mesh::getString((Mesh::face_t)face) << ", z-level " << zIndex << " has "
+          << boundaryPoints[face][zIndex].size() << " boundary points, expected " << nNodesX;
+        return false;
+      }
+    }
+  }
+
+  nodePositions.resize(nNodesX*nNodesX*nNodesZ);
+
+  // the z-levels are independent of each other
+  int nInvalidLevels = 0;
+#pragma omp parallel for reduction(+:nInvalidLevels)
+  for (int zIndex = 0; zIndex < nNodesZ; zIndex++)
+  {
+    if (!createPlanarMeshNative(boundaryPoints, zIndex, nodePositions.data() + zIndex*nNodesX*nNodesX))
+      nInvalidLevels++;
+  }
+
+  if (nInvalidLevels > 0)
+  {
+    LOG(DEBUG) << "createMeshNative: the 2D mesh could not be created on " << nInvalidLevels << " of " << nNodesZ << " z-levels.";
+    return false;
+  }
+
+  // for linear elements
+  if (BasisFunctionType::getBasisOrder() == 1)
+  {
+    nElementsPerCoordinateDirectionLocal = std::array<int,3>({nNodesX-1, nNodesX-1, nNodesZ-1});
+  }
+  else if (BasisFunctionType::getBasisOrder() == 2)
+  {
+    // for quadratic elements, the numbers of nodes are odd
+    nElementsPerCoordinateDirectionLocal = std::array<int,3>({(nNodesX-1)/2, (nNodesX-1)/2, (nNodesZ-1)/2});
+  }
+
+  return true;
+}
+
+template<typename BasisFunctionType>
+bool ParallelFiberEstimation<BasisFunctionType>::
+createPlanarMeshNative(const std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, int zIndex, Vec3 *nodePositions)
+{
+  // This is the algorithm of stl_create_mesh.create_planar_mesh with triangulation_type 2 and parametric_space_shape 3:
+  // 1. The loop of boundary points is triangulated by triangles around its center of gravity (create_slice_tringulation.py).
+  // 2. The harmonic map of this triangulation to the unit disk is computed, the boundary points are mapped to equidistant points on the unit circle (solve_laplace_problem.py).
+  // 3. A structured grid on the unit disk is mapped to the world space by the inverse of the harmonic map,
+  //    i.e. by the barycentric coordinates in the triangles of the parameter space (map_quadrangulation_to_world_space.py).
+  // 4. If improveMesh_ is set, the grid is smoothed by the Laplacian smoothing of fix_and_smooth_mesh.py.
+  //    The resolution of self-intersections and small angles is not implemented, false is returned if the mesh would need it.
+  const int n = nBoundaryPointsXNew_;
+  const int nLoopPoints = 4*(n-1);
+
+  // access to the grid point (i,j)
+  auto node = [&nodePositions,n](int i, int j) -> Vec3 &
+  {
+    return nodePositions[j*n + i];
+  };
+
+  // assemble the loop of boundary points, counter-clockwise starting at the first point of face 1-,
+  // the first / last point of every face is the same as the corresponding point of the adjacent face
+  //   ^ --(1+)-> ^
+  // ^ 0-         0+
+  // | | --(1-)-> |
+  // +-->
+  std::vector<Vec3> loop(nLoopPoints);
+  for (int i = 0; i < n-1; i++)
+  {
+    loop[i]           = boundaryPoints[Mesh::face_t::face1Minus][zIndex][i];
+    loop[(n-1) + i]   = boundaryPoints[Mesh::face_t::face0Plus][zIndex][i];
+    loop[2*(n-1) + i] = boundaryPoints[Mesh::face_t::face1Plus][zIndex][n-1-i];
+    loop[3*(n-1) + i] = boundaryPoints[Mesh::face_t::face0Minus][zIndex][n-1-i];
+  }
+
+  // the center point is the center of gravity, all points are projected to the plane z=const through the center point
+  Vec3 centerPoint({0,0,0});
+  for (const Vec3 &point : loop)
+  {
+    centerPoint += point;
+  }
+  centerPoint /= nLoopPoints;
+
+  for (Vec3 &point : loop)
+  {
+    point[2] = centerPoint[2];
+  }
+
+  // triangle k of the triangulation consists of the center point and the loop points k and k+1
+  // the loop points are mapped to equidistant points on the unit circle
+  std::vector<Vec2> loopParameterSpace(nLoopPoints);
+  for (int k = 0; k < nLoopPoints; k++)
+  {
+    const double phi = double(k) / nLoopPoints * 2 * M_PI;
+    loopParameterSpace[k] = Vec2({cos(phi), sin(phi)});
+  }
+
+  // assemble the row of the stiffness matrix of the Laplace problem that belongs to the center point,
+  // the ansatz functions are the ones of solve_laplace_problem.py, the integrands are quadratic and are integrated exactly by the edge midpoint rule
+  double stiffnessCenterCenter = 0;
+  std::vector<double> stiffnessCenterLoop(nLoopPoints, 0.0);
+  const std::array<Vec2,3> samplingPoints = {Vec2({0.5, 0.0}), Vec2({0.5, 0.5}), Vec2({0.0, 0.5})};
+
+  for (int k = 0; k < nLoopPoints; k++)
+  {
+    const Vec3 dxdxi1 = loop[k] - centerPoint;
+    const Vec3 dxdxi2 = loop[(k+1) % nLoopPoints] - centerPoint;
+
+    // metric tensor of the triangle and its inverse
+    const double g11 = MathUtility::dot(dxdxi1, dxdxi1);
+    const double g12 = MathUtility::dot(dxdxi1, dxdxi2);
+    const double g22 = MathUtility::dot(dxdxi2, dxdxi2);
+    const double determinant = g11*g22 - g12*g12;
+
+    if (determinant <= 0)
+    {
+      VLOG(1) << "z-level " << zIndex << ": triangle " << k << " of the triangulation is degenerate";
+      return false;
+    }
+
+    const double integrationFactor = sqrt(determinant);
+    const std::array<double,3> inverseMetric = {g22/determinant, -g12/determinant, g11/determinant};
+
+    for (const Vec2 &xi : samplingPoints)
+    {
+      // gradients of the ansatz functions of the center point and the loop points k and k+1
+      const std::array<Vec2,3> gradPhi = {
+        Vec2({-(1. - xi[1]), -(1. - xi[0])}),
+        Vec2({1. - xi[1], -xi[0]}),
+        Vec2({-xi[1], 1. - xi[0]})
+      };
+
+      auto integrand = [&gradPhi,&inverseMetric](int dofNo)
+      {
+        return gradPhi[0][0] * (inverseMetric[0]*gradPhi[dofNo][0] + inverseMetric[1]*gradPhi[dofNo][1])
+          + gradPhi[0][1] * (inverseMetric[1]*gradPhi[dofNo][0] + inverseMetric[2]*gradPhi[dofNo][1]);
+      };
+
+      const double weight = 1./6 * integrationFactor;
+      stiffnessCenterCenter += weight * integrand(0);
+      stiffnessCenterLoop[k] += weight * integrand(1);
+      stiffnessCenterLoop[(k+1) % nLoopPoints] += weight * integrand(2);
+    }
+  }
+
+  // solve for the position of the center point in the parameter space
+  Vec2 centerPointParameterSpace({0,0});
+  for (int k = 0; k < nLoopPoints; k++)
+  {
+    centerPointParameterSpace += -stiffnessCenterLoop[k] / stiffnessCenterCenter * loopParameterSpace[k];
+  }
+
+  // find the triangle in the parameter space that contains the point and interpolate the world space position with its barycentric coordinates
+  auto transformToWorldSpace = [&](const Vec2 &pointParameterSpace, Vec3 &pointWorldSpace) -> bool
+  {
+    for (int k = 0; k < nLoopPoints; k++)
+    {
+      const Vec2 dudxi1 = loopParameterSpace[k] - centerPointParameterSpace;
+      const Vec2 dudxi2 = loopParameterSpace[(k+1) % nLoopPoints] - centerPointParameterSpace;
+      const Vec2 difference = pointParameterSpace - centerPointParameterSpace;
+
+      const double determinant = dudxi1[0]*dudxi2[1] - dudxi2[0]*dudxi1[1];
+      if (determinant == 0)
+        continue;
+
+      const double xi1 = ( dudxi2[1]*difference[0] - dudxi2[0]*difference[1]) / determinant;
+      const double xi2 = (-dudxi1[1]*difference[0] + dudxi1[0]*difference[1]) / determinant;
+
+      const double tolerance = 1e-14;
+      if (-tolerance <= xi1 && xi1 <= 1+tolerance && -tolerance <= xi2 && xi2 <= 1+tolerance && xi1 + xi2 <= 1+tolerance)
+      {
+        pointWorldSpace = (1 - xi1 - xi2)*centerPoint + xi1*loop[k] + xi2*loop[(k+1) % nLoopPoints];
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // map the grid points, the grid on the unit disk is the "unit circle with adjusted grid": the square is divided into four triangles at its diagonals
+  // and the grid lines parallel to the boundary of the square are mapped to circular arcs
+  const double sqrt2 = sqrt(2.);
+  for (int j = 0; j < n; j++)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      double x = double(i) / (n-1);
+      double y = double(j) / (n-1);
+
+      if ((n%2 == 1 && j != n/2) || n%2 == 0)
+      {
+        if (j < n/2.)
+        {
+          // bottom triangle
+          if (i >= j && i <= n-1-j)
+          {
+            const double a = ((n-1)/2. - j) * 2.0 / (n-1);
+            const double alpha = double(i - j) / (n-1-2*j);
+            const double phi = -M_PI/4. + M_PI/2.*alpha;
+            x = sin(phi)*a;
+            y = (-1./sqrt2 + (-cos(phi) + 1./sqrt2)*a)*a;
+          }
+        }
+        else
+        {
+          // top triangle
+          if (i >= n-1-j && i <= j)
+          {
+            const double a = (j - (n-1)/2.) * 2.0 / (n-1);
+            const double alpha = double(i - (n-1-j)) / (2*j-n+1);
+            const double phi = -M_PI/4. + M_PI/2.*alpha;
+            x = sin(phi)*a;
+            y = (1./sqrt2 + (cos(phi) - 1./sqrt2)*a)*a;
+          }
+        }
+      }
+
+      if ((n%2 == 1 && i != n/2) || n%2 == 0)
+      {
+        if (i < n/2.)
+        {
+          // left triangle
+          if (j >= i && j <= n-1-i)
+          {
+            const double a = ((n-1)/2. - i) * 2.0 / (n-1);
+            const double alpha = double(j - i) / (n-1-2*i);
+            const double phi = -M_PI/4. + M_PI/2.*alpha;
+            y = sin(phi)*a;
+            x = (-1./sqrt2 + (-cos(phi) + 1./sqrt2)*a)*a;
+          }
+        }
+        else
+        {
+          // right triangle
+          if (j >= n-i && j <= i)
+          {
+            const double a = (i - (n-1)/2.) * 2.0 / (n-1);
+            const double alpha = double(j - (n-1-i)) / (2*i-n+1);
+            const double phi = -M_PI/4. + M_PI/2.*alpha;
+            y = sin(phi)*a;
+            x = (1./sqrt2 + (cos(phi) - 1./sqrt2)*a)*a;
+          }
+        }
+      }
+
+      // rotate the grid such that the grid point (0,0) is mapped to the first loop point
+      const double phi = atan2(y, x) + M_PI/4 + M_PI/2;
+      const double r = sqrt(x*x + y*y);
+      Vec2 pointParameterSpace({cos(phi)*r, sin(phi)*r});
+
+      // center point
+      if (n%2 == 1 && i == n/2 && j == n/2)
+      {
+        pointParameterSpace = Vec2({0.0, 0.0});
+      }
+
+      bool pointFound = transformToWorldSpace(pointParameterSpace, node(i,j));
+
+      // if the grid point lies between the unit circle and the polygon of the loop points, move it inwards
+      for (int tryNo = 0; !pointFound && tryNo < 5; tryNo++)
+      {
+        double phi = atan2(pointParameterSpace[1], pointParameterSpace[0]);
+        double r = pointParameterSpace[0] / cos(phi);
+        const double signR = (r > 0) - (r < 0);
+
+        bool searchAgain = false;
+        if (fabs(r) <= 1e-10)
+        {
+          r = 1e-4*signR;
+          phi += 1e-4;
+        }
+        else if (fabs(r) >= 1.0-1e-10)
+        {
+          r = 0.99*signR;
+          phi += 1e-4;
+        }
+        else if (fabs(r) <= 1e-4)
+        {
+          r = 0.01;
+          phi = 0.0;
+        }
+        else
+        {
+          r = 0.99*r;
+          phi += 1e-4;
+          searchAgain = true;
+        }
+        pointParameterSpace = Vec2({r*cos(phi), r*sin(phi)});
+
+        if (searchAgain)
+          pointFound = transformToWorldSpace(pointParameterSpace, node(i,j));
+      }
+
+      if (!pointFound)
+      {
+        VLOG(1) << "z-level " << zIndex << ": could not find the triangle in the parameter space for grid point (" << i << "," << j << ")";
+        return false;
+      }
+    }
+  }
+
+  if (!improveMesh_)
+    return true;
+
+  // Laplacian smoothing like in fix_and_smooth_mesh.py, a point is only moved if the adjacent elements stay valid
+  auto ccw = [](const Vec3 &p0, const Vec3 &p1, const Vec3 &p2) -> bool
+  {
+    return (p1[0]-p0[0])*(p2[1]-p0[1]) - (p2[0]-p0[0])*(p1[1]-p0[1]) > 0.0;
+  };
+
+  // if the element with the points p0,p1,p2,p3 (p0,p1 at the bottom, p2,p3 at the top) is oriented counter-clockwise and not self-intersecting
+  auto isProperlyOriented = [&ccw](const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) -> bool
+  {
+    int nCcw = (ccw(p0,p1,p3)? 1 : 0) + (ccw(p1,p3,p2)? 1 : 0) + (ccw(p3,p2,p0)? 1 : 0) + (ccw(p2,p0,p1)? 1 : 0);
+    return nCcw >= 3;
+  };
+
+  // if all angles of the element are at least 20 degrees
+  auto angleConstraintIsMet = [](const Vec3 &p0, const Vec3 &p1, const Vec3 &p2, const Vec3 &p3) -> bool
+  {
+    auto angle = [](const Vec3 &v1, const Vec3 &v2)
+    {
+      return atan2(MathUtility::norm<3>(MathUtility::cross(v1, v2)), MathUtility::dot(v1, v2));
+    };
+    const double angleConstraint = 20./180.*M_PI;
+    return angle(p1-p0, p2-p0) >= angleConstraint && angle(p3-p1, p0-p1) >= angleConstraint
+      && angle(p2-p3, p1-p3) >= angleConstraint && angle(p0-p2, p3-p2) >= angleConstraint;
+  };
+
+  auto allElementsAreValid = [&](bool checkAngles) -> bool
+  {
+    for (int j = 0; j < n-1; j++)
+    {
+      for (int i = 0; i < n-1; i++)
+      {
+        if (!isProperlyOriented(node(i,j), node(i+1,j), node(i,j+1), node(i+1,j+1)))
+          return false;
+        if (checkAngles && !angleConstraintIsMet(node(i,j), node(i+1,j), node(i,j+1), node(i+1,j+1)))
+          return false;
+      }
+    }
+    return true;
+  };
+
+  // self-intersecting elements would be resolved by the python script before the smoothing
+  if (!allElementsAreValid(false))
+  {
+    VLOG(1) << "z-level " << zIndex << ": the mesh contains self-intersecting elements";
+    return false;
+  }
+
+  // sweep over the interior points in alternating directions
+  const std::array<int,4> iStart = {1, n-2, n-2, 1};
+  const std::array<int,4> jStart = {1, n-2, 1, n-2};
+  const std::array<int,4> iEnd = {n-1, 0, 0, n-1};
+  const std::array<int,4> jEnd = {n-1, 0, n-1, 0};
+  const std::array<int,4> iIncrement = {1, -1, -1, 1};
+  const std::array<int,4> jIncrement = {1, -1, 1, -1};
+
+  for (int sweepNo = 0; sweepNo < 5; sweepNo++)
+  {
+    const int direction = sweepNo % 4;
+    for (int j = jStart[direction]; j != jEnd[direction]; j += jIncrement[direction])
+    {
+      for (int i = iStart[direction]; i != iEnd[direction]; i += iIncrement[direction])
+      {
+        // p6 p5 p4
+        // p7 p  p3
+        // p0 p1 p2
+        const Vec3 p  = node(i,j);
+        const Vec3 p0 = node(i-1,j-1);
+        const Vec3 p1 = node(i,  j-1);
+        const Vec3 p2 = node(i+1,j-1);
+        const Vec3 p3 = node(i+1,j);
+        const Vec3 p4 = node(i+1,j+1);
+        const Vec3 p5 = node(i,  j+1);
+        const Vec3 p6 = node(i-1,j+1);
+        const Vec3 p7 = node(i-1,j);
+
+        const Vec3 pChanged = 2./12*(p1+p3+p5+p7) + 1./12*(p0+p2+p4+p6);
+
+        if (!isProperlyOriented(p0,p1,p7,pChanged) || !isProperlyOriented(p1,p2,pChanged,p3)
+          || !isProperlyOriented(p7,pChanged,p6,p5) || !isProperlyOriented(pChanged,p3,p5,p4))
+          continue;
+
+        if ((angleConstraintIsMet(p0,p1,p7,p) && !angleConstraintIsMet(p0,p1,p7,pChanged))
+          || (angleConstraintIsMet(p1,p2,p,p3) && !angleConstraintIsMet(p1,p2,pChanged,p3))
+          || (angleConstraintIsMet(p7,p,p6,p5) && !angleConstraintIsMet(p7,pChanged,p6,p5))
+          || (angleConstraintIsMet(p,p3,p5,p4) && !angleConstraintIsMet(pChanged,p3,p5,p4)))
+          continue;
+
+        node(i,j) = pChanged;
+      }
+    }
+  }
+
+  // elements with small angles would be improved further by the python script
+  if (!allElementsAreValid(true))
+  {
+    VLOG(1) << "z-level " << zIndex << ": the smoothed mesh contains elements with small angles";
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
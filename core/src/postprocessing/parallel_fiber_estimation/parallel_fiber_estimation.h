@@ -69,9 +69,16 @@ protected:
   //! refine the given boundary points (boundaryPointsOld) in x and y direction
   void refineBoundaryPoints(std::array<std::vector<std::vector<Vec3>>,4> &boundaryPointsOld, std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints);
 
-  //! create the mesh with given boundaryPoints, using harmonic maps by calling the python script
+  //! create the mesh with given boundaryPoints, using harmonic maps, either natively (createMeshNative) or by calling the python script
   void createMesh(std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal);
 
+  //! create the mesh with given boundaryPoints with the same algorithm as the python script, returns false if the boundary points do not fit or the mesh of a z-level could not be created
+  bool createMeshNative(const std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal);
+
+  //! create the 2D grid of the z-level zIndex from the boundary points by the inverse of a harmonic map to the unit disk, nodePositions points to the first of the nBoundaryPointsXNew_^2 grid points of the level,
+  //! returns false if a grid point could not be mapped or if improveMesh_ is set and the mesh would need more than Laplacian smoothing
+  bool createPlanarMeshNative(const std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, int zIndex, Vec3 *nodePositions);
+
   //! check if the algorithm is at the stage where no more subdomains are created and the final fibers are traced, this sets the current level_
   bool checkTraceFinalFibers();
 
@@ -206,6 +213,7 @@ protected:
   int nFineGridFibers_;             //< the number of additional fibers between "key" fibers in one coordinate direction
   int nNodesPerFiber_;              //< the number of nodes of the final fiber, this is assured at the end, then the fibers get resampled to the required number of nodes per fiber
   bool improveMesh_;                //< if the improveMesh_ flag should be set to the algorithm that creates the 3D mesh. This make the mesh smoother but it takes more time
+  bool useNativeMeshGeneration_;    //< if the 3D mesh of a subdomain should be created by createMeshNative instead of the python script, the python script is still used where createMeshNative fails
   int level_;                       //< current level of the recursion, 0=1 process, 1=8 processes, 2=64 processes
   bool useNeumannBoundaryConditions_;     //< if neumann instead of dirichlet boundary conditions should be used
   int laplacianSmoothingNIterations_;     //< number of iterations of Laplacian smoothing that is applied prior to tracing the fine grid fibers
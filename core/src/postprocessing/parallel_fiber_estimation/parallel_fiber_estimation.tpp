@@ -25,6 +25,7 @@
 // include files that implement various methods of this class, these make use the previous defines
 #include "postprocessing/parallel_fiber_estimation/01_refine_boundary_points.tpp"
 #include "postprocessing/parallel_fiber_estimation/02_create_mesh.tpp"
+#include "postprocessing/parallel_fiber_estimation/02_create_mesh_native.tpp"
 #include "postprocessing/parallel_fiber_estimation/03_create_dirichlet_boundary_conditions.tpp"
 #include "postprocessing/parallel_fiber_estimation/03_create_neumann_boundary_conditions.tpp"
 #include "postprocessing/parallel_fiber_estimation/04_exchange_ghost_values.tpp"
@@ -64,6 +65,7 @@ ParallelFiberEstimation(DihuContext context) :
   maxLevel_ = specificSettings_.getOptionInt("maxLevel", 2);
   nFineGridFibers_ = specificSettings_.getOptionInt("nFineGridFibers", 2);
   improveMesh_ = specificSettings_.getOptionBool("improveMesh", true);
+  useNativeMeshGeneration_ = specificSettings_.getOptionBool("useNativeMeshGeneration", true);
   useNeumannBoundaryConditions_ = specificSettings_.getOptionBool("useNeumannBoundaryConditions", false);
   nNodesPerFiber_ = specificSettings_.getOptionInt("nNodesPerFiber", 1000);
   finalBottomZClip_ = specificSettings_.getOptionDouble("finalBottomZClip", bottomZClip_);
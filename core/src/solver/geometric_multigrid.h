@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <petscksp.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "control/types.h"
+#include "solver/linear.h"
+#include "mesh/type_traits.h"
+#include "basis_function/lagrange.h"
+#include "function_space/function_space.h"
+
+namespace Solver
+{
+
+/**
+ * Geometric multigrid preconditioner (PETSc PCMG) for finite element problems on structured meshes.
+ * The grid hierarchy is created by coarsening the structured mesh partition by a factor of 2 in every coordinate direction,
+ * as long as the number of elements on every partition stays even. The interpolation matrices between the levels are the
+ * (bi-/tri-)linear prolongations of the nested meshes, the coarse operators are computed by PETSc as Galerkin products P^T A P.
+ * Coarsening does not change the rank of any node, therefore no data has to be redistributed between the levels.
+ *
+ * This generic class is used for all other function spaces, where no mesh hierarchy is known. It only outputs a warning.
+ */
+template<typename FunctionSpaceType, typename DummyForTraits = typename FunctionSpaceType::Mesh>
+class GeometricMultigrid
+{
+public:
+  //! set the multigrid levels and interpolation matrices to the preconditioner of the linear solver, the system matrix has to be set already
+  static void setup(std::shared_ptr<Linear> linearSolver, std::shared_ptr<FunctionSpaceType> functionSpace, int nComponents);
+};
+
+/**
+ * Partial specialization for structured meshes with linear Lagrange basis functions, where the geometric multigrid hierarchy can be constructed.
+ */
+template<typename MeshType>
+class GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>
+{
+public:
+  typedef FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  typedef Partition::MeshPartition<FunctionSpaceType> MeshPartitionType;
+
+  //! set the multigrid levels and interpolation matrices to the preconditioner of the linear solver, the system matrix has to be set already,
+  //! the hierarchy is only created again if the system matrix is a different matrix object than at the previous call
+  static void setup(std::shared_ptr<Linear> linearSolver, std::shared_ptr<FunctionSpaceType> functionSpace, int nComponents);
+
+protected:
+
+  //! the system matrix for which the multigrid hierarchy of a preconditioner was created
+  struct FineOperator
+  {
+    PetscObjectId systemMatrixId;               //< the unique id of the system matrix object, which changes when the matrix is created again, e.g. after a reset
+    PetscObjectId preconditionerMatrixId;       //< the unique id of the AIJ matrix that was converted from the nested system matrix, -1 if there is none
+    PetscObjectState systemMatrixState;         //< the state of the system matrix at the conversion, which changes when its values change
+  };
+
+  //! if the preconditioner matrix is a nested matrix or it is outdated, set the system matrix converted to AIJ as preconditioner matrix
+  static void convertNestedPreconditionerMatrix(KSP ksp, FineOperator &fineOperator);
+
+  //! create the mesh partitions of all coarser levels, the result contains the fine mesh partition at index 0, coarser levels follow
+  static void createCoarseMeshPartitions(std::shared_ptr<MeshPartitionType> fineMeshPartition, int nLevels,
+                                         std::vector<std::shared_ptr<MeshPartitionType>> &meshPartitions);
+
+  //! create the interpolation matrix from the coarse to the fine level, for nComponents > 1 the rows and columns are ordered as in a MatNest
+  static void createInterpolationMatrix(std::shared_ptr<MeshPartitionType> fineMeshPartition, std::shared_ptr<MeshPartitionType> coarseMeshPartition,
+                                        int nComponents, Mat &interpolationMatrix);
+
+  static std::map<PC,FineOperator> fineOperators_;   //< for every preconditioner that was set up, the system matrix that the hierarchy belongs to
+};
+
+}  // namespace
+
+#include "solver/geometric_multigrid.tpp"
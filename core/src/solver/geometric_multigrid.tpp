@@ -0,0 +1,314 @@
+#include "solver/geometric_multigrid.h"
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+#include "utility/vector_operators.h"
+
+namespace Solver
+{
+
+template<typename FunctionSpaceType, typename DummyForTraits>
+void GeometricMultigrid<FunctionSpaceType,DummyForTraits>::
+setup(std::shared_ptr<Linear> linearSolver, std::shared_ptr<FunctionSpaceType> functionSpace, int nComponents)
+{
+  LOG(WARNING) << "Linear solver \"" << linearSolver->name() << "\": The geometric multigrid preconditioner \"gmg\" is only available "
+    << "for structured meshes with linear Lagrange basis functions. Using \"gamg\" instead.";
+
+  PetscErrorCode ierr;
+  PC pc;
+  ierr = KSPGetPC(*linearSolver->ksp(), &pc); CHKERRV(ierr);
+  ierr = PCSetType(pc, PCGAMG); CHKERRV(ierr);
+}
+
+template<typename MeshType>
+std::map<PC,typename GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>::FineOperator>
+GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>::fineOperators_;
+
+template<typename MeshType>
+void GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>::
+setup(std::shared_ptr<Linear> linearSolver, std::shared_ptr<FunctionSpaceType> functionSpace, int nComponents)
+{
+  KSP ksp = *linearSolver->ksp();
+
+  PetscErrorCode ierr;
+  PC pc;
+  ierr = KSPGetPC(ksp, &pc); CHKERRV(ierr);
+
+  Mat systemMatrix;
+  ierr = KSPGetOperators(ksp, &systemMatrix, NULL); CHKERRV(ierr);
+
+  PetscObjectId systemMatrixId;
+  ierr = PetscObjectGetId((PetscObject)systemMatrix, &systemMatrixId); CHKERRV(ierr);
+
+  // if the multigrid hierarchy has already been set up by a previous call for the same system matrix, it can be reused,
+  // the Galerkin products of the coarse levels are computed again by PETSc if the values of the matrix have changed
+  PetscInt nLevelsPrevious = 0;
+  ierr = PCMGGetLevels(pc, &nLevelsPrevious); CHKERRV(ierr);
+  if (nLevelsPrevious > 1)
+  {
+    typename std::map<PC,FineOperator>::iterator iter = fineOperators_.find(pc);
+    if (iter != fineOperators_.end() && iter->second.systemMatrixId == systemMatrixId)
+    {
+      // KSPSetOperators may have set the nested matrix again as preconditioner matrix
+      if (nComponents > 1)
+        convertNestedPreconditionerMatrix(ksp, iter->second);
+      return;
+    }
+
+    // the system matrix was created again, e.g. after a reset, possibly on a different mesh,
+    // discard the old hierarchy, such that PCMG is set up from scratch with the new interpolation matrices
+    LOG(DEBUG) << "system matrix of linear solver \"" << linearSolver->name() << "\" has changed, set up geometric multigrid again";
+    ierr = PCSetType(pc, PCNONE); CHKERRV(ierr);
+  }
+
+  // create the mesh partitions of the coarse levels, meshPartitions[0] is the finest level
+  std::vector<std::shared_ptr<MeshPartitionType>> meshPartitions;
+  createCoarseMeshPartitions(functionSpace->meshPartition(), linearSolver->nMultigridLevels(), meshPartitions);
+
+  const int nLevels = meshPartitions.size();
+  if (nLevels == 1)
+  {
+    LOG(WARNING) << "Linear solver \"" << linearSolver->name() << "\": The mesh with " << functionSpace->meshPartition()->nElementsGlobal()
+      << " elements cannot be coarsened, because the numbers of elements on the partitions are not all even. "
+      << "The geometric multigrid preconditioner \"gmg\" needs a coarsenable mesh, using \"gamg\" instead.";
+    ierr = PCSetType(pc, PCGAMG); CHKERRV(ierr);
+    return;
+  }
+
+  // store the system matrix that the hierarchy belongs to
+  FineOperator &fineOperator = fineOperators_[pc];
+  fineOperator.systemMatrixId = systemMatrixId;
+  fineOperator.preconditionerMatrixId = -1;
+  fineOperator.systemMatrixState = -1;
+
+  // for multiple components the matrices are nested matrices, the Galerkin products need an AIJ preconditioner matrix
+  if (nComponents > 1)
+    convertNestedPreconditionerMatrix(ksp, fineOperator);
+
+  LOG(DEBUG) << "setup geometric multigrid with " << nLevels << " levels, finest level has "
+    << functionSpace->meshPartition()->nElementsGlobal() << " elements, coarsest level has " << meshPartitions.back()->nElementsGlobal() << " elements";
+
+  // set the levels, PCMG numbers the levels from 0 (coarsest) to nLevels-1 (finest)
+  ierr = PCSetType(pc, PCMG); CHKERRV(ierr);
+  ierr = PCMGSetLevels(pc, nLevels, NULL); CHKERRV(ierr);
+  ierr = PCMGSetType(pc, PC_MG_MULTIPLICATIVE); CHKERRV(ierr);
+  ierr = PCMGSetCycleType(pc, linearSolver->multigridCycleType()); CHKERRV(ierr);
+
+  // compute the coarse operators as Galerkin products P^T A P, this also handles the rows and columns of Dirichlet boundary conditions
+  ierr = PCMGSetGalerkin(pc, PC_MG_GALERKIN_BOTH); CHKERRV(ierr);
+
+  // set the interpolation matrices from level-1 to level
+  for (int level = 1; level < nLevels; level++)
+  {
+    std::shared_ptr<MeshPartitionType> fineMeshPartition = meshPartitions[nLevels-1 - level];
+    std::shared_ptr<MeshPartitionType> coarseMeshPartition = meshPartitions[nLevels - level];
+
+    Mat interpolationMatrix;
+    createInterpolationMatrix(fineMeshPartition, coarseMeshPartition, nComponents, interpolationMatrix);
+
+    ierr = PCMGSetInterpolation(pc, level, interpolationMatrix); CHKERRV(ierr);
+
+    // the preconditioner holds a reference to the matrix
+    ierr = MatDestroy(&interpolationMatrix); CHKERRV(ierr);
+  }
+
+  // set options from command line, e.g. for the smoothers (-mg_levels_ksp_type), this overrides the python config
+  ierr = PCSetFromOptions(pc); CHKERRV(ierr);
+}
+
+template<typename MeshType>
+void GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>::
+convertNestedPreconditionerMatrix(KSP ksp, FineOperator &fineOperator)
+{
+  PetscErrorCode ierr;
+  Mat systemMatrix;
+  Mat preconditionerMatrix;
+  ierr = KSPGetOperators(ksp, &systemMatrix, &preconditionerMatrix); CHKERRV(ierr);
+
+  PetscBool isNested;
+  ierr = PetscObjectTypeCompare((PetscObject)preconditionerMatrix, MATNEST, &isNested); CHKERRV(ierr);
+
+  // the previously converted matrix is outdated if the values of the system matrix have changed since the conversion
+  PetscObjectId preconditionerMatrixId;
+  PetscObjectState systemMatrixState;
+  ierr = PetscObjectGetId((PetscObject)preconditionerMatrix, &preconditionerMatrixId); CHKERRV(ierr);
+  ierr = PetscObjectStateGet((PetscObject)systemMatrix, &systemMatrixState); CHKERRV(ierr);
+
+  Mat nestedMatrix = preconditionerMatrix;
+  if (!isNested)
+  {
+    if (preconditionerMatrixId != fineOperator.preconditionerMatrixId || systemMatrixState == fineOperator.systemMatrixState)
+      return;
+
+    // convert the system matrix again, the converted matrix was created from it
+    nestedMatrix = systemMatrix;
+  }
+
+  Mat preconditionerMatrixAij;
+  ierr = MatConvert(nestedMatrix, MATAIJ, MAT_INITIAL_MATRIX, &preconditionerMatrixAij); CHKERRV(ierr);
+  ierr = KSPSetOperators(ksp, systemMatrix, preconditionerMatrixAij); CHKERRV(ierr);
+
+  ierr = PetscObjectGetId((PetscObject)preconditionerMatrixAij, &fineOperator.preconditionerMatrixId); CHKERRV(ierr);
+  fineOperator.systemMatrixState = systemMatrixState;
+
+  // the ksp object holds a reference to the converted matrix
+  ierr = MatDestroy(&preconditionerMatrixAij); CHKERRV(ierr);
+}
+
+template<typename MeshType>
+void GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>::
+createCoarseMeshPartitions(std::shared_ptr<MeshPartitionType> fineMeshPartition, int nLevels,
+                           std::vector<std::shared_ptr<MeshPartitionType>> &meshPartitions)
+{
+  const int D = MeshType::dim();
+
+  meshPartitions.clear();
+  meshPartitions.push_back(fineMeshPartition);
+
+  while ((int)meshPartitions.size() < nLevels)
+  {
+    std::shared_ptr<MeshPartitionType> meshPartition = meshPartitions.back();
+
+    // check if the number of elements of every partition is even in every coordinate direction,
+    // then the nodes of the coarse mesh are a subset of the nodes of the fine mesh that stays on the same ranks.
+    // The sizes of all partitions are known on every rank, therefore all ranks take the same decision.
+    bool canBeCoarsened = true;
+    for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+    {
+      for (element_no_t localSize : meshPartition->localSizesOnRanks(coordinateDirection))
+      {
+        if (localSize < 2 || localSize % 2 != 0)
+        {
+          canBeCoarsened = false;
+          break;
+        }
+      }
+    }
+
+    if (!canBeCoarsened)
+      break;
+
+    // create the mesh partition of the coarse mesh
+    std::array<element_no_t,D> nElementsLocal;
+    std::array<global_no_t,D> nElementsGlobal;
+    std::array<global_no_t,D> beginElementGlobal;
+    std::array<int,D> nRanks;
+
+    for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+    {
+      nElementsLocal[coordinateDirection] = meshPartition->nElementsLocal(coordinateDirection) / 2;
+      nElementsGlobal[coordinateDirection] = meshPartition->nElementsGlobal(coordinateDirection) / 2;
+      beginElementGlobal[coordinateDirection] = meshPartition->beginElementGlobal(coordinateDirection) / 2;
+      nRanks[coordinateDirection] = meshPartition->nRanks(coordinateDirection);
+    }
+
+    VLOG(1) << "create coarse mesh partition for multigrid level " << meshPartitions.size() << ", nElementsLocal: " << nElementsLocal
+      << ", nElementsGlobal: " << nElementsGlobal;
+
+    meshPartitions.push_back(std::make_shared<MeshPartitionType>(nElementsLocal, nElementsGlobal, beginElementGlobal, nRanks, meshPartition->rankSubset()));
+  }
+}
+
+template<typename MeshType>
+void GeometricMultigrid<FunctionSpace::FunctionSpace<MeshType,BasisFunction::LagrangeOfOrder<1>>,Mesh::isStructured<MeshType>>::
+createInterpolationMatrix(std::shared_ptr<MeshPartitionType> fineMeshPartition, std::shared_ptr<MeshPartitionType> coarseMeshPartition,
+                          int nComponents, Mat &interpolationMatrix)
+{
+  const int D = MeshType::dim();
+  const int nEntriesPerRow = 1 << D;     // maximum number of coarse nodes that contribute to a fine node
+  MPI_Comm mpiCommunicator = fineMeshPartition->mpiCommunicator();
+
+  const node_no_t nNodesLocalFine = fineMeshPartition->nNodesLocalWithoutGhosts();
+  const node_no_t nNodesLocalCoarse = coarseMeshPartition->nNodesLocalWithoutGhosts();
+
+  // gather the begin and size of the coarse partitions on all ranks, needed to compute the column numbers in the nested numbering of multiple components
+  const int nRanks = coarseMeshPartition->nRanks();
+  PetscInt beginNodeGlobalCoarse = coarseMeshPartition->beginNodeGlobalPetsc();
+  PetscInt nNodesLocalCoarseValue = nNodesLocalCoarse;
+  std::vector<PetscInt> beginNodeGlobalCoarseOnRanks(nRanks);
+  std::vector<PetscInt> nNodesLocalCoarseOnRanks(nRanks);
+
+  MPIUtility::handleReturnValue(MPI_Allgather(&beginNodeGlobalCoarse, 1, MPIU_INT, beginNodeGlobalCoarseOnRanks.data(), 1, MPIU_INT, mpiCommunicator), "MPI_Allgather");
+  MPIUtility::handleReturnValue(MPI_Allgather(&nNodesLocalCoarseValue, 1, MPIU_INT, nNodesLocalCoarseOnRanks.data(), 1, MPIU_INT, mpiCommunicator), "MPI_Allgather");
+
+  // create the matrix, the rows are the fine dofs, the columns are the coarse dofs
+  PetscErrorCode ierr;
+  ierr = MatCreateAIJ(mpiCommunicator, nComponents*nNodesLocalFine, nComponents*nNodesLocalCoarse, PETSC_DETERMINE, PETSC_DETERMINE,
+                      nEntriesPerRow, NULL, nEntriesPerRow, NULL, &interpolationMatrix); CHKERRV(ierr);
+
+  const PetscInt beginRowGlobal = nComponents*fineMeshPartition->beginNodeGlobalPetsc();
+
+  std::array<PetscInt,8> columns;
+  std::array<double,8> values;
+
+  // loop over the non-ghost nodes of the fine mesh
+  for (node_no_t nodeNoLocal = 0; nodeNoLocal < nNodesLocalFine; nodeNoLocal++)
+  {
+    std::array<global_no_t,D> coordinatesGlobal = fineMeshPartition->getCoordinatesGlobal(nodeNoLocal);
+
+    // determine the coarse node coordinates and weights in every coordinate direction,
+    // even fine nodes coincide with coarse nodes, odd fine nodes lie in the middle of two coarse nodes
+    std::array<std::array<global_no_t,2>,D> coarseCoordinates;
+    std::array<std::array<double,2>,D> coarseWeights;
+    std::array<int,D> nCoarseNodes;
+
+    for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+    {
+      global_no_t coordinate = coordinatesGlobal[coordinateDirection];
+      if (coordinate % 2 == 0)
+      {
+        nCoarseNodes[coordinateDirection] = 1;
+        coarseCoordinates[coordinateDirection][0] = coordinate / 2;
+        coarseWeights[coordinateDirection][0] = 1.0;
+      }
+      else
+      {
+        nCoarseNodes[coordinateDirection] = 2;
+        coarseCoordinates[coordinateDirection][0] = (coordinate - 1) / 2;
+        coarseCoordinates[coordinateDirection][1] = (coordinate + 1) / 2;
+        coarseWeights[coordinateDirection][0] = 0.5;
+        coarseWeights[coordinateDirection][1] = 0.5;
+      }
+    }
+
+    // loop over the tensor product of the contributing coarse nodes
+    int nColumns = 1;
+    for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+      nColumns *= nCoarseNodes[coordinateDirection];
+
+    for (int componentNo = 0; componentNo < nComponents; componentNo++)
+    {
+      for (int columnIndex = 0; columnIndex < nColumns; columnIndex++)
+      {
+        std::array<global_no_t,D> coordinatesGlobalCoarse;
+        double weight = 1.0;
+
+        int index = columnIndex;
+        for (int coordinateDirection = 0; coordinateDirection < D; coordinateDirection++)
+        {
+          int indexInDirection = index % nCoarseNodes[coordinateDirection];
+          index /= nCoarseNodes[coordinateDirection];
+
+          coordinatesGlobalCoarse[coordinateDirection] = coarseCoordinates[coordinateDirection][indexInDirection];
+          weight *= coarseWeights[coordinateDirection][indexInDirection];
+        }
+
+        // get the number of the coarse node in the nested numbering, where on every rank all local dofs of component 0 come first, then component 1, etc.
+        global_no_t nodeNoGlobalPetscCoarse = coarseMeshPartition->getNodeNoGlobalPetsc(coordinatesGlobalCoarse);
+        int rankNo = coarseMeshPartition->getRankOfNodeNoGlobalNatural(coarseMeshPartition->getNodeNoGlobalNatural(coordinatesGlobalCoarse));
+
+        columns[columnIndex] = nComponents*beginNodeGlobalCoarseOnRanks[rankNo] + componentNo*nNodesLocalCoarseOnRanks[rankNo]
+          + (nodeNoGlobalPetscCoarse - beginNodeGlobalCoarseOnRanks[rankNo]);
+        values[columnIndex] = weight;
+      }
+
+      PetscInt row = beginRowGlobal + componentNo*nNodesLocalFine + nodeNoLocal;
+      ierr = MatSetValues(interpolationMatrix, 1, &row, nColumns, columns.data(), values.data(), INSERT_VALUES); CHKERRV(ierr);
+    }
+  }
+
+  ierr = MatAssemblyBegin(interpolationMatrix, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+  ierr = MatAssemblyEnd(interpolationMatrix, MAT_FINAL_ASSEMBLY); CHKERRV(ierr);
+}
+
+}  // namespace
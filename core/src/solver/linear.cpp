@@ -20,6 +20,8 @@ Linear::Linear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, std::str
   }
 
   mpiCommunicator_ = mpiCommunicator;
+  nMultigridLevels_ = 25;
+  multigridCycleType_ = PC_MG_CYCLE_V;
 
   parseOptions();
 }
@@ -99,10 +101,25 @@ void Linear::setupKsp(KSP ksp)
   ierr = PCSetType(pc, pcType_); CHKERRV(ierr);
 
   // for multigrid set number of levels and cycle type
+  if (pcType_ == std::string(PCGAMG) || pcType_ == std::string(PCMG))
+  {
+    nMultigridLevels_ = this->specificSettings_.getOptionInt("nLevels", 25, PythonUtility::Positive);
+
+    std::string mgType = this->specificSettings_.getOptionString("cycleType", "cycleV");
+
+    multigridCycleType_ = PC_MG_CYCLE_V;
+
+    if (mgType == "cycleW")
+    {
+      multigridCycleType_ = PC_MG_CYCLE_W;
+    }
+  }
+
+  // for algebraic multigrid set number of levels and cycle type,
+  // for geometric multigrid this is done in GeometricMultigrid::setup when the mesh hierarchy is known
   if (pcType_ == std::string(PCGAMG))
   {
-    int nLevels = this->specificSettings_.getOptionInt("nLevels", 25, PythonUtility::Positive);
-    ierr = PCMGSetLevels(pc, nLevels, NULL); CHKERRV(ierr);
+    ierr = PCMGSetLevels(pc, nMultigridLevels_, NULL); CHKERRV(ierr);
     
     std::string mgType = this->specificSettings_.getOptionString("gamgType", "agg");
     
@@ -119,16 +136,7 @@ void Linear::setupKsp(KSP ksp)
     
     ierr = PCGAMGSetType(pc,gamgType); CHKERRV(ierr);
     
-    mgType = this->specificSettings_.getOptionString("cycleType", "cycleV");
-    
-    PCMGCycleType cycleType = PC_MG_CYCLE_V;
-    
-    if (mgType == "cycleW")
-    {
-      cycleType = PC_MG_CYCLE_W;
-    }
-    
-    ierr = PCMGSetCycleType(pc, cycleType); CHKERRV(ierr);    
+    ierr = PCMGSetCycleType(pc, multigridCycleType_); CHKERRV(ierr);
   }
   // set Hypre Options from Python config
   else if (pcType_ == std::string(PCHYPRE))
@@ -187,6 +195,11 @@ void Linear::parseSolverTypes(std::string solverType, std::string preconditioner
   {
     pcType = PCMG;
   }
+  // geometric multigrid on structured meshes, the levels are set up by GeometricMultigrid
+  else if (preconditionerType == "gmg")
+  {
+    pcType = PCMG;
+  }
   else if (preconditionerType == "bjacobi")
   {
     pcType = PCBJACOBI;
@@ -372,4 +385,19 @@ int Linear::lastNumberOfIterations()
   return lastNumberOfIterations_;
 }
 
+bool Linear::isGeometricMultigrid() const
+{
+  return preconditionerType_ == "gmg";
+}
+
+int Linear::nMultigridLevels() const
+{
+  return nMultigridLevels_;
+}
+
+PCMGCycleType Linear::multigridCycleType() const
+{
+  return multigridCycleType_;
+}
+
 }   //namespace
@@ -34,6 +34,15 @@ public:
   //! return the number of iterations of the last solve
   int lastNumberOfIterations();
 
+  //! if the geometric multigrid preconditioner ("gmg") is selected, then the mesh hierarchy has to be set by Solver::GeometricMultigrid
+  bool isGeometricMultigrid() const;
+
+  //! return the maximum number of multigrid levels, as given in the settings
+  int nMultigridLevels() const;
+
+  //! return the cycle type for multigrid preconditioners
+  PCMGCycleType multigridCycleType() const;
+
   //! dump files containing rhs, solution and system matrix
   void dumpMatrixRightHandSideSolution(Vec rightHandSide, Vec solution);
 
@@ -57,6 +66,8 @@ protected:
   double absoluteTolerance_;   //< absolute solver tolerance of the residuum norm
   long int maxIterations_;     //< maximum number of iterations
   int lastNumberOfIterations_; //< the number of iterations of the previous solve
+  int nMultigridLevels_;       //< maximum number of levels for multigrid preconditioners
+  PCMGCycleType multigridCycleType_;  //< V or W cycle for multigrid preconditioners
 
   std::string dumpFormat_;     //< format to use for dumping matrices and vectors
   std::string dumpFilename_;   //< filename used for dumping matrices and vectors, empty for no dump
@@ -16,6 +16,7 @@
 #include "mesh/mesh_manager/mesh_manager.h"
 #include "solver/solver_manager.h"
 #include "solver/linear.h"
+#include "solver/geometric_multigrid.h"
 #include "partition/partitioned_petsc_vec/partitioned_petsc_vec.h"
 #include "partition/partitioned_petsc_mat/partitioned_petsc_mat.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
@@ -257,6 +258,12 @@ setInformationToPreconditioner()
     LOG(DEBUG) << "set coordinates to preconditioner, " << nodePositionCoordinatesForPreconditioner.size() << " node coordinates";
     ierr = PCSetCoordinates(pc, 3, nNodesLocal, nodePositionCoordinatesForPreconditioner.data()); CHKERRV(ierr);
   }
+
+  // set up the mesh hierarchy for the geometric multigrid preconditioner
+  if (linearSolver->isGeometricMultigrid())
+  {
+    Solver::GeometricMultigrid<FunctionSpaceType>::setup(linearSolver, data_.functionSpace(), nComponents);
+  }
 }
 
 template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
@@ -6,6 +6,7 @@
 #include <petscsys.h>
 
 #include "quadrature/tensor_product.h"
+#include "function_space/basis_on_quadrature.h"
 #include "spatial_discretization/finite_element_method/integrand/integrand_mass_matrix.h"
 
 namespace SpatialDiscretization
@@ -55,6 +56,10 @@ setMassMatrix()
 
   element_no_t nElementsLocal = functionSpace->nElementsLocal();
 
+  // element block of the matrix of a single component, row major
+  typedef std::array<double_v_t,nDofsPerElement*nDofsPerElement> ElementBlockType;
+  const ElementBlockType zeroElementBlock{};
+
   // initialize values to zero
   // loop over elements, always 4 elements at once using the vectorized functions
   for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
@@ -79,21 +84,10 @@ setMassMatrix()
 
     std::array<dof_no_v_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocalv);
 
-    for (int i = 0; i < nDofsPerElement; i++)
+    // loop over components (1,...,D for solid mechanics), set the whole element block of each component at once
+    for (int componentNo = 0; componentNo < nComponents*nComponents; componentNo++)
     {
-      for (int j = 0; j < nDofsPerElement; j++)
-      {
-        // loop over components (1,...,D for solid mechanics)
-        for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
-        {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
-          {
-            int componentNo = rowComponentNo*nComponents + columnComponentNo;
-
-            massMatrix->setValue(componentNo, dofNosLocal[i], dofNosLocal[j], 0, INSERT_VALUES);
-          }
-        }
-      }
+      massMatrix->setValuesElement(componentNo, dofNosLocal, zeroElementBlock, INSERT_VALUES);
     }
   }
   massMatrix->assembly(MAT_FLUSH_ASSEMBLY);
@@ -129,46 +123,41 @@ setMassMatrix()
     // compute integral
     for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
     {
-      // evaluate function to integrate at samplingPoints[i*2], write value to evaluations[i]
-      std::array<double,D> xi = samplingPoints[samplingPointIndex];
-
       // compute the 3xD jacobian of the parameter space to world space mapping
-      auto jacobian = FunctionSpaceType::computeJacobian(geometry, xi);
+      auto jacobian = FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::computeJacobian(geometry, samplingPointIndex);
+
+      // values of the basis functions at the sampling point
+      const std::array<double,nDofsPerElement> &phi = FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::phi()[samplingPointIndex];
 
       // get evaluations of integrand which is defined in another class
-      evaluationsArray[samplingPointIndex] = IntegrandMassMatrix<D,EvaluationsType,FunctionSpaceType,nComponents,double_v_t,dof_no_v_t,Term>::evaluateIntegrand(jacobian,xi);
+      evaluationsArray[samplingPointIndex] = IntegrandMassMatrix<D,EvaluationsType,FunctionSpaceType,nComponents,double_v_t,dof_no_v_t,Term>::evaluateIntegrand(jacobian,phi);
 
     }  // function evaluations
 
     // integrate all values for the (i,j) dof pairs at once
     EvaluationsType integratedValues = QuadratureDD::computeIntegral(evaluationsArray);
 
-    // perform integration and add to entry in rhs vector
-    for (int i = 0; i < nDofsPerElement; i++)
+    // perform integration and add the element blocks to the mass matrix
+    for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
     {
-      for (int j = 0; j < nDofsPerElement; j++)
+      for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
       {
-        for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
+        int componentNo = rowComponentNo*nComponents + columnComponentNo;
+
+        // collect the element block of the current component for all elements of the vectorized values
+        ElementBlockType elementBlock;
+        for (int i = 0; i < nDofsPerElement; i++)
         {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
+          for (int j = 0; j < nDofsPerElement; j++)
           {
-            // integrate value and set entry in discretization matrix
-            double_v_t integratedValue = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
-            int componentNo = rowComponentNo*nComponents + columnComponentNo;
-
-            // get local dof no
-            dof_no_v_t dofINoLocal = dofNosLocal[i];
-            dof_no_v_t dofJNoLocal = dofNosLocal[j];
-
-            // add the entry in the stiffness matrix, for all dofs of the vectorized values at once,
-            // i.e. K_dofINoLocal[0],dofJNoLocal[0] = value[0]
-            // i.e. K_dofINoLocal[1],dofJNoLocal[1] = value[1], etc.
-            // Note that K_dofINoLocal[0],dofJNoLocal[1] would be potentially zero, the contributions are considered element-wise
-            massMatrix->setValue(componentNo, dofINoLocal, dofJNoLocal, integratedValue, ADD_VALUES);
-          }
-        }
-      }  // j
-    }  // i
+            elementBlock[i*nDofsPerElement + j] = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
+          }  // j
+        }  // i
+
+        // add the element block to the mass matrix, one MatSetValues call per element of the vectorized values
+        massMatrix->setValuesElement(componentNo, dofNosLocal, elementBlock, ADD_VALUES);
+      }
+    }
   }  // elementNoLocalv
 
   // merge local changes in parallel and assemble the matrix (MatAssemblyBegin, MatAssemblyEnd)
@@ -8,6 +8,7 @@
 
 #include "quadrature/tensor_product.h"
 #include "function_space/function_space.h"
+#include "function_space/basis_on_quadrature.h"
 #include "spatial_discretization/finite_element_method/integrand/integrand_stiffness_matrix_laplace.h"
 #include "spatial_discretization/finite_element_method/integrand/integrand_stiffness_matrix_linear_elasticity.h"
 #include "control/types.h"
@@ -63,6 +64,10 @@ setStiffnessMatrix()
   const element_no_t nElementsLocal = functionSpace->nElementsLocal();
   LOG(DEBUG) << " nElementsLocal: " << nElementsLocal;
 
+  // element block of the matrix of a single component, row major
+  typedef std::array<double_v_t,nDofsPerElement*nDofsPerElement> ElementBlockType;
+  const ElementBlockType zeroElementBlock{};
+
   // initialize values to zero
   // loop over elements, always 4 elements at once using the vectorized functions
   for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
@@ -87,22 +92,10 @@ setStiffnessMatrix()
 
     std::array<dof_no_v_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocalv);
 
-    for (int i = 0; i < nDofsPerElement; i++)
+    // loop over components (1,...,D for solid mechanics), set the whole element block of each component at once
+    for (int componentNo = 0; componentNo < nComponents*nComponents; componentNo++)
     {
-      for (int j = 0; j < nDofsPerElement; j++)
-      {
-        // loop over components (1,...,D for solid mechanics)
-        for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
-        {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
-          {
-            int componentNo = rowComponentNo*nComponents + columnComponentNo;
-
-            //LOG(DEBUG) << " initialize stiffnessMatrix entry ( " << dofNosLocal[i] << "," << dofNosLocal[j] << ") (no. " << cntr++ << ")";
-            stiffnessMatrix->setValue(componentNo, dofNosLocal[i], dofNosLocal[j], 0, INSERT_VALUES);
-          }
-        }
-      }
+      stiffnessMatrix->setValuesElement(componentNo, dofNosLocal, zeroElementBlock, INSERT_VALUES);
     }
   }
 
@@ -159,7 +152,7 @@ setStiffnessMatrix()
       std::array<double,D> xi = samplingPoints[samplingPointIndex];
 
       // compute the 3xD jacobian of the parameter space to world space mapping
-      std::array<Vec3_v_t,D> jacobian = FunctionSpaceType::computeJacobian(geometry, xi);
+      std::array<Vec3_v_t,D> jacobian = FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::computeJacobian(geometry, samplingPointIndex);
 
       VLOG(2) << "samplingPointIndex=" << samplingPointIndex<< ", xi=" <<xi<< ", geometry: " <<geometry<< ", jac: " <<jacobian;
 
@@ -176,38 +169,34 @@ setStiffnessMatrix()
     // integrate all values for the (i,j) dof pairs at once
     EvaluationsType integratedValues = QuadratureDD::computeIntegral(evaluationsArray);
 
-    // perform integration and add to entry of stiffness matrix
-    for (int i = 0; i < nDofsPerElement; i++)
+    // loop over components (1,...,D for solid mechanics)
+    for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
     {
-      for (int j = 0; j < nDofsPerElement; j++)
+      for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
       {
-        // loop over components (1,...,D for solid mechanics)
-        for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
+        int componentNo = rowComponentNo*nComponents + columnComponentNo;
+
+        // collect the element block of the current component for all elements of the vectorized values
+        ElementBlockType elementBlock;
+        for (int i = 0; i < nDofsPerElement; i++)
         {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
+          for (int j = 0; j < nDofsPerElement; j++)
           {
-            // integrate value and set entry in stiffness matrix
             double_v_t integratedValue = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
-            double_v_t value = -integratedValue;
-            int componentNo = rowComponentNo*nComponents + columnComponentNo;
+            elementBlock[i*nDofsPerElement + j] = -integratedValue;
 
             VLOG(2) << "  dof pair (" << i<< "," <<j<< ") dofs (" << dofNosLocal[i]<< "," << dofNosLocal[j]<< "), "
               << "component (" << rowComponentNo << "," << columnComponentNo << "), " << componentNo
               << ", integrated value: " <<integratedValue;
+          }  // j
+        }  // i
 
-            // get local dof no
-            dof_no_v_t dofINoLocal = dofNosLocal[i];
-            dof_no_v_t dofJNoLocal = dofNosLocal[j];
-
-            // add the entry in the stiffness matrix, for all dofs of the vectorized values at once,
-            // i.e. K_dofINoLocal[0],dofJNoLocal[0] = value[0]
-            // i.e. K_dofINoLocal[1],dofJNoLocal[1] = value[1], etc.
-            // Note that K_dofINoLocal[0],dofJNoLocal[1] would be potentially zero, the contributions are considered element-wise
-            stiffnessMatrix->setValue(componentNo, dofINoLocal, dofJNoLocal, value, ADD_VALUES);
-          }
-        }
-      }  // j
-    }  // i
+        // add the element block to the stiffness matrix, one MatSetValues call per element,
+        // i.e. K_dofNosLocal[i][0],dofNosLocal[j][0] += elementBlock[i*nDofsPerElement+j][0] for all i,j in the first call,
+        // K_dofNosLocal[i][1],dofNosLocal[j][1] += elementBlock[i*nDofsPerElement+j][1] in the second call, etc.
+        stiffnessMatrix->setValuesElement(componentNo, dofNosLocal, elementBlock, ADD_VALUES);
+      }
+    }
   }  // elementNoLocalv
 
   if (outputAssemble3DStiffnessMatrixHere && this->context_.ownRankNoCommWorld() == 0)
@@ -8,6 +8,7 @@
 #include <functional>
 
 #include "quadrature/tensor_product.h"
+#include "function_space/basis_on_quadrature.h"
 #include "function_space/function_space.h"
 #include "spatial_discretization/finite_element_method/integrand/integrand_mass_matrix.h"
 #include "field_variable/field_variable.h"
@@ -47,97 +48,120 @@ multiplyRightHandSideWithMassMatrix()
 
   std::shared_ptr<FunctionSpaceType> functionSpace = std::static_pointer_cast<FunctionSpaceType>(this->data_.functionSpace());
 
-  // merge local changes on the partitioned vector
+  // The ghost values of the rhs vector are communicated while the interior elements, which need no ghost values, are integrated.
+  // The contributions of all elements are accumulated in resultValues, because the vector must not be changed while the communication is in progress.
   rightHandSide->setRepresentationGlobal();
-  rightHandSide->startGhostManipulation();
-  
-  // get all entries
-  std::vector<VecD<nComponents>> rhsValues;
-  rightHandSide->getValuesWithGhosts(rhsValues);
-  VLOG(1) << "extracted rhsValues (with ghosts): " << rhsValues;
+  rightHandSide->startGhostManipulationBegin();
 
-  // initialize values to zero
-  rightHandSide->zeroEntries();
-
-  // also zero out the ghost buffer
-  rightHandSide->zeroGhostBuffer();
-
-  // set entries in rhs vector
+  // get the own entries, the ghost entries are not yet available
+  std::vector<VecD<nComponents>> rhsValues;
+  rightHandSide->getValuesWithoutGhosts(rhsValues);
+  rhsValues.resize(functionSpace->nDofsLocalWithGhosts(), VecD<nComponents>{});
 
-  element_no_t nElementsLocal = functionSpace->nElementsLocal();
+  // the new values of the rhs vector, including the contributions to ghost dofs
+  std::vector<VecD<nComponents>> resultValues(functionSpace->nDofsLocalWithGhosts(), VecD<nComponents>{});
 
-  // initialize values to zero
-  // loop over elements, always 4 elements at once using the vectorized functions
-  for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
+  // integrate the given elements and add the contributions to resultValues
+  auto integrateElements = [&](const std::vector<element_no_t> &elementNosLocal)
   {
+    const int nElements = elementNosLocal.size();
+
+    // loop over elements, always 4 elements at once using the vectorized functions
+    for (int elementIndex = 0; elementIndex < nElements; elementIndex += nVcComponents)
+    {
 
 #ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
-    // get indices of elementNos that should be handled in the current iterations,
-    // this is, e.g.
-    //    [10,11,12,13,-1,-1,-1,-1] (if nVcComponents==4 and nElementsLocal > 13)
-    // or [10,11,12,-1,-1,-1,-1,-1] (if nVcComponents==4 and nElementsLocal == 13)
+      // get indices of elementNos that should be handled in the current iterations,
+      // this is, e.g.
+      //    [10,11,12,13,-1,-1,-1,-1] (if nVcComponents==4 and there are more elements in the list)
+      // or [10,11,12,-1,-1,-1,-1,-1] (if nVcComponents==4 and 12 is the last element in the list)
 
-    dof_no_v_t elementNoLocalv([elementNoLocal, nElementsLocal](int i)
-    {
-      return (i >= nVcComponents || elementNoLocal+i >= nElementsLocal? -1: elementNoLocal+i);
-    });
+      dof_no_v_t elementNoLocalv([&elementNosLocal, elementIndex, nElements](int i)
+      {
+        return (i >= nVcComponents || elementIndex+i >= nElements? -1: elementNosLocal[elementIndex+i]);
+      });
 
-    // here, elementNoLocalv is the list of indices of the current iteration, e.g. [10,11,12,13,-1,-1,-1,-1]
-    // elementNoLocal is the first entry of elementNoLocalv
+      // here, elementNoLocalv is the list of indices of the current iteration, e.g. [10,11,12,13,-1,-1,-1,-1]
 #else
-    int elementNoLocalv = elementNoLocal;
+      int elementNoLocalv = elementNosLocal[elementIndex];
 #endif
 
-    // get indices of element-local dofs
-    std::array<dof_no_v_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocalv);
+      // get indices of element-local dofs
+      std::array<dof_no_v_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocalv);
 
-    VLOG(2) << "element " << elementNoLocalv;
+      VLOG(2) << "element " << elementNoLocalv;
 
-    // get geometry field (which are the node positions for Lagrange basis and node positions and derivatives for Hermite)
-    std::array<Vec3_v_t,FunctionSpaceType::nDofsPerElement()> geometry;
-    functionSpace->getElementGeometry(elementNoLocalv, geometry);
+      // get geometry field (which are the node positions for Lagrange basis and node positions and derivatives for Hermite)
+      std::array<Vec3_v_t,FunctionSpaceType::nDofsPerElement()> geometry;
+      functionSpace->getElementGeometry(elementNoLocalv, geometry);
 
-    // compute integral
-    for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
-    {
-      // evaluate function to integrate at samplingPoints[i*2], write value to evaluations[i]
-      std::array<double,D> xi = samplingPoints[samplingPointIndex];
+      // compute integral
+      for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+      {
+        // compute the 3xD jacobian of the parameter space to world space mapping
+        auto jacobian = FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::computeJacobian(geometry, samplingPointIndex);
 
-      // compute the 3xD jacobian of the parameter space to world space mapping
-      auto jacobian = FunctionSpaceType::computeJacobian(geometry, xi);
+        // values of the basis functions at the sampling point
+        const std::array<double,nDofsPerElement> &phi = FunctionSpace::BasisOnQuadrature<FunctionSpaceType,QuadratureDD>::phi()[samplingPointIndex];
 
-      // get evaluations of integrand which is defined in another class
-      evaluationsArray[samplingPointIndex] = IntegrandMassMatrix<D,EvaluationsType,FunctionSpaceType,nComponents,double_v_t,dof_no_v_t,Term>::
-        evaluateIntegrand(jacobian,xi);
+        // get evaluations of integrand which is defined in another class
+        evaluationsArray[samplingPointIndex] = IntegrandMassMatrix<D,EvaluationsType,FunctionSpaceType,nComponents,double_v_t,dof_no_v_t,Term>::
+          evaluateIntegrand(jacobian,phi);
 
-    }  // function evaluations
+      }  // function evaluations
 
-    // integrate all values for the (i,j) dof pairs at once
-    EvaluationsType integratedValues = QuadratureDD::computeIntegral(evaluationsArray);
+      // integrate all values for the (i,j) dof pairs at once
+      EvaluationsType integratedValues = QuadratureDD::computeIntegral(evaluationsArray);
 
-    // perform integration and add to entry in rhs vector
-    for (int i = 0; i < nDofsPerElement; i++)
-    {
-      for (int j = 0; j < nDofsPerElement; j++)
+      // perform integration and add to entry in rhs vector
+      for (int i = 0; i < nDofsPerElement; i++)
       {
-        // loop over components (1,...,D for solid mechanics)
+        VecD<nComponents,double_v_t> contribution;
         for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
+          contribution[rowComponentNo] = 0.0;
+
+        for (int j = 0; j < nDofsPerElement; j++)
         {
-          for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
+          // getValuesAtIndices replaces operator[] (i.e. "rhsValues[dofNosLocal[j]]") and is necessary for it to work also with Vc::double_v
+          VecD<nComponents,double_v_t> rhsValue = getValuesAtIndices(rhsValues,dofNosLocal[j]);
+
+          // loop over components (1,...,D for solid mechanics)
+          for (int rowComponentNo = 0; rowComponentNo < nComponents; rowComponentNo++)
           {
-            // integrate value and set entry in stiffness matrix
-            double_v_t integratedValue = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
+            for (int columnComponentNo = 0; columnComponentNo < nComponents; columnComponentNo++)
+            {
+              // integrate value and set entry in stiffness matrix
+              double_v_t integratedValue = integratedValues(i*nComponents + rowComponentNo, j*nComponents + columnComponentNo);
 
-            // getValuesAtIndices replaces operator[] (i.e. "rhsValues[dofNosLocal[j]]") and is necessary for it to work also with Vc::double_v
-            double_v_t value = integratedValue * getValuesAtIndices(rhsValues,dofNosLocal[j])[columnComponentNo];
-            VLOG(2) << "  dof pair (" << i<< "," <<j<< "), integrated value: " <<integratedValue << ", rhsValue[" << dofNosLocal[j]<< "]: " << getValuesAtIndices(rhsValues,dofNosLocal[j]) << " = " << value;
+              double_v_t value = integratedValue * rhsValue[columnComponentNo];
+              VLOG(2) << "  dof pair (" << i<< "," <<j<< "), integrated value: " <<integratedValue << ", rhsValue[" << dofNosLocal[j]<< "]: " << rhsValue << " = " << value;
 
-            rightHandSide->setValue(rowComponentNo, dofNosLocal[i], value, ADD_VALUES);
+              contribution[rowComponentNo] += value;
+            }
           }
-        }
-      }  // j
-    }  // i
-  }  // elementNoLocalv
+        }  // j
+
+        // addValuesAtIndices replaces "resultValues[dofNosLocal[i]] += contribution"
+        addValuesAtIndices(resultValues, dofNosLocal[i], contribution);
+      }  // i
+    }  // elementNoLocalv
+  };
+
+  // integrate the interior elements while the ghost values are communicated
+  integrateElements(functionSpace->elementNosLocalInterior());
+
+  // wait for the ghost values and get all entries
+  rightHandSide->startGhostManipulationEnd();
+
+  rhsValues.clear();
+  rightHandSide->getValuesWithGhosts(rhsValues);
+  VLOG(1) << "extracted rhsValues (with ghosts): " << rhsValues;
+
+  // integrate the boundary elements which need the ghost values
+  integrateElements(functionSpace->elementNosLocalBoundary());
+
+  // set the new values, including the contributions to the ghost dofs which are added to the values of their owning ranks by finishGhostManipulation
+  rightHandSide->setValuesWithGhosts(resultValues, INSERT_VALUES);
 
   // merge local changes on the vector, parallel assembly
   rightHandSide->finishGhostManipulation();
@@ -12,7 +12,8 @@ template<int D,typename EvaluationsType,typename FunctionSpaceType,int nComponen
 class IntegrandMassMatrix
 {
 public:
-  static EvaluationsType evaluateIntegrand(const std::array<VecD<3,double_v_t>,D> &jacobian, const std::array<double,D> xi);
+  //! evaluate the integrand phi_i * phi_j at a sampling point, phi are the values of the basis functions at the sampling point
+  static EvaluationsType evaluateIntegrand(const std::array<VecD<3,double_v_t>,D> &jacobian, const std::array<double,FunctionSpaceType::nDofsPerElement()> &phi);
 };
 
 
@@ -13,6 +13,7 @@
 #include "basis_function/lagrange.h"
 #include "time_stepping_scheme/implicit_euler.h"
 #include "spatial_discretization/finite_element_method/finite_element_method.h"
+#include "control/diagnostic_tool/performance_measurement.h"
 
 /** Buffers for CellML computation
   *  Includes Vc::double_v::size() instances of the CellML problem (usually 4 when using AVX-2).
@@ -48,6 +49,13 @@ public:
 
 /** The implementation of a monodomain solver as used in the fibers_emg example, number of states and algebraics is templated.
  *  This class contains all functionality except the reaction term. Deriving classes only need to implement compute0D.
+ *
+ *  Every entry of fiberPointBuffers_ contains the states of Vc::double_v::size() neighbouring points of one fiber. The order of the entries is given by the option "pointBufferLayout":
+ *  - "consecutive": all points of all fibers are stored one after the other, every splitting time step computes the 0D problem of all fibers, then the 1D problem of all fibers.
+ *  - "tiled": the fibers are grouped into tiles of "nFibersPerTile" fibers, within a tile the point buffers of the fibers are interleaved,
+ *    i.e. the j-th point buffer of all fibers of the tile are stored next to each other. All splitting time steps are computed for one tile after the other, such that
+ *    the data of a tile stays in the cache between the 0D and 1D computations. The 1D problems of the fibers in a tile are solved together row by row, then
+ *    both the 0D and the 1D computation traverse the point buffers of the tile linearly. This layout requires that all fibers have the same number of points.
   */
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 class FastMonodomainSolverBase : public Runnable
@@ -84,6 +92,9 @@ public:
   //! constructor
   FastMonodomainSolverBase(const DihuContext &context);
 
+  //! destructor
+  virtual ~FastMonodomainSolverBase();
+
   //! initialize the simulation, this is called from run
   void initialize();
 
@@ -172,20 +183,40 @@ protected:
   //! send vmValues data from fiberData_ back to the fibers where it belongs to and set in the respective field variable
   void updateFiberData();
 
-  //! solve the 0D problem, starting from startTime. This is the part that is usually provided by the cellml file
-  void compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer);
+  //! register the states of all local fibers and the stimulation information with Control::Checkpointing, such that a simulation can be restarted
+  void registerCheckpointingState();
+
+  //! solve the 0D problem, starting from startTime, for the point buffers in the range [pointBuffersBegin,pointBuffersEnd) that hold the fibers [fiberDataBegin,fiberDataEnd). This is the part that is usually provided by the cellml file
+  void compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer,
+                 int fiberDataBegin, int fiberDataEnd, int pointBuffersBegin, int pointBuffersEnd);
 
   //! compute one time step of the right hand side for a single simd vector of instances
   virtual void compute0DInstance(Vc::double_v states[], std::vector<Vc::double_v> &parameters, double currentTime, double timeStepWidth,
                                  bool stimulate, bool storeAlgebraicsForTransfer,
                                  std::vector<Vc::double_v> &algebraicsForTransfer){};
 
-  //! solve the 1D problem (diffusion), starting from startTime
-  void compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefactor);
+  //! solve the 1D problem (diffusion), starting from startTime, for the fibers in the range [fiberDataBegin,fiberDataEnd)
+  void compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefactor, int fiberDataBegin, int fiberDataEnd);
+
+  //! compute the entries a,b,c of the row valueNo of the tridiagonal diffusion matrix of the fiber fiberDataNo and the right hand side d
+  void computeDiffusionMatrixRow(int fiberDataNo, int valueNo, double timeStepWidth, double prefactor, bool useImplicitEuler,
+                                 double &a, double &b, double &c, double &d);
 
   //! compute the 0D-1D problem with Strang splitting
   void computeMonodomain();
 
+  //! get the index in fiberPointBuffers_ and the entry in the Vc vector of the point valueNo of the fiber fiberDataNo, depending on the point buffer layout
+  void getPointBufferIndex(int fiberDataNo, int valueNo, global_no_t &pointBuffersNo, int &entryNo) const;
+
+  //! get the fiber of the point buffer pointBuffersNo and the index in the fiber of its first entry
+  void getFiberOfPointBuffer(global_no_t pointBuffersNo, int &fiberDataNo, int &indexInFiber) const;
+
+  //! get the point buffers of the previous and next points on the same fiber as pointBuffersNo, -1 if there is none
+  void getNeighbourPointBuffers(global_no_t pointBuffersNo, int &previousPointBuffersNo, int &nextPointBuffersNo) const;
+
+  //! get the number of fibers in the tile tileNo, only for the tiled point buffer layout, this is nFibersPerTile_ except for the last tile
+  int nFibersInTile(int tileNo) const;
+
   //! check if the current point will be stimulated now
   bool isCurrentPointStimulated(int fiberDataNo, double currentTime, bool currentPointIsInCenter);
 
@@ -213,8 +244,9 @@ protected:
   PythonConfig specificSettings_;    //< config for this object
 
   NestedSolversType nestedSolvers_;   //< the nested solvers object that would normally solve the problem
+  std::shared_ptr<Partition::RankSubset> rankSubset_;   //< the ranks of this solver, used to determine if it is the outermost solver that writes the checkpoints
 
-  std::vector<FiberPointBuffers<nStates>> fiberPointBuffers_;    //< computation buffers for the 0D problem, the states vector used when optimizationType == "vc"
+  std::vector<FiberPointBuffers<nStates>> fiberPointBuffers_;    //< computation buffers for the 0D problem, the states vector used when optimizationType == "vc", the order is given by the point buffer layout
   std::vector<FiberPointBuffers<nStates>> fiberPointBuffersLastCheckpoint_;    //< copy of fiberPointBuffers_ that was stored at the last checkpoint, needed for implicit coupling with precice, where a previous state needs to be restored
 
   std::string fiberDistributionFilename_;  //< filename of the fiberDistributionFile, which contains motor unit numbers for fiber numbers
@@ -225,6 +257,8 @@ protected:
   std::vector<int> motorUnitNo_;                  //< number of motor unit for given fiber no motorUnitNo_[fiberNo]
   std::string durationLogKey0D_;                  //< duration log key for the 0D problem
   std::string durationLogKey1D_;                  //< duration log key for the 1D problem
+  Control::PerformanceMeasurement::TimerHandle timerHandle0D_;   //< timer handle for durationLogKey0D_, resolved once to avoid the lookup by name in every time step
+  Control::PerformanceMeasurement::TimerHandle timerHandle1D_;   //< timer handle for durationLogKey1D_
 
   OutputWriter::Manager outputWriterManager_;     //< manager object holding all output writers
 
@@ -237,6 +271,10 @@ protected:
   double currentTime_;                //< the current time used for the output writer
   int nTimeStepsSplitting_;           //< number of times to repeat the Strang splitting for one advanceTimeSpan() call of FastMonodomainSolver
 
+  bool useTiledPointBufferLayout_;    //< if the point buffers of nFibersPerTile_ fibers are interleaved in tiles ("tiled"), otherwise all points of all fibers are stored consecutively ("consecutive")
+  int nFibersPerTile_;                //< for the tiled layout, number of fibers in a tile whose point buffers are interleaved and which are computed together for all splitting time steps
+  int nPointBuffersPerFiber_;         //< for the tiled layout, number of point buffers of a single fiber, the last one is padded if the number of points is not a multiple of Vc::double_v::size()
+
   bool onlyComputeIfHasBeenStimulated_;       //< option if fiber should only be computed after it has been stimulated for the first time
   std::vector<bool> fiberHasBeenStimulated_;  //< for every fiber if it has been stimulated
 
@@ -296,6 +334,7 @@ protected:
   bool useVc_;                                       //< if the Vc library is used, if not, code for the GPU or OpenMP is generated
   std::string optimizationType_;                     //< the optimization type as given in the settings, one of "vc", "openmp", "gpu"
   bool initialized_;                                 //< if initialize was already called
+  int checkpointingHandle_ = -1;                     //< handle of the registered state in Control::Checkpointing, -1 if not registered
 };
 
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_base.tpp"
@@ -2,6 +2,9 @@
 
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
+#include "control/checkpointing/checkpointing.h"
+
+#include <algorithm>
 
 //! get element lengths and vmValues from the other ranks
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -155,15 +158,14 @@ fetchFiberData()
 
         for (int instanceNo = 0; instanceNo < nInstancesOnFiber; instanceNo++)
         {
-          // compute indices for fiberPointBuffersParameters_
-          global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + instanceNo;
-
           if (useVc_)
           {
-            global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
-            int entryNo = valueIndexAllFibers % Vc::double_v::size();
+            // compute indices for fiberPointBuffersParameters_
+            global_no_t pointBuffersNo = 0;
+            int entryNo = 0;
+            getPointBufferIndex(fiberDataNo, instanceNo, pointBuffersNo, entryNo);
 
-            //LOG(DEBUG) << "valueIndexAllFibers: " << valueIndexAllFibers << ", (" << pointBuffersNo << "," << entryNo << ")";
+            //LOG(DEBUG) << "instanceNo: " << instanceNo << ", (" << pointBuffersNo << "," << entryNo << ")";
 
             // set all received parameter values for the current instance in the correct slot in the vc vector of the current pointBuffer compute buffer
             for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
@@ -220,10 +222,9 @@ fetchFiberData()
 
       for (int valueNo = 0; valueNo < nValues; valueNo++)
       {
-        global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-
-        global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
-        int entryNo = valueIndexAllFibers % Vc::double_v::size();
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
 
         fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = fiberData_[fiberDataNo].vmValues[valueNo];
       }
@@ -248,10 +249,9 @@ updateFiberData()
       for (int valueNo = 0; valueNo < nValues; valueNo++)
       {
         // compute indices to access fiberPointBuffers_ variable
-        global_no_t valueIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-
-        global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
-        int entryNo = valueIndexAllFibers % Vc::double_v::size();
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
 
         assert(statesForTransferIndices_.size() > 0);
         const int stateToTransfer = statesForTransferIndices_[0];  // transfer the first state value
@@ -509,4 +509,136 @@ void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 saveFiberDataCheckpoint()
 {
   fiberPointBuffersLastCheckpoint_ = fiberPointBuffers_;
-}
\ No newline at end of file
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+registerCheckpointingState()
+{
+  if (!Control::Checkpointing::enabled())
+    return;
+
+  // the states of the fibers are only available in fiberPointBuffers_ for "vc", a checkpoint without them would silently restart from wrong values
+  if (!useVc_)
+  {
+    LOG(FATAL) << "FastMonodomainSolver: Checkpointing and Parareal are only supported for \"optimizationType\": \"vc\", "
+      << "with \"" << optimizationType_ << "\" the states of the fibers cannot be stored.";
+  }
+
+  // the values are stored per point of the fibers, in the order fiber, point, state, and not in the memory order of fiberPointBuffers_,
+  // such that a checkpoint does not depend on the point buffer layout and on the padding of the tiled layout
+  int nPointsLocal = 0;
+  for (const FiberData &fiberData : fiberData_)
+  {
+    nPointsLocal += fiberData.valuesLength;
+  }
+  const int nValuesPerFiber = 4;
+
+  // store the states, the stimulation information of the fibers and the current time
+  Control::Checkpointing::SaveFunction save = [this,nPointsLocal,nValuesPerFiber](std::vector<double> &values)
+  {
+    values.reserve(nPointsLocal*nStates + fiberData_.size()*nValuesPerFiber + fiberHasBeenStimulated_.size() + nPointsLocal + 1);
+
+    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      for (int valueNo = 0; valueNo < fiberData_[fiberDataNo].valuesLength; valueNo++)
+      {
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+
+        for (int stateNo = 0; stateNo < nStates; stateNo++)
+        {
+          values.push_back(fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo]);
+        }
+      }
+    }
+
+    for (const FiberData &fiberData : fiberData_)
+    {
+      values.push_back(fiberData.lastStimulationCheckTime);
+      values.push_back(fiberData.currentJitter);
+      values.push_back(fiberData.jitterIndex);
+      values.push_back(fiberData.currentlyStimulating);
+    }
+
+    values.insert(values.end(), fiberHasBeenStimulated_.begin(), fiberHasBeenStimulated_.end());
+
+    // the equilibrium information of the point buffer of every point
+    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      for (int valueNo = 0; valueNo < fiberData_[fiberDataNo].valuesLength; valueNo++)
+      {
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+        values.push_back(fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo]);
+      }
+    }
+    values.push_back(currentTime_);
+  };
+
+  Control::Checkpointing::RestoreFunction restore = [this,nPointsLocal,nValuesPerFiber](const std::vector<double> &values)
+  {
+    const std::size_t nValuesExpected = nPointsLocal*nStates + fiberData_.size()*nValuesPerFiber + fiberHasBeenStimulated_.size() + nPointsLocal + 1;
+
+    if (values.size() != nValuesExpected)
+    {
+      LOG(FATAL) << "FastMonodomainSolver: Checkpoint contains " << values.size() << " values, but " << nValuesExpected << " are needed. "
+        << "The settings differ from the run that wrote the checkpoint.";
+    }
+
+    std::vector<double>::const_iterator iter = values.begin();
+    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      for (int valueNo = 0; valueNo < fiberData_[fiberDataNo].valuesLength; valueNo++)
+      {
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+
+        for (int stateNo = 0; stateNo < nStates; stateNo++)
+        {
+          fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo] = *(iter++);
+        }
+      }
+    }
+
+    for (FiberData &fiberData : fiberData_)
+    {
+      fiberData.lastStimulationCheckTime = *(iter++);
+      fiberData.currentJitter = *(iter++);
+      fiberData.jitterIndex = int(*(iter++));
+      fiberData.currentlyStimulating = *(iter++) != 0;
+    }
+
+    for (int i = 0; i < fiberHasBeenStimulated_.size(); i++)
+    {
+      fiberHasBeenStimulated_[i] = *(iter++) != 0;
+    }
+
+    // if the checkpoint was written with another layout, a point buffer can contain points with different equilibrium states, then the most active one is used
+    std::fill(fiberPointBuffersStatesAreCloseToEquilibrium_.begin(), fiberPointBuffersStatesAreCloseToEquilibrium_.end(), inactive);
+    for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      for (int valueNo = 0; valueNo < fiberData_[fiberDataNo].valuesLength; valueNo++)
+      {
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+
+        state_t state = state_t(int(*(iter++)));
+        if (state > fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo])
+          fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] = state;
+      }
+    }
+    nFiberPointBufferStatesCloseToEquilibrium_ = std::count(fiberPointBuffersStatesAreCloseToEquilibrium_.begin(),
+                                                            fiberPointBuffersStatesAreCloseToEquilibrium_.end(), inactive);
+    currentTime_ = *iter;
+
+    // set the transferred states in the field variables
+    updateFiberData();
+  };
+
+  checkpointingHandle_ = Control::Checkpointing::registerState("fastMonodomainSolver", save, restore);
+}
@@ -2,13 +2,60 @@
 
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
+#include "control/checkpointing/checkpointing.h"
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 run()
 {
   initialize();
-  advanceTimeSpan();
+
+  // if this is the outermost solver, continue from the last checkpoint, if "restart" is set
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+  const bool isOutermostSolver = Control::Checkpointing::claimOutermostSolver(rankSubset_->mpiCommunicator());
+
+  double checkpointTime = 0;
+  if (isOutermostSolver && Control::Checkpointing::restoreCheckpoint(checkpointTime))
+  {
+    for (int i = 0; i < instances.size(); i++)
+    {
+      instances[i].restartAtTime(checkpointTime);
+    }
+  }
+
+  if (!isOutermostSolver || !Control::Checkpointing::writesCheckpoints() || instances.empty())
+  {
+    advanceTimeSpan();
+    return;
+  }
+
+  // compute one splitting time step per call to advanceTimeSpan, such that checkpoints can be written in between
+  const double startTime = instances[0].startTime();
+  const double endTime = instances[0].endTime();
+  const double timeStepWidth = instances[0].timeStepWidth();
+  const int nTimeSteps = instances[0].numberTimeSteps();
+
+  for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)
+  {
+    double currentTime = startTime + timeStepNo * timeStepWidth;
+    double nextTime = (timeStepNo == nTimeSteps-1? endTime : currentTime + timeStepWidth);
+
+    for (int i = 0; i < instances.size(); i++)
+    {
+      instances[i].setTimeSpan(currentTime, nextTime);
+      instances[i].setNumberTimeSteps(1);
+    }
+
+    advanceTimeSpan();
+    Control::Checkpointing::writeCheckpointIfDue(nextTime);
+  }
+
+  // restore the whole time span
+  for (int i = 0; i < instances.size(); i++)
+  {
+    instances[i].setTimeSpan(startTime, endTime);
+    instances[i].setNumberTimeSteps(nTimeSteps);
+  }
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -74,6 +121,10 @@ computeMonodomain()
 
   LOG(DEBUG) << "durationLogKeys: " << durationLogKey0D_ << "," << durationLogKey1D_;
 
+  // resolve the timer handles once, such that the measurements in compute0D and compute1D do not need to look up the names
+  timerHandle0D_ = Control::PerformanceMeasurement::getTimerHandle(durationLogKey0D_);
+  timerHandle1D_ = Control::PerformanceMeasurement::getTimerHandle(durationLogKey1D_);
+
   double startTime = instances[0].startTime();
   double timeStepWidthSplitting = instances[0].timeStepWidth();
   nTimeStepsSplitting_ = instances[0].numberTimeSteps();
@@ -110,23 +161,45 @@ computeMonodomain()
   }
 
   // int fakeTimeStepNo = 0;
- 
-  // loop over splitting time steps
-  for (int timeStepNo = 0; timeStepNo < nTimeStepsSplitting_; timeStepNo++)
+
+  // for the consecutive layout, all fibers are computed at once, for the tiled layout, the fibers of one tile after the other are computed for all time steps,
+  // the fibers are independent of each other, only the order of the computations changes
+  const int nFibers = fiberData_.size();
+  const int nTiles = (useTiledPointBufferLayout_? (nFibers + nFibersPerTile_ - 1) / nFibersPerTile_ : 1);
+
+  // loop over tiles
+  for (int tileNo = 0; tileNo < nTiles; tileNo++)
   {
-    // perform Strang splitting
-    double currentTime = startTime + timeStepNo * timeStepWidthSplitting;
+    int fiberDataBegin = 0;
+    int fiberDataEnd = nFibers;
+    int pointBuffersBegin = 0;
+    int pointBuffersEnd = fiberPointBuffers_.size();
+
+    if (useTiledPointBufferLayout_)
+    {
+      fiberDataBegin = tileNo * nFibersPerTile_;
+      fiberDataEnd = fiberDataBegin + nFibersInTile(tileNo);
+      pointBuffersBegin = fiberDataBegin * nPointBuffersPerFiber_;
+      pointBuffersEnd = fiberDataEnd * nPointBuffersPerFiber_;
+    }
+
+    // loop over splitting time steps
+    for (int timeStepNo = 0; timeStepNo < nTimeStepsSplitting_; timeStepNo++)
+    {
+      // perform Strang splitting
+      double currentTime = startTime + timeStepNo * timeStepWidthSplitting;
 
-    LOG(DEBUG) << "splitting " << timeStepNo << "/" << nTimeStepsSplitting_ << ", t: " << currentTime;
+      LOG(DEBUG) << "splitting " << timeStepNo << "/" << nTimeStepsSplitting_ << ", t: " << currentTime;
 
-    // compute midTime once per step to reuse it. [currentTime, midTime=currentTime+0.5*timeStepWidth, currentTime+timeStepWidth]
-    double midTime = currentTime + 0.5 * timeStepWidthSplitting;
-    bool storeAlgebraicsForTransfer = timeStepNo == nTimeStepsSplitting_-1;   // after the last timestep, store the algebraics for transfer
+      // compute midTime once per step to reuse it. [currentTime, midTime=currentTime+0.5*timeStepWidth, currentTime+timeStepWidth]
+      double midTime = currentTime + 0.5 * timeStepWidthSplitting;
+      bool storeAlgebraicsForTransfer = timeStepNo == nTimeStepsSplitting_-1;   // after the last timestep, store the algebraics for transfer
 
-    // perform splitting
-    compute0D(currentTime, dt0D, nTimeSteps0D, false);
-    compute1D(currentTime, dt1D, nTimeSteps1D, prefactor);
-    compute0D(midTime,     dt0D, nTimeSteps0D, storeAlgebraicsForTransfer);
+      // perform splitting
+      compute0D(currentTime, dt0D, nTimeSteps0D, false, fiberDataBegin, fiberDataEnd, pointBuffersBegin, pointBuffersEnd);
+      compute1D(currentTime, dt1D, nTimeSteps1D, prefactor, fiberDataBegin, fiberDataEnd);
+      compute0D(midTime,     dt0D, nTimeSteps0D, storeAlgebraicsForTransfer, fiberDataBegin, fiberDataEnd, pointBuffersBegin, pointBuffersEnd);
+    }
   }
 
   currentTime_ = instances[0].endTime();
@@ -134,9 +207,10 @@ computeMonodomain()
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
-compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer)
+compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlgebraicsForTransfer,
+          int fiberDataBegin, int fiberDataEnd, int pointBuffersBegin, int pointBuffersEnd)
 {
-  Control::PerformanceMeasurement::start(durationLogKey0D_);
+  Control::PerformanceMeasurement::start(timerHandle0D_);
   LOG(DEBUG) << "compute0D(" << startTime << "), " << nTimeSteps << " time step" << (nTimeSteps == 1? "" : "s");
 
   using Vc::double_v;
@@ -155,15 +229,30 @@ compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlge
     return;
   }
 
-  // set first and last point of the subdomain active to capture stimuli from neighbors
-  fiberPointBuffersStatesAreCloseToEquilibrium_[0] = active;
-  fiberPointBuffersStatesAreCloseToEquilibrium_[nPointBuffers-1] = active;
+  // set the point buffers with the first and last point of every fiber active to capture stimuli from the neighbouring subdomains,
+  // for the tiled layout these are not the first and last point buffers of the range
+  if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  {
+    for (int fiberDataNo = fiberDataBegin; fiberDataNo < fiberDataEnd; fiberDataNo++)
+    {
+      for (int valueNo : {0, fiberData_[fiberDataNo].valuesLength-1})
+      {
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
 
-  const double factorForForDataNo = (double)Vc::double_v::size() / fiberData_[0].valuesLength;
-  for (global_no_t pointBuffersNo = 0; pointBuffersNo < nPointBuffers; pointBuffersNo++)
+        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] == inactive)
+          nFiberPointBufferStatesCloseToEquilibrium_--;
+        fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] = active;
+      }
+    }
+  }
+
+  for (global_no_t pointBuffersNo = pointBuffersBegin; pointBuffersNo < pointBuffersEnd; pointBuffersNo++)
   {
-    int fiberDataNo = pointBuffersNo * factorForForDataNo;
-    int indexInFiber = pointBuffersNo * Vc::double_v::size() - fiberData_[fiberDataNo].valuesOffset;
+    int fiberDataNo = 0;
+    int indexInFiber = 0;
+    getFiberOfPointBuffer(pointBuffersNo, fiberDataNo, indexInFiber);
 
     // determine if current point is at center of fiber
     int fiberCenterIndex = fiberData_[fiberDataNo].fiberStimulationPointIndex;
@@ -254,12 +343,12 @@ compute0D(double startTime, double timeStepWidth, int nTimeSteps, bool storeAlge
 #endif
 
   VLOG(1) << "nFiberPointBuffers: " << nPointBuffers;
-  Control::PerformanceMeasurement::stop(durationLogKey0D_);
+  Control::PerformanceMeasurement::stop(timerHandle0D_);
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
-compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefactor)
+compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefactor, int fiberDataBegin, int fiberDataEnd)
 {
   // if all entries are at equilibrium, nothing will be computed, skip also 1D computation
   if (nFiberPointBufferStatesCloseToEquilibrium_ == fiberPointBuffersStatesAreCloseToEquilibrium_.size())
@@ -268,7 +357,7 @@ compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefact
     return;
   }
 
-  Control::PerformanceMeasurement::start(durationLogKey1D_);
+  Control::PerformanceMeasurement::start(timerHandle1D_);
 
   LOG(DEBUG) << "compute1D(" << startTime << ")";
 
@@ -287,32 +376,40 @@ compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefact
 
   const double dt = timeStepWidth;
 
-  // loop over fibers
-  for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
+  // for the consecutive layout, the fibers are solved one after the other,
+  // for the tiled layout, all fibers of the tile are solved together row by row, such that the interleaved point buffers are traversed linearly
+  const int nFibersSolvedTogether = (useTiledPointBufferLayout_? fiberDataEnd - fiberDataBegin : 1);
+
+  // loop over groups of fibers that are solved together
+  for (int fiberDataGroupBegin = fiberDataBegin; fiberDataGroupBegin < fiberDataEnd; fiberDataGroupBegin += nFibersSolvedTogether)
   {
-    int nValues = fiberData_[fiberDataNo].vmValues.size();
+    // all fibers of a group have the same number of values
+    int nValues = fiberData_[fiberDataGroupBegin].vmValues.size();
 
 #ifndef NDEBUG
-    VLOG(1) << "fiber " << fiberDataNo << "/" << fiberData_.size() << ", valuesOffset: " << fiberData_[fiberDataNo].valuesOffset
-      << ", has " << nValues << " values: ";
-
-    std::stringstream s, s2;
-    for (int valueNo = 0; valueNo < nValues; valueNo++)
+    for (int fiberDataNo = fiberDataGroupBegin; fiberDataNo < fiberDataGroupBegin+nFibersSolvedTogether; fiberDataNo++)
     {
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-      double u = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
-      if (valueNo != 0)
+      VLOG(1) << "fiber " << fiberDataNo << "/" << fiberData_.size() << ", valuesOffset: " << fiberData_[fiberDataNo].valuesOffset
+        << ", has " << nValues << " values: ";
+
+      std::stringstream s, s2;
+      for (int valueNo = 0; valueNo < nValues; valueNo++)
       {
-        s << ", ";
-        s2 << ",";
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+        double u = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+        if (valueNo != 0)
+        {
+          s << ", ";
+          s2 << ",";
+        }
+        s << u;
+        s2 << "[" << pointBuffersNo << "][" << entryNo << "]  ";
       }
-      s << u;
-      s2 << "[" << pointBuffersNo << "][" << entryNo << "](" << valuesIndexAllFibers << ")  ";
+      VLOG(1) << s.str();
+      //LOG(DEBUG) << "indices: " << s2.str();
     }
-    VLOG(1) << s.str();
-    //LOG(DEBUG) << "indices: " << s2.str();
 #endif
     // [ b c     ] [x]   [d]
     // [ a b c   ] [x] = [d]
@@ -331,183 +428,204 @@ compute1D(double startTime, double timeStepWidth, int nTimeSteps, double prefact
     // x_n = d'_n
     // x_i = d'_i - c'_i * x_{i+1}
 
-    // helper buffers c', d'
-    static std::vector<double> cAlgebraic(nValues-1);
-    static std::vector<double> dAlgebraic(nValues);
+    // helper buffers c', d', for all fibers of the group: cAlgebraic[valueNo*nFibersSolvedTogether + fiberNoInGroup]
+    static std::vector<double> cAlgebraic;
+    static std::vector<double> dAlgebraic;
+    cAlgebraic.resize(nValues*nFibersSolvedTogether);
+    dAlgebraic.resize(nValues*nFibersSolvedTogether);
 
     // perform forward substitution
     // loop over entries / rows of matrices
     for (int valueNo = 0; valueNo < nValues; valueNo++)
     {
-     // new with CN
-      double a = 0;
-      double b = 0;
-      double c = 0;
-      double d = 0;
-
-      double u_previous = 0;
-      double u_center = 0;
-      double u_next = 0;
-
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-      u_center = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
-
-      // contribution from left element
-      if (valueNo > 0)
+      // loop over the fibers of the group
+      for (int fiberNoInGroup = 0; fiberNoInGroup < nFibersSolvedTogether; fiberNoInGroup++)
       {
-        global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo - 1;
-        global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-        int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-        u_previous = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+        const int fiberDataNo = fiberDataGroupBegin + fiberNoInGroup;
+        const int index = valueNo*nFibersSolvedTogether + fiberNoInGroup;
 
-        // stencil K: 1/h*[1   _-1_ ]*prefactor
-        // stencil M:   h*[1/6 _1/3_]
+        double a = 0;
+        double b = 0;
+        double c = 0;
+        double d = 0;
+        computeDiffusionMatrixRow(fiberDataNo, valueNo, dt, prefactor, useImplicitEuler, a, b, c, d);
 
-        double h_left = fiberData_[fiberDataNo].elementLengths[valueNo-1];
-        double k_left = 1./h_left*(1) * prefactor;
-        double m_left = h_left*1./6;
-
-        if (useImplicitEuler)
-        {
-          a = (k_left - 1/dt*m_left);
-        }
-        else  // Crank-Nicolson
+        if (valueNo == 0)
         {
-          a = (k_left/2. - 1/dt*m_left);
-        }
-
-        double k_right = 1./h_left*(-1) * prefactor;
-        double m_right = h_left*1./3;
+          // c'_0 = c_0 / b_0
+          cAlgebraic[index] = c / b;
 
-        if (useImplicitEuler)
-        {
-          b += (k_right - 1/dt*m_right);
-          d += (-1/dt*m_left) * u_previous + (-1/dt*m_right) * u_center;
+          // d'_0 = d_0 / b_0
+          dAlgebraic[index] = d / b;
         }
-        else  // Crank-Nicolson
+        else
         {
-          b += (k_right/2. - 1/dt*m_right);
-          d += (-k_left/2. - 1/dt*m_left) * u_previous + (-k_right/2. - 1/dt*m_right) * u_center;
-        }
-      }
-
-      // contribution from right element
-      if (valueNo < nValues-1)
-      {
-        global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo + 1;
-        global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-        int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-        u_next = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
-
-        // stencil K: 1/h*[_-1_  1  ]*prefactor
-        // stencil M:   h*[_1/3_ 1/6]
-
-        double h_right = fiberData_[fiberDataNo].elementLengths[valueNo];
-        double k_right = 1./h_right*(1) * prefactor;
-        double m_right = h_right*1./6;
+          const int indexPrevious = index - nFibersSolvedTogether;
+          if (valueNo != nValues-1)
+          {
+            // c'_i = c_i / (b_i - c'_{i-1}*a_i)
+            cAlgebraic[index] = c / (b - cAlgebraic[indexPrevious]*a);
+          }
 
-        if (useImplicitEuler)
-        {
-          c = (k_right - 1/dt*m_right);
-        }
-        else  // Crank-Nicolson
-        {
-          c = (k_right/2. - 1/dt*m_right);
+          // d'_i = (d_i - d'_{i-1}*a_i) / (b_i - c'_{i-1}*a_i)
+          dAlgebraic[index] = (d - dAlgebraic[indexPrevious]*a) / (b - cAlgebraic[indexPrevious]*a);
         }
 
-        double k_left = 1./h_right*(-1) * prefactor;
-        double m_left = h_right*1./3;
-
-        if (useImplicitEuler)
-        {
-          b += (k_left - 1/dt*m_left);
-          d += (-1/dt*m_left) * u_center + (-1/dt*m_right) * u_next;
-        }
-        else  // Crank-Nicolson
+#ifndef NDEBUG
+        if (valueNo > 0 && (valueNo < 5 || valueNo >= nValues-6))
         {
-          b += (k_left/2. - 1/dt*m_left);
-          d += (-k_left/2. - 1/dt*m_left) * u_center + (-k_right/2. - 1/dt*m_right) * u_next;
+          const int indexPrevious = index - nFibersSolvedTogether;
+          VLOG(2) << "valueNo: " << valueNo << ", a: " << a << ", b: " << b << ", c: " << c << ", d: " << d
+            << ", c': " << (valueNo < nValues-1? cAlgebraic[index] : 0) << ", d': " << dAlgebraic[index]
+            << " = (" << d << "-" << dAlgebraic[indexPrevious]*a << ")/(" << b << "-" << cAlgebraic[indexPrevious]*a << ") = " << (d - dAlgebraic[indexPrevious]*a) << "/" << (b - cAlgebraic[indexPrevious]*a);
         }
+#endif
       }
+    }
 
-      if (valueNo == 0)
-      {
-        // c'_0 = c_0 / b_0
-        cAlgebraic[valueNo] = c / b;
+    //LOG(DEBUG) << "cAlgebraic: " << cAlgebraic;
+    //LOG(DEBUG) << "dAlgebraic: " << dAlgebraic;
 
-        // d'_0 = d_0 / b_0
-        dAlgebraic[valueNo] = d / b;
-      }
-      else
+    // perform backward substitution
+    // loop over entries / rows of matrices
+    for (int valueNo = nValues-1; valueNo >= 0; valueNo--)
+    {
+      // loop over the fibers of the group
+      for (int fiberNoInGroup = 0; fiberNoInGroup < nFibersSolvedTogether; fiberNoInGroup++)
       {
+        const int fiberDataNo = fiberDataGroupBegin + fiberNoInGroup;
+        const int index = valueNo*nFibersSolvedTogether + fiberNoInGroup;
+
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+
+        // x_n = d'_n
+        double resultValue = dAlgebraic[index];
+
+        // x_i = d'_i - c'_i * x_{i+1}
         if (valueNo != nValues-1)
         {
-          // c'_i = c_i / (b_i - c'_{i-1}*a_i)
-          cAlgebraic[valueNo] = c / (b - cAlgebraic[valueNo-1]*a);
+          // the previous value x_{i+1} was already stored in the next row of dAlgebraic
+          resultValue -= cAlgebraic[index] * dAlgebraic[index + nFibersSolvedTogether];
+          dAlgebraic[index] = resultValue;
         }
 
-        // d'_i = (d_i - d'_{i-1}*a_i) / (b_i - c'_{i-1}*a_i)
-        dAlgebraic[valueNo] = (d - dAlgebraic[valueNo-1]*a) / (b - cAlgebraic[valueNo-1]*a);
+        fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = resultValue;
       }
+    }
 
 #ifndef NDEBUG
-      if (valueNo < 5 || valueNo >= nValues-6)
+    for (int fiberDataNo = fiberDataGroupBegin; fiberDataNo < fiberDataGroupBegin+nFibersSolvedTogether; fiberDataNo++)
+    {
+      std::stringstream s;
+      for (int valueNo = 0; valueNo < nValues; valueNo++)
       {
-        VLOG(2) << "valueNo: " << valueNo << ", a: " << a << ", b: " << b << ", c: " << c << ", d: " << d
-          << ", u: " << u_center << ", c': " << (valueNo < nValues-1? cAlgebraic[valueNo] : 0) << ", d': " << dAlgebraic[valueNo]
-          << " = (" << d << "-" << dAlgebraic[valueNo-1]*a << ")/(" << b << "-" << cAlgebraic[valueNo-1]*a << ") = " << (d - dAlgebraic[valueNo-1]*a) << "/" << (b - cAlgebraic[valueNo-1]*a);
+        global_no_t pointBuffersNo = 0;
+        int entryNo = 0;
+        getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+        double u = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+        if (valueNo != 0)
+          s << ", ";
+        s << u;
       }
-#endif
+      VLOG(1) << " -> " << s.str();
     }
+#endif
+  }
+  Control::PerformanceMeasurement::stop(timerHandle1D_);
+}
 
-    //LOG(DEBUG) << "cAlgebraic: " << cAlgebraic;
-    //LOG(DEBUG) << "dAlgebraic: " << dAlgebraic;
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+computeDiffusionMatrixRow(int fiberDataNo, int valueNo, double timeStepWidth, double prefactor, bool useImplicitEuler,
+                          double &a, double &b, double &c, double &d)
+{
+  const double dt = timeStepWidth;
+  const int nValues = fiberData_[fiberDataNo].vmValues.size();
 
-    // perform backward substitution
-    // x_n = d'_n
-    global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + nValues-1;
-    global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-    int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-    fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = dAlgebraic[nValues-1];
-    //LOG(DEBUG) << "set entry (" << pointBuffersNo << "," << entryNo << ") to " << dAlgebraic[nValues-1];
+  double u_previous = 0;
+  double u_center = 0;
+  double u_next = 0;
 
-    double previousValue = dAlgebraic[nValues-1];
+  global_no_t pointBuffersNo = 0;
+  int entryNo = 0;
+  getPointBufferIndex(fiberDataNo, valueNo, pointBuffersNo, entryNo);
+  u_center = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
 
-    // loop over entries / rows of matrices
-    for (int valueNo = nValues-2; valueNo >= 0; valueNo--)
+  // contribution from left element
+  if (valueNo > 0)
+  {
+    getPointBufferIndex(fiberDataNo, valueNo - 1, pointBuffersNo, entryNo);
+    u_previous = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
+
+    // stencil K: 1/h*[1   _-1_ ]*prefactor
+    // stencil M:   h*[1/6 _1/3_]
+
+    double h_left = fiberData_[fiberDataNo].elementLengths[valueNo-1];
+    double k_left = 1./h_left*(1) * prefactor;
+    double m_left = h_left*1./6;
+
+    if (useImplicitEuler)
+    {
+      a = (k_left - 1/dt*m_left);
+    }
+    else  // Crank-Nicolson
     {
-      // x_i = d'_i - c'_i * x_{i+1}
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
+      a = (k_left/2. - 1/dt*m_left);
+    }
 
-      double resultValue = dAlgebraic[valueNo] - cAlgebraic[valueNo] * previousValue;
-      fiberPointBuffers_[pointBuffersNo].states[0][entryNo] = resultValue;
+    double k_right = 1./h_left*(-1) * prefactor;
+    double m_right = h_left*1./3;
 
-      previousValue = resultValue;
+    if (useImplicitEuler)
+    {
+      b += (k_right - 1/dt*m_right);
+      d += (-1/dt*m_left) * u_previous + (-1/dt*m_right) * u_center;
     }
+    else  // Crank-Nicolson
+    {
+      b += (k_right/2. - 1/dt*m_right);
+      d += (-k_left/2. - 1/dt*m_left) * u_previous + (-k_right/2. - 1/dt*m_right) * u_center;
+    }
+  }
 
-    int nPointBuffers = fiberPointBuffers_.size();
-    pointBuffersNo = int(nPointBuffers/2);
+  // contribution from right element
+  if (valueNo < nValues-1)
+  {
+    getPointBufferIndex(fiberDataNo, valueNo + 1, pointBuffersNo, entryNo);
+    u_next = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
 
-#ifndef NDEBUG
-    s.str("");
-    for (int valueNo = 0; valueNo < nValues; valueNo++)
+    // stencil K: 1/h*[_-1_  1  ]*prefactor
+    // stencil M:   h*[_1/3_ 1/6]
+
+    double h_right = fiberData_[fiberDataNo].elementLengths[valueNo];
+    double k_right = 1./h_right*(1) * prefactor;
+    double m_right = h_right*1./6;
+
+    if (useImplicitEuler)
     {
-      global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
-      global_no_t pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
-      int entryNo = valuesIndexAllFibers % Vc::double_v::size();
-      double u = fiberPointBuffers_[pointBuffersNo].states[0][entryNo];
-      if (valueNo != 0)
-        s << ", ";
-      s << u;
+      c = (k_right - 1/dt*m_right);
+    }
+    else  // Crank-Nicolson
+    {
+      c = (k_right/2. - 1/dt*m_right);
+    }
+
+    double k_left = 1./h_right*(-1) * prefactor;
+    double m_left = h_right*1./3;
+
+    if (useImplicitEuler)
+    {
+      b += (k_left - 1/dt*m_left);
+      d += (-1/dt*m_left) * u_center + (-1/dt*m_right) * u_next;
+    }
+    else  // Crank-Nicolson
+    {
+      b += (k_left/2. - 1/dt*m_left);
+      d += (-k_left/2. - 1/dt*m_left) * u_center + (-k_right/2. - 1/dt*m_right) * u_next;
     }
-    VLOG(1) << " -> " << s.str();
-#endif
   }
-  Control::PerformanceMeasurement::stop(durationLogKey1D_);
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -650,6 +768,11 @@ equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int poi
   // check if states for the current point are at their equilibrium
   if (disableComputationWhenStatesAreCloseToEquilibrium_)
   {
+    // get the neighbouring point buffers on the same fiber, depending on the point buffer layout
+    int previousPointBuffersNo = -1;
+    int nextPointBuffersNo = -1;
+    getNeighbourPointBuffers(pointBuffersNo, previousPointBuffersNo, nextPointBuffersNo);
+
     bool statesAreAtEquilibrium = true;
 
     // if the current point is not inactive and therefore was computed
@@ -700,8 +823,8 @@ equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int poi
     )
     {
       // check if one of the neighbours is still not inactive, if it is not, set own point to inactive
-      if (pointBuffersNo > 0)
-        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] != active)
+      if (previousPointBuffersNo != -1)
+        if (fiberPointBuffersStatesAreCloseToEquilibrium_[previousPointBuffersNo] != active)
         {
           if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] != inactive)
           {
@@ -710,8 +833,8 @@ equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int poi
           }
         }
 
-      if (pointBuffersNo < fiberPointBuffers_.size()-1)
-        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] != active)
+      if (nextPointBuffersNo != -1)
+        if (fiberPointBuffersStatesAreCloseToEquilibrium_[nextPointBuffersNo] != active)
         {
           if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] != inactive)
           {
@@ -742,21 +865,21 @@ equilibriumAccelerationUpdate(const Vc::double_v statesPreviousValues[], int poi
         fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] = active;
 
         // set neighbouring point buffers to "neighbor_is_active"
-        if (pointBuffersNo > 0)
+        if (previousPointBuffersNo != -1)
         {
-          if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] == inactive)
+          if (fiberPointBuffersStatesAreCloseToEquilibrium_[previousPointBuffersNo] == inactive)
           {
             nFiberPointBufferStatesCloseToEquilibrium_--;
-            fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] = neighbor_is_active;
+            fiberPointBuffersStatesAreCloseToEquilibrium_[previousPointBuffersNo] = neighbor_is_active;
           }
         }
 
-        if (pointBuffersNo < fiberPointBuffers_.size()-1)
+        if (nextPointBuffersNo != -1)
         {
-          if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] == inactive)
+          if (fiberPointBuffersStatesAreCloseToEquilibrium_[nextPointBuffersNo] == inactive)
           {
             nFiberPointBufferStatesCloseToEquilibrium_--;
-            fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] = neighbor_is_active;
+            fiberPointBuffersStatesAreCloseToEquilibrium_[nextPointBuffersNo] = neighbor_is_active;
           }
         }
       }
@@ -774,20 +897,25 @@ isEquilibriumAccelerationCurrentPointDisabled(bool stimulateCurrentPoint, int po
     {
       fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] = active;
 
+      // get the neighbouring point buffers on the same fiber, depending on the point buffer layout
+      int previousPointBuffersNo = -1;
+      int nextPointBuffersNo = -1;
+      getNeighbourPointBuffers(pointBuffersNo, previousPointBuffersNo, nextPointBuffersNo);
+
       // set neighbouring point buffers to "neighbor_is_active"
-      if (pointBuffersNo > 0)
-        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] == inactive)
+      if (previousPointBuffersNo != -1)
+        if (fiberPointBuffersStatesAreCloseToEquilibrium_[previousPointBuffersNo] == inactive)
         {
-          if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] == inactive)
+          if (fiberPointBuffersStatesAreCloseToEquilibrium_[previousPointBuffersNo] == inactive)
             nFiberPointBufferStatesCloseToEquilibrium_--;
-          fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo-1] = neighbor_is_active;
+          fiberPointBuffersStatesAreCloseToEquilibrium_[previousPointBuffersNo] = neighbor_is_active;
         }
-      if (pointBuffersNo < fiberPointBuffers_.size()-1)
-        if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] == inactive)
+      if (nextPointBuffersNo != -1)
+        if (fiberPointBuffersStatesAreCloseToEquilibrium_[nextPointBuffersNo] == inactive)
         {
-          if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] == inactive)
+          if (fiberPointBuffersStatesAreCloseToEquilibrium_[nextPointBuffersNo] == inactive)
             nFiberPointBufferStatesCloseToEquilibrium_--;
-          fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo+1] = neighbor_is_active;
+          fiberPointBuffersStatesAreCloseToEquilibrium_[nextPointBuffersNo] = neighbor_is_active;
         }
     }
 
@@ -798,4 +926,86 @@ isEquilibriumAccelerationCurrentPointDisabled(bool stimulateCurrentPoint, int po
     }
   }
   return false;
-}
\ No newline at end of file
+}
+
+// methods for the index mapping of the point buffer layout
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+getPointBufferIndex(int fiberDataNo, int valueNo, global_no_t &pointBuffersNo, int &entryNo) const
+{
+  if (useTiledPointBufferLayout_)
+  {
+    // in a tile, the j-th point buffers of all fibers of the tile are stored next to each other
+    const int tileNo = fiberDataNo / nFibersPerTile_;
+    const int fiberNoInTile = fiberDataNo % nFibersPerTile_;
+
+    pointBuffersNo = (global_no_t)tileNo * nFibersPerTile_ * nPointBuffersPerFiber_
+      + (valueNo / Vc::double_v::size()) * nFibersInTile(tileNo) + fiberNoInTile;
+    entryNo = valueNo % Vc::double_v::size();
+  }
+  else
+  {
+    // all points of all fibers are stored consecutively
+    global_no_t valuesIndexAllFibers = fiberData_[fiberDataNo].valuesOffset + valueNo;
+    pointBuffersNo = valuesIndexAllFibers / Vc::double_v::size();
+    entryNo = valuesIndexAllFibers % Vc::double_v::size();
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+getFiberOfPointBuffer(global_no_t pointBuffersNo, int &fiberDataNo, int &indexInFiber) const
+{
+  if (useTiledPointBufferLayout_)
+  {
+    const int nPointBuffersPerTile = nFibersPerTile_ * nPointBuffersPerFiber_;
+    const int tileNo = pointBuffersNo / nPointBuffersPerTile;
+    const int pointBuffersNoInTile = pointBuffersNo - (global_no_t)tileNo * nPointBuffersPerTile;
+    const int nFibersInCurrentTile = nFibersInTile(tileNo);
+
+    fiberDataNo = tileNo * nFibersPerTile_ + pointBuffersNoInTile % nFibersInCurrentTile;
+    indexInFiber = (pointBuffersNoInTile / nFibersInCurrentTile) * Vc::double_v::size();
+  }
+  else
+  {
+    // all fibers have the same number of values, a point buffer can contain points of two fibers, then the first fiber is used
+    fiberDataNo = pointBuffersNo * Vc::double_v::size() / fiberData_[0].valuesLength;
+    indexInFiber = pointBuffersNo * Vc::double_v::size() - fiberData_[fiberDataNo].valuesOffset;
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+getNeighbourPointBuffers(global_no_t pointBuffersNo, int &previousPointBuffersNo, int &nextPointBuffersNo) const
+{
+  // for the consecutive layout, the neighbours are the adjacent point buffers, also across the boundary between two fibers
+  global_no_t pointBuffersBegin = 0;
+  global_no_t pointBuffersEnd = fiberPointBuffers_.size();
+  int stride = 1;
+
+  // for the tiled layout, the neighbours on the same fiber are nFibersInTile point buffers apart
+  if (useTiledPointBufferLayout_)
+  {
+    const int nPointBuffersPerTile = nFibersPerTile_ * nPointBuffersPerFiber_;
+    const int tileNo = pointBuffersNo / nPointBuffersPerTile;
+    stride = nFibersInTile(tileNo);
+    pointBuffersBegin = (global_no_t)tileNo * nPointBuffersPerTile;
+    pointBuffersEnd = pointBuffersBegin + stride * nPointBuffersPerFiber_;
+  }
+
+  previousPointBuffersNo = -1;
+  nextPointBuffersNo = -1;
+
+  if (pointBuffersNo >= pointBuffersBegin + stride)
+    previousPointBuffersNo = pointBuffersNo - stride;
+
+  if (pointBuffersNo + stride < pointBuffersEnd)
+    nextPointBuffersNo = pointBuffersNo + stride;
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+int FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+nFibersInTile(int tileNo) const
+{
+  return std::min(nFibersPerTile_, (int)fiberData_.size() - tileNo * nFibersPerTile_);
+}
@@ -3,18 +3,26 @@
 #include <vc_or_std_simd.h>  // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
+#include "control/checkpointing/checkpointing.h"
 #include <random>
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 FastMonodomainSolverBase(const DihuContext &context) :
-  specificSettings_(context.getPythonConfig()), nestedSolvers_(context),
+  specificSettings_(context.getPythonConfig()), nestedSolvers_(context), rankSubset_(context.rankSubset()),
   compute0DInstance_(nullptr), computeMonodomain_(nullptr), initializeStates_(nullptr), useVc_(true), initialized_(false)
 {
   // initialize output writers
   this->outputWriterManager_.initialize(context, specificSettings_);
 }
 
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+~FastMonodomainSolverBase()
+{
+  Control::Checkpointing::unregisterState(checkpointingHandle_);
+}
+
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 initialize()
@@ -37,6 +45,9 @@ initialize()
     LOG(FATAL) << "Timestepping scheme of diffusion in FastMonodomainSolver must be either ImplicitEuler or CrankNicolson!";
   }
 
+  // the states that are registered for checkpointing by this solver get the path of the settings as key prefix
+  Control::Checkpointing::KeyScope checkpointingKeyScope(specificSettings_.getStringPath());
+
   // disable the generation of the source code and compilation of the library in the nested CellmlAdapter
   // loop over instances of the CellML adapter
   for (int i = 0; i < nestedSolvers_.instancesLocal().size(); i++)
@@ -71,6 +82,22 @@ initialize()
   neuromuscularJunctionRelativeSize_ = specificSettings_.getOptionDouble("neuromuscularJunctionRelativeSize", 0.0);
   generateGpuSource_ = specificSettings_.getOptionBool("generateGPUSource", true);
 
+  // parse the memory layout of the point buffers
+  std::string pointBufferLayout = specificSettings_.getOptionString("pointBufferLayout", "consecutive");
+  nFibersPerTile_ = specificSettings_.getOptionInt("nFibersPerTile", 4, PythonUtility::Positive);
+  nPointBuffersPerFiber_ = 0;
+
+  if (pointBufferLayout == "tiled")
+    useTiledPointBufferLayout_ = true;
+  else if (pointBufferLayout == "consecutive")
+    useTiledPointBufferLayout_ = false;
+  else
+  {
+    LOG(ERROR) << "FastMonodomainSolver has invalid \"pointBufferLayout\": \"" << pointBufferLayout
+      << "\". Valid options are \"consecutive\" or \"tiled\". Now using \"consecutive\".";
+    useTiledPointBufferLayout_ = false;
+  }
+
   // output warning if there are output writers
   if (this->outputWriterManager_.hasOutputWriters())
   {
@@ -139,6 +166,9 @@ initialize()
   // initialize the variable names where field variables are connector via connector slots
   initializeFieldVariableNames();
 
+  // the states of the fibers are only stored in fiberPointBuffers_, they have to be part of checkpoints
+  registerCheckpointingState();
+
   initialized_ = true;
 }
 
@@ -422,6 +452,30 @@ initializeDataStructures()
 
   int nVcVectors = (nInstancesToCompute_ + Vc::double_v::size() - 1) / Vc::double_v::size();
 
+  // the tiled layout needs the same number of points on all fibers, it pads every fiber to full point buffers
+  if (useTiledPointBufferLayout_ && useVc_)
+  {
+    for (int fiberDataNo = 1; fiberDataNo < fiberData_.size(); fiberDataNo++)
+    {
+      if (fiberData_[fiberDataNo].valuesLength != fiberData_[0].valuesLength)
+      {
+        LOG(WARNING) << "FastMonodomainSolver: \"pointBufferLayout\": \"tiled\" requires that all fibers have the same number of points, "
+          << "but fiber " << fiberData_[fiberDataNo].fiberNoGlobal << " has " << fiberData_[fiberDataNo].valuesLength << " instead of "
+          << fiberData_[0].valuesLength << " points. Now using \"consecutive\".";
+        useTiledPointBufferLayout_ = false;
+        break;
+      }
+    }
+  }
+
+  if (useTiledPointBufferLayout_ && useVc_ && !fiberData_.empty())
+  {
+    nPointBuffersPerFiber_ = (fiberData_[0].valuesLength + Vc::double_v::size() - 1) / Vc::double_v::size();
+    nVcVectors = fiberData_.size() * nPointBuffersPerFiber_;
+
+    LOG(DEBUG) << "tiled point buffer layout, " << nFibersPerTile_ << " fibers per tile, " << nPointBuffersPerFiber_ << " point buffers per fiber";
+  }
+
   if (useVc_)
   {
     fiberPointBuffers_.resize(nVcVectors);
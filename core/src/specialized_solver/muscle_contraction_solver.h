@@ -7,6 +7,7 @@
 #include "data_management/specialized_solver/muscle_contraction_solver.h"
 #include "specialized_solver/solid_mechanics/dynamic_hyperelasticity/dynamic_hyperelasticity_solver.h"
 #include "equation/mooney_rivlin_incompressible.h"
+#include "mesh/mapping_between_meshes/embedded_geometry.h"
 #include "data_management/specialized_solver/muscle_contraction_solver.h"
 
 /** Solve the incompressible, transversely isotropic Mooney-Rivlin material with active stress contribution.
@@ -75,6 +76,10 @@ protected:
   //! create the mappings for the geometry field mapping between meshes
   void initializeMappingBetweenMeshes();
 
+  //! store the interpolation weights of the given mesh in the own mesh, such that its geometry can be updated directly in mapGeometryToGivenMeshes
+  template<typename FunctionSpaceTargetType>
+  void initializeEmbeddedGeometry(std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget);
+
   std::shared_ptr<DynamicHyperelasticitySolverType> dynamicHyperelasticitySolver_;   //< the dynamic hyperelasticity solver that solves for the dynamic contraction
   std::shared_ptr<StaticHyperelasticitySolverType> staticHyperelasticitySolver_;     //< the static hyperelasticity solver that can be used for quasi-static solution
 
@@ -86,6 +91,8 @@ protected:
   bool enableForceLengthRelation_;              //< if the force-length relation factor f_l(λ_f) should be multiplied
   double lambdaDotScalingFactor_;               //< scaling factor for the computation of lambdaDot
   std::vector<std::string> meshNamesOfGeometryToMapTo_;   //< a list of mesh names which will get updated with the geometry
+  std::vector<std::shared_ptr<MappingBetweenMeshes::EmbeddedGeometryBase>> embeddedGeometries_;   //< the geometry transfers to the meshes of meshNamesOfGeometryToMapTo_, if reverseMappingOrder is set
+  bool embeddedGeometriesInitialized_;          //< if embeddedGeometries_ has been created, then it is used instead of the generic mapping between meshes
 
   bool initialized_;                            //< if initialize was already called
 };
@@ -11,7 +11,7 @@ MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
 MuscleContractionSolver(DihuContext context) :
   Runnable(),
   ::TimeSteppingScheme::TimeSteppingScheme(context["MuscleContractionSolver"]),
-  data_(this->context_), initialized_(false)
+  data_(this->context_), embeddedGeometriesInitialized_(false), initialized_(false)
 {
   // get python settings object from context
   this->specificSettings_ = this->context_.getPythonConfig();
@@ -296,7 +296,7 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
-          DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType1,SourceFunctionSpaceType>(functionSpaceTarget,functionSpaceSource);
+          initializeEmbeddedGeometry<TargetFunctionSpaceType1>(functionSpaceTarget);
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType1>(functionSpaceSource, functionSpaceTarget);
       }
@@ -316,7 +316,7 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
-          DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType2,SourceFunctionSpaceType>(functionSpaceTarget,functionSpaceSource);
+          initializeEmbeddedGeometry<TargetFunctionSpaceType2>(functionSpaceTarget);
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType2>(functionSpaceSource, functionSpaceTarget);
 
@@ -337,7 +337,7 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
-          DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType3,SourceFunctionSpaceType>(functionSpaceTarget, functionSpaceSource);
+          initializeEmbeddedGeometry<TargetFunctionSpaceType3>(functionSpaceTarget);
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType3>(functionSpaceSource, functionSpaceTarget);
       }
@@ -357,18 +357,58 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
-          DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType4,SourceFunctionSpaceType>(functionSpaceTarget, functionSpaceSource);
+          initializeEmbeddedGeometry<TargetFunctionSpaceType4>(functionSpaceTarget);
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType4>(functionSpaceSource, functionSpaceTarget);
       }
       else LOG(DEBUG) << "no";
+
+      // for fiber meshes
+      using TargetFunctionSpaceType5 = ::FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>>;
+      LOG(DEBUG) << "mesh \"" << meshName << "\", test if " << StringUtility::demangle(typeid(TargetFunctionSpaceType5).name());
+
+      // if the mesh name corresponds to a 1D fiber mesh
+      if (this->context_.meshManager()->hasFunctionSpaceOfType<TargetFunctionSpaceType5>(meshName))
+      {
+        // get target function space
+        std::shared_ptr<TargetFunctionSpaceType5> functionSpaceTarget = this->context_.meshManager()->functionSpace<TargetFunctionSpaceType5>(meshName);
+
+        LOG(DEBUG) << "** create mapping " << functionSpaceSource->meshName() << " -> " << functionSpaceTarget->meshName();
+
+        // the geometry of fiber meshes is always interpolated in the 3D mesh
+        if (reverseMappingOrder)
+          initializeEmbeddedGeometry<TargetFunctionSpaceType5>(functionSpaceTarget);
+        else
+          LOG(ERROR) << "Mesh \"" << meshName << "\" in \"mapGeometryToMeshes\" is a 1D mesh, this needs \"reverseMappingOrder\": True.";
+      }
+      else LOG(DEBUG) << "no";
     }
+
+    // from now on, the geometry is updated by the stored embedded geometries
+    if (reverseMappingOrder)
+      embeddedGeometriesInitialized_ = true;
   }
 
   if (this->durationLogKey_ != "")
     Control::PerformanceMeasurement::stop(this->durationLogKey_+std::string("_map_geometry"));
 }
 
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+template<typename FunctionSpaceTargetType>
+void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+initializeEmbeddedGeometry(std::shared_ptr<FunctionSpaceTargetType> functionSpaceTarget)
+{
+  using SourceFunctionSpaceType = typename StaticHyperelasticitySolverType::DisplacementsFunctionSpace;
+
+  // the interpolation weights are only computed once, in the undeformed configuration
+  if (embeddedGeometriesInitialized_)
+    return;
+
+  // this also creates the mapping functionSpaceTarget -> functionSpaceSource
+  embeddedGeometries_.push_back(std::make_shared<MappingBetweenMeshes::EmbeddedGeometry<SourceFunctionSpaceType,FunctionSpaceTargetType>>(
+    data_.functionSpace(), functionSpaceTarget));
+}
+
 template<typename MeshType,typename Term,bool withLargeOutputFiles>
 void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
 mapGeometryToGivenMeshes()
@@ -377,7 +417,15 @@ mapGeometryToGivenMeshes()
     Control::PerformanceMeasurement::stop(this->durationLogKey_+std::string("_map_geometry"));
 
   LOG(DEBUG) << "mapGeometryToGivenMeshes: meshNamesOfGeometryToMapTo: " << meshNamesOfGeometryToMapTo_;
-  if (!meshNamesOfGeometryToMapTo_.empty())
+  if (embeddedGeometriesInitialized_)
+  {
+    // the meshes are embedded in the reference configuration of the own mesh, interpolate the geometry with the stored weights
+    for (std::shared_ptr<MappingBetweenMeshes::EmbeddedGeometryBase> embeddedGeometry : embeddedGeometries_)
+    {
+      embeddedGeometry->updateGeometry();
+    }
+  }
+  else if (!meshNamesOfGeometryToMapTo_.empty())
   {
     using SourceFunctionSpaceType = typename StaticHyperelasticitySolverType::DisplacementsFunctionSpace;
     using SourceFieldVariableType = FieldVariable::FieldVariable<SourceFunctionSpaceType,3>;
@@ -34,6 +34,9 @@ public:
   //! constructor
   DynamicHyperelasticitySolver(DihuContext context);
 
+  //! destructor
+  virtual ~DynamicHyperelasticitySolver();
+
   //! advance simulation by the given time span
   void advanceTimeSpan(bool withOutputWritersEnabled = true);
 
@@ -108,6 +111,7 @@ private:
   std::string totalForceLogFilename_;                             //< filename of the log file that will contain the total bearing forces at top and bottom elements
   bool isTractionInCurrentConfiguration_;                         //< if traction is given in current configuration, then it has to be transformed to reference configuration in every timestep
   bool isReferenceGeometryInitialized_;                           //< if the copy of the reference geometry in the hyperelasticitySolver_ has already been set in the first timestep
+  int checkpointingHandle_ = -1;                                  //< handle of the state registered in Control::Checkpointing, -1 if not registered
 };
 
 }  // namespace
@@ -5,6 +5,7 @@
 #include "spatial_discretization/finite_element_method/integrand/integrand_mass_matrix.h"
 #include "partition/partitioned_petsc_vec/02_partitioned_petsc_vec_for_hyperelasticity.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
+#include "control/checkpointing/checkpointing.h"
 #include "spatial_discretization/neumann_boundary_conditions/01_neumann_boundary_conditions.h"
 
 namespace TimeSteppingScheme
@@ -25,6 +26,13 @@ DynamicHyperelasticitySolver(DihuContext context) :
   isReferenceGeometryInitialized_ = false;
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType>
+DynamicHyperelasticitySolver<Term,withLargeOutput,MeshType>::
+~DynamicHyperelasticitySolver()
+{
+  Control::Checkpointing::unregisterState(checkpointingHandle_);
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType>
 void DynamicHyperelasticitySolver<Term,withLargeOutput,MeshType>::
 initialize()
@@ -32,6 +40,9 @@ initialize()
   LOG_SCOPE_FUNCTION;
   TimeSteppingScheme::initialize();
 
+  // the states that are registered for checkpointing get the path of the settings as key prefix
+  Control::Checkpointing::KeyScope checkpointingKeyScope(this->specificSettings_.getStringPath());
+
   // add this solver to the solvers diagram
   DihuContext::solverStructureVisualizer()->addSolver("DynamicHyperelasticitySolver");
 
@@ -149,6 +160,37 @@ initialize()
 
   totalForceLogFilename_ = this->specificSettings_.getOptionString("totalForceLogFilename", "");
 
+  // store u,v,p and the counters of the callback functions in checkpoints
+  if (Control::Checkpointing::enabled())
+  {
+    Control::Checkpointing::SaveFunction save = [this](std::vector<double> &values)
+    {
+      Control::Checkpointing::getLocalValues(uvp_->valuesGlobal(), values);
+      values.push_back(updateDirichletBoundaryConditionsFunctionCallCount_);
+      values.push_back(updateNeumannBoundaryConditionsFunctionCallCount_);
+      values.push_back(pythonTotalForceFunctionCallCount_);
+    };
+    std::string key = std::string("dynamicHyperelasticity/") + data_.functionSpace()->meshName() + "/uvp";
+    Control::Checkpointing::RestoreFunction restore = [this,key](const std::vector<double> &values)
+    {
+      if (values.size() < 3)
+      {
+        LOG(FATAL) << "Checkpoint contains " << values.size() << " values for \"" << key << "\", this is too few.";
+      }
+      std::vector<double> uvpValues(values.begin(), values.end()-3);
+      Control::Checkpointing::setLocalValues(uvp_->valuesGlobal(), uvpValues, key);
+      hyperelasticitySolver_.setDisplacementsVelocitiesAndPressureFromCombinedVec(uvp_->valuesGlobal(), this->data_.displacements(), this->data_.velocities());
+
+      updateDirichletBoundaryConditionsFunctionCallCount_ = int(values[values.size()-3]);
+      updateNeumannBoundaryConditionsFunctionCallCount_ = int(values[values.size()-2]);
+      pythonTotalForceFunctionCallCount_ = int(values[values.size()-1]);
+
+      // the restored geometry is deformed, the reference geometry is restored as field variable and must not be overwritten
+      isReferenceGeometryInitialized_ = true;
+    };
+    checkpointingHandle_ = Control::Checkpointing::registerState(key, save, restore);
+  }
+
   // write initial mesh but don't increment counter
   this->outputWriterManager_.writeOutput(this->data_, 0, 0.0, 0);
 
@@ -43,6 +43,9 @@ public:
   //! constructor
   HyperelasticityInitialize(DihuContext context, std::string settingsKey = "HyperelasticitySolver");
 
+  //! destructor
+  virtual ~HyperelasticityInitialize();
+
   //! initialize components of the simulation
   void initialize();
 
@@ -53,16 +56,22 @@ public:
   Data &data();
 
   //! copy entries of combined vector x to u and p, if both u and p are nullptr, use this->data_.displacements() and this->data_.pressure(), if only p is nullptr, only copy to u
-  void setDisplacementsAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsFieldVariableType> u = nullptr, std::shared_ptr<PressureFieldVariableType> p = nullptr);
+  //! @param overlapGhostCommunication if the communication of the ghost values is only started, see setUVP
+  void setDisplacementsAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsFieldVariableType> u = nullptr, std::shared_ptr<PressureFieldVariableType> p = nullptr,
+                                                  bool overlapGhostCommunication = false);
 
   //! copy entries of combined vector x to u, v and p, if all u,v and p are nullptr, use this->data_.displacements(), this->data_.velocities() and this->data_.pressure(), if only p is nullptr, only copy to u
+  //! @param overlapGhostCommunication if the communication of the ghost values is only started, see setUVP
   void setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsFieldVariableType> u = nullptr,
                                                             std::shared_ptr<DisplacementsFieldVariableType> v = nullptr,
-                                                            std::shared_ptr<PressureFieldVariableType> p = nullptr);
+                                                            std::shared_ptr<PressureFieldVariableType> p = nullptr,
+                                                            bool overlapGhostCommunication = false);
 
   //! copy the values of the vector x which contains (u and p) or (u,v and p) values to this->data_.displacements(), this->data_.velocities() and this->data_.pressure();
   //! This simply calls setDisplacementsAndPressureFromCombinedVec or setDisplacementsVelocitiesAndPressureFromCombinedVec depending on static or dynamic problem.
-  void setUVP(Vec x);
+  //! If overlapGhostCommunication is true, the communication of the ghost values is only started and the ghost values are not yet valid. Then, the assembly of the residual
+  //! and the jacobian integrates the interior elements while the communication is in progress and calls completeGhostCommunication() before the boundary elements.
+  void setUVP(Vec x, bool overlapGhostCommunication = false);
 
   //! copy the entries in the combined solution vector to this->data_.displacements() and this->data_.pressure()
   void setSolutionVector();
@@ -141,6 +150,12 @@ protected:
   //! compute δW_ext,dead = int_Ω B^L * phi^L * phi^M * δu^M dx + int_∂Ω T^L * phi^L * phi^M * δu^M dS
   virtual void materialComputeExternalVirtualWorkDead() = 0;
 
+  //! set elementNosLocalAssemblyOrder_, the interior elements of the displacements and pressure function spaces come first, then the boundary elements
+  void initializeAssemblyElementOrder();
+
+  //! complete the communication of the ghost values of u, v and p that was started by setUVP(x, true), does nothing if there is no communication in progress
+  void completeGhostCommunication();
+
   DihuContext context_;                                     //< object that contains the python config for the current context and the global singletons meshManager and solverManager
 
   OutputWriter::Manager outputWriterManager_;               //< manager object holding all output writer for displacements based variables
@@ -195,6 +210,10 @@ protected:
   bool lastSolveSucceeded_;                                 //< if the last computation of the residual or jacobian succeeded, if this is false, it indicates that there was a negative jacobian
   double loadFactorGiveUpThreshold_;                        //< a threshold for the load factor, if it is below, the solve is aborted
   unsigned int nNonZerosJacobian_;                          //< number of nonzero entries in the material jacobian on the local domain, used for preallocation of the matrix
+  int checkpointingHandle_ = -1;                            //< handle of the solution vector registered in Control::Checkpointing, -1 if not registered
+  std::vector<element_no_t> elementNosLocalAssemblyOrder_;  //< the local elements in the order of the assembly loops, first the interior elements, padded with -1 to full batches of nVcComponents, then the boundary elements
+  int nElementsInteriorAssemblyOrder_ = 0;                  //< number of entries of elementNosLocalAssemblyOrder_ that belong to batches of interior elements, a multiple of nVcComponents
+  bool ghostCommunicationInProgress_ = false;               //< if the communication of the ghost values of u, v and p was started by setUVP(x, true) and is not yet completed
 
   std::vector<double> loadFactors_;                         //< vector of load factors, 1.0 means normal computation, any lower value reduces the right hand side (scales body and traction forces)
   std::vector<double> norms_;                               //< vector that collects the norms in every iteration, it will be cleared for every new load factor
@@ -8,6 +8,7 @@
 #include "data_management/specialized_solver/multidomain.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
+#include "control/checkpointing/checkpointing.h"
 #include "partition/mesh_partition/01_mesh_partition_structured.h"
 #include "specialized_solver/solid_mechanics/hyperelasticity/02_petsc_callbacks.h"
 
@@ -97,6 +98,9 @@ initialize()
     << ", term " << StringUtility::demangle(typeid(Term).name());
   assert(this->specificSettings_.pyObject());
 
+  // the states that are registered for checkpointing get the path of the settings as key prefix
+  Control::Checkpointing::KeyScope checkpointingKeyScope(this->specificSettings_.getStringPath());
+
   // create function space / mesh, the geometry is from the settings
   displacementsFunctionSpace_ = context_.meshManager()->functionSpace<DisplacementsFunctionSpace>(specificSettings_);
 
@@ -109,6 +113,7 @@ initialize()
   data_.setPressureFunctionSpace(pressureFunctionSpace_);
 
   data_.initialize();
+  initializeAssemblyElementOrder();
   pressureDataCopy_.initialize(data_.pressure(), data_.displacementsLinearMesh(), data_.velocitiesLinearMesh());
   pressureDataCopy_.setFunctionSpace(pressureFunctionSpace_);
 
@@ -163,10 +168,33 @@ initialize()
   // set the slotConnectorData for the solverStructureVisualizer to appear in the solver diagram
   DihuContext::solverStructureVisualizer()->setSlotConnectorData(getSlotConnectorData());
 
+  // store the solution vector in checkpoints, it is the initial guess of the next nonlinear solve
+  if (Control::Checkpointing::enabled())
+  {
+    Control::Checkpointing::SaveFunction save = [this](std::vector<double> &values)
+    {
+      Control::Checkpointing::getLocalValues(solverVariableSolution_, values);
+    };
+    std::string key = std::string("hyperelasticity/") + displacementsFunctionSpace_->meshName() + "/uvp";
+    Control::Checkpointing::RestoreFunction restore = [this,key](const std::vector<double> &values)
+    {
+      Control::Checkpointing::setLocalValues(solverVariableSolution_, values, key);
+      setUVP(solverVariableSolution_);
+    };
+    checkpointingHandle_ = Control::Checkpointing::registerState(key, save, restore);
+  }
+
   LOG(DEBUG) << "initialization done";
   this->initialized_ = true;
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+~HyperelasticityInitialize()
+{
+  Control::Checkpointing::unregisterState(checkpointingHandle_);
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 initializeFiberDirections()
@@ -669,7 +697,7 @@ initializeSolutionVariable()
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 setDisplacementsAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsFieldVariableType> u,
-                                           std::shared_ptr<PressureFieldVariableType> p)
+                                           std::shared_ptr<PressureFieldVariableType> p, bool overlapGhostCommunication)
 {
   assert(nDisplacementComponents == 3);
 
@@ -695,6 +723,12 @@ setDisplacementsAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsF
     VecSwap(x, solverVariableSolution_);
   }
 
+  // the communication can only be overlapped for the field variables of the data object, because completeGhostCommunication() completes it for them
+  assert(!overlapGhostCommunication || (!u && !p));
+
+  // complete a previous communication, before the values are changed
+  completeGhostCommunication();
+
   if (!u && !p)
   {
     u = this->data_.displacements();
@@ -717,7 +751,10 @@ setDisplacementsAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsF
     u->setValues(componentNo, nEntries, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(), values.data());
   }
   u->finishGhostManipulation();
-  u->startGhostManipulation();
+  if (overlapGhostCommunication)
+    u->startGhostManipulationBegin();     // the communication is completed by completeGhostCommunication()
+  else
+    u->startGhostManipulation();
 
   // set pressure entries
   if (p)
@@ -729,9 +766,14 @@ setDisplacementsAndPressureFromCombinedVec(Vec x, std::shared_ptr<DisplacementsF
     combinedVecSolution_->getValues(pressureComponent, nEntries, pressureFunctionSpace_->meshPartition()->dofNosLocal().data(), values.data());
     p->setValues(0, nEntries, pressureFunctionSpace_->meshPartition()->dofNosLocal().data(), values.data());
     p->finishGhostManipulation();
-    p->startGhostManipulation();
+    if (overlapGhostCommunication)
+      p->startGhostManipulationBegin();     // the communication is completed by completeGhostCommunication()
+    else
+      p->startGhostManipulation();
   }
 
+  ghostCommunicationInProgress_ = overlapGhostCommunication;
+
   // undo the backup operation
   if (backupVecs)
   {
@@ -747,7 +789,8 @@ void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementCompon
 setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x,
                                                      std::shared_ptr<DisplacementsFieldVariableType> u,
                                                      std::shared_ptr<DisplacementsFieldVariableType> v,
-                                                     std::shared_ptr<PressureFieldVariableType> p)
+                                                     std::shared_ptr<PressureFieldVariableType> p,
+                                                     bool overlapGhostCommunication)
 {
   assert(nDisplacementComponents == 6);
 
@@ -773,6 +816,12 @@ setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x,
     VecSwap(x, solverVariableSolution_);
   }
 
+  // the communication can only be overlapped for the field variables of the data object, because completeGhostCommunication() completes it for them
+  assert(!overlapGhostCommunication || (!u && !v && !p));
+
+  // complete a previous communication, before the values are changed
+  completeGhostCommunication();
+
   if (!u && !v && !p)
   {
     u = this->data_.displacements();
@@ -796,7 +845,10 @@ setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x,
     u->setValues(componentNo, nEntries, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(), values.data());
   }
   u->finishGhostManipulation();
-  u->startGhostManipulation();
+  if (overlapGhostCommunication)
+    u->startGhostManipulationBegin();     // the communication is completed by completeGhostCommunication()
+  else
+    u->startGhostManipulation();
 
   // set velocity entries
   if (v)
@@ -814,7 +866,10 @@ setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x,
       v->setValues(componentNo, nEntries, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(), values.data());
     }
     v->finishGhostManipulation();
-    v->startGhostManipulation();
+    if (overlapGhostCommunication)
+      v->startGhostManipulationBegin();     // the communication is completed by completeGhostCommunication()
+    else
+      v->startGhostManipulation();
   }
   // set pressure entries
   if (p)
@@ -831,9 +886,14 @@ setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x,
 
     p->setValues(0, nEntries, pressureFunctionSpace_->meshPartition()->dofNosLocal().data(), values.data());
     p->finishGhostManipulation();
-    p->startGhostManipulation();
+    if (overlapGhostCommunication)
+      p->startGhostManipulationBegin();     // the communication is completed by completeGhostCommunication()
+    else
+      p->startGhostManipulation();
   }
 
+  ghostCommunicationInProgress_ = overlapGhostCommunication;
+
   // undo the backup operation
   if (backupVecs)
   {
@@ -846,18 +906,71 @@ setDisplacementsVelocitiesAndPressureFromCombinedVec(Vec x,
 
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
-setUVP(Vec x)
+setUVP(Vec x, bool overlapGhostCommunication)
 {
   if (nDisplacementComponents == 3)
   {
-    setDisplacementsAndPressureFromCombinedVec(x);
+    setDisplacementsAndPressureFromCombinedVec(x, nullptr, nullptr, overlapGhostCommunication);
   }
   else if (nDisplacementComponents == 6)
   {
-    setDisplacementsVelocitiesAndPressureFromCombinedVec(x);
+    setDisplacementsVelocitiesAndPressureFromCombinedVec(x, nullptr, nullptr, nullptr, overlapGhostCommunication);
   }
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+completeGhostCommunication()
+{
+  if (!ghostCommunicationInProgress_)
+    return;
+
+  this->data_.displacements()->startGhostManipulationEnd();
+  if (nDisplacementComponents == 6)
+    this->data_.velocities()->startGhostManipulationEnd();
+  if (Term::isIncompressible)
+    this->data_.pressure()->startGhostManipulationEnd();
+
+  ghostCommunicationInProgress_ = false;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+initializeAssemblyElementOrder()
+{
+  // an element is interior if it has no ghost dofs in the displacements and in the pressure function space,
+  // then the integrals over the element do not need the ghost values of u, v and p
+  const element_no_t nElementsLocal = displacementsFunctionSpace_->nElementsLocal();
+  std::vector<bool> isInterior(nElementsLocal, false);
+  for (element_no_t elementNoLocal : displacementsFunctionSpace_->elementNosLocalInterior())
+    isInterior[elementNoLocal] = true;
+
+  std::vector<bool> isInteriorPressure(nElementsLocal, false);
+  for (element_no_t elementNoLocal : pressureFunctionSpace_->elementNosLocalInterior())
+    isInteriorPressure[elementNoLocal] = true;
+
+  elementNosLocalAssemblyOrder_.clear();
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    if (isInterior[elementNoLocal] && isInteriorPressure[elementNoLocal])
+      elementNosLocalAssemblyOrder_.push_back(elementNoLocal);
+  }
+
+  // the vectorized loops handle nVcComponents elements at once, no batch contains interior and boundary elements
+  while (elementNosLocalAssemblyOrder_.size() % nVcComponents != 0)
+    elementNosLocalAssemblyOrder_.push_back(-1);
+  nElementsInteriorAssemblyOrder_ = elementNosLocalAssemblyOrder_.size();
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    if (!isInterior[elementNoLocal] || !isInteriorPressure[elementNoLocal])
+      elementNosLocalAssemblyOrder_.push_back(elementNoLocal);
+  }
+
+  VLOG(1) << "assembly order of the elements: " << nElementsInteriorAssemblyOrder_ << " entries for interior elements, "
+    << elementNosLocalAssemblyOrder_.size() - nElementsInteriorAssemblyOrder_ << " boundary elements";
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 dumpJacobianMatrix(Mat jac)
@@ -4,6 +4,8 @@
 
 #include "specialized_solver/solid_mechanics/hyperelasticity/expression_helper.h"
 #include "specialized_solver/solid_mechanics/hyperelasticity/00_initialize.h"
+#include "function_space/geometric_factors_cache.h"
+#include "quadrature/gauss.h"
 
 namespace SpatialDiscretization
 {
@@ -71,6 +73,7 @@ public:
 protected:
 
   typedef HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents> Parent;
+  typedef FunctionSpace::GeometricFactorsCache<DisplacementsFunctionSpace,Quadrature::TensorProduct<3,Quadrature::Gauss<3>>> ReferenceGeometricFactorsCacheType;
 
   //! compute δW_int, input is in this->data_.displacements() and this->data_.pressure(), output is in solverVariableResidual_
   //! @param communicateGhosts if startGhostManipulation() and finishGhostManipulation() will be called on combinedVecResidual_ inside this method, if set to false, you have to do it manually before and after this method
@@ -163,6 +166,8 @@ protected:
   //! compute the PK2 stress at every node, update the geometry field by the new displacements, dump files containing rhs and system matrix
   virtual void postprocessSolution() = 0;
 
+  ReferenceGeometricFactorsCacheType referenceGeometricFactors_;   //< the inverse jacobians of the reference configuration at the sampling points, these do not have to be recomputed in every evaluation of the residual and the jacobian
+
   // use variables from the base class, this avoids writing "this->" in front of those members
   using Parent::displacementsFunctionSpace_;          //< the function space with quadratic Lagrange basis functions, used for discretization of displacements
   using Parent::pressureFunctionSpace_;               //< the function space with linear Lagrange basis functions, used for discretization of pressure
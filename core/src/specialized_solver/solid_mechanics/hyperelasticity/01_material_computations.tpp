@@ -47,7 +47,6 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
   const int D = 3;  // dimension
   const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
   const int nPressureDofsPerElement = PressureFunctionSpace::nDofsPerElement();
-  const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
   const int nUnknowsPerElement = nDisplacementsDofsPerElement*D;    // D directions for displacements per dof
 
   // define shortcuts for quadrature
@@ -63,6 +62,10 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
   // setup arrays used for integration
   std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
 
+  // tables of the basis functions at the sampling points
+  typedef FunctionSpace::BasisOnQuadrature<DisplacementsFunctionSpace,QuadratureDD> DisplacementsBasisOnQuadrature;
+  typedef FunctionSpace::BasisOnQuadrature<PressureFunctionSpace,QuadratureDD> PressureBasisOnQuadrature;
+
   // set values to zero
   if (communicateGhosts)
   {
@@ -82,20 +85,28 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
     combinedVecSolution_->dumpGlobalNatural(filename.str());
   }
 
-  // loop over elements, always 4 elements at once using the vectorized functions
-  for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
+  // loop over elements, always 4 elements at once using the vectorized functions.
+  // The interior elements come first, they do not need the ghost values of u, v and p, which may still be communicated (see setUVP)
+  const std::vector<element_no_t> &elementNosLocal = this->elementNosLocalAssemblyOrder_;
+  const int nElementsAssemblyOrder = elementNosLocal.size();
+  for (int elementIndex = 0; elementIndex < nElementsAssemblyOrder; elementIndex += nVcComponents)
   {
+    // the boundary elements need the ghost values
+    if (elementIndex == this->nElementsInteriorAssemblyOrder_)
+      this->completeGhostCommunication();
+
+    // the first element of the current batch, the padding entries -1 are only at the end of a batch
+    const element_no_t elementNoLocal = elementNosLocal[elementIndex];
 
 #ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
     // get indices of elementNos that should be handled in the current iterations,
     // this is, e.g.
-    //    [10,11,12,13,-1,-1,-1,-1] (if nVcComponents==4 and nElementsLocal > 13)
-    // or [10,11,12,-1,-1,-1,-1,-1] (if nVcComponents==4 and nElementsLocal == 13)
+    //    [10,11,12,13,-1,-1,-1,-1] (if nVcComponents==4 and there are more elements)
+    // or [10,11,12,-1,-1,-1,-1,-1] (if nVcComponents==4 and 12 is the last interior element or the last element)
 
-
-    dof_no_v_t elementNoLocalv([elementNoLocal, nElementsLocal](int i)
+    dof_no_v_t elementNoLocalv([&elementNosLocal, elementIndex, nElementsAssemblyOrder](int i)
     {
-      return (i >= nVcComponents || elementNoLocal+i >= nElementsLocal? -1: elementNoLocal+i);
+      return (i >= nVcComponents || elementIndex+i >= nElementsAssemblyOrder? -1: elementNosLocal[elementIndex+i]);
     });
 
     // here, elementNoLocalv is the list of indices of the current iteration, e.g. [10,11,12,13,-1,-1,-1,-1]
@@ -107,7 +118,11 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
     // get geometry field of reference configuration
     std::array<Vec3_v_t,nDisplacementsDofsPerElement> geometryReferenceValues;
     this->data_.geometryReference()->getElementValues(elementNoLocalv, geometryReferenceValues);
-    double_v_t approximateMeshWidth = MathUtility::computeApproximateMeshWidth<double_v_t,nDisplacementsDofsPerElement>(geometryReferenceValues);
+
+    // get the inverse jacobians of the reference configuration at the sampling points, they are only recomputed if the reference geometry changed
+    const typename ReferenceGeometricFactorsCacheType::ElementFactors &referenceGeometricFactors
+      = referenceGeometricFactors_.get(elementIndex, geometryReferenceValues);
+    double_v_t approximateMeshWidth = referenceGeometricFactors.approximateMeshWidth;
 
     // get displacements field values for element
     std::array<Vec3_v_t,nDisplacementsDofsPerElement> displacementsValues;
@@ -139,10 +154,9 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
       // get parameter values of current sampling point
       Vec3 xi = samplingPoints[samplingPointIndex];
 
-      // compute the 3x3 jacobian of the parameter space to world space mapping
-      Tensor2_v_t<D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
-      double_v_t jacobianDeterminant;
-      Tensor2_v_t<D> inverseJacobianMaterial = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+      // get the inverse of the 3x3 jacobian of the parameter space to world space mapping and its determinant
+      const Tensor2_v_t<D> &inverseJacobianMaterial = referenceGeometricFactors.inverseJacobian[samplingPointIndex];
+      const double_v_t jacobianDeterminant = referenceGeometricFactors.jacobianDeterminant[samplingPointIndex];
 
       // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
       // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
@@ -220,7 +234,7 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
         fictitiousPK2Stress, pk2StressIsochoric
       );
 
-      std::array<Vec3,nDisplacementsDofsPerElement> gradPhi = displacementsFunctionSpace->getGradPhi(xi);
+      const std::array<Vec3,nDisplacementsDofsPerElement> &gradPhi = DisplacementsBasisOnQuadrature::gradPhi()[samplingPointIndex];
       // (column-major storage) gradPhi[L][a] = dphi_L / dxi_a
       // gradPhi[column][row] = gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i, columnIdx = dofIndex, rowIdx = which direction
 
@@ -232,7 +246,6 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
         VLOG(2) << "element local " << elementNoLocal << " (" << elementNoLocalv << ") global " << elementNoGlobal << " xi: " << xi;
         VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
         VLOG(2) << "  displacementsValues: " << displacementsValues;
-        VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
         VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
         VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
         VLOG(2) << "  deformationGradient: F=" << deformationGradient;
@@ -330,7 +343,7 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
         // loop over basis functions and evaluate integrand at xi for pressure part ((J-1)*psi)
         for (int dofIndex = 0; dofIndex < nPressureDofsPerElement; dofIndex++)           // index over dofs in element, L in derivation
         {
-          const double phiL = pressureFunctionSpace->phi(dofIndex, xi);
+          const double phiL = PressureBasisOnQuadrature::phi()[samplingPointIndex][dofIndex];
           const double_v_t integrand = (deformationGradientDeterminant - 1.0) * phiL;     // (J-1) * phi_L
 
           // store integrand in evaluations array
@@ -404,6 +417,9 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
     }  // elementNoLocal
   }
 
+  // complete the communication if there were no boundary elements
+  this->completeGhostCommunication();
+
   // assemble result vector
   if (communicateGhosts)
   {
@@ -606,6 +622,9 @@ materialComputeExternalVirtualWorkDead()
     // setup arrays used for integration
     std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
 
+    // table of the basis functions at the sampling points
+    typedef FunctionSpace::BasisOnQuadrature<DisplacementsFunctionSpace,QuadratureDD> DisplacementsBasisOnQuadrature;
+
     // initialize variables
     functionSpace->geometryField().setRepresentationGlobal();
     functionSpace->geometryField().startGhostManipulation();   // ensure that local ghost values of geometry field are set
@@ -624,13 +643,13 @@ materialComputeExternalVirtualWorkDead()
       // evaluate integrand at sampling points
       for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
       {
-        // evaluate function to integrate at samplingPoints[i*2], write value to evaluations[i]
-        std::array<double,D> xi = samplingPoints[samplingPointIndex];
-
         // compute the 3xD jacobian of the parameter space to world space mapping
-        auto jacobian = DisplacementsFunctionSpace::computeJacobian(geometry, xi);
+        auto jacobian = DisplacementsBasisOnQuadrature::computeJacobian(geometry, samplingPointIndex);
         double integrationFactor = MathUtility::computeIntegrationFactor(jacobian);
 
+        // values of the basis functions at xi
+        const std::array<double,nDofsPerElement> &phi = DisplacementsBasisOnQuadrature::phi()[samplingPointIndex];
+
         for (unsigned int elementalDofNoM = 0; elementalDofNoM < nDofsPerElement; elementalDofNoM++)   // dof index M
         {
           for (int dimensionNo = 0; dimensionNo < 3; dimensionNo++)
@@ -639,8 +658,7 @@ materialComputeExternalVirtualWorkDead()
 
             for (unsigned int elementalDofNoL = 0; elementalDofNoL < nDofsPerElement; elementalDofNoL++)   // dof index L
             {
-              integrand += DisplacementsFunctionSpace::phi(elementalDofNoL,xi) * DisplacementsFunctionSpace::phi(elementalDofNoM,xi)
-                * this->constantBodyForce_[dimensionNo];
+              integrand += phi[elementalDofNoL] * phi[elementalDofNoM] * this->constantBodyForce_[dimensionNo];
             }
 
             evaluationsArray[samplingPointIndex][elementalDofNoM*3 + dimensionNo] = integrand * integrationFactor;
@@ -715,6 +733,9 @@ materialAddAccelerationTermAndVelocityEquation(bool communicateGhosts)
   // setup arrays used for integration
   std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
 
+  // table of the basis functions at the sampling points
+  typedef FunctionSpace::BasisOnQuadrature<DisplacementsFunctionSpace,QuadratureDD> DisplacementsBasisOnQuadrature;
+
   const int nElementsLocal = functionSpace->nElementsLocal();
 
   // loop over elements, always 4 elements at once using the vectorized functions
@@ -803,13 +824,13 @@ materialAddAccelerationTermAndVelocityEquation(bool communicateGhosts)
     // evaluate integrand at sampling points
     for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
     {
-      // evaluate function to integrate at samplingPoints[i*2], write value to evaluations[i]
-      std::array<double,D> xi = samplingPoints[samplingPointIndex];
-
       // compute the 3xD jacobian of the parameter space to world space mapping
-      auto jacobian = DisplacementsFunctionSpace::computeJacobian(geometry, xi);
+      auto jacobian = DisplacementsBasisOnQuadrature::computeJacobian(geometry, samplingPointIndex);
       double_v_t integrationFactor = MathUtility::computeIntegrationFactor(jacobian);
 
+      // values of the basis functions at xi
+      const std::array<double,nDofsPerElement> &phi = DisplacementsBasisOnQuadrature::phi()[samplingPointIndex];
+
       // loop over elemantal dofs, M
       for (unsigned int elementalDofNoM = 0; elementalDofNoM < nDofsPerElement; elementalDofNoM++)   // dof index M
       {
@@ -824,14 +845,12 @@ materialAddAccelerationTermAndVelocityEquation(bool communicateGhosts)
             const double_v_t oldVelocity = oldVelocityValues[elementalDofNoL][dimensionNo];
             const double_v_t newVelocity = newVelocityValues[elementalDofNoL][dimensionNo];
 
-            integrand += this->density_ * (newVelocity - oldVelocity) / this->timeStepWidth_ * DisplacementsFunctionSpace::phi(elementalDofNoL,xi)
-              * DisplacementsFunctionSpace::phi(elementalDofNoM,xi);
+            integrand += this->density_ * (newVelocity - oldVelocity) / this->timeStepWidth_ * phi[elementalDofNoL] * phi[elementalDofNoM];
 
             // add damping factor if enabled: d*v*phi_L*phi_M
             if (this->dampingFactor_ != 0)
             {
-              integrand += this->dampingFactor_ * oldVelocity * DisplacementsFunctionSpace::phi(elementalDofNoL,xi)
-                * DisplacementsFunctionSpace::phi(elementalDofNoM,xi);
+              integrand += this->dampingFactor_ * oldVelocity * phi[elementalDofNoL] * phi[elementalDofNoM];
             }
 
             evaluationsArray[samplingPointIndex][elementalDofNoM*3 + dimensionNo] = integrand * integrationFactor;
@@ -948,6 +967,10 @@ materialComputeJacobian()
   // setup arrays used for integration
   std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
 
+  // tables of the basis functions at the sampling points
+  typedef FunctionSpace::BasisOnQuadrature<DisplacementsFunctionSpace,QuadratureDD> DisplacementsBasisOnQuadrature;
+  typedef FunctionSpace::BasisOnQuadrature<PressureFunctionSpace,QuadratureDD> PressureBasisOnQuadrature;
+
   // loop over elements, always 4 elements at once using the vectorized functions
   for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
   {
@@ -1071,19 +1094,28 @@ materialComputeJacobian()
   // allow switching between stiffnessMatrix->setValue(... INSERT_VALUES) and ADD_VALUES
   combinedMatrixJacobian_->assembly(MAT_FLUSH_ASSEMBLY);
 
-  // loop over elements, always 4 elements at once using the vectorized functions
-  for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
+  // loop over elements, always 4 elements at once using the vectorized functions.
+  // The interior elements come first, they do not need the ghost values of u, v and p, which may still be communicated (see setUVP)
+  const std::vector<element_no_t> &elementNosLocal = this->elementNosLocalAssemblyOrder_;
+  const int nElementsAssemblyOrder = elementNosLocal.size();
+  for (int elementIndex = 0; elementIndex < nElementsAssemblyOrder; elementIndex += nVcComponents)
   {
+    // the boundary elements need the ghost values
+    if (elementIndex == this->nElementsInteriorAssemblyOrder_)
+      this->completeGhostCommunication();
+
+    // the first element of the current batch, the padding entries -1 are only at the end of a batch
+    const element_no_t elementNoLocal = elementNosLocal[elementIndex];
 
 #ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
     // get indices of elementNos that should be handled in the current iterations,
     // this is, e.g.
-    //    [10,11,12,13,-1,-1,-1,-1] (if nVcComponents==4 and nElementsLocal > 13)
-    // or [10,11,12,-1,-1,-1,-1,-1] (if nVcComponents==4 and nElementsLocal == 13)
+    //    [10,11,12,13,-1,-1,-1,-1] (if nVcComponents==4 and there are more elements)
+    // or [10,11,12,-1,-1,-1,-1,-1] (if nVcComponents==4 and 12 is the last interior element or the last element)
 
-    dof_no_v_t elementNoLocalv([elementNoLocal, nElementsLocal](dof_no_t i)
+    dof_no_v_t elementNoLocalv([&elementNosLocal, elementIndex, nElementsAssemblyOrder](dof_no_t i)
     {
-      return (i >= nVcComponents || elementNoLocal+i >= nElementsLocal? -1: elementNoLocal+i);
+      return (i >= nVcComponents || elementIndex+i >= nElementsAssemblyOrder? -1: elementNosLocal[elementIndex+i]);
     });
 
     // here, elementNoLocalv is the list of indices of the current iteration, e.g. [10,11,12,13,-1,-1,-1,-1]
@@ -1095,7 +1127,11 @@ materialComputeJacobian()
     // get geometry field of reference configuration
     std::array<Vec3_v_t,nDisplacementsDofsPerElement> geometryReferenceValues;
     this->data_.geometryReference()->getElementValues(elementNoLocalv, geometryReferenceValues);
-    double_v_t approximateMeshWidth = MathUtility::computeApproximateMeshWidth<double_v_t,nDisplacementsDofsPerElement>(geometryReferenceValues);
+
+    // get the inverse jacobians of the reference configuration at the sampling points, they are only recomputed if the reference geometry changed
+    const typename ReferenceGeometricFactorsCacheType::ElementFactors &referenceGeometricFactors
+      = referenceGeometricFactors_.get(elementIndex, geometryReferenceValues);
+    double_v_t approximateMeshWidth = referenceGeometricFactors.approximateMeshWidth;
 
     // get displacements field values for element
     std::array<Vec3_v_t,nDisplacementsDofsPerElement> displacementsValues;
@@ -1116,10 +1152,9 @@ materialComputeJacobian()
       // get parameter values of current sampling point
       Vec3 xi = samplingPoints[samplingPointIndex];
 
-      // compute the 3x3 jacobian of the parameter space to world space mapping
-      Tensor2_v_t<D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
-      double_v_t jacobianDeterminant;
-      Tensor2_v_t<D> inverseJacobianMaterial = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+      // get the inverse of the 3x3 jacobian of the parameter space to world space mapping and its determinant
+      const Tensor2_v_t<D> &inverseJacobianMaterial = referenceGeometricFactors.inverseJacobian[samplingPointIndex];
+      const double_v_t jacobianDeterminant = referenceGeometricFactors.jacobianDeterminant[samplingPointIndex];
 
       // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
       // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
@@ -1178,7 +1213,7 @@ materialComputeJacobian()
                                                         deformationGradientDeterminant, fiberDirection, elementNoLocalv,
                                                         fictitiousPK2Stress, pk2StressIsochoric);
 
-      std::array<Vec3,nDisplacementsDofsPerElement> gradPhi = displacementsFunctionSpace->getGradPhi(xi);
+      const std::array<Vec3,nDisplacementsDofsPerElement> &gradPhi = DisplacementsBasisOnQuadrature::gradPhi()[samplingPointIndex];
       // (column-major storage) gradPhi[L][a] = dphi_L / dxi_a
       // gradPhi[column][row] = gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i, columnIdx = dofIndex, rowIdx = which direction
 
@@ -1196,7 +1231,6 @@ materialComputeJacobian()
       VLOG(2) << "element " << elementNoLocal << " xi: " << xi;
       VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
       VLOG(2) << "  displacementsValues: " << displacementsValues;
-      VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
       VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
       VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
       VLOG(2) << "  deformationGradient: F=" << deformationGradient;
@@ -1345,7 +1379,7 @@ materialComputeJacobian()
 
               // compute integrand J * psi_L * (F^-1)_Ba * phi_Ma,B
 
-              const double_v_t psiL = pressureFunctionSpace->phi(lDof,xi);
+              const double_v_t psiL = PressureBasisOnQuadrature::phi()[samplingPointIndex][lDof];
               const double_v_t integrand = deformationGradientDeterminant * psiL * fInv_Ba_dphiM_dXB;
 
               // compute index of degree of freedom and component (result vector index)
@@ -1369,7 +1403,8 @@ materialComputeJacobian()
           for (int mDof = 0; mDof < nDisplacementsDofsPerElement; mDof++)  // index over dofs, each dof has D components, M in derivation
           {
             // integrate ∫_Ω ρ0 ϕ^L ϕ^M dV, the actual needed value is 1/dt δ_ab ∫_Ω ρ0 ϕ^L ϕ^M dV, but this will be computed later
-            const double integrand = this->density_ * displacementsFunctionSpace->phi(lDof, xi) * displacementsFunctionSpace->phi(mDof, xi);
+            const double integrand = this->density_ * DisplacementsBasisOnQuadrature::phi()[samplingPointIndex][lDof]
+              * DisplacementsBasisOnQuadrature::phi()[samplingPointIndex][mDof];
 
             // compute index of degree of freedom and component (result vector index)
             const int index = lDof*nDisplacementsDofsPerElement + mDof;
@@ -1515,6 +1550,9 @@ materialComputeJacobian()
     }
   }  // local elements
 
+  // complete the communication if there were no boundary elements
+  this->completeGhostCommunication();
+
   combinedMatrixJacobian_->assembly(MAT_FINAL_ASSEMBLY);
 
   if (!this->lastSolveSucceeded_)
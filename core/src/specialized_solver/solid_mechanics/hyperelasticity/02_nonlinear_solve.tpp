@@ -528,7 +528,8 @@ evaluateNonlinearFunction(Vec x, Vec f)
   }
 
   // set the solverVariableSolution_ values in displacements, velocities and pressure, this is needed for materialComputeResidual
-  this->setUVP(solverVariableSolution_);
+  // the communication of the ghost values is overlapped with the integration over the interior elements
+  this->setUVP(solverVariableSolution_, true);
 
   // compute the actual output of the nonlinear function
   bool successful = this->materialComputeResidual(currentLoadFactor_);
@@ -555,8 +556,8 @@ template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementC
 bool HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 evaluateAnalyticJacobian(Vec x, Mat jac)
 {
-  // copy the values of x to the internal data vectors in this->data_
-  this->setUVP(x);
+  // copy the values of x to the internal data vectors in this->data_, the communication of the ghost values is overlapped with the interior elements
+  this->setUVP(x, true);
 
   // compute the jacobian
   return this->materialComputeJacobian();
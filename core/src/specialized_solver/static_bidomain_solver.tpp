@@ -6,6 +6,7 @@
 #include "utility/petsc_utility.h"
 #include "data_management/specialized_solver/multidomain.h"
 #include "control/diagnostic_tool/performance_measurement.h"
+#include "solver/geometric_multigrid.h"
 
 namespace TimeSteppingScheme
 {
@@ -203,6 +204,12 @@ initialize()
   MatSetNearNullSpace(systemMatrix, constantFunctions); // for multigrid methods
   MatNullSpaceDestroy(&constantFunctions);
 
+  // set up the mesh hierarchy for the geometric multigrid preconditioner
+  if (this->linearSolver_->isGeometricMultigrid())
+  {
+    Solver::GeometricMultigrid<FunctionSpace>::setup(this->linearSolver_, finiteElementMethodDiffusionExtracellular_.functionSpace(), 1);
+  }
+
   // set the slotConnectorData for the solverStructureVisualizer to appear in the solver diagram
   DihuContext::solverStructureVisualizer()->setSlotConnectorData(getSlotConnectorData());
 
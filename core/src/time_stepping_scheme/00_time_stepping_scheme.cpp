@@ -1,12 +1,13 @@
 #include "time_stepping_scheme/00_time_stepping_scheme.h"
 
 #include "utility/python_utility.h"
+#include "control/checkpointing/checkpointing.h"
 
 namespace TimeSteppingScheme
 {
 
 TimeSteppingScheme::TimeSteppingScheme(DihuContext context) :
-  Splittable(), context_(context), specificSettings_(NULL), initialized_(false)
+  Splittable(), context_(context), specificSettings_(NULL), initialized_(false), isOutermostSolver_(false)
 {
   // specificSettings_ needs to be set by deriving class, in time_stepping_scheme_ode.tpp
   isTimeStepWidthSignificant_ = false;
@@ -67,6 +68,43 @@ void TimeSteppingScheme::setTimeSpan(double startTime, double endTime)
   }
 }
 
+void TimeSteppingScheme::restartAtTime(double startTime)
+{
+  startTime_ = startTime;
+
+  // if the checkpoint was written at the end of the simulation, there is nothing left to compute
+  if (startTime_ >= endTime_ - 1e-10*timeStepWidth_)
+  {
+    LOG(DEBUG) << "restart at t=" << startTime << ", end time " << endTime_ << " is already reached";
+    numberTimeSteps_ = 0;
+    return;
+  }
+
+  // recompute the number of time steps in the remaining time span with the previous time step width
+  setTimeStepWidth(timeStepWidth_);
+  LOG(DEBUG) << "restart at t=" << startTime << ", " << numberTimeSteps_ << " time steps of width " << timeStepWidth_ << " remain";
+}
+
+void TimeSteppingScheme::startCheckpointing()
+{
+  isOutermostSolver_ = Control::Checkpointing::claimOutermostSolver(context_.rankSubset()->mpiCommunicator());
+  if (!isOutermostSolver_)
+    return;
+
+  // continue from the last checkpoint, if "restart" is set
+  double checkpointTime = 0;
+  if (Control::Checkpointing::restoreCheckpoint(checkpointTime))
+  {
+    restartAtTime(checkpointTime);
+  }
+}
+
+void TimeSteppingScheme::writeCheckpointIfDue(double currentTime)
+{
+  if (isOutermostSolver_)
+    Control::Checkpointing::writeCheckpointIfDue(currentTime);
+}
+
 void TimeSteppingScheme::reset()
 {
   initialized_ = false;
@@ -32,6 +32,15 @@ public:
   //! set a new time interval that will be simulated by next call to advanceTimeSpan. This also potentially changes the time step width (it preserves the number of timesteps in the new time span)
   void setTimeSpan(double startTime, double endTime);
 
+  //! continue the simulation at the given start time, e.g. after a checkpoint was restored, this keeps the end time and the time step width
+  void restartAtTime(double startTime);
+
+  //! called in run(): if this scheme is the outermost solver, it is responsible for the checkpoints, then continue from the last checkpoint if "restart" is set
+  void startCheckpointing();
+
+  //! write a checkpoint if this scheme is the outermost solver and the checkpoint interval has passed, called after every time step
+  void writeCheckpointIfDue(double currentTime);
+
   //! initialize time span from specificSettings_
   void initialize();
   
@@ -89,6 +98,7 @@ protected:
 
   PythonConfig specificSettings_;   //< python object containing the value of the python config dict with corresponding key
   bool initialized_;                //< if initialize() was already called
+  bool isOutermostSolver_;          //< if this scheme was started by run() on all ranks, then it restores and writes the checkpoints of Control::Checkpointing
 };
 
 }  // namespace
@@ -112,6 +112,9 @@ run()
   // initialize
   this->initialize();
 
+  // continue from the last checkpoint, if "restart" is set and this is the outermost solver
+  this->startCheckpointing();
+
   // do simulations
   this->advanceTimeSpan();
 }
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "utility/python_utility.h"
+#include "control/checkpointing/checkpointing.h"
 
 namespace TimeSteppingScheme
 {
@@ -61,6 +62,9 @@ initialize()
   TimeSteppingScheme::initialize();
   LOG(TRACE) << "TimeSteppingSchemeOdeBase::initialize";
 
+  // the states that are registered for checkpointing by this solver and the discretizableInTime object get the path of the settings as key prefix
+  Control::Checkpointing::KeyScope checkpointingKeyScope(this->specificSettings_.getStringPath());
+
   // disable boundary condition handling in finite element method, because Dirichlet BC have to be handled in the system matrix here
   discretizableInTime_.setBoundaryConditionHandlingEnabled(false);
 
@@ -6,9 +6,48 @@
 #include "data_management/data.h"
 #include "time_stepping_scheme/02_time_stepping_scheme_ode.h"
 
+// forward declaration
+template <int nStates,int nAlgebraics_,typename FunctionSpaceType>
+class CellmlAdapter;
+
 namespace TimeSteppingScheme
 {
 
+/** Helper class to compute multiple explicit time steps at once, if the DiscretizableInTime object supports it.
+ *  By default, every time step is computed individually.
+ */
+template<typename DiscretizableInTimeType>
+struct FusedTimeSteps
+{
+  //! get the number of the next time steps that can be computed at once, 0 if not supported
+  static int nTimeStepsWithoutInterruption(DiscretizableInTimeType &discretizableInTime, double currentTime, double timeStepWidth,
+                                           int nTimeStepsMaximum, int nRhsEvaluationsPerTimeStep){return 0;}
+
+  //! compute the time steps at once
+  static void computeTimeSteps(DiscretizableInTimeType &discretizableInTime, Vec &solution, double currentTime, double timeStepWidth,
+                               int nTimeSteps, bool useHeun){}
+};
+
+/** Partial specialization for CellmlAdapter, the generated code contains a routine that computes multiple explicit Euler or Heun time steps.
+ */
+template<int nStates,int nAlgebraics_,typename FunctionSpaceType>
+struct FusedTimeSteps<CellmlAdapter<nStates,nAlgebraics_,FunctionSpaceType>>
+{
+  //! get the number of the next time steps that can be computed at once, i.e. until a callback or output of the CellmlAdapter is due
+  static int nTimeStepsWithoutInterruption(CellmlAdapter<nStates,nAlgebraics_,FunctionSpaceType> &cellmlAdapter, double currentTime, double timeStepWidth,
+                                           int nTimeStepsMaximum, int nRhsEvaluationsPerTimeStep)
+  {
+    return cellmlAdapter.nTimeStepsWithoutInterruption(currentTime, timeStepWidth, nTimeStepsMaximum, nRhsEvaluationsPerTimeStep);
+  }
+
+  //! compute the time steps at once in the compiled library
+  static void computeTimeSteps(CellmlAdapter<nStates,nAlgebraics_,FunctionSpaceType> &cellmlAdapter, Vec &solution, double currentTime, double timeStepWidth,
+                               int nTimeSteps, bool useHeun)
+  {
+    cellmlAdapter.computeTimeSteps(solution, currentTime, timeStepWidth, nTimeSteps, useHeun);
+  }
+};
+
 /** This is the base class for all ode solvers.
  */
 template<typename DiscretizableInTimeType>
@@ -23,6 +62,12 @@ protected:
 
   //! set the dofs in the solution vector to the given boundary conditions
   void applyBoundaryConditions();
+
+  //! If the DiscretizableInTime object supports it, compute as many of the next time steps as possible at once, until an output or callback is due.
+  //! Afterwards, the caller has to write the output with callCountIncrement set to the returned number of time steps.
+  //! @return the number of computed time steps, 0 if the next time step has to be computed individually
+  //! @param useHeun if the Heun scheme should be used, otherwise explicit Euler
+  int computeFusedTimeSteps(int timeStepNo, double currentTime, bool withOutputWritersEnabled, bool useHeun);
 };
 }  // namespace
 
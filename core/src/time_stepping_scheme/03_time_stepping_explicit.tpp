@@ -2,6 +2,7 @@
 
 #include <Python.h>  // has to be the first included header
 #include <vector>
+#include <algorithm>
 
 #include "utility/python_utility.h"
 
@@ -15,4 +16,33 @@ applyBoundaryConditions()
   this->dirichletBoundaryConditions_->applyInVector(this->data_->solution());
 }
 
+template<typename DiscretizableInTimeType>
+int TimeSteppingExplicit<DiscretizableInTimeType>::
+computeFusedTimeSteps(int timeStepNo, double currentTime, bool withOutputWritersEnabled, bool useHeun)
+{
+  // Dirichlet boundary conditions have to be applied after every time step
+  if (!this->dirichletBoundaryConditions_->boundaryConditionNonGhostDofLocalNos().empty())
+    return 0;
+
+  // compute the time steps up to and including the next one where output is written
+  int nTimeSteps = this->numberTimeSteps_ - timeStepNo;
+  if (withOutputWritersEnabled)
+    nTimeSteps = std::min(nTimeSteps, this->outputWriterManager_.nCallsUntilNextOutput());
+
+  const int nRhsEvaluationsPerTimeStep = (useHeun? 2 : 1);
+  nTimeSteps = FusedTimeSteps<DiscretizableInTimeType>::nTimeStepsWithoutInterruption(
+    this->discretizableInTime_, currentTime, this->timeStepWidth_, nTimeSteps, nRhsEvaluationsPerTimeStep);
+
+  // a single time step is computed in the normal way
+  if (nTimeSteps <= 1)
+    return 0;
+
+  VLOG(1) << "compute " << nTimeSteps << " fused time steps, starting at time step " << timeStepNo << ", t=" << currentTime;
+
+  FusedTimeSteps<DiscretizableInTimeType>::computeTimeSteps(
+    this->discretizableInTime_, this->data_->solution()->getValuesContiguous(), currentTime, this->timeStepWidth_, nTimeSteps, useHeun);
+
+  return nTimeSteps;
+}
+
 } // namespace
@@ -7,6 +7,7 @@
 #include <petscksp.h>
 #include "solver/solver_manager.h"
 #include "solver/linear.h"
+#include "solver/geometric_multigrid.h"
 #include "data_management/time_stepping/time_stepping_implicit.h"
 
 namespace TimeSteppingScheme
@@ -110,6 +111,13 @@ initializeWithTimeStepWidth_impl(double timeStepWidth)
   assert(this->ksp_);
   PetscErrorCode ierr;
   ierr = KSPSetOperators(*ksp_, systemMatrix, systemMatrix); CHKERRV(ierr);
+
+  // set up the mesh hierarchy for the geometric multigrid preconditioner
+  if (linearSolver_->isGeometricMultigrid())
+  {
+    Solver::GeometricMultigrid<typename DiscretizableInTimeType::FunctionSpace>::setup(
+      linearSolver_, this->data_->functionSpace(), DiscretizableInTimeType::nComponents());
+  }
 }
 
 template<typename DiscretizableInTimeType>
@@ -74,6 +74,9 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     // write current output values
     if (withOutputWritersEnabled)
       this->outputWriterManager_.writeOutput(*this->data_, timeStepNo, currentTime);
+
+    // write a checkpoint if this scheme is the outermost solver and the interval has passed
+    this->writeCheckpointIfDue(currentTime);
     
     // start duration measurement
     if (this->durationLogKey_ != "")
@@ -62,6 +62,34 @@ advanceTimeSpan(bool withOutputWritersEnabled)
       LOG(INFO) << "Heun, timestep " << timeStepNo << "/" << this->numberTimeSteps_<< ", t=" << currentTime;
     }
 
+    // compute multiple time steps at once, if supported by the discretizableInTime object and no output or callback is due
+    int nFusedTimeSteps = this->computeFusedTimeSteps(timeStepNo, currentTime, withOutputWritersEnabled, true);
+    if (nFusedTimeSteps > 0)
+    {
+      // advance simulation time
+      timeStepNo += nFusedTimeSteps;
+      currentTime = this->startTime_ + double(timeStepNo) / this->numberTimeSteps_ * timeSpan;
+
+      // check if the solution contains Nans or Inf values
+      this->checkForNanInf(timeStepNo, currentTime);
+
+      // stop duration measurement
+      if (this->durationLogKey_ != "")
+        Control::PerformanceMeasurement::stop(this->durationLogKey_);
+
+      // write current output values, the output writers count the computed time steps
+      if (withOutputWritersEnabled)
+        this->outputWriterManager_.writeOutput(*this->data_, timeStepNo, currentTime, nFusedTimeSteps);
+
+      // write a checkpoint if this scheme is the outermost solver and the interval has passed
+      this->writeCheckpointIfDue(currentTime);
+
+      // start duration measurement
+      if (this->durationLogKey_ != "")
+        Control::PerformanceMeasurement::start(this->durationLogKey_);
+      continue;
+    }
+
     VLOG(1) << "starting from solution (" << this->data_->solution() << "): " << *this->data_->solution();
 
     // advance solution value to compute u* first
@@ -111,6 +139,9 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     if (withOutputWritersEnabled)
       this->outputWriterManager_.writeOutput(*this->data_, timeStepNo, currentTime);
 
+    // write a checkpoint if this scheme is the outermost solver and the interval has passed
+    this->writeCheckpointIfDue(currentTime);
+
     // start duration measurement
     if (this->durationLogKey_ != "")
       Control::PerformanceMeasurement::start(this->durationLogKey_);
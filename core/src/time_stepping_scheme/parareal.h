@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <mpi.h>
+#include <memory>
+#include <vector>
+
+#include "time_stepping_scheme/00_time_stepping_scheme.h"
+#include "partition/rank_subset.h"
+
+#include "easylogging++.h"
+
+namespace TimeSteppingScheme
+{
+
+/** Parallel-in-time integration with the Parareal algorithm, wrapping any time stepping scheme.
+ *  The time span [startTime,endTime] is split into nTimeSlices time slices of equal length. The ranks are split into nTimeSlices groups of consecutive ranks,
+ *  every group holds the whole spatial problem and computes one time slice. All groups have the same number of ranks and therefore the same domain decomposition.
+ *
+ *  The nested scheme is used as fine propagator with its own time step width and as coarse propagator with the larger coarseTimeStepWidth.
+ *  The state that is propagated from one time slice to the next is the full state of the nested scheme, i.e. all field variables and the internal states
+ *  of solvers such as CellML models or the FastMonodomainSolver. It is stored and restored with the functions that are registered for checkpointing.
+ *
+ *  One Parareal iteration computes the fine propagation of all time slices in parallel, followed by a sequential sweep of the coarse propagator over the
+ *  time slices that corrects the initial values of the next time slice. Time slices whose initial values did not change skip their computations.
+ *  The iteration stops if the maximum change of the values at the time slice boundaries is below the tolerance, after maximumNumberOfIterations
+ *  iterations or after nTimeSlices iterations, when the result is equal to the sequential fine solution.
+ *
+ *  During the iterations, output writers of the nested scheme are disabled. Afterwards, only the converged values at the time slice boundaries are output
+ *  by the first group and the values at the end time are sent from the last group to all groups. Parareal has to be the outermost solver, because the nested solver is created on the rank subset of the own time slice.
+ */
+template<typename TimeStepping>
+class Parareal :
+  public TimeSteppingScheme
+{
+public:
+  typedef typename TimeStepping::SlotConnectorDataType SlotConnectorDataType;
+
+  //! constructor, split the ranks into the groups of the time slices and create the nested solver on the own group
+  Parareal(DihuContext context);
+
+  //! destructor, free the communicator between the time slices
+  virtual ~Parareal();
+
+  //! advance simulation by the given time span [startTime_, endTime_], using Parareal iterations over the time slices
+  virtual void advanceTimeSpan(bool withOutputWritersEnabled = true);
+
+  //! initialize the nested solver
+  void initialize();
+
+  //! initialize and run the Parareal iterations
+  void run();
+
+  //! call the output writer of the nested solver
+  void callOutputWriter(int timeStepNo, double currentTime, int callCountIncrement = 1);
+
+  //! get the data that will be transferred in an operator splitting, this is the data of the nested solver
+  std::shared_ptr<SlotConnectorDataType> getSlotConnectorData();
+
+  //! get the nested solver
+  TimeStepping &timeStepping();
+
+protected:
+
+  //! get the full state of the nested solver, i.e. the values of all states that the nested solver registered at Control::Checkpointing
+  void getState(std::vector<double> &state);
+
+  //! set the values of all connector slots of the nested solver, state has the layout of getState
+  void setState(const std::vector<double> &state);
+
+  //! propagate initialState over the own time slice with the nested solver and the given time step width
+  void propagate(const std::vector<double> &initialState, double timeStepWidth, std::vector<double> &result);
+
+  //! send the values at the end of the own time slice to the next time slice, non-blocking
+  void sendToNextTimeSlice(const std::vector<double> &state);
+
+  //! receive the initial values of the own time slice from the previous time slice
+  void receiveFromPreviousTimeSlice(std::vector<double> &state);
+
+  //! output the values at the end of all time slices with the output writers of the nested solver of the first time slice
+  void outputConvergedTrajectory(const std::vector<double> &endState);
+
+  std::shared_ptr<TimeStepping> timeStepping_;                //< the nested solver, used as coarse and fine propagator
+  std::shared_ptr<Partition::RankSubset> rankSubsetTimeSlice_;  //< the ranks that compute the own time slice
+  MPI_Comm timeSliceCommunicator_;    //< communicator with the ranks that have the same rank no in all time slice groups, the rank no is the time slice no
+
+  int nTimeSlices_;                   //< number of time slices and rank groups
+  int timeSliceNo_;                   //< the time slice computed by the own rank
+  double fineTimeStepWidth_;          //< time step width of the fine propagator, given by the settings of the nested solver
+  double coarseTimeStepWidth_;        //< time step width of the coarse propagator
+  int maximumNumberOfIterations_;     //< maximum number of Parareal iterations
+  double tolerance_;                  //< tolerance for the maximum change of the values at the time slice boundaries
+  int nIterations_;                   //< number of iterations in the last call to advanceTimeSpan
+  int stateHandleBegin_;              //< the first handle of the states that were registered by the nested solver
+  int stateHandleEnd_;                //< one after the last handle of the states that were registered by the nested solver
+
+  std::vector<double> sendBuffer_;    //< the values that are sent to the next time slice
+  MPI_Request sendRequest_;           //< the request of the non-blocking send to the next time slice
+};
+
+}  // namespace
+
+#include "time_stepping_scheme/parareal.tpp"
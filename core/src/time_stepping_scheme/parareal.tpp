@@ -0,0 +1,332 @@
+#include "time_stepping_scheme/parareal.h"
+
+#include <Python.h>  // has to be the first included header
+#include <cassert>
+#include <cmath>
+
+#include "utility/python_utility.h"
+#include "utility/mpi_utility.h"
+#include "control/checkpointing/checkpointing.h"
+#include "control/diagnostic_tool/solver_structure_visualizer.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+
+namespace TimeSteppingScheme
+{
+
+template<typename TimeStepping>
+Parareal<TimeStepping>::Parareal(DihuContext context) :
+  TimeSteppingScheme(context["Parareal"]), timeSliceCommunicator_(MPI_COMM_NULL), nIterations_(0), sendRequest_(MPI_REQUEST_NULL)
+{
+  this->specificSettings_ = this->context_.getPythonConfig();
+
+  std::shared_ptr<Partition::RankSubset> rankSubset = this->context_.rankSubset();
+  MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
+  int nRanks = 0;
+  int ownRankNo = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_size(mpiCommunicator, &nRanks), "MPI_Comm_size");
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator, &ownRankNo), "MPI_Comm_rank");
+
+  nTimeSlices_ = this->specificSettings_.getOptionInt("nTimeSlices", nRanks, PythonUtility::Positive);
+  if (nRanks % nTimeSlices_ != 0)
+  {
+    LOG(FATAL) << this->specificSettings_.getStringPath() << "[\"nTimeSlices\"] = " << nTimeSlices_
+      << " does not divide the number of ranks, " << nRanks << ". Every time slice needs the same number of ranks.";
+  }
+
+  // the time slices are computed by groups of consecutive ranks
+  int nRanksPerTimeSlice = nRanks / nTimeSlices_;
+  timeSliceNo_ = ownRankNo / nRanksPerTimeSlice;
+  int rankNoInTimeSlice = ownRankNo % nRanksPerTimeSlice;
+
+  MPI_Comm timeSliceGroupCommunicator;
+  MPIUtility::handleReturnValue(MPI_Comm_split(mpiCommunicator, timeSliceNo_, rankNoInTimeSlice, &timeSliceGroupCommunicator), "MPI_Comm_split");
+  MPIUtility::handleReturnValue(MPI_Comm_split(mpiCommunicator, rankNoInTimeSlice, timeSliceNo_, &timeSliceCommunicator_), "MPI_Comm_split");
+  rankSubset->incrementNCommunicatorSplit();
+  rankSubset->incrementNCommunicatorSplit();
+
+  rankSubsetTimeSlice_ = std::make_shared<Partition::RankSubset>(timeSliceGroupCommunicator);
+
+  LOG(DEBUG) << "Parareal: " << nTimeSlices_ << " time slices, own time slice: " << timeSliceNo_ << ", rank subset: " << *rankSubsetTimeSlice_;
+
+  // the meshes and collective operations of the nested solver only involve the ranks of the own time slice
+  this->context_.partitionManager()->setRankSubsetForNextCreatedPartitioning(rankSubsetTimeSlice_);
+  this->context_.partitionManager()->setRankSubsetForCollectiveOperations(rankSubsetTimeSlice_);
+
+  // the nested solver registers all its states, such that the full state can be propagated between the time slices
+  Control::Checkpointing::requestStateRegistration();
+  stateHandleBegin_ = Control::Checkpointing::nextHandle();
+  stateHandleEnd_ = stateHandleBegin_;
+
+  timeStepping_ = std::make_shared<TimeStepping>(this->context_.createSubContext(this->specificSettings_, rankSubsetTimeSlice_));
+}
+
+template<typename TimeStepping>
+Parareal<TimeStepping>::~Parareal()
+{
+  if (sendRequest_ != MPI_REQUEST_NULL)
+    MPIUtility::handleReturnValue(MPI_Wait(&sendRequest_, MPI_STATUS_IGNORE), "MPI_Wait");
+
+  if (timeSliceCommunicator_ != MPI_COMM_NULL)
+    MPI_Comm_free(&timeSliceCommunicator_);
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+initialize()
+{
+  if (this->initialized_)
+    return;
+
+  TimeSteppingScheme::initialize();
+  LOG(TRACE) << "Parareal::initialize";
+
+  // every time step of this scheme is one time slice
+  this->setNumberTimeSteps(nTimeSlices_);
+
+  // add this solver to the solvers diagram
+  DihuContext::solverStructureVisualizer()->addSolver("Parareal", true);   // hasInternalConnectionToFirstNestedSolver=true (the last argument) means slot connector data is shared with the first subsolver
+
+  // indicate in solverStructureVisualizer that now a child solver will be initialized
+  DihuContext::solverStructureVisualizer()->beginChild();
+
+  timeStepping_->initialize();
+  stateHandleEnd_ = Control::Checkpointing::nextHandle();
+
+  // indicate in solverStructureVisualizer that the child solver initialization is done
+  DihuContext::solverStructureVisualizer()->endChild();
+
+  fineTimeStepWidth_ = timeStepping_->timeStepWidth();
+  coarseTimeStepWidth_ = this->specificSettings_.getOptionDouble("coarseTimeStepWidth", this->timeStepWidth_, PythonUtility::Positive);
+  maximumNumberOfIterations_ = this->specificSettings_.getOptionInt("maximumNumberOfIterations", nTimeSlices_, PythonUtility::Positive);
+  tolerance_ = this->specificSettings_.getOptionDouble("tolerance", 1e-6, PythonUtility::NonNegative);
+
+  if (coarseTimeStepWidth_ <= fineTimeStepWidth_)
+  {
+    LOG(WARNING) << this->specificSettings_.getStringPath() << "[\"coarseTimeStepWidth\"] = " << coarseTimeStepWidth_
+      << " is not larger than the time step width of the nested solver, " << fineTimeStepWidth_ << ". Parareal will not give a speedup.";
+  }
+
+  this->initialized_ = true;
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+getState(std::vector<double> &state)
+{
+  // the states of field variables, CellML models etc. of the nested solver, all groups have the same partitioning and therefore the same layout
+  Control::Checkpointing::saveStates(stateHandleBegin_, stateHandleEnd_, state);
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+setState(const std::vector<double> &state)
+{
+  Control::Checkpointing::restoreStates(stateHandleBegin_, stateHandleEnd_, state);
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+propagate(const std::vector<double> &initialState, double timeStepWidth, std::vector<double> &result)
+{
+  double timeSliceStartTime = this->startTime_ + timeSliceNo_*this->timeStepWidth_;
+  double timeSliceEndTime = this->startTime_ + (timeSliceNo_+1)*this->timeStepWidth_;
+
+  setState(initialState);
+
+  timeStepping_->setTimeSpan(timeSliceStartTime, timeSliceEndTime);
+  timeStepping_->setTimeStepWidth(timeStepWidth);
+  timeStepping_->advanceTimeSpan(false);
+
+  getState(result);
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+sendToNextTimeSlice(const std::vector<double> &state)
+{
+  if (timeSliceNo_ == nTimeSlices_-1)
+    return;
+
+  // the previous message has to be completed before the send buffer can be reused
+  MPIUtility::handleReturnValue(MPI_Wait(&sendRequest_, MPI_STATUS_IGNORE), "MPI_Wait");
+
+  sendBuffer_ = state;
+  MPIUtility::handleReturnValue(MPI_Isend(sendBuffer_.data(), sendBuffer_.size(), MPI_DOUBLE, timeSliceNo_+1, 0,
+                                          timeSliceCommunicator_, &sendRequest_), "MPI_Isend");
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+receiveFromPreviousTimeSlice(std::vector<double> &state)
+{
+  if (timeSliceNo_ == 0)
+    return;
+
+  MPIUtility::handleReturnValue(MPI_Recv(state.data(), state.size(), MPI_DOUBLE, timeSliceNo_-1, 0,
+                                         timeSliceCommunicator_, MPI_STATUS_IGNORE), "MPI_Recv");
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+advanceTimeSpan(bool withOutputWritersEnabled)
+{
+  // start duration measurement, the name of the output variable can be set by "durationLogKey" in the config
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::start(this->durationLogKey_);
+
+  // the time slices are the time steps of this scheme
+  this->setNumberTimeSteps(nTimeSlices_);
+
+  LOG(DEBUG) << "Parareal::advanceTimeSpan, timeSpan=[" << this->startTime_ << "," << this->endTime_ << "], " << nTimeSlices_
+    << " time slices, fine timeStepWidth: " << fineTimeStepWidth_ << ", coarse timeStepWidth: " << coarseTimeStepWidth_;
+
+  // The notation is U_n^k for the initial values of time slice n in iteration k, G the coarse and F the fine propagator.
+  // the current values of the nested solver are the initial values U_0 of the whole time span, all groups start with the same values
+  std::vector<double> initialState;       // U_n^k
+  getState(initialState);
+
+  // initial coarse sweep, U_{n+1}^0 = G(U_n^0)
+  std::vector<double> coarseSolution;     // G(U_n^k)
+  receiveFromPreviousTimeSlice(initialState);
+  propagate(initialState, coarseTimeStepWidth_, coarseSolution);
+
+  std::vector<double> endState = coarseSolution;   // U_{n+1}^k
+  sendToNextTimeSlice(endState);
+
+  std::vector<double> fineSolution;       // F(U_n^k)
+  std::vector<double> fineInitialState;   // the initial values of the last fine propagation
+  std::vector<double> previousInitialState;
+  bool fineSolutionIsUpToDate = false;
+
+  MPI_Comm mpiCommunicator = this->context_.rankSubset()->mpiCommunicator();
+  bool converged = false;
+
+  for (nIterations_ = 0; nIterations_ < maximumNumberOfIterations_;)
+  {
+    // fine propagation of all time slices in parallel, time slices with unchanged initial values keep their fine solution
+    if (!fineSolutionIsUpToDate)
+    {
+      propagate(initialState, fineTimeStepWidth_, fineSolution);
+      fineInitialState = initialState;
+    }
+
+    // sequential correction sweep: U_{n+1}^{k+1} = G(U_n^{k+1}) + F(U_n^k) - G(U_n^k)
+    previousInitialState = initialState;
+    receiveFromPreviousTimeSlice(initialState);
+
+    std::vector<double> newCoarseSolution = coarseSolution;
+    if (initialState != previousInitialState)
+    {
+      propagate(initialState, coarseTimeStepWidth_, newCoarseSolution);
+    }
+
+    double localChange = 0;
+    for (std::size_t i = 0; i < endState.size(); i++)
+    {
+      double newValue = newCoarseSolution[i] + fineSolution[i] - coarseSolution[i];
+      localChange = std::max(localChange, std::fabs(newValue - endState[i]));
+      endState[i] = newValue;
+    }
+    coarseSolution = newCoarseSolution;
+    sendToNextTimeSlice(endState);
+
+    fineSolutionIsUpToDate = (initialState == fineInitialState);
+    nIterations_++;
+
+    // the maximum change of the values at the time slice boundaries over all time slices
+    double change = 0;
+    MPIUtility::handleReturnValue(MPI_Allreduce(&localChange, &change, 1, MPI_DOUBLE, MPI_MAX, mpiCommunicator), "MPI_Allreduce");
+
+    LOG(INFO) << "Parareal, iteration " << nIterations_ << ", maximum change at the time slice boundaries: " << change;
+
+    // after nTimeSlices iterations the solution is equal to the sequential fine solution
+    if (change <= tolerance_ || nIterations_ >= nTimeSlices_)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  if (!converged)
+  {
+    LOG(WARNING) << "Parareal did not converge in " << maximumNumberOfIterations_ << " iterations.";
+  }
+
+  MPIUtility::handleReturnValue(MPI_Wait(&sendRequest_, MPI_STATUS_IGNORE), "MPI_Wait");
+
+  Control::PerformanceMeasurement::setParameter("pararealNIterations", nIterations_);
+
+  if (withOutputWritersEnabled)
+    outputConvergedTrajectory(endState);
+
+  // every group has the values at the end of its own time slice, the values at endTime of the last group are the result on all groups
+  std::vector<double> finalState = endState;
+  MPIUtility::handleReturnValue(MPI_Bcast(finalState.data(), finalState.size(), MPI_DOUBLE, nTimeSlices_-1, timeSliceCommunicator_), "MPI_Bcast");
+
+  setState(finalState);
+
+  // stop duration measurement
+  if (this->durationLogKey_ != "")
+    Control::PerformanceMeasurement::stop(this->durationLogKey_);
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+outputConvergedTrajectory(const std::vector<double> &endState)
+{
+  // the groups send their values to the first group, which writes all output files such that the file numbering is continuous
+  if (timeSliceNo_ != 0)
+  {
+    MPIUtility::handleReturnValue(MPI_Send(endState.data(), endState.size(), MPI_DOUBLE, 0, 1, timeSliceCommunicator_), "MPI_Send");
+    return;
+  }
+
+  std::vector<double> state = endState;
+  for (int timeSliceNo = 0; timeSliceNo < nTimeSlices_; timeSliceNo++)
+  {
+    if (timeSliceNo > 0)
+    {
+      MPIUtility::handleReturnValue(MPI_Recv(state.data(), state.size(), MPI_DOUBLE, timeSliceNo, 1,
+                                             timeSliceCommunicator_, MPI_STATUS_IGNORE), "MPI_Recv");
+    }
+
+    setState(state);
+    timeStepping_->callOutputWriter(timeSliceNo+1, this->startTime_ + (timeSliceNo+1)*this->timeStepWidth_);
+  }
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+run()
+{
+  initialize();
+
+  // output the initial values
+  if (timeSliceNo_ == 0)
+    timeStepping_->callOutputWriter(0, this->startTime_, 0);
+
+  advanceTimeSpan();
+}
+
+template<typename TimeStepping>
+void Parareal<TimeStepping>::
+callOutputWriter(int timeStepNo, double currentTime, int callCountIncrement)
+{
+  timeStepping_->callOutputWriter(timeStepNo, currentTime, callCountIncrement);
+}
+
+template<typename TimeStepping>
+std::shared_ptr<typename Parareal<TimeStepping>::SlotConnectorDataType> Parareal<TimeStepping>::
+getSlotConnectorData()
+{
+  return timeStepping_->getSlotConnectorData();
+}
+
+template<typename TimeStepping>
+TimeStepping &Parareal<TimeStepping>::
+timeStepping()
+{
+  return *timeStepping_;
+}
+
+} // namespace
@@ -0,0 +1,140 @@
+#include "utility/file_lock.h"
+
+#include <fcntl.h>      // open
+#include <unistd.h>     // getpid, gethostname, link, write, close
+#include <signal.h>     // kill
+#include <climits>      // HOST_NAME_MAX
+#include <cerrno>
+#include <cstdio>       // rename, remove
+#include <fstream>
+#include <sstream>
+
+#include "easylogging++.h"
+#include "utility/string_utility.h"
+
+namespace
+{
+
+//! read the owner from a lock file, empty if the file does not exist
+std::string readLockOwner(std::string filename)
+{
+  std::ifstream file(filename.c_str());
+  std::stringstream content;
+  content << file.rdbuf();
+
+  std::string owner = content.str();
+  StringUtility::trim(owner);
+  return owner;
+}
+
+//! get the name of the own host
+std::string ownHostname()
+{
+  char hostname[HOST_NAME_MAX+1] = {0};
+  gethostname(hostname, HOST_NAME_MAX);
+  return std::string(hostname);
+}
+
+}  // namespace
+
+FileLock::FileLock(std::string lockFilename) :
+  lockFilename_(lockFilename), isLocked_(false)
+{
+}
+
+FileLock::~FileLock()
+{
+  unlock();
+}
+
+bool FileLock::tryLock()
+{
+  if (isLocked_)
+    return true;
+
+  // creating the file with O_EXCL is atomic, only one process succeeds
+  int fileDescriptor = open(lockFilename_.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+  if (fileDescriptor == -1 && errno == EEXIST && removeStaleLock())
+  {
+    fileDescriptor = open(lockFilename_.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+  }
+
+  if (fileDescriptor == -1)
+    return false;
+
+  // store the owner such that other processes can detect if it terminates without releasing the lock
+  std::string owner = ownProcess() + "\n";
+  if (write(fileDescriptor, owner.c_str(), owner.size()) != (ssize_t)owner.size())
+  {
+    LOG(WARNING) << "Could not write the owner to lock file \"" << lockFilename_ << "\".";
+  }
+  close(fileDescriptor);
+
+  isLocked_ = true;
+  return true;
+}
+
+void FileLock::unlock()
+{
+  if (!isLocked_)
+    return;
+
+  std::remove(lockFilename_.c_str());
+  isLocked_ = false;
+}
+
+bool FileLock::isLocked() const
+{
+  return isLocked_;
+}
+
+std::string FileLock::owner() const
+{
+  return readLockOwner(lockFilename_);
+}
+
+std::string FileLock::ownProcess()
+{
+  std::stringstream result;
+  result << ownHostname() << " " << getpid();
+  return result.str();
+}
+
+bool FileLock::removeStaleLock()
+{
+  // parse "<host name> <process id>", an empty lock file belongs to a process that has not yet written its id
+  std::string lockOwner = readLockOwner(lockFilename_);
+  std::stringstream lockOwnerStream(lockOwner);
+  std::string hostname;
+  long processId = 0;
+  if (!(lockOwnerStream >> hostname >> processId) || processId <= 0)
+    return false;
+
+  // the state of processes on other hosts is not known
+  if (hostname != ownHostname())
+    return false;
+
+  if (kill(processId, 0) == 0 || errno != ESRCH)
+    return false;
+
+  // move the lock file away atomically, another process that also detected the stale lock may have replaced it by its own lock in the meantime,
+  // in this case the lock is put back
+  std::stringstream staleFilename;
+  staleFilename << lockFilename_ << "." << getpid() << ".stale";
+  if (std::rename(lockFilename_.c_str(), staleFilename.str().c_str()) != 0)
+    return false;
+
+  if (readLockOwner(staleFilename.str()) != lockOwner)
+  {
+    if (link(staleFilename.str().c_str(), lockFilename_.c_str()) != 0)
+    {
+      LOG(WARNING) << "Could not restore lock file \"" << lockFilename_ << "\".";
+    }
+    std::remove(staleFilename.str().c_str());
+    return false;
+  }
+
+  std::remove(staleFilename.str().c_str());
+  LOG(WARNING) << "Removed lock file \"" << lockFilename_ << "\" of process \"" << lockOwner << "\", which has terminated.";
+  return true;
+}
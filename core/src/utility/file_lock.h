@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <string>
+
+/** An exclusive lock between processes that is given by the existence of a lock file, it works on all file systems that support O_EXCL, also on shared directories.
+ *  The lock file contains the host name and the process id of the owner. If the owner runs on the same host and has terminated without releasing the lock,
+ *  e.g. because the job was aborted, the lock is stale and is removed by the next process that tries to acquire it.
+ */
+class FileLock
+{
+public:
+
+  //! constructor, the lock is not yet acquired
+  FileLock(std::string lockFilename);
+
+  //! destructor, releases the lock if it is held
+  ~FileLock();
+
+  //! try to acquire the lock without waiting, a stale lock is removed, returns true if the lock is held afterwards
+  bool tryLock();
+
+  //! release the lock by removing the lock file, if it is held
+  void unlock();
+
+  //! if the lock is held by this object
+  bool isLocked() const;
+
+  //! the owner of the lock as stored in the lock file, i.e. "<host name> <process id>", empty if the lock file does not exist
+  std::string owner() const;
+
+  //! the string that identifies the own process in a lock file
+  static std::string ownProcess();
+
+private:
+
+  //! remove the lock file if its owner has terminated, returns true if the lock file was removed
+  bool removeStaleLock();
+
+  std::string lockFilename_;    //< the name of the lock file
+  bool isLocked_;               //< if the lock file was created by this object
+};
@@ -0,0 +1,284 @@
+#include "utility/incremental_svd.h"
+
+#include <petscsys.h>
+#include <petscblaslapack.h>
+#include <algorithm>
+#include <cmath>
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
+namespace
+{
+
+//! compute c = alpha*op(a)*op(b) + beta*c for column-major matrices, op(a) is m x k, op(b) is k x n, also handles empty dimensions
+void gemm(char transposeA, char transposeB, int m, int n, int k, double alpha, const double *a, int lda,
+          const double *b, int ldb, double beta, double *c, int ldc)
+{
+  if (m == 0 || n == 0)
+    return;
+
+  if (k == 0)
+  {
+    for (int j = 0; j < n; j++)
+      for (int i = 0; i < m; i++)
+        c[j*ldc + i] *= beta;
+    return;
+  }
+
+  PetscBLASInt mBlas = m, nBlas = n, kBlas = k, ldaBlas = lda, ldbBlas = ldb, ldcBlas = ldc;
+  BLASgemm_(&transposeA, &transposeB, &mBlas, &nBlas, &kBlas, &alpha, a, &ldaBlas, b, &ldbBlas, &beta, c, &ldcBlas);
+}
+
+//! compute the eigenvalues (ascending) and eigenvectors of the symmetric n x n matrix, the eigenvectors overwrite the matrix
+void symmetricEigenvalueDecomposition(std::vector<double> &matrix, int n, std::vector<double> &eigenvalues)
+{
+  char jobz = 'V';
+  char upperLower = 'U';
+  PetscBLASInt nBlas = n;
+  PetscBLASInt info = 0;
+  eigenvalues.resize(n);
+
+  // workspace query
+  PetscBLASInt lwork = -1;
+  double workSize = 0;
+  LAPACKsyev_(&jobz, &upperLower, &nBlas, matrix.data(), &nBlas, eigenvalues.data(), &workSize, &lwork, &info);
+
+  lwork = std::max((PetscBLASInt)workSize, 3*nBlas);
+  std::vector<double> work(lwork);
+  LAPACKsyev_(&jobz, &upperLower, &nBlas, matrix.data(), &nBlas, eigenvalues.data(), work.data(), &lwork, &info);
+
+  if (info != 0)
+  {
+    LOG(FATAL) << "Eigenvalue decomposition of a " << n << "x" << n << " matrix failed, LAPACK syev returned info=" << info << ".";
+  }
+}
+
+}  // namespace
+
+IncrementalSvd::IncrementalSvd(MPI_Comm mpiCommunicator, int maximumRank, int blockSize, double truncationTolerance) :
+  mpiCommunicator_(mpiCommunicator), maximumRank_(maximumRank), blockSize_(blockSize), truncationTolerance_(truncationTolerance),
+  nRowsLocal_(-1), nSnapshots_(0), nSnapshotsInBlock_(0)
+{
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator_, &ownRankNo_), "MPI_Comm_rank");
+}
+
+void IncrementalSvd::addSnapshot(const std::vector<double> &snapshotLocal)
+{
+  // the first snapshot determines the number of rows
+  if (nRowsLocal_ == -1)
+  {
+    nRowsLocal_ = snapshotLocal.size();
+    snapshotBlock_.resize(nRowsLocal_*blockSize_);
+  }
+  else if ((int)snapshotLocal.size() != nRowsLocal_)
+  {
+    LOG(FATAL) << "IncrementalSvd: snapshot has " << snapshotLocal.size() << " local entries, but previous snapshots had " << nRowsLocal_ << ".";
+  }
+
+  std::copy(snapshotLocal.begin(), snapshotLocal.end(), snapshotBlock_.begin() + nSnapshotsInBlock_*nRowsLocal_);
+  nSnapshotsInBlock_++;
+  nSnapshots_++;
+
+  if (nSnapshotsInBlock_ == blockSize_)
+  {
+    updateWithBlock();
+  }
+}
+
+void IncrementalSvd::flush()
+{
+  if (nSnapshotsInBlock_ > 0)
+  {
+    updateWithBlock();
+  }
+}
+
+int IncrementalSvd::rank() const
+{
+  return singularValues_.size();
+}
+
+int IncrementalSvd::nRowsLocal() const
+{
+  return nRowsLocal_;
+}
+
+int IncrementalSvd::nSnapshots() const
+{
+  return nSnapshots_;
+}
+
+const std::vector<double> &IncrementalSvd::leftSingularVectors() const
+{
+  return leftSingularVectors_;
+}
+
+const std::vector<double> &IncrementalSvd::singularValues() const
+{
+  return singularValues_;
+}
+
+void IncrementalSvd::updateWithBlock()
+{
+  const int k = rank();
+  const int b = nSnapshotsInBlock_;
+  const int n = nRowsLocal_;
+  const int ld = std::max(1, n);
+
+  VLOG(1) << "IncrementalSvd: update rank " << k << " decomposition with " << b << " snapshots";
+
+  // split the snapshots C into the part in the span of U and the orthogonal rest, C = U*projection + newDirections
+  // the projection is done twice to keep the new directions orthogonal to U in floating point arithmetic
+  std::vector<double> newDirections(snapshotBlock_.begin(), snapshotBlock_.begin() + n*b);
+  std::vector<double> projection(k*b, 0.0);
+
+  for (int passNo = 0; passNo < 2 && k > 0; passNo++)
+  {
+    std::vector<double> coefficients(k*b, 0.0);
+    gemm('T', 'N', k, b, n, 1.0, leftSingularVectors_.data(), ld, newDirections.data(), ld, 0.0, coefficients.data(), k);
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, coefficients.data(), k*b, MPI_DOUBLE, MPI_SUM, mpiCommunicator_), "MPI_Allreduce");
+
+    gemm('N', 'N', n, b, k, -1.0, leftSingularVectors_.data(), ld, coefficients.data(), k, 1.0, newDirections.data(), ld);
+
+    for (int i = 0; i < k*b; i++)
+      projection[i] += coefficients[i];
+  }
+
+  // newDirections = Q*triangularFactor with orthonormal Q of p columns, directions that are negligible compared to the leading singular value are dropped
+  std::vector<double> triangularFactor;
+  const int p = orthonormalize(newDirections, b, (k > 0? singularValues_[0] : 0.0), triangularFactor);
+
+  // assemble the small core matrix [diag(sigma) projection; 0 triangularFactor] of size (k+p) x (k+b)
+  const int m = k + p;
+  const int nColumns = k + b;
+  nSnapshotsInBlock_ = 0;
+
+  if (m == 0)
+    return;
+
+  std::vector<double> coreMatrix(m*nColumns, 0.0);
+  for (int j = 0; j < k; j++)
+  {
+    coreMatrix[j*m + j] = singularValues_[j];
+  }
+  for (int columnNo = 0; columnNo < b; columnNo++)
+  {
+    for (int i = 0; i < k; i++)
+      coreMatrix[(k+columnNo)*m + i] = projection[columnNo*k + i];
+    for (int i = 0; i < p; i++)
+      coreMatrix[(k+columnNo)*m + k+i] = triangularFactor[columnNo*p + i];
+  }
+
+  // compute the SVD of the core matrix on rank 0, such that all ranks use exactly the same result, p <= b, therefore the core matrix has m singular values
+  std::vector<double> coreLeftSingularVectors(m*m);
+  std::vector<double> coreSingularValues(m);
+
+  if (ownRankNo_ == 0)
+  {
+    char jobu = 'S';
+    char jobvt = 'N';
+    PetscBLASInt mBlas = m, nBlas = nColumns, ldvt = 1, info = 0;
+    double rightSingularVectorsDummy = 0;
+
+    PetscBLASInt lwork = -1;
+    double workSize = 0;
+    LAPACKgesvd_(&jobu, &jobvt, &mBlas, &nBlas, coreMatrix.data(), &mBlas, coreSingularValues.data(), coreLeftSingularVectors.data(), &mBlas,
+                 &rightSingularVectorsDummy, &ldvt, &workSize, &lwork, &info);
+
+    lwork = std::max((PetscBLASInt)workSize, 5*std::max(mBlas, nBlas));
+    std::vector<double> work(lwork);
+    LAPACKgesvd_(&jobu, &jobvt, &mBlas, &nBlas, coreMatrix.data(), &mBlas, coreSingularValues.data(), coreLeftSingularVectors.data(), &mBlas,
+                 &rightSingularVectorsDummy, &ldvt, work.data(), &lwork, &info);
+
+    if (info != 0)
+    {
+      LOG(FATAL) << "SVD of the " << m << "x" << nColumns << " core matrix failed, LAPACK gesvd returned info=" << info << ".";
+    }
+  }
+
+  MPIUtility::handleReturnValue(MPI_Bcast(coreLeftSingularVectors.data(), m*m, MPI_DOUBLE, 0, mpiCommunicator_), "MPI_Bcast");
+  MPIUtility::handleReturnValue(MPI_Bcast(coreSingularValues.data(), m, MPI_DOUBLE, 0, mpiCommunicator_), "MPI_Bcast");
+
+  // truncate the decomposition
+  int newRank = 0;
+  while (newRank < std::min(m, maximumRank_) && coreSingularValues[newRank] > truncationTolerance_*coreSingularValues[0])
+  {
+    newRank++;
+  }
+
+  // rotate the extended basis, U_new = [U Q]*coreLeftSingularVectors(:,1:newRank)
+  std::vector<double> newLeftSingularVectors(n*newRank, 0.0);
+  gemm('N', 'N', n, newRank, k, 1.0, leftSingularVectors_.data(), ld, coreLeftSingularVectors.data(), m, 0.0, newLeftSingularVectors.data(), ld);
+  gemm('N', 'N', n, newRank, p, 1.0, newDirections.data(), ld, coreLeftSingularVectors.data() + k, m, 1.0, newLeftSingularVectors.data(), ld);
+
+  leftSingularVectors_ = std::move(newLeftSingularVectors);
+  singularValues_.assign(coreSingularValues.begin(), coreSingularValues.begin() + newRank);
+}
+
+int IncrementalSvd::orthonormalize(std::vector<double> &values, int nColumns, double referenceNorm, std::vector<double> &triangularFactor)
+{
+  const int n = nRowsLocal_;
+  const int ld = std::max(1, n);
+
+  // start with the identity, values = values*triangularFactor
+  int nColumnsCurrent = nColumns;
+  triangularFactor.assign(nColumns*nColumns, 0.0);
+  for (int i = 0; i < nColumns; i++)
+    triangularFactor[i*nColumns + i] = 1.0;
+
+  // the second pass removes the loss of orthogonality of the first pass, which is caused by the squared condition number of the Gram matrix
+  for (int passNo = 0; passNo < 2 && nColumnsCurrent > 0; passNo++)
+  {
+    const int c = nColumnsCurrent;
+
+    // compute the Gram matrix values^T*values and its eigenvalue decomposition W*diag(lambda)*W^T
+    std::vector<double> gramMatrix(c*c, 0.0);
+    gemm('T', 'N', c, c, n, 1.0, values.data(), ld, values.data(), ld, 0.0, gramMatrix.data(), c);
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, gramMatrix.data(), c*c, MPI_DOUBLE, MPI_SUM, mpiCommunicator_), "MPI_Allreduce");
+
+    std::vector<double> eigenvalues;
+    symmetricEigenvalueDecomposition(gramMatrix, c, eigenvalues);
+
+    // select the directions that are not numerically zero, in descending order of the eigenvalues.
+    // The eigenvalues are the squared norms of the directions, they are compared to the leading singular value of the decomposition,
+    // such that the rounding errors of the projection of snapshots that are already in the span of the basis do not become new modes
+    const double largestEigenvalue = eigenvalues[c-1];
+    const double referenceEigenvalue = std::max(largestEigenvalue, referenceNorm*referenceNorm);
+    std::vector<int> selectedColumns;
+    for (int j = c-1; j >= 0; j--)
+    {
+      if (largestEigenvalue > 0 && eigenvalues[j] > 1e-14*referenceEigenvalue)
+        selectedColumns.push_back(j);
+    }
+    const int p = selectedColumns.size();
+
+    std::vector<double> selectedEigenvectors(c*p);
+    for (int q = 0; q < p; q++)
+    {
+      std::copy(gramMatrix.begin() + selectedColumns[q]*c, gramMatrix.begin() + (selectedColumns[q]+1)*c, selectedEigenvectors.begin() + q*c);
+    }
+
+    // values_new = values*W*diag(lambda)^(-1/2), triangularFactor_new = diag(lambda)^(1/2)*W^T*triangularFactor
+    std::vector<double> newValues(n*p, 0.0);
+    gemm('N', 'N', n, p, c, 1.0, values.data(), ld, selectedEigenvectors.data(), c, 0.0, newValues.data(), ld);
+
+    std::vector<double> newTriangularFactor(p*nColumns, 0.0);
+    gemm('T', 'N', p, nColumns, c, 1.0, selectedEigenvectors.data(), c, triangularFactor.data(), c, 0.0, newTriangularFactor.data(), p);
+
+    for (int q = 0; q < p; q++)
+    {
+      const double norm = std::sqrt(eigenvalues[selectedColumns[q]]);
+      for (int i = 0; i < n; i++)
+        newValues[q*n + i] /= norm;
+      for (int j = 0; j < nColumns; j++)
+        newTriangularFactor[j*p + q] *= norm;
+    }
+
+    values = std::move(newValues);
+    triangularFactor = std::move(newTriangularFactor);
+    nColumnsCurrent = p;
+  }
+
+  return nColumnsCurrent;
+}
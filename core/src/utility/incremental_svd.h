@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <mpi.h>
+#include <vector>
+
+/** Distributed incremental (streaming) singular value decomposition of a snapshot matrix, after M. Brand, "Fast low-rank modifications of the thin singular value decomposition", 2006.
+ *  The rows of the snapshot matrix are distributed over the ranks of the communicator, every rank adds the local part of every snapshot.
+ *  Snapshots are collected in a block of at most blockSize columns, then the truncated SVD U*diag(sigma) is updated with the whole block.
+ *  Only the left singular vectors U (nRowsLocal x rank) and the singular values are stored, the right singular vectors are not needed for a POD basis.
+ *  Therefore, the memory is bounded by nRowsLocal*(maximumRank + blockSize) values, independent of the number of snapshots.
+ *
+ *  The new directions of a block are orthonormalized by an eigenvalue decomposition of their Gram matrix which is repeated once (similar to CholeskyQR2),
+ *  this needs only one MPI_Allreduce of a blockSize x blockSize matrix per pass. The small core SVD is computed on rank 0 and broadcast.
+ */
+class IncrementalSvd
+{
+public:
+
+  //! constructor, maximumRank is the maximum number of modes that are kept, modes with a singular value below truncationTolerance times the largest singular value are discarded
+  IncrementalSvd(MPI_Comm mpiCommunicator, int maximumRank, int blockSize, double truncationTolerance);
+
+  //! add the local part of a snapshot, all snapshots must have the same number of local entries, this is collective when the block is full
+  void addSnapshot(const std::vector<double> &snapshotLocal);
+
+  //! update the decomposition with the snapshots that are still in the block, collective
+  void flush();
+
+  //! number of currently stored modes
+  int rank() const;
+
+  //! number of local rows of the snapshots, -1 before the first snapshot was added
+  int nRowsLocal() const;
+
+  //! number of snapshots that were added so far
+  int nSnapshots() const;
+
+  //! the local rows of the left singular vectors, column-major with dimensions nRowsLocal x rank, only valid after flush()
+  const std::vector<double> &leftSingularVectors() const;
+
+  //! the singular values in descending order, only valid after flush()
+  const std::vector<double> &singularValues() const;
+
+private:
+
+  //! update the decomposition with the snapshots in snapshotBlock_
+  void updateWithBlock();
+
+  //! orthonormalize the nColumns columns of the local rows in values (column-major), replace them by p orthonormal columns and set triangularFactor (p x nColumns) such that values_old = values_new*triangularFactor, returns p.
+  //! Columns whose norm is negligible compared to referenceNorm, the leading singular value, are dropped
+  int orthonormalize(std::vector<double> &values, int nColumns, double referenceNorm, std::vector<double> &triangularFactor);
+
+  MPI_Comm mpiCommunicator_;                //< the communicator of all ranks that own rows of the snapshots
+  int ownRankNo_;                           //< own rank in mpiCommunicator_
+  int maximumRank_;                         //< maximum number of modes that are kept
+  int blockSize_;                           //< number of snapshots that are collected before the decomposition is updated
+  double truncationTolerance_;              //< relative tolerance for the singular values of the kept modes
+
+  int nRowsLocal_;                          //< number of local rows of the snapshots
+  int nSnapshots_;                          //< total number of added snapshots
+  int nSnapshotsInBlock_;                   //< number of snapshots in snapshotBlock_ that were not yet processed
+
+  std::vector<double> snapshotBlock_;       //< the buffered snapshots, column-major nRowsLocal x blockSize
+  std::vector<double> leftSingularVectors_; //< the local rows of the left singular vectors, column-major nRowsLocal x rank
+  std::vector<double> singularValues_;      //< the singular values in descending order
+};
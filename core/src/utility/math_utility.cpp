@@ -315,6 +315,18 @@ bool isFinite<Vc::double_v>(Vc::double_v value)
   return Vc::all_of(Vc::isfinite(value));
 }
 
+template<>
+bool isEqual<double>(double a, double b)
+{
+  return a == b;
+}
+
+template<>
+bool isEqual<Vc::double_v>(Vc::double_v a, Vc::double_v b)
+{
+  return Vc::all_of(a == b);
+}
+
 int permutation(int i, int j, int k)
 {
   if ((i==1 && j==2 && k==3) || (i==2 && j==3 && k==1) || (i==3 && j==1 && k==2))
@@ -161,6 +161,10 @@ double_v_t computeIntegrationFactor(const std::array<VecD<3,double_v_t>,3> &jaco
 template<typename double_v_t=double>
 bool isFinite(double_v_t value);
 
+//! check if the two values are exactly equal, for vectorized values all entries have to be equal
+template<typename double_v_t=double>
+bool isEqual(double_v_t a, double_v_t b);
+
 //! compute 3D cross product
 Vec3 cross(const Vec3 &vector1, const Vec3 &vector2);
 
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <sstream>
+#include <cstdint>
 #ifdef __GNUC__
 #include <cxxabi.h>
 #endif
@@ -146,4 +148,19 @@ std::size_t stringLength(std::string string)
   return length;
 }
 
+std::string hashHexadecimal(const std::string &str)
+{
+  // FNV-1a with 64 bit offset basis and prime
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char character : str)
+  {
+    hash ^= character;
+    hash *= 1099511628211ULL;
+  }
+
+  std::stringstream result;
+  result << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return result.str();
+}
+
 }  // namespace
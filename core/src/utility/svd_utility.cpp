@@ -5,6 +5,7 @@
 #endif
 
 #include "easylogging++.h"
+#include "utility/mpi_utility.h"
 
 #include <iostream>
 #include <vector>
@@ -12,6 +13,7 @@
 #include <fstream>
 #include <algorithm>
 #include <sstream>
+#include <numeric>
 
 using namespace std;
 
@@ -310,3 +312,188 @@ return j;
 }
 
 
+
+namespace
+{
+//! header of the binary POD basis files, it is followed by the singular values and the row-major basis
+struct BasisFileHeader
+{
+  char magic[16];           //< "opendihuPODbasis"
+  long long nRowsGlobal;    //< number of rows of the basis
+  long long nModes;         //< number of modes, i.e. columns of the basis
+};
+
+const char basisFileMagic[] = "opendihuPODbasis";
+
+//! create a file type that selects the rows with the given global numbers, a row consists of nValuesPerRow doubles.
+//! The file view needs ascending displacements, permutation is set to the local row indices in the order of the file type
+void createRowsFileType(const vector<long long> &rowNosGlobal, long long nValuesPerRow, vector<int> &permutation, MPI_Datatype &rowType, MPI_Datatype &fileType)
+{
+  const int nRows = rowNosGlobal.size();
+  permutation.resize(nRows);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::sort(permutation.begin(), permutation.end(), [&rowNosGlobal](int a, int b)
+  {
+    return rowNosGlobal[a] < rowNosGlobal[b];
+  });
+
+  vector<int> displacements(nRows);
+  for (int i = 0; i < nRows; i++)
+  {
+    displacements[i] = rowNosGlobal[permutation[i]];
+  }
+
+  MPIUtility::handleReturnValue(MPI_Type_contiguous(nValuesPerRow, MPI_DOUBLE, &rowType), "MPI_Type_contiguous");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&rowType), "MPI_Type_commit");
+  MPIUtility::handleReturnValue(MPI_Type_create_indexed_block(nRows, 1, displacements.data(), rowType, &fileType), "MPI_Type_create_indexed_block");
+  MPIUtility::handleReturnValue(MPI_Type_commit(&fileType), "MPI_Type_commit");
+}
+}
+
+// writes the local rows of the basis collectively at the positions given by their global natural numbers, rank 0 writes the header and the singular values
+void SvdUtility::writeBasisBinary(string filename, const vector<double> &leftSingVec, const vector<double> &singVal,
+                                  const vector<long long> &rowNosGlobalNatural, long long nRowsGlobalPerComponent, int nComponents, MPI_Comm mpiCommunicator)
+{
+  int ownRankNo = 0;
+  MPIUtility::handleReturnValue(MPI_Comm_rank(mpiCommunicator, &ownRankNo), "MPI_Comm_rank");
+
+  const long long nModes = singVal.size();
+  const int nRowsLocalPerComponent = rowNosGlobalNatural.size();
+  const int nRowsLocal = nRowsLocalPerComponent*nComponents;
+
+  // in the file, the rows are ordered by component and then by global natural number, this does not depend on the partitioning
+  vector<long long> rowNosGlobal(nRowsLocal);
+  for (int componentNo = 0; componentNo < nComponents; componentNo++)
+  {
+    for (int i = 0; i < nRowsLocalPerComponent; i++)
+    {
+      rowNosGlobal[componentNo*nRowsLocalPerComponent + i] = componentNo*nRowsGlobalPerComponent + rowNosGlobalNatural[i];
+    }
+  }
+
+  MPI_File fileHandle;
+  MPIUtility::handleReturnValue(MPI_File_open(mpiCommunicator, filename.c_str(), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                              MPI_INFO_NULL, &fileHandle), "MPI_File_open");
+  MPIUtility::handleReturnValue(MPI_File_set_size(fileHandle, 0), "MPI_File_set_size");
+
+  const MPI_Offset headerSize = sizeof(BasisFileHeader) + nModes*sizeof(double);
+  if (ownRankNo == 0)
+  {
+    BasisFileHeader header;
+    std::copy(basisFileMagic, basisFileMagic+16, header.magic);
+    header.nRowsGlobal = nRowsGlobalPerComponent*nComponents;
+    header.nModes = nModes;
+
+    MPIUtility::handleReturnValue(MPI_File_write_at(fileHandle, 0, &header, sizeof(BasisFileHeader), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_write_at");
+    MPIUtility::handleReturnValue(MPI_File_write_at(fileHandle, sizeof(BasisFileHeader), singVal.data(), nModes, MPI_DOUBLE, MPI_STATUS_IGNORE), "MPI_File_write_at");
+  }
+
+  // all ranks have the same number of modes
+  if (nModes == 0)
+  {
+    MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+    return;
+  }
+
+  vector<int> permutation;
+  MPI_Datatype rowType, fileType;
+  createRowsFileType(rowNosGlobal, nModes, permutation, rowType, fileType);
+
+  // convert the local rows from column-major to row-major order, in the sorted order of the file type
+  vector<double> buffer((long long)nRowsLocal*nModes);
+  for (int i = 0; i < nRowsLocal; i++)
+  {
+    for (int modeNo = 0; modeNo < nModes; modeNo++)
+    {
+      buffer[(long long)i*nModes + modeNo] = leftSingVec[(long long)modeNo*nRowsLocal + permutation[i]];
+    }
+  }
+
+  MPIUtility::handleReturnValue(MPI_File_set_view(fileHandle, headerSize, MPI_DOUBLE, fileType, "native", MPI_INFO_NULL), "MPI_File_set_view");
+  MPIUtility::handleReturnValue(MPI_File_write_all(fileHandle, buffer.data(), buffer.size(), MPI_DOUBLE, MPI_STATUS_IGNORE), "MPI_File_write_all");
+
+  MPIUtility::handleReturnValue(MPI_Type_free(&fileType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_Type_free(&rowType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+}
+
+// reads the rows with the given global natural numbers collectively, every rank reads its own rows
+bool SvdUtility::readBasisBinary(string filename, const vector<long long> &rowNosGlobalNatural, int nModes, vector<double> &values, vector<double> &singVal,
+                                 MPI_Comm mpiCommunicator)
+{
+  MPI_File fileHandle;
+  if (MPI_File_open(mpiCommunicator, filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fileHandle) != MPI_SUCCESS)
+  {
+    LOG(ERROR) << "Could not open POD basis file \"" << filename << "\".";
+    return false;
+  }
+
+  BasisFileHeader header;
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle, 0, &header, sizeof(BasisFileHeader), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  if (!std::equal(basisFileMagic, basisFileMagic+16, header.magic))
+  {
+    LOG(ERROR) << "File \"" << filename << "\" is not a binary POD basis file.";
+    MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+    return false;
+  }
+
+  singVal.resize(header.nModes);
+  MPIUtility::handleReturnValue(MPI_File_read_at_all(fileHandle, sizeof(BasisFileHeader), singVal.data(), header.nModes, MPI_DOUBLE, MPI_STATUS_IGNORE), "MPI_File_read_at_all");
+
+  if (nModes > header.nModes)
+  {
+    LOG(WARNING) << "POD basis file \"" << filename << "\" contains " << header.nModes << " modes, but " << nModes << " modes are required. The remaining modes are set to zero.";
+  }
+
+  // only the rows that are contained in the file are read, the others are set to zero
+  const int nRows = rowNosGlobalNatural.size();
+  vector<long long> rowNosInFile;
+  vector<int> rowIndicesInFile;
+  for (int i = 0; i < nRows; i++)
+  {
+    if (rowNosGlobalNatural[i] < header.nRowsGlobal)
+    {
+      rowNosInFile.push_back(rowNosGlobalNatural[i]);
+      rowIndicesInFile.push_back(i);
+    }
+  }
+  if ((int)rowNosInFile.size() != nRows)
+  {
+    LOG(ERROR) << "POD basis file \"" << filename << "\" contains " << header.nRowsGlobal << " rows, but " << nRows - rowNosInFile.size()
+      << " required rows have higher numbers. The mesh differs from the mesh of the snapshots.";
+  }
+
+  values.assign((long long)nRows*nModes, 0.0);
+  if (header.nModes == 0)
+  {
+    MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+    return true;
+  }
+
+  // read all modes of the own rows with a file view that selects them
+  vector<int> permutation;
+  MPI_Datatype rowType, fileType;
+  createRowsFileType(rowNosInFile, header.nModes, permutation, rowType, fileType);
+
+  const MPI_Offset headerSize = sizeof(BasisFileHeader) + header.nModes*sizeof(double);
+  vector<double> buffer(rowNosInFile.size()*header.nModes);
+  MPIUtility::handleReturnValue(MPI_File_set_view(fileHandle, headerSize, MPI_DOUBLE, fileType, "native", MPI_INFO_NULL), "MPI_File_set_view");
+  MPIUtility::handleReturnValue(MPI_File_read_all(fileHandle, buffer.data(), buffer.size(), MPI_DOUBLE, MPI_STATUS_IGNORE), "MPI_File_read_all");
+
+  MPIUtility::handleReturnValue(MPI_Type_free(&fileType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_Type_free(&rowType), "MPI_Type_free");
+  MPIUtility::handleReturnValue(MPI_File_close(&fileHandle), "MPI_File_close");
+
+  // extract the first nModes modes and undo the sorting
+  const int nModesInFile = std::min((long long)nModes, header.nModes);
+  for (int i = 0; i < (int)rowNosInFile.size(); i++)
+  {
+    const int rowIndex = rowIndicesInFile[permutation[i]];
+    for (int modeNo = 0; modeNo < nModesInFile; modeNo++)
+    {
+      values[(long long)rowIndex*nModes + modeNo] = buffer[(long long)i*header.nModes + modeNo];
+    }
+  }
+  return true;
+}
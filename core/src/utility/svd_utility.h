@@ -6,6 +6,7 @@
 #include <lapacke.h>
 #endif
 
+#include <mpi.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <vector>
@@ -39,6 +40,17 @@ class SvdUtility
   static int getCSVRowCount(string filename);
 
   static int getCSVColumnCount(string filename);
+
+  //! collectively write a POD basis in binary format, the local rows of every component are given column-major in leftSingVec (rowNosGlobalNatural.size()*nComponents x nModes),
+  //! rowNosGlobalNatural are the global natural dof numbers of the local rows of one component. In the file, the rows are ordered by component and then by
+  //! global natural dof number, i.e. the file does not depend on the partitioning
+  static void writeBasisBinary(string filename, const vector<double> &leftSingVec, const vector<double> &singVal,
+                               const vector<long long> &rowNosGlobalNatural, long long nRowsGlobalPerComponent, int nComponents, MPI_Comm mpiCommunicator);
+
+  //! collectively read the rows with the given global natural numbers and the first nModes modes of a binary POD basis, the values are stored row-major (nRows x nModes)
+  //! modes or rows that are not in the file are set to zero, @return if the file could be read
+  static bool readBasisBinary(string filename, const vector<long long> &rowNosGlobalNatural, int nModes, vector<double> &values, vector<double> &singVal,
+                              MPI_Comm mpiCommunicator);
 };
 
 
@@ -54,6 +54,14 @@ std::array<Vc::double_v,N> getValuesAtIndices(const std::vector<std::array<doubl
 template<std::size_t N>
 std::array<double,N> getValuesAtIndices(const std::vector<std::array<double,N>> &values, int index);
 
+//! add multiple values to the entries of a normal vector, indices of -1 are ignored
+template<std::size_t N>
+void addValuesAtIndices(std::vector<std::array<double,N>> &values, Vc::int_v indices, const std::array<Vc::double_v,N> &valuesToAdd);
+
+//! add values to an entry of a normal vector
+template<std::size_t N>
+void addValuesAtIndices(std::vector<std::array<double,N>> &values, int index, const std::array<double,N> &valuesToAdd);
+
 //! comparison operator with double value, true if any of the components fulfills the conditions " < value"
 template<typename T, std::size_t N>
 bool operator<(const std::array<T,N> &vector, double value);
@@ -112,6 +112,34 @@ std::array<double,N> getValuesAtIndices(const std::vector<std::array<double,N>>
   return values[index];
 }
 
+//! add multiple values to the entries of a normal vector, indices of -1 are ignored
+template<std::size_t N>
+void addValuesAtIndices(std::vector<std::array<double,N>> &values, Vc::int_v indices, const std::array<Vc::double_v,N> &valuesToAdd)
+{
+  // the entries are added one after the other, because the same index can occur multiple times
+  for (int vcComponentNo = 0; vcComponentNo < Vc::double_v::size(); vcComponentNo++)
+  {
+    int index = indices[vcComponentNo];
+
+    if (index != -1)
+    {
+      for (int i = 0; i < N; i++)
+      {
+        values[index][i] += valuesToAdd[i][vcComponentNo];
+      }
+    }
+  }
+}
+
+template<std::size_t N>
+void addValuesAtIndices(std::vector<std::array<double,N>> &values, int index, const std::array<double,N> &valuesToAdd)
+{
+  for (int i = 0; i < N; i++)
+  {
+    values[index][i] += valuesToAdd[i];
+  }
+}
+
 
 //! component-wise division
 template<typename T, std::size_t nComponents>
@@ -144,6 +144,7 @@ config = {
     "maxAreaFactor":              max_area_factor,       # factor only for triangulation_type 1, approximately the minimum number of triangles that will be created because of a maximum triangle area constraint
     
     "improveMesh":                improve_mesh,          # smooth the 2D meshes, required for bigger meshes or larger amount of ranks
+    "useNativeMeshGeneration":    True,                  # create the 3D meshes of the subdomains in C++ with the algorithm of stl_create_mesh.py (default True), where this fails the python script is used, False always uses the python script
     "refinementFactors": [refinement,refinement,refinement],         # [2,2,2] factors in x,y,z direction by which the mesh should be refined prior to solving the laplace problem and tracing the streamlines
     "laplacianSmoothingNIterations": 10,                 # number of Laplacian smoothing iterations on the final fibers grid
     "ghostLayerWidth":            ghost_layer_width,     # width of the ghost layer of elements that is communicated between the subdomains, such that boundary streamlines do not leave the subdomains during tracing
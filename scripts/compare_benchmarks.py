@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# This script compares benchmark results, as written by testing/benchmarks (or Google Benchmark with --benchmark_format=json), to a stored baseline.
+# A benchmark is flagged as regression if its time increased by more than the tolerance and the increase is larger than the measurement noise,
+# i.e. twice the standard deviation of the repetitions. Counters that are durations ("duration_*") are compared in the same way.
+# The exit code is 1 if there is at least one regression, such that the script can be used in scripts or CI.
+#
+# usage: compare_benchmarks.py <baseline.json> <results.json> [<tolerance, default 0.1>]
+#
+
+import sys
+import json
+
+if len(sys.argv) < 3:
+  print("usage: {} <baseline.json> <results.json> [<tolerance, default 0.1>]".format(sys.argv[0]))
+  sys.exit(0)
+
+baseline_filename = sys.argv[1]
+results_filename = sys.argv[2]
+tolerance = 0.1
+if len(sys.argv) > 3:
+  tolerance = float(sys.argv[3])
+
+# factors to convert the time units to microseconds
+time_unit_factor = {"ns": 1e-3, "us": 1.0, "ms": 1e3, "s": 1e6}
+
+def load_results(filename):
+  """
+  load a json file with benchmark results, return the context and a dict name -> {"time", "stddev", "counters"}, all times in microseconds
+  """
+  with open(filename) as f:
+    data = json.load(f)
+
+  results = {}
+  for entry in data.get("benchmarks", []):
+
+    # Google Benchmark with repetitions writes aggregates, only use the median
+    name = entry["name"]
+    if entry.get("run_type") == "aggregate":
+      if entry.get("aggregate_name") != "median":
+        continue
+      name = entry.get("run_name", name)
+
+    factor = time_unit_factor.get(entry.get("time_unit", "us"), 1.0)
+    counters = {key: value for key, value in entry.items() if key.startswith("duration_")}
+
+    results[name] = {
+      "time": entry["real_time"]*factor,
+      "stddev": entry.get("real_time_stddev", 0.0)*factor,
+      "counters": counters,
+    }
+  return data.get("context", {}), results
+
+baseline_context, baseline = load_results(baseline_filename)
+context, results = load_results(results_filename)
+
+# warn if the results were obtained in a different setting
+for key in ["host_name", "num_ranks", "build_type"]:
+  if key in baseline_context and key in context and baseline_context[key] != context[key]:
+    print("Warning: \"{}\" differs, baseline: {}, results: {}".format(key, baseline_context[key], context[key]))
+
+def is_regression(old_value, new_value, noise):
+  """
+  check if the new value is slower than the old value by more than the tolerance and the noise
+  """
+  return new_value > old_value*(1+tolerance) and new_value - old_value > noise
+
+regressions = []
+improvements = []
+
+print("{:<80} {:>14} {:>14} {:>9}".format("benchmark", "baseline [us]", "result [us]", "change"))
+for name in sorted(results.keys()):
+  if name not in baseline:
+    print("{:<80} {:>14} {:>14.2f}".format(name, "-", results[name]["time"]))
+    continue
+
+  old = baseline[name]
+  new = results[name]
+  noise = 2*max(old["stddev"], new["stddev"])
+  change = (new["time"] - old["time"]) / old["time"] if old["time"] > 0 else 0.0
+
+  flag = ""
+  if is_regression(old["time"], new["time"], noise):
+    flag = "REGRESSION"
+    regressions.append(name)
+  elif is_regression(new["time"], old["time"], noise):
+    flag = "improved"
+    improvements.append(name)
+
+  print("{:<80} {:>14.2f} {:>14.2f} {:>+8.1f}% {}".format(name, old["time"], new["time"], 100*change, flag))
+
+  # compare the measured durations of parts of the benchmark, e.g. duration_0D and duration_1D
+  for counter_name in sorted(new["counters"].keys()):
+    if counter_name not in old["counters"]:
+      continue
+    old_value = old["counters"][counter_name]
+    new_value = new["counters"][counter_name]
+    counter_change = (new_value - old_value) / old_value if old_value > 0 else 0.0
+
+    # the counters have no own standard deviation, use the noise of the total time
+    counter_flag = ""
+    if is_regression(old_value, new_value, noise):
+      counter_flag = "REGRESSION"
+      regressions.append("{} ({})".format(name, counter_name))
+
+    print("  {:<78} {:>14.2f} {:>14.2f} {:>+8.1f}% {}".format(counter_name, old_value, new_value, 100*counter_change, counter_flag))
+
+missing = [name for name in baseline.keys() if name not in results]
+if missing:
+  print("\nBenchmarks in the baseline without result: {}".format(", ".join(sorted(missing))))
+
+print("\n{} benchmarks compared, tolerance {:.0f}%: {} regressions, {} improvements".format(
+  len([name for name in results if name in baseline]), 100*tolerance, len(regressions), len(improvements)))
+
+if regressions:
+  print("Regressions:")
+  for name in regressions:
+    print("  {}".format(name))
+  sys.exit(1)
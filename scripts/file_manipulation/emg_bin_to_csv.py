@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# This script converts the binary file of sampled EMG values, that is written by OutputSurface with "enableBufferedSampling": True,
+# to the csv format of OutputSurface with "enableGeometryInCsvFile": False. The csv file can then be plotted with plot_emg.py.
+# usage: emg_bin_to_csv.py <input.bin> [<output.csv>]
+#
+
+import sys, os
+import datetime
+import struct
+
+if len(sys.argv) < 2:
+  print("usage: {} <input.bin> [<output.csv>]".format(sys.argv[0]))
+  sys.exit(0)
+
+input_filename = sys.argv[1]
+output_filename = os.path.splitext(input_filename)[0] + ".csv"
+if len(sys.argv) > 2:
+  output_filename = sys.argv[2]
+
+# read file
+# header: char[8] "EMGBUF01", int32 n_points, int32 sampling_point_no[n_points], double position[n_points][3]
+# records: double t, double value[n_points]
+with open(input_filename, "rb") as infile:
+  magic = infile.read(8)
+  if magic != b"EMGBUF01":
+    print("Error: \"{}\" is not a buffered EMG sampling file.".format(input_filename))
+    sys.exit(1)
+
+  n_points = struct.unpack("i", infile.read(4))[0]
+  point_nos = struct.unpack("{}i".format(n_points), infile.read(4*n_points))
+  positions = struct.unpack("{}d".format(3*n_points), infile.read(8*3*n_points))
+
+  # read all records, drop an incomplete last record, e.g. if the simulation was aborted
+  records = []
+  record_size = 8*(n_points+1)
+  while True:
+    data = infile.read(record_size)
+    if len(data) < record_size:
+      break
+    records.append(struct.unpack("{}d".format(n_points+1), data))
+
+n_records = len(records)
+print("{}: {} points (sampling point nos {}...{}), {} samples".format(input_filename, n_points,
+  min(point_nos) if n_points > 0 else "-", max(point_nos) if n_points > 0 else "-", n_records))
+
+# write csv file in the same format as OutputPoints::writeCsvFile
+timestamp = datetime.datetime.now().strftime("%Y/%m/%d %H:%M:%S")
+with open(output_filename, "w") as outfile:
+  outfile.write("#electrode positions (x0,y0,z0,x1,y1,z1,...);\n#; ")
+  for value in positions:
+    outfile.write(";{}".format(value))
+  outfile.write("\n")
+
+  outfile.write("#timestamp;t;n_points")
+  for point_no in range(n_points):
+    outfile.write(";p{}_value".format(point_no))
+  outfile.write("\n")
+
+  for record in records:
+    outfile.write("{};{};{}".format(timestamp, record[0], n_points))
+    outfile.write("".join(";{}".format(value) for value in record[1:]))
+    outfile.write("\n")
+
+print("Wrote \"{}\".".format(output_filename))
@@ -6,6 +6,7 @@
 #
 
 import pickle, json
+import os
 import copy
 import numpy as np
 
@@ -57,6 +58,88 @@ def get_min_max(data, field_variable_name, component_name):
         break
   return min_value, max_value
   
+def load_numpy_blocks(filename):
+  """
+    Load the blocks of a binary *.npys file as they are stored, without reconstructing delta encoded values.
+    :param filename: the filename
+    :return: a list with a tuple (meta data dict, list of arrays) for every block, i.e. for every rank that is contained in the file
+  """
+  blocks = []
+  with open(filename,'rb') as f:
+    file_size = os.fstat(f.fileno()).st_size
+    
+    # read blocks until the end of the file, a combined file contains the blocks of all ranks
+    while f.tell() < file_size:
+      dict_from_file = json.loads(np.load(f).tobytes().decode('utf-8'))
+      
+      # one array per field variable, or two arrays (chunk sources, chunk values) for delta encoded files
+      n_arrays_per_field_variable = 2 if 'delta' in dict_from_file else 1
+      arrays = [np.load(f) for _ in range(n_arrays_per_field_variable*len(dict_from_file['data']))]
+      blocks.append((dict_from_file, arrays))
+  return blocks
+  
+def get_stored_chunk(chunk_sources, chunk_values, chunk_no, chunk_size):
+  """
+    Get the values of a chunk that is stored in a delta encoded block, i.e. that has chunk source -1.
+    All chunks except the last have chunk_size values, therefore the position follows from the number of stored chunks before.
+  """
+  begin = np.count_nonzero(chunk_sources[:chunk_no] == -1) * chunk_size
+  return chunk_values[begin:begin+chunk_size]
+  
+def load_numpy_file(filename, block_cache=None):
+  """
+    Load a binary *.npys file that was written with the option "numpy": True.
+    The file contains for every rank a block with the json encoded meta data followed by one array per field variable.
+    Files that were written with "deltaOutput": True are reconstructed to the full values, the unchanged chunks are read from the referenced files
+    in the same directory, from the block at the same position, i.e. of the same rank.
+    :param filename: the filename
+    :param block_cache: optional dict from filename to the result of load_numpy_blocks, to avoid reading referenced files multiple times
+    :return: a list of dicts, one for every rank that is contained in the file
+  """
+  if block_cache is None:
+    block_cache = {}
+  
+  result = []
+  for block_no,(dict_from_file,arrays) in enumerate(load_numpy_blocks(filename)):
+    
+    # full values, the values of a field variable are stored as array with shape (n_components, n_values)
+    if 'delta' not in dict_from_file:
+      for field_variable,values in zip(dict_from_file['data'], arrays):
+        for component_index,component in enumerate(field_variable['components']):
+          component['values'] = values[component_index]
+      result.append(dict_from_file)
+      continue
+    
+    # delta encoded values, collect the chunks from this block and from the referenced files
+    delta = dict_from_file.pop('delta')
+    chunk_size = delta['chunkSize']
+    referenced_blocks = []
+    for referenced_filename in delta['referencedFiles']:
+      referenced_filename = os.path.join(os.path.dirname(filename), referenced_filename)
+      if referenced_filename not in block_cache:
+        block_cache[referenced_filename] = load_numpy_blocks(referenced_filename)
+      referenced_blocks.append(block_cache[referenced_filename][block_no])
+    
+    for field_variable_no,field_variable in enumerate(dict_from_file['data']):
+      chunk_sources = arrays[2*field_variable_no]
+      chunk_values = arrays[2*field_variable_no+1]
+      
+      chunks = []
+      for chunk_no,chunk_source in enumerate(chunk_sources):
+        if chunk_source == -1:
+          chunks.append(get_stored_chunk(chunk_sources, chunk_values, chunk_no, chunk_size))
+        else:
+          # the referenced block stores the chunk itself
+          referenced_arrays = referenced_blocks[chunk_source][1]
+          chunks.append(get_stored_chunk(referenced_arrays[2*field_variable_no], referenced_arrays[2*field_variable_no+1], chunk_no, chunk_size))
+      
+      values = np.concatenate(chunks) if len(chunks) > 0 else np.zeros(0)
+      values = values.reshape(delta['shapes'][field_variable_no])
+      for component_index,component in enumerate(field_variable['components']):
+        component['values'] = values[component_index]
+    result.append(dict_from_file)
+  return result
+
 def load_data(filenames):
   """
     Load raw data structures from opendihu *.py output files.
@@ -66,6 +149,9 @@ def load_data(filenames):
   """
   loaded_data = []
 
+  # blocks of *.npys files that are referenced by delta encoded files, shared by all files
+  numpy_block_cache = {}
+
   # group parallel files
   grouped_filenames = []  # each item is [<base_filename>, [<filename0>, <filename1>, ...]]
   for filename in filenames:
@@ -73,6 +159,8 @@ def load_data(filenames):
       continue
     rank_no = 0
     pos_last_point = filename.rfind(".py")
+    if filename.endswith(".npys"):
+      pos_last_point = filename.rfind(".npys")
     pos_2ndlast_point = filename.rfind(".", 0, pos_last_point)
     
     bucket_found = False
@@ -101,6 +189,15 @@ def load_data(filenames):
     # load py files of current group
     for filename in filenames:
 
+      # binary files with numpy arrays, a combined file contains the data of all ranks
+      if filename.endswith(".npys"):
+        # a missing or truncated file or a block that is not in the expected format is skipped, other errors are raised
+        try:
+          group_data += load_numpy_file(filename, numpy_block_cache)
+        except (OSError, EOFError, ValueError, KeyError, IndexError) as e:
+          print("Could not parse file \"{}\": {}".format(filename, e))
+        continue
+
       # try to load file content using json, this works if it is an ascii file
       try:
         with open(filename,'r') as f:
@@ -110,7 +207,7 @@ def load_data(filenames):
         try: 
           with open(filename,'rb') as f:
             dict_from_file = pickle.load(f)
-        except:
+        except (OSError, EOFError, ValueError, TypeError, AttributeError, ImportError, IndexError, pickle.UnpicklingError):
           
           # loading did not work either way
           dict_from_file = None
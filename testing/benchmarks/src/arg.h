@@ -0,0 +1,4 @@
+#pragma once
+
+extern int argc;
+extern char** argv;
@@ -0,0 +1,382 @@
+#include "benchmark.h"
+
+#include <mpi.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+namespace Benchmark
+{
+
+namespace
+{
+
+//! get the maximum of a value over all ranks, the value is unchanged if MPI is not initialized
+double maximumOverAllRanks(double value)
+{
+  int mpiIsInitialized = 0;
+  MPI_Initialized(&mpiIsInitialized);
+  if (!mpiIsInitialized)
+    return value;
+
+  double result = value;
+  MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  return result;
+}
+
+//! get the own rank no and the number of ranks in MPI_COMM_WORLD, 0 and 1 if MPI is not initialized
+void getRankNo(int &ownRankNo, int &nRanks)
+{
+  ownRankNo = 0;
+  nRanks = 1;
+
+  int mpiIsInitialized = 0;
+  MPI_Initialized(&mpiIsInitialized);
+  if (mpiIsInitialized)
+  {
+    MPI_Comm_rank(MPI_COMM_WORLD, &ownRankNo);
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+  }
+}
+
+//! escape a string for the use in a json file
+std::string escapeJson(const std::string &str)
+{
+  std::stringstream result;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      result << '\\' << c;
+    else if (c == '\n')
+      result << "\\n";
+    else
+      result << c;
+  }
+  return result.str();
+}
+
+//! the result of a benchmark, as it is written to the output file
+struct BenchmarkResult
+{
+  std::string name;                               //< name of the benchmark
+  long long iterations;                           //< number of iterations per repetition
+  int repetitions;                                //< number of repetitions
+  double timePerIteration;                        //< median time per iteration in s
+  double minimumTimePerIteration;                 //< minimum time per iteration in s
+  double standardDeviation;                       //< standard deviation of the time per iteration in s
+  std::map<std::string,double> counters;          //< user defined counters
+  std::string label;                              //< user defined label
+};
+
+//! write the results in the json format of Google Benchmark, all times are in microseconds
+void writeJsonFile(std::string filename, const std::vector<BenchmarkResult> &results, int nRanks, const char *executable)
+{
+  std::ofstream file(filename);
+  if (!file.is_open())
+  {
+    std::cerr << "Could not write benchmark results to \"" << filename << "\"." << std::endl;
+    return;
+  }
+
+  char hostname[256] = "";
+  gethostname(hostname, 255);
+
+  std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#ifdef NDEBUG
+  const char *buildType = "release";
+#else
+  const char *buildType = "debug";
+#endif
+
+  file << std::setprecision(10)
+    << "{\n"
+    << "  \"context\": {\n"
+    << "    \"date\": \"" << date << "\",\n"
+    << "    \"host_name\": \"" << escapeJson(hostname) << "\",\n"
+    << "    \"executable\": \"" << escapeJson(executable) << "\",\n"
+    << "    \"build_type\": \"" << buildType << "\",\n"
+    << "    \"num_ranks\": " << nRanks << "\n"
+    << "  },\n"
+    << "  \"benchmarks\": [";
+
+  for (std::size_t i = 0; i < results.size(); i++)
+  {
+    const BenchmarkResult &result = results[i];
+    file << (i == 0? "\n" : ",\n")
+      << "    {\n"
+      << "      \"name\": \"" << escapeJson(result.name) << "\",\n"
+      << "      \"iterations\": " << result.iterations << ",\n"
+      << "      \"repetitions\": " << result.repetitions << ",\n"
+      << "      \"real_time\": " << result.timePerIteration*1e6 << ",\n"
+      << "      \"real_time_min\": " << result.minimumTimePerIteration*1e6 << ",\n"
+      << "      \"real_time_stddev\": " << result.standardDeviation*1e6 << ",\n";
+
+    for (const std::pair<const std::string,double> &counter : result.counters)
+    {
+      file << "      \"" << escapeJson(counter.first) << "\": " << counter.second << ",\n";
+    }
+
+    file << "      \"label\": \"" << escapeJson(result.label) << "\",\n"
+      << "      \"time_unit\": \"us\"\n"
+      << "    }";
+  }
+  file << "\n  ]\n}\n";
+}
+
+}  // anonymous namespace
+
+State::State(double minimumTime, int nRepetitions) :
+  minimumTime_(minimumTime), nRepetitions_(std::max(1,nRepetitions)), isCalibrating_(true), isStarted_(false),
+  batchSize_(1), iterationNoInBatch_(0), nIterationsTotal_(0), batchDuration_(0), isPaused_(false)
+{
+}
+
+bool State::keepRunning()
+{
+  if (!isStarted_)
+  {
+    isStarted_ = true;
+  }
+  else
+  {
+    iterationNoInBatch_++;
+    nIterationsTotal_++;
+
+    // if the current batch is not yet finished, continue
+    if (iterationNoInBatch_ < batchSize_)
+      return true;
+
+    // the batch is finished, stop the timer
+    if (!isPaused_)
+      batchDuration_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart_).count();
+
+    if (!finishBatch())
+      return false;
+  }
+
+  // start the next batch
+  iterationNoInBatch_ = 0;
+  batchDuration_ = 0;
+  isPaused_ = false;
+  tStart_ = std::chrono::steady_clock::now();
+  return true;
+}
+
+bool State::finishBatch()
+{
+  // all ranks have to take the same decisions, use the duration of the slowest rank
+  const double duration = maximumOverAllRanks(batchDuration_);
+
+  if (isCalibrating_)
+  {
+    // if the batch was long enough, keep the batch size for the measured repetitions
+    if (duration >= minimumTime_)
+    {
+      isCalibrating_ = false;
+    }
+    else
+    {
+      // increase the batch size, estimate the needed size from the current duration but grow by at most a factor of 10
+      double factor = 10;
+      if (duration > 0)
+        factor = std::min(10.0, std::max(2.0, 1.4*minimumTime_/duration));
+      batchSize_ = (long long)std::ceil(batchSize_*factor);
+    }
+    return true;
+  }
+
+  timesPerIteration_.push_back(duration / batchSize_);
+  return (int)timesPerIteration_.size() < nRepetitions_;
+}
+
+void State::pauseTiming()
+{
+  if (!isPaused_)
+  {
+    batchDuration_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart_).count();
+    isPaused_ = true;
+  }
+}
+
+void State::resumeTiming()
+{
+  if (isPaused_)
+  {
+    tStart_ = std::chrono::steady_clock::now();
+    isPaused_ = false;
+  }
+}
+
+void State::setCounter(std::string name, double value)
+{
+  counters_[name] = value;
+}
+
+void State::setLabel(std::string label)
+{
+  label_ = label;
+}
+
+long long State::iterations() const
+{
+  return nIterationsTotal_;
+}
+
+double State::timePerIteration() const
+{
+  if (timesPerIteration_.empty())
+    return 0;
+
+  std::vector<double> times(timesPerIteration_);
+  std::sort(times.begin(), times.end());
+
+  const int n = times.size();
+  if (n % 2 == 1)
+    return times[n/2];
+  return 0.5*(times[n/2-1] + times[n/2]);
+}
+
+double State::minimumTimePerIteration() const
+{
+  if (timesPerIteration_.empty())
+    return 0;
+  return *std::min_element(timesPerIteration_.begin(), timesPerIteration_.end());
+}
+
+double State::standardDeviation() const
+{
+  const int n = timesPerIteration_.size();
+  if (n < 2)
+    return 0;
+
+  double mean = 0;
+  for (double time : timesPerIteration_)
+    mean += time;
+  mean /= n;
+
+  double variance = 0;
+  for (double time : timesPerIteration_)
+    variance += (time - mean)*(time - mean);
+  return std::sqrt(variance / (n-1));
+}
+
+long long State::nIterationsPerRepetition() const
+{
+  return batchSize_;
+}
+
+const std::map<std::string,double> &State::counters() const
+{
+  return counters_;
+}
+
+const std::string &State::label() const
+{
+  return label_;
+}
+
+Registration::Registration(std::string name, std::function<void(State &)> function)
+{
+  registeredBenchmarks().push_back(BenchmarkEntry{name, function});
+}
+
+std::vector<BenchmarkEntry> &registeredBenchmarks()
+{
+  static std::vector<BenchmarkEntry> benchmarks;
+  return benchmarks;
+}
+
+int runAllBenchmarks(int &argc, char **argv)
+{
+  std::string filter = ".*";
+  std::string outputFilename = "benchmarks.json";
+  double minimumTime = 0.5;
+  int nRepetitions = 5;
+  bool onlyList = false;
+
+  // parse and remove the own command line arguments, such that the remaining arguments can be passed on to DihuContext
+  int nRemainingArguments = 1;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string argument(argv[i]);
+    std::string value;
+    std::size_t pos = argument.find("=");
+    if (pos != std::string::npos)
+      value = argument.substr(pos+1);
+
+    if (argument.find("--benchmark_filter=") == 0)
+      filter = value;
+    else if (argument.find("--benchmark_out=") == 0)
+      outputFilename = value;
+    else if (argument.find("--benchmark_min_time=") == 0)
+      minimumTime = atof(value.c_str());
+    else if (argument.find("--benchmark_repetitions=") == 0)
+      nRepetitions = atoi(value.c_str());
+    else if (argument == "--benchmark_list")
+      onlyList = true;
+    else
+      argv[nRemainingArguments++] = argv[i];
+  }
+  argc = nRemainingArguments;
+
+  std::regex filterRegex(filter);
+  std::vector<BenchmarkResult> results;
+
+  for (const BenchmarkEntry &benchmark : registeredBenchmarks())
+  {
+    if (!std::regex_search(benchmark.name, filterRegex))
+      continue;
+
+    if (onlyList)
+    {
+      std::cout << benchmark.name << std::endl;
+      continue;
+    }
+
+    State state(minimumTime, nRepetitions);
+    benchmark.function(state);
+
+    BenchmarkResult result{benchmark.name, state.nIterationsPerRepetition(), (int)std::max(1,nRepetitions),
+      state.timePerIteration(), state.minimumTimePerIteration(), state.standardDeviation(), state.counters(), state.label()};
+    results.push_back(result);
+
+    int ownRankNo, nRanks;
+    getRankNo(ownRankNo, nRanks);
+    if (ownRankNo == 0)
+    {
+      std::cout << std::left << std::setw(70) << result.name << std::right
+        << std::setw(14) << std::fixed << std::setprecision(2) << result.timePerIteration*1e6 << " us"
+        << " +- " << std::setw(10) << result.standardDeviation*1e6 << " us"
+        << std::setw(10) << result.iterations << " it.";
+      for (const std::pair<const std::string,double> &counter : result.counters)
+      {
+        std::cout << "  " << counter.first << "=" << std::defaultfloat << std::setprecision(6) << counter.second;
+      }
+      std::cout << std::defaultfloat << std::endl;
+    }
+  }
+
+  if (onlyList)
+    return EXIT_SUCCESS;
+
+  int ownRankNo, nRanks;
+  getRankNo(ownRankNo, nRanks);
+  if (ownRankNo == 0)
+  {
+    writeJsonFile(outputFilename, results, nRanks, argv[0]);
+    std::cout << "Wrote " << results.size() << " benchmark results to \"" << outputFilename << "\"." << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
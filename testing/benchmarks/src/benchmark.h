@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/** A minimal micro benchmark harness in the style of Google Benchmark.
+ *  A benchmark is a function that gets a State object. It does its setup, then runs the measured code in a loop
+ *  `while (state.keepRunning()) { ... }` and finally can add counters, e.g. durations that were measured by Control::PerformanceMeasurement.
+ *
+ *  The number of iterations is determined by the harness: The loop is first run with increasing batch sizes until one batch takes at least the minimum time.
+ *  Then, the batch is run `repetitions` times, the reported time per iteration is the median over the repetitions.
+ *  All decisions are made collectively over MPI_COMM_WORLD with the maximum duration of all ranks, such that benchmarks may contain collective operations.
+ *
+ *  Register a benchmark function with BENCHMARK(function) at file scope, template instances can be given directly, e.g. BENCHMARK(function<3,double>).
+ */
+namespace Benchmark
+{
+
+/** The state of a running benchmark, controls the benchmark loop.
+ */
+class State
+{
+public:
+  //! constructor
+  State(double minimumTime, int nRepetitions);
+
+  //! returns true as long as the measured loop should continue, starts and stops the timer
+  bool keepRunning();
+
+  //! pause the timer, e.g. to reset data that should not be part of the measurement, has to be called inside the loop
+  void pauseTiming();
+
+  //! resume the timer after pauseTiming
+  void resumeTiming();
+
+  //! set a user defined counter, e.g. a duration per iteration, counters of the same name are overwritten
+  void setCounter(std::string name, double value);
+
+  //! set a label that is added to the result, e.g. the problem size
+  void setLabel(std::string label);
+
+  //! get the total number of iterations of the loop so far, including the calibration phase
+  long long iterations() const;
+
+  //! the median time per iteration over all repetitions in seconds
+  double timePerIteration() const;
+
+  //! the minimum time per iteration over all repetitions in seconds
+  double minimumTimePerIteration() const;
+
+  //! the standard deviation of the time per iteration over all repetitions in seconds
+  double standardDeviation() const;
+
+  //! the number of iterations per repetition
+  long long nIterationsPerRepetition() const;
+
+  //! the user defined counters
+  const std::map<std::string,double> &counters() const;
+
+  //! the label
+  const std::string &label() const;
+
+private:
+
+  //! stop the timer of the current batch and decide how to continue, returns if another batch should be run
+  bool finishBatch();
+
+  double minimumTime_;                  //< minimum duration of one batch in seconds
+  int nRepetitions_;                    //< number of batches that are measured after the calibration
+
+  bool isCalibrating_;                  //< if the batch size is still being determined
+  bool isStarted_;                      //< if keepRunning was called at least once
+  long long batchSize_;                 //< number of iterations of the current batch
+  long long iterationNoInBatch_;        //< number of the current iteration in the current batch
+  long long nIterationsTotal_;          //< total number of iterations so far
+
+  std::chrono::time_point<std::chrono::steady_clock> tStart_;   //< start of the current timing interval
+  double batchDuration_;                //< accumulated duration of the current batch, without paused intervals
+  bool isPaused_;                       //< if pauseTiming was called
+
+  std::vector<double> timesPerIteration_;           //< the measured times per iteration for all finished repetitions
+  std::map<std::string,double> counters_;           //< user defined counters
+  std::string label_;                               //< user defined label
+};
+
+/** A registered benchmark
+ */
+struct BenchmarkEntry
+{
+  std::string name;                               //< name of the benchmark, the string of the function
+  std::function<void(State &)> function;          //< the function that contains the benchmark loop
+};
+
+/** Helper to register benchmarks at static initialization time, used by the BENCHMARK macro.
+ */
+class Registration
+{
+public:
+  //! constructor, adds the benchmark to the global list
+  Registration(std::string name, std::function<void(State &)> function);
+};
+
+//! get the list of all registered benchmarks
+std::vector<BenchmarkEntry> &registeredBenchmarks();
+
+//! parse the options that start with "--benchmark_", remove them from argc/argv, run all selected benchmarks and write the results, returns the exit code
+int runAllBenchmarks(int &argc, char **argv);
+
+}  // namespace
+
+#define BENCHMARK_CONCATENATE_(a,b) a##b
+#define BENCHMARK_CONCATENATE(a,b) BENCHMARK_CONCATENATE_(a,b)
+
+//! register a benchmark function with signature void(Benchmark::State &), use at file scope
+#define BENCHMARK(...) \
+  static Benchmark::Registration BENCHMARK_CONCATENATE(benchmarkRegistration_, __COUNTER__)(#__VA_ARGS__, __VA_ARGS__)
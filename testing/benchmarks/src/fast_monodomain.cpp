@@ -0,0 +1,266 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+#include "opendihu.h"
+#include "arg.h"
+#include "benchmark.h"
+
+namespace
+{
+
+// settings of the FastMonodomainSolver, the same setup as in the unit test CellMLTest.FastFibersVc, but with more and longer fibers and without output
+// the variables model_filename, n_fibers, n_elements and the parameters of the CellML model are prepended
+const char *fastMonodomainSettings = R"(
+import sys
+
+rank_no = int(sys.argv[-2])
+n_ranks = int(sys.argv[-1])
+
+dt_0D = 1e-4                      # timestep width of ODEs, cellml integration
+dt_1D = 1e-3                      # timestep width of diffusion
+dt_splitting = 1e-3               # timestep width of strang splitting, one call to advanceTimeSpan
+stimulation_frequency = 100*1e-3  # [Hz]*1e-3 = [ms^-1]
+
+fiber_distribution_file = "../../unit_testing/input/MU_fibre_distribution_10MUs.txt"
+firing_times_file = "../../unit_testing/input/MU_firing_times_always.txt"
+
+# the stimulation is handled by the FastMonodomainSolver itself, the callback is not called
+def set_specific_states(n_nodes_global, time_step_no, current_time, states, fiber_no):
+  pass
+
+config = {
+  "scenarioName": "benchmark",
+  "Meshes": {
+    "MeshFiber_{}".format(fiber_no): {
+      "nElements":         [n_elements],
+      "physicalExtent":    [n_elements/100.],
+      "inputMeshIsGlobal": True,
+    }
+    for fiber_no in range(n_fibers)
+  },
+  "Solvers": {
+    "implicitSolver": {     # solver for the implicit timestepping scheme of the diffusion time step
+      "maxIterations":      1e4,
+      "relativeTolerance":  1e-10,
+      "dumpFormat":         "",
+      "dumpFilename":       "",
+      "solverType":         "gmres",
+      "preconditionerType": "none",
+    },
+  },
+  "MultipleInstances": {
+    "ranksAllComputedInstances":  list(range(n_ranks)),
+    "nInstances":                 n_fibers,
+    "instances":
+    [{
+      "ranks": [fiber_no % n_ranks],
+      "StrangSplitting": {
+        "timeStepWidth":          dt_splitting,
+        "timeStepOutputInterval": 1e4,
+        "endTime":                dt_splitting,
+        "connectedSlotsTerm1To2": [0],   # transfer slot 0 = state Vm from Term1 (CellML) to Term2 (Diffusion)
+        "connectedSlotsTerm2To1": [0],   # transfer the same back
+
+        "Term1": {      # CellML, i.e. reaction term of Monodomain equation
+          "MultipleInstances": {
+            "logKey":             "duration_subdomains_z",
+            "nInstances":         1,
+            "instances":
+            [{
+              "ranks":                          [0],    # these rank nos are local nos to the outer instance of MultipleInstances
+              "Heun" : {
+                "timeStepWidth":                dt_0D,
+                "logTimeStepWidthAsKey":        "dt_0D",
+                "durationLogKey":               "duration_0D",
+                "initialValues":                [],
+                "timeStepOutputInterval":       1e4,
+                "inputMeshIsGlobal":            True,
+                "dirichletBoundaryConditions":  {},
+
+                "CellML" : {
+                  "modelFilename":                          model_filename,
+                  "optimizationType":                       "vc",
+                  "approximateExponentialFunction":         True,
+                  "compilerFlags":                          "-fPIC -O3 -march=native -shared ",
+                  "maximumNumberOfThreads":                 0,
+
+                  "setSpecificStatesFunction":              set_specific_states,
+                  "setSpecificStatesCallInterval":          0,
+                  "setSpecificStatesCallFrequency":         stimulation_frequency,
+                  "setSpecificStatesFrequencyJitter":       0,
+                  "setSpecificStatesRepeatAfterFirstCall":  0.1,
+                  "setSpecificStatesCallEnableBegin":       0,
+                  "additionalArgument":                     fiber_no,
+                  "stimulationLogFilename":                 "out/stimulation_log.txt",
+
+                  "algebraicsForTransfer":                  [],
+                  "statesForTransfer":                      0,      # state 0 = Vm for both Shorten and Hodgkin-Huxley
+                  "parametersUsedAsAlgebraic":              parameters_used_as_algebraic,
+                  "parametersUsedAsConstant":               parameters_used_as_constant,
+                  "parametersInitialValues":                parameters_initial_values,
+                  "meshName":                               "MeshFiber_{}".format(fiber_no),
+                },
+              },
+            }],
+          }
+        },
+        "Term2": {     # Diffusion
+          "MultipleInstances": {
+            "nInstances": 1,
+            "instances":
+            [{
+              "ranks":                         [0],
+              "ImplicitEuler" : {
+                "initialValues":               [],
+                "timeStepWidth":               dt_1D,
+                "timeStepWidthRelativeTolerance": 1e-10,
+                "logTimeStepWidthAsKey":       "dt_1D",
+                "durationLogKey":              "duration_1D",
+                "timeStepOutputInterval":      1e4,
+                "dirichletBoundaryConditions": {},
+                "inputMeshIsGlobal":           True,
+                "solverName":                  "implicitSolver",
+                "FiniteElementMethod" : {
+                  "maxIterations":             1e4,
+                  "relativeTolerance":         1e-10,
+                  "inputMeshIsGlobal":         True,
+                  "meshName":                  "MeshFiber_{}".format(fiber_no),
+                  "prefactor":                 0.03,  # resolves to Conductivity / (Am * Cm)
+                  "solverName":                "implicitSolver",
+                },
+                "OutputWriter" : [],
+              },
+            }],
+          },
+        },
+      }
+    } for fiber_no in range(n_fibers)],
+    "OutputWriter" : [],
+  },
+  "fiberDistributionFile":    fiber_distribution_file,
+  "firingTimesFile":          firing_times_file,
+  "onlyComputeIfHasBeenStimulated": False,                          # compute all fibers, such that the timing does not depend on the stimulation
+  "disableComputationWhenStatesAreCloseToEquilibrium": False,       # compute all points, such that the timing does not depend on the state
+}
+)";
+
+/** One splitting time step (compute0D and compute1D) of the FastMonodomainSolver for nFibers fibers with nElements elements each.
+ *  The durations of the 0D and 1D parts are reported per time step as counters "duration_0D" and "duration_1D".
+ *  pointBufferLayout is the value of the option with the same name, "consecutive" or "tiled".
+ */
+template<int nStates, int nAlgebraics>
+void fastMonodomainSolver(Benchmark::State &state, std::string modelSettings, int nFibers, int nElements, std::string pointBufferLayout)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << "n_fibers = " << nFibers << "\n"
+    << "n_elements = " << nElements << "\n"
+    << modelSettings << "\n"
+    << fastMonodomainSettings << "\n"
+    << "config[\"pointBufferLayout\"] = \"" << pointBufferLayout << "\"\n"
+    << "config[\"nFibersPerTile\"] = 4\n";
+
+  DihuContext settings(argc, argv, pythonConfig.str());
+
+  FastMonodomainSolver<
+    Control::MultipleInstances<                       // fibers
+      OperatorSplitting::Strang<
+        Control::MultipleInstances<
+          TimeSteppingScheme::Heun<                   // fiber reaction term
+            CellmlAdapter<
+              nStates, nAlgebraics,
+              FunctionSpace::FunctionSpace<
+                Mesh::StructuredDeformableOfDimension<1>,
+                BasisFunction::LagrangeOfOrder<1>
+              >
+            >
+          >
+        >,
+        Control::MultipleInstances<
+          TimeSteppingScheme::ImplicitEuler<          // fiber diffusion
+            SpatialDiscretization::FiniteElementMethod<
+              Mesh::StructuredDeformableOfDimension<1>,
+              BasisFunction::LagrangeOfOrder<1>,
+              Quadrature::Gauss<2>,
+              Equation::Dynamic::IsotropicDiffusion
+            >
+          >
+        >
+      >
+    >
+  > problem(settings);
+
+  // this also generates and compiles the code of the CellML model
+  problem.initialize();
+
+  const double timeStepWidth = problem.endTime() - problem.startTime();
+  double currentTime = 0;
+
+  // the 0D and 1D parts are measured by the solver itself
+  const double duration0DStart = Control::PerformanceMeasurement::getDuration("duration_0D");
+  const double duration1DStart = Control::PerformanceMeasurement::getDuration("duration_1D");
+
+  while (state.keepRunning())
+  {
+    problem.setTimeSpan(currentTime, currentTime + timeStepWidth);
+    problem.advanceTimeSpan(false);
+    currentTime += timeStepWidth;
+  }
+
+  const double nIterations = std::max(1LL, state.iterations());
+  state.setCounter("duration_0D", (Control::PerformanceMeasurement::getDuration("duration_0D") - duration0DStart) / nIterations * 1e6);
+  state.setCounter("duration_1D", (Control::PerformanceMeasurement::getDuration("duration_1D") - duration1DStart) / nIterations * 1e6);
+
+  std::stringstream label;
+  label << nFibers << " fibers x " << nElements << " elements, " << pointBufferLayout;
+  state.setLabel(label.str());
+}
+
+// settings of the Hodgkin-Huxley model, 4 states, 9 algebraics
+const char *hodgkinHuxleySettings = R"(
+model_filename = "../../unit_testing/input/hodgkin_huxley_1952.c"
+parameters_used_as_algebraic = []
+parameters_used_as_constant = [2]
+parameters_initial_values = [0.0]
+)";
+
+// settings of the Shorten model, 56 states, 71 algebraics
+const char *shortenSettings = R"(
+model_filename = "../../unit_testing/input/shorten_ocallaghan_davidson_soboleva_2007.c"
+parameters_used_as_algebraic = [32]
+parameters_used_as_constant = [65]
+parameters_initial_values = [0.0, 1.0]
+)";
+
+//! Hodgkin-Huxley model, point buffers of all fibers stored consecutively
+void fastMonodomainHodgkinHuxley(Benchmark::State &state)
+{
+  fastMonodomainSolver<4,9>(state, hodgkinHuxleySettings, 16, 1000, "consecutive");
+}
+
+//! Hodgkin-Huxley model, point buffers of 4 fibers interleaved in tiles
+void fastMonodomainHodgkinHuxleyTiled(Benchmark::State &state)
+{
+  fastMonodomainSolver<4,9>(state, hodgkinHuxleySettings, 16, 1000, "tiled");
+}
+
+//! Shorten model, point buffers of all fibers stored consecutively
+void fastMonodomainShorten(Benchmark::State &state)
+{
+  fastMonodomainSolver<56,71>(state, shortenSettings, 16, 1000, "consecutive");
+}
+
+//! Shorten model, point buffers of 4 fibers interleaved in tiles
+void fastMonodomainShortenTiled(Benchmark::State &state)
+{
+  fastMonodomainSolver<56,71>(state, shortenSettings, 16, 1000, "tiled");
+}
+
+}  // namespace
+
+BENCHMARK(fastMonodomainHodgkinHuxley);
+BENCHMARK(fastMonodomainHodgkinHuxleyTiled);
+BENCHMARK(fastMonodomainShorten);
+BENCHMARK(fastMonodomainShortenTiled);
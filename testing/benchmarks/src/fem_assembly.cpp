@@ -0,0 +1,173 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <sstream>
+
+#include "opendihu.h"
+#include "arg.h"
+#include "benchmark.h"
+
+namespace
+{
+
+//! get the python settings of a FiniteElementMethod on a unit cube mesh with nElementsPerDimension elements in every coordinate direction
+std::string finiteElementMethodSettings(int D, int nElementsPerDimension)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+# Laplace, only used to assemble the matrices
+config = {
+  "disablePrinting": True,
+  "disableMatrixPrinting": True,
+  "FiniteElementMethod" : {
+    "nElements":         [)" << nElementsPerDimension << "]*" << D << R"(,
+    "physicalExtent":    [1.0]*)" << D << R"(,
+    "inputMeshIsGlobal": True,
+    "relativeTolerance": 1e-15,
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+//! get the python settings of a FiniteElementMethod on an unstructured unit cube mesh of linear hexahedral elements with nElementsPerDimension elements in every coordinate direction
+std::string finiteElementMethodSettingsUnstructured3D(int nElementsPerDimension)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+# Laplace on an unstructured mesh, only used to assemble the matrices
+n = )" << nElementsPerDimension << R"(
+
+node_positions = [[i/n, j/n, k/n] for k in range(n+1) for j in range(n+1) for i in range(n+1)]
+
+def node_no(i, j, k):
+  return k*(n+1)*(n+1) + j*(n+1) + i
+
+elements = [[node_no(i,j,k), node_no(i+1,j,k), node_no(i,j+1,k), node_no(i+1,j+1,k),
+             node_no(i,j,k+1), node_no(i+1,j,k+1), node_no(i,j+1,k+1), node_no(i+1,j+1,k+1)]
+            for k in range(n) for j in range(n) for i in range(n)]
+
+config = {
+  "disablePrinting": True,
+  "disableMatrixPrinting": True,
+  "FiniteElementMethod" : {
+    "nodePositions":     node_positions,
+    "elements":          elements,
+    "inputMeshIsGlobal": True,
+    "relativeTolerance": 1e-15,
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+/** Assembly of the stiffness matrix of the Laplace operator on a structured deformable mesh, i.e. by numerical integration.
+ */
+template<int D, typename BasisFunctionType, typename QuadratureType, int nElementsPerDimension>
+void femStiffnessMatrix(Benchmark::State &state)
+{
+  DihuContext settings(argc, argv, finiteElementMethodSettings(D, nElementsPerDimension));
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<D>,
+    BasisFunctionType,
+    QuadratureType,
+    Equation::Static::Laplace
+  > finiteElementMethod(settings);
+
+  // this allocates the matrix and assembles it once
+  finiteElementMethod.initialize();
+
+  while (state.keepRunning())
+  {
+    finiteElementMethod.setStiffnessMatrix();
+  }
+
+  state.setCounter("nElementsLocal", finiteElementMethod.functionSpace()->nElementsLocal());
+  state.setCounter("nDofsLocal", finiteElementMethod.functionSpace()->nDofsLocalWithoutGhosts());
+}
+
+/** Assembly of the mass matrix on a structured deformable mesh, i.e. by numerical integration.
+ */
+template<int D, typename BasisFunctionType, typename QuadratureType, int nElementsPerDimension>
+void femMassMatrix(Benchmark::State &state)
+{
+  DihuContext settings(argc, argv, finiteElementMethodSettings(D, nElementsPerDimension));
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<D>,
+    BasisFunctionType,
+    QuadratureType,
+    Equation::Static::Laplace
+  > finiteElementMethod(settings);
+
+  finiteElementMethod.initialize();
+
+  // the first call allocates the mass matrix
+  finiteElementMethod.setMassMatrix();
+
+  while (state.keepRunning())
+  {
+    finiteElementMethod.setMassMatrix();
+  }
+
+  state.setCounter("nElementsLocal", finiteElementMethod.functionSpace()->nElementsLocal());
+  state.setCounter("nDofsLocal", finiteElementMethod.functionSpace()->nDofsLocalWithoutGhosts());
+}
+
+/** Assembly of the stiffness matrix of the Laplace operator on an unstructured deformable mesh with linear hexahedral elements.
+ *  This is the same problem as femStiffnessMatrix<3, LagrangeOfOrder<1>, ...>, the difference in runtime is the overhead of the unstructured dof numbering.
+ */
+template<int nElementsPerDimension>
+void femStiffnessMatrixUnstructured(Benchmark::State &state)
+{
+  DihuContext settings(argc, argv, finiteElementMethodSettingsUnstructured3D(nElementsPerDimension));
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::UnstructuredDeformableOfDimension<3>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Laplace
+  > finiteElementMethod(settings);
+
+  finiteElementMethod.initialize();
+
+  while (state.keepRunning())
+  {
+    finiteElementMethod.setStiffnessMatrix();
+  }
+
+  state.setCounter("nElementsLocal", finiteElementMethod.functionSpace()->nElementsLocal());
+  state.setCounter("nDofsLocal", finiteElementMethod.functionSpace()->nDofsLocalWithoutGhosts());
+}
+
+}  // namespace
+
+// the problem sizes are chosen such that the numbers of dofs are of similar magnitude
+
+// 1D
+BENCHMARK(femStiffnessMatrix<1, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 10000>);
+BENCHMARK(femStiffnessMatrix<1, BasisFunction::LagrangeOfOrder<2>, Quadrature::Gauss<3>, 5000>);
+BENCHMARK(femStiffnessMatrix<1, BasisFunction::Hermite, Quadrature::Gauss<3>, 5000>);
+BENCHMARK(femMassMatrix<1, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 10000>);
+BENCHMARK(femMassMatrix<1, BasisFunction::LagrangeOfOrder<2>, Quadrature::Gauss<3>, 5000>);
+BENCHMARK(femMassMatrix<1, BasisFunction::Hermite, Quadrature::Gauss<3>, 5000>);
+
+// 2D
+BENCHMARK(femStiffnessMatrix<2, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 100>);
+BENCHMARK(femStiffnessMatrix<2, BasisFunction::LagrangeOfOrder<2>, Quadrature::Gauss<3>, 50>);
+BENCHMARK(femStiffnessMatrix<2, BasisFunction::Hermite, Quadrature::Gauss<3>, 50>);
+BENCHMARK(femMassMatrix<2, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 100>);
+BENCHMARK(femMassMatrix<2, BasisFunction::LagrangeOfOrder<2>, Quadrature::Gauss<3>, 50>);
+BENCHMARK(femMassMatrix<2, BasisFunction::Hermite, Quadrature::Gauss<3>, 50>);
+
+// 3D
+BENCHMARK(femStiffnessMatrix<3, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 20>);
+BENCHMARK(femStiffnessMatrix<3, BasisFunction::LagrangeOfOrder<2>, Quadrature::Gauss<3>, 10>);
+BENCHMARK(femStiffnessMatrix<3, BasisFunction::Hermite, Quadrature::Gauss<3>, 10>);
+BENCHMARK(femMassMatrix<3, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 20>);
+BENCHMARK(femMassMatrix<3, BasisFunction::LagrangeOfOrder<2>, Quadrature::Gauss<3>, 10>);
+BENCHMARK(femMassMatrix<3, BasisFunction::Hermite, Quadrature::Gauss<3>, 10>);
+
+// 3D unstructured, compare with femStiffnessMatrix<3, BasisFunction::LagrangeOfOrder<1>, Quadrature::Gauss<2>, 20>
+BENCHMARK(femStiffnessMatrixUnstructured<20>);
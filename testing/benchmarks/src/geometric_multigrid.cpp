@@ -0,0 +1,122 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "opendihu.h"
+#include "arg.h"
+#include "benchmark.h"
+
+namespace
+{
+
+//! get the python settings of a Poisson problem with f=1 and u=0 on the boundary of the unit cube with nElementsPerDimension elements in every coordinate direction,
+//! the linear system is solved by the solver "benchmarkSolver" with the given preconditioner
+std::string poissonSettings(int D, int nElementsPerDimension, std::string preconditionerType)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+D = )" << D << R"(
+n = )" << nElementsPerDimension << R"(
+n_nodes = (n+1)**D
+
+# Dirichlet boundary conditions u=0 on all nodes at the boundary
+bc = {}
+for node_no in range(n_nodes):
+  coordinates = [(node_no // (n+1)**d) % (n+1) for d in range(D)]
+  if 0 in coordinates or n in coordinates:
+    bc[node_no] = 0.0
+
+config = {
+  "disablePrinting": True,
+  "disableMatrixPrinting": True,
+  "Solvers": {
+    "benchmarkSolver": {
+      "solverType":         "cg",
+      "preconditionerType": ")" << preconditionerType << R"(",
+      "relativeTolerance":  1e-8,
+      "absoluteTolerance":  0,
+      "maxIterations":      1e4,
+      "dumpFilename":       "",
+      "dumpFormat":         "default",
+    },
+  },
+  "FiniteElementMethod" : {
+    "nElements":         [n]*D,
+    "physicalExtent":    [1.0]*D,
+    "inputMeshIsGlobal": True,
+    "dirichletBoundaryConditions": bc,
+    "rightHandSide":     [1.0]*n_nodes,
+    "solverName":        "benchmarkSolver",
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+/** Solution of the linear system of a Poisson problem on a structured mesh, including the setup of the preconditioner.
+ *  The matrix is assembled again outside of the measured time in every iteration. It is a new matrix object,
+ *  therefore the multigrid hierarchy and the preconditioner are set up again in every measured solve.
+ *  The counters give the number of iterations of the solver and the duration of the setup and solve [us].
+ */
+template<int D>
+void poissonSolve(Benchmark::State &state, int nElementsPerDimension, std::string preconditionerType)
+{
+  DihuContext settings(argc, argv, poissonSettings(D, nElementsPerDimension, preconditionerType));
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredRegularFixedOfDimension<D>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Poisson
+  > finiteElementMethod(settings);
+
+  const double durationSolveStart = Control::PerformanceMeasurement::getDuration("durationSolve_benchmarkSolver");
+
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    finiteElementMethod.reset();
+    finiteElementMethod.initialize();
+    state.resumeTiming();
+
+    finiteElementMethod.run();
+  }
+
+  const double nIterations = std::max(1LL, state.iterations());
+  state.setCounter("duration_solve", (Control::PerformanceMeasurement::getDuration("durationSolve_benchmarkSolver") - durationSolveStart) / nIterations * 1e6);
+  state.setCounter("nIterations", atof(Control::PerformanceMeasurement::getParameter("nIterations_benchmarkSolver").c_str()));
+  state.setCounter("nDofsLocal", finiteElementMethod.functionSpace()->nDofsLocalWithoutGhosts());
+
+  std::stringstream label;
+  label << nElementsPerDimension << "^" << D << " elements, " << preconditionerType;
+  state.setLabel(label.str());
+}
+
+//! geometric multigrid on the structured mesh
+template<int D, int nElementsPerDimension>
+void poissonSolveGeometricMultigrid(Benchmark::State &state)
+{
+  poissonSolve<D>(state, nElementsPerDimension, "gmg");
+}
+
+//! algebraic multigrid of PETSc, for comparison
+template<int D, int nElementsPerDimension>
+void poissonSolveAlgebraicMultigrid(Benchmark::State &state)
+{
+  poissonSolve<D>(state, nElementsPerDimension, "gamg");
+}
+
+}  // namespace
+
+// the numbers of elements are powers of 2, such that the meshes on 2 ranks can be coarsened to few elements
+
+// 2D
+BENCHMARK(poissonSolveGeometricMultigrid<2, 256>);
+BENCHMARK(poissonSolveAlgebraicMultigrid<2, 256>);
+
+// 3D
+BENCHMARK(poissonSolveGeometricMultigrid<3, 32>);
+BENCHMARK(poissonSolveAlgebraicMultigrid<3, 32>);
@@ -0,0 +1,29 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <mpi.h>
+#include <petscsys.h>
+
+#include "benchmark.h"
+
+int argc;
+char** argv;
+
+int main(int argc_, char **argv_)
+{
+  argc = argc_;
+  argv = argv_;
+
+  // run all benchmarks, this removes the "--benchmark_*" arguments from argc and argv, the remaining arguments are passed on to DihuContext
+  int result = Benchmark::runAllBenchmarks(argc, argv);
+
+  // the DihuContext objects of the benchmarks do not finalize MPI, because multiple contexts are created one after another, finalize here
+  int mpiIsInitialized = 0;
+  MPI_Initialized(&mpiIsInitialized);
+  if (mpiIsInitialized)
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+    PetscFinalize();
+    MPI_Finalize();
+  }
+  return result;
+}
@@ -0,0 +1,157 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "opendihu.h"
+#include "arg.h"
+#include "benchmark.h"
+
+namespace
+{
+
+typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>, BasisFunction::LagrangeOfOrder<1>> FiberFunctionSpace;
+typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>, BasisFunction::LagrangeOfOrder<1>> FunctionSpace3D;
+typedef MappingBetweenMeshes::MappingBetweenMeshes<FiberFunctionSpace,FunctionSpace3D> MappingFibersTo3D;
+
+// a 3D mesh with n_fibers_x x n_fibers_x embedded fibers, like a small fibers_emg setup, the fibers are located in the interior of the 3D elements
+const char *mappingSettings = R"(
+n_fibers_x = 4
+n_elements_fiber = 960
+
+meshes = {
+  "Mesh3D": {
+    "nElements":         [8, 8, 48],
+    "physicalExtent":    [2.0, 2.0, 12.0],
+    "inputMeshIsGlobal": True,
+  }
+}
+for j in range(n_fibers_x):
+  for i in range(n_fibers_x):
+    meshes["MeshFiber_{}".format(j*n_fibers_x + i)] = {
+      "nodePositions":     [[0.135 + 0.5*i, 0.14 + 0.5*j, 0.01 + 11.98*k/n_elements_fiber] for k in range(n_elements_fiber+1)],
+      "nElements":         [n_elements_fiber],
+      "inputMeshIsGlobal": True,
+    }
+
+config = {
+  "disablePrinting": True,
+  "Meshes": meshes,
+}
+)";
+
+const int nFibers = 16;    //< number of fibers in mappingSettings, n_fibers_x*n_fibers_x
+
+//! get the function spaces of the 3D mesh and all fibers
+void getFunctionSpaces(DihuContext &settings, std::shared_ptr<FunctionSpace3D> &functionSpace3D, std::vector<std::shared_ptr<FiberFunctionSpace>> &fiberFunctionSpaces)
+{
+  functionSpace3D = settings.meshManager()->functionSpace<FunctionSpace3D>("Mesh3D");
+
+  fiberFunctionSpaces.clear();
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    std::stringstream meshName;
+    meshName << "MeshFiber_" << fiberNo;
+    fiberFunctionSpaces.push_back(settings.meshManager()->functionSpace<FiberFunctionSpace>(meshName.str()));
+  }
+}
+
+/** Construction of the mappings of all fibers to the 3D mesh, this includes the search of the 3D element of every fiber node.
+ */
+void mappingBetweenMeshesConstruction(Benchmark::State &state)
+{
+  DihuContext settings(argc, argv, mappingSettings);
+
+  std::shared_ptr<FunctionSpace3D> functionSpace3D;
+  std::vector<std::shared_ptr<FiberFunctionSpace>> fiberFunctionSpaces;
+  getFunctionSpaces(settings, functionSpace3D, fiberFunctionSpaces);
+
+  while (state.keepRunning())
+  {
+    for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+    {
+      std::shared_ptr<MappingFibersTo3D> mapping = std::make_shared<MappingFibersTo3D>(fiberFunctionSpaces[fiberNo], functionSpace3D);
+    }
+  }
+
+  state.setCounter("nFibers", nFibers);
+}
+
+/** Mapping of one component from all fibers to the 3D mesh (low to high dimension) with prepareMapping, map and finalizeMapping.
+ */
+void mappingBetweenMeshesFibersTo3D(Benchmark::State &state)
+{
+  DihuContext settings(argc, argv, mappingSettings);
+
+  std::shared_ptr<FunctionSpace3D> functionSpace3D;
+  std::vector<std::shared_ptr<FiberFunctionSpace>> fiberFunctionSpaces;
+  getFunctionSpaces(settings, functionSpace3D, fiberFunctionSpaces);
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,1>> fieldVariable3D = functionSpace3D->createFieldVariable<1>("Vm_3D");
+
+  std::vector<std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>>> fiberFieldVariables;
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    fiberFieldVariables.push_back(fiberFunctionSpaces[fiberNo]->createFieldVariable<1>("Vm"));
+    fiberFieldVariables.back()->setValues(-75.0);
+
+    // create the mappings before the measurement
+    DihuContext::mappingBetweenMeshesManager()->mappingBetweenMeshes<FiberFunctionSpace,FunctionSpace3D>(fiberFunctionSpaces[fiberNo], functionSpace3D);
+  }
+
+  std::shared_ptr<MappingBetweenMeshes::Manager> manager = DihuContext::mappingBetweenMeshesManager();
+  while (state.keepRunning())
+  {
+    manager->prepareMapping(fiberFieldVariables[0], fieldVariable3D, 0);
+    for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+    {
+      manager->map(fiberFieldVariables[fiberNo], fieldVariable3D, 0, 0, false);
+    }
+    manager->finalizeMapping(fiberFieldVariables[0], fieldVariable3D, 0, 0, false);
+  }
+
+  state.setCounter("nFibers", nFibers);
+}
+
+/** Mapping of one component from the 3D mesh to all fibers (high to low dimension), i.e. interpolation at the fiber nodes.
+ */
+void mappingBetweenMeshes3DToFibers(Benchmark::State &state)
+{
+  DihuContext settings(argc, argv, mappingSettings);
+
+  std::shared_ptr<FunctionSpace3D> functionSpace3D;
+  std::vector<std::shared_ptr<FiberFunctionSpace>> fiberFunctionSpaces;
+  getFunctionSpaces(settings, functionSpace3D, fiberFunctionSpaces);
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpace3D,1>> fieldVariable3D = functionSpace3D->createFieldVariable<1>("Vm_3D");
+  fieldVariable3D->setValues(-75.0);
+
+  std::vector<std::shared_ptr<FieldVariable::FieldVariable<FiberFunctionSpace,1>>> fiberFieldVariables;
+  for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+  {
+    fiberFieldVariables.push_back(fiberFunctionSpaces[fiberNo]->createFieldVariable<1>("Vm"));
+
+    // create the mappings before the measurement
+    DihuContext::mappingBetweenMeshesManager()->mappingBetweenMeshes<FiberFunctionSpace,FunctionSpace3D>(fiberFunctionSpaces[fiberNo], functionSpace3D);
+  }
+
+  std::shared_ptr<MappingBetweenMeshes::Manager> manager = DihuContext::mappingBetweenMeshesManager();
+  while (state.keepRunning())
+  {
+    for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+    {
+      manager->prepareMapping(fieldVariable3D, fiberFieldVariables[fiberNo], 0);
+      manager->map(fieldVariable3D, fiberFieldVariables[fiberNo], 0, 0, false);
+      manager->finalizeMapping(fieldVariable3D, fiberFieldVariables[fiberNo], 0, 0, false);
+    }
+  }
+
+  state.setCounter("nFibers", nFibers);
+}
+
+}  // namespace
+
+BENCHMARK(mappingBetweenMeshesConstruction);
+BENCHMARK(mappingBetweenMeshesFibersTo3D);
+BENCHMARK(mappingBetweenMeshes3DToFibers);
@@ -0,0 +1,98 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "opendihu.h"
+#include "arg.h"
+#include "benchmark.h"
+
+namespace
+{
+
+/** Paraview output of the field variables of a 3D FiniteElementMethod with nElementsPerDimension^3 linear elements,
+ *  outputWriterSettings contains the options of the Paraview output writer, e.g. "binary", "combineFiles", "appended", "compression".
+ */
+void paraviewOutput(Benchmark::State &state, std::string outputWriterSettings, int nElementsPerDimension)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+config = {
+  "disablePrinting": True,
+  "disableMatrixPrinting": True,
+  "FiniteElementMethod" : {
+    "nElements":         [)" << nElementsPerDimension << R"(]*3,
+    "physicalExtent":    [1.0]*3,
+    "inputMeshIsGlobal": True,
+    "relativeTolerance": 1e-15,
+    "OutputWriter" : [
+      dict({"format": "Paraview", "outputInterval": 1, "filename": "out/benchmark_paraview/output"}, **)" << outputWriterSettings << R"(),
+    ],
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig.str());
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<3>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Laplace
+  > finiteElementMethod(settings);
+
+  finiteElementMethod.initialize();
+
+  OutputWriter::Manager outputWriterManager;
+  outputWriterManager.initialize(settings["FiniteElementMethod"], settings["FiniteElementMethod"].getPythonConfig());
+
+  int timeStepNo = 0;
+  while (state.keepRunning())
+  {
+    outputWriterManager.writeOutput(finiteElementMethod.data(), timeStepNo, timeStepNo*1e-3);
+    timeStepNo++;
+  }
+
+  state.setCounter("nDofsLocal", finiteElementMethod.functionSpace()->nDofsLocalWithoutGhosts());
+
+  // remove the written files
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (DihuContext::ownRankNoCommWorld() == 0)
+  {
+    int returnValue = system("rm -rf out/benchmark_paraview");
+    if (returnValue != 0)
+      LOG(WARNING) << "Could not remove output files of benchmark.";
+  }
+}
+
+//! one binary file per rank
+void paraviewOutputBinary(Benchmark::State &state)
+{
+  paraviewOutput(state, R"({"binary": True, "fixedFormat": False, "combineFiles": False})", 40);
+}
+
+//! one combined binary file with inline base64 data
+void paraviewOutputCombined(Benchmark::State &state)
+{
+  paraviewOutput(state, R"({"binary": True, "fixedFormat": False, "combineFiles": True})", 40);
+}
+
+//! one combined file with appended raw data
+void paraviewOutputCombinedAppended(Benchmark::State &state)
+{
+  paraviewOutput(state, R"({"binary": True, "fixedFormat": False, "combineFiles": True, "appended": True})", 40);
+}
+
+//! one combined file with appended zlib compressed data, without zlib support the data is not compressed
+void paraviewOutputCombinedAppendedZlib(Benchmark::State &state)
+{
+  paraviewOutput(state, R"({"binary": True, "fixedFormat": False, "combineFiles": True, "appended": True, "compression": "zlib"})", 40);
+}
+
+}  // namespace
+
+BENCHMARK(paraviewOutputBinary);
+BENCHMARK(paraviewOutputCombined);
+BENCHMARK(paraviewOutputCombinedAppended);
+BENCHMARK(paraviewOutputCombinedAppendedZlib);
@@ -0,0 +1,56 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <sstream>
+
+#include "opendihu.h"
+#include "arg.h"
+#include "benchmark.h"
+
+namespace
+{
+
+/** Ghost exchange of a field variable with nComponents components on a 3D mesh with nElementsPerDimension^3 linear elements.
+ *  One iteration is the sequence that is used around every assembly, i.e. startGhostManipulation (scatter of the owned values to the ghosts),
+ *  zeroGhostBuffer and finishGhostManipulation (reverse scatter that adds the ghost contributions to the owned values).
+ */
+template<int nComponents, int nElementsPerDimension>
+void partitionedPetscVecGhostExchange(Benchmark::State &state)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+config = {
+  "disablePrinting": True,
+  "Meshes": {
+    "Mesh3D": {
+      "nElements":         [)" << nElementsPerDimension << R"(]*3,
+      "physicalExtent":    [1.0]*3,
+      "inputMeshIsGlobal": True,
+    }
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig.str());
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>, BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+  std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->functionSpace<FunctionSpaceType>("Mesh3D");
+
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,nComponents>> fieldVariable
+    = functionSpace->template createFieldVariable<nComponents>("u");
+
+  while (state.keepRunning())
+  {
+    fieldVariable->startGhostManipulation();
+    fieldVariable->zeroGhostBuffer();
+    fieldVariable->finishGhostManipulation();
+  }
+
+  state.setCounter("nDofsLocal", functionSpace->nDofsLocalWithoutGhosts());
+  state.setCounter("nGhostDofs", functionSpace->nDofsLocalWithGhosts() - functionSpace->nDofsLocalWithoutGhosts());
+}
+
+}  // namespace
+
+BENCHMARK(partitionedPetscVecGhostExchange<1, 40>);
+BENCHMARK(partitionedPetscVecGhostExchange<3, 40>);
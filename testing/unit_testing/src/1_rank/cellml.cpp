@@ -3,14 +3,20 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <array>
+#include <cmath>
 
 #include "gtest/gtest.h"
 #include "opendihu.h"
 #include "arg.h"
 #include "stiffness_matrix_tester.h"
 #include "equation/diffusion.h"
+#include "utility/file_lock.h"
 #include "../utility.h"
 
+#include <signal.h>  // kill
+#include <cerrno>
+
 TEST(CellMLTest, HodgkinHuxleySimd)
 {
   // delete so libraries from previous runs
@@ -669,4 +675,460 @@ print("gpu avg error: {}".format(total_error))
   LOG(DEBUG) << "error between not_fast and fast_gpu: " << error;
 
   ASSERT_LE(error, 1.35);
+
+  // check the vc code with the tiled point buffer layout, it has to give the same result as the consecutive layout
+
+  strToReplace = "out/fast_gpu/fibers";
+  pos = pythonConfig.find(strToReplace);
+  pythonConfig.replace(pos, strToReplace.length(), "out/fast_tiled/fibers");
+
+  strToReplace = "\"gpu\"";
+  pos = pythonConfig.find(strToReplace);
+  pythonConfig.replace(pos, strToReplace.length(), "\"vc\"");
+
+  strToReplace = "\"firingTimesFile\":";
+  pos = pythonConfig.find(strToReplace);
+  pythonConfig.insert(pos, "\"pointBufferLayout\": \"tiled\",\n    ");
+
+  DihuContext settings4(argc, argv, pythonConfig);
+
+  // define problem with FastMonodomainSolver
+  TimeSteppingScheme::RepeatedCall<
+    FastMonodomainSolver<                        // a wrapper that improves performance of multidomain
+      Control::MultipleInstances<                       // fibers
+        OperatorSplitting::Strang<
+          Control::MultipleInstances<
+            TimeSteppingScheme::Heun<                   // fiber reaction term
+              CellmlAdapter<
+                4, 9,  // nStates,nAlgebraics: 57,1 = Shorten, 4,9 = Hodgkin Huxley
+                FunctionSpace::FunctionSpace<
+                  Mesh::StructuredDeformableOfDimension<1>,
+                  BasisFunction::LagrangeOfOrder<1>
+                >
+              >
+            >
+          >,
+          Control::MultipleInstances<
+            TimeSteppingScheme::ImplicitEuler<          // fiber diffusion, note that implicit euler gives lower error in this case than crank nicolson
+              SpatialDiscretization::FiniteElementMethod<
+                Mesh::StructuredDeformableOfDimension<1>,
+                BasisFunction::LagrangeOfOrder<1>,
+                Quadrature::Gauss<2>,
+                Equation::Dynamic::IsotropicDiffusion
+              >
+            >
+          >
+        >
+      >
+    >
+  > problem4(settings4);
+
+  // run problem
+  problem4.run();
+
+  // compare results of the consecutive and the tiled layout
+  command = R"(
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import sys, os
+import py_reader
+import numpy as np
+
+directory1 = "out/fast_tiled"
+directory2 = "out/fast_vc"
+
+# read all files in directories
+files1 = sorted([os.path.join(directory1, filename) for filename in os.listdir(directory1) if filename.endswith(".py")])
+files2 = sorted([os.path.join(directory2, filename) for filename in os.listdir(directory2) if filename.endswith(".py")])
+
+# load data
+data1 = py_reader.load_data(files1)
+data2 = py_reader.load_data(files2)
+
+n_values = min(len(data1), len(data2))
+
+component_name = "0"
+total_error = 0
+for i in range(n_values):
+  values1 = py_reader.get_values(data1[i], "solution", component_name)
+  values2 = py_reader.get_values(data2[i], "solution", component_name)
+
+  error = np.linalg.norm(values1-values2) / np.size(values1);
+  total_error += error
+
+total_error /= n_values
+print("tiled avg error: {}".format(total_error))
+
+)";
+  returnValue = PyRun_SimpleString(command.c_str());
+  PythonUtility::checkForError();
+  ASSERT_EQ(returnValue, 0);
+
+  mainModule = PyImport_AddModule("__main__");
+  totalError = PyObject_GetAttrString(mainModule, "total_error");
+
+  error = PythonUtility::convertFromPython<double>::get(totalError);
+  LOG(DEBUG) << "error between fast_vc and fast_tiled: " << error;
+
+  ASSERT_LE(error, 1e-10);
+}
+
+// the tiled layout with several fibers per tile, a partially filled last tile, a number of points that is not a multiple of the Vc vector size
+// and enabled equilibrium acceleration has to give the same result as the consecutive layout
+TEST(CellMLTest, FastFibersVcTiledEqualsConsecutive)
+{
+  std::string pythonConfig = R"(
+
+import numpy as np
+
+dt_0D = 2e-4
+dt_1D = 2e-3
+dt_splitting = 2e-3
+output_timestep = 0.5
+end_time = 10.0
+n_fibers = 3
+n_elements = 102        # 103 points per fiber, this is not a multiple of the Vc vector size
+
+stimulation_frequency = 100*1e-3   # [Hz]*1e-3 = [ms^-1]
+call_enable_begin = 1.0
+
+fiber_distribution_file = "../input/MU_fibre_distribution_10MUs.txt"
+firing_times_file = "../input/MU_firing_times_always.txt"
+
+point_buffer_layout = "consecutive"
+output_directory = "out/fast_consecutive"
+
+def fiber_instance(fiber_no):
+  return {
+    "ranks": [0],
+    "StrangSplitting": {
+      "timeStepWidth":          dt_splitting,
+      "timeStepOutputInterval": 100,
+      "endTime":                dt_splitting,
+      "connectedSlotsTerm1To2": [0],
+      "connectedSlotsTerm2To1": [0],
+
+      "Term1": {      # CellML, i.e. reaction term of Monodomain equation
+        "MultipleInstances": {
+          "nInstances": 1,
+          "instances":
+          [{
+            "ranks": [0],
+            "Heun" : {
+              "timeStepWidth":                dt_0D,
+              "initialValues":                [],
+              "timeStepOutputInterval":       1e4,
+              "inputMeshIsGlobal":            True,
+              "dirichletBoundaryConditions":  {},
+
+              "CellML" : {
+                "modelFilename":                          "../input/hodgkin_huxley_1952.c",
+                "optimizationType":                       "vc",
+                "approximateExponentialFunction":         True,
+                "compilerFlags":                          "-fPIC -O3 -march=native -shared ",
+                "maximumNumberOfThreads":                 0,
+                "setSpecificStatesCallInterval":          0,
+                "setSpecificStatesCallFrequency":         stimulation_frequency,
+                "setSpecificStatesFrequencyJitter":       [0],
+                "setSpecificStatesRepeatAfterFirstCall":  0.1,
+                "setSpecificStatesCallEnableBegin":       call_enable_begin + fiber_no,   # the fibers are stimulated at different times
+                "additionalArgument":                     fiber_no,
+                "algebraicsForTransfer":                  [],
+                "statesForTransfer":                      0,
+                "parametersUsedAsAlgebraic":              [],
+                "parametersUsedAsConstant":               [2],
+                "parametersInitialValues":                [0.0],
+                "meshName":                               "MeshFiber_{}".format(fiber_no),
+              },
+            },
+          }],
+        }
+      },
+      "Term2": {     # Diffusion
+        "MultipleInstances": {
+          "nInstances": 1,
+          "instances":
+          [{
+            "ranks": [0],
+            "ImplicitEuler" : {
+              "initialValues":               [],
+              "timeStepWidth":               dt_1D,
+              "timeStepOutputInterval":      1e4,
+              "dirichletBoundaryConditions": {},
+              "inputMeshIsGlobal":           True,
+              "solverName":                  "implicitSolver",
+              "FiniteElementMethod" : {
+                "inputMeshIsGlobal":         True,
+                "meshName":                  "MeshFiber_{}".format(fiber_no),
+                "prefactor":                 0.03,
+                "solverName":                "implicitSolver",
+              },
+            },
+          }],
+          "OutputWriter" : [
+            {"format": "PythonFile", "outputInterval": int(1./dt_splitting*output_timestep), "filename": "{}/fiber_{}".format(output_directory, fiber_no), "binary": True, "fixedFormat": False, "combineFiles": True, "onlyNodalValues": True}
+          ]
+        },
+      },
+    }
+  }
+
+config = {
+  "scenarioName": "tiled",
+  "Meshes": {
+    "MeshFiber_{}".format(fiber_no): {
+      "nElements": [n_elements],
+      "physicalExtent": [n_elements/100.],
+      "inputMeshIsGlobal": True,
+    }
+    for fiber_no in range(n_fibers)
+  },
+  "Solvers": {
+    "implicitSolver": {
+      "maxIterations":      1e4,
+      "relativeTolerance":  1e-10,
+      "dumpFormat":         "",
+      "dumpFilename":       "",
+      "solverType":         "gmres",
+      "preconditionerType": "none"
+    },
+  },
+  "RepeatedCall": {
+    "timeStepWidth":          dt_splitting,
+    "timeStepOutputInterval": 100,
+    "endTime":                end_time,
+    "MultipleInstances": {
+      "ranksAllComputedInstances":  [0],
+      "nInstances":                 n_fibers,
+      "instances":                  [fiber_instance(fiber_no) for fiber_no in range(n_fibers)],
+    },
+    "fiberDistributionFile":    fiber_distribution_file,
+    "firingTimesFile":          firing_times_file,
+    "onlyComputeIfHasBeenStimulated": False,
+    "disableComputationWhenStatesAreCloseToEquilibrium": True,
+    "pointBufferLayout":        point_buffer_layout,
+    "nFibersPerTile":           2,      # two tiles, the second one contains only one fiber
+  }
+}
+)";
+
+  typedef TimeSteppingScheme::RepeatedCall<
+    FastMonodomainSolver<
+      Control::MultipleInstances<                       // fibers
+        OperatorSplitting::Strang<
+          Control::MultipleInstances<
+            TimeSteppingScheme::Heun<                   // fiber reaction term
+              CellmlAdapter<
+                4, 9,  // nStates,nAlgebraics: 4,9 = Hodgkin Huxley
+                FunctionSpace::FunctionSpace<
+                  Mesh::StructuredDeformableOfDimension<1>,
+                  BasisFunction::LagrangeOfOrder<1>
+                >
+              >
+            >
+          >,
+          Control::MultipleInstances<
+            TimeSteppingScheme::ImplicitEuler<          // fiber diffusion
+              SpatialDiscretization::FiniteElementMethod<
+                Mesh::StructuredDeformableOfDimension<1>,
+                BasisFunction::LagrangeOfOrder<1>,
+                Quadrature::Gauss<2>,
+                Equation::Dynamic::IsotropicDiffusion
+              >
+            >
+          >
+        >
+      >
+    >
+  > ProblemType;
+
+  // run with the consecutive layout
+  DihuContext settings1(argc, argv, pythonConfig);
+  ProblemType problem1(settings1);
+  problem1.run();
+
+  // run with the tiled layout
+  std::string strToReplace("point_buffer_layout = \"consecutive\"");
+  std::size_t pos = pythonConfig.find(strToReplace);
+  pythonConfig.replace(pos, strToReplace.length(), "point_buffer_layout = \"tiled\"");
+
+  strToReplace = "out/fast_consecutive";
+  pos = pythonConfig.find(strToReplace);
+  pythonConfig.replace(pos, strToReplace.length(), "out/fast_tiled_3_fibers");
+
+  DihuContext settings2(argc, argv, pythonConfig);
+  ProblemType problem2(settings2);
+  problem2.run();
+
+  // compare all fibers at all output times
+  std::string command = R"(
+import sys, os
+import py_reader
+import numpy as np
+
+directory1 = "out/fast_tiled_3_fibers"
+directory2 = "out/fast_consecutive"
+
+filenames = sorted([filename for filename in os.listdir(directory2) if filename.endswith(".py")])
+n_files_consecutive = len(filenames)
+n_files_tiled = len([filename for filename in os.listdir(directory1) if filename.endswith(".py")])
+
+max_error = 0
+max_value_range = 0
+for filename in filenames:
+  data1 = py_reader.load_data([os.path.join(directory1, filename)])
+  data2 = py_reader.load_data([os.path.join(directory2, filename)])
+
+  values1 = np.array(py_reader.get_values(data1[0], "solution", "0"))
+  values2 = np.array(py_reader.get_values(data2[0], "solution", "0"))
+
+  max_error = max(max_error, np.max(np.abs(values1-values2)))
+  max_value_range = max(max_value_range, np.max(values2) - np.min(values2))
+
+print("tiled vs. consecutive: {} files, max error: {}, max range of Vm: {}".format(len(filenames), max_error, max_value_range))
+)";
+  int returnValue = PyRun_SimpleString(command.c_str());
+  PythonUtility::checkForError();
+  ASSERT_EQ(returnValue, 0);
+
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  int nFilesConsecutive = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_files_consecutive"));
+  int nFilesTiled = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_files_tiled"));
+  double maxError = PythonUtility::convertFromPython<double>::get(PyObject_GetAttrString(mainModule, "max_error"));
+  double maxValueRange = PythonUtility::convertFromPython<double>::get(PyObject_GetAttrString(mainModule, "max_value_range"));
+
+  // both runs wrote the same files, the fibers have been stimulated
+  ASSERT_GT(nFilesConsecutive, 0);
+  EXPECT_EQ(nFilesTiled, nFilesConsecutive);
+  EXPECT_GT(maxValueRange, 50.0);
+
+  // the equilibrium acceleration disables different point buffers at the ends of the fibers in the two layouts, otherwise the computation is the same
+  EXPECT_LE(maxError, 1e-3*maxValueRange);
+}
+
+// the fused time steps in the generated code have to give the same result as individual Heun steps,
+// the individual steps are enforced by a callback that is called at every evaluation of the right hand side
+TEST(CellMLTest, FusedTimeStepsEqualIndividualTimeSteps)
+{
+  for (std::string optimizationType : {"simd", "vc"})
+  {
+    std::array<std::vector<std::array<double,4>>,2> solutionValues;
+    for (int runNo = 0; runNo < 2; runNo++)
+    {
+      std::string pythonConfig = R"(
+n_elements = 6          # 7 instances, this is not a multiple of the Vc vector size
+call_interval = )" + std::string(runNo == 0? "1000000" : "1") + R"(
+
+# different stimulation currents for the instances, the values do not change in time
+def set_specific_parameters(n_nodes_global, time_step_no, current_time, parameters, additional_argument):
+  for node_no in range(n_nodes_global):
+    parameters[([node_no],0,0)] = 10.0 + 20.0*node_no
+
+config = {
+  "Meshes": {
+    "MeshFiber": {
+      "nElements": [n_elements],
+      "physicalExtent": [n_elements/100.],
+      "inputMeshIsGlobal": True,
+    }
+  },
+  "Heun" : {
+    "timeStepWidth": 2e-4,
+    "endTime": 0.5,
+    "initialValues": [],
+    "timeStepOutputInterval": 1e4,
+    "inputMeshIsGlobal": True,
+    "dirichletBoundaryConditions": {},
+
+    "CellML" : {
+      "modelFilename": "../input/hodgkin_huxley_1952.c",
+      "optimizationType": ")" + optimizationType + R"(",
+      "approximateExponentialFunction": False,
+      "setSpecificParametersFunction": set_specific_parameters,
+      "setSpecificParametersCallInterval": call_interval,
+      "statesInitialValues": [-20, 0.05, 0.6, 0.325],
+      "parametersInitialValues": [0.0],
+      "parametersUsedAsAlgebraic": [],
+      "parametersUsedAsConstant": [2],
+      "meshName": "MeshFiber",
+    },
+  }
+}
+)";
+
+      DihuContext settings(argc, argv, pythonConfig);
+
+      TimeSteppingScheme::Heun<
+        CellmlAdapter<
+          4, 9,  // nStates,nAlgebraics: 4,9 = Hodgkin Huxley
+          FunctionSpace::FunctionSpace<
+            Mesh::StructuredDeformableOfDimension<1>,
+            BasisFunction::LagrangeOfOrder<1>
+          >
+        >
+      > problem(settings);
+
+      problem.run();
+
+      problem.data().solution()->getValuesWithoutGhosts(solutionValues[runNo]);
+    }
+
+    // the instances have different solutions, the fused and the individual time steps only differ by rounding errors
+    ASSERT_EQ(solutionValues[0].size(), 7) << optimizationType;
+    ASSERT_EQ(solutionValues[1].size(), solutionValues[0].size()) << optimizationType;
+    EXPECT_GT(std::fabs(solutionValues[1][6][0] - solutionValues[1][0][0]), 1e-3) << optimizationType;
+
+    for (int instanceNo = 0; instanceNo < solutionValues[0].size(); instanceNo++)
+    {
+      for (int stateNo = 0; stateNo < 4; stateNo++)
+      {
+        EXPECT_NEAR(solutionValues[0][instanceNo][stateNo], solutionValues[1][instanceNo][stateNo], 1e-8*(1.0 + std::fabs(solutionValues[1][instanceNo][stateNo])))
+          << optimizationType << ", instance " << instanceNo << ", state " << stateNo;
+      }
+    }
+  }
+}
+
+// the lock file of the CellML library cache is removed if its owner has terminated on the same host, otherwise it is kept
+TEST(CellMLTest, LibraryLockRemovesLockOfTerminatedProcess)
+{
+  std::string lockFilename = "library_lock_test.so.lock";
+  std::remove(lockFilename.c_str());
+
+  // find a process id that is not in use
+  long terminatedProcessId = 4194303;
+  while (!(kill(terminatedProcessId, 0) == -1 && errno == ESRCH))
+    terminatedProcessId--;
+
+  std::string ownProcess = FileLock::ownProcess();
+  std::string hostname = ownProcess.substr(0, ownProcess.find(" "));
+
+  // a lock of a terminated process on the own host is stale
+  {
+    std::ofstream file(lockFilename);
+    file << hostname << " " << terminatedProcessId << std::endl;
+  }
+
+  FileLock lock(lockFilename);
+  ASSERT_TRUE(lock.tryLock());
+  EXPECT_EQ(lock.owner(), ownProcess);
+
+  // the lock of a running process is kept
+  FileLock otherLock(lockFilename);
+  EXPECT_FALSE(otherLock.tryLock());
+
+  lock.unlock();
+  EXPECT_TRUE(otherLock.tryLock());
+  otherLock.unlock();
+  EXPECT_EQ(otherLock.owner(), "");
+
+  // the state of a process on another host is not known, the lock is kept
+  {
+    std::ofstream file(lockFilename);
+    file << hostname << "-other-host " << terminatedProcessId << std::endl;
+  }
+  EXPECT_FALSE(lock.tryLock());
+
+  std::remove(lockFilename.c_str());
 }
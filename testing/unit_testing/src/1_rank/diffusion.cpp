@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <cstdio>
 #include <fstream>
 
 #include "gtest/gtest.h"
@@ -10,6 +11,7 @@
 #include "stiffness_matrix_tester.h"
 #include "equation/diffusion.h"
 #include "../utility.h"
+#include "utility/svd_utility.h"
 
 TEST(DiffusionTest, ExplicitEuler1D)
 {
@@ -532,3 +534,178 @@ config = {
     >
   > problem(settings);
 }
+
+TEST(DiffusionTest, ExplicitEuler1DCheckpointRestart)
+{
+  // the same diffusion problem is run with different end times and checkpointing settings
+  auto pythonConfig = [](std::string endTime, std::string numberTimeSteps, std::string checkpointing)
+  {
+    return std::string(R"(
+# Diffusion 1D
+n = 5
+config = {
+  "checkpointing": )") + checkpointing + R"(,
+  "ExplicitEuler" : {
+    "initialValues": [2,2,4,5,2,2],
+    "numberTimeSteps": )" + numberTimeSteps + R"(,
+    "endTime": )" + endTime + R"(,
+    "FiniteElementMethod" : {
+      "nElements": n,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+      "inputMeshIsGlobal": True,
+    },
+  },
+}
+)";
+  };
+
+  typedef TimeSteppingScheme::ExplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<1>,
+      BasisFunction::LagrangeOfOrder<>,
+      Quadrature::None,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > ProblemType;
+
+  // remove the checkpoint of a previous test run
+  std::remove("checkpoints_test/diffusion1d");
+
+  // uninterrupted reference run
+  std::vector<double> valuesReference;
+  {
+    DihuContext settings(argc, argv, pythonConfig("0.1", "10", "{}"));
+    ProblemType problem(settings);
+    problem.run();
+    problem.data().solution()->getValuesWithoutGhosts(valuesReference);
+  }
+
+  // first half of the simulation, a checkpoint is written at t=0.05
+  {
+    DihuContext settings(argc, argv, pythonConfig("0.05", "5",
+      R"({"filename": "checkpoints_test/diffusion1d", "interval": 0.05, "restart": False})"));
+    ProblemType problem(settings);
+    problem.run();
+  }
+
+  // the restarted simulation has to continue at t=0.05 and compute the remaining 5 time steps
+  std::vector<double> valuesRestarted;
+  {
+    DihuContext settings(argc, argv, pythonConfig("0.1", "10",
+      R"({"filename": "checkpoints_test/diffusion1d", "interval": 0, "restart": True})"));
+    ProblemType problem(settings);
+    problem.run();
+    problem.data().solution()->getValuesWithoutGhosts(valuesRestarted);
+  }
+
+  ASSERT_EQ(valuesRestarted.size(), valuesReference.size());
+  for (int i = 0; i < valuesReference.size(); i++)
+  {
+    EXPECT_NEAR(valuesRestarted[i], valuesReference[i], 1e-12) << "dof " << i;
+  }
+}
+
+// the reduced implicit Euler with the identity as basis has to give the full-order solution after every time span,
+// both with the dense and with the KSP solver for the reduced system
+TEST(DiffusionTest, ImplicitEuler1DReducedEqualsFull)
+{
+  std::string implicitEulerConfig = R"(
+    "initialValues": [2,2,4,5,2,2],
+    "timeStepWidth": 0.02,
+    "endTime": 0.1,
+    "relativeTolerance": 1e-15,
+    "FiniteElementMethod" : {
+      "nElements": 5,
+      "physicalExtent": 4.0,
+      "relativeTolerance": 1e-15,
+      "diffusionTensor": [5.0],
+      "inputMeshIsGlobal": True,
+    },
+)";
+
+  typedef TimeSteppingScheme::ImplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<1>,
+      BasisFunction::LagrangeOfOrder<>,
+      Quadrature::None,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > FullProblemType;
+  typedef ModelOrderReduction::ImplicitEulerReduced<FullProblemType> ReducedProblemType;
+
+  // reference solution of the full-order model at the end of two time spans
+  std::vector<double> valuesReference0, valuesReference1;
+  {
+    DihuContext settings(argc, argv, std::string("config = {\n  \"ImplicitEuler\": {") + implicitEulerConfig + "  }\n}\n");
+    FullProblemType problem(settings);
+    problem.initialize();
+
+    problem.setTimeSpan(0.0, 0.04);
+    problem.advanceTimeSpan(false);
+    problem.data().solution()->getValuesWithoutGhosts(valuesReference0);
+
+    problem.setTimeSpan(0.04, 0.1);
+    problem.advanceTimeSpan(false);
+    problem.data().solution()->getValuesWithoutGhosts(valuesReference1);
+  }
+
+  // write the identity as basis
+  const int nDofs = 6;
+  std::vector<double> basis(nDofs*nDofs, 0.0), singularValues(nDofs, 1.0);
+  std::vector<long long> rowNosGlobalNatural(nDofs);
+  for (int i = 0; i < nDofs; i++)
+  {
+    basis[i*nDofs + i] = 1.0;
+    rowNosGlobalNatural[i] = i;
+  }
+  int returnValue = system("mkdir -p out");
+  if (returnValue != 0)
+    LOG(WARNING) << "failed to create directory \"out\"";
+  SvdUtility::writeBasisBinary("out/diffusion1d_identity_basis.pod", basis, singularValues, rowNosGlobalNatural, nDofs, 1, MPI_COMM_WORLD);
+
+  for (std::string denseReducedSystem : {"True", "False"})
+  {
+    std::string pythonConfig = std::string(R"(
+config = {
+  "ModelOrderReduction": {
+    "nRowsSnapshots": 6,
+    "nReducedBases": 6,
+    "basisFile": "out/diffusion1d_identity_basis.pod",
+    "ImplicitEulerReduced": {
+      "timeStepWidth": 0.02,
+      "endTime": 0.1,
+      "relativeTolerance": 1e-15,
+      "denseReducedSystem": )") + denseReducedSystem + R"(,
+    },
+    "ImplicitEuler": {)" + implicitEulerConfig + R"(    },
+  }
+}
+)";
+    DihuContext settings(argc, argv, pythonConfig);
+    ReducedProblemType problem(settings);
+    problem.initialize();
+
+    std::vector<double> values;
+    problem.setTimeSpan(0.0, 0.04);
+    problem.advanceTimeSpan(false);
+    problem.fullTimestepping().data().solution()->getValuesWithoutGhosts(values);
+
+    ASSERT_EQ(values.size(), valuesReference0.size());
+    for (int i = 0; i < nDofs; i++)
+    {
+      EXPECT_NEAR(values[i], valuesReference0[i], 1e-10) << "dof " << i << ", denseReducedSystem: " << denseReducedSystem;
+    }
+
+    problem.setTimeSpan(0.04, 0.1);
+    problem.advanceTimeSpan(false);
+    problem.fullTimestepping().data().solution()->getValuesWithoutGhosts(values);
+
+    ASSERT_EQ(values.size(), valuesReference1.size());
+    for (int i = 0; i < nDofs; i++)
+    {
+      EXPECT_NEAR(values[i], valuesReference1[i], 1e-10) << "dof " << i << ", denseReducedSystem: " << denseReducedSystem;
+    }
+  }
+}
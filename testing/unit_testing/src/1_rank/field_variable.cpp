@@ -3,6 +3,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <algorithm>
 
 #include "gtest/gtest.h"
 #include "opendihu.h"
@@ -932,4 +933,196 @@ config = {
   
 }
 
+// the vectorized getElementValues gather the dof nos from the table of the function space, the batch of elements is only partially filled,
+// i.e. the lanes after the last element have element no -1, as at the end of the element loops of the assembly
+TEST(FieldVariableTest, UnstructuredDeformableVectorizedElementValues)
+{
+  std::string pythonConfig = R"(
+import numpy as np
+
+nodePositions = []
+for y in np.linspace(0,1,5):
+  for x in np.linspace(0,1,5):
+    nodePositions.append([x,y])
+
+config = {
+  "Meshes" : {
+    "testMesh": {
+      "nElements": 4,
+      "nodePositions": nodePositions,
+      "elements": [[0,1,2,5,6,7,10,11,12], [2,3,4,7,8,9,12,13,14], [10,11,12,15,16,17,20,21,22], [12,13,14,17,18,19,22,23,24]],
+    }
+  },
+  "FiniteElementMethod" : {
+    "relativeTolerance": 1e-15,
+    "meshName": "testMesh",
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::UnstructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<2>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Laplace
+  > finiteElementMethod(settings);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<2>,BasisFunction::LagrangeOfOrder<2>> FunctionSpaceType;
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+
+  std::shared_ptr<FunctionSpaceType> functionSpace = std::static_pointer_cast<FunctionSpaceType>(finiteElementMethod.functionSpace());
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,2>> a = functionSpace->template createFieldVariable<2>("a");
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>> c = functionSpace->template createFieldVariable<1>("c");
+
+  // every dof has different values
+  const int nDofs = functionSpace->nDofsLocalWithoutGhosts();
+  std::vector<dof_no_t> dofNos(nDofs);
+  std::vector<Vec2> valuesA(nDofs);
+  std::vector<double> valuesC(nDofs);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofs; dofNoLocal++)
+  {
+    dofNos[dofNoLocal] = dofNoLocal;
+    valuesA[dofNoLocal] = Vec2({1.0 + dofNoLocal, 100.0 + dofNoLocal});
+    valuesC[dofNoLocal] = 1000.0 + dofNoLocal;
+  }
+  a->setValues(dofNos, valuesA);
+  c->setValues(dofNos, valuesC);
+
+  // the elements 3,2,1,0 in this order, at least one lane is not used if there is more than one lane
+  const int nLanes = Vc::double_v::size();
+  const int nActiveLanes = (nLanes == 1? 1 : std::min(nLanes-1, 4));
+  Vc::int_v elementNoLocal(-1);
+  for (int vcComponent = 0; vcComponent < nActiveLanes; vcComponent++)
+  {
+    elementNoLocal[vcComponent] = 3 - vcComponent;
+  }
+
+  std::array<Vc::int_v,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocal);
+
+  std::array<std::array<Vc::double_v,2>,nDofsPerElement> elementValuesA;
+  a->getElementValues(elementNoLocal, elementValuesA);
+
+  std::array<Vc::double_v,nDofsPerElement> elementValuesC;
+  c->getElementValues(elementNoLocal, elementValuesC);
+
+  for (int vcComponent = 0; vcComponent < nLanes; vcComponent++)
+  {
+    if (vcComponent >= nActiveLanes)
+    {
+      // the lanes without element have no dofs
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        EXPECT_EQ(dofNosLocal[dofIndex][vcComponent], -1) << "lane " << vcComponent;
+      }
+      continue;
+    }
+
+    // the active lanes have the same values as the scalar functions for the element
+    element_no_t elementNo = 3 - vcComponent;
+    std::array<dof_no_t,nDofsPerElement> referenceDofNos = functionSpace->getElementDofNosLocal(elementNo);
+
+    std::array<Vec2,nDofsPerElement> referenceValuesA;
+    a->getElementValues(elementNo, referenceValuesA);
+
+    std::array<double,nDofsPerElement> referenceValuesC;
+    c->getElementValues(elementNo, referenceValuesC);
+
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      EXPECT_EQ(dofNosLocal[dofIndex][vcComponent], referenceDofNos[dofIndex]) << "element " << elementNo << ", dof " << dofIndex;
+      EXPECT_EQ(elementValuesA[dofIndex][0][vcComponent], referenceValuesA[dofIndex][0]) << "element " << elementNo << ", dof " << dofIndex;
+      EXPECT_EQ(elementValuesA[dofIndex][1][vcComponent], referenceValuesA[dofIndex][1]) << "element " << elementNo << ", dof " << dofIndex;
+      EXPECT_EQ(elementValuesC[dofIndex][vcComponent], referenceValuesC[dofIndex]) << "element " << elementNo << ", dof " << dofIndex;
+    }
+  }
+}
+
+TEST(FieldVariableTest, ContiguousStorage)
+{
+  std::string pythonConfig = R"(
+config = {
+  "contiguousStorage": True,
+  "Meshes" : {
+    "testMesh": {
+      "nElements": [2],
+      "physicalExtent": [1.0],
+    }
+  },
+  "FiniteElementMethod" : {
+    "relativeTolerance": 1e-15,
+    "meshName": "testMesh",
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<1>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Laplace
+  > finiteElementMethod(settings);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+
+  std::shared_ptr<FunctionSpaceType> functionSpace = finiteElementMethod.functionSpace();
+  functionSpace->initialize();
+
+  // 3 nodes, 3 components
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,3>> fieldVariable = functionSpace->template createFieldVariable<3>("a");
+
+  std::vector<double> values{1.0, 2.0, 3.0};
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    fieldVariable->setValuesWithoutGhosts(componentNo, values);
+    for (double &value : values)
+      value += 10.0;
+  }
+
+  // the contiguous vector is the storage of the component vectors
+  Vec contiguousVector = fieldVariable->partitionedPetscVec()->getValuesContiguous();
+
+  PetscErrorCode ierr;
+  double *valuesContiguous;
+  ierr = VecGetArray(contiguousVector, &valuesContiguous); CHKERRV(ierr);
+
+  std::vector<double> reference{1.0, 2.0, 3.0, 11.0, 12.0, 13.0, 21.0, 22.0, 23.0};
+  for (int i = 0; i < 9; i++)
+  {
+    ASSERT_EQ(valuesContiguous[i], reference[i]);
+  }
+
+  // change values in the contiguous representation
+  valuesContiguous[4] = 100.0;
+  ierr = VecRestoreArray(contiguousVector, &valuesContiguous); CHKERRV(ierr);
+  ierr = VecShift(contiguousVector, 1.0); CHKERRV(ierr);
+
+  fieldVariable->partitionedPetscVec()->restoreValuesContiguous();
+
+  std::vector<double> component1;
+  fieldVariable->getValuesWithoutGhosts(1, component1);
+  ASSERT_EQ(component1, std::vector<double>({12.0, 101.0, 14.0}));
+
+  // the norm of the component vector has to consider the changed values
+  double norm;
+  ierr = VecNorm(fieldVariable->valuesGlobal(1), NORM_INFINITY, &norm); CHKERRV(ierr);
+  ASSERT_EQ(norm, 101.0);
+
+  // the component vectors are views on the memory of the contiguous vector and not copies of it,
+  // a copy would also pass the checks above
+  const double *valuesContiguousData;
+  ierr = VecGetArrayRead(contiguousVector, &valuesContiguousData); CHKERRV(ierr);
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    const double *componentData;
+    ierr = VecGetArrayRead(fieldVariable->valuesGlobal(componentNo), &componentData); CHKERRV(ierr);
+    EXPECT_EQ(componentData, valuesContiguousData + componentNo*3) << "component " << componentNo;
+    ierr = VecRestoreArrayRead(fieldVariable->valuesGlobal(componentNo), &componentData); CHKERRV(ierr);
+  }
+  ierr = VecRestoreArrayRead(contiguousVector, &valuesContiguousData); CHKERRV(ierr);
+}
+
 }  // namespace
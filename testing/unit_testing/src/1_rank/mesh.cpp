@@ -9,6 +9,7 @@
 #include "arg.h"
 #include "stiffness_matrix_tester.h"
 #include "node_positions_tester.h"
+#include "mesh/mapping_between_meshes/embedded_geometry.h"
 
 namespace SpatialDiscretization
 {
@@ -229,4 +230,109 @@ config = {
   
 }
 
+// the geometry of meshes that are embedded in a deformed quadratic host mesh is the same with the stored interpolation weights of
+// EmbeddedGeometry and with the generic mapping, the interpolation of the quadratic displacements is exact up to the accuracy of the xi coordinates
+TEST(MeshTest, EmbeddedGeometryEqualsGenericMapping)
+{
+  std::string pythonConfig = R"(
+config = {}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>,BasisFunction::LagrangeOfOrder<2>> FunctionSpaceHost;
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceEmbedded;
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<1>,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceFiber;
+  typedef FieldVariable::FieldVariable<FunctionSpaceHost,3> FieldVariableHost;
+  typedef FieldVariable::FieldVariable<FunctionSpaceEmbedded,3> FieldVariableEmbedded;
+
+  std::shared_ptr<Mesh::Manager> meshManager = settings.meshManager();
+
+  // host mesh of 2x2x2 quadratic elements on [0,2]^3
+  std::vector<Vec3> nodePositionsHost;
+  for (int k = 0; k < 5; k++)
+    for (int j = 0; j < 5; j++)
+      for (int i = 0; i < 5; i++)
+        nodePositionsHost.push_back(Vec3({0.5*i, 0.5*j, 0.5*k}));
+
+  // embedded mesh of 3x3x3 linear elements on [0.2,1.7]^3, twice with the same nodes for the two ways of the geometry update
+  std::vector<Vec3> nodePositionsEmbedded;
+  for (int k = 0; k < 4; k++)
+    for (int j = 0; j < 4; j++)
+      for (int i = 0; i < 4; i++)
+        nodePositionsEmbedded.push_back(Vec3({0.2+0.5*i, 0.2+0.5*j, 0.2+0.5*k}));
+
+  // oblique fiber inside the host mesh
+  std::vector<Vec3> nodePositionsFiber;
+  for (int i = 0; i < 11; i++)
+    nodePositionsFiber.push_back(Vec3({0.3+0.14*i, 0.8+0.03*i, 1.3-0.05*i}));
+
+  std::shared_ptr<FunctionSpaceHost> functionSpaceHost = meshManager->createFunctionSpace<FunctionSpaceHost>(
+    "host", nodePositionsHost, std::array<element_no_t,3>({2,2,2}), std::array<int,3>({1,1,1}));
+  std::shared_ptr<FunctionSpaceEmbedded> functionSpaceEmbedded = meshManager->createFunctionSpace<FunctionSpaceEmbedded>(
+    "embedded", nodePositionsEmbedded, std::array<element_no_t,3>({3,3,3}), std::array<int,3>({1,1,1}));
+  std::shared_ptr<FunctionSpaceEmbedded> functionSpaceEmbeddedGeneric = meshManager->createFunctionSpace<FunctionSpaceEmbedded>(
+    "embeddedGeneric", nodePositionsEmbedded, std::array<element_no_t,3>({3,3,3}), std::array<int,3>({1,1,1}));
+  std::shared_ptr<FunctionSpaceFiber> functionSpaceFiber = meshManager->createFunctionSpace<FunctionSpaceFiber>(
+    "fiber", nodePositionsFiber, std::array<element_no_t,1>({10}), std::array<int,1>({1}));
+
+  // store the interpolation weights in the reference configuration, for the generic mapping only create the mapping embedded -> host,
+  // like in the MuscleContractionSolver with "reverseMappingOrder"
+  MappingBetweenMeshes::EmbeddedGeometry<FunctionSpaceHost,FunctionSpaceEmbedded> embeddedGeometry(functionSpaceHost, functionSpaceEmbedded);
+  MappingBetweenMeshes::EmbeddedGeometry<FunctionSpaceHost,FunctionSpaceFiber> embeddedGeometryFiber(functionSpaceHost, functionSpaceFiber);
+  DihuContext::mappingBetweenMeshesManager()->mappingBetweenMeshes<FunctionSpaceEmbedded,FunctionSpaceHost>(functionSpaceEmbeddedGeneric, functionSpaceHost);
+
+  // quadratic displacements, they are represented exactly by the quadratic host mesh
+  auto deformedPosition = [](const Vec3 &position)
+  {
+    return Vec3({position[0] + 0.1*position[1]*position[2], position[1] + 0.05*position[0]*position[0], position[2] - 0.1*position[0]*position[1]});
+  };
+
+  std::vector<Vec3> geometryValuesHost;
+  functionSpaceHost->geometryField().getValuesWithoutGhosts(geometryValuesHost);
+  for (Vec3 &position : geometryValuesHost)
+  {
+    position = deformedPosition(position);
+  }
+  functionSpaceHost->geometryField().setValuesWithoutGhosts(geometryValuesHost);
+
+  // update the geometry with the stored weights
+  embeddedGeometry.updateGeometry();
+  embeddedGeometryFiber.updateGeometry();
+
+  // update the geometry with the generic mapping, in the same way as the MuscleContractionSolver without the embedded geometry
+  std::shared_ptr<FieldVariableHost> geometryFieldHost = std::make_shared<FieldVariableHost>(functionSpaceHost->geometryField());
+  std::shared_ptr<FieldVariableEmbedded> geometryFieldEmbeddedGeneric = std::make_shared<FieldVariableEmbedded>(functionSpaceEmbeddedGeneric->geometryField());
+  DihuContext::mappingBetweenMeshesManager()->prepareMapping<FieldVariableHost,FieldVariableEmbedded>(geometryFieldHost, geometryFieldEmbeddedGeneric, -1);
+  DihuContext::mappingBetweenMeshesManager()->map<FieldVariableHost,FieldVariableEmbedded>(geometryFieldHost, geometryFieldEmbeddedGeneric, -1, -1, false);
+  DihuContext::mappingBetweenMeshesManager()->finalizeMapping<FieldVariableHost,FieldVariableEmbedded>(geometryFieldHost, geometryFieldEmbeddedGeneric, -1, -1, false);
+
+  std::vector<Vec3> geometryValuesEmbedded, geometryValuesEmbeddedGeneric, geometryValuesFiber;
+  functionSpaceEmbedded->geometryField().getValuesWithoutGhosts(geometryValuesEmbedded);
+  functionSpaceEmbeddedGeneric->geometryField().getValuesWithoutGhosts(geometryValuesEmbeddedGeneric);
+  functionSpaceFiber->geometryField().getValuesWithoutGhosts(geometryValuesFiber);
+
+  ASSERT_EQ(geometryValuesEmbedded.size(), nodePositionsEmbedded.size());
+  ASSERT_EQ(geometryValuesEmbeddedGeneric.size(), nodePositionsEmbedded.size());
+  for (int dofNoLocal = 0; dofNoLocal < nodePositionsEmbedded.size(); dofNoLocal++)
+  {
+    Vec3 expectedPosition = deformedPosition(nodePositionsEmbedded[dofNoLocal]);
+    for (int i = 0; i < 3; i++)
+    {
+      EXPECT_NEAR(geometryValuesEmbedded[dofNoLocal][i], geometryValuesEmbeddedGeneric[dofNoLocal][i], 1e-12) << "dof " << dofNoLocal << ", component " << i;
+      EXPECT_NEAR(geometryValuesEmbedded[dofNoLocal][i], expectedPosition[i], 1e-8) << "dof " << dofNoLocal << ", component " << i;
+    }
+  }
+
+  ASSERT_EQ(geometryValuesFiber.size(), nodePositionsFiber.size());
+  for (int dofNoLocal = 0; dofNoLocal < nodePositionsFiber.size(); dofNoLocal++)
+  {
+    Vec3 expectedPosition = deformedPosition(nodePositionsFiber[dofNoLocal]);
+    for (int i = 0; i < 3; i++)
+    {
+      EXPECT_NEAR(geometryValuesFiber[dofNoLocal][i], expectedPosition[i], 1e-8) << "fiber dof " << dofNoLocal << ", component " << i;
+    }
+  }
+}
+
 } // namespace
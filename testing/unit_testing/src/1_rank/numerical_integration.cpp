@@ -7,6 +7,7 @@
 #include "gtest/gtest.h"
 #include "opendihu.h"
 #include "utility/petsc_utility.h"
+#include "function_space/geometric_factors_cache.h"
 #include "arg.h"
 #include "stiffness_matrix_tester.h"
 
@@ -213,6 +214,111 @@ config = {
   
   StiffnessMatrixTester::checkEqual(equationDiscretized1, equationDiscretized2);
 }
+
+// the geometric factors from the cache are the same as the directly computed ones, they are reused for unchanged geometry and recomputed if the geometry changed
+TEST(NumericalIntegrationTest, GeometricFactorsCacheEqualsDirectComputation)
+{
+  std::string pythonConfig = R"(
+config = {}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>,BasisFunction::LagrangeOfOrder<2>> FunctionSpaceType;
+  typedef Quadrature::TensorProduct<3,Quadrature::Gauss<3>> QuadratureDD;
+  typedef FunctionSpace::GeometricFactorsCache<FunctionSpaceType,QuadratureDD> GeometricFactorsCacheType;
+  const int nDofsPerElement = FunctionSpaceType::nDofsPerElement();
+
+  // a distorted mesh of 2x2x1 quadratic elements
+  std::array<element_no_t,3> nElements({2, 2, 1});
+  std::array<int,3> nRanks({1, 1, 1});
+  std::vector<Vec3> nodePositions;
+  for (int k = 0; k < 2*nElements[2]+1; k++)
+  {
+    for (int j = 0; j < 2*nElements[1]+1; j++)
+    {
+      for (int i = 0; i < 2*nElements[0]+1; i++)
+      {
+        double x = 0.5*i, y = 0.5*j, z = 0.5*k;
+        nodePositions.push_back(Vec3({x + 0.1*sin(y+z), y + 0.05*x*x, 1.2*z + 0.1*x*y}));
+      }
+    }
+  }
+
+  std::shared_ptr<FunctionSpaceType> functionSpace = settings.meshManager()->createFunctionSpace<FunctionSpaceType>("functionSpace", nodePositions, nElements, nRanks);
+  const element_no_t nElementsLocal = functionSpace->nElementsLocal();
+
+  GeometricFactorsCacheType geometricFactorsCache;
+  std::array<Vec3,QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
+
+  // get the factors of the batch at elementIndex from the cache and compare them to the direct computation, all entries of the batch get the same element geometry
+  auto checkFactors = [&](element_no_t elementIndex, const std::array<Vec3,nDofsPerElement> &geometry, std::string description)
+  {
+    std::array<Vec3_v_t,nDofsPerElement> geometryBatch;
+    for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+    {
+      for (int i = 0; i < 3; i++)
+        geometryBatch[dofIndex][i] = geometry[dofIndex][i];
+    }
+
+    const typename GeometricFactorsCacheType::ElementFactors &factors = geometricFactorsCache.get(elementIndex, geometryBatch);
+
+    double approximateMeshWidth = MathUtility::computeApproximateMeshWidth<double,nDofsPerElement>(geometry);
+    for (int samplingPointIndex = 0; samplingPointIndex < QuadratureDD::numberEvaluations(); samplingPointIndex++)
+    {
+      Tensor2<3> jacobian = FunctionSpaceType::computeJacobian(geometry, samplingPoints[samplingPointIndex]);
+      double jacobianDeterminant = 0;
+      Tensor2<3> inverseJacobian = MathUtility::computeInverse(jacobian, approximateMeshWidth, jacobianDeterminant);
+
+      EXPECT_GT(jacobianDeterminant, 0) << description;
+      EXPECT_FALSE(Vc::any_of(MathUtility::abs(factors.jacobianDeterminant[samplingPointIndex] - jacobianDeterminant) > 1e-12))
+        << description << ", element " << elementIndex << ", sampling point " << samplingPointIndex;
+      for (int columnIdx = 0; columnIdx < 3; columnIdx++)
+      {
+        for (int rowIdx = 0; rowIdx < 3; rowIdx++)
+        {
+          EXPECT_FALSE(Vc::any_of(MathUtility::abs(factors.inverseJacobian[samplingPointIndex][columnIdx][rowIdx] - inverseJacobian[columnIdx][rowIdx]) > 1e-12))
+            << description << ", element " << elementIndex << ", sampling point " << samplingPointIndex << ", entry (" << rowIdx << "," << columnIdx << ")";
+        }
+      }
+    }
+  };
+
+  std::vector<std::array<Vec3,nDofsPerElement>> elementGeometry(nElementsLocal);
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    functionSpace->getElementGeometry(elementNoLocal, elementGeometry[elementNoLocal]);
+  }
+
+  // the first calls compute the factors of all batches
+  int nBatches = 0;
+  for (element_no_t elementIndex = 0; elementIndex < nElementsLocal; elementIndex += nVcComponents, nBatches++)
+  {
+    checkFactors(elementIndex, elementGeometry[elementIndex], "first call");
+  }
+  EXPECT_EQ(geometricFactorsCache.nComputations(), nBatches);
+
+  // the same geometry reuses the stored factors
+  for (element_no_t elementIndex = 0; elementIndex < nElementsLocal; elementIndex += nVcComponents)
+  {
+    checkFactors(elementIndex, elementGeometry[elementIndex], "unchanged geometry");
+  }
+  EXPECT_EQ(geometricFactorsCache.nComputations(), nBatches);
+
+  // moving one node of the first element only recomputes the factors of the first batch
+  elementGeometry[0][4][0] += 0.05;
+  elementGeometry[0][4][2] -= 0.02;
+  for (element_no_t elementIndex = 0; elementIndex < nElementsLocal; elementIndex += nVcComponents)
+  {
+    checkFactors(elementIndex, elementGeometry[elementIndex], "changed geometry");
+  }
+  EXPECT_EQ(geometricFactorsCache.nComputations(), nBatches+1);
+
+  // after clear, the factors are computed again
+  geometricFactorsCache.clear();
+  checkFactors(0, elementGeometry[0], "after clear");
+  EXPECT_EQ(geometricFactorsCache.nComputations(), 1);
+}
 /*
  * // the following tests are commented out because they take very long to compile, they should work, however
 TEST(NumericalIntegrationTest, GaussIntegrationHigherOrderWorks)
@@ -0,0 +1,114 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "arg.h"
+
+namespace
+{
+//! gives access to the mesh creation of ParallelFiberEstimation
+class ParallelFiberEstimationTester :
+  public Postprocessing::ParallelFiberEstimation<BasisFunction::LagrangeOfOrder<1>>
+{
+public:
+  using Postprocessing::ParallelFiberEstimation<BasisFunction::LagrangeOfOrder<1>>::ParallelFiberEstimation;
+
+  //! create the mesh natively, nNodesX is the number of boundary points per face and z-level
+  bool createMeshNative(const std::array<std::vector<std::vector<Vec3>>,4> &boundaryPoints, int nNodesX, bool improveMesh,
+                        std::vector<Vec3> &nodePositions, std::array<int,3> &nElementsPerCoordinateDirectionLocal)
+  {
+    this->nBoundaryPointsXNew_ = nNodesX;
+    this->nBoundaryPointsZ_ = boundaryPoints[0].size();
+    this->improveMesh_ = improveMesh;
+    return Postprocessing::ParallelFiberEstimation<BasisFunction::LagrangeOfOrder<1>>::createMeshNative(
+      boundaryPoints, nodePositions, nElementsPerCoordinateDirectionLocal);
+  }
+};
+}
+
+// the native mesh generation has to give the same mesh as the python script stl_create_mesh.py for a concave cross section
+TEST(ParallelFiberEstimationTest, NativeMeshEqualsPythonScript)
+{
+  std::string pythonConfig = R"(
+config = {
+  "ParallelFiberEstimation": {
+    "nElementsZPerSubdomain": 2,
+    "nElementsXPerSubdomain": 6,
+  }
+}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+  ParallelFiberEstimationTester parallelFiberEstimation(settings);
+
+  // peanut-shaped cross sections that are concave at the left and right, the loop of boundary points is counter-clockwise
+  const int nNodesX = 13;
+  const int nNodesZ = 3;
+  const int nLoopPoints = 4*(nNodesX-1);
+
+  std::array<std::vector<std::vector<Vec3>>,4> boundaryPoints;    // [face_t][z-level][pointIndex]
+  for (int face = 0; face < 4; face++)
+  {
+    boundaryPoints[face].resize(nNodesZ, std::vector<Vec3>(nNodesX));
+  }
+
+  for (int zIndex = 0; zIndex < nNodesZ; zIndex++)
+  {
+    std::vector<Vec3> loop(nLoopPoints);
+    for (int k = 0; k < nLoopPoints; k++)
+    {
+      const double theta = -3*M_PI/4 + 2*M_PI*k/nLoopPoints;
+      const double r = (1.0 + 0.1*zIndex) * (1.0 - 0.4*cos(2*theta));
+      loop[k] = Vec3({2.0 + r*cos(theta), -1.0 + 0.7*r*sin(theta), 0.5*zIndex});
+    }
+
+    for (int i = 0; i < nNodesX; i++)
+    {
+      boundaryPoints[Mesh::face_t::face1Minus][zIndex][i] = loop[i];
+      boundaryPoints[Mesh::face_t::face0Plus][zIndex][i] = loop[(nNodesX-1) + i];
+      boundaryPoints[Mesh::face_t::face1Plus][zIndex][i] = loop[3*(nNodesX-1) - i];
+      boundaryPoints[Mesh::face_t::face0Minus][zIndex][i] = loop[(4*(nNodesX-1) - i) % nLoopPoints];
+    }
+  }
+
+  // load the python script
+  PyObject *sysPath = PySys_GetObject("path");
+  PyList_Append(sysPath, PyUnicode_FromString((std::string(OPENDIHU_HOME) + "/scripts/geometry_manipulation").c_str()));
+  PyObject *moduleStlCreateMesh = PyImport_ImportModule("stl_create_mesh");
+  PythonUtility::checkForError();
+  ASSERT_NE(moduleStlCreateMesh, nullptr);
+
+  PyObject *functionCreate3dMeshFromBoundaryPointsFaces = PyObject_GetAttrString(moduleStlCreateMesh, "create_3d_mesh_from_boundary_points_faces");
+  ASSERT_NE(functionCreate3dMeshFromBoundaryPointsFaces, nullptr);
+
+  for (bool improveMesh : {false, true})
+  {
+    std::vector<Vec3> nodePositions;
+    std::array<int,3> nElementsPerCoordinateDirectionLocal;
+    ASSERT_TRUE(parallelFiberEstimation.createMeshNative(boundaryPoints, nNodesX, improveMesh, nodePositions, nElementsPerCoordinateDirectionLocal))
+      << "improveMesh: " << improveMesh;
+
+    EXPECT_EQ(nElementsPerCoordinateDirectionLocal, (std::array<int,3>({nNodesX-1, nNodesX-1, nNodesZ-1})));
+
+    PyObject *boundaryPointsFacesPy = PythonUtility::convertToPython<std::array<std::vector<std::vector<Vec3>>,4>>::get(boundaryPoints);
+    PyObject *meshData = PyObject_CallFunction(functionCreate3dMeshFromBoundaryPointsFaces, "(O,O,d,i)",
+                                               boundaryPointsFacesPy, (improveMesh? Py_True : Py_False), 100.0, 0);
+    PythonUtility::checkForError();
+    ASSERT_NE(meshData, Py_None);
+
+    PyObject *object = PythonUtility::getOptionPyObject(meshData, "node_positions", "");
+    std::vector<Vec3> nodePositionsPython = PythonUtility::convertFromPython<std::vector<Vec3>>::get(object);
+
+    ASSERT_EQ(nodePositions.size(), nodePositionsPython.size());
+    for (int nodeNo = 0; nodeNo < (int)nodePositions.size(); nodeNo++)
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        EXPECT_NEAR(nodePositions[nodeNo][i], nodePositionsPython[nodeNo][i], 1e-10) << "node " << nodeNo << ", improveMesh: " << improveMesh;
+      }
+    }
+  }
+}
@@ -0,0 +1,144 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+#include "control/diagnostic_tool/hardware_counters.h"
+
+// a dot product has a known number of floating point operations, which has to be measured by the hardware counters if the CPU supports them
+TEST(PerformanceMeasurementTest, HardwareCountersCountFlops)
+{
+  std::string pythonConfig = R"(
+config = {}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  // perf_event_open is not available in all environments, e.g. in virtual machines without a virtual PMU
+  Control::HardwareCounters::initialize();
+  if (!Control::HardwareCounters::isEnabled())
+  {
+    LOG(WARNING) << "Hardware counters are not available, the test is skipped.";
+    return;
+  }
+
+  const int nEntries = 1000000;
+  const int nRepetitions = 10;
+  std::vector<double> a(nEntries), b(nEntries);
+  for (int i = 0; i < nEntries; i++)
+  {
+    a[i] = 1.0 + 1e-3*(i % 7);
+    b[i] = 2.0 - 1e-3*(i % 5);
+  }
+
+  // one multiplication and one addition per entry
+  double result = 0;
+  Control::PerformanceMeasurement::start("hardwareCountersDotProduct");
+  for (int repetitionNo = 0; repetitionNo < nRepetitions; repetitionNo++)
+  {
+    double sum = 0;
+    for (int i = 0; i < nEntries; i++)
+    {
+      sum += a[i]*b[i];
+    }
+    result += sum;
+  }
+  Control::PerformanceMeasurement::stop("hardwareCountersDotProduct");
+  EXPECT_GT(result, 0);
+
+  // the derived metrics are computed when the log file is written
+  Control::PerformanceMeasurement::writeLogFile("out/hardware_counters_log");
+
+  std::string cycles = Control::PerformanceMeasurement::getParameter("hardwareCountersDotProduct_cycles");
+  ASSERT_FALSE(cycles.empty());
+  EXPECT_GT(atof(cycles.c_str()), 0);
+
+  std::string instructionsPerCycle = Control::PerformanceMeasurement::getParameter("hardwareCountersDotProduct_IPC");
+  if (!instructionsPerCycle.empty())
+  {
+    EXPECT_GT(atof(instructionsPerCycle.c_str()), 0);
+  }
+
+  // the flops are only reported if all floating point counters could be opened, FMA instructions count as two operations
+  std::string flops = Control::PerformanceMeasurement::getParameter("hardwareCountersDotProduct_flops");
+  if (!flops.empty())
+  {
+    const double nFlopsExpected = 2.0*nEntries*nRepetitions;
+    EXPECT_NEAR(atof(flops.c_str()), nFlopsExpected, 0.05*nFlopsExpected);
+  }
+}
+
+// the region files are only written if a filename is set, names of regions with quotes and backslashes have to be escaped in the JSON files
+TEST(PerformanceMeasurementTest, RegionFilesEscapeNames)
+{
+  std::string pythonConfig = R"(
+config = {}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  const std::string regionsFilename = "out/performance_measurement_regions";
+  const std::string traceFilename = "out/performance_measurement_trace";
+  std::remove((regionsFilename + ".txt").c_str());
+  std::remove((regionsFilename + ".speedscope.json").c_str());
+
+  // without settings, no region files are written
+  Control::PerformanceMeasurement::start("regionFilesOuter");
+  Control::PerformanceMeasurement::start("region \"quoted\" \\ name");
+  Control::PerformanceMeasurement::stop("region \"quoted\" \\ name");
+  Control::PerformanceMeasurement::stop("regionFilesOuter");
+
+  Control::PerformanceMeasurement::writeRegionFiles();
+  EXPECT_FALSE(std::ifstream(regionsFilename + ".txt").good());
+  EXPECT_FALSE(std::ifstream(regionsFilename + ".speedscope.json").good());
+
+  // record the nested regions again with the output enabled
+  Control::PerformanceMeasurement::setRegionOutput(regionsFilename, traceFilename, 1000);
+  Control::PerformanceMeasurement::start("regionFilesOuter");
+  Control::PerformanceMeasurement::start("region \"quoted\" \\ name");
+  Control::PerformanceMeasurement::stop("region \"quoted\" \\ name");
+  Control::PerformanceMeasurement::stop("regionFilesOuter");
+
+  // stopping a region that was never started is only an error message
+  Control::PerformanceMeasurement::stop("regionFilesNeverStarted");
+
+  Control::PerformanceMeasurement::writeRegionFiles();
+
+  // the inner region is indented below the outer region in the text file
+  std::ifstream textFile(regionsFilename + ".txt");
+  ASSERT_TRUE(textFile.is_open());
+  bool outerRegionFound = false;
+  bool innerRegionFound = false;
+  std::string line;
+  while (std::getline(textFile, line))
+  {
+    if (line.find("  regionFilesOuter ") == 0)
+      outerRegionFound = true;
+    if (line.find("    region \"quoted\" \\ name ") == 0)
+      innerRegionFound = true;
+  }
+  EXPECT_TRUE(outerRegionFound);
+  EXPECT_TRUE(innerRegionFound);
+
+  std::ifstream speedscopeFile(regionsFilename + ".speedscope.json");
+  ASSERT_TRUE(speedscopeFile.is_open());
+  std::stringstream speedscope;
+  speedscope << speedscopeFile.rdbuf();
+  EXPECT_NE(speedscope.str().find("{\"name\":\"region \\\"quoted\\\" \\\\ name\"}"), std::string::npos) << speedscope.str();
+  EXPECT_NE(speedscope.str().find("{\"name\":\"regionFilesOuter\"}"), std::string::npos) << speedscope.str();
+
+  // the trace contains the call of the inner region
+  std::ifstream traceFile(traceFilename + ".0000000.json");
+  ASSERT_TRUE(traceFile.is_open());
+  std::stringstream trace;
+  trace << traceFile.rdbuf();
+  EXPECT_NE(trace.str().find("{\"name\":\"region \\\"quoted\\\" \\\\ name\",\"ph\":\"X\""), std::string::npos) << trace.str();
+
+  Control::PerformanceMeasurement::setRegionOutput("", "", 1000000);
+}
@@ -0,0 +1,176 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+#include "control/coupling/concurrent_transfer.h"
+
+// every rank sends every second dof in descending order and receives a contiguous block in reverse order and a dof that nobody sends,
+// the received values have to be the sent values of the same global natural dofs
+TEST(ConcurrentCouplingTest, TransferMatchesGlobalNaturalDofs)
+{
+  std::string pythonConfig = R"(
+config = {}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  MPI_Comm mpiCommunicator = MPI_COMM_WORLD;
+  int ownRankNo = 0;
+  int nRanks = 0;
+  MPI_Comm_rank(mpiCommunicator, &ownRankNo);
+  MPI_Comm_size(mpiCommunicator, &nRanks);
+
+  const int nDofsGlobal = 23;
+  std::vector<global_no_t> sendDofNosGlobalNatural;
+  for (int dofNo = nDofsGlobal-1; dofNo >= 0; dofNo--)
+  {
+    if (dofNo % nRanks == ownRankNo)
+      sendDofNosGlobalNatural.push_back(dofNo);
+  }
+
+  std::vector<global_no_t> receiveDofNosGlobalNatural;
+  for (int dofNo = (ownRankNo+1)*nDofsGlobal/nRanks - 1; dofNo >= ownRankNo*nDofsGlobal/nRanks; dofNo--)
+  {
+    receiveDofNosGlobalNatural.push_back(dofNo);
+  }
+  receiveDofNosGlobalNatural.push_back(nDofsGlobal);
+
+  Control::ConcurrentTransfer transfer;
+  transfer.initialize(mpiCommunicator, sendDofNosGlobalNatural, receiveDofNosGlobalNatural, 0);
+
+  EXPECT_EQ(transfer.nValuesToSend(), (int)sendDofNosGlobalNatural.size());
+  EXPECT_EQ(transfer.nValuesToReceive(), (int)receiveDofNosGlobalNatural.size()-1);
+
+  // the same communication pattern is used for several transfers
+  for (int transferNo = 0; transferNo < 2; transferNo++)
+  {
+    std::vector<double> sendValues;
+    for (global_no_t dofNoGlobalNatural : sendDofNosGlobalNatural)
+    {
+      sendValues.push_back(100.0*transferNo + dofNoGlobalNatural + 0.5);
+    }
+
+    transfer.startTransfer(sendValues);
+    EXPECT_TRUE(transfer.transferIsActive());
+
+    std::vector<double> receivedValues(receiveDofNosGlobalNatural.size(), -1.0);
+    transfer.finishTransfer(receivedValues);
+    EXPECT_FALSE(transfer.transferIsActive());
+
+    for (int i = 0; i < (int)receiveDofNosGlobalNatural.size()-1; i++)
+    {
+      EXPECT_EQ(receivedValues[i], 100.0*transferNo + receiveDofNosGlobalNatural[i] + 0.5) << "dof " << receiveDofNosGlobalNatural[i];
+    }
+
+    // the dof that is not sent by any rank keeps its value
+    EXPECT_EQ(receivedValues.back(), -1.0);
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// Term 1 on rank 0 starts with the initial values, term 2 on both ranks starts with zero. Because the coupling is lagged by one time step,
+// the two terms swap their values in every time step. After an odd number of time steps, term 2 has the values of an uncoupled computation
+// and term 1 is zero. This checks the matching of the dofs including the ghost dofs of the partitioned term 2.
+TEST(ConcurrentCouplingTest, LaggedCouplingSwapsValues)
+{
+  std::string pythonConfigTerms = R"(
+# initial values
+iv = {3: 5.0, 4: 4.0, 5: 2.0, 12: 1.0}
+
+def term(ranks, initial_values, end_time):
+  return {
+    "MultipleInstances": {
+      "nInstances": 1,
+      "instances": [{
+        "ranks": ranks,
+        "ExplicitEuler": {
+          "initialValues": initial_values,
+          "timeStepWidth": 0.05,
+          "endTime": end_time,
+          "timeStepOutputInterval": 100,
+          "FiniteElementMethod": {
+            "inputMeshIsGlobal": True,
+            "nElements": [16],
+            "physicalExtent": [16.0],
+            "relativeTolerance": 1e-15,
+          },
+        }
+      }]
+    }
+  }
+)";
+
+  std::string pythonConfig = pythonConfigTerms + R"(
+config = {
+  "ConcurrentCoupling": {
+    "timeStepWidth": 0.1,
+    "endTime": 0.5,
+    "timeStepOutputInterval": 100,
+    "connectedSlotsTerm1To2": [0],
+    "connectedSlotsTerm2To1": [0],
+    "Term1": term([0], iv, 0.1),
+    "Term2": term([0,1], [], 0.1),
+  }
+}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef Control::MultipleInstances<
+    TimeSteppingScheme::ExplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+        Mesh::StructuredRegularFixedOfDimension<1>,
+        BasisFunction::LagrangeOfOrder<1>,
+        Quadrature::Gauss<2>,
+        Equation::Dynamic::IsotropicDiffusion
+      >
+    >
+  > TermType;
+
+  Control::ConcurrentCoupling<TermType,TermType> problem(settings);
+  problem.run();
+
+  // the uncoupled computation with the same partitioning as term 2
+  std::string pythonConfigReference = pythonConfigTerms + R"(
+config = term([0,1], iv, 0.5)
+)";
+  DihuContext settingsReference(argc, argv, pythonConfigReference);
+  TermType reference(settingsReference);
+  reference.run();
+
+  std::vector<double> referenceValues;
+  reference.instancesLocal()[0].data().solution()->getValuesWithoutGhosts(referenceValues);
+
+  std::vector<double> values2;
+  ASSERT_EQ((int)problem.timeStepping2().instancesLocal().size(), 1);
+  problem.timeStepping2().instancesLocal()[0].data().solution()->getValuesWithoutGhosts(values2);
+
+  ASSERT_EQ(values2.size(), referenceValues.size());
+  double maximumValue = 0;
+  for (int i = 0; i < values2.size(); i++)
+  {
+    EXPECT_NEAR(values2[i], referenceValues[i], 1e-12) << "dof " << i;
+    maximumValue = std::max(maximumValue, fabs(referenceValues[i]));
+  }
+  EXPECT_GT(maximumValue, 0.1);
+
+  // term 1 is only computed on rank 0
+  if (problem.timeStepping1().instancesLocal().size() > 0)
+  {
+    std::vector<double> values1;
+    problem.timeStepping1().instancesLocal()[0].data().solution()->getValuesWithoutGhosts(values1);
+    for (int i = 0; i < values1.size(); i++)
+    {
+      EXPECT_NEAR(values1[i], 0.0, 1e-12) << "dof " << i;
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
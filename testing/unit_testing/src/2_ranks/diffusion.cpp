@@ -3,6 +3,9 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
+#include <sstream>
+#include <map>
+#include <regex>
 
 #include "gtest/gtest.h"
 #include "arg.h"
@@ -220,3 +223,473 @@ config = {
 
   nFails += ::testing::Test::HasFailure();
 }
+
+// the delta encoded numpy output in a combined file has to be reconstructed to the same values as the full output
+TEST(DiffusionTest, NumpyDeltaOutputEqualsFullOutput)
+{
+  std::string pythonConfig = R"(
+# Diffusion 1D, two peaks that spread over a few nodes per time step, such that the chunks far away from them do not change
+n = 40
+
+# initial values
+iv = {}
+iv[10] = 5.
+iv[30] = 4.
+
+config = {
+  "ExplicitEuler": {
+    "initialValues": iv,
+    "numberTimeSteps": 6,
+    "endTime": 0.6,
+    "FiniteElementMethod": {
+      "inputMeshIsGlobal": True,
+      "nElements": n,
+      "physicalExtent": n,
+      "relativeTolerance": 1e-15,
+    },
+    "OutputWriter" : [
+      {"format": "PythonFile", "filename": "out/numpy_full/diffusion", "outputInterval": 1, "numpy": True, "combineFiles": True},
+      {"format": "PythonFile", "filename": "out/numpy_delta/diffusion", "outputInterval": 1, "numpy": True, "combineFiles": True,
+       "deltaOutput": True, "deltaChunkSize": 4, "deltaTolerance": 0.0},
+    ]
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<1>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > problem(settings);
+
+  problem.run();
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  // compare every file of the delta output with the corresponding file of the full output
+  std::string command = R"(
+import os
+import py_reader
+import numpy as np
+
+directory_full = "out/numpy_full"
+directory_delta = "out/numpy_delta"
+filenames = sorted([filename for filename in os.listdir(directory_full) if filename.endswith(".npys")])
+
+n_files_compared = 0
+n_partial_frames = 0
+n_mismatches = 0
+block_cache = {}
+for filename in filenames:
+  blocks_full = py_reader.load_numpy_file(os.path.join(directory_full, filename))
+  blocks_delta = py_reader.load_numpy_file(os.path.join(directory_delta, filename), block_cache)
+
+  if len(blocks_full) != len(blocks_delta):
+    n_mismatches += 1
+    continue
+
+  for block_full,block_delta in zip(blocks_full, blocks_delta):
+    for field_variable_full,field_variable_delta in zip(block_full["data"], block_delta["data"]):
+      for component_full,component_delta in zip(field_variable_full["components"], field_variable_delta["components"]):
+        if not np.array_equal(np.asarray(component_full["values"]), np.asarray(component_delta["values"])):
+          print("mismatch in file {}, field variable {}, component {}".format(filename, field_variable_full["name"], component_full["name"]))
+          n_mismatches += 1
+
+  # count the files in which a field variable has both stored chunks and chunks that refer to earlier files
+  for dict_from_file,arrays in py_reader.load_numpy_blocks(os.path.join(directory_delta, filename)):
+    if "delta" in dict_from_file:
+      chunk_sources = arrays[0::2]
+      if any(np.any(sources == -1) and np.any(sources >= 0) for sources in chunk_sources):
+        n_partial_frames += 1
+        break
+  n_files_compared += 1
+
+print("compared {} files, {} partial delta frames, {} mismatches".format(n_files_compared, n_partial_frames, n_mismatches))
+)";
+  int returnValue = PyRun_SimpleString(command.c_str());
+  PythonUtility::checkForError();
+  ASSERT_EQ(returnValue, 0);
+
+  PyObject *mainModule = PyImport_AddModule("__main__");
+  int nFilesCompared = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_files_compared"));
+  int nPartialFrames = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_partial_frames"));
+  int nMismatches = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_mismatches"));
+
+  // initial values and 6 time steps
+  EXPECT_EQ(nFilesCompared, 7);
+  EXPECT_GE(nPartialFrames, 3);
+  EXPECT_EQ(nMismatches, 0);
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+#ifdef HAVE_HDF5
+namespace
+{
+//! read a dataset of the HDF5 file with the given element type, dimensions contains the extents of all dimensions
+template<typename T>
+std::vector<T> readHdf5Dataset(hid_t file, std::string path, hid_t memoryType, std::vector<hsize_t> &dimensions)
+{
+  hid_t dataset = H5Dopen2(file, path.c_str(), H5P_DEFAULT);
+  EXPECT_GE(dataset, 0) << "dataset " << path;
+  if (dataset < 0)
+    return std::vector<T>();
+
+  hid_t dataSpace = H5Dget_space(dataset);
+  dimensions.resize(H5Sget_simple_extent_ndims(dataSpace));
+  H5Sget_simple_extent_dims(dataSpace, dimensions.data(), NULL);
+
+  hsize_t nValues = 1;
+  for (hsize_t dimension : dimensions)
+    nValues *= dimension;
+
+  std::vector<T> values(nValues);
+  H5Dread(dataset, memoryType, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+  H5Sclose(dataSpace);
+  H5Dclose(dataset);
+  return values;
+}
+
+//! get the entries of the time series datasets that the time steps of the XDMF file refer to,
+//! result[timeStepNo][datasetPath] = {entryNo, extent of the time dimension}, datasetPath is the path in the HDF5 file, e.g. "/diffusionMesh/geometry"
+std::vector<std::map<std::string,std::array<long long,2>>> readXdmfHyperSlabEntries(std::string xdmfFilename)
+{
+  std::vector<std::map<std::string,std::array<long long,2>>> result;
+
+  std::ifstream xdmfFile(xdmfFilename.c_str());
+  EXPECT_TRUE(xdmfFile.is_open()) << xdmfFilename;
+  std::stringstream contents;
+  contents << xdmfFile.rdbuf();
+  const std::string xdmf = contents.str();
+
+  const std::string timeStepBegin = "GridType=\"Collection\" CollectionType=\"Spatial\"";
+  const std::regex hyperSlab("Format=\"XML\">(\\d+) 0 0 1 1 1 1 \\d+ \\d+</DataItem>\\s*"
+                             "<DataItem Dimensions=\"(\\d+) \\d+ \\d+\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">[^:<]*:([^<]*)</DataItem>");
+
+  for (std::size_t position = xdmf.find(timeStepBegin); position != std::string::npos; )
+  {
+    std::size_t nextPosition = xdmf.find(timeStepBegin, position+1);
+    std::string timeStep = xdmf.substr(position, nextPosition == std::string::npos? std::string::npos : nextPosition-position);
+
+    result.emplace_back();
+    for (std::sregex_iterator iter(timeStep.begin(), timeStep.end(), hyperSlab); iter != std::sregex_iterator(); iter++)
+    {
+      result.back()[(*iter)[3].str()] = std::array<long long,2>({std::stoll((*iter)[1].str()), std::stoll((*iter)[2].str())});
+    }
+    position = nextPosition;
+  }
+  return result;
+}
+}
+
+// the HDF5 file of a parallel run has to contain every node once, numbered globally and with the same values as the serial run,
+// the XDMF file has to refer to the datasets with their extent
+TEST(DiffusionTest, HDF5OutputEqualsSerial)
+{
+  std::string pythonConfig = R"(
+# Diffusion 2D
+nx = 4   # number of elements in x direction
+ny = 3   # number of elements in y direction
+
+# initial values
+iv = {}
+iv[6] = 5.
+iv[7] = 4.
+iv[12] = 3.
+
+config = {
+  "Meshes": {
+    "diffusionMesh": {
+      "inputMeshIsGlobal": True,
+      "nElements": [nx, ny],
+      "physicalExtent": [nx, ny],
+    }
+  },
+  "MultipleInstances": {
+    "nInstances": 1,
+    "instances": [{
+      "ranks": ranks,
+      "ExplicitEuler": {
+        "initialValues": iv,
+        "numberTimeSteps": 5,
+        "endTime": 0.5,
+        "FiniteElementMethod": {
+          "meshName": "diffusionMesh",
+          "relativeTolerance": 1e-15,
+        },
+        "OutputWriter" : [
+          {"format": "HDF5", "filename": filename, "outputInterval": 1}
+        ]
+      }
+    }]
+  }
+}
+)";
+
+  typedef Control::MultipleInstances<
+    TimeSteppingScheme::ExplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+        Mesh::StructuredRegularFixedOfDimension<2>,
+        BasisFunction::LagrangeOfOrder<1>,
+        Quadrature::Gauss<2>,
+        Equation::Dynamic::IsotropicDiffusion
+      >
+    >
+  > ProblemType;
+
+  // run the serial and the parallel problem, the files are closed when the problems are destroyed
+  {
+    DihuContext settings(argc, argv, std::string("ranks = [0]\nfilename = \"out/hdf5_serial/diffusion\"\n") + pythonConfig);
+    ProblemType problemSerial(settings);
+    problemSerial.run();
+  }
+  {
+    DihuContext settings(argc, argv, std::string("ranks = [0,1]\nfilename = \"out/hdf5_parallel/diffusion\"\n") + pythonConfig);
+    ProblemType problemParallel(settings);
+    problemParallel.run();
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  int ownRankNo = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &ownRankNo);
+  if (ownRankNo == 0)
+  {
+    const int nx = 4;
+    const int ny = 3;
+    const int nPoints = (nx+1)*(ny+1);
+    const int nTimeSteps = 6;   // initial values and 5 time steps
+
+    hid_t fileSerial = H5Fopen("out/hdf5_serial/diffusion.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    hid_t fileParallel = H5Fopen("out/hdf5_parallel/diffusion.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    ASSERT_GE(fileSerial, 0);
+    ASSERT_GE(fileParallel, 0);
+
+    std::vector<hsize_t> dimensionsSerial, dimensionsParallel, dimensionsConnectivity;
+    std::vector<double> geometrySerial = readHdf5Dataset<double>(fileSerial, "/diffusionMesh/geometry", H5T_NATIVE_DOUBLE, dimensionsSerial);
+    std::vector<double> geometryParallel = readHdf5Dataset<double>(fileParallel, "/diffusionMesh/geometry", H5T_NATIVE_DOUBLE, dimensionsParallel);
+
+    // the ghost nodes are not stored twice
+    ASSERT_EQ(dimensionsSerial, (std::vector<hsize_t>({nTimeSteps, nPoints, 3})));
+    ASSERT_EQ(dimensionsParallel, (std::vector<hsize_t>({nTimeSteps, nPoints, 3})));
+
+    // every cell of the parallel connectivity is a unit square with counter-clockwise nodes
+    std::vector<long long> connectivity = readHdf5Dataset<long long>(fileParallel, "/diffusionMesh/connectivity", H5T_NATIVE_LLONG, dimensionsConnectivity);
+    ASSERT_EQ(dimensionsConnectivity, (std::vector<hsize_t>({nx*ny, 4})));
+
+    hid_t connectivityDataset = H5Dopen2(fileParallel, "/diffusionMesh/connectivity", H5P_DEFAULT);
+    hid_t connectivityType = H5Dget_type(connectivityDataset);
+    EXPECT_EQ(H5Tget_size(connectivityType), 8u);
+    H5Tclose(connectivityType);
+    H5Dclose(connectivityDataset);
+
+    const std::array<std::array<double,2>,4> cornerOffsets = {{{0,0}, {1,0}, {1,1}, {0,1}}};
+    for (int cellNo = 0; cellNo < nx*ny; cellNo++)
+    {
+      long long firstPointNo = connectivity[4*cellNo];
+      ASSERT_GE(firstPointNo, 0);
+      ASSERT_LT(firstPointNo, nPoints);
+      for (int cornerNo = 0; cornerNo < 4; cornerNo++)
+      {
+        long long pointNo = connectivity[4*cellNo + cornerNo];
+        ASSERT_GE(pointNo, 0);
+        ASSERT_LT(pointNo, nPoints);
+        for (int i = 0; i < 2; i++)
+        {
+          EXPECT_NEAR(geometryParallel[3*pointNo + i] - geometryParallel[3*firstPointNo + i], cornerOffsets[cornerNo][i], 1e-12)
+            << "cell " << cellNo << ", corner " << cornerNo;
+        }
+      }
+    }
+
+    // the values of every parallel point equal the values of the serial point at the same position
+    std::vector<double> solutionSerial = readHdf5Dataset<double>(fileSerial, "/diffusionMesh/fields/solution", H5T_NATIVE_DOUBLE, dimensionsSerial);
+    std::vector<double> solutionParallel = readHdf5Dataset<double>(fileParallel, "/diffusionMesh/fields/solution", H5T_NATIVE_DOUBLE, dimensionsParallel);
+    ASSERT_EQ(dimensionsSerial, (std::vector<hsize_t>({nTimeSteps, nPoints, 1})));
+    ASSERT_EQ(dimensionsParallel, dimensionsSerial);
+
+    std::vector<int> nMatches(nPoints, 0);
+    for (int pointNoParallel = 0; pointNoParallel < nPoints; pointNoParallel++)
+    {
+      for (int pointNoSerial = 0; pointNoSerial < nPoints; pointNoSerial++)
+      {
+        if (fabs(geometryParallel[3*pointNoParallel] - geometrySerial[3*pointNoSerial]) > 1e-12
+          || fabs(geometryParallel[3*pointNoParallel+1] - geometrySerial[3*pointNoSerial+1]) > 1e-12)
+          continue;
+
+        nMatches[pointNoSerial]++;
+        for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)
+        {
+          EXPECT_NEAR(solutionParallel[timeStepNo*nPoints + pointNoParallel], solutionSerial[timeStepNo*nPoints + pointNoSerial], 1e-12)
+            << "point " << pointNoParallel << ", time step " << timeStepNo;
+        }
+      }
+    }
+    EXPECT_EQ(nMatches, std::vector<int>(nPoints, 1));
+
+    H5Fclose(fileSerial);
+    H5Fclose(fileParallel);
+
+    // the time series datasets in the XDMF file have the extent of the datasets
+    std::ifstream xdmfFile("out/hdf5_parallel/diffusion.xdmf");
+    ASSERT_TRUE(xdmfFile.is_open());
+    std::stringstream contents;
+    contents << xdmfFile.rdbuf();
+    std::string xdmf = contents.str();
+
+    EXPECT_NE(xdmf.find("TopologyType=\"Quadrilateral\" NumberOfElements=\"12\""), std::string::npos);
+    EXPECT_NE(xdmf.find("NumberType=\"Int\" Precision=\"8\" Format=\"HDF\">diffusion.h5:/diffusionMesh/connectivity"), std::string::npos);
+
+    std::stringstream expectedDimensions;
+    expectedDimensions << "Dimensions=\"" << nTimeSteps << " " << nPoints << " ";
+
+    int nTimeSeriesDataItems = 0;
+    for (std::size_t position = xdmf.find("NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"); position != std::string::npos;
+         position = xdmf.find("NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">", position+1))
+    {
+      std::size_t dataItemBegin = xdmf.rfind("<DataItem ", position);
+      EXPECT_EQ(xdmf.substr(dataItemBegin + 10, expectedDimensions.str().size()), expectedDimensions.str());
+      nTimeSeriesDataItems++;
+    }
+    EXPECT_GE(nTimeSeriesDataItems, 2*nTimeSteps);
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// with deltaOutput, the datasets of the static geometry and of a field variable that changes less than deltaTolerance contain fewer entries than time steps,
+// the entries that the XDMF file refers to for every time step have to contain the same values as the full output
+TEST(DiffusionTest, HDF5DeltaOutputEqualsFullOutput)
+{
+  std::string pythonConfig = R"(
+# Diffusion 2D
+nx = 4   # number of elements in x direction
+ny = 3   # number of elements in y direction
+
+# initial values
+iv = {}
+iv[6] = 5.
+iv[7] = 4.
+iv[12] = 3.
+
+config = {
+  "Meshes": {
+    "diffusionMesh": {
+      "inputMeshIsGlobal": True,
+      "nElements": [nx, ny],
+      "physicalExtent": [nx, ny],
+    }
+  },
+  "ExplicitEuler": {
+    "initialValues": iv,
+    "numberTimeSteps": 5,
+    "endTime": 0.5,
+    "FiniteElementMethod": {
+      "meshName": "diffusionMesh",
+      "relativeTolerance": 1e-15,
+    },
+    "OutputWriter" : [
+      {"format": "HDF5", "filename": "out/hdf5_delta_reference/diffusion", "outputInterval": 1},
+      {"format": "HDF5", "filename": "out/hdf5_delta/diffusion", "outputInterval": 1, "deltaOutput": True},
+      {"format": "HDF5", "filename": "out/hdf5_delta_tolerance/diffusion", "outputInterval": 1, "deltaOutput": True, "deltaTolerance": 10.0},
+    ]
+  }
+}
+)";
+
+  // the files are closed when the problem is destroyed
+  {
+    DihuContext settings(argc, argv, pythonConfig);
+
+    TimeSteppingScheme::ExplicitEuler<
+      SpatialDiscretization::FiniteElementMethod<
+        Mesh::StructuredRegularFixedOfDimension<2>,
+        BasisFunction::LagrangeOfOrder<1>,
+        Quadrature::Gauss<2>,
+        Equation::Dynamic::IsotropicDiffusion
+      >
+    > problem(settings);
+
+    problem.run();
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  int ownRankNo = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &ownRankNo);
+  if (ownRankNo == 0)
+  {
+    const int nPoints = 5*4;
+    const long long nTimeSteps = 6;   // initial values and 5 time steps
+    const std::string geometryPath = "/diffusionMesh/geometry";
+    const std::string solutionPath = "/diffusionMesh/fields/solution";
+
+    hid_t fileReference = H5Fopen("out/hdf5_delta_reference/diffusion.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    ASSERT_GE(fileReference, 0);
+
+    std::vector<hsize_t> dimensions;
+    std::map<std::string,std::vector<double>> valuesReference;
+    valuesReference[geometryPath] = readHdf5Dataset<double>(fileReference, geometryPath, H5T_NATIVE_DOUBLE, dimensions);
+    ASSERT_EQ(dimensions, (std::vector<hsize_t>({nTimeSteps, nPoints, 3})));
+    valuesReference[solutionPath] = readHdf5Dataset<double>(fileReference, solutionPath, H5T_NATIVE_DOUBLE, dimensions);
+    ASSERT_EQ(dimensions, (std::vector<hsize_t>({nTimeSteps, nPoints, 1})));
+    H5Fclose(fileReference);
+
+    // the solution changes in every time step, but by less than the tolerance of 10 of the second delta output
+    const std::map<std::string,std::map<std::string,long long>> expectedNEntries = {
+      {"out/hdf5_delta/diffusion", {{geometryPath, 1}, {solutionPath, nTimeSteps}}},
+      {"out/hdf5_delta_tolerance/diffusion", {{geometryPath, 1}, {solutionPath, 1}}}
+    };
+    const std::map<std::string,double> tolerances = {{"out/hdf5_delta/diffusion", 1e-12}, {"out/hdf5_delta_tolerance/diffusion", 10.0}};
+
+    for (const std::pair<const std::string,std::map<std::string,long long>> &expectedNEntriesFile : expectedNEntries)
+    {
+      const std::string &filenameBase = expectedNEntriesFile.first;
+      hid_t file = H5Fopen((filenameBase + ".h5").c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+      ASSERT_GE(file, 0) << filenameBase;
+
+      std::map<std::string,std::vector<double>> values;
+      std::map<std::string,int> nComponents = {{geometryPath, 3}, {solutionPath, 1}};
+      for (const std::pair<const std::string,long long> &expectedNEntriesDataset : expectedNEntriesFile.second)
+      {
+        const std::string &path = expectedNEntriesDataset.first;
+        values[path] = readHdf5Dataset<double>(file, path, H5T_NATIVE_DOUBLE, dimensions);
+        EXPECT_EQ(dimensions, (std::vector<hsize_t>({(hsize_t)expectedNEntriesDataset.second, nPoints, (hsize_t)nComponents[path]})))
+          << filenameBase << ", " << path;
+      }
+      H5Fclose(file);
+
+      // every time step of the XDMF file refers to an existing entry, with the extent of the dataset, that contains the values of the time step
+      std::vector<std::map<std::string,std::array<long long,2>>> entries = readXdmfHyperSlabEntries(filenameBase + ".xdmf");
+      ASSERT_EQ(entries.size(), (std::size_t)nTimeSteps) << filenameBase;
+
+      for (int timeStepNo = 0; timeStepNo < nTimeSteps; timeStepNo++)
+      {
+        for (const std::pair<const std::string,long long> &expectedNEntriesDataset : expectedNEntriesFile.second)
+        {
+          const std::string &path = expectedNEntriesDataset.first;
+          const long long nEntries = expectedNEntriesDataset.second;
+          ASSERT_EQ(entries[timeStepNo].count(path), 1u) << filenameBase << ", time step " << timeStepNo << ", " << path;
+
+          const long long entryNo = entries[timeStepNo][path][0];
+          EXPECT_EQ(entries[timeStepNo][path][1], nEntries) << filenameBase << ", time step " << timeStepNo << ", " << path;
+          EXPECT_EQ(entryNo, std::min((long long)timeStepNo, nEntries-1)) << filenameBase << ", time step " << timeStepNo << ", " << path;
+          if (entryNo < 0 || entryNo >= nEntries || values[path].size() != (std::size_t)(nEntries*nPoints*nComponents[path]))
+            continue;
+
+          const int nValuesPerEntry = nPoints*nComponents[path];
+          for (int i = 0; i < nValuesPerEntry; i++)
+          {
+            EXPECT_NEAR(values[path][entryNo*nValuesPerEntry + i], valuesReference[path][timeStepNo*nValuesPerEntry + i], tolerances.at(filenameBase))
+              << filenameBase << ", time step " << timeStepNo << ", " << path << ", value " << i;
+          }
+        }
+      }
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+#endif
@@ -0,0 +1,175 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+namespace
+{
+
+//! get the python settings of a Poisson problem with f=1 and u=0 on the boundary of the unit cube, the linear system is solved by the solver
+//! "gmgSolver" with the geometric multigrid preconditioner or by the solver "plainSolver" without preconditioner
+std::string poissonSettings(int D, int nElementsPerDimension, std::string solverName)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+D = )" << D << R"(
+n = )" << nElementsPerDimension << R"(
+n_nodes = (n+1)**D
+
+# Dirichlet boundary conditions u=0 on all nodes at the boundary
+bc = {}
+for node_no in range(n_nodes):
+  coordinates = [(node_no // (n+1)**d) % (n+1) for d in range(D)]
+  if 0 in coordinates or n in coordinates:
+    bc[node_no] = 0.0
+
+config = {
+  "Solvers": {
+    "gmgSolver": {
+      "solverType":         "cg",
+      "preconditionerType": "gmg",
+      "relativeTolerance":  1e-10,
+      "absoluteTolerance":  0,
+      "maxIterations":      1e4,
+      "dumpFilename":       "",
+      "dumpFormat":         "default",
+    },
+    "plainSolver": {
+      "solverType":         "cg",
+      "preconditionerType": "none",
+      "relativeTolerance":  1e-10,
+      "absoluteTolerance":  0,
+      "maxIterations":      1e4,
+      "dumpFilename":       "",
+      "dumpFormat":         "default",
+    },
+  },
+  "FiniteElementMethod" : {
+    "nElements":         [n]*D,
+    "physicalExtent":    [1.0]*D,
+    "inputMeshIsGlobal": True,
+    "dirichletBoundaryConditions": bc,
+    "rightHandSide":     [1.0]*n_nodes,
+    "solverName":        ")" << solverName << R"(",
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+//! solve the Poisson problem with and without the geometric multigrid preconditioner, check that the multigrid hierarchy was created,
+//! also again after a reset, that the preconditioned solver needs much less iterations and that both solutions are the same
+template<typename MeshType>
+void testGeometricMultigridConvergence(int nElementsPerDimension)
+{
+  const int D = MeshType::dim();
+  typedef SpatialDiscretization::FiniteElementMethod<
+    MeshType,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Poisson
+  > ProblemType;
+
+  std::vector<double> solutionGeometricMultigrid;
+  std::vector<double> solutionPlain;
+
+  // solve with the geometric multigrid preconditioner
+  {
+    DihuContext settings(argc, argv, poissonSettings(D, nElementsPerDimension, "gmgSolver"));
+    ProblemType problem(settings);
+    problem.run();
+
+    // the preconditioner is a PCMG with the coarse levels of the structured mesh and not the fallback to gamg
+    PythonConfig finiteElementMethodSettings(settings.getPythonConfig(), "FiniteElementMethod");
+    std::shared_ptr<Solver::Linear> linearSolver = settings.solverManager()->solver<Solver::Linear>(
+      finiteElementMethodSettings, problem.functionSpace()->meshPartition()->mpiCommunicator());
+
+    PC pc;
+    PCType pcType;
+    PetscInt nLevels = 0;
+    KSPGetPC(*linearSolver->ksp(), &pc);
+    PCGetType(pc, &pcType);
+    EXPECT_EQ(std::string(pcType), std::string(PCMG)) << D << "D";
+    PCMGGetLevels(pc, &nLevels);
+    EXPECT_GE(nLevels, 3) << D << "D";
+
+    problem.data().solution()->getValuesWithoutGhosts(solutionGeometricMultigrid);
+
+    // after a reset, the system matrix is created again and the multigrid hierarchy has to be set up for the new matrix
+    problem.reset();
+    problem.initialize();
+    problem.run();
+
+    KSPGetPC(*linearSolver->ksp(), &pc);
+    PCGetType(pc, &pcType);
+    EXPECT_EQ(std::string(pcType), std::string(PCMG)) << D << "D, after reset";
+    PCMGGetLevels(pc, &nLevels);
+    EXPECT_GE(nLevels, 3) << D << "D, after reset";
+
+    int nIterationsAfterReset = atoi(Control::PerformanceMeasurement::getParameter("nIterations_gmgSolver").c_str());
+    EXPECT_GT(nIterationsAfterReset, 0) << D << "D, after reset";
+    EXPECT_LE(nIterationsAfterReset, 20) << D << "D, after reset";
+
+    std::vector<double> solutionAfterReset;
+    problem.data().solution()->getValuesWithoutGhosts(solutionAfterReset);
+    ASSERT_EQ(solutionAfterReset.size(), solutionGeometricMultigrid.size()) << D << "D";
+    for (int dofNoLocal = 0; dofNoLocal < solutionAfterReset.size(); dofNoLocal++)
+    {
+      EXPECT_NEAR(solutionAfterReset[dofNoLocal], solutionGeometricMultigrid[dofNoLocal], 1e-9) << D << "D, after reset, dof " << dofNoLocal;
+    }
+  }
+  int nIterationsGeometricMultigrid = atoi(Control::PerformanceMeasurement::getParameter("nIterations_gmgSolver").c_str());
+
+  // solve without preconditioner
+  {
+    DihuContext settings(argc, argv, poissonSettings(D, nElementsPerDimension, "plainSolver"));
+    ProblemType problem(settings);
+    problem.run();
+
+    problem.data().solution()->getValuesWithoutGhosts(solutionPlain);
+  }
+  int nIterationsPlain = atoi(Control::PerformanceMeasurement::getParameter("nIterations_plainSolver").c_str());
+
+  LOG(INFO) << D << "D, " << nElementsPerDimension << " elements per dimension: "
+    << nIterationsGeometricMultigrid << " iterations with gmg, " << nIterationsPlain << " iterations without preconditioner";
+
+  // multigrid converges in a number of iterations that is independent of the mesh size
+  EXPECT_GT(nIterationsGeometricMultigrid, 0) << D << "D";
+  EXPECT_LE(nIterationsGeometricMultigrid, 20) << D << "D";
+  EXPECT_LT(4*nIterationsGeometricMultigrid, nIterationsPlain) << D << "D";
+
+  // both solutions are the same, the magnitude of the solution in the center of the domain is about 0.07 in 2D and 0.056 in 3D
+  ASSERT_EQ(solutionGeometricMultigrid.size(), solutionPlain.size()) << D << "D";
+  double maximumValue = 0;
+  for (int dofNoLocal = 0; dofNoLocal < solutionPlain.size(); dofNoLocal++)
+  {
+    maximumValue = std::max(maximumValue, std::fabs(solutionPlain[dofNoLocal]));
+    EXPECT_NEAR(solutionGeometricMultigrid[dofNoLocal], solutionPlain[dofNoLocal], 1e-7) << D << "D, dof " << dofNoLocal;
+  }
+  EXPECT_GT(maximumValue, 1e-2) << D << "D";
+}
+
+}  // namespace
+
+// the meshes are split between the 2 ranks, the local numbers of elements are powers of 2 such that they can be coarsened several times
+TEST(GeometricMultigridTest, Poisson2DConvergesFasterThanPlainKsp)
+{
+  testGeometricMultigridConvergence<Mesh::StructuredRegularFixedOfDimension<2>>(64);
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+TEST(GeometricMultigridTest, Poisson3DConvergesFasterThanPlainKsp)
+{
+  testGeometricMultigridConvergence<Mesh::StructuredDeformableOfDimension<3>>(16);
+
+  nFails += ::testing::Test::HasFailure();
+}
@@ -0,0 +1,133 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+#include "utility/incremental_svd.h"
+#include "utility/svd_utility.h"
+
+namespace
+{
+//! discrete sine vector k of length n, these vectors are orthonormal
+double sineVector(int k, int i, int n)
+{
+  return sqrt(2./(n+1)) * sin(M_PI*(k+1)*(i+1)/(n+1));
+}
+}
+
+// the snapshot matrix has a known SVD A = U*diag(sigma)*V^T with discrete sine vectors as U and V,
+// the incremental SVD over blocks that do not divide the number of snapshots has to give the same singular values and modes as the direct SVD
+TEST(IncrementalSvdTest, EqualsDirectSvd)
+{
+  std::string pythonConfig = R"(
+config = {}
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  MPI_Comm mpiCommunicator = MPI_COMM_WORLD;
+  int ownRankNo = 0;
+  MPI_Comm_rank(mpiCommunicator, &ownRankNo);
+
+  const int nRowsGlobal = 40;
+  const int nRowsLocal = nRowsGlobal/2;
+  const int nSnapshots = 25;
+  const std::vector<double> sigma = {10.0, 5.0, 2.0, 1.0};
+  const int nModesExact = sigma.size();
+
+  // the result has to be independent of the scaling of the snapshots
+  for (double scalingFactor : {1.0, 1e-6})
+  {
+    IncrementalSvd incrementalSvd(mpiCommunicator, 6, 4, 1e-10);
+
+    for (int j = 0; j < nSnapshots; j++)
+    {
+      std::vector<double> snapshot(nRowsLocal, 0.0);
+      for (int i = 0; i < nRowsLocal; i++)
+      {
+        const int rowNoGlobal = ownRankNo*nRowsLocal + i;
+        for (int k = 0; k < nModesExact; k++)
+        {
+          snapshot[i] += scalingFactor * sigma[k] * sineVector(k, rowNoGlobal, nRowsGlobal) * sineVector(k, j, nSnapshots);
+        }
+      }
+      incrementalSvd.addSnapshot(snapshot);
+    }
+    incrementalSvd.flush();
+
+    // the singular values
+    const std::vector<double> &singularValues = incrementalSvd.singularValues();
+    ASSERT_EQ((int)singularValues.size(), nModesExact);
+    ASSERT_EQ(incrementalSvd.nSnapshots(), nSnapshots);
+    for (int k = 0; k < nModesExact; k++)
+    {
+      EXPECT_NEAR(singularValues[k], scalingFactor*sigma[k], 1e-10*scalingFactor*sigma[0]);
+    }
+
+    // the modes are equal up to the sign
+    const std::vector<double> &leftSingularVectors = incrementalSvd.leftSingularVectors();
+    std::vector<double> projectionsLocal(nModesExact, 0.0), projections(nModesExact);
+    for (int k = 0; k < nModesExact; k++)
+    {
+      for (int i = 0; i < nRowsLocal; i++)
+      {
+        projectionsLocal[k] += leftSingularVectors[k*nRowsLocal + i] * sineVector(k, ownRankNo*nRowsLocal + i, nRowsGlobal);
+      }
+    }
+    MPI_Allreduce(projectionsLocal.data(), projections.data(), nModesExact, MPI_DOUBLE, MPI_SUM, mpiCommunicator);
+    for (int k = 0; k < nModesExact; k++)
+    {
+      EXPECT_NEAR(fabs(projections[k]), 1.0, 1e-10);
+    }
+
+    // write the basis, the rows are given by their global natural numbers
+    if (ownRankNo == 0)
+    {
+      int returnValue = system("mkdir -p out");
+      if (returnValue != 0)
+        LOG(WARNING) << "failed to create directory \"out\"";
+    }
+    MPI_Barrier(mpiCommunicator);
+
+    std::vector<long long> rowNosGlobalNatural(nRowsLocal);
+    for (int i = 0; i < nRowsLocal; i++)
+    {
+      rowNosGlobalNatural[i] = ownRankNo*nRowsLocal + i;
+    }
+    std::string filename = "out/incremental_svd_basis.pod";
+    SvdUtility::writeBasisBinary(filename, leftSingularVectors, singularValues, rowNosGlobalNatural, nRowsGlobal, 1, mpiCommunicator);
+
+    // read the rows of the other rank in reverse order and one more mode than in the file, which is zero
+    std::vector<long long> rowNosToRead(nRowsLocal);
+    for (int i = 0; i < nRowsLocal; i++)
+    {
+      rowNosToRead[i] = nRowsGlobal-1 - (ownRankNo*nRowsLocal + i);
+    }
+    const int nModesToRead = nModesExact+1;
+    std::vector<double> values, singularValuesFile;
+    ASSERT_TRUE(SvdUtility::readBasisBinary(filename, rowNosToRead, nModesToRead, values, singularValuesFile, mpiCommunicator));
+
+    ASSERT_EQ((int)singularValuesFile.size(), nModesExact);
+    ASSERT_EQ((int)values.size(), nRowsLocal*nModesToRead);
+    for (int k = 0; k < nModesExact; k++)
+    {
+      EXPECT_EQ(singularValuesFile[k], singularValues[k]);
+    }
+    for (int i = 0; i < nRowsLocal; i++)
+    {
+      for (int k = 0; k < nModesExact; k++)
+      {
+        const double sign = (projections[k] < 0? -1.0 : 1.0);
+        EXPECT_NEAR(values[i*nModesToRead + k], sign*sineVector(k, rowNosToRead[i], nRowsGlobal), 1e-10);
+      }
+      EXPECT_EQ(values[i*nModesToRead + nModesExact], 0.0);
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
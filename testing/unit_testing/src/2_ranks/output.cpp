@@ -0,0 +1,328 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+#include "output_writer/python_file/numpy_file_writer.h"
+
+// Every rank writes a block with 2 field variables of a rank dependent size, one of them is empty on rank 0, to its own file and to a combined file.
+// Both are read with py_reader.load_numpy_file and compared to the written values, load_data has to skip a truncated file.
+TEST(NumpyFileWriterTest, PerRankAndCombinedFilesRoundTrip)
+{
+  int ownRankNo = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &ownRankNo);
+
+  // the values of component componentNo of the field variable "u" (2 components) and "p" (1 component) on the given rank
+  const int nValuesU = 3 + 2*ownRankNo;
+  const int nValuesP = 2*ownRankNo;
+  std::vector<double> valuesU(2*nValuesU), valuesP(nValuesP);
+  for (int componentNo = 0; componentNo < 2; componentNo++)
+  {
+    for (int i = 0; i < nValuesU; i++)
+      valuesU[componentNo*nValuesU + i] = 1000.0*ownRankNo + 100.0*componentNo + i + 0.25;
+  }
+  for (int i = 0; i < nValuesP; i++)
+    valuesP[i] = -(ownRankNo + 1.0)*i;
+
+  std::stringstream metaData;
+  metaData << R"({"ownRankNo": )" << ownRankNo << R"(, "data": [)"
+    << R"({"name": "u", "components": [{"name": "x", "values": null}, {"name": "y", "values": null}]}, )"
+    << R"({"name": "p", "components": [{"name": "0", "values": null}]}]})";
+
+  OutputWriter::NumpyFileWriter numpyFileWriter(metaData.str());
+  numpyFileWriter.addFieldVariable(valuesU, 2);
+  numpyFileWriter.addFieldVariable(valuesP, 1);
+
+  std::stringstream filename;
+  filename << "out/numpy_round_trip/block." << ownRankNo << ".npys";
+
+  // create the directory
+  std::ofstream file;
+  OutputWriter::Generic::openFile(file, filename.str());
+  file.close();
+
+  numpyFileWriter.write(filename.str());
+  numpyFileWriter.writeCombined("out/numpy_round_trip/combined.npys", MPI_COMM_WORLD);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  if (ownRankNo == 0)
+  {
+    std::string command = R"(
+import sys, os
+sys.path.append(")" + std::string(OPENDIHU_HOME) + R"(/scripts")
+import py_reader
+import numpy as np
+
+# the values that were written on the given rank
+def expected_values(rank_no):
+  n_values_u = 3 + 2*rank_no
+  n_values_p = 2*rank_no
+  return {
+    "u": [np.array([1000.0*rank_no + 100.0*component_no + i + 0.25 for i in range(n_values_u)]) for component_no in range(2)],
+    "p": [np.array([-(rank_no + 1.0)*i for i in range(n_values_p)])],
+  }
+
+n_mismatches = 0
+def compare_block(block, rank_no, description):
+  global n_mismatches
+  if block["ownRankNo"] != rank_no:
+    print("{}: ownRankNo is {} instead of {}".format(description, block["ownRankNo"], rank_no))
+    n_mismatches += 1
+  expected = expected_values(rank_no)
+  if [field_variable["name"] for field_variable in block["data"]] != ["u", "p"]:
+    print("{}: wrong field variables".format(description))
+    n_mismatches += 1
+    return
+  for field_variable in block["data"]:
+    for component,expected_component in zip(field_variable["components"], expected[field_variable["name"]]):
+      if not np.array_equal(np.asarray(component["values"]), expected_component):
+        print("{}: mismatch in field variable {}, component {}".format(description, field_variable["name"], component["name"]))
+        n_mismatches += 1
+
+# one block in every file of a rank
+n_blocks_per_rank = []
+for rank_no in range(2):
+  blocks = py_reader.load_numpy_file("out/numpy_round_trip/block.{}.npys".format(rank_no))
+  n_blocks_per_rank.append(len(blocks))
+  if len(blocks) == 1:
+    compare_block(blocks[0], rank_no, "file of rank {}".format(rank_no))
+
+# the blocks of all ranks in the order of the ranks in the combined file
+blocks = py_reader.load_numpy_file("out/numpy_round_trip/combined.npys")
+n_blocks_combined = len(blocks)
+for rank_no,block in enumerate(blocks):
+  compare_block(block, rank_no, "combined file, block {}".format(rank_no))
+
+# a truncated file is reported and skipped by load_data
+with open("out/numpy_round_trip/combined.npys", "rb") as f:
+  contents = f.read()
+with open("out/numpy_round_trip/truncated.npys", "wb") as f:
+  f.write(contents[:-8])
+n_loaded_truncated = len(py_reader.load_data(["out/numpy_round_trip/truncated.npys"]))
+)";
+    int returnValue = PyRun_SimpleString(command.c_str());
+    PythonUtility::checkForError();
+    ASSERT_EQ(returnValue, 0);
+
+    PyObject *mainModule = PyImport_AddModule("__main__");
+    std::vector<int> nBlocksPerRank = PythonUtility::convertFromPython<std::vector<int>>::get(PyObject_GetAttrString(mainModule, "n_blocks_per_rank"));
+    int nBlocksCombined = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_blocks_combined"));
+    int nMismatches = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_mismatches"));
+    int nLoadedTruncated = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_loaded_truncated"));
+
+    EXPECT_EQ(nBlocksPerRank, std::vector<int>({1, 1}));
+    EXPECT_EQ(nBlocksCombined, 2);
+    EXPECT_EQ(nMismatches, 0);
+    EXPECT_EQ(nLoadedTruncated, 0);
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// The combined VTK files of a 2D diffusion problem are written with ascii data and with raw appended data, uncompressed and compressed
+// in blocks that span the data of both ranks. The appended data is decoded following the header_type and compressor attributes and
+// compared to the ascii files, this checks the offsets, the headers and the blocks that are compressed from data of multiple ranks.
+TEST(ParaviewTest, CombinedAppendedDataEqualsAscii)
+{
+  std::string pythonConfig = R"(
+n = 8
+
+# initial values
+iv = {}
+iv[4*(n+1)+4] = 5.
+iv[2*(n+1)+6] = 4.
+
+# the small block size for the compression creates blocks that contain data of both ranks
+output_writer = [
+  {"format": "Paraview", "filename": "out/vtk_ascii/diffusion", "outputInterval": 1, "binary": False, "combineFiles": True},
+  {"format": "Paraview", "filename": "out/vtk_appended/diffusion", "outputInterval": 1, "binary": True, "combineFiles": True,
+   "appended": True, "compression": "none"},
+  {"format": "Paraview", "filename": "out/vtk_zlib/diffusion", "outputInterval": 1, "binary": True, "combineFiles": True,
+   "appended": True, "compression": "zlib", "compressionBlockSize": 200},
+  {"format": "Paraview", "filename": "out/vtk_lz4/diffusion", "outputInterval": 1, "binary": True, "combineFiles": True,
+   "appended": True, "compression": "lz4", "compressionBlockSize": 200},
+]
+
+config = {
+  "ExplicitEuler": {
+    "initialValues": iv,
+    "numberTimeSteps": 2,
+    "endTime": 0.02,
+    "FiniteElementMethod": {
+      "inputMeshIsGlobal": True,
+      "nElements": [n, n],
+      "physicalExtent": [n, n],
+      "relativeTolerance": 1e-15,
+    },
+    "OutputWriter": output_writer,
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::ExplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<2>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > problem(settings);
+
+  problem.run();
+  MPIUtility::handleReturnValue(MPI_Barrier(MPI_COMM_WORLD), "MPI_Barrier");
+
+  // the files are compared on rank 0
+  if (DihuContext::ownRankNoCommWorld() == 0)
+  {
+    std::string command = R"(
+import os, re, struct, zlib
+import numpy as np
+try:
+  import lz4.block
+  has_lz4 = True
+except ImportError:
+  has_lz4 = False
+
+data_types = {"Float32": "<f4", "Int32": "<i4", "UInt8": "u1"}
+
+# read the data arrays of a file with an <AppendedData> section, in the order of the <DataArray> elements
+def read_appended_arrays(filename):
+  global n_mismatches
+  with open(filename, "rb") as f:
+    contents = f.read()
+  appended_data_begin = contents.index(b'<AppendedData encoding="raw">')
+  data_begin = contents.index(b"_", appended_data_begin) + 1
+  xml = contents[:appended_data_begin].decode("utf-8")
+
+  if 'header_type="UInt64"' not in xml:
+    print("{}: header_type is not UInt64".format(filename))
+    n_mismatches += 1
+  compressor = re.search(r'compressor="(\w+)"', xml)
+  compressor = compressor.group(1) if compressor else None
+
+  arrays = []
+  position = data_begin
+  for attributes in re.findall(r'<DataArray ([^>]*)>', xml):
+    data_type = re.search(r'type="(\w+)"', attributes).group(1)
+    offset = int(re.search(r'offset="(\d+)"', attributes).group(1))
+
+    # the data arrays follow each other without gaps
+    if data_begin + offset != position:
+      print("{}: data array at offset {} should start at offset {}".format(filename, offset, position - data_begin))
+      n_mismatches += 1
+    position = data_begin + offset
+
+    if compressor is None:
+      n_bytes = struct.unpack_from("<Q", contents, position)[0]
+      raw_data = contents[position+8:position+8+n_bytes]
+      position += 8 + n_bytes
+    else:
+      n_blocks, block_size, last_block_size = struct.unpack_from("<3Q", contents, position)
+      compressed_sizes = struct.unpack_from("<{}Q".format(n_blocks), contents, position+24)
+      position += 24 + 8*n_blocks
+      raw_data = b""
+      for block_no,compressed_size in enumerate(compressed_sizes):
+        block = contents[position:position+compressed_size]
+        position += compressed_size
+        uncompressed_size = last_block_size if block_no == n_blocks-1 and last_block_size != 0 else block_size
+        if compressor == "vtkZLibDataCompressor":
+          block = zlib.decompress(block)
+        else:
+          block = lz4.block.decompress(block, uncompressed_size=uncompressed_size)
+        if len(block) != uncompressed_size:
+          print("{}: block {} has {} instead of {} bytes".format(filename, block_no, len(block), uncompressed_size))
+          n_mismatches += 1
+        raw_data += block
+
+    arrays.append(np.frombuffer(raw_data, dtype=data_types[data_type]).astype(float))
+
+  if not contents[position:].startswith(b"\n\t</AppendedData>"):
+    print("{}: the last data array does not end at the end of the appended data".format(filename))
+    n_mismatches += 1
+  return arrays, compressor
+
+# read the data arrays of a file with ascii data
+def read_ascii_arrays(filename):
+  with open(filename, "r") as f:
+    contents = f.read()
+  return [np.array(values.split(), dtype=float) for values in re.findall(r'<DataArray [^>]*>(.*?)</DataArray>', contents, re.DOTALL)]
+
+n_mismatches = 0
+n_files_compared = {}
+n_compressed_files = {}
+ascii_filenames = sorted([filename for filename in os.listdir("out/vtk_ascii") if filename.endswith(".vtu")])
+
+for directory in ["out/vtk_appended", "out/vtk_zlib", "out/vtk_lz4"]:
+  n_files_compared[directory] = 0
+  n_compressed_files[directory] = 0
+  for filename in ascii_filenames:
+    arrays_ascii = read_ascii_arrays(os.path.join("out/vtk_ascii", filename))
+
+    with open(os.path.join(directory, filename), "rb") as f:
+      compressor = re.search(rb'compressor="(\w+)"', f.read().split(b"<AppendedData")[0])
+    if compressor is not None and compressor.group(1) == b"vtkLZ4DataCompressor" and not has_lz4:
+      print("skip {}, python module lz4 is not available".format(os.path.join(directory, filename)))
+      continue
+
+    arrays_appended, compressor = read_appended_arrays(os.path.join(directory, filename))
+    if compressor is not None:
+      n_compressed_files[directory] += 1
+
+    if len(arrays_appended) != len(arrays_ascii):
+      print("{}: {} data arrays, but {} in the ascii file".format(os.path.join(directory, filename), len(arrays_appended), len(arrays_ascii)))
+      n_mismatches += 1
+      continue
+
+    for array_no,(array_appended,array_ascii) in enumerate(zip(arrays_appended, arrays_ascii)):
+      if array_appended.shape != array_ascii.shape or not np.allclose(array_appended, array_ascii, rtol=1e-5, atol=1e-10):
+        print("{}: data array {} differs from the ascii file".format(os.path.join(directory, filename), array_no))
+        n_mismatches += 1
+    n_files_compared[directory] += 1
+
+n_ascii_files = len(ascii_filenames)
+n_files_appended = n_files_compared["out/vtk_appended"]
+n_files_zlib = n_files_compared["out/vtk_zlib"]
+n_compressed_files_zlib = n_compressed_files["out/vtk_zlib"]
+n_compressed_files_lz4 = n_compressed_files["out/vtk_lz4"]
+print("compared {} files, {} mismatches".format(n_files_compared, n_mismatches))
+)";
+    int returnValue = PyRun_SimpleString(command.c_str());
+    PythonUtility::checkForError();
+    ASSERT_EQ(returnValue, 0);
+
+    PyObject *mainModule = PyImport_AddModule("__main__");
+    int nAsciiFiles = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_ascii_files"));
+    int nFilesAppended = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_files_appended"));
+    int nFilesZlib = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_files_zlib"));
+    int nCompressedFilesZlib = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_compressed_files_zlib"));
+    int nCompressedFilesLz4 = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_compressed_files_lz4"));
+    int nMismatches = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "n_mismatches"));
+
+    // initial values and 2 time steps
+    EXPECT_EQ(nAsciiFiles, 3);
+    EXPECT_EQ(nFilesAppended, nAsciiFiles);
+    EXPECT_EQ(nFilesZlib, nAsciiFiles);
+    EXPECT_EQ(nMismatches, 0);
+
+    // without the libraries, the output is written uncompressed
+#ifdef HAVE_ZLIB
+    EXPECT_EQ(nCompressedFilesZlib, nAsciiFiles);
+#else
+    EXPECT_EQ(nCompressedFilesZlib, 0);
+#endif
+#ifndef HAVE_LZ4
+    EXPECT_EQ(nCompressedFilesLz4, 0);
+#endif
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
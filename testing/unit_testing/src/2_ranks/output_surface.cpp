@@ -0,0 +1,467 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+namespace
+{
+int nGathervCalls = 0;    //< number of calls to MPI_Gatherv on the own rank, counted by the wrapper below
+}
+
+// wrapper of MPI_Gatherv using the MPI profiling interface, counts the calls such that the number of collective operations of the buffered sampling can be checked
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[], const int displs[],
+                MPI_Datatype recvtype, int root, MPI_Comm comm)
+{
+  nGathervCalls++;
+  return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+}
+
+namespace
+{
+
+typedef FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<3>,BasisFunction::LagrangeOfOrder<1>> FunctionSpaceType;
+
+const int nSamplingPointsPerDimension = 5;
+const double samplingPointCoordinates[nSamplingPointsPerDimension] = {0.25, 1.0, 2.0, 3.0, 3.75};
+
+//! the value of the sampled field variable, it is linear in space, such that the interpolation on the surface is exact
+double sampledFieldValue(Vec3 position, double time)
+{
+  return 1.0 + position[0] + 2.0*position[1] + 3.0*position[2] + 10.0*time;
+}
+
+//! the requested position of a sampling point, the points lie on the top face z=1, some of them on the boundary between the subdomains of the 2 ranks
+Vec3 samplingPointPosition(int samplingPointNo)
+{
+  return Vec3{samplingPointCoordinates[samplingPointNo % nSamplingPointsPerDimension],
+              samplingPointCoordinates[samplingPointNo / nSamplingPointsPerDimension], 1.0};
+}
+
+//! data object of SampledFieldSolver, the field variables for the output writer have the layout (geometry, *, sampled field variable) that OutputSurface expects
+struct SampledFieldData
+{
+  typedef std::tuple<
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,3>>,   // geometry
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>>,
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>>    // the field variable that is sampled
+  > FieldVariablesForOutputWriter;
+
+  //! get pointers to all field variables that can be written by output writers
+  FieldVariablesForOutputWriter getFieldVariablesForOutputWriter()
+  {
+    std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,3>> geometryField
+      = std::make_shared<FieldVariable::FieldVariable<FunctionSpaceType,3>>(functionSpace->geometryField());
+
+    return FieldVariablesForOutputWriter(geometryField, values, values);
+  }
+
+  std::shared_ptr<FunctionSpaceType> functionSpace;                           //< the 3D function space
+  std::shared_ptr<FieldVariable::FieldVariable<FunctionSpaceType,1>> values;  //< the values of sampledFieldValue at the current time
+};
+
+//! a minimal solver for OutputSurface, it sets the values of a field variable to sampledFieldValue at the start time of every time span
+class SampledFieldSolver
+{
+public:
+  typedef FunctionSpaceType FunctionSpace;
+  typedef SampledFieldData Data;
+  typedef ::Data::SlotConnectorData<FunctionSpaceType,1> SlotConnectorDataType;
+
+  //! constructor
+  SampledFieldSolver(DihuContext context) :
+    context_(context["SampledFieldSolver"]), currentTime_(0.0)
+  {
+  }
+
+  //! create the mesh and the field variable
+  void initialize()
+  {
+    if (data_.functionSpace)
+      return;
+
+    data_.functionSpace = context_.meshManager()->functionSpace<FunctionSpaceType>(context_.getPythonConfig());
+    data_.values = data_.functionSpace->createFieldVariable<1>("emg");
+
+    slotConnectorData_ = std::make_shared<SlotConnectorDataType>();
+    slotConnectorData_->addFieldVariable(data_.values);
+
+    setValues();
+  }
+
+  //! set the values at the start time of the time span
+  void advanceTimeSpan(bool withOutputWritersEnabled = true)
+  {
+    setValues();
+  }
+
+  //! initialize, the values are set for the initial time
+  void run()
+  {
+    initialize();
+  }
+
+  //! reset state
+  void reset()
+  {
+  }
+
+  //! set a new time interval
+  void setTimeSpan(double startTime, double endTime)
+  {
+    currentTime_ = startTime;
+  }
+
+  //! there are no own output writers
+  void callOutputWriter(int timeStepNo, double currentTime, int callCountIncrement = 1)
+  {
+  }
+
+  //! return the data object
+  Data &data()
+  {
+    return data_;
+  }
+
+  //! get the data that would be transferred to other solvers
+  std::shared_ptr<SlotConnectorDataType> getSlotConnectorData()
+  {
+    return slotConnectorData_;
+  }
+
+private:
+
+  //! set the values of the field variable at all own dofs to sampledFieldValue at currentTime_
+  void setValues()
+  {
+    std::vector<double> values(data_.functionSpace->nDofsLocalWithoutGhosts());
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < values.size(); dofNoLocal++)
+    {
+      values[dofNoLocal] = sampledFieldValue(data_.functionSpace->getGeometry(dofNoLocal), currentTime_);
+    }
+    data_.values->setValuesWithoutGhosts(values);
+  }
+
+  DihuContext context_;                                     //< object that contains the python config for the current context and the global singletons meshManager and solverManager
+  Data data_;                                               //< the data object
+  std::shared_ptr<SlotConnectorDataType> slotConnectorData_;  //< the slot connector data with the values
+  double currentTime_;                                      //< the start time of the current time span
+};
+
+//! get the python settings for an OutputSurface with the SampledFieldSolver on a 4x4x1 mesh, that is split between the 2 ranks in x or y direction
+std::string outputSurfaceSettings(std::string filename, bool enableBufferedSampling, int bufferSize)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+coordinates = [0.25, 1.0, 2.0, 3.0, 3.75]
+sampling_points = [[x, y, 1.0] for y in coordinates for x in coordinates]
+
+config = {
+  "OutputSurface": {
+    "face":                    ["2+"],
+    "samplingPoints":          sampling_points,
+    "filename":                "out/output_surface/)" << filename << R"(.csv",
+    "binaryFilename":          "out/output_surface/)" << filename << R"(.bin",
+    "xiTolerance":             0.3,
+    "updatePointPositions":    False,
+    "enableCsvFile":           True,
+    "enableVtpFile":           False,
+    "enableGeometryInCsvFile": False,
+    "enableGeometryFiles":     False,
+    "enableBufferedSampling":  )" << (enableBufferedSampling? "True" : "False") << R"(,
+    "bufferSize":              )" << bufferSize << R"(,
+    "OutputWriter":            [],
+    "SampledFieldSolver": {
+      "nElements":         [4, 4, 1],
+      "physicalExtent":    [4.0, 4.0, 1.0],
+      "inputMeshIsGlobal": True,
+    },
+  }
+}
+)";
+  return pythonConfig.str();
+}
+
+//! the contents of a binary file of buffered sampling
+struct BufferedSamplingFile
+{
+  std::string magic;                          //< the first 8 characters of the file
+  std::vector<int32_t> pointNos;              //< the sampling point nos of the columns
+  std::vector<double> positions;              //< [pointNo*3 + componentNo] the positions of the points
+  std::vector<double> times;                  //< [recordNo] the time of the record
+  std::vector<std::vector<double>> values;    //< [recordNo][columnNo] the values of the record
+  long long nBytesAfterLastRecord;            //< number of bytes of an incomplete last record, should be 0
+};
+
+//! read the binary file that is written by OutputSurface with "enableBufferedSampling": True
+void readBufferedSamplingFile(std::string filename, BufferedSamplingFile &contents)
+{
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  ASSERT_TRUE(file.is_open()) << "Could not open file \"" << filename << "\".";
+
+  char magic[8];
+  int32_t nPoints = 0;
+  file.read(magic, 8);
+  file.read((char *)&nPoints, sizeof(int32_t));
+  ASSERT_TRUE(file.good());
+  ASSERT_GE(nPoints, 0);
+
+  contents.magic = std::string(magic, 8);
+  contents.pointNos.resize(nPoints);
+  contents.positions.resize(3*nPoints);
+  file.read((char *)contents.pointNos.data(), sizeof(int32_t)*nPoints);
+  file.read((char *)contents.positions.data(), sizeof(double)*3*nPoints);
+  ASSERT_TRUE(file.good());
+
+  contents.times.clear();
+  contents.values.clear();
+  std::vector<double> record(1 + nPoints);
+  while (file.read((char *)record.data(), sizeof(double)*record.size()))
+  {
+    contents.times.push_back(record[0]);
+    contents.values.push_back(std::vector<double>(record.begin()+1, record.end()));
+  }
+  contents.nBytesAfterLastRecord = file.gcount();
+}
+
+//! read the data lines of a csv file that is written by OutputPoints::writeCsvFile without geometry, i.e. lines of "timestamp;t;n_points;value0;value1;..."
+void readCsvFile(std::string filename, std::vector<double> &times, std::vector<std::vector<double>> &values)
+{
+  std::ifstream file(filename);
+  ASSERT_TRUE(file.is_open()) << "Could not open file \"" << filename << "\".";
+
+  times.clear();
+  values.clear();
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::stringstream lineStream(line);
+    std::string timestamp, field;
+    std::getline(lineStream, timestamp, ';');
+    std::getline(lineStream, field, ';');
+    times.push_back(atof(field.c_str()));
+    std::getline(lineStream, field, ';');
+    int nPoints = atoi(field.c_str());
+
+    values.push_back(std::vector<double>());
+    while (std::getline(lineStream, field, ';'))
+    {
+      values.back().push_back(atof(field.c_str()));
+    }
+    EXPECT_EQ(values.back().size(), nPoints) << "file \"" << filename << "\", t=" << times.back();
+  }
+}
+
+//! get the size of a file in bytes
+long long fileSize(std::string filename)
+{
+  std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    return -1;
+  return file.tellg();
+}
+
+//! compare the values of two csv files, the values are written with 6 significant digits
+void expectEqualCsvValues(std::string filename, std::string referenceFilename)
+{
+  std::vector<double> times, referenceTimes;
+  std::vector<std::vector<double>> values, referenceValues;
+  readCsvFile(filename, times, values);
+  readCsvFile(referenceFilename, referenceTimes, referenceValues);
+
+  ASSERT_EQ(times.size(), referenceTimes.size()) << filename;
+  for (int sampleNo = 0; sampleNo < times.size(); sampleNo++)
+  {
+    EXPECT_NEAR(times[sampleNo], referenceTimes[sampleNo], 1e-10) << filename << ", sample " << sampleNo;
+    ASSERT_EQ(values[sampleNo].size(), referenceValues[sampleNo].size()) << filename << ", sample " << sampleNo;
+    for (int columnNo = 0; columnNo < values[sampleNo].size(); columnNo++)
+    {
+      EXPECT_NEAR(values[sampleNo][columnNo], referenceValues[sampleNo][columnNo], 1e-5*std::fabs(referenceValues[sampleNo][columnNo]))
+        << filename << ", sample " << sampleNo << ", column " << columnNo;
+    }
+  }
+}
+
+}  // namespace
+
+// The sampling points on the boundary between the subdomains are found on both ranks. Buffered sampling assigns every point to one rank,
+// gathers the samples once per window and writes them to a binary file. Its values have to be the same as the values of the unbuffered csv output.
+TEST(OutputSurfaceTest, BufferedSamplingEqualsUnbuffered)
+{
+  typedef OutputWriter::OutputSurface<SampledFieldSolver> ProblemType;
+
+  const int nSamplingPoints = nSamplingPointsPerDimension*nSamplingPointsPerDimension;
+  const int nSamples = 7;
+  const int bufferSize = 3;
+  const double timeStepWidth = 0.1;
+  const long long headerSize = 8 + sizeof(int32_t) + nSamplingPoints*(sizeof(int32_t) + 3*sizeof(double));
+  const long long recordSize = (1 + nSamplingPoints)*sizeof(double);
+  const int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  // unbuffered sampling, writes a line to the csv file in every call
+  {
+    DihuContext settings(argc, argv, outputSurfaceSettings("unbuffered", false, 1));
+    ProblemType problem(settings);
+    problem.initialize();
+
+    for (int sampleNo = 0; sampleNo < nSamples; sampleNo++)
+    {
+      problem.setTimeSpan(sampleNo*timeStepWidth, (sampleNo+1)*timeStepWidth);
+      problem.advanceTimeSpan();
+    }
+  }
+
+  // buffered sampling, the samples of a full window are written with one MPI_Gatherv, the incomplete last window is written by run()
+  {
+    DihuContext settings(argc, argv, outputSurfaceSettings("buffered", true, bufferSize));
+    ProblemType problem(settings);
+    problem.initialize();
+
+    if (ownRankNo == 0)
+    {
+      EXPECT_EQ(fileSize("out/output_surface/buffered.bin"), headerSize);
+    }
+
+    for (int sampleNo = 0; sampleNo < nSamples; sampleNo++)
+    {
+      problem.setTimeSpan(sampleNo*timeStepWidth, (sampleNo+1)*timeStepWidth);
+
+      int nGathervCallsBefore = nGathervCalls;
+      problem.advanceTimeSpan();
+
+      const int nSamplesTaken = sampleNo + 1;
+      const bool windowIsFull = (nSamplesTaken % bufferSize == 0);
+      EXPECT_EQ(nGathervCalls - nGathervCallsBefore, (windowIsFull? 1 : 0)) << "sample " << sampleNo;
+
+      // only complete windows are in the file
+      if (ownRankNo == 0)
+      {
+        EXPECT_EQ(fileSize("out/output_surface/buffered.bin"), headerSize + (nSamplesTaken/bufferSize)*bufferSize*recordSize) << "sample " << sampleNo;
+      }
+    }
+
+    int nGathervCallsBefore = nGathervCalls;
+    problem.run();
+    EXPECT_EQ(nGathervCalls - nGathervCallsBefore, 1) << "run()";
+
+    if (ownRankNo == 0)
+    {
+      EXPECT_EQ(fileSize("out/output_surface/buffered.bin"), headerSize + nSamples*recordSize) << "after run()";
+    }
+  }
+
+  // the incomplete last window is written by the destructor
+  {
+    DihuContext settings(argc, argv, outputSurfaceSettings("buffered_destructor", true, bufferSize));
+    {
+      ProblemType problem(settings);
+      problem.initialize();
+
+      for (int sampleNo = 0; sampleNo < 5; sampleNo++)
+      {
+        problem.setTimeSpan(sampleNo*timeStepWidth, (sampleNo+1)*timeStepWidth);
+        problem.advanceTimeSpan();
+      }
+
+      if (ownRankNo == 0)
+      {
+        EXPECT_EQ(fileSize("out/output_surface/buffered_destructor.bin"), headerSize + 3*recordSize) << "before destructor";
+      }
+    }
+
+    if (ownRankNo == 0)
+    {
+      EXPECT_EQ(fileSize("out/output_surface/buffered_destructor.bin"), headerSize + 5*recordSize) << "after destructor";
+    }
+  }
+
+  // the files are written by rank 0
+  if (ownRankNo == 0)
+  {
+    BufferedSamplingFile contents;
+    readBufferedSamplingFile("out/output_surface/buffered.bin", contents);
+
+    // every sampling point is contained once, in the order of the sampling point nos, even if it was found on both ranks
+    EXPECT_EQ(contents.magic, std::string("EMGBUF01"));
+    ASSERT_EQ(contents.pointNos.size(), nSamplingPoints);
+    for (int columnNo = 0; columnNo < nSamplingPoints; columnNo++)
+    {
+      EXPECT_EQ(contents.pointNos[columnNo], columnNo);
+
+      Vec3 position = samplingPointPosition(columnNo);
+      for (int componentNo = 0; componentNo < 3; componentNo++)
+      {
+        EXPECT_NEAR(contents.positions[3*columnNo + componentNo], position[componentNo], 1e-10) << "point " << columnNo;
+      }
+    }
+    EXPECT_EQ(contents.nBytesAfterLastRecord, 0);
+
+    // the buffered values are the exact values of the field variable and equal to the values in the csv file of the unbuffered sampling
+    std::vector<double> timesUnbuffered;
+    std::vector<std::vector<double>> valuesUnbuffered;
+    readCsvFile("out/output_surface/unbuffered.csv", timesUnbuffered, valuesUnbuffered);
+
+    ASSERT_EQ(contents.times.size(), nSamples);
+    ASSERT_EQ(timesUnbuffered.size(), nSamples);
+    for (int sampleNo = 0; sampleNo < nSamples; sampleNo++)
+    {
+      EXPECT_EQ(contents.times[sampleNo], sampleNo*timeStepWidth);
+      EXPECT_NEAR(timesUnbuffered[sampleNo], contents.times[sampleNo], 1e-10);
+      ASSERT_EQ(valuesUnbuffered[sampleNo].size(), nSamplingPoints) << "sample " << sampleNo;
+
+      for (int columnNo = 0; columnNo < nSamplingPoints; columnNo++)
+      {
+        double value = sampledFieldValue(samplingPointPosition(columnNo), contents.times[sampleNo]);
+        EXPECT_NEAR(contents.values[sampleNo][columnNo], value, 1e-10) << "sample " << sampleNo << ", point " << columnNo;
+        EXPECT_NEAR(valuesUnbuffered[sampleNo][columnNo], contents.values[sampleNo][columnNo], 1e-5*std::fabs(value))
+          << "sample " << sampleNo << ", point " << columnNo;
+      }
+    }
+
+    // the file written by the destructor has the first 5 samples
+    BufferedSamplingFile contentsDestructor;
+    readBufferedSamplingFile("out/output_surface/buffered_destructor.bin", contentsDestructor);
+    ASSERT_EQ(contentsDestructor.times.size(), 5);
+    for (int sampleNo = 0; sampleNo < 5; sampleNo++)
+    {
+      EXPECT_EQ(contentsDestructor.times[sampleNo], contents.times[sampleNo]);
+      EXPECT_EQ(contentsDestructor.values[sampleNo], contents.values[sampleNo]) << "sample " << sampleNo;
+    }
+
+    // the conversion script reads the binary layout and creates the same csv file as the unbuffered sampling
+    std::stringstream command;
+    command << R"(
+import sys, runpy
+sys_argv = sys.argv
+sys.argv = ["emg_bin_to_csv.py", "out/output_surface/buffered.bin", "out/output_surface/buffered_converted.csv"]
+exit_code = 0
+try:
+  runpy.run_path(")" << OPENDIHU_HOME << R"(/scripts/file_manipulation/emg_bin_to_csv.py", run_name="__main__")
+except SystemExit as e:
+  exit_code = e.code if isinstance(e.code, int) else 1
+sys.argv = sys_argv
+)";
+    int returnValue = PyRun_SimpleString(command.str().c_str());
+    PythonUtility::checkForError();
+    ASSERT_EQ(returnValue, 0);
+
+    PyObject *mainModule = PyImport_AddModule("__main__");
+    int exitCode = PythonUtility::convertFromPython<int>::get(PyObject_GetAttrString(mainModule, "exit_code"));
+    ASSERT_EQ(exitCode, 0);
+
+    expectEqualCsvValues("out/output_surface/buffered_converted.csv", "out/output_surface/unbuffered.csv");
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
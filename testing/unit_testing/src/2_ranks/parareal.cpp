@@ -0,0 +1,126 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+
+// Parareal with 2 time slices and 2 iterations gives the sequential fine solution on all ranks
+TEST(PararealTest, EqualsSerialFineSolution)
+{
+  // run the serial fine solve on both ranks
+  std::string pythonConfig = R"(
+# Diffusion 1D
+n = 10
+
+# initial values
+iv = {}
+for i in range(n+1):
+  iv[i] = 0.
+iv[4] = 5.
+iv[5] = 4.
+
+config = {
+  "MultipleInstances": {
+    "nInstances": 2,
+    "instances": [{
+      "ranks": [0],
+      "ExplicitEuler": {
+        "initialValues": iv,
+        "timeStepWidth": 1e-2,
+        "endTime": 1.0,
+        "FiniteElementMethod": {
+          "inputMeshIsGlobal": True,
+          "nElements": n,
+          "physicalExtent": 4.0,
+          "relativeTolerance": 1e-15,
+        },
+      }
+    },
+    {
+      "ranks": [1],
+      "ExplicitEuler": {
+        "initialValues": iv,
+        "timeStepWidth": 1e-2,
+        "endTime": 1.0,
+        "FiniteElementMethod": {
+          "inputMeshIsGlobal": True,
+          "nElements": n,
+          "physicalExtent": 4.0,
+          "relativeTolerance": 1e-15,
+        },
+      }
+    }]
+  }
+}
+)";
+
+  typedef TimeSteppingScheme::ExplicitEuler<
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::StructuredRegularFixedOfDimension<1>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Dynamic::IsotropicDiffusion
+    >
+  > TimeSteppingType;
+
+  DihuContext settings(argc, argv, pythonConfig);
+  Control::MultipleInstances<TimeSteppingType> problemSerial(settings);
+  problemSerial.run();
+
+  std::vector<double> valuesSerial;
+  problemSerial.instancesLocal()[0].data().solution()->getValuesWithoutGhosts(valuesSerial);
+
+  // run Parareal with one time slice per rank, the coarse propagator has a 2.5 times larger time step width
+  std::string pythonConfig2 = R"(
+# Diffusion 1D
+n = 10
+
+# initial values
+iv = {}
+for i in range(n+1):
+  iv[i] = 0.
+iv[4] = 5.
+iv[5] = 4.
+
+config = {
+  "Parareal": {
+    "endTime": 1.0,
+    "nTimeSlices": 2,
+    "coarseTimeStepWidth": 2.5e-2,
+    "tolerance": 0.0,
+    "ExplicitEuler": {
+      "initialValues": iv,
+      "timeStepWidth": 1e-2,
+      "endTime": 1.0,
+      "FiniteElementMethod": {
+        "inputMeshIsGlobal": True,
+        "nElements": n,
+        "physicalExtent": 4.0,
+        "relativeTolerance": 1e-15,
+      },
+    }
+  }
+}
+)";
+
+  DihuContext settings2(argc, argv, pythonConfig2);
+  TimeSteppingScheme::Parareal<TimeSteppingType> problemParareal(settings2);
+  problemParareal.run();
+
+  // the result of the last time slice has to be available on all ranks
+  std::vector<double> valuesParareal;
+  problemParareal.timeStepping().data().solution()->getValuesWithoutGhosts(valuesParareal);
+
+  ASSERT_EQ(valuesParareal.size(), valuesSerial.size());
+  for (int i = 0; i < valuesSerial.size(); i++)
+  {
+    EXPECT_NEAR(valuesParareal[i], valuesSerial[i], 1e-12) << "dof " << i;
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
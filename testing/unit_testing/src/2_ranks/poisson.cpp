@@ -243,3 +243,85 @@ config = {
 
   nFails += ::testing::Test::HasFailure();
 }
+
+// the rhs in weak form is integrated with the communication of the ghost values overlapped with the interior elements,
+// it has to be equal to the product of the mass matrix with the strong form rhs, which is computed after all ghost values are known
+TEST(PoissonTest, RhsWithOverlappedCommunicationEqualsMassMatrixProduct)
+{
+  std::string pythonConfig = R"(
+# Poisson 2D, 6 x 5 = 30 nodes, deformed mesh
+nx = 5   # number of elements in x direction
+ny = 4   # number of elements in y direction
+
+node_positions = []
+for j in range(ny+1):
+  for i in range(nx+1):
+    node_positions.append([i + 0.1*j*j, j + 0.05*i*j, 0.0])
+
+# right hand side in strong form
+rhs = [1.0 + 0.1*i + 0.01*i*i for i in range((nx+1)*(ny+1))]
+
+config = {
+  "FiniteElementMethod": {
+    "inputMeshIsGlobal": True,
+    "nElements": [nx, ny],
+    "nodePositions": node_positions,
+    "rightHandSide": rhs,
+    "dirichletBoundaryConditions": {},
+    "relativeTolerance": 1e-15,
+  }
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  typedef SpatialDiscretization::FiniteElementMethod<
+    Mesh::StructuredDeformableOfDimension<2>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<2>,
+    Equation::Static::Poisson
+  > ProblemType;
+
+  ProblemType problem(settings);
+  problem.initialize();
+  problem.setMassMatrix();
+
+  std::shared_ptr<typename ProblemType::FunctionSpace> functionSpace = problem.data().functionSpace();
+  ASSERT_EQ(functionSpace->meshPartition()->nRanks(), 2);
+
+  // set the strong form rhs in a vector with the same layout as the rhs
+  problem.data().rightHandSide()->setRepresentationGlobal();
+  Vec rhsWeak = problem.data().rightHandSide()->valuesGlobal();
+  Vec rhsStrong, massMatrixProduct;
+  PetscErrorCode ierr;
+  ierr = VecDuplicate(rhsWeak, &rhsStrong); CHKERRV(ierr);
+  ierr = VecDuplicate(rhsWeak, &massMatrixProduct); CHKERRV(ierr);
+
+  std::vector<global_no_t> dofNosGlobalNatural;
+  functionSpace->meshPartition()->getDofNosGlobalNatural(dofNosGlobalNatural);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < (dof_no_t)dofNosGlobalNatural.size(); dofNoLocal++)
+  {
+    const double i = dofNosGlobalNatural[dofNoLocal];
+    PetscInt dofNoGlobalPetsc = functionSpace->meshPartition()->getDofNoGlobalPetsc(dofNoLocal);
+    ierr = VecSetValue(rhsStrong, dofNoGlobalPetsc, 1.0 + 0.1*i + 0.01*i*i, INSERT_VALUES); CHKERRV(ierr);
+  }
+  ierr = VecAssemblyBegin(rhsStrong); CHKERRV(ierr);
+  ierr = VecAssemblyEnd(rhsStrong); CHKERRV(ierr);
+
+  // compute M*f and compare with the integrated rhs
+  ierr = MatMult(problem.data().massMatrix()->valuesGlobal(), rhsStrong, massMatrixProduct); CHKERRV(ierr);
+
+  PetscReal normMassMatrixProduct, normDifference;
+  ierr = VecNorm(massMatrixProduct, NORM_INFINITY, &normMassMatrixProduct); CHKERRV(ierr);
+  ierr = VecAXPY(massMatrixProduct, -1.0, rhsWeak); CHKERRV(ierr);
+  ierr = VecNorm(massMatrixProduct, NORM_INFINITY, &normDifference); CHKERRV(ierr);
+
+  LOG(INFO) << "|M*f| = " << normMassMatrixProduct << ", |M*f - rhs| = " << normDifference;
+  EXPECT_GT(normMassMatrixProduct, 0.1);
+  EXPECT_LT(normDifference, 1e-12*normMassMatrixProduct);
+
+  ierr = VecDestroy(&rhsStrong); CHKERRV(ierr);
+  ierr = VecDestroy(&massMatrixProduct); CHKERRV(ierr);
+
+  nFails += ::testing::Test::HasFailure();
+}
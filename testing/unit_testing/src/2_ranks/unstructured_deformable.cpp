@@ -0,0 +1,230 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "arg.h"
+#include "opendihu.h"
+#include "../utility.h"
+#include "mesh/unstructured_binary_file.h"
+
+// A 4 x 2 element mesh that is given by "nodePositions" and "elements" in a permuted element order is distributed to both ranks.
+// With u=0 at x=0 and u=4 at x=4 the exact solution u=x is linear and reproduced by the linear elements,
+// this checks the local numberings, the ghost nodes and the assembly over the partition boundary for every partitioning method.
+TEST(UnstructuredDeformableTest, DistributedLaplace2D)
+{
+  for (std::string partitioningMethod : {"rcb", "sfc", "graph"})
+  {
+    std::string pythonConfig = R"(
+nx = 4   # number of elements in x direction
+ny = 2   # number of elements in y direction
+
+node_positions = [[i, j, 0.0] for j in range(ny+1) for i in range(nx+1)]
+elements = [[j*(nx+1)+i, j*(nx+1)+i+1, (j+1)*(nx+1)+i, (j+1)*(nx+1)+i+1] for j in range(ny) for i in range(nx)]
+elements = elements[1::2] + elements[0::2]
+
+# Dirichlet boundary conditions u=x on the left and right boundary
+bc = {}
+for j in range(ny+1):
+  bc[j*(nx+1)] = 0.0
+  bc[j*(nx+1)+nx] = float(nx)
+
+config = {
+  "FiniteElementMethod": {
+    "inputMeshIsGlobal": True,
+    "nodePositions": node_positions,
+    "elements": elements,
+    "partitioningMethod": ")" + partitioningMethod + R"(",
+    "dirichletBoundaryConditions": bc,
+    "relativeTolerance": 1e-15,
+    "solverType": "gmres",
+    "preconditionerType": "none",
+  }
+}
+)";
+
+    DihuContext settings(argc, argv, pythonConfig);
+
+    SpatialDiscretization::FiniteElementMethod<
+      Mesh::UnstructuredDeformableOfDimension<2>,
+      BasisFunction::LagrangeOfOrder<1>,
+      Quadrature::Gauss<2>,
+      Equation::Static::Laplace
+    > problem(settings);
+
+    problem.run();
+
+    auto functionSpace = problem.data().functionSpace();
+    auto meshPartition = functionSpace->meshPartition();
+    MPI_Comm mpiCommunicator = meshPartition->mpiCommunicator();
+
+    // every element and every node is on exactly one rank
+    int nElementsLocal = functionSpace->nElementsLocal();
+    int nNodesLocalWithoutGhosts = meshPartition->nNodesLocalWithoutGhosts();
+    int nElementsTotal = 0;
+    int nNodesTotal = 0;
+    MPI_Allreduce(&nElementsLocal, &nElementsTotal, 1, MPI_INT, MPI_SUM, mpiCommunicator);
+    MPI_Allreduce(&nNodesLocalWithoutGhosts, &nNodesTotal, 1, MPI_INT, MPI_SUM, mpiCommunicator);
+
+    EXPECT_EQ(meshPartition->nRanks(), 2) << partitioningMethod;
+    EXPECT_GT(nElementsLocal, 0) << partitioningMethod;
+    EXPECT_EQ(nElementsTotal, 8) << partitioningMethod;
+    EXPECT_EQ(nNodesTotal, 15) << partitioningMethod;
+    EXPECT_EQ(functionSpace->nElementsGlobal(), 8) << partitioningMethod;
+    EXPECT_EQ(functionSpace->nDofsGlobal(), 15) << partitioningMethod;
+
+    // the solution at the own nodes is the x coordinate
+    std::vector<double> solutionValues;
+    std::vector<double> xValues;
+    problem.data().solution()->getValuesWithoutGhosts(solutionValues);
+    functionSpace->geometryField().getValuesWithoutGhosts(0, xValues);
+
+    ASSERT_EQ(solutionValues.size(), meshPartition->nDofsLocalWithoutGhosts()) << partitioningMethod;
+    ASSERT_EQ(xValues.size(), solutionValues.size()) << partitioningMethod;
+    for (int dofNoLocal = 0; dofNoLocal < solutionValues.size(); dofNoLocal++)
+    {
+      EXPECT_NEAR(solutionValues[dofNoLocal], xValues[dofNoLocal], 1e-10)
+        << partitioningMethod << ", dof " << dofNoLocal << " (global " << meshPartition->getDofNoGlobalPetsc(dofNoLocal) << ")";
+    }
+
+    // the nodes at the partition boundary are ghosts on the ranks that do not own them,
+    // after the ghost values were fetched from the owning rank they are also the x coordinate
+    int nDofsLocalWithGhosts = meshPartition->nDofsLocalWithGhosts();
+    int nDofsLocalWithoutGhosts = meshPartition->nDofsLocalWithoutGhosts();
+    int nGhostDofsLocal = nDofsLocalWithGhosts - nDofsLocalWithoutGhosts;
+    int nGhostDofsTotal = 0;
+    MPI_Allreduce(&nGhostDofsLocal, &nGhostDofsTotal, 1, MPI_INT, MPI_SUM, mpiCommunicator);
+    EXPECT_GT(nGhostDofsTotal, 0) << partitioningMethod;
+
+    problem.data().solution()->startGhostManipulation();
+    functionSpace->geometryField().startGhostManipulation();
+    problem.data().solution()->getValuesWithGhosts(solutionValues);
+    functionSpace->geometryField().getValuesWithGhosts(0, xValues);
+    problem.data().solution()->setRepresentationGlobal();
+    functionSpace->geometryField().setRepresentationGlobal();
+
+    ASSERT_EQ(solutionValues.size(), nDofsLocalWithGhosts) << partitioningMethod;
+    ASSERT_EQ(xValues.size(), solutionValues.size()) << partitioningMethod;
+    for (int dofNoLocal = nDofsLocalWithoutGhosts; dofNoLocal < nDofsLocalWithGhosts; dofNoLocal++)
+    {
+      EXPECT_NEAR(solutionValues[dofNoLocal], xValues[dofNoLocal], 1e-10)
+        << partitioningMethod << ", ghost dof " << dofNoLocal << " (global " << meshPartition->getDofNoGlobalPetsc(dofNoLocal) << ")";
+    }
+  }
+
+  nFails += ::testing::Test::HasFailure();
+}
+
+// A binary mesh file is written by rank 0 and read back collectively. Every rank reads an uneven block of the elements and the values of
+// some nodes in unsorted order, with 2 dofs per node, the topology is read again after the node values to check that the file view is reset.
+TEST(UnstructuredBinaryFileTest, ReadTopologyAndNodeValuesRoundTrip)
+{
+  const int nElements = 7;
+  const int nNodes = 12;
+  const int nNodesPerElement = 4;
+  const int nDofsPerNode = 2;
+  const int nValuesPerNode = nDofsPerNode*3;
+  const std::string filename = "out/unstructured_binary_file_round_trip.bin";
+
+  std::vector<int64_t> elementNodeNos(nElements*nNodesPerElement);
+  std::vector<int32_t> elementNodeVersions(nElements*nNodesPerElement);
+  for (int elementNo = 0; elementNo < nElements; elementNo++)
+  {
+    for (int nodeIndex = 0; nodeIndex < nNodesPerElement; nodeIndex++)
+    {
+      elementNodeNos[elementNo*nNodesPerElement + nodeIndex] = (3*elementNo + 5*nodeIndex) % nNodes;
+      elementNodeVersions[elementNo*nNodesPerElement + nodeIndex] = (elementNo + nodeIndex) % 3;
+    }
+  }
+
+  std::vector<double> nodeValues(nNodes*nValuesPerNode);
+  for (int i = 0; i < nodeValues.size(); i++)
+  {
+    nodeValues[i] = 100.0*(i / nValuesPerNode) + (i % nValuesPerNode) + 0.5;
+  }
+
+  int ownRankNo = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &ownRankNo);
+
+  if (ownRankNo == 0)
+  {
+    std::ofstream emptyFile;
+    OutputWriter::Generic::openFile(emptyFile, filename);   // creates the directory
+    emptyFile.close();
+    Mesh::UnstructuredBinaryFile::write(filename, 2, nNodesPerElement, nDofsPerNode, elementNodeNos, elementNodeVersions, nodeValues);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  Mesh::UnstructuredBinaryFile file(filename, MPI_COMM_WORLD);
+  EXPECT_EQ(file.header().dimension, 2);
+  EXPECT_EQ(file.header().nNodesPerElement, nNodesPerElement);
+  EXPECT_EQ(file.header().nDofsPerNode, nDofsPerNode);
+  EXPECT_EQ(file.header().nElements, nElements);
+  EXPECT_EQ(file.header().nNodes, nNodes);
+
+  // check the topology of the block [elementNoBegin, elementNoEnd), the centroid is the mean of the node positions, i.e. the first dof of the nodes
+  auto checkTopology = [&](global_no_t elementNoBegin, global_no_t elementNoEnd)
+  {
+    std::vector<int64_t> elementNodeNosRead;
+    std::vector<int32_t> elementNodeVersionsRead;
+    std::vector<Vec3> elementCentroidsRead;
+    file.readTopology(elementNoBegin, elementNoEnd, elementNodeNosRead, elementNodeVersionsRead, elementCentroidsRead);
+
+    ASSERT_EQ(elementNodeNosRead.size(), (elementNoEnd - elementNoBegin)*nNodesPerElement);
+    ASSERT_EQ(elementNodeVersionsRead.size(), elementNodeNosRead.size());
+    ASSERT_EQ(elementCentroidsRead.size(), elementNoEnd - elementNoBegin);
+
+    for (global_no_t elementNo = elementNoBegin; elementNo < elementNoEnd; elementNo++)
+    {
+      Vec3 centroid({0.0, 0.0, 0.0});
+      for (int nodeIndex = 0; nodeIndex < nNodesPerElement; nodeIndex++)
+      {
+        int index = (elementNo - elementNoBegin)*nNodesPerElement + nodeIndex;
+        int64_t nodeNo = elementNodeNos[elementNo*nNodesPerElement + nodeIndex];
+        EXPECT_EQ(elementNodeNosRead[index], nodeNo) << "element " << elementNo << ", node " << nodeIndex;
+        EXPECT_EQ(elementNodeVersionsRead[index], elementNodeVersions[elementNo*nNodesPerElement + nodeIndex]) << "element " << elementNo << ", node " << nodeIndex;
+
+        for (int componentNo = 0; componentNo < 3; componentNo++)
+          centroid[componentNo] += nodeValues[nodeNo*nValuesPerNode + componentNo] / nNodesPerElement;
+      }
+      for (int componentNo = 0; componentNo < 3; componentNo++)
+        EXPECT_NEAR(elementCentroidsRead[elementNo - elementNoBegin][componentNo], centroid[componentNo], 1e-12) << "element " << elementNo;
+    }
+  };
+
+  if (ownRankNo == 0)
+    checkTopology(0, 3);
+  else
+    checkTopology(3, nElements);
+
+  // read the node values in unsorted order, they are returned in the requested order
+  std::vector<global_no_t> nodeNosGlobal;
+  if (ownRankNo == 0)
+    nodeNosGlobal = std::vector<global_no_t>{11, 0, 5, 7};
+  else
+    nodeNosGlobal = std::vector<global_no_t>{3, 10, 1};
+
+  std::vector<double> nodeValuesRead;
+  file.readNodeValues(nodeNosGlobal, nodeValuesRead);
+
+  ASSERT_EQ(nodeValuesRead.size(), nodeNosGlobal.size()*nValuesPerNode);
+  for (int i = 0; i < nodeNosGlobal.size(); i++)
+  {
+    for (int valueIndex = 0; valueIndex < nValuesPerNode; valueIndex++)
+    {
+      EXPECT_EQ(nodeValuesRead[i*nValuesPerNode + valueIndex], nodeValues[nodeNosGlobal[i]*nValuesPerNode + valueIndex])
+        << "node " << nodeNosGlobal[i] << ", value " << valueIndex;
+    }
+  }
+
+  // the explicit byte offsets of readTopology are valid again after the file view of readNodeValues
+  if (ownRankNo == 0)
+    checkTopology(4, nElements);
+  else
+    checkTopology(0, 4);
+
+  nFails += ::testing::Test::HasFailure();
+}